@@ -82,6 +82,16 @@ OPTION(ENABLE_LIBMSPACK "Enable libmspack-xenia for Xbox 360 executables." ON)
 # Enable the PowerVR Native SDK subset for PVRTC decompression.
 OPTION(ENABLE_PVRTC "Enable the PowerVR Native SDK subset for PVRTC decompression." ON)
 
+# Enable per-stage profiling counters. (`rpcli --profile`)
+OPTION(ENABLE_PROFILING "Enable per-stage timing and byte counters for `rpcli --profile`." OFF)
+
+# Enable USDT probes for perf and bpftrace.
+IF(UNIX AND NOT APPLE)
+	OPTION(ENABLE_USDT "Enable USDT probes for perf and bpftrace. (requires sys/sdt.h)" OFF)
+ELSE(UNIX AND NOT APPLE)
+	SET(ENABLE_USDT OFF)
+ENDIF(UNIX AND NOT APPLE)
+
 # Enable precompiled headers.
 # FIXME: Not working properly on older gcc. Use cmake-3.16.0's built-in PCH?
 IF(MSVC)
@@ -128,6 +128,25 @@ UNICE68_API
  */
 int unice68_depacker(void * dst, const void * src);
 
+UNICE68_API
+/**
+ *  Depack the beginning of an ICE buffer.
+ *   The unice68_depacker_head() function depacks the first dst_size
+ *   bytes of the src input ICE compressed buffer into dst.
+ *   ICE data is depacked back to front, so the entire input buffer
+ *   is still decoded, but only a small window of the output is kept
+ *   in memory instead of the entire depacked data.
+ *   (rom-properties addition)
+ * @param  dst       output (destination) buffer (uncompressed data).
+ * @param  dst_size  output buffer size.
+ * @param  src       input  (source)      buffer (compressed data).
+ * @param  src_size  input buffer size.
+ * @return error code
+ * @retval 0     succcess
+ * @retval -1    failure
+ */
+int unice68_depacker_head(void * dst, int dst_size, const void * src, int src_size);
+
 UNICE68_API
 /**
  *  Pack a buffer with ice packer.
@@ -33,6 +33,10 @@
 # include <stdint.h>
 #endif
 
+/* rom-properties: Needed for unice68_depacker_head(). */
+#include <stdlib.h>
+#include <string.h>
+
 typedef uint8_t u8;
 typedef  int8_t s8;
 typedef int16_t s16;
@@ -45,8 +49,23 @@ typedef struct {
   dreg_t d0,d1,d2,d3,d4,d5,d6,d7;
   areg_t srcbuf,srcend,dstbuf,dstend;
   int overflow;
+  /* rom-properties: Sliding window for unice68_depacker_head().
+   * window: size of dst buffer, or 0 to depack the entire file.
+   * vbase:  depacked offset of dstbuf[0]. */
+  int window, vbase;
 } all_regs_t;
 
+/* rom-properties: Sliding window parameters.
+ * WINDOW_KEEP:   Bytes above a6 that may still be referenced.
+ *                (longest string is 1033 bytes; farthest offset is
+ *                 0x111e+0x11f, so 0x2000 is plenty.)
+ * WINDOW_MARGIN: Free space needed below a6 before each step.
+ *                (longest direct copy is 0x7fff+270 bytes)
+ * WINDOW_SLACK:  Extra space so the window doesn't slide too often. */
+#define WINDOW_KEEP   0x2000
+#define WINDOW_MARGIN 0x8200
+#define WINDOW_SLACK  0x10000
+
 #define ICE_MAGIC 0x49434521 /* 'ICE!' */
 
 #define B_CC(CC, LABEL) if (CC) {goto LABEL;} else
@@ -97,6 +116,28 @@ static void strings(all_regs_t *);
 static void normal_bytes(all_regs_t *);
 static int get_d0_bits(all_regs_t *, int d0);
 
+/* rom-properties: Slide the window up if a6 is getting close to the
+ * bottom of the dst buffer. Bytes above the kept area are discarded;
+ * they can no longer be referenced. */
+static void slide_window(all_regs_t *R)
+{
+  int delta;
+
+  if (R->vbase <= 0 || R->a6 - R->dstbuf >= WINDOW_MARGIN) {
+    return;
+  }
+  delta = (int)(R->dstend - R->a6) - WINDOW_KEEP;
+  if (delta > R->vbase) {
+    delta = R->vbase;
+  }
+  if (delta <= 0) {
+    return;
+  }
+  memmove(R->a6 + delta, R->a6, (size_t)(R->dstend - R->a6) - delta);
+  R->a6 += delta;
+  R->vbase -= delta;
+}
+
 static inline int chk_dst_range(all_regs_t *R, const areg_t a, const areg_t b)
 {
   R->overflow |= (a <  R->dstbuf) << 0;
@@ -139,7 +180,11 @@ static inline int get_1_bit(all_regs_t *R)
   r = (R->d7 & 255) << 1;
   B_CC(r & 255, bitfound);
 
-  chk_src_range(R,R->a5-1,R->a5-1);
+  /* rom-properties: Don't read out of bounds. */
+  if (chk_src_range(R,R->a5-1,R->a5-1)) {
+    r = 0;
+    goto bitfound;
+  }
 
   r = (r>>8) + (*(--R->a5) << 1);
 bitfound:
@@ -191,7 +236,14 @@ static int ice_decrunch(all_regs_t *R)
   R->srcend = R->a5 = R->a0 - 8 + csize;
   R->d0 = dsize = getinfo(R);
   R->a6 = R->a4 = R->a1;
-  R->a6 += R->d0;
+  if (R->window > 0 && R->window < dsize) {
+    /* rom-properties: Only keep a window of the depacked data. */
+    R->vbase = dsize - R->window;
+    R->a6 += R->window;
+  } else {
+    R->vbase = 0;
+    R->a6 += R->d0;
+  }
   R->dstend = R->a3 = R->a6;
 
   R->d7 = *(--R->a5);
@@ -210,9 +262,24 @@ static int ice_decrunch(all_regs_t *R)
   R->a6 = R->a3;
   GET_1_BIT_BCC(not_packed);
   R->d7 = 0x0f9f;
-  GET_1_BIT_BCC(ice_00);
+  GET_1_BIT_BCC(ice_window);
   R->d7 = R->d1 = get_d0_bits(R, 15);
 
+ice_window:
+  if (R->dstend - R->dstbuf < dsize) {
+    /* rom-properties: Windowed depack. The picture pass works on
+     * independent 8-byte groups going down from the end of the
+     * depacked data, so skip the groups that aren't in the window. */
+    const int above = dsize - (int)(R->dstend - R->dstbuf);
+    const int skip = (above + 7) >> 3;
+    const int groups = DBF_COUNT(R->d7) - skip;
+    if (R->overflow || R->vbase != 0 || groups <= 0) {
+      goto not_packed;
+    }
+    R->d7 = groups - 1;
+    R->a3 = R->dstbuf + (dsize - (skip << 3));
+  }
+
 /* ice_00:      moveq   #3,d6 */
 /* ice_01:      move.w  -(a3),d4 */
 /*      moveq   #3,d5 */
@@ -305,6 +372,11 @@ static void normal_bytes(all_regs_t *R)
   while (1) {
     const int * tab;
 
+    if (R->overflow) {
+      /* rom-properties: Stop on errors. */
+      break;
+    }
+    slide_window(R);
     GET_1_BIT_BCC(test_if_end);
     R->d1 = 0;
     GET_1_BIT_BCC(copy_direkt);
@@ -338,6 +410,7 @@ static void normal_bytes(all_regs_t *R)
       }
       break;
     }
+    slide_window(R);
     strings(R);
   }
 }
@@ -370,7 +443,11 @@ hole_bit_loop:
   r7 = (r7 & 255) << 1;
   B_CC(r7 & 255, on_d0);
 
-  chk_src_range(R,R->a5-1,R->a5-1);
+  /* rom-properties: Don't read out of bounds. */
+  if (chk_src_range(R,R->a5-1,R->a5-1)) {
+    r7 = 0;
+    goto on_d0;
+  }
 
   r7 = (*(--R->a5) << 1) + (r7>>8);
 on_d0:
@@ -478,6 +555,10 @@ less_40:
 depack_bytes:
   R->a1 = R->a6 + 2 + (s16)R->d4 + (s16)R->d1;
   chk_dst_range(R, R->a6 - DBF_COUNT(R->d4) - 1, R->a6-1);
+  /* rom-properties: Don't read past the end of the dst buffer. */
+  if (chk_dst_range(R, R->a1 - DBF_COUNT(R->d4) - 1, R->a1-1)) {
+    return;
+  }
   if (R->a6>R->a4) *(--R->a6) = *(--R->a1);
 dep_b:
   if (R->a6>R->a4) *(--R->a6) = *(--R->a1);
@@ -537,6 +618,56 @@ int unice68_depacker(void * dest, const void * src)
   allregs.a0 = (areg_t)src;
   allregs.a1 = dest;
   allregs.overflow = 0;
+  allregs.window = 0;
+  allregs.vbase = 0;
 
   return ice_decrunch(&allregs);
 }
+
+/* rom-properties: Bounded depacker. */
+int unice68_depacker_head(void * dest, int dest_size,
+                          const void * src, int src_size)
+{
+  all_regs_t allregs;
+  int csize, dsize, win, ret;
+  u8 * buf;
+
+  if (!dest || dest_size <= 0 || !src || src_size < 12) {
+    return -1;
+  }
+  csize = 0;
+  dsize = unice68_depacked_size(src, &csize);
+  if (dsize <= 0 || csize > src_size) {
+    return -1;
+  }
+  if (dest_size > dsize) {
+    dest_size = dsize;
+  }
+
+  /* The window has to hold the requested data, plus the data that
+   * can still be referenced, plus room for the next step. If the
+   * depacked data isn't much larger than that, depack all of it. */
+  win = dest_size + WINDOW_KEEP + WINDOW_MARGIN + WINDOW_SLACK;
+  if (dest_size == dsize) {
+    return unice68_depacker(dest, src);
+  } else if (win >= dsize) {
+    win = dsize;
+  }
+
+  buf = (u8 *)malloc(win);
+  if (!buf) {
+    return -1;
+  }
+
+  memset(&allregs, 0, sizeof(allregs));
+  allregs.a0 = (areg_t)src;
+  allregs.a1 = buf;
+  allregs.window = win;
+
+  ret = ice_decrunch(&allregs);
+  if (ret == 0) {
+    memcpy(dest, buf, dest_size);
+  }
+  free(buf);
+  return ret;
+}
@@ -9,6 +9,11 @@
 #include "stdafx.h"
 
 // librpbase, librptexture
+#include "librpbase/config.librpbase.h"
+#include "librpbase/config/Config.hpp"
+#ifdef ENABLE_DECRYPTION
+# include "librpbase/crypto/KeyManager.hpp"
+#endif /* ENABLE_DECRYPTION */
 using namespace LibRpBase;
 using LibRpTexture::rp_image;
 
@@ -21,9 +26,16 @@ using LibRomData::RomDataFactory;
 #include "libromdata/img/TCreateThumbnail.cpp"
 using LibRomData::TCreateThumbnail;
 
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+
+// C includes.
+#include <sys/stat.h>
+
 // C++ STL classes.
 using std::string;
 using std::unique_ptr;
+using std::vector;
 
 // GTK+ major version.
 // We can't simply use GTK_MAJOR_VERSION because
@@ -189,9 +201,11 @@ string CreateThumbnailPrivate::proxyForUrl(const string &url) const
  * @param source_file	[in] Source filename or URI.
  * @param pp_file	[out] Opened file.
  * @param s_uri		[out] Normalized URI. (file:/ for a filename, etc.)
+ * @param enableThumbnailOnNetworkFS [in] Config::enableThumbnailOnNetworkFS()
  * @return 0 on success; RPCT error code on error.
  */
-static int openFromFilenameOrURI(const char *source_file, IRpFile **pp_file, string &s_uri)
+static int openFromFilenameOrURI(const char *source_file, IRpFile **pp_file, string &s_uri,
+	bool enableThumbnailOnNetworkFS)
 {
 	// NOTE: Not checking these in Release builds.
 	assert(source_file != nullptr);
@@ -199,7 +213,6 @@ static int openFromFilenameOrURI(const char *source_file, IRpFile **pp_file, str
 
 	*pp_file = nullptr;
 	s_uri.clear();
-	const bool enableThumbnailOnNetworkFS = Config::instance()->enableThumbnailOnNetworkFS();
 
 	IRpFile *file = nullptr;
 	char *const uri_scheme = g_uri_parse_scheme(source_file);
@@ -288,29 +301,18 @@ static int openFromFilenameOrURI(const char *source_file, IRpFile **pp_file, str
 }
 
 /**
- * Thumbnail creator function for wrapper programs.
- * @param source_file Source file or URI. (UTF-8)
- * @param output_file Output file. (UTF-8)
- * @param maximum_size Maximum size.
+ * Create a thumbnail.
+ * @param d			[in] CreateThumbnailPrivate
+ * @param source_file		[in] Source file or URI. (UTF-8)
+ * @param output_file		[in] Output file. (UTF-8)
+ * @param maximum_size		[in] Maximum size.
+ * @param enableThumbnailOnNetworkFS [in] Config::enableThumbnailOnNetworkFS()
  * @return 0 on success; non-zero on error.
  */
-extern "C"
-G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *output_file, int maximum_size)
+static int createThumbnail(CreateThumbnailPrivate *d,
+	const char *source_file, const char *output_file, int maximum_size,
+	bool enableThumbnailOnNetworkFS)
 {
-	// Some of this is based on the GNOME Thumbnailer skeleton project.
-	// https://github.com/hadess/gnome-thumbnailer-skeleton/blob/master/gnome-thumbnailer-skeleton.c
-
-	if (getuid() == 0 || geteuid() == 0) {
-		g_critical("*** " G_LOG_DOMAIN " does not support running as root.");
-		return RPCT_RUNNING_AS_ROOT;
-	}
-
-	// Make sure glib is initialized.
-	// NOTE: This is a no-op as of glib-2.36.
-#if !GLIB_CHECK_VERSION(2,36,0)
-	g_type_init();
-#endif
-
 	// NOTE: TCreateThumbnail() has wrappers for opening the
 	// ROM file and getting RomData*, but we're doing it here
 	// in order to return better error codes.
@@ -318,7 +320,7 @@ G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *out
 	// Attempt to open the ROM file.
 	IRpFile *file = nullptr;
 	string s_uri;
-	int ret = openFromFilenameOrURI(source_file, &file, s_uri);
+	int ret = openFromFilenameOrURI(source_file, &file, s_uri, enableThumbnailOnNetworkFS);
 	if (ret != 0) {
 		// Error opening the file.
 		return ret;
@@ -336,10 +338,9 @@ G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *out
 
 	// Create the thumbnail.
 	// TODO: If image is larger than maximum_size, resize down.
-	unique_ptr<CreateThumbnailPrivate> d(new CreateThumbnailPrivate());
 	CreateThumbnailPrivate::GetThumbnailOutParams_t outParams;
 	ret = d->getThumbnail(romData, maximum_size, &outParams);
-	if (ret != 0 || !d->isImgClassValid(outParams.retImg)) {
+	if (ret != 0 || (outParams.pngData.empty() && !d->isImgClassValid(outParams.retImg))) {
 		// No image.
 		if (outParams.retImg) {
 			d->freeImgClass(outParams.retImg);
@@ -349,6 +350,7 @@ G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *out
 	}
 
 	// Save the image using RpPngWriter.
+	unique_ptr<RpPngWriter> pngWriter;
 	unique_ptr<const uint8_t*[]> row_pointers;
 	guchar *pixels;
 	int rowstride;
@@ -361,18 +363,6 @@ G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *out
 	GFile *f_src = nullptr;
 	const char *mimeType;
 
-	// gdk-pixbuf doesn't support CI8, so we'll assume all
-	// images are ARGB32. (Well, ABGR32, but close enough.)
-	// TODO: Verify channels, etc.?
-	unique_ptr<RpPngWriter> pngWriter(new RpPngWriter(output_file,
-		outParams.thumbSize.width, outParams.thumbSize.height,
-		rp_image::FORMAT_ARGB32));
-	if (!pngWriter->isOpen()) {
-		// Could not open the PNG writer.
-		ret = RPCT_OUTPUT_FILE_FAILED;
-		goto cleanup;
-	}
-
 	/** tEXt chunks. **/
 	// NOTE: These are written before IHDR in order to put the
 	// tEXt chunks before the IDAT chunk.
@@ -448,6 +438,39 @@ G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *out
 	// - https://specifications.freedesktop.org/thumbnail-spec/thumbnail-spec-latest.html
 	kv.emplace_back("Thumb::URI", s_uri.c_str());
 
+	if (!outParams.pngData.empty()) {
+		// PNG pass-through: Copy the original PNG image
+		// with the tEXt chunks added.
+		RpFile *const pngFile = new RpFile(output_file, RpFile::FM_CREATE_WRITE);
+		pwRet = (pngFile->isOpen()
+			? RpPngWriter::copy_with_tEXt(pngFile,
+				outParams.pngData.data(), outParams.pngData.size(), kv)
+			: -EIO);
+		pngFile->unref();
+		if (pwRet != 0) {
+			// Error writing the PNG image.
+			// TODO: Unlink the PNG image.
+			ret = RPCT_OUTPUT_FILE_FAILED;
+		}
+		goto cleanup;
+	}
+
+	// gdk-pixbuf doesn't support CI8, so we'll assume all
+	// images are ARGB32. (Well, ABGR32, but close enough.)
+	// TODO: Verify channels, etc.?
+	pngWriter.reset(new RpPngWriter(output_file,
+		outParams.thumbSize.width, outParams.thumbSize.height,
+		rp_image::FORMAT_ARGB32));
+	if (!pngWriter->isOpen()) {
+		// Could not open the PNG writer.
+		ret = RPCT_OUTPUT_FILE_FAILED;
+		goto cleanup;
+	}
+
+	// Thumbnails are regenerated whenever the cache is rebuilt,
+	// so use the fast encoding profile.
+	pngWriter->setProfile(RpPngWriter::PROFILE_FAST);
+
 	// Write the tEXt chunks.
 	pngWriter->write_tEXt(kv);
 
@@ -495,7 +518,201 @@ G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *out
 	}
 
 cleanup:
-	d->freeImgClass(outParams.retImg);
+	if (outParams.retImg) {
+		d->freeImgClass(outParams.retImg);
+	}
 	romData->unref();
 	return ret;
 }
+
+/**
+ * Thumbnail creator function for wrapper programs.
+ * @param source_file Source file or URI. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param maximum_size Maximum size.
+ * @return 0 on success; non-zero on error.
+ */
+extern "C"
+G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *output_file, int maximum_size)
+{
+	// Some of this is based on the GNOME Thumbnailer skeleton project.
+	// https://github.com/hadess/gnome-thumbnailer-skeleton/blob/master/gnome-thumbnailer-skeleton.c
+
+	if (getuid() == 0 || geteuid() == 0) {
+		g_critical("*** " G_LOG_DOMAIN " does not support running as root.");
+		return RPCT_RUNNING_AS_ROOT;
+	}
+
+	// Make sure glib is initialized.
+	// NOTE: This is a no-op as of glib-2.36.
+#if !GLIB_CHECK_VERSION(2,36,0)
+	g_type_init();
+#endif
+
+	unique_ptr<CreateThumbnailPrivate> d(new CreateThumbnailPrivate());
+	d->setPngPassthrough(true);
+	return createThumbnail(d.get(), source_file, output_file, maximum_size,
+		Config::instance()->enableThumbnailOnNetworkFS());
+}
+
+// Number of upcoming files to prefetch in rp_create_thumbnail_batch().
+#define BATCH_READAHEAD_FILES 4
+// Size of the header window to prefetch for each file.
+// Most RomData subclasses can identify the file and load
+// the fields needed for thumbnailing from this window.
+#define BATCH_READAHEAD_SIZE (64U*1024U)
+
+/**
+ * rp_create_thumbnail_batch() work item.
+ */
+struct BatchItem_t {
+	unsigned int idx;	// Index in the entries array.
+	dev_t dev;		// Device. (0 if not a local file)
+	ino_t ino;		// Inode. (0 if not a local file)
+	gchar *filename;	// Local filename to prefetch. (nullptr if none)
+};
+
+/**
+ * Get the local filename for a source file or URI.
+ * @param source_file Source file or URI. (UTF-8)
+ * @return Local filename (free with g_free()), or nullptr if it isn't a local file.
+ */
+static gchar *getLocalFilename(const char *source_file)
+{
+	char *const uri_scheme = g_uri_parse_scheme(source_file);
+	if (uri_scheme != nullptr) {
+		// This is a URI.
+		g_free(uri_scheme);
+		return g_filename_from_uri(source_file, nullptr, nullptr);
+	}
+
+	// This is a filename.
+	return g_strdup(source_file);
+}
+
+/**
+ * Batch thumbnail creator function for wrapper programs.
+ *
+ * Entries are processed in physical order (device, then inode) on the
+ * global thread pool, with readahead issued for the headers of upcoming
+ * files. All entries share the same configuration and key state.
+ *
+ * @param entries	[in/out] Batch entries.
+ * @param count		[in] Number of entries.
+ * @return 0 if the batch was processed (check each entry's result); non-zero on error.
+ */
+extern "C"
+G_MODULE_EXPORT int rp_create_thumbnail_batch(RpCreateThumbnailBatchEntry *entries, unsigned int count)
+{
+	if (getuid() == 0 || geteuid() == 0) {
+		g_critical("*** " G_LOG_DOMAIN " does not support running as root.");
+		return RPCT_RUNNING_AS_ROOT;
+	}
+
+	assert(entries != nullptr || count == 0);
+	if (!entries || count == 0) {
+		// Nothing to do.
+		return RPCT_SUCCESS;
+	}
+
+	// Make sure glib is initialized.
+	// NOTE: This is a no-op as of glib-2.36.
+#if !GLIB_CHECK_VERSION(2,36,0)
+	g_type_init();
+#endif
+
+	// Load the configuration and keys once for the entire batch.
+	// This also prevents the worker threads from racing to load them.
+	const Config *const config = Config::instance();
+	const bool enableThumbnailOnNetworkFS = config->enableThumbnailOnNetworkFS();
+#ifdef ENABLE_DECRYPTION
+	KeyManager::instance()->load();
+#endif /* ENABLE_DECRYPTION */
+
+	unique_ptr<CreateThumbnailPrivate> d(new CreateThumbnailPrivate());
+	d->setPngPassthrough(true);
+	d->setConfig(config);
+
+	// Sort the entries by physical location.
+	// Local files are sorted by device and inode, which usually matches
+	// the on-disk order closely enough to avoid most seeks on rotational
+	// media. Anything that can't be stat()'d is processed last.
+	vector<BatchItem_t> items(count);
+	for (unsigned int i = 0; i < count; i++) {
+		BatchItem_t &item = items[i];
+		item.idx = i;
+		item.dev = 0;
+		item.ino = 0;
+		item.filename = nullptr;
+		entries[i].result = RPCT_SOURCE_FILE_ERROR;
+
+		gchar *const filename = getLocalFilename(entries[i].source_file);
+		if (!filename)
+			continue;
+
+		struct stat sb;
+		if (stat(filename, &sb) != 0 || !S_ISREG(sb.st_mode) ||
+		    FileSystem::isOnBadFS(filename, enableThumbnailOnNetworkFS))
+		{
+			// Not a regular file on a "good" file system.
+			// Don't prefetch it.
+			g_free(filename);
+			continue;
+		}
+
+		item.dev = sb.st_dev;
+		item.ino = sb.st_ino;
+		item.filename = filename;
+	}
+	std::stable_sort(items.begin(), items.end(),
+		[](const BatchItem_t &a, const BatchItem_t &b) {
+			// Non-local files go last.
+			if (!a.filename || !b.filename) {
+				return (a.filename != nullptr && b.filename == nullptr);
+			}
+			if (a.dev != b.dev) {
+				return (a.dev < b.dev);
+			}
+			return (a.ino < b.ino);
+		}
+	);
+
+	// Prefetch the first few files.
+	const size_t itemCount = items.size();
+	auto prefetch = [&items](size_t i) {
+		const BatchItem_t &item = items[i];
+		if (!item.filename)
+			return;
+		// NOTE: The readahead isn't cancelled when the file is closed.
+		RpFile *const file = new RpFile(item.filename, RpFile::FM_OPEN_READ);
+		if (file->isOpen()) {
+			file->prefetch(0, BATCH_READAHEAD_SIZE);
+		}
+		file->unref();
+	};
+	for (size_t i = 0; i < BATCH_READAHEAD_FILES && i < itemCount; i++) {
+		prefetch(i);
+	}
+
+	// Process the entries.
+	// Chunks are handed out in ascending order, so the readahead
+	// for entry i+BATCH_READAHEAD_FILES is issued while entry i
+	// is being processed.
+	auto fn = [&](size_t begin, size_t end, ScratchArena *arena) {
+		RP_UNUSED(arena);
+		for (size_t i = begin; i < end; i++) {
+			if (i + BATCH_READAHEAD_FILES < itemCount) {
+				prefetch(i + BATCH_READAHEAD_FILES);
+			}
+			RpCreateThumbnailBatchEntry &entry = entries[items[i].idx];
+			entry.result = createThumbnail(d.get(),
+				entry.source_file, entry.output_file, entry.maximum_size,
+				enableThumbnailOnNetworkFS);
+		}
+	};
+	ThreadPool::instance()->parallelFor(0, itemCount, 1, fn);
+
+	std::for_each(items.begin(), items.end(),
+		[](BatchItem_t &item) { g_free(item.filename); });
+	return RPCT_SUCCESS;
+}
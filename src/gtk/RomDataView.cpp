@@ -20,8 +20,8 @@ using LibRpFile::RpFile;
 using LibRpTexture::rp_image;
 
 // libromdata
-#include "libromdata/RomDataFactory.hpp"
-using LibRomData::RomDataFactory;
+#include "libromdata/RomDataLoader.hpp"
+using LibRomData::RomDataLoader;
 
 // C++ includes.
 using std::array;
@@ -80,9 +80,12 @@ static void	rom_data_view_desc_format_type_changed(RpDescFormatType desc_format_
 						 RomDataView	*page);
 
 static void	rom_data_view_init_header_row	(RomDataView	*page);
+static void	rom_data_view_init_header_images(RomDataView	*page);
 static void	rom_data_view_update_display	(RomDataView	*page);
 static gboolean	rom_data_view_load_rom_data	(gpointer	 data);
+static void	rom_data_view_cancel_loader	(RomDataView	*page);
 static void	rom_data_view_delete_tabs	(RomDataView	*page);
+static gboolean	rom_data_view_listdata_idle	(gpointer	 data);
 
 /** Signal handlers. **/
 static void	checkbox_no_toggle_signal_handler   (GtkToggleButton	*togglebutton,
@@ -129,12 +132,41 @@ struct Data_ListDataMulti_t {
 		, field(field) { }
 };
 
+// RFT_LISTDATA incremental fill state.
+// Large lists are filled in chunks from an idle handler
+// so the rest of the page can be displayed immediately.
+struct Data_ListDataFill_t {
+	GtkListStore *listStore;
+	GtkTreeView *treeView;
+	const RomFields::Field *field;
+	const RomFields::ListData_t *list_data;
+	unsigned int row;	// Next row in list_data.
+	uint32_t checkboxes;	// Remaining checkbox bits.
+	int col_start;		// First string column.
+	bool isMulti;		// RFT_LISTDATA_MULTI: placeholder rows only.
+
+	Data_ListDataFill_t(
+		GtkListStore *listStore,
+		GtkTreeView *treeView,
+		const RomFields::Field *field,
+		const RomFields::ListData_t *list_data)
+		: listStore(listStore)
+		, treeView(treeView)
+		, field(field)
+		, list_data(list_data)
+		, row(0)
+		, checkboxes(0)
+		, col_start(0)
+		, isMulti(false) { }
+};
+
 // GTK+ property page instance.
 struct _RomDataView {
 	super __parent__;
 
 	/* Timeouts */
 	guint		changed_idle;
+	guint		listdata_idle;
 
 	// Header row.
 	GtkWidget	*hboxHeaderRow_outer;
@@ -149,6 +181,10 @@ struct _RomDataView {
 	// ROM data.
 	RomData		*romData;
 
+	// Asynchronous loader.
+	// This is only set while the RomData object is being loaded.
+	RomDataLoader	*loader;
+
 	// Tab layout.
 	GtkWidget	*tabWidget;
 	struct tab {
@@ -175,6 +211,9 @@ struct _RomDataView {
 
 	// RFT_LISTDATA_MULTI value GtkListStores.
 	vector<Data_ListDataMulti_t> *vecListDataMulti;
+
+	// RFT_LISTDATA fields that are still being filled.
+	vector<Data_ListDataFill_t> *vecListDataFill;
 };
 
 // NOTE: G_DEFINE_TYPE() doesn't work in C++ mode with gcc-6.2
@@ -300,6 +339,7 @@ rom_data_view_init(RomDataView *page)
 	// No ROM data initially.
 	page->uri = nullptr;
 	page->romData = nullptr;
+	page->loader = nullptr;
 	page->tabWidget = nullptr;
 	page->tabs = new vector<RomDataView::tab>();
 
@@ -312,6 +352,7 @@ rom_data_view_init(RomDataView *page)
 	page->vecDescLabels = new vector<GtkWidget*>();
 	page->vecStringMulti = new vector<Data_StringMulti_t>();
 	page->vecListDataMulti = new vector<Data_ListDataMulti_t>();
+	page->vecListDataFill = new vector<Data_ListDataFill_t>();
 
 	/**
 	 * Base class is:
@@ -393,6 +434,9 @@ rom_data_view_dispose(GObject *object)
 		page->changed_idle = 0;
 	}
 
+	// Cancel the loader, if it's still running.
+	rom_data_view_cancel_loader(page);
+
 	// Delete the icon frames and tabs.
 	rom_data_view_delete_tabs(page);
 
@@ -415,6 +459,7 @@ rom_data_view_finalize(GObject *object)
 	delete page->set_lc;
 	delete page->vecStringMulti;
 	delete page->vecListDataMulti;
+	delete page->vecListDataFill;
 
 	// Unreference romData.
 	if (page->romData) {
@@ -515,6 +560,9 @@ rom_data_view_set_uri(RomDataView	*page,
 		g_free(page->uri);
 		page->uri = nullptr;
 
+		// Cancel the loader, if it's still running.
+		rom_data_view_cancel_loader(page);
+
 		// Unreference the existing RomData object.
 		if (page->romData) {
 			page->romData->unref();
@@ -628,11 +676,29 @@ rom_data_view_init_header_row(RomDataView *page)
 		C_("RomDataView", "%1$s\n%2$s"), systemName, fileType);
 	gtk_label_set_text(GTK_LABEL(page->lblSysInfo), sysInfo.c_str());
 
+	// Banner and icon are shown once they're loaded.
+	gtk_widget_hide(page->imgBanner);
+	gtk_widget_hide(page->imgIcon);
+
+	// Show the header row. (outer box)
+	gtk_widget_show(page->hboxHeaderRow);
+	gtk_widget_show(page->hboxHeaderRow_outer);
+}
+
+static void
+rom_data_view_init_header_images(RomDataView *page)
+{
+	// Initialize the header row images.
+	// NOTE: The images must have already been loaded by RomDataLoader.
+	assert(page != nullptr);
+	const RomData *const romData = page->romData;
+	if (!romData)
+		return;
+
 	// Supported image types.
 	const uint32_t imgbf = romData->supportedImageTypes();
 
 	// Banner.
-	gtk_widget_hide(page->imgBanner);
 	if (imgbf & RomData::IMGBF_INT_BANNER) {
 		// Get the banner.
 		bool ok = drag_image_set_rp_image(DRAG_IMAGE(page->imgBanner), romData->image(RomData::IMG_INT_BANNER));
@@ -642,7 +708,6 @@ rom_data_view_init_header_row(RomDataView *page)
 	}
 
 	// Icon.
-	gtk_widget_hide(page->imgIcon);
 	if (imgbf & RomData::IMGBF_INT_ICON) {
 		// Get the icon.
 		const rp_image *const icon = romData->image(RomData::IMG_INT_ICON);
@@ -656,12 +721,14 @@ rom_data_view_init_header_row(RomDataView *page)
 			}
 			if (ok) {
 				gtk_widget_show(page->imgIcon);
+				if (gtk_widget_get_mapped(GTK_WIDGET(page))) {
+					// The page was mapped before the icon was loaded,
+					// so the animation timer has to be started here.
+					drag_image_start_anim_timer(DRAG_IMAGE(page->imgIcon));
+				}
 			}
 		}
 	}
-
-	// Show the header row. (outer box)
-	gtk_widget_show(page->hboxHeaderRow_outer);
 }
 
 #if GTK_CHECK_VERSION(3,0,0)
@@ -837,6 +904,86 @@ rom_data_view_init_bitfield(RomDataView *page, const RomFields::Field &field)
 	return widget;
 }
 
+// Number of RFT_LISTDATA rows to add at a time.
+#define LISTDATA_CHUNK_ROWS 256U
+
+/**
+ * Add rows to an RFT_LISTDATA GtkListStore.
+ * @param fill	[in/out] Fill state.
+ * @param count	[in] Maximum number of rows to add.
+ * @return True if there are more rows to add; false if the list is complete.
+ */
+static bool
+rom_data_view_listdata_add_rows(Data_ListDataFill_t &fill, unsigned int count)
+{
+	GtkListStore *const listStore = fill.listStore;
+	const RomFields::Field *const field = fill.field;
+	const auto &listDataDesc = field->desc.list_data;
+	const bool hasCheckboxes = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_CHECKBOXES);
+	const bool hasIcons = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_ICONS);
+
+	const unsigned int rowCount = static_cast<unsigned int>(fill.list_data->size());
+	unsigned int row_end = fill.row + count;
+	if (row_end > rowCount || row_end < fill.row) {
+		row_end = rowCount;
+	}
+
+	for (; fill.row < row_end; fill.row++) {
+		const vector<string> &data_row = fill.list_data->at(fill.row);
+		// FIXME: Skip even if we don't have checkboxes?
+		// (also check other UI frontends)
+		if (hasCheckboxes && data_row.empty()) {
+			// Skip this row.
+			fill.checkboxes >>= 1;
+			continue;
+		}
+
+		GtkTreeIter treeIter;
+		gtk_list_store_append(listStore, &treeIter);
+		if (hasCheckboxes) {
+			// Checkbox column.
+			gtk_list_store_set(listStore, &treeIter,
+				0, (fill.checkboxes & 1), -1);
+			fill.checkboxes >>= 1;
+		} else if (hasIcons) {
+			// Icon column.
+			const rp_image *const icon = field->data.list_data.mxd.icons->at(fill.row);
+			assert(icon != nullptr);
+			if (icon) {
+				PIMGTYPE pixbuf = rp_image_to_PIMGTYPE(icon);
+				if (pixbuf) {
+					// TODO: Ideal icon size?
+					// Using 32x32 for now.
+					static const int icon_sz = 32;
+					// NOTE: GtkCellRendererPixbuf can't scale the
+					// pixbuf itself...
+					if (!PIMGTYPE_size_check(pixbuf, icon_sz, icon_sz)) {
+						// TODO: Use nearest-neighbor if upscaling.
+						// Also, preserve the aspect ratio.
+						PIMGTYPE scaled = PIMGTYPE_scale(pixbuf, icon_sz, icon_sz, true);
+						if (scaled) {
+							PIMGTYPE_destroy(pixbuf);
+							pixbuf = scaled;
+						}
+					}
+					gtk_list_store_set(listStore, &treeIter,
+						0, pixbuf, -1);
+					PIMGTYPE_destroy(pixbuf);
+				}
+			}
+		}
+
+		if (!fill.isMulti) {
+			int col = fill.col_start;
+			for (auto iter = data_row.cbegin(); iter != data_row.cend(); ++iter, col++) {
+				gtk_list_store_set(listStore, &treeIter, col, iter->c_str(), -1);
+			}
+		}
+	}
+
+	return (fill.row < rowCount);
+}
+
 /**
  * Initialize a list data field.
  * @param page	[in] RomDataView object.
@@ -844,7 +991,7 @@ rom_data_view_init_bitfield(RomDataView *page, const RomFields::Field &field)
  * @return Display widget, or nullptr on error.
  */
 static GtkWidget*
-rom_data_view_init_listdata(G_GNUC_UNUSED RomDataView *page, const RomFields::Field &field)
+rom_data_view_init_listdata(RomDataView *page, const RomFields::Field &field)
 {
 	// ListData type. Create a GtkListStore for the data.
 	const auto &listDataDesc = field.desc.list_data;
@@ -938,63 +1085,17 @@ rom_data_view_init_listdata(G_GNUC_UNUSED RomDataView *page, const RomFields::Fi
 	}
 
 	// Add the row data.
-	uint32_t checkboxes = 0;
+	// NOTE: Large lists are filled incrementally from an idle handler.
+	// RFT_LISTDATA_MULTI lists are always filled immediately, since
+	// rom_data_view_update_multi() needs all of the rows.
+	Data_ListDataFill_t fill(listStore, nullptr, &field, list_data);
 	if (hasCheckboxes) {
-		checkboxes = field.data.list_data.mxd.checkboxes;
-	}
-	unsigned int row = 0;	// for icons [TODO: Use iterator?]
-	for (auto iter = list_data->cbegin(); iter != list_data->cend(); ++iter, row++) {
-		const vector<string> &data_row = *iter;
-		// FIXME: Skip even if we don't have checkboxes?
-		// (also check other UI frontends)
-		if (hasCheckboxes && data_row.empty()) {
-			// Skip this row.
-			checkboxes >>= 1;
-			continue;
-		}
-
-		GtkTreeIter treeIter;
-		gtk_list_store_append(listStore, &treeIter);
-		if (hasCheckboxes) {
-			// Checkbox column.
-			gtk_list_store_set(listStore, &treeIter,
-				0, (checkboxes & 1), -1);
-			checkboxes >>= 1;
-		} else if (hasIcons) {
-			// Icon column.
-			const rp_image *const icon = field.data.list_data.mxd.icons->at(row);
-			assert(icon != nullptr);
-			if (icon) {
-				PIMGTYPE pixbuf = rp_image_to_PIMGTYPE(icon);
-				if (pixbuf) {
-					// TODO: Ideal icon size?
-					// Using 32x32 for now.
-					static const int icon_sz = 32;
-					// NOTE: GtkCellRendererPixbuf can't scale the
-					// pixbuf itself...
-					if (!PIMGTYPE_size_check(pixbuf, icon_sz, icon_sz)) {
-						// TODO: Use nearest-neighbor if upscaling.
-						// Also, preserve the aspect ratio.
-						PIMGTYPE scaled = PIMGTYPE_scale(pixbuf, icon_sz, icon_sz, true);
-						if (scaled) {
-							PIMGTYPE_destroy(pixbuf);
-							pixbuf = scaled;
-						}
-					}
-					gtk_list_store_set(listStore, &treeIter,
-						0, pixbuf, -1);
-					PIMGTYPE_destroy(pixbuf);
-				}
-			}
-		}
-
-		if (!isMulti) {
-			int col = col_start;
-			for (auto iter = data_row.cbegin(); iter != data_row.cend(); ++iter, col++) {
-				gtk_list_store_set(listStore, &treeIter, col, iter->c_str(), -1);
-			}
-		}
+		fill.checkboxes = field.data.list_data.mxd.checkboxes;
 	}
+	fill.col_start = col_start;
+	fill.isMulti = isMulti;
+	const bool moreRows = rom_data_view_listdata_add_rows(fill,
+		(isMulti ? static_cast<unsigned int>(list_data->size()) : LISTDATA_CHUNK_ROWS));
 
 	// Scroll area for the GtkTreeView.
 	GtkWidget *widget = gtk_scrolled_window_new(nullptr, nullptr);
@@ -1098,6 +1199,14 @@ rom_data_view_init_listdata(G_GNUC_UNUSED RomDataView *page, const RomFields::Fi
 	if (isMulti) {
 		page->vecListDataMulti->emplace_back(
 			Data_ListDataMulti_t(listStore, GTK_TREE_VIEW(treeView), &field));
+	} else if (moreRows) {
+		// Fill the rest of the list later.
+		fill.treeView = GTK_TREE_VIEW(treeView);
+		g_object_ref(listStore);
+		page->vecListDataFill->push_back(fill);
+		if (page->listdata_idle == 0) {
+			page->listdata_idle = g_idle_add(rom_data_view_listdata_idle, page);
+		}
 	}
 
 	return widget;
@@ -1486,9 +1595,6 @@ rom_data_view_update_display(RomDataView *page)
 	// Delete the icon frames and tabs.
 	rom_data_view_delete_tabs(page);
 
-	// Initialize the header row.
-	rom_data_view_init_header_row(page);
-
 	if (!page->romData) {
 		// No ROM data...
 		return;
@@ -1781,6 +1887,82 @@ rom_data_view_update_display(RomDataView *page)
 	}
 }
 
+/**
+ * RomDataLoader stage notification.
+ * Queued from the worker thread to the UI thread.
+ */
+struct LoaderStage_t {
+	RomDataLoader *loader;	// ref()'d
+	RomDataView *page;	// Only valid if the loader wasn't cancelled.
+	RomDataLoader::Stage stage;
+};
+
+/**
+ * A RomDataLoader stage has completed.
+ * Called on the UI thread.
+ * @param data LoaderStage_t
+ * @return False to remove the idle source.
+ */
+static gboolean
+rom_data_view_loader_stage(gpointer data)
+{
+	LoaderStage_t *const ls = static_cast<LoaderStage_t*>(data);
+	RomDataLoader *const loader = ls->loader;
+
+	// NOTE: If the loader was cancelled, the page might
+	// have been destroyed, so don't touch it.
+	if (!loader->isCancelled()) {
+		RomDataView *const page = ls->page;
+		assert(page->loader == loader);
+		switch (ls->stage) {
+			case RomDataLoader::STAGE_HEADER:
+				// Header-level information is available.
+				page->romData = loader->romData()->ref();
+				rom_data_view_init_header_row(page);
+				break;
+
+			case RomDataLoader::STAGE_FIELDS:
+				// Update the display widgets.
+				rom_data_view_update_display(page);
+				break;
+
+			case RomDataLoader::STAGE_IMAGES:
+				// Internal images are loaded. This is the last stage.
+				rom_data_view_init_header_images(page);
+				rom_data_view_cancel_loader(page);
+				break;
+
+			case RomDataLoader::STAGE_ERROR:
+			default:
+				// The file isn't supported.
+				gtk_widget_hide(page->hboxHeaderRow_outer);
+				rom_data_view_cancel_loader(page);
+				break;
+		}
+	}
+
+	loader->unref();
+	g_free(ls);
+	return false;
+}
+
+/**
+ * RomDataLoader stage notification function.
+ * Called on the worker thread.
+ * @param loader RomDataLoader.
+ * @param stage Stage.
+ * @param userdata RomDataView.
+ */
+static void
+rom_data_view_loader_notify(RomDataLoader *loader, RomDataLoader::Stage stage, gpointer userdata)
+{
+	LoaderStage_t *const ls = static_cast<LoaderStage_t*>(g_malloc(sizeof(LoaderStage_t)));
+	ls->loader = loader->ref();
+	ls->page = static_cast<RomDataView*>(userdata);
+	ls->stage = stage;
+	g_idle_add(rom_data_view_loader_stage, ls);
+}
+
 static gboolean
 rom_data_view_load_rom_data(gpointer data)
 {
@@ -1807,30 +1989,40 @@ rom_data_view_load_rom_data(gpointer data)
 	}
 
 	if (file->isOpen()) {
-		// Create the RomData object.
-		// file is ref()'d by RomData.
-		page->romData = RomDataFactory::create(file);
-
-		// Update the display widgets.
-		rom_data_view_update_display(page);
-
-		// Make sure the underlying file handle is closed,
-		// since we don't need it once the RomData has been
-		// loaded by RomDataView.
-		if (page->romData) {
-			page->romData->close();
-		}
+		// Load the RomData object on a worker thread.
+		// The display widgets are updated as each stage
+		// is completed, so slow files (e.g. disc images on
+		// network shares) don't block the file manager.
+		// NOTE: file is ref()'d by RomDataLoader.
+		rom_data_view_cancel_loader(page);
+		page->loader = new RomDataLoader(file);
+		page->loader->start(rom_data_view_loader_notify, page);
 	}
 	file->unref();
 
 	// Animation timer will be started when the page
-	// receives the "map" signal.
+	// receives the "map" signal, or when the icon is
+	// loaded if the page is already mapped.
 
 	// Clear the timeout.
 	page->changed_idle = 0;
 	return false;
 }
 
+/**
+ * Cancel the RomDataLoader, if one is running.
+ * @param page RomDataView.
+ */
+static void
+rom_data_view_cancel_loader(RomDataView *page)
+{
+	if (page->loader) {
+		page->loader->cancel();
+		page->loader->unref();
+		page->loader = nullptr;
+	}
+}
+
 /**
  * Delete tabs and related widgets.
  * @param page RomDataView.
@@ -1875,6 +2067,18 @@ rom_data_view_delete_tabs(RomDataView *page)
 		page->lstoreLanguage = nullptr;
 	}
 
+	// Stop filling RFT_LISTDATA fields.
+	if (page->listdata_idle > 0) {
+		g_source_remove(page->listdata_idle);
+		page->listdata_idle = 0;
+	}
+	std::for_each(page->vecListDataFill->begin(), page->vecListDataFill->end(),
+		[](Data_ListDataFill_t &fill) {
+			g_object_unref(fill.listStore);
+		}
+	);
+	page->vecListDataFill->clear();
+
 	// Clear the various widget references.
 	page->vecDescLabels->clear();
 	page->set_lc->clear();
@@ -1882,6 +2086,36 @@ rom_data_view_delete_tabs(RomDataView *page)
 	page->vecListDataMulti->clear();
 }
 
+/**
+ * Add more rows to RFT_LISTDATA fields that are still being filled.
+ * @param data RomDataView
+ * @return True if there are more rows to add; false if all lists are complete.
+ */
+static gboolean
+rom_data_view_listdata_idle(gpointer data)
+{
+	RomDataView *const page = ROM_DATA_VIEW(data);
+	if (page->vecListDataFill->empty()) {
+		page->listdata_idle = 0;
+		return false;
+	}
+
+	Data_ListDataFill_t &fill = page->vecListDataFill->front();
+	if (!rom_data_view_listdata_add_rows(fill, LISTDATA_CHUNK_ROWS)) {
+		// This list is complete.
+		// Resize the columns to fit the contents.
+		gtk_tree_view_columns_autosize(fill.treeView);
+		g_object_unref(fill.listStore);
+		page->vecListDataFill->erase(page->vecListDataFill->begin());
+	}
+
+	if (page->vecListDataFill->empty()) {
+		page->listdata_idle = 0;
+		return false;
+	}
+	return true;
+}
+
 /** Signal handlers. **/
 
 /**
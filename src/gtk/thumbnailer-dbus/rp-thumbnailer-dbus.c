@@ -52,6 +52,7 @@ enum RpThumbnailerProperties {
 	PROP_CONNECTION,
 	PROP_CACHE_DIR,
 	PROP_PFN_RP_CREATE_THUMBNAIL,
+	PROP_PFN_RP_CREATE_THUMBNAIL_BATCH,
 	PROP_EXPORTED,
 
 	PROP_LAST
@@ -94,6 +95,11 @@ struct _RpThumbnailerClass {
 
 #define SHUTDOWN_TIMEOUT_SECONDS 30
 
+// Maximum number of requests to process in a single batch.
+// NOTE: Batches are processed on a worker thread, but the results
+// aren't emitted until the entire batch has been processed.
+#define MAX_BATCH_REQUESTS 64
+
 // Thumbnail request information.
 struct request_info {
 	gchar *uri;
@@ -111,6 +117,24 @@ static void request_info_free(gpointer data, G_GNUC_UNUSED gpointer user_data)
 	}
 }
 
+static gint request_info_compare_handle(gconstpointer a, gconstpointer b)
+{
+	const struct request_info *const req = (const struct request_info*)a;
+	const guint handle = GPOINTER_TO_UINT(b);
+	return (req->handle == handle ? 0 : 1);
+}
+
+// Batch of thumbnail requests for the worker thread.
+struct batch_info {
+	RpThumbnailer *thumbnailer;	// ref()'d
+	PFN_RP_CREATE_THUMBNAIL_BATCH pfn_rp_create_thumbnail_batch;
+	unsigned int count;
+	int ret;			// Return value from rp_create_thumbnail_batch().
+	struct request_info *reqs[MAX_BATCH_REQUESTS];
+	gchar *cache_filenames[MAX_BATCH_REQUESTS];
+	RpCreateThumbnailBatchEntry entries[MAX_BATCH_REQUESTS];
+};
+
 struct _RpThumbnailer {
 	GObject __parent__;
 	OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton;
@@ -124,6 +148,9 @@ struct _RpThumbnailer {
 	// Idle function for processing.
 	guint idle_process;
 
+	// Is a batch being processed on the worker thread?
+	bool batch_running;
+
 	// Last handle value.
 	guint last_handle;
 
@@ -141,6 +168,9 @@ struct _RpThumbnailer {
 	// rp_create_thumbnail() function pointer.
 	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail;
 
+	// rp_create_thumbnail_batch() function pointer. (optional)
+	PFN_RP_CREATE_THUMBNAIL_BATCH pfn_rp_create_thumbnail_batch;
+
 	// Is the D-Bus object exported?
 	bool exported;
 };
@@ -216,6 +246,10 @@ rp_thumbnailer_class_init(gpointer g_class, gpointer class_data)
 		g_param_spec_pointer("pfn_rp_create_thumbnail", "pfn_rp_create_thumbnail",
 			"rp_create_thumbnail() function pointer.",
 			(GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY)));
+	g_object_class_install_property(gobject_class, PROP_PFN_RP_CREATE_THUMBNAIL_BATCH,
+		g_param_spec_pointer("pfn_rp_create_thumbnail_batch", "pfn_rp_create_thumbnail_batch",
+			"rp_create_thumbnail_batch() function pointer.",
+			(GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY)));
 	g_object_class_install_property(gobject_class, PROP_EXPORTED,
 		g_param_spec_boolean("exported", "exported", "Is the D-Bus object exported?",
 			false, G_PARAM_READABLE));
@@ -231,6 +265,7 @@ rp_thumbnailer_init(GTypeInstance *instance, gpointer g_class)
 	thumbnailer->shutdown_emitted = false;
 	thumbnailer->timeout_id = 0;
 	thumbnailer->idle_process = 0;
+	thumbnailer->batch_running = false;
 	thumbnailer->last_handle = 0;
 	thumbnailer->request_queue = g_queue_new();
 
@@ -238,6 +273,7 @@ rp_thumbnailer_init(GTypeInstance *instance, gpointer g_class)
 	thumbnailer->connection = NULL;
 	thumbnailer->cache_dir = NULL;
 	thumbnailer->pfn_rp_create_thumbnail = NULL;
+	thumbnailer->pfn_rp_create_thumbnail_batch = NULL;
 	thumbnailer->exported = false;
 }
 
@@ -337,6 +373,9 @@ rp_thumbnailer_get_property(GObject *object,
 		case PROP_PFN_RP_CREATE_THUMBNAIL:
 			g_value_set_pointer(value, (gpointer)thumbnailer->pfn_rp_create_thumbnail);
 			break;
+		case PROP_PFN_RP_CREATE_THUMBNAIL_BATCH:
+			g_value_set_pointer(value, (gpointer)thumbnailer->pfn_rp_create_thumbnail_batch);
+			break;
 		case PROP_EXPORTED:
 			g_value_set_boolean(value, thumbnailer->exported);
 			break;
@@ -386,6 +425,11 @@ rp_thumbnailer_set_property(GObject *object,
 				(PFN_RP_CREATE_THUMBNAIL)g_value_get_pointer(value);
 			break;
 
+		case PROP_PFN_RP_CREATE_THUMBNAIL_BATCH:
+			thumbnailer->pfn_rp_create_thumbnail_batch =
+				(PFN_RP_CREATE_THUMBNAIL_BATCH)g_value_get_pointer(value);
+			break;
+
 		case PROP_EXPORTED:
 			// FIXME: Read-only property.
 			// Need to show some error message...
@@ -452,8 +496,9 @@ rp_thumbnailer_queue(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
 	g_queue_push_tail(thumbnailer->request_queue, req);
 
 	// Make sure the idle process is started.
-	// TODO: Make it multi-threaded? (needs atomic compare and/or mutex...)
-	if (thumbnailer->idle_process == 0) {
+	// If a batch is running, the idle process will be
+	// restarted once the batch is finished.
+	if (thumbnailer->idle_process == 0 && !thumbnailer->batch_running) {
 		thumbnailer->idle_process = g_idle_add((GSourceFunc)rp_thumbnailer_process, thumbnailer);
 	}
 
@@ -478,7 +523,15 @@ rp_thumbnailer_dequeue(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton
 	g_dbus_async_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), invocation, false);
 	g_dbus_async_return_val_if_fail(handle != 0, invocation, false);
 
-	// TODO
+	// Remove the request if it hasn't been processed yet.
+	// NOTE: Requests in a running batch can't be cancelled.
+	GList *const node = g_queue_find_custom(thumbnailer->request_queue,
+		GUINT_TO_POINTER(handle), request_info_compare_handle);
+	if (node) {
+		request_info_free(node->data, NULL);
+		g_queue_delete_link(thumbnailer->request_queue, node);
+	}
+
 	org_freedesktop_thumbnails_specialized_thumbnailer1_complete_dequeue(skeleton, invocation);
 	return true;
 }
@@ -491,7 +544,7 @@ static gboolean
 rp_thumbnailer_timeout(RpThumbnailer *thumbnailer)
 {
 	g_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), false);
-	if (!g_queue_is_empty(thumbnailer->request_queue)) {
+	if (!g_queue_is_empty(thumbnailer->request_queue) || thumbnailer->batch_running) {
 		// Still processing stuff.
 		return true;
 	}
@@ -506,44 +559,30 @@ rp_thumbnailer_timeout(RpThumbnailer *thumbnailer)
 }
 
 /**
- * Process a thumbnail.
+ * Get the thumbnail cache filename for a request.
+ * The thumbnail cache directory is created if it doesn't exist.
+ * On error, the error signal is emitted for the request.
  * @param thumbnailer RpThumbnailer object.
+ * @param req Request.
+ * @return Cache filename (free with g_free()), or NULL on error.
  */
-static gboolean
-rp_thumbnailer_process(RpThumbnailer *thumbnailer)
+static gchar*
+rp_thumbnailer_get_cache_filename(RpThumbnailer *thumbnailer, const struct request_info *req)
 {
-	g_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), FALSE);
-
-	GChecksum *md5 = NULL;
+	GChecksum *md5;
 	const gchar *md5_string;	// owned by md5 object
-	const struct request_info *req;	// request info from the map
-	gchar *cache_filename = NULL;	// cache filename (g_strdup_printf())
+	gchar *cache_filename;		// cache filename (g_malloc())
 	size_t cache_filename_sz;	// size of cache_filename
 	int pos, pos2;			// snprintf() position
-	int ret;
 
-	// Process one thumbnail.
-	req = (struct request_info*)g_queue_pop_head(thumbnailer->request_queue);
-	if (req == NULL) {
-		// Nothing in the queue.
-		goto cleanup;
-	}
-
-	// NOTE: cache_dir and pfn_rp_create_thumbnail should NOT be NULL
-	// at this point, but we're checking it anyway.
+	// NOTE: cache_dir should NOT be NULL at this point,
+	// but we're checking it anyway.
 	if (!thumbnailer->cache_dir || thumbnailer->cache_dir[0] == 0) {
 		// No cache directory...
 		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
 			thumbnailer->skeleton, req->handle, "",
 			0, "Thumbnail cache directory is empty.");
-		goto finished;
-	}
-	if (!thumbnailer->pfn_rp_create_thumbnail) {
-		// No thumbnailer function.
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, "",
-			0, "No thumbnailer function is available.");
-		goto finished;
+		return NULL;
 	}
 
 	// TODO: Make sure the URI to thumbnail is not in the cache directory.
@@ -566,14 +605,16 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
 			thumbnailer->skeleton, req->handle, req->uri,
 			0, "Cannot snprintf() the thumbnail cache directory name.");
-		goto finished;
+		g_free(cache_filename);
+		return NULL;
 	}
 
 	if (g_mkdir_with_parents(cache_filename, 0777) != 0) {
 		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
 			thumbnailer->skeleton, req->handle, req->uri,
 			0, "Cannot mkdir() the thumbnail cache directory.");
-		goto finished;
+		g_free(cache_filename);
+		return NULL;
 	}
 
 	// Reference: https://specifications.freedesktop.org/thumbnail-spec/thumbnail-spec-latest.html
@@ -585,24 +626,39 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
 			thumbnailer->skeleton, req->handle, req->uri,
 			0, "g_checksum_new() does not support MD5.");
-		goto finished;
+		g_free(cache_filename);
+		return NULL;
 	}
 	g_checksum_update(md5, (const guchar*)req->uri, strlen(req->uri));
 	md5_string = g_checksum_get_string(md5);
 
 	// Append the MD5.
 	pos2 = snprintf(&cache_filename[pos], cache_filename_sz - pos, "/%s.png", md5_string);
+	g_checksum_free(md5);
 	// pos and pos2 do NOT include the NULL terminator, so check >=.
 	if (pos2 < 0 || ((size_t)pos + (size_t)pos2) >= cache_filename_sz) {
 		// Not enough memory.
 		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
 			thumbnailer->skeleton, req->handle, req->uri,
 			0, "Cannot snprintf() the thumbnail filename.");
-		goto finished;
+		g_free(cache_filename);
+		return NULL;
 	}
 
-	// Thumbnail the image.
-	ret = thumbnailer->pfn_rp_create_thumbnail(req->uri, cache_filename, req->large ? 256 : 128);
+	return cache_filename;
+}
+
+/**
+ * Emit the result of a thumbnail request.
+ * @param thumbnailer RpThumbnailer object.
+ * @param req Request.
+ * @param cache_filename Cache filename.
+ * @param ret Return value from rp_create_thumbnail().
+ */
+static void
+rp_thumbnailer_emit_result(RpThumbnailer *thumbnailer, const struct request_info *req,
+	const gchar *cache_filename, int ret)
+{
 	if (ret == 0) {
 		// Image thumbnailed successfully.
 		g_debug("rom-properties thumbnail: %s -> %s [OK]", req->uri, cache_filename);
@@ -615,15 +671,203 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 			thumbnailer->skeleton, req->handle, req->uri,
 			2, "Image thumbnailing failed... (TODO: return code)");
 	}
+}
+
+/**
+ * A batch of thumbnails has been processed by the worker thread.
+ * This is run on the main thread.
+ * @param batch Batch.
+ * @return False to remove the idle source.
+ */
+static gboolean
+rp_thumbnailer_batch_finished(struct batch_info *batch)
+{
+	RpThumbnailer *const thumbnailer = batch->thumbnailer;
+	unsigned int i;
+
+	for (i = 0; i < batch->count; i++) {
+		// If the batch failed entirely, report its error for every request.
+		rp_thumbnailer_emit_result(thumbnailer, batch->reqs[i], batch->cache_filenames[i],
+			(batch->ret != 0 ? batch->ret : batch->entries[i].result));
+
+		// Request is finished. Emit the finished signal.
+		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_finished(
+			thumbnailer->skeleton, batch->reqs[i]->handle);
+
+		g_free(batch->cache_filenames[i]);
+		request_info_free(batch->reqs[i], NULL);
+	}
+	thumbnailer->batch_running = false;
+
+	if (!g_queue_is_empty(thumbnailer->request_queue)) {
+		// More requests were queued while the batch was running.
+		if (thumbnailer->idle_process == 0) {
+			thumbnailer->idle_process = g_idle_add((GSourceFunc)rp_thumbnailer_process, thumbnailer);
+		}
+	} else if (G_LIKELY(thumbnailer->timeout_id == 0)) {
+		// Restart the inactivity timeout.
+		thumbnailer->timeout_id = g_timeout_add_seconds(SHUTDOWN_TIMEOUT_SECONDS,
+			(GSourceFunc)rp_thumbnailer_timeout, thumbnailer);
+	}
+
+	g_object_unref(thumbnailer);
+	g_free(batch);
+	return false;
+}
+
+/**
+ * Worker thread for rp_create_thumbnail_batch().
+ * The results are emitted on the main thread.
+ * @param data Batch.
+ * @return NULL
+ */
+static gpointer
+rp_thumbnailer_batch_thread(gpointer data)
+{
+	struct batch_info *const batch = (struct batch_info*)data;
+	batch->ret = batch->pfn_rp_create_thumbnail_batch(batch->entries, batch->count);
+	g_idle_add((GSourceFunc)rp_thumbnailer_batch_finished, batch);
+	return NULL;
+}
+
+/**
+ * Start processing a batch of thumbnails using rp_create_thumbnail_batch().
+ * The batch is processed on a worker thread so the main loop
+ * can continue handling D-Bus requests.
+ * @param thumbnailer RpThumbnailer object.
+ * @return True if a batch was started; false if there were no valid requests.
+ */
+static bool
+rp_thumbnailer_start_batch(RpThumbnailer *thumbnailer)
+{
+	struct batch_info *const batch = g_malloc(sizeof(struct batch_info));
+	GThread *thread;
+	GError *error = NULL;
+
+	// Get the requests.
+	batch->count = 0;
+	batch->ret = 0;
+	while (batch->count < MAX_BATCH_REQUESTS) {
+		struct request_info *const req =
+			(struct request_info*)g_queue_pop_head(thumbnailer->request_queue);
+		if (!req)
+			break;
+
+		gchar *const cache_filename = rp_thumbnailer_get_cache_filename(thumbnailer, req);
+		if (!cache_filename) {
+			// Error signal was already emitted.
+			org_freedesktop_thumbnails_specialized_thumbnailer1_emit_finished(
+				thumbnailer->skeleton, req->handle);
+			request_info_free(req, NULL);
+			continue;
+		}
+
+		const unsigned int i = batch->count;
+		batch->reqs[i] = req;
+		batch->cache_filenames[i] = cache_filename;
+		batch->entries[i].source_file = req->uri;
+		batch->entries[i].output_file = cache_filename;
+		batch->entries[i].maximum_size = (req->large ? 256 : 128);
+		batch->entries[i].result = 0;
+		batch->count++;
+	}
+
+	if (batch->count == 0) {
+		// No valid requests.
+		g_free(batch);
+		return false;
+	}
+
+	batch->thumbnailer = g_object_ref(thumbnailer);
+	batch->pfn_rp_create_thumbnail_batch = thumbnailer->pfn_rp_create_thumbnail_batch;
+	thumbnailer->batch_running = true;
+
+	// Thumbnail the images.
+#if GLIB_CHECK_VERSION(2,32,0)
+	thread = g_thread_try_new("rp-thumbnailer-batch", rp_thumbnailer_batch_thread, batch, &error);
+	if (thread) {
+		// The thread doesn't need to be joined.
+		g_thread_unref(thread);
+	}
+#else /* !GLIB_CHECK_VERSION(2,32,0) */
+	thread = g_thread_create(rp_thumbnailer_batch_thread, batch, false, &error);
+#endif /* GLIB_CHECK_VERSION(2,32,0) */
+	if (!thread) {
+		// Unable to create the thread.
+		// Process the batch on the main thread instead.
+		g_debug("Unable to create the batch thread: %s", (error ? error->message : "unknown error"));
+		g_clear_error(&error);
+		rp_thumbnailer_batch_thread(batch);
+	}
+	return true;
+}
+
+/**
+ * Process a thumbnail.
+ * @param thumbnailer RpThumbnailer object.
+ */
+static gboolean
+rp_thumbnailer_process(RpThumbnailer *thumbnailer)
+{
+	g_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), FALSE);
+
+	struct request_info *req;	// request info from the map
+	gchar *cache_filename = NULL;	// cache filename
+	int ret;
+
+	if (thumbnailer->batch_running) {
+		// A batch is already running. The idle process
+		// will be restarted once the batch is finished.
+		thumbnailer->idle_process = 0;
+		return false;
+	}
+
+	if (thumbnailer->pfn_rp_create_thumbnail_batch) {
+		// Process the queued thumbnails as a batch.
+		if (rp_thumbnailer_start_batch(thumbnailer)) {
+			// The idle process will be restarted
+			// once the batch is finished.
+			thumbnailer->idle_process = 0;
+			return false;
+		}
+		goto cleanup;
+	}
+
+	// Process one thumbnail.
+	req = (struct request_info*)g_queue_pop_head(thumbnailer->request_queue);
+	if (req == NULL) {
+		// Nothing in the queue.
+		goto cleanup;
+	}
+
+	// NOTE: pfn_rp_create_thumbnail should NOT be NULL
+	// at this point, but we're checking it anyway.
+	if (!thumbnailer->pfn_rp_create_thumbnail) {
+		// No thumbnailer function.
+		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
+			thumbnailer->skeleton, req->handle, "",
+			0, "No thumbnailer function is available.");
+		goto finished;
+	}
+
+	cache_filename = rp_thumbnailer_get_cache_filename(thumbnailer, req);
+	if (!cache_filename) {
+		// Error signal was already emitted.
+		goto finished;
+	}
+
+	// Thumbnail the image.
+	ret = thumbnailer->pfn_rp_create_thumbnail(req->uri, cache_filename, req->large ? 256 : 128);
+	rp_thumbnailer_emit_result(thumbnailer, req, cache_filename, ret);
 
 finished:
 	// Request is finished. Emit the finished signal.
 	org_freedesktop_thumbnails_specialized_thumbnailer1_emit_finished(
 		thumbnailer->skeleton, req->handle);
+	request_info_free(req, NULL);
 
 cleanup:
 	// Free allocated things.
-	g_checksum_free(md5);
 	g_free(cache_filename);
 
 	// Return TRUE if we still have more thumbnails queued.
@@ -647,17 +891,20 @@ cleanup:
  * @param connection			[in] GDBusConnection
  * @param cache_dir			[in] Cache directory.
  * @param pfn_rp_create_thumbnail	[in] rp_create_thumbnail() function pointer.
+ * @param pfn_rp_create_thumbnail_batch	[in,opt] rp_create_thumbnail_batch() function pointer.
  * @return RpThumbnailer object.
  */
 RpThumbnailer*
 rp_thumbnailer_new(GDBusConnection *connection,
 	const gchar *cache_dir,
-	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail)
+	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail,
+	PFN_RP_CREATE_THUMBNAIL_BATCH pfn_rp_create_thumbnail_batch)
 {
 	return g_object_new(TYPE_RP_THUMBNAILER,
 		"connection", connection,
 		"cache_dir", cache_dir,
 		"pfn_rp_create_thumbnail", pfn_rp_create_thumbnail,
+		"pfn_rp_create_thumbnail_batch", pfn_rp_create_thumbnail_batch,
 		NULL);
 }
 
@@ -23,6 +23,24 @@ G_BEGIN_DECLS
  */
 typedef int (*PFN_RP_CREATE_THUMBNAIL)(const char *source_file, const char *output_file, int maximum_size);
 
+/**
+ * rp_create_thumbnail_batch() entry.
+ */
+typedef struct _RpCreateThumbnailBatchEntry {
+	const char *source_file;	// [in] Source file. (UTF-8)
+	const char *output_file;	// [in] Output file. (UTF-8)
+	int maximum_size;		// [in] Maximum size.
+	int result;			// [out] 0 on success; non-zero on error.
+} RpCreateThumbnailBatchEntry;
+
+/**
+ * rp_create_thumbnail_batch() function pointer.
+ * @param entries	[in/out] Batch entries.
+ * @param count		[in] Number of entries.
+ * @return 0 if the batch was processed (check each entry's result); non-zero on error.
+ */
+typedef int (*PFN_RP_CREATE_THUMBNAIL_BATCH)(RpCreateThumbnailBatchEntry *entries, unsigned int count);
+
 typedef struct _RpThumbnailerClass	RpThumbnailerClass;
 typedef struct _RpThumbnailer		RpThumbnailer;
 
@@ -37,7 +55,8 @@ GType		rp_thumbnailer_get_type			(void) G_GNUC_CONST G_GNUC_INTERNAL;
 
 RpThumbnailer	*rp_thumbnailer_new			(GDBusConnection *connection,
 							 const gchar *cache_dir,
-							 PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail)
+							 PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail,
+							 PFN_RP_CREATE_THUMBNAIL_BATCH pfn_rp_create_thumbnail_batch)
 							G_GNUC_MALLOC G_GNUC_WARN_UNUSED_RESULT;
 
 gboolean	rp_thumbnailer_is_exported		(RpThumbnailer *thumbnailer);
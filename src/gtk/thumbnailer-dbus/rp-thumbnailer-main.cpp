@@ -152,6 +152,13 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	// The batch thumbnailer function is optional.
+	PFN_RP_CREATE_THUMBNAIL_BATCH pfn_rp_create_thumbnail_batch =
+		(PFN_RP_CREATE_THUMBNAIL_BATCH)dlsym(pDll, "rp_create_thumbnail_batch");
+	if (!pfn_rp_create_thumbnail_batch) {
+		g_debug("rp_create_thumbnail_batch() is not available; thumbnails will not be batched.");
+	}
+
 	GError *error = nullptr;
 	GDBusConnection *const connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
 	if (error) {
@@ -165,7 +172,7 @@ int main(int argc, char *argv[])
 
 	// Create the RpThumbnail service object.
 	RpThumbnailer *const thumbnailer = rp_thumbnailer_new(
-		connection, cache_dir.c_str(), pfn_rp_create_thumbnail);
+		connection, cache_dir.c_str(), pfn_rp_create_thumbnail, pfn_rp_create_thumbnail_batch);
 
 	// Register the D-Bus service.
 	g_bus_own_name_on_connection(connection,
@@ -52,6 +52,8 @@ int rpt_do_security_options(void)
 		SCMP_SYS(getppid),	// dll-search.c: walk_proc_tree()
 		SCMP_SYS(getuid),	// TODO: Only use geteuid()?
 		SCMP_SYS(lseek), SCMP_SYS(_llseek),
+		SCMP_SYS(fadvise64), SCMP_SYS(fadvise64_64),	// RpFile::prefetch()
+		SCMP_SYS(inotify_init1), SCMP_SYS(inotify_add_watch),	// LibRpBase::ConfReader
 		SCMP_SYS(lstat), SCMP_SYS(lstat64),	// LibRpBase::FileSystem::is_symlink(), resolve_symlink()
 		SCMP_SYS(mkdir),	// g_mkdir_with_parents() [rp_thumbnailer_process()]
 		SCMP_SYS(mmap),		// iconv_open(), dlopen()
@@ -26,6 +26,10 @@ using std::vector;
 // Custom Qt widgets.
 #include "DragImageTreeWidget.hpp"
 
+// libromdata
+#include "libromdata/RomDataLoader.hpp"
+using LibRomData::RomDataLoader;
+
 // KAcceleratorManager
 #if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
 # include <KAcceleratorManager>
@@ -71,15 +75,42 @@ class RomDataViewPrivate
 		typedef std::pair<QTreeWidget*, const RomFields::Field*> Data_ListDataMulti_t;
 		vector<Data_ListDataMulti_t> vecListDataMulti;
 
+		// RFT_LISTDATA incremental fill state.
+		// Large lists are filled in chunks from a zero-interval
+		// timer so the rest of the page can be displayed immediately.
+		struct Data_ListDataFill_t {
+			QTreeWidget *treeWidget;
+			const RomFields::Field *field;
+			const RomFields::ListData_t *list_data;
+			unsigned int row;	// Next row in list_data.
+			uint32_t checkboxes;	// Remaining checkbox bits.
+			Qt::ItemFlags itemFlags;
+			bool isMulti;		// RFT_LISTDATA_MULTI: placeholder rows only.
+		};
+		vector<Data_ListDataFill_t> vecListDataFill;
+		QTimer *tmrListDataFill;
+
 		// RomData object.
 		RomData *romData;
 
+		// Asynchronous loader.
+		// This is only set while the RomData object is being loaded.
+		RomDataLoader *loader;
+
 		/**
 		 * Initialize the header row widgets.
 		 * The widgets must have already been created by ui.setupUi().
+		 * NOTE: Only the system information is initialized here.
+		 * The images are initialized by initHeaderImages().
 		 */
 		void initHeaderRow(void);
 
+		/**
+		 * Initialize the header row images.
+		 * The images must have already been loaded by RomDataLoader.
+		 */
+		void initHeaderImages(void);
+
 		/**
 		 * Clear a QLayout.
 		 * @param layout QLayout.
@@ -120,6 +151,14 @@ class RomDataViewPrivate
 		 */
 		void initListData(QLabel *lblDesc, const RomFields::Field &field);
 
+		/**
+		 * Add rows to an RFT_LISTDATA QTreeWidget.
+		 * @param fill	[in/out] Fill state.
+		 * @param count	[in] Maximum number of rows to add.
+		 * @return True if there are more rows to add; false if the list is complete.
+		 */
+		static bool addListDataRows(Data_ListDataFill_t &fill, unsigned int count);
+
 		/**
 		 * Adjust an RFT_LISTDATA field if it's the last field in a tab.
 		 * @param tabIdx Tab index.
@@ -166,6 +205,26 @@ class RomDataViewPrivate
 		 * be deleted and recreated.
 		 */
 		void initDisplayWidgets(void);
+
+		/**
+		 * Start loading the RomData object on a worker thread.
+		 * Any running loader is cancelled first.
+		 */
+		void startLoader(void);
+
+		/**
+		 * Cancel the RomDataLoader, if one is running.
+		 */
+		void cancelLoader(void);
+
+		/**
+		 * RomDataLoader stage notification function.
+		 * Called on the worker thread.
+		 * @param loader RomDataLoader.
+		 * @param stage Stage.
+		 * @param userdata RomDataView.
+		 */
+		static void loaderNotify(RomDataLoader *loader, RomDataLoader::Stage stage, void *userdata);
 };
 
 /** RomDataViewPrivate **/
@@ -174,7 +233,9 @@ RomDataViewPrivate::RomDataViewPrivate(RomDataView *q, RomData *romData)
 	: q_ptr(q)
 	, def_lc(0)
 	, cboLanguage(nullptr)
+	, tmrListDataFill(nullptr)
 	, romData(romData->ref())
+	, loader(nullptr)
 {
 	// Register RpQImageBackend.
 	// TODO: Static initializer somewhere?
@@ -183,6 +244,7 @@ RomDataViewPrivate::RomDataViewPrivate(RomDataView *q, RomData *romData)
 
 RomDataViewPrivate::~RomDataViewPrivate()
 {
+	cancelLoader();
 	ui.lblIcon->clearRp();
 	ui.lblBanner->clearRp();
 	if (romData) {
@@ -224,6 +286,20 @@ void RomDataViewPrivate::initHeaderRow(void)
 	ui.lblSysInfo->setText(sysInfo);
 	ui.lblSysInfo->show();
 
+	// Banner and icon are shown once they're loaded.
+	ui.lblBanner->hide();
+	ui.lblIcon->hide();
+}
+
+/**
+ * Initialize the header row images.
+ * The images must have already been loaded by RomDataLoader.
+ */
+void RomDataViewPrivate::initHeaderImages(void)
+{
+	if (!romData)
+		return;
+
 	// Supported image types.
 	const uint32_t imgbf = romData->supportedImageTypes();
 
@@ -250,6 +326,11 @@ void RomDataViewPrivate::initHeaderRow(void)
 				ok = ui.lblIcon->setRpImage(icon);
 			}
 			ui.lblIcon->setVisible(ok);
+			if (ok && q_ptr->isVisible()) {
+				// The page was shown before the icon was loaded,
+				// so the animation timer has to be started here.
+				ui.lblIcon->startAnimTimer();
+			}
 		} else {
 			// No icon.
 			ui.lblIcon->hide();
@@ -441,6 +522,84 @@ void RomDataViewPrivate::initBitfield(QLabel *lblDesc, const RomFields::Field &f
 	tabs[field.tabIdx].form->addRow(lblDesc, gridLayout);
 }
 
+// RFT_LISTDATA format table.
+// All values are known to fit in uint8_t.
+// NOTE: Need to include AlignVCenter.
+static const uint8_t listdata_align_tbl[4] = {
+	// Order: TXA_D, TXA_L, TXA_C, TXA_R
+	Qt::AlignLeft | Qt::AlignVCenter,
+	Qt::AlignLeft | Qt::AlignVCenter,
+	Qt::AlignCenter,
+	Qt::AlignRight | Qt::AlignVCenter,
+};
+
+// Number of RFT_LISTDATA rows to add at a time.
+#define LISTDATA_CHUNK_ROWS 256U
+
+/**
+ * Add rows to an RFT_LISTDATA QTreeWidget.
+ * @param fill [in/out] Fill state.
+ * @param count [in] Maximum number of rows to add.
+ * @return True if there are more rows to add; false if the list is complete.
+ */
+bool RomDataViewPrivate::addListDataRows(Data_ListDataFill_t &fill, unsigned int count)
+{
+	QTreeWidget *const treeWidget = fill.treeWidget;
+	const RomFields::Field *const field = fill.field;
+	const auto &listDataDesc = field->desc.list_data;
+	const bool hasCheckboxes = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_CHECKBOXES);
+	const bool hasIcons = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_ICONS);
+
+	const unsigned int rowCount = static_cast<unsigned int>(fill.list_data->size());
+	unsigned int row_end = fill.row + count;
+	if (row_end > rowCount || row_end < fill.row) {
+		row_end = rowCount;
+	}
+
+	for (; fill.row < row_end; fill.row++) {
+		const vector<string> &data_row = fill.list_data->at(fill.row);
+		// FIXME: Skip even if we don't have checkboxes?
+		// (also check other UI frontends)
+		if (hasCheckboxes && data_row.empty()) {
+			// Skip this row.
+			fill.checkboxes >>= 1;
+			continue;
+		}
+
+		QTreeWidgetItem *const treeWidgetItem = new QTreeWidgetItem(treeWidget);
+		if (hasCheckboxes) {
+			// The checkbox will only show up if setCheckState()
+			// is called at least once, regardless of value.
+			treeWidgetItem->setCheckState(0, (fill.checkboxes & 1) ? Qt::Checked : Qt::Unchecked);
+			fill.checkboxes >>= 1;
+		} else if (hasIcons) {
+			const rp_image *const icon = field->data.list_data.mxd.icons->at(fill.row);
+			if (icon) {
+				treeWidgetItem->setIcon(0, QIcon(
+					QPixmap::fromImage(rpToQImage(icon))));
+				treeWidgetItem->setData(0, DragImageTreeWidget::RpImageRole,
+					QVariant::fromValue((void*)icon));
+			}
+		}
+
+		// Set item flags.
+		treeWidgetItem->setFlags(fill.itemFlags);
+
+		int col = 0;
+		uint32_t align = listDataDesc.alignment.data;
+		for (auto iter = data_row.cbegin(); iter != data_row.cend(); ++iter) {
+			if (!fill.isMulti) {
+				treeWidgetItem->setData(col, Qt::DisplayRole, U82Q(*iter));
+			}
+			treeWidgetItem->setTextAlignment(col, listdata_align_tbl[align & 3]);
+			col++;
+			align >>= 2;
+		}
+	}
+
+	return (fill.row < rowCount);
+}
+
 /**
  * Initialize a list data field.
  * @param lblDesc Description label.
@@ -534,17 +693,6 @@ void RomDataViewPrivate::initListData(QLabel *lblDesc, const RomFields::Field &f
 	// while others might take up three or more.
 	treeWidget->setUniformRowHeights(false);
 
-	// Format table.
-	// All values are known to fit in uint8_t.
-	// NOTE: Need to include AlignVCenter.
-	static const uint8_t align_tbl[4] = {
-		// Order: TXA_D, TXA_L, TXA_C, TXA_R
-		Qt::AlignLeft | Qt::AlignVCenter,
-		Qt::AlignLeft | Qt::AlignVCenter,
-		Qt::AlignCenter,
-		Qt::AlignRight | Qt::AlignVCenter,
-	};
-
 	// Set up the column names.
 	treeWidget->setColumnCount(colCount);
 	if (listDataDesc.names) {
@@ -554,7 +702,7 @@ void RomDataViewPrivate::initListData(QLabel *lblDesc, const RomFields::Field &f
 		uint32_t align = listDataDesc.alignment.headers;
 		auto iter = listDataDesc.names->cbegin();
 		for (int col = 0; col < colCount; col++, ++iter, align >>= 2) {
-			header->setTextAlignment(col, align_tbl[align & 3]);
+			header->setTextAlignment(col, listdata_align_tbl[align & 3]);
 
 			const string &name = *iter;
 			if (!name.empty()) {
@@ -579,55 +727,24 @@ void RomDataViewPrivate::initListData(QLabel *lblDesc, const RomFields::Field &f
 
 	// Add the row data.
 	// NOTE: For RFT_STRING_MULTI, we're only adding placeholder rows.
-	uint32_t checkboxes = 0;
-	if (hasCheckboxes) {
-		checkboxes = field.data.list_data.mxd.checkboxes;
-	}
-
-	unsigned int row = 0;	// for icons [TODO: Use iterator?]
-	for (auto iter = list_data->cbegin(); iter != list_data->cend(); ++iter, row++) {
-		const vector<string> &data_row = *iter;
-		// FIXME: Skip even if we don't have checkboxes?
-		// (also check other UI frontends)
-		if (hasCheckboxes && data_row.empty()) {
-			// Skip this row.
-			checkboxes >>= 1;
-			continue;
-		}
-
-		QTreeWidgetItem *const treeWidgetItem = new QTreeWidgetItem(treeWidget);
-		if (hasCheckboxes) {
-			// The checkbox will only show up if setCheckState()
-			// is called at least once, regardless of value.
-			treeWidgetItem->setCheckState(0, (checkboxes & 1) ? Qt::Checked : Qt::Unchecked);
-			checkboxes >>= 1;
-		} else if (hasIcons) {
-			const rp_image *const icon = field.data.list_data.mxd.icons->at(row);
-			if (icon) {
-				treeWidgetItem->setIcon(0, QIcon(
-					QPixmap::fromImage(rpToQImage(icon))));
-				treeWidgetItem->setData(0, DragImageTreeWidget::RpImageRole,
-					QVariant::fromValue((void*)icon));
-			}
-		}
-
-		// Set item flags.
-		treeWidgetItem->setFlags(itemFlags);
-
-		int col = 0;
-		uint32_t align = listDataDesc.alignment.data;
-		for (auto iter = data_row.cbegin(); iter != data_row.cend(); ++iter) {
-			if (!isMulti) {
-				treeWidgetItem->setData(col, Qt::DisplayRole, U82Q(*iter));
-			}
-			treeWidgetItem->setTextAlignment(col, align_tbl[align & 3]);
-			col++;
-			align >>= 2;
-		}
-	}
+	// Large lists are filled incrementally from tmrListDataFill.
+	// RFT_LISTDATA_MULTI lists are always filled immediately, since
+	// updateMulti() needs all of the rows.
+	Data_ListDataFill_t fill;
+	fill.treeWidget = treeWidget;
+	fill.field = &field;
+	fill.list_data = list_data;
+	fill.row = 0;
+	fill.checkboxes = (hasCheckboxes ? field.data.list_data.mxd.checkboxes : 0);
+	fill.itemFlags = itemFlags;
+	fill.isMulti = isMulti;
+	const bool moreRows = addListDataRows(fill,
+		(isMulti ? static_cast<unsigned int>(list_data->size()) : LISTDATA_CHUNK_ROWS));
 
 	if (!isMulti) {
 		// Resize the columns to fit the contents.
+		// NOTE: If the list is being filled incrementally,
+		// this is done again once it's complete.
 		for (int i = 0; i < colCount; i++) {
 			treeWidget->resizeColumnToContents(i);
 		}
@@ -654,6 +771,18 @@ void RomDataViewPrivate::initListData(QLabel *lblDesc, const RomFields::Field &f
 
 	if (isMulti) {
 		vecListDataMulti.emplace_back(std::make_pair(treeWidget, &field));
+	} else if (moreRows) {
+		// Fill the rest of the list later.
+		vecListDataFill.push_back(fill);
+		if (!tmrListDataFill) {
+			tmrListDataFill = new QTimer(q);
+			tmrListDataFill->setInterval(0);
+			QObject::connect(tmrListDataFill, SIGNAL(timeout()),
+			                 q, SLOT(tmrListDataFill_timeout()));
+		}
+		if (!tmrListDataFill->isActive()) {
+			tmrListDataFill->start();
+		}
 	}
 }
 
@@ -1040,8 +1169,11 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 	ui.tabWidget->clear();
 	ui.tabWidget->hide();
 
-	// Initialize the header row.
-	initHeaderRow();
+	// Stop filling RFT_LISTDATA fields.
+	if (tmrListDataFill) {
+		tmrListDataFill->stop();
+	}
+	vecListDataFill.clear();
 
 	if (!romData) {
 		// No ROM data to display.
@@ -1189,10 +1321,59 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 		adjustListData(static_cast<int>(tabs.size()-1));
 	}
 
-	// Close the file.
-	// Keeping the file open may prevent the user from
-	// changing the file.
-	romData->close();
+	// NOTE: The file is closed by RomDataLoader
+	// once the internal images have been loaded.
+}
+
+/**
+ * Start loading the RomData object on a worker thread.
+ * Any running loader is cancelled first.
+ */
+void RomDataViewPrivate::startLoader(void)
+{
+	cancelLoader();
+	if (!romData)
+		return;
+
+	// The display widgets are updated as each stage
+	// is completed, so slow files (e.g. disc images on
+	// network shares) don't block the file manager.
+	Q_Q(RomDataView);
+	loader = new RomDataLoader(romData);
+	loader->start(loaderNotify, q);
+}
+
+/**
+ * Cancel the RomDataLoader, if one is running.
+ */
+void RomDataViewPrivate::cancelLoader(void)
+{
+	if (!loader)
+		return;
+
+	// NOTE: Once cancel() returns, loaderNotify() won't be called
+	// again. Stage notifications that are still queued are
+	// discarded by loaderStage(), since the loader ID won't match.
+	loader->cancel();
+	loader->unref();
+	loader = nullptr;
+}
+
+/**
+ * RomDataLoader stage notification function.
+ * Called on the worker thread.
+ * @param loader RomDataLoader.
+ * @param stage Stage.
+ * @param userdata RomDataView.
+ */
+void RomDataViewPrivate::loaderNotify(RomDataLoader *loader, RomDataLoader::Stage stage, void *userdata)
+{
+	// NOTE: This must not block on the UI thread, since the
+	// UI thread may be waiting in RomDataLoader::cancel().
+	RomDataView *const q = static_cast<RomDataView*>(userdata);
+	QMetaObject::invokeMethod(q, "loaderStage", Qt::QueuedConnection,
+		Q_ARG(uint, loader->id()),
+		Q_ARG(int, static_cast<int>(stage)));
 }
 
 /** RomDataView **/
@@ -1214,8 +1395,10 @@ RomDataView::RomDataView(RomData *romData, QWidget *parent)
 	Q_D(RomDataView);
 	d->ui.setupUi(this);
 
-	// Initialize the display widgets.
-	d->initDisplayWidgets();
+	// Initialize the header row.
+	// Everything else is initialized once it's been loaded.
+	d->initHeaderRow();
+	d->startLoader();
 }
 
 RomDataView::~RomDataView()
@@ -1359,6 +1542,72 @@ void RomDataView::cboLanguage_currentIndexChanged_slot(int index)
 	d->updateMulti(lc);
 }
 
+/**
+ * Add more rows to RFT_LISTDATA fields that are still being filled.
+ */
+void RomDataView::tmrListDataFill_timeout(void)
+{
+	Q_D(RomDataView);
+	if (d->vecListDataFill.empty()) {
+		d->tmrListDataFill->stop();
+		return;
+	}
+
+	auto &fill = d->vecListDataFill.front();
+	if (!d->addListDataRows(fill, LISTDATA_CHUNK_ROWS)) {
+		// This list is complete.
+		// Resize the columns to fit the contents.
+		QTreeWidget *const treeWidget = fill.treeWidget;
+		const int colCount = treeWidget->columnCount();
+		for (int i = 0; i < colCount; i++) {
+			treeWidget->resizeColumnToContents(i);
+		}
+		d->vecListDataFill.erase(d->vecListDataFill.begin());
+	}
+
+	if (d->vecListDataFill.empty()) {
+		d->tmrListDataFill->stop();
+	}
+}
+
+/**
+ * A RomDataLoader stage has completed.
+ * Queued from the worker thread by RomDataViewPrivate::loaderNotify().
+ * @param loaderId RomDataLoader ID.
+ * @param stage RomDataLoader::Stage
+ */
+void RomDataView::loaderStage(uint loaderId, int stage)
+{
+	Q_D(RomDataView);
+	if (!d->loader || d->loader->id() != loaderId) {
+		// Loader was cancelled or replaced.
+		return;
+	}
+
+	switch (static_cast<RomDataLoader::Stage>(stage)) {
+		case RomDataLoader::STAGE_HEADER:
+			// Header row was already initialized,
+			// since the RomData object already exists.
+			break;
+
+		case RomDataLoader::STAGE_FIELDS:
+			// Initialize the display widgets.
+			d->initDisplayWidgets();
+			break;
+
+		case RomDataLoader::STAGE_IMAGES:
+			// Internal images are loaded. This is the last stage.
+			d->initHeaderImages();
+			d->cancelLoader();
+			break;
+
+		case RomDataLoader::STAGE_ERROR:
+		default:
+			d->cancelLoader();
+			break;
+	}
+}
+
 /** Properties. **/
 
 /**
@@ -1391,11 +1640,14 @@ void RomDataView::setRomData(RomData *romData)
 		d->ui.lblIcon->resetAnimFrame();
 	}
 
+	d->cancelLoader();
 	if (d->romData) {
 		d->romData->unref();
 	}
 	d->romData = (romData ? romData->ref() : nullptr);
 	d->initDisplayWidgets();
+	d->initHeaderRow();
+	d->startLoader();
 
 	if (romData != nullptr && prevAnimTimerRunning) {
 		// Restart the animation timer.
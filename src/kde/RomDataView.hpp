@@ -72,6 +72,19 @@ class RomDataView : public QWidget
 		 */
 		void cboLanguage_currentIndexChanged_slot(int index);
 
+		/**
+		 * Add more rows to RFT_LISTDATA fields that are still being filled.
+		 */
+		void tmrListDataFill_timeout(void);
+
+		/**
+		 * A RomDataLoader stage has completed.
+		 * Queued from the worker thread by RomDataViewPrivate::loaderNotify().
+		 * @param loaderId RomDataLoader ID.
+		 * @param stage RomDataLoader::Stage
+		 */
+		void loaderStage(uint loaderId, int stage);
+
 	public:
 		/** Properties. **/
 
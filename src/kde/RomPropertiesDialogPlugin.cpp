@@ -62,10 +62,9 @@ RomPropertiesDialogPlugin::RomPropertiesDialogPlugin(KPropertiesDialog *props, c
 	// tr: Tab title.
 	props->addPage(romDataView, U82Q(C_("RomDataView", "ROM Properties")));
 
-	// Make sure the underlying file handle is closed,
-	// since we don't need it once the RomData has been
-	// loaded by RomDataView.
-	romData->close();
+	// NOTE: RomDataView loads the fields and images on a
+	// worker thread, and closes the underlying file handle
+	// once it's done, so don't close it here.
 
 	// RomDataView takes a reference to the RomData object.
 	// We don't need to hold on to it.
@@ -270,17 +270,17 @@ Q_DECL_EXPORT int rp_create_thumbnail(const char *source_file, const char *outpu
 	// TODO: If image is larger than maximum_size, resize down.
 	RomThumbCreatorPrivate *const d = new RomThumbCreatorPrivate();
 	RomThumbCreatorPrivate::GetThumbnailOutParams_t outParams;
+	d->setPngPassthrough(true);
 	int ret = d->getThumbnail(romData, maximum_size, &outParams);
 	delete d;
 
-	if (ret != 0 || outParams.retImg.isNull()) {
+	if (ret != 0 || (outParams.pngData.empty() && outParams.retImg.isNull())) {
 		// No image.
 		romData->unref();
 		return RPCT_SOURCE_FILE_NO_IMAGE;
 	}
 
 	// Save the image using RpPngWriter.
-	const int height = outParams.retImg.height();
 
 	/** tEXt chunks. **/
 	// NOTE: These are written before IHDR in order to put the
@@ -293,31 +293,6 @@ Q_DECL_EXPORT int rp_create_thumbnail(const char *source_file, const char *outpu
 	// KDE uses this order: Software, MTime, Mimetype, Size, URI
 	RpPngWriter::kv_vector kv;
 
-	// Determine the image format.
-	rp_image::Format format;
-	switch (outParams.retImg.format()) {
-		case QImage::Format_Indexed8:
-			format = rp_image::FORMAT_CI8;
-			break;
-		case QImage::Format_ARGB32:
-			format = rp_image::FORMAT_ARGB32;
-			break;
-		default:
-			// Unsupported...
-			assert(!"Unsupported QImage image format.");
-			romData->unref();
-			return RPCT_OUTPUT_FILE_FAILED;
-	}
-
-	RpPngWriter *pngWriter = new RpPngWriter(output_file,
-		outParams.retImg.width(), height, format);
-	if (!pngWriter->isOpen()) {
-		// Could not open the PNG writer.
-		delete pngWriter;
-		romData->unref();
-		return RPCT_OUTPUT_FILE_FAILED;
-	}
-
 	// Software.
 	static const char sw[] = "ROM Properties Page shell extension (" RP_KDE_UPPER QT_MAJOR_STR ")";
 	kv.emplace_back("Software", sw);
@@ -366,6 +341,51 @@ Q_DECL_EXPORT int rp_create_thumbnail(const char *source_file, const char *outpu
 	// FIXME: Do we want to store the local URI or the original URI?
 	kv.emplace_back("Thumb::URI", localUrl.toString().toUtf8().constData());
 
+	if (!outParams.pngData.empty()) {
+		// PNG pass-through: Copy the original PNG image
+		// with the tEXt chunks added.
+		RpFile *const pngFile = new RpFile(output_file, RpFile::FM_CREATE_WRITE);
+		const int pwRet = (pngFile->isOpen()
+			? RpPngWriter::copy_with_tEXt(pngFile,
+				outParams.pngData.data(), outParams.pngData.size(), kv)
+			: -EIO);
+		pngFile->unref();
+		romData->unref();
+		// TODO: Unlink the PNG image on error.
+		return (pwRet == 0 ? RPCT_SUCCESS : RPCT_OUTPUT_FILE_FAILED);
+	}
+
+	const int height = outParams.retImg.height();
+
+	// Determine the image format.
+	rp_image::Format format;
+	switch (outParams.retImg.format()) {
+		case QImage::Format_Indexed8:
+			format = rp_image::FORMAT_CI8;
+			break;
+		case QImage::Format_ARGB32:
+			format = rp_image::FORMAT_ARGB32;
+			break;
+		default:
+			// Unsupported...
+			assert(!"Unsupported QImage image format.");
+			romData->unref();
+			return RPCT_OUTPUT_FILE_FAILED;
+	}
+
+	RpPngWriter *pngWriter = new RpPngWriter(output_file,
+		outParams.retImg.width(), height, format);
+	if (!pngWriter->isOpen()) {
+		// Could not open the PNG writer.
+		delete pngWriter;
+		romData->unref();
+		return RPCT_OUTPUT_FILE_FAILED;
+	}
+
+	// Thumbnails are regenerated whenever the cache is rebuilt,
+	// so use the fast encoding profile.
+	pngWriter->setProfile(RpPngWriter::PROFILE_FAST);
+
 	// Write the tEXt chunks.
 	pngWriter->write_tEXt(kv);
 
@@ -201,27 +201,28 @@ SNDHPrivate::TagData SNDHPrivate::parseTags(void)
 		// Packed with ICE.
 #ifdef ENABLE_UNICE68
 		// Decompress the data.
-		// FIXME: unice68_depacker() only supports decompressing the entire file.
-		// Add a variant that supports buffer sizes.
+		// NOTE: ICE data is depacked back to front, so the entire
+		// file has to be read, but only the header is kept.
 		const off64_t fileSize = file->size();
-		if (fileSize <= 0) {
+		if (fileSize <= 0 || fileSize > 16*1024*1024) {
 			return tags;
 		}
-		unique_ptr<uint8_t[]> inbuf(new uint8_t[fileSize]);
-		sz = file->seekAndRead(0, inbuf.get(), fileSize);
-		if (sz != (size_t)fileSize) {
+		unique_ptr<uint8_t[]> inbuf(new uint8_t[static_cast<size_t>(fileSize)]);
+		sz = file->seekAndRead(0, inbuf.get(), static_cast<size_t>(fileSize));
+		if (sz != static_cast<size_t>(fileSize)) {
 			return tags;
 		}
-		int reqSize = unice68_depacked_size(inbuf.get(), nullptr);
+		const int reqSize = unice68_depacked_size(inbuf.get(), nullptr);
 		if (reqSize <= 0) {
 			return tags;
 		}
-		header.reset(new uint8_t[reqSize+1]);
-		int ret = unice68_depacker(header.get(), inbuf.get());
+		headerSize = std::min(4096, reqSize);
+		header.reset(new uint8_t[headerSize+1]);
+		int ret = unice68_depacker_head(header.get(), static_cast<int>(headerSize),
+			inbuf.get(), static_cast<int>(fileSize));
 		if (ret != 0) {
 			return tags;
 		}
-		headerSize = std::min(4096, reqSize);
 		header[headerSize] = 0;	// ensure NULL-termination
 #else /* !ENABLE_UNICE68 */
 		// unice68 is disabled.
@@ -917,4 +917,23 @@ int Dreamcast::loadInternalImage(ImageType imageType, const rp_image **pImage)
 		d->load0GDTEX);	// func
 }
 
+
+/**
+ * Get the logical disc image, if this is a disc image
+ * stored in a sparse or compressed container.
+ * This is used to calculate hashes of the logical disc image.
+ *
+ * NOTE: The IDiscReader is owned by this object.
+ *
+ * @return IDiscReader, or nullptr if the file should be hashed as-is.
+ */
+IDiscReader *Dreamcast::logicalImage(void) const
+{
+	// GDI images are split into multiple track files,
+	// so the logical disc image is hashed using GdiReader.
+	// 2048-byte and 2352-byte ISOs are hashed as-is.
+	RP_D(const Dreamcast);
+	return (d->discType == DreamcastPrivate::DISC_GDI ? d->gdiReader : nullptr);
+}
+
 }
@@ -23,6 +23,8 @@
 #include "librpfile/DualFile.hpp"
 #include "librpfile/RelatedFile.hpp"
 #include "librpbase/SystemRegion.hpp"
+#include "librpthreads/Mutex.hpp"
+#include "librpthreads/ThreadPool.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 using LibRpTexture::rp_image;
@@ -136,6 +138,10 @@ class GameCubePrivate : public RomDataPrivate
 		vector<WiiPartEntry> wiiPtbl;
 		bool wiiPtblLoaded;
 
+		// Serializes discReader access for the WiiPartition objects,
+		// since partitions may be read from multiple threads.
+		Mutex discReaderMutex;
+
 		// Pointers to specific partitions within wiiPtbl.
 		WiiPartition *updatePartition;
 		WiiPartition *gamePartition;
@@ -193,6 +199,23 @@ class GameCubePrivate : public RomDataPrivate
 		 * @return nullptr if partition is readable; error message if not.
 		 */
 		const char *wii_getCryptoStatus(WiiPartition *partition);
+
+		// Partition data range. (start, end)
+		typedef std::pair<off64_t, off64_t> DataRange;
+
+		/**
+		 * [Wii] Find files that overlap corrupted data ranges.
+		 * Subdirectories are checked recursively.
+		 *
+		 * @param partition	[in] Partition.
+		 * @param path		[in] Directory path, with a trailing slash.
+		 * @param ranges	[in] Corrupted data ranges. (sorted, non-overlapping)
+		 * @param ptname	[in] Partition name, for error locations.
+		 * @param errors	[out] Integrity errors.
+		 */
+		static void wii_findCorruptedFiles(WiiPartition *partition, const string &path,
+			const vector<DataRange> &ranges, const string &ptname,
+			vector<RomData::IntegrityError> &errors);
 };
 
 /** GameCubePrivate **/
@@ -347,6 +370,11 @@ int GameCubePrivate::loadWiiPartitionTables(void)
 		}
 	}
 
+	if (wiiPtbl.empty()) {
+		// No partitions. Nothing else to do here.
+		return 0;
+	}
+
 	// Sort partitions by starting address in order to calculate the sizes.
 	std::sort(wiiPtbl.begin(), wiiPtbl.end(),
 		[](const WiiPartEntry &a, const WiiPartEntry &b) {
@@ -378,6 +406,7 @@ int GameCubePrivate::loadWiiPartitionTables(void)
 		// still show how they'd be encrypted.
 		iter->partition = new WiiPartition(discReader, iter->start, iter->size,
 			(WiiPartition::CryptoMethod)cryptoMethod);
+		iter->partition->setDiscReaderMutex(&discReaderMutex);
 
 		if (iter->type == PARTITION_UPDATE && !updatePartition) {
 			// System Update partition.
@@ -645,6 +674,56 @@ const char *GameCubePrivate::wii_getCryptoStatus(WiiPartition *partition)
 	return err;
 }
 
+/**
+ * [Wii] Find files that overlap corrupted data ranges.
+ * Subdirectories are checked recursively.
+ *
+ * @param partition	[in] Partition.
+ * @param path		[in] Directory path, with a trailing slash.
+ * @param ranges	[in] Corrupted data ranges. (sorted, non-overlapping)
+ * @param ptname	[in] Partition name, for error locations.
+ * @param errors	[out] Integrity errors.
+ */
+void GameCubePrivate::wii_findCorruptedFiles(WiiPartition *partition, const string &path,
+	const vector<DataRange> &ranges, const string &ptname,
+	vector<RomData::IntegrityError> &errors)
+{
+	IFst::Dir *const dirp = partition->opendir(path);
+	if (!dirp) {
+		return;
+	}
+
+	vector<string> subdirs;
+	IFst::DirEnt *dirent;
+	while ((dirent = partition->readdir(dirp)) != nullptr) {
+		if (!dirent->name)
+			continue;
+		if (dirent->type == DT_DIR) {
+			// Check subdirectories after this directory is closed.
+			subdirs.emplace_back(path + dirent->name + '/');
+			continue;
+		} else if (dirent->type != DT_REG || dirent->size <= 0) {
+			continue;
+		}
+
+		// Find the first range that ends after the file starts.
+		const off64_t file_end = dirent->offset + dirent->size;
+		auto iter = std::upper_bound(ranges.cbegin(), ranges.cend(), dirent->offset,
+			[](off64_t offset, const DataRange &range) { return offset < range.second; });
+		if (iter != ranges.cend() && iter->first < file_end) {
+			RomData::IntegrityError error;
+			error.location = ptname + ": " + path + dirent->name;
+			error.description = C_("GameCube", "File data is corrupted.");
+			errors.emplace_back(std::move(error));
+		}
+	}
+	partition->closedir(dirp);
+
+	for (const string &subdir : subdirs) {
+		wii_findCorruptedFiles(partition, subdir, ranges, ptname, errors);
+	}
+}
+
 /** GameCube **/
 
 /**
@@ -1749,6 +1828,32 @@ int GameCube::loadFieldData(void)
 			d->fields->addField_string(update_title, sysMenu);
 		}
 
+		// Get the encryption key and used size for each partition.
+		// Decrypting the title keys and reading the FSTs is slow,
+		// so the partitions are processed in parallel.
+		struct PartInfo {
+			WiiPartition::EncKey encKey;
+			off64_t used_size;
+		};
+		vector<PartInfo> partInfo(d->wiiPtbl.size());
+		const bool isNASOS = ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) == GameCubePrivate::DISC_FORMAT_NASOS);
+		auto getPartInfo = [d, isNASOS, &partInfo](size_t begin, size_t end, ScratchArena*) {
+			for (size_t i = begin; i < end; i++) {
+				WiiPartition *const partition = d->wiiPtbl[i].partition;
+				PartInfo &info = partInfo[i];
+				if (isNASOS && d->discHeader.disc_noCrypto == 0) {
+					// NASOS disc image.
+					// If this would normally be an encrypted image, use encKeyReal().
+					info.encKey = partition->encKeyReal();
+				} else {
+					// Other disc image. Use encKey().
+					info.encKey = partition->encKey();
+				}
+				info.used_size = partition->partition_size_used();
+			}
+		};
+		ThreadPool::instance()->parallelFor(0, d->wiiPtbl.size(), 1, getPartInfo);
+
 		// Partition table.
 		auto vv_partitions = new RomFields::ListData_t();
 		vv_partitions->resize(d->wiiPtbl.size());
@@ -1801,17 +1906,8 @@ int GameCube::loadFieldData(void)
 
 			// Encryption key.
 			// TODO: Use a string table?
-			WiiPartition::EncKey encKey;
-			if ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) == GameCubePrivate::DISC_FORMAT_NASOS) {
-				// NASOS disc image.
-				// If this would normally be an encrypted image, use encKeyReal().
-				encKey = (d->discHeader.disc_noCrypto == 0
-					? entry.partition->encKeyReal()
-					: entry.partition->encKey());
-			} else {
-				// Other disc image. Use encKey().
-				encKey = entry.partition->encKey();
-			}
+			const PartInfo &info = partInfo[src_iter - d->wiiPtbl.cbegin()];
+			const WiiPartition::EncKey encKey = info.encKey;
 
 			static const char *const wii_key_tbl[] = {
 				// tr: WiiPartition::ENCKEY_COMMON - Retail encryption key.
@@ -1838,7 +1934,7 @@ int GameCube::loadFieldData(void)
 			data_row.emplace_back(s_key_name);
 
 			// Used size.
-			const off64_t used_size = entry.partition->partition_size_used();
+			const off64_t used_size = info.used_size;
 			if (used_size >= 0) {
 				data_row.emplace_back(LibRpBase::formatFileSize(used_size));
 			} else {
@@ -2174,4 +2270,142 @@ int GameCube::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) c
 	return 0;
 }
 
+
+/**
+ * Get the logical disc image, if this is a disc image
+ * stored in a sparse or compressed container.
+ * This is used to calculate hashes of the logical disc image.
+ *
+ * NOTE: The IDiscReader is owned by this object.
+ *
+ * @return IDiscReader, or nullptr if the file should be hashed as-is.
+ */
+IDiscReader *GameCube::logicalImage(void) const
+{
+	// The disc reader handles WBFS, CISO, NASOS, and TGC,
+	// so the logical disc image can be hashed directly.
+	RP_D(const GameCube);
+	return d->discReader;
+}
+
+/**
+ * Verify the ROM image using its internal hashes.
+ *
+ * For Wii discs, the H0-H3 hash tree of each partition is
+ * checked, and corrupted sectors are mapped to files using
+ * the partition's FST. GameCube discs don't have hashes.
+ *
+ * NOTE: This reads the entire ROM image, so it may take a while.
+ *
+ * @param errors	[out] Integrity errors. (empty if the ROM image is intact)
+ * @param group		[in,opt] Task group for cancellation.
+ * @return 0 if verified; negative POSIX error code on error. (-ENOTSUP if no internal hashes)
+ */
+int GameCube::verifyIntegrity(vector<IntegrityError> &errors, TaskGroup *group)
+{
+	RP_D(GameCube);
+	errors.clear();
+	if (!d->isValid || !d->discReader) {
+		// Disc image isn't valid.
+		return -EIO;
+	} else if ((d->discType & GameCubePrivate::DISC_SYSTEM_MASK) != GameCubePrivate::DISC_SYSTEM_WII) {
+		// Only Wii discs have hashes.
+		return -ENOTSUP;
+	}
+
+	int ret = d->loadWiiPartitionTables();
+	if (ret != 0) {
+		return ret;
+	}
+
+	// NOTE: RVT-H images don't have hashes, so
+	// -ENOTSUP is returned if no partitions have them.
+	ret = -ENOTSUP;
+	for (const GameCubePrivate::WiiPartEntry &entry : d->wiiPtbl) {
+		WiiPartition *const partition = entry.partition;
+		const string ptname = rp_sprintf("%dp%d", entry.vg, entry.pt);
+
+		WiiPartition::HashCheckResult result;
+		const int pret = partition->verifyHashes(result, group);
+		if (pret == -ECANCELED) {
+			return pret;
+		} else if (pret == -ENOTSUP) {
+			// This partition doesn't have hashes.
+			continue;
+		} else if (pret != 0) {
+			// Unable to verify this partition.
+			const char *status = d->wii_getCryptoStatus(partition);
+			IntegrityError error;
+			error.location = ptname;
+			error.description = rp_sprintf(C_("GameCube", "Unable to verify this partition: %s"),
+				(status ? status : strerror(-pret)));
+			errors.emplace_back(std::move(error));
+			ret = 0;
+			continue;
+		}
+		ret = 0;
+
+		if (!result.h3_table_ok) {
+			IntegrityError error;
+			error.location = ptname;
+			error.description = C_("GameCube", "The H3 table does not match the TMD.");
+			errors.emplace_back(std::move(error));
+		}
+		if (result.bad_sectors.empty())
+			continue;
+
+		// Report each bad sector, and get the corrupted data ranges.
+		// Data ranges use the decrypted partition addresses, which
+		// exclude the 0x400-byte hash block in each sector.
+		vector<GameCubePrivate::DataRange> ranges;
+		for (const WiiPartition::BadSector &bad : result.bad_sectors) {
+			string levels;
+			for (unsigned int lvl = 0; lvl < 4; lvl++) {
+				if (!(bad.h_levels & (1U << lvl)))
+					continue;
+				if (!levels.empty()) {
+					levels += ", ";
+				}
+				levels += 'H';
+				levels += static_cast<char>('0' + lvl);
+			}
+
+			IntegrityError error;
+			error.location = rp_sprintf(C_("GameCube", "%s, sector %u"), ptname.c_str(), bad.sector);
+			error.description = rp_sprintf(C_("GameCube", "Hash mismatch: %s"), levels.c_str());
+			errors.emplace_back(std::move(error));
+
+			const off64_t sector_addr = static_cast<off64_t>(bad.sector) * 0x7C00;
+			if (bad.h_levels & ~1U) {
+				// The sector's hashes are corrupted,
+				// so none of its data can be trusted.
+				ranges.emplace_back(sector_addr, sector_addr + 0x7C00);
+			} else {
+				for (unsigned int blk = 0; blk < 31; blk++) {
+					if (bad.h0_blocks & (1U << blk)) {
+						const off64_t blk_addr = sector_addr + (blk * 0x400);
+						ranges.emplace_back(blk_addr, blk_addr + 0x400);
+					}
+				}
+			}
+		}
+
+		// Merge adjacent ranges. (Bad sectors are sorted.)
+		auto out = ranges.begin();
+		for (auto iter = ranges.begin() + 1; iter != ranges.end(); ++iter) {
+			if (iter->first <= out->second) {
+				out->second = std::max(out->second, iter->second);
+			} else {
+				*(++out) = *iter;
+			}
+		}
+		ranges.erase(out + 1, ranges.end());
+
+		// Find the files that use the corrupted data.
+		GameCubePrivate::wii_findCorruptedFiles(partition, "/", ranges, ptname, errors);
+	}
+
+	return ret;
+}
+
 }
@@ -20,6 +20,8 @@ ROMDATA_DECL_IMGSUPPORT()
 ROMDATA_DECL_IMGPF()
 ROMDATA_DECL_IMGINT()
 ROMDATA_DECL_IMGEXT()
+ROMDATA_DECL_LOGICALIMAGE()
+ROMDATA_DECL_VERIFYINTEGRITY()
 ROMDATA_DECL_END()
 
 }
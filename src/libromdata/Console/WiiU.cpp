@@ -653,4 +653,22 @@ int WiiU::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) const
 	return 0;
 }
 
+
+/**
+ * Get the logical disc image, if this is a disc image
+ * stored in a sparse or compressed container.
+ * This is used to calculate hashes of the logical disc image.
+ *
+ * NOTE: The IDiscReader is owned by this object.
+ *
+ * @return IDiscReader, or nullptr if the file should be hashed as-is.
+ */
+IDiscReader *WiiU::logicalImage(void) const
+{
+	// The disc reader handles WUX, so the logical
+	// disc image can be hashed directly.
+	RP_D(const WiiU);
+	return d->discReader;
+}
+
 }
@@ -17,9 +17,11 @@
 #include "xbox360_xdbf_structs.h"
 #include "data/XboxLanguage.hpp"
 
+// STFS file reader
+#include "disc/StfsReader.hpp"
+
 // librpbase, librpfile, librptexture
 #include "librpbase/img/RpPng.hpp"
-#include "librpbase/disc/DiscReader.hpp"
 #include "librpbase/disc/PartitionFile.hpp"
 #include "librpfile/RpMemFile.hpp"
 using namespace LibRpBase;
@@ -29,6 +31,7 @@ using namespace LibRpTexture;
 
 // C++ STL classes.
 using std::string;
+using std::unordered_map;
 using std::vector;
 
 namespace LibRomData {
@@ -104,37 +107,30 @@ class Xbox360_STFS_Private : public RomDataPrivate
 
 	public:
 		// XEX executable.
-		DiscReader *xexReader;
+		StfsReader *xexReader;
 		Xbox360_XEX *xex;
 
 		// File table.
 		ao::uvector<STFS_DirEntry_t> fileTable;
 
+		// File table index.
+		// Key: Lowercase filename; value: Index in fileTable.
+		// Files in the root directory take precedence.
+		unordered_map<string, size_t> fileTableIndex;
+
 		/**
-		 * Convert a block number to an offset.
-		 * @param blockNumber Block number.
-		 * @return Offset, or -1 on error.
+		 * Create an StfsReader for a file in the package.
+		 * @param dirEntry Directory entry.
+		 * @return StfsReader, or nullptr on error.
 		 */
-		inline int32_t blockNumberToOffset(int blockNumber)
-		{
-			// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
-			int ret;
-			if (blockNumber > 0xFFFFFF) {
-				ret = -1;
-			} else {
-				ret = (((be32_to_cpu(stfsMetadata.header_size) + 0xFFF) & 0xF000) +
-				        (blockNumber * STFS_BLOCK_SIZE));
-			}
-			return ret;
-		}
+		StfsReader *openFile(const STFS_DirEntry_t *dirEntry);
 
 		/**
-		 * Convert a data block number to a physical block number.
-		 * Data block numbers don't include hash blocks.
-		 * @param dataBlockNumber Data block number.
-		 * @return physBlockNumber Physical block number.
+		 * Find a file in the file table.
+		 * @param filename Filename. (case-insensitive)
+		 * @return Directory entry, or nullptr if not found.
 		 */
-		int32_t dataBlockNumberToPhys(int dataBlockNumber);
+		const STFS_DirEntry_t *findFile(const char *filename) const;
 
 		/**
 		 * Load the file table.
@@ -325,50 +321,55 @@ int Xbox360_STFS_Private::loadHeader(unsigned int header)
 }
 
 /**
- * Convert a data block number to a physical block number.
- * Data block numbers don't include hash blocks.
- * @param dataBlockNumber Data block number.
- * @return physBlockNumber Physical block number.
+ * Create an StfsReader for a file in the package.
+ * @param dirEntry Directory entry.
+ * @return StfsReader, or nullptr on error.
  */
-int32_t Xbox360_STFS_Private::dataBlockNumberToPhys(int dataBlockNumber)
+StfsReader *Xbox360_STFS_Private::openFile(const STFS_DirEntry_t *dirEntry)
 {
-	// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
-	int blockShift;
-	if (((be32_to_cpu(stfsMetadata.header_size) + 0xFFF) & 0xF000) == 0xB000) {
-		blockShift = 1;
-	} else {
-		if ((stfsMetadata.stfs_desc.block_separation & 1) == 1) {
-			blockShift = 0;
-		} else {
-			blockShift = 1;
-		}
+	assert(dirEntry != nullptr);
+	if (!dirEntry || (dirEntry->flags_len & STFS_DIRENTRY_FLAG_DIRECTORY)) {
+		// Not a file.
+		return nullptr;
 	}
 
-	int32_t base = ((dataBlockNumber + 0xAA) / 0xAA);
-	if (stfsType == STFS_TYPE_CON) {
-		base <<= blockShift;
+	// NOTE: Block number and block count are **little-endian** here.
+	const uint32_t blockNumber =
+		(dirEntry->block_number[2] << 16) |
+		(dirEntry->block_number[1] <<  8) |
+		 dirEntry->block_number[0];
+	const uint32_t blockCount =
+		(dirEntry->blocks[2] << 16) |
+		(dirEntry->blocks[1] <<  8) |
+		 dirEntry->blocks[0];
+
+	StfsReader *const reader = new StfsReader(this->file, &stfsMetadata,
+		(stfsType == STFS_TYPE_CON), blockNumber, blockCount,
+		be32_to_cpu(dirEntry->filesize),
+		!!(dirEntry->flags_len & STFS_DIRENTRY_FLAG_CONSECUTIVE));
+	if (!reader->isOpen()) {
+		delete reader;
+		return nullptr;
 	}
+	return reader;
+}
 
-	int32_t ret = (base + dataBlockNumber);
-	if (dataBlockNumber > 0xAA) {
-		base = ((dataBlockNumber + 0x70E4) / 0x70E4);
-		if (stfsType == STFS_TYPE_CON) {
-			base <<= blockShift;
-		}
-		ret += base;
-
-		if (dataBlockNumber > 0x70E4) {
-			base = ((dataBlockNumber + 0x4AF768) / 0x4AF768);
-			// FIXME: Originally compared magic to blockShift,
-			// which doesn't make sense...
-			if (stfsType == STFS_TYPE_CON) {
-				base <<= blockShift;
-			}
-			ret += base;
-		}
-	}
+/**
+ * Find a file in the file table.
+ * @param filename Filename. (case-insensitive)
+ * @return Directory entry, or nullptr if not found.
+ */
+const STFS_DirEntry_t *Xbox360_STFS_Private::findFile(const char *filename) const
+{
+	string key(filename);
+	std::transform(key.begin(), key.end(), key.begin(), ::tolower);
 
-	return ret;
+	auto iter = fileTableIndex.find(key);
+	if (iter == fileTableIndex.end()) {
+		// File not found.
+		return nullptr;
+	}
+	return &fileTable[iter->second];
 }
 
 /**
@@ -400,28 +401,29 @@ int Xbox360_STFS_Private::loadFileTable(void)
 	// TODO: Verify that this is STFS and not SVOD.
 	// NOTE: These values are signed. Make sure they're not negative.
 	const int16_t blockCount = be16_to_cpu(stfsMetadata.stfs_desc.file_table_block_count);
-	if (blockCount < 0 || stfsMetadata.stfs_desc.file_table_block_number[0] >= 0x80) {
+	if (blockCount <= 0 || stfsMetadata.stfs_desc.file_table_block_number[0] >= 0x80) {
 		// Negative values.
 		return -EIO;
 	}
-	const int32_t blockNumber =
+	const uint32_t blockNumber =
 		(stfsMetadata.stfs_desc.file_table_block_number[0] << 16) |
 		(stfsMetadata.stfs_desc.file_table_block_number[1] <<  8) |
 		 stfsMetadata.stfs_desc.file_table_block_number[2];
-	const int32_t offset = blockNumberToOffset(dataBlockNumberToPhys(blockNumber));
-	if (offset < 0) {
-		// Invalid block number.
-		return -EIO;
-	}
 
 	// Load the file table.
-	size_t fileTableSize = ((uint32_t)blockCount * STFS_BLOCK_SIZE);
-	assert(fileTableSize % sizeof(STFS_DirEntry_t) == 0);
-	if (fileTableSize % sizeof(STFS_DirEntry_t) != 0) {
-		fileTableSize += sizeof(STFS_DirEntry_t);
-	}
+	// NOTE: The file table isn't necessarily consecutive,
+	// so it has to be read using the hash chain.
+	const uint32_t fileTableSize = static_cast<uint32_t>(blockCount) * STFS_BLOCK_SIZE;
+	static_assert(STFS_BLOCK_SIZE % sizeof(STFS_DirEntry_t) == 0,
+		"STFS_BLOCK_SIZE is not a multiple of sizeof(STFS_DirEntry_t).");
+	StfsReader *const reader = new StfsReader(this->file, &stfsMetadata,
+		(stfsType == STFS_TYPE_CON), blockNumber, blockCount, fileTableSize, false);
 	fileTable.resize(fileTableSize / sizeof(STFS_DirEntry_t));
-	size_t size = file->seekAndRead(offset, fileTable.data(), fileTableSize);
+	size_t size = 0;
+	if (reader->isOpen()) {
+		size = reader->read(fileTable.data(), fileTableSize);
+	}
+	delete reader;
 	if (size != fileTableSize) {
 		// Seek and/or read error.
 		fileTable.clear();
@@ -437,6 +439,26 @@ int Xbox360_STFS_Private::loadFileTable(void)
 		}
 	}
 
+	// Index the file table by filename.
+	fileTableIndex.clear();
+	fileTableIndex.reserve(fileTable.size());
+	for (size_t i = 0; i < fileTable.size(); i++) {
+		const STFS_DirEntry_t &entry = fileTable[i];
+		const unsigned int len = entry.flags_len & 0x3F;
+		if (len == 0 || len > sizeof(entry.filename)) {
+			// Invalid filename length.
+			continue;
+		}
+
+		string key(entry.filename, len);
+		std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+		auto ins = fileTableIndex.emplace(std::move(key), i);
+		if (!ins.second && be16_to_cpu(entry.path) == -1) {
+			// Files in the root directory take precedence.
+			ins.first->second = i;
+		}
+	}
+
 	return (!fileTable.empty() ? 0 : -ENOENT);
 }
 
@@ -458,74 +480,34 @@ Xbox360_XEX *Xbox360_STFS_Private::openDefaultXex(void)
 	}
 
 	// Find default.xex or default.xexp and load it.
-	// TODO: Handle subdirectories?
-	const STFS_DirEntry_t *dirEntry = nullptr;
-	for (auto iter = fileTable.cbegin(); iter != fileTable.cend(); ++iter) {
-		// Make sure this isn't a subdirectory.
-		if (iter->flags_len & 0x80) {
-			// It's a subdirectory.
-			continue;
-		}
-
-		// "default.xex" is 11 characters.
-		// "default.xexp" is 12 characters.
-		switch (iter->flags_len & 0x3F) {
-			case 11:
-				// Check for default.xex.
-				if (!strncasecmp("default.xex", iter->filename, 12)) {
-					// Found default.xex.
-					dirEntry = &(*iter);
-					break;
-				}
-				break;
-
-			case 12:
-				// Check for default.xexp.
-				if (!strncasecmp("default.xexp", iter->filename, 13)) {
-					// Found default.xexp.
-					dirEntry = &(*iter);
-					break;
-				}
-				break;
-
-			default:
-				break;
+	const STFS_DirEntry_t *dirEntry = findFile("default.xex");
+	if (!dirEntry) {
+		dirEntry = findFile("default.xexp");
+		if (!dirEntry) {
+			// Directory entry not found.
+			return nullptr;
 		}
 	}
 
-	if (!dirEntry) {
-		// Directory entry not found.
+	StfsReader *stfsReader = openFile(dirEntry);
+	if (!stfsReader) {
+		// Unable to open the file.
 		return nullptr;
 	}
 
-	// Offset and filesize.
-	// NOTE: Block number is **little-endian** here.
-	const int32_t blockNumber =
-		(dirEntry->block_number[2] << 16) |
-		(dirEntry->block_number[1] <<  8) |
-		 dirEntry->block_number[0];
-	const int32_t offset = blockNumberToOffset(dataBlockNumberToPhys(blockNumber));
-	const uint32_t filesize = be32_to_cpu(dirEntry->filesize);
-
-	// Load default.xexp.
-	// FIXME: Maybe add a reader class to handle the hashes,
-	// though we only need the XEX header right now.
-	DiscReader *discReader = new DiscReader(this->file);
-	if (discReader->isOpen()) {
-		PartitionFile *const xexFile_tmp = new PartitionFile(discReader, offset, filesize);
-		if (xexFile_tmp->isOpen()) {
-			Xbox360_XEX *const xex_tmp = new Xbox360_XEX(xexFile_tmp);
-			if (xex_tmp->isOpen()) {
-				this->xex = xex_tmp;
-				this->xexReader = discReader;
-				discReader = nullptr;
-			} else {
-				xex_tmp->unref();
-			}
+	PartitionFile *const xexFile_tmp = new PartitionFile(stfsReader, 0, stfsReader->size());
+	if (xexFile_tmp->isOpen()) {
+		Xbox360_XEX *const xex_tmp = new Xbox360_XEX(xexFile_tmp);
+		if (xex_tmp->isOpen()) {
+			this->xex = xex_tmp;
+			this->xexReader = stfsReader;
+			stfsReader = nullptr;
+		} else {
+			xex_tmp->unref();
 		}
-		xexFile_tmp->unref();
 	}
-	delete discReader;
+	xexFile_tmp->unref();
+	delete stfsReader;
 
 	return this->xex;
 }
@@ -159,6 +159,20 @@ typedef struct PACKED _RVL_TMD_Header {
 } RVL_TMD_Header;
 ASSERT_STRUCT(RVL_TMD_Header, 0x1E4);
 
+/**
+ * Wii TMD content entry.
+ * Stored after the TMD header.
+ * Reference: https://wiibrew.org/wiki/Tmd_file_structure
+ */
+typedef struct PACKED _RVL_Content_Entry {
+	uint32_t content_id;	// [0x000] Content ID.
+	uint16_t index;		// [0x004] Index.
+	uint16_t type;		// [0x006] Type.
+	uint64_t size;		// [0x008] Size.
+	uint8_t sha1_hash[20];	// [0x010] SHA-1 hash. (For discs, this is the H3 table hash.)
+} RVL_Content_Entry;
+ASSERT_STRUCT(RVL_Content_Entry, 36);
+
 /**
  * Access rights.
  */
@@ -184,6 +198,31 @@ typedef struct PACKED _RVL_PartitionHeader {
 } RVL_PartitionHeader;
 ASSERT_STRUCT(RVL_PartitionHeader, 0x8000);
 
+/**
+ * Wii partition sector hash block.
+ * This is the first 0x400 bytes of each 0x8000-byte sector.
+ * For encrypted partitions, this is encrypted with the
+ * title key, using an IV of all zeroes.
+ *
+ * Sectors are grouped into subgroups of 8 sectors,
+ * and subgroups are grouped into groups of 8 subgroups.
+ * Each sector has a copy of its subgroup's H1 table
+ * and its group's H2 table. The H3 table has one hash
+ * per group, and its hash is stored in the TMD.
+ *
+ * Reference: https://wiibrew.org/wiki/Wii_Disc#Encrypted
+ */
+#define RVL_H3_TABLE_SIZE 0x18000
+typedef struct PACKED _RVL_HashBlock {
+	uint8_t h0[31][20];	// [0x000] H0: SHA-1 of each 0x400-byte data block in this sector.
+	uint8_t padding0[0x14];	// [0x26C]
+	uint8_t h1[8][20];	// [0x280] H1: SHA-1 of the H0 table of each sector in this subgroup.
+	uint8_t padding1[0x20];	// [0x320]
+	uint8_t h2[8][20];	// [0x340] H2: SHA-1 of the H1 table of each subgroup in this group.
+	uint8_t padding2[0x20];	// [0x3E0]
+} RVL_HashBlock;
+ASSERT_STRUCT(RVL_HashBlock, 0x400);
+
 /**
  * Country indexes in RVL_RegionSetting.ratings[].
  */
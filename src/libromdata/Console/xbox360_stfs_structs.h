@@ -272,6 +272,50 @@ typedef struct _STFS_DirEntry_t {
 } STFS_DirEntry_t;
 ASSERT_STRUCT(STFS_DirEntry_t, 0x40);
 
+/**
+ * STFS: Directory entry flags. (upper bits of flags_len)
+ */
+typedef enum {
+	STFS_DIRENTRY_FLAG_CONSECUTIVE	= 0x40,	// Blocks are consecutive. (no need to follow the hash chain)
+	STFS_DIRENTRY_FLAG_DIRECTORY	= 0x80,	// Entry is a subdirectory.
+} STFS_DirEntry_Flags_e;
+
+/**
+ * STFS: Hash table entry.
+ * Each hash table is one block, containing 0xAA entries.
+ *
+ * Level 0 tables cover 0xAA data blocks, level 1 tables cover
+ * 0xAA level 0 tables, and the level 2 table covers 0xAA level 1
+ * tables. Packages with two copies of each table store the copy
+ * to use in the parent entry's status byte.
+ *
+ * All fields are in big-endian.
+ */
+#define STFS_HASH_ENTRIES_PER_TABLE 0xAA
+typedef struct PACKED _STFS_Hash_Entry {
+	uint8_t sha1[0x14];		// [0x000] SHA-1 of the block
+	uint8_t status;			// [0x014] Status (see STFS_Hash_Status_e)
+	uint8_t next_block[3];		// [0x015] Next data block in the chain (BE24; level 0 only)
+} STFS_Hash_Entry;
+ASSERT_STRUCT(STFS_Hash_Entry, 0x18);
+
+/**
+ * STFS: Hash table entry status.
+ */
+typedef enum {
+	STFS_HASH_STATUS_UNUSED		= 0x00,
+	STFS_HASH_STATUS_FREE		= 0x40,
+	STFS_HASH_STATUS_USED		= 0x80,
+	STFS_HASH_STATUS_NEW		= 0xC0,
+
+	// For level 1 and 2 entries: Use the second
+	// copy of the child table, if present.
+	STFS_HASH_STATUS_ACTIVE_INDEX	= 0x40,
+} STFS_Hash_Status_e;
+
+// End of a hash chain.
+#define STFS_HASH_CHAIN_END 0xFFFFFF
+
 #ifdef __cplusplus
 }
 #endif
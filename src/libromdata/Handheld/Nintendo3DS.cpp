@@ -14,6 +14,8 @@
 #include "n3ds_structs.h"
 
 // librpbase, librpfile, librptexture
+#include "librpbase/crypto/MultiHash.hpp"
+#include "librpthreads/ThreadPool.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 using namespace LibRpTexture;
@@ -630,8 +632,8 @@ NCCHReader *Nintendo3DSPrivate::loadNCCH(void)
 		}
 	}
 
-	// TODO: For CCIs, verify that the copy in the
-	// Card Info Header matches the actual partition?
+	// NOTE: For CCIs, verifyIntegrity() checks that the
+	// ExHeader hash in the NCSD header matches this NCCH.
 	// NOTE: We're not checking isOpen() here.
 	// That should be checked by the caller.
 	loadNCCH(content_idx, &this->ncch_reader);
@@ -2963,4 +2965,167 @@ bool Nintendo3DS::hasDangerousPermissions(void) const
 	return d->perm.isDangerous;
 }
 
+
+/**
+ * Verify the ROM image using its internal hashes.
+ *
+ * For the primary NCCH, this checks the SHA-256 hashes of the
+ * ExHeader, the ExeFS header, and each ExeFS file. For CCIs,
+ * the ExHeader hash in the NCSD header is also checked.
+ * ExeFS files are read sequentially and hashed in parallel.
+ *
+ * NOTE: RomFS is not checked.
+ *
+ * @param errors	[out] Integrity errors. (empty if the ROM image is intact)
+ * @param group		[in,opt] Task group for cancellation.
+ * @return 0 if verified; negative POSIX error code on error. (-ENOTSUP if no internal hashes)
+ */
+int Nintendo3DS::verifyIntegrity(vector<IntegrityError> &errors, TaskGroup *group)
+{
+	RP_D(Nintendo3DS);
+	errors.clear();
+	if (!d->isValid || !d->file) {
+		// ROM image isn't valid.
+		return -EIO;
+	} else if (d->romType != Nintendo3DSPrivate::ROM_TYPE_CCI &&
+		   d->romType != Nintendo3DSPrivate::ROM_TYPE_CIA &&
+		   d->romType != Nintendo3DSPrivate::ROM_TYPE_NCCH)
+	{
+		// Only NCCHs have hashes.
+		return -ENOTSUP;
+	} else if (!(MultiHash::supportedAlgorithms() & MultiHash::ALGO_SHA256)) {
+		// SHA-256 isn't available.
+		return -ENOTSUP;
+	}
+
+	NCCHReader *const ncch = d->loadNCCH();
+	if (!ncch || !ncch->isOpen()) {
+		// Unable to open the primary NCCH.
+		return -EIO;
+	}
+	const N3DS_NCCH_Header_NoSig_t *const ncch_header = ncch->ncchHeader();
+	if (!ncch_header) {
+		return -EIO;
+	}
+	if (ncch->verifyResult() != KeyManager::VERIFY_OK) {
+		// Encrypted, and the keys aren't available.
+		return -EIO;
+	}
+
+	// SHA-256 of a buffer.
+	auto sha256 = [](const void *data, size_t size, uint8_t *digest) {
+		MultiHash hash(MultiHash::ALGO_SHA256);
+		hash.update(data, size);
+		hash.finalize();
+		hash.digest(MultiHash::ALGO_SHA256, digest, 32);
+	};
+	auto addError = [&errors](const char *location, const char *description) {
+		IntegrityError error;
+		error.location = location;
+		error.description = description;
+		errors.emplace_back(std::move(error));
+	};
+	uint8_t digest[32];
+
+	// ExHeader. (Only the first 0x400 bytes are hashed.)
+	const uint32_t exheader_size = le32_to_cpu(ncch_header->exheader_size);
+	if (exheader_size != 0) {
+		const N3DS_NCCH_ExHeader_t *const exheader = ncch->ncchExHeader();
+		if (!exheader || exheader_size > sizeof(*exheader)) {
+			addError("ExHeader", C_("Nintendo3DS", "Unable to load the ExHeader."));
+		} else {
+			sha256(exheader, exheader_size, digest);
+			if (memcmp(digest, ncch_header->exheader_hash, sizeof(digest)) != 0) {
+				addError("ExHeader", C_("Nintendo3DS", "SHA-256 mismatch."));
+			}
+		}
+
+		if (d->romType == Nintendo3DSPrivate::ROM_TYPE_CCI &&
+		    (d->headers_loaded & Nintendo3DSPrivate::HEADER_NCSD) &&
+		    memcmp(d->mxh.ncsd_header.cci.exheader_sha256, ncch_header->exheader_hash, 32) != 0)
+		{
+			addError("NCSD", C_("Nintendo3DS", "The ExHeader hash does not match partition 0."));
+		}
+	}
+
+	// ExeFS.
+	const N3DS_ExeFS_Header_t *const exefs_header = ncch->exefsHeader();
+	if (!exefs_header) {
+		// No ExeFS.
+		return 0;
+	}
+	const uint32_t exefs_hash_region_size =
+		le32_to_cpu(ncch_header->exefs_hash_region_size) << d->media_unit_shift;
+	if (exefs_hash_region_size == sizeof(*exefs_header)) {
+		// The hash region is the ExeFS header.
+		// TODO: Larger hash regions?
+		sha256(exefs_header, sizeof(*exefs_header), digest);
+		if (memcmp(digest, ncch_header->exefs_uperblock_hash, sizeof(digest)) != 0) {
+			addError("ExeFS", C_("Nintendo3DS", "SHA-256 mismatch."));
+		}
+	}
+
+	// Read the ExeFS files sequentially, then hash them in parallel.
+	// NOTE: Hashes are stored in reverse order.
+	struct ExeFSFile {
+		string name;
+		unique_ptr<uint8_t[]> data;
+		size_t size;
+		const uint8_t *expected;
+		bool ok;
+	};
+	vector<ExeFSFile> files;
+	files.reserve(ARRAY_SIZE(exefs_header->files));
+	for (unsigned int i = 0; i < ARRAY_SIZE(exefs_header->files); i++) {
+		const N3DS_ExeFS_File_Header_t *const fhdr = &exefs_header->files[i];
+		if (fhdr->name[0] == '\0')
+			continue;
+
+		ExeFSFile file;
+		file.name = "ExeFS/";
+		file.name.append(fhdr->name, strnlen(fhdr->name, sizeof(fhdr->name)));
+		file.size = le32_to_cpu(fhdr->size);
+		file.expected = exefs_header->hashes[ARRAY_SIZE(exefs_header->files) - 1 - i];
+		file.ok = false;
+
+		const string fname(fhdr->name, strnlen(fhdr->name, sizeof(fhdr->name)));
+		IRpFile *const f = ncch->open(N3DS_NCCH_SECTION_EXEFS, fname.c_str());
+		if (f) {
+			if (f->isOpen()) {
+				file.data.reset(new uint8_t[file.size]);
+				if (f->read(file.data.get(), file.size) != file.size) {
+					file.data.reset();
+				}
+			}
+			f->unref();
+		}
+		if (!file.data) {
+			addError(file.name.c_str(), C_("Nintendo3DS", "Unable to read the file."));
+			continue;
+		}
+		files.emplace_back(std::move(file));
+
+		if (group && group->isCancelled()) {
+			return -ECANCELED;
+		}
+	}
+
+	auto hashFiles = [&files, &sha256](size_t begin, size_t end, ScratchArena*) {
+		for (size_t i = begin; i < end; i++) {
+			ExeFSFile &file = files[i];
+			uint8_t file_digest[32];
+			sha256(file.data.get(), file.size, file_digest);
+			file.ok = (memcmp(file_digest, file.expected, sizeof(file_digest)) == 0);
+		}
+	};
+	ThreadPool::instance()->parallelFor(0, files.size(), 1, hashFiles);
+
+	for (const ExeFSFile &file : files) {
+		if (!file.ok) {
+			addError(file.name.c_str(), C_("Nintendo3DS", "SHA-256 mismatch."));
+		}
+	}
+	return 0;
+}
+
 }
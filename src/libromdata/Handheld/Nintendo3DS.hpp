@@ -23,6 +23,7 @@ ROMDATA_DECL_IMGPF()
 ROMDATA_DECL_IMGINT()
 ROMDATA_DECL_ICONANIM()
 ROMDATA_DECL_IMGEXT()
+ROMDATA_DECL_VERIFYINTEGRITY()
 ROMDATA_DECL_END()
 
 }
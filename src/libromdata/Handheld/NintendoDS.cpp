@@ -14,6 +14,9 @@
 #include "data/NintendoPublishers.hpp"
 #include "data/NintendoLanguage.hpp"
 
+// librptexture
+#include "librptexture/decoder/PixelConversion.hpp"
+
 // librpbase, librpfile, librptexture
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
@@ -334,18 +337,49 @@ const rp_image *NintendoDSPrivate::loadIcon(void)
 		iconAnimData->seq_count = seq_idx;
 
 		// Convert the required bitmaps.
+		// NOTE: Each bitmap is only decoded once. Other palette
+		// combinations use a copy of the decoded CI8 image with
+		// the palette replaced, since the pixel data is identical.
+		array<const rp_image*, 8> bmp_decoded;
+		bmp_decoded.fill(nullptr);
 		for (unsigned int i = 0; i < static_cast<unsigned int>(bmp_used.size()); i++) {
-			if (bmp_used[i]) {
-				iconAnimData->count = i + 1;
+			if (!bmp_used[i])
+				continue;
+			iconAnimData->count = i + 1;
 
-				const uint8_t bmp = (i & 7);
-				const uint8_t pal = (i >> 3) & 7;
+			const uint8_t bmp = (i & 7);
+			const uint8_t pal = (i >> 3) & 7;
+			if (!bmp_decoded[bmp]) {
+				// First use of this bitmap. Decode it.
 				iconAnimData->frames[i] = ImageDecoder::fromNDS_CI4(32, 32,
 					nds_icon_title.dsi_icon_data[bmp],
 					sizeof(nds_icon_title.dsi_icon_data[bmp]),
 					nds_icon_title.dsi_icon_pal[pal],
 					sizeof(nds_icon_title.dsi_icon_pal[pal]));
+				bmp_decoded[bmp] = iconAnimData->frames[i];
+				continue;
+			}
+
+			// Bitmap has already been decoded with a different palette.
+			rp_image *const img = bmp_decoded[bmp]->dup();
+			if (!img->isValid() || img->palette_len() < 16) {
+				// Could not allocate the image.
+				delete img;
+				continue;
+			}
+
+			// Convert the palette.
+			// NOTE: Same as ImageDecoder::fromNDS_CI4().
+			const uint16_t *const pal_buf = nds_icon_title.dsi_icon_pal[pal];
+			uint32_t *const palette = img->palette();
+			for (unsigned int j = 0; j < 16; j++) {
+				// NDS color format is BGR555.
+				palette[j] = PixelConversion::BGR555_to_ARGB32(le16_to_cpu(pal_buf[j]));
 			}
+			// Color 0 is always transparent.
+			palette[0] = 0;
+			img->set_tr_idx(0);
+			iconAnimData->frames[i] = img;
 		}
 	}
 
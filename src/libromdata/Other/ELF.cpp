@@ -12,7 +12,9 @@
 #include "elf_structs.h"
 
 // librpbase, librpfile
+#include "librpfile/FileView.hpp"
 using namespace LibRpBase;
+using LibRpFile::FileView;
 using LibRpFile::IRpFile;
 
 // cinttypes was added in MSVC 2013.
@@ -33,7 +35,6 @@ using LibRpFile::IRpFile;
 
 // C++ STL classes.
 using std::string;
-using std::unique_ptr;
 using std::vector;
 
 // Uninitialized vector class.
@@ -231,7 +232,6 @@ int ELFPrivate::checkProgramHeaders(void)
 	off64_t e_phoff;
 	unsigned int e_phnum;
 	unsigned int phsize;
-	uint8_t phbuf[sizeof(Elf64_Phdr)];
 
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
 		e_phoff = static_cast<off64_t>(Elf_Header.elf64.e_phoff);
@@ -248,21 +248,20 @@ int ELFPrivate::checkProgramHeaders(void)
 		return 0;
 	}
 
-	int ret = file->seek(e_phoff);
-	if (ret != 0) {
-		// Seek error.
-		return ret;
+	// Get the entire program header table at once.
+	// NOTE: e_phnum is 16-bit, so the table is at most ~3.5 MB.
+	const FileView phView(file, e_phoff, static_cast<size_t>(e_phnum) * phsize, 8);
+	if (!phView.data()) {
+		// Seek and/or read error.
+		return -EIO;
 	}
+	// If the table was truncated, only process complete entries.
+	e_phnum = static_cast<unsigned int>(phView.size() / phsize);
 
-	// Read all of the program header entries.
+	// Process all of the program header entries.
 	const bool isHostEndian = (Elf_Header.primary.e_data == ELFDATAHOST);
-	for (; e_phnum > 0; e_phnum--) {
-		size_t size = file->read(phbuf, phsize);
-		if (size != phsize) {
-			// Read error.
-			break;
-		}
-
+	const uint8_t *phbuf = phView.data();
+	for (; e_phnum > 0; e_phnum--, phbuf += phsize) {
 		// Check the type.
 		uint32_t p_type;
 		memcpy(&p_type, phbuf, sizeof(p_type));
@@ -282,17 +281,11 @@ int ELFPrivate::checkProgramHeaders(void)
 				// NOTE: Interpreter should be NULL-terminated.
 				if (info.size <= 256) {
 					char buf[256];
-					const off64_t prevoff = file->tell();
-					size = file->seekAndRead(info.addr, buf, info.size);
+					size_t size = file->seekAndRead(info.addr, buf, info.size);
 					if (size != info.size) {
 						// Seek and/or read error.
 						return -EIO;
 					}
-					ret = file->seek(prevoff);
-					if (ret != 0) {
-						// Seek error.
-						return ret;
-					}
 
 					// Remove trailing NULLs.
 					while (info.size > 0 && buf[info.size-1] == 0) {
@@ -340,7 +333,6 @@ int ELFPrivate::checkSectionHeaders(void)
 	off64_t e_shoff;
 	unsigned int e_shnum;
 	unsigned int shsize;
-	uint8_t shbuf[sizeof(Elf64_Shdr)];
 
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
 		e_shoff = static_cast<off64_t>(Elf_Header.elf64.e_shoff);
@@ -357,21 +349,20 @@ int ELFPrivate::checkSectionHeaders(void)
 		return 0;
 	}
 
-	int ret = file->seek(e_shoff);
-	if (ret != 0) {
-		// Seek error.
-		return ret;
+	// Get the entire section header table at once.
+	// NOTE: e_shnum is 16-bit, so the table is at most 4 MB.
+	const FileView shView(file, e_shoff, static_cast<size_t>(e_shnum) * shsize, 8);
+	if (!shView.data()) {
+		// Seek and/or read error.
+		return -EIO;
 	}
+	// If the table was truncated, only process complete entries.
+	e_shnum = static_cast<unsigned int>(shView.size() / shsize);
 
-	// Read all of the section header entries.
+	// Process all of the section header entries.
 	const bool isHostEndian = (Elf_Header.primary.e_data == ELFDATAHOST);
-	for (; e_shnum > 0; e_shnum--) {
-		size_t size = file->read(shbuf, shsize);
-		if (size != shsize) {
-			// Read error.
-			break;
-		}
-
+	const uint8_t *shbuf = shView.data();
+	for (; e_shnum > 0; e_shnum--, shbuf += shsize) {
 		// Check the type.
 		uint32_t s_type;
 		memcpy(&s_type, &shbuf[4], sizeof(s_type));
@@ -415,17 +406,11 @@ int ELFPrivate::checkSectionHeaders(void)
 		}
 
 		uint8_t buf[256];
-		const off64_t prevoff = file->tell();
-		size = file->seekAndRead(int_addr, buf, int_size);
+		size_t size = file->seekAndRead(int_addr, buf, int_size);
 		if (size != int_size) {
 			// Seek and/or read error.
 			return -EIO;
 		}
-		ret = file->seek(prevoff);
-		if (ret != 0) {
-			// Seek error.
-			return ret;
-		}
 
 		// Parse the note.
 		Elf32_Nhdr *const nhdr = reinterpret_cast<Elf32_Nhdr*>(buf);
@@ -624,10 +609,10 @@ int ELFPrivate::addPtDynamicFields(void)
 		return -2;
 	}
 
-	// Read the header.
+	// Get the header.
 	const unsigned int sz_to_read = static_cast<unsigned int>(pt_dynamic.size);
-	unique_ptr<uint8_t[]> pt_dyn_buf(new uint8_t[sz_to_read]);
-	size_t size = file->seekAndRead(pt_dynamic.addr, pt_dyn_buf.get(), sz_to_read);
+	const FileView pt_dyn_buf(file, pt_dynamic.addr, sz_to_read, 8);
+	const size_t size = pt_dyn_buf.size();
 	if (size != sz_to_read) {
 		// Read error.
 		return -3;
@@ -641,7 +626,7 @@ int ELFPrivate::addPtDynamicFields(void)
 	// TODO: DT_RPATH/DT_RUNPATH
 	// Requires string table parsing too?
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
-		const Elf64_Dyn *phdr = reinterpret_cast<const Elf64_Dyn*>(pt_dyn_buf.get());
+		const Elf64_Dyn *phdr = reinterpret_cast<const Elf64_Dyn*>(pt_dyn_buf.data());
 		const Elf64_Dyn *const phdr_end = phdr + (size / sizeof(*phdr));
 		// TODO: Don't allow duplicates?
 		for (; phdr < phdr_end; phdr++) {
@@ -660,7 +645,7 @@ int ELFPrivate::addPtDynamicFields(void)
 			}
 		}
 	} else {
-		const Elf32_Dyn *phdr = reinterpret_cast<const Elf32_Dyn*>(pt_dyn_buf.get());
+		const Elf32_Dyn *phdr = reinterpret_cast<const Elf32_Dyn*>(pt_dyn_buf.data());
 		const Elf32_Dyn *const phdr_end = phdr + (size / sizeof(*phdr));
 		for (; phdr < phdr_end; phdr++) {
 			Elf32_Sword d_tag = elf32_to_cpu(phdr->d_tag);
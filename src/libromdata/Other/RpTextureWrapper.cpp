@@ -199,13 +199,34 @@ vector<RomData::ImageSizeDef> RpTextureWrapper::supportedImageSizes(ImageType im
 		return vector<ImageSizeDef>();
 	}
 
-	// Return the image's size.
-	const ImageSizeDef imgsz[] = {{nullptr,
-		static_cast<uint16_t>(d->texture->width()),
-		static_cast<uint16_t>(d->texture->height()),
-		0
-	}};
-	return vector<ImageSizeDef>(imgsz, imgsz + 1);
+	// Return the image's size, followed by the sizes
+	// of any mipmaps that can be decoded separately.
+	// Mipmap 0 is the full image.
+	vector<ImageSizeDef> ret;
+	const int mipmapCount = std::max(d->texture->mipmapCount(), 1);
+	ret.reserve(mipmapCount);
+	for (int mip = 0; mip < mipmapCount; mip++) {
+		int dimensions[3];
+		if (d->texture->getMipmapDimensions(mip, dimensions) != 0)
+			break;
+
+		const ImageSizeDef imgsz = {nullptr,
+			static_cast<uint16_t>(dimensions[0]),
+			static_cast<uint16_t>(dimensions[1] > 0 ? dimensions[1] : 1),
+			static_cast<uint16_t>(mip)
+		};
+		ret.push_back(imgsz);
+	}
+	if (ret.empty()) {
+		// No mipmap dimensions. Use the image's size.
+		const ImageSizeDef imgsz = {nullptr,
+			static_cast<uint16_t>(d->texture->width()),
+			static_cast<uint16_t>(d->texture->height()),
+			0
+		};
+		ret.push_back(imgsz);
+	}
+	return ret;
 }
 
 /**
@@ -345,4 +366,35 @@ int RpTextureWrapper::loadInternalImage(ImageType imageType, const rp_image **pI
 		d->texture->image);	// func
 }
 
+/**
+ * Load an internal image at a specific size.
+ * Called by RomData::image() if a size was requested.
+ * @param imageType	[in] Image type to load.
+ * @param index		[in] Image index. (ImageSizeDef::index from supportedImageSizes())
+ * @param pImage	[out] Pointer to const rp_image* to store the image in.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpTextureWrapper::loadInternalImageSized(ImageType imageType, int index, const rp_image **pImage)
+{
+	ASSERT_loadInternalImage(imageType, pImage);
+	RP_D(RpTextureWrapper);
+	if (imageType != IMG_INT_IMAGE) {
+		// Only IMG_INT_IMAGE is supported by RpTextureWrapper.
+		*pImage = nullptr;
+		return -ENOENT;
+	} else if (!d->file) {
+		// File isn't open.
+		*pImage = nullptr;
+		return -EBADF;
+	} else if (!d->isValid) {
+		// Texture isn't valid.
+		*pImage = nullptr;
+		return -EIO;
+	}
+
+	// ImageSizeDef::index is the mipmap number.
+	*pImage = d->texture->mipmap(index);
+	return (*pImage != nullptr ? 0 : -EIO);
+}
+
 }
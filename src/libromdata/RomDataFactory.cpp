@@ -19,11 +19,15 @@ using namespace LibRpFile;
 
 // librpthreads
 #include "librpthreads/pthread_once.h"
+#include "librpthreads/Profiler.hpp"
 
 // librptexture
 #include "librptexture/FileFormatFactory.hpp"
 using LibRpTexture::FileFormatFactory;
 
+// Precomputed file extension and MIME type lists.
+#include "RomDataFactory_lists.h"
+
 // C++ STL classes.
 using std::string;
 using std::unordered_map;
@@ -133,9 +137,23 @@ class RomDataFactoryPrivate
 		template<typename klass>
 		static LibRpBase::RomData *RomData_ctor(LibRpFile::IRpFile *file)
 		{
+			RP_PROFILE_SCOPE(STAGE_CONSTRUCT);
 			return new klass(file);
 		}
 
+		/**
+		 * Check if a ROM is supported by a RomData subclass.
+		 * This wraps RomDataFns::isRomSupported() for profiling.
+		 * @param fns RomDataFns
+		 * @param info DetectInfo containing ROM detection information.
+		 * @return Class-specific system ID (>= 0) if supported; -1 if not.
+		 */
+		static inline int isRomSupported(const RomDataFns *fns, const RomData::DetectInfo *info)
+		{
+			RP_PROFILE_SCOPE(STAGE_DETECT);
+			return fns->isRomSupported(info);
+		}
+
 #define GetRomDataFns(sys, attrs) \
 	{sys::isRomSupported_static, \
 	 RomDataFactoryPrivate::RomData_ctor<sys>, \
@@ -177,9 +195,9 @@ class RomDataFactoryPrivate
 		static RomData *openDreamcastVMSandVMI(IRpFile *file);
 
 		// Vectors for file extensions and MIME types.
-		// We want to collect them once per session instead of
-		// repeatedly collecting them, since the caller might
-		// not cache them.
+		// These are filled from the precomputed tables in
+		// RomDataFactory_lists.h on first use, so the RomData
+		// subclasses don't have to be queried.
 		// pthread_once() control variable.
 		static vector<RomDataFactory::ExtInfo> vec_exts;
 		static vector<const char*> vec_mimeTypes;
@@ -191,9 +209,6 @@ class RomDataFactoryPrivate
 		 * Used for Win32 COM registration.
 		 *
 		 * Internal function; must be called using pthread_once().
-		 *
-		 * NOTE: The return value is a struct that includes a flag
-		 * indicating if the file type handler supports thumbnails.
 		 */
 		static void init_supportedFileExtensions(void);
 
@@ -406,7 +421,11 @@ RomData *RomDataFactoryPrivate::openDreamcastVMSandVMI(IRpFile *file)
 
 	// Attempt to create a DreamcastSave using both the
 	// VMS and VMI files.
-	DreamcastSave *const dcSave = new DreamcastSave(vms_file, vmi_file);
+	DreamcastSave *dcSave;
+	{
+		RP_PROFILE_SCOPE(STAGE_CONSTRUCT);
+		dcSave = new DreamcastSave(vms_file, vmi_file);
+	}
 	(*other_file)->unref();	// Not needed anymore.
 	if (!dcSave->isValid()) {
 		// Not valid.
@@ -460,6 +479,7 @@ RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
 	}
 
 	if (mayBeXbox) {
+		RP_PROFILE_SCOPE(STAGE_CONSTRUCT);
 		RomData *const romData = new XboxDisc(file);
 		if (romData->isValid()) {
 			// Got an Xbox disc.
@@ -470,6 +490,7 @@ RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
 
 	// Not a game-specific file system.
 	// Use the generic ISO-9660 parser.
+	RP_PROFILE_SCOPE(STAGE_CONSTRUCT);
 	return new ISO(file);
 }
 
@@ -570,7 +591,7 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 		uint32_t magic = header.u32[fns->address/4];
 		if (be32_to_cpu(magic) == fns->size) {
 			// Found a matching magic number.
-			if (fns->isRomSupported(&info) >= 0) {
+			if (RomDataFactoryPrivate::isRomSupported(fns, &info) >= 0) {
 				RomData *const romData = fns->newRomData(file);
 				if (romData->isValid()) {
 					// RomData subclass obtained.
@@ -586,6 +607,7 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 	// Check for supported textures.
 	{
 		// TODO: RpTextureWrapper::isRomSupported()?
+		RP_PROFILE_SCOPE(STAGE_CONSTRUCT);
 		RomData *const romData = new RpTextureWrapper(file);
 		if (romData->isValid()) {
 			// RomData subclass obtained.
@@ -665,16 +687,23 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 				continue;
 
 			// Read the header data.
+			// If the file supports zero-copy views, use the
+			// file data directly instead of copying it.
 			info.header.addr = fns->address;
-			int ret = file->seek(info.header.addr);
-			if (ret != 0)
-				continue;
-			info.header.size = static_cast<uint32_t>(file->read(header.u8, fns->size));
-			if (info.header.size != fns->size)
-				continue;
+			const uint8_t *const pView = file->view(info.header.addr, fns->size);
+			if (pView) {
+				info.header.pData = pView;
+				info.header.size = fns->size;
+			} else {
+				info.header.pData = header.u8;
+				info.header.size = static_cast<uint32_t>(
+					file->seekAndRead(info.header.addr, header.u8, fns->size));
+				if (info.header.size != fns->size)
+					continue;
+			}
 		}
 
-		if (fns->isRomSupported(&info) >= 0) {
+		if (RomDataFactoryPrivate::isRomSupported(fns, &info) >= 0) {
 			RomData *romData;
 			if (fns->attrs & RDA_CHECK_ISO) {
 				// Check for a game-specific ISO subclass.
@@ -724,6 +753,7 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			static const int footer_size = 1024;
 			if (info.szFile > footer_size) {
 				info.header.addr = static_cast<uint32_t>(info.szFile - footer_size);
+				info.header.pData = header.u8;
 				info.header.size = static_cast<uint32_t>(file->seekAndRead(info.header.addr, header.u8, footer_size));
 				if (info.header.size == 0) {
 					// Seek and/or read error.
@@ -733,7 +763,7 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			readFooter = true;
 		}
 
-		if (fns->isRomSupported(&info) >= 0) {
+		if (RomDataFactoryPrivate::isRomSupported(fns, &info) >= 0) {
 			RomData *const romData = fns->newRomData(file);
 			if (romData->isValid()) {
 				// RomData subclass obtained.
@@ -754,12 +784,33 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
  * Used for Win32 COM registration.
  *
  * Internal function; must be called using pthread_once().
- *
- * NOTE: The return value is a struct that includes a flag
- * indicating if the file type handler supports thumbnails.
  */
 void RomDataFactoryPrivate::init_supportedFileExtensions(void)
 {
+	// Use the precomputed table.
+	vec_exts.reserve(ARRAY_SIZE(RomDataFactory_exts));
+	for (size_t i = 0; i < ARRAY_SIZE(RomDataFactory_exts); i++) {
+		vec_exts.emplace_back(RomDataFactory::ExtInfo(
+			&RomDataFactory_strtbl[RomDataFactory_exts[i].ext],
+			RomDataFactory_exts[i].attrs));
+	}
+}
+
+/**
+ * Enumerate all supported file extensions by querying
+ * every RomData and FileFormat subclass.
+ *
+ * supportedFileExtensions() uses a precomputed table instead.
+ * This function is used by RomDataFactoryTest to verify and
+ * regenerate the precomputed table.
+ *
+ * @return All supported file extensions, including the leading dot.
+ */
+vector<RomDataFactory::ExtInfo> RomDataFactory::enumSupportedFileExtensions(void)
+{
+	typedef RomDataFactoryPrivate::RomDataFns RomDataFns;
+	vector<ExtInfo> vec_exts;
+
 	// In order to handle multiple RomData subclasses
 	// that support the same extensions, we're using
 	// an unordered_map<string, unsigned int>. If any of the
@@ -770,15 +821,15 @@ void RomDataFactoryPrivate::init_supportedFileExtensions(void)
 	unordered_map<string, unsigned int> map_exts;
 
 	static const size_t reserve_size =
-		(ARRAY_SIZE(romDataFns_magic) +
-		 ARRAY_SIZE(romDataFns_header) +
-		 ARRAY_SIZE(romDataFns_footer)) * 2;
+		(ARRAY_SIZE(RomDataFactoryPrivate::romDataFns_magic) +
+		 ARRAY_SIZE(RomDataFactoryPrivate::romDataFns_header) +
+		 ARRAY_SIZE(RomDataFactoryPrivate::romDataFns_footer)) * 2;
 	vec_exts.reserve(reserve_size);
 #ifdef HAVE_UNORDERED_MAP_RESERVE
 	map_exts.reserve(reserve_size);
 #endif /* HAVE_UNORDERED_MAP_RESERVE */
 
-	for (const RomDataFns *const *tblptr = &romDataFns_tbl[0];
+	for (const RomDataFns *const *tblptr = &RomDataFactoryPrivate::romDataFns_tbl[0];
 	     *tblptr != nullptr; tblptr++)
 	{
 		const RomDataFns *fns = *tblptr;
@@ -796,8 +847,7 @@ void RomDataFactoryPrivate::init_supportedFileExtensions(void)
 				} else {
 					// First time encountering this extension.
 					map_exts[*sys_exts] = fns->attrs;
-					vec_exts.emplace_back(RomDataFactory::ExtInfo(
-						*sys_exts, fns->attrs));
+					vec_exts.emplace_back(ExtInfo(*sys_exts, fns->attrs));
 				}
 			}
 		}
@@ -807,7 +857,7 @@ void RomDataFactoryPrivate::init_supportedFileExtensions(void)
 	static const unsigned int FFF_ATTRS = ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA;
 	vector<const char*> vec_exts_fileFormat = FileFormatFactory::supportedFileExtensions();
 	std::for_each(vec_exts_fileFormat.cbegin(), vec_exts_fileFormat.cend(),
-		[&map_exts](const char *ext) {
+		[&map_exts, &vec_exts](const char *ext) {
 			auto iter = map_exts.find(ext);
 			if (iter != map_exts.end()) {
 				// We already had this extension.
@@ -816,7 +866,7 @@ void RomDataFactoryPrivate::init_supportedFileExtensions(void)
 			} else {
 				// First time encountering this extension.
 				map_exts[ext] = FFF_ATTRS;
-				vec_exts.emplace_back(RomDataFactory::ExtInfo(ext, FFF_ATTRS));
+				vec_exts.emplace_back(ExtInfo(ext, FFF_ATTRS));
 			}
 		}
 	);
@@ -825,6 +875,8 @@ void RomDataFactoryPrivate::init_supportedFileExtensions(void)
 	for (auto iter = vec_exts.begin(); iter != vec_exts.end(); ++iter) {
 		iter->attrs = map_exts[iter->ext];
 	}
+
+	return vec_exts;
 }
 
 /**
@@ -851,6 +903,28 @@ const vector<RomDataFactory::ExtInfo> &RomDataFactory::supportedFileExtensions(v
  */
 void RomDataFactoryPrivate::init_supportedMimeTypes(void)
 {
+	// Use the precomputed table.
+	vec_mimeTypes.reserve(ARRAY_SIZE(RomDataFactory_mimeTypes));
+	for (size_t i = 0; i < ARRAY_SIZE(RomDataFactory_mimeTypes); i++) {
+		vec_mimeTypes.emplace_back(&RomDataFactory_strtbl[RomDataFactory_mimeTypes[i]]);
+	}
+}
+
+/**
+ * Enumerate all supported MIME types by querying
+ * every RomData and FileFormat subclass.
+ *
+ * supportedMimeTypes() uses a precomputed table instead.
+ * This function is used by RomDataFactoryTest to verify and
+ * regenerate the precomputed table.
+ *
+ * @return All supported MIME types.
+ */
+vector<const char*> RomDataFactory::enumSupportedMimeTypes(void)
+{
+	typedef RomDataFactoryPrivate::RomDataFns RomDataFns;
+	vector<const char*> vec_mimeTypes;
+
 	// TODO: Add generic types, e.g. application/octet-stream?
 
 	// In order to handle multiple RomData subclasses
@@ -860,15 +934,15 @@ void RomDataFactoryPrivate::init_supportedMimeTypes(void)
 	unordered_set<string> set_mimeTypes;
 
 	static const size_t reserve_size =
-		(ARRAY_SIZE(romDataFns_magic) +
-		 ARRAY_SIZE(romDataFns_header) +
-		 ARRAY_SIZE(romDataFns_footer)) * 2;
+		(ARRAY_SIZE(RomDataFactoryPrivate::romDataFns_magic) +
+		 ARRAY_SIZE(RomDataFactoryPrivate::romDataFns_header) +
+		 ARRAY_SIZE(RomDataFactoryPrivate::romDataFns_footer)) * 2;
 	vec_mimeTypes.reserve(reserve_size);
 #ifdef HAVE_UNORDERED_SET_RESERVE
 	set_mimeTypes.reserve(reserve_size);
 #endif /* HAVE_UNORDERED_SET_RESERVE */
 
-	for (const RomDataFns *const *tblptr = &romDataFns_tbl[0];
+	for (const RomDataFns *const *tblptr = &RomDataFactoryPrivate::romDataFns_tbl[0];
 	     *tblptr != nullptr; tblptr++)
 	{
 		const RomDataFns *fns = *tblptr;
@@ -890,7 +964,7 @@ void RomDataFactoryPrivate::init_supportedMimeTypes(void)
 	// Get MIME types from FileFormatFactory.
 	vector<const char*> vec_mimeTypes_fileFormat = FileFormatFactory::supportedMimeTypes();
 	std::for_each(vec_mimeTypes_fileFormat.cbegin(), vec_mimeTypes_fileFormat.cend(),
-		[&set_mimeTypes](const char *mimeType) {
+		[&set_mimeTypes, &vec_mimeTypes](const char *mimeType) {
 			auto iter = set_mimeTypes.find(mimeType);
 			if (iter == set_mimeTypes.end()) {
 				set_mimeTypes.insert(mimeType);
@@ -898,6 +972,8 @@ void RomDataFactoryPrivate::init_supportedMimeTypes(void)
 			}
 		}
 	);
+
+	return vec_mimeTypes;
 }
 
 /**
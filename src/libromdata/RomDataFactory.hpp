@@ -104,6 +104,30 @@ class RomDataFactory
 		 * @return All supported MIME types.
 		 */
 		static const std::vector<const char*> &supportedMimeTypes(void);
+
+		/**
+		 * Enumerate all supported file extensions by querying
+		 * every RomData and FileFormat subclass.
+		 *
+		 * supportedFileExtensions() uses a precomputed table instead.
+		 * This function is used by RomDataFactoryTest to verify and
+		 * regenerate the precomputed table.
+		 *
+		 * @return All supported file extensions, including the leading dot.
+		 */
+		static std::vector<ExtInfo> enumSupportedFileExtensions(void);
+
+		/**
+		 * Enumerate all supported MIME types by querying
+		 * every RomData and FileFormat subclass.
+		 *
+		 * supportedMimeTypes() uses a precomputed table instead.
+		 * This function is used by RomDataFactoryTest to verify and
+		 * regenerate the precomputed table.
+		 *
+		 * @return All supported MIME types.
+		 */
+		static std::vector<const char*> enumSupportedMimeTypes(void);
 };
 
 }
@@ -0,0 +1,558 @@
+/** RomDataFactory_lists.h: Generated by RomDataFactoryTest. **/
+/** DO NOT EDIT! See RomDataFactoryTest.cpp for instructions. **/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_ROMDATAFACTORY_LISTS_H__
+#define __ROMPROPERTIES_LIBROMDATA_ROMDATAFACTORY_LISTS_H__
+
+#include <stdint.h>
+
+// String pool.
+static const char RomDataFactory_strtbl[] =
+	"\0"
+	".bin\0"
+	".wibn\0"
+	".xbe\0"
+	".xdbf\0"
+	".spa\0"
+	".xex\0"
+	".xexp\0"
+	".gb\0"
+	".sgb\0"
+	".sgb2\0"
+	".gbc\0"
+	".cgb\0"
+	".gbx\0"
+	".gba\0"
+	".agb\0"
+	".mb\0"
+	".srl\0"
+	".lnx\0"
+	".ngp\0"
+	".ngc\0"
+	".ngpc\0"
+	".firm\0"
+	".smdh\0"
+	".nds\0"
+	".dsi\0"
+	".ids\0"
+	".brstm\0"
+	".gbs\0"
+	".nsf\0"
+	".spc\0"
+	".vgm\0"
+	".vgz\0"
+	".elf\0"
+	".so\0"
+	".o\0"
+	".core\0"
+	".debug\0"
+	".rpx\0"
+	".rpl\0"
+	".iso\0"
+	".gdi\0"
+	".vms\0"
+	".vmi\0"
+	".dci\0"
+	".gcm\0"
+	".rvm\0"
+	".wbfs\0"
+	".ciso\0"
+	".cso\0"
+	".tgc\0"
+	".dec\0"
+	".wia\0"
+	".bnr\0"
+	".gci\0"
+	".gcs\0"
+	".sav\0"
+	".cmd\0"
+	".dat\0"
+	".gen\0"
+	".smd\0"
+	".32x\0"
+	".pco\0"
+	".sgd\0"
+	".68k\0"
+	".md\0"
+	".z64\0"
+	".n64\0"
+	".v64\0"
+	".nes\0"
+	".nez\0"
+	".fds\0"
+	".qd\0"
+	".tds\0"
+	".smc\0"
+	".swc\0"
+	".sfc\0"
+	".fig\0"
+	".ufo\0"
+	".mgd\0"
+	".bs\0"
+	".bsx\0"
+	".wud\0"
+	".wux\0"
+	".wad\0"
+	".bwf\0"
+	".3dsx\0"
+	".3ds\0"
+	".3dz\0"
+	".cci\0"
+	".cia\0"
+	".ncch\0"
+	".app\0"
+	".cxi\0"
+	".cfa\0"
+	".csu\0"
+	".adx\0"
+	".ahx\0"
+	".bcstm\0"
+	".bfstm\0"
+	".bcwav\0"
+	".psf\0"
+	".minipsf\0"
+	".psf1\0"
+	".minipsf1\0"
+	".psf2\0"
+	".minipsf2\0"
+	".ssf\0"
+	".minissf\0"
+	".dsf\0"
+	".minidsf\0"
+	".usf\0"
+	".miniusf\0"
+	".gsf\0"
+	".minigsf\0"
+	".snsf\0"
+	".minisnsf\0"
+	".qsf\0"
+	".miniqsf\0"
+	".sap\0"
+	".sndh\0"
+	".sid\0"
+	".psid\0"
+	".nfc\0"
+	".nfp\0"
+	".dylib\0"
+	".bundle\0"
+	".prb\0"
+	".cab\0"
+	".exe\0"
+	".dll\0"
+	".acm\0"
+	".ax\0"
+	".cpl\0"
+	".drv\0"
+	".efi\0"
+	".mui\0"
+	".ocx\0"
+	".scr\0"
+	".sys\0"
+	".tsp\0"
+	".fon\0"
+	".icl\0"
+	".vxd\0"
+	".386\0"
+	".psv\0"
+	".mcb\0"
+	".mcx\0"
+	".pda\0"
+	".psx\0"
+	".mcs\0"
+	".ps1\0"
+	".sms\0"
+	".gg\0"
+	".min\0"
+	".iso9660\0"
+	".xiso\0"
+	".vb\0"
+	".dds\0"
+	".pvr\0"
+	".gvr\0"
+	".svr\0"
+	".vtf\0"
+	".xbx\0"
+	".xpr\0"
+	".tex\0"
+	".texs\0"
+	"application/x-wii-wibn\0"
+	"application/x-xbox-executable\0"
+	"application/x-xbox360-xdbf\0"
+	"application/x-xbox360-executable\0"
+	"application/x-xbox360-patch\0"
+	"application/x-gameboy-rom\0"
+	"application/x-gameboy-color-rom\0"
+	"application/x-gba-rom\0"
+	"application/x-atari-lynx-rom\0"
+	"application/x-neo-geo-pocket-rom\0"
+	"application/x-neo-geo-pocket-color-rom\0"
+	"application/x-nintendo-3ds-firm\0"
+	"application/x-nintendo-3ds-smdh\0"
+	"application/x-nintendo-ds-rom\0"
+	"application/x-nintendo-dsi-rom\0"
+	"audio/x-brstm\0"
+	"audio/x-gbs\0"
+	"audio/x-nsf\0"
+	"audio/x-spc\0"
+	"audio/x-vgm\0"
+	"application/x-object\0"
+	"application/x-executable\0"
+	"application/x-sharedlib\0"
+	"application/x-core\0"
+	"application/x-xbox360-stfs\0"
+	"application/x-dreamcast-rom\0"
+	"application/x-dreamcast-iso-image\0"
+	"application/x-dreamcast-cuesheet\0"
+	"application/x-dc-rom\0"
+	"application/x-dreamcast-vms\0"
+	"application/x-dreamcast-vms-info\0"
+	"application/x-dreamcast-dci\0"
+	"application/x-gamecube-rom\0"
+	"application/x-gamecube-iso-image\0"
+	"application/x-wii-rom\0"
+	"application/x-wii-iso-image\0"
+	"application/x-wbfs\0"
+	"application/x-wia\0"
+	"application/x-cso\0"
+	"application/x-nasos-image\0"
+	"application/x-gamecube-bnr\0"
+	"application/x-gamecube-save\0"
+	"application/x-ique-cmd\0"
+	"application/x-ique-dat\0"
+	"application/x-genesis-rom\0"
+	"application/x-sega-cd-rom\0"
+	"application/x-genesis-32x-rom\0"
+	"application/x-sega-cd-32x-rom\0"
+	"application/x-sega-pico-rom\0"
+	"application/x-n64-rom\0"
+	"application/x-nes-rom\0"
+	"application/x-fds-disk\0"
+	"application/vnd.nintendo.snes.rom\0"
+	"application/x-snes-rom\0"
+	"application/x-saturn-rom\0"
+	"application/x-wii-save\0"
+	"application/x-wii-u-rom\0"
+	"application/x-wii-wad\0"
+	"application/x-nintendo-3ds-3dsx\0"
+	"application/x-nintendo-3ds-rom\0"
+	"application/x-nintendo-3ds-emmc\0"
+	"application/x-nintendo-3ds-cia\0"
+	"application/x-nintendo-3ds-ncch\0"
+	"audio/x-adx\0"
+	"audio/x-bcstm\0"
+	"audio/x-bfstm\0"
+	"audio/x-bcwav\0"
+	"audio/x-psf\0"
+	"audio/x-minipsf\0"
+	"audio/x-sap\0"
+	"audio/x-sndh\0"
+	"audio/prs.sid\0"
+	"application/x-nintendo-amiibo\0"
+	"application/x-mach-object\0"
+	"application/x-mach-executable\0"
+	"application/x-mach-sharedlib\0"
+	"application/x-mach-core\0"
+	"application/x-mach-bundle\0"
+	"application/x-nintendo-badge\0"
+	"application/x-nintendo-badge-set\0"
+	"application/x-ms-dos-executable\0"
+	"application/x-msdownload\0"
+	"application/x-ps1-save\0"
+	"application/x-game-com-rom\0"
+	"application/x-sms-rom\0"
+	"application/x-gamegear-rom\0"
+	"application/x-pokemon-mini-rom\0"
+	"application/x-cd-image\0"
+	"application/x-iso9660-image\0"
+	"application/x-virtual-boy-rom\0"
+	"image/x-dds\0"
+	"image/x-pvr\0"
+	"image/x-sega-pvr\0"
+	"image/x-sega-gvr\0"
+	"image/x-sega-svr\0"
+	"image/x-sega-pvrx\0"
+	"image/vnd.valve.source.texture\0"
+	"image/x-vtf\0"
+	"image/x-vtf3\0"
+	"image/x-xbox-xpr0\0"
+	"image/x-didj-texture\0";
+
+// Supported file extensions: {string pool offset, attributes}
+static const struct {
+	uint16_t ext;
+	uint16_t attrs;
+} RomDataFactory_exts[] = {
+	{1, 0x010D},	// .bin
+	{6, 0x0001},	// .wibn
+	{12, 0x0005},	// .xbe
+	{17, 0x0001},	// .xdbf
+	{23, 0x0001},	// .spa
+	{28, 0x0005},	// .xex
+	{33, 0x0005},	// .xexp
+	{39, 0x0005},	// .gb
+	{43, 0x0005},	// .sgb
+	{48, 0x0005},	// .sgb2
+	{54, 0x0005},	// .gbc
+	{59, 0x0005},	// .cgb
+	{64, 0x0005},	// .gbx
+	{69, 0x0005},	// .gba
+	{74, 0x0005},	// .agb
+	{79, 0x0005},	// .mb
+	{83, 0x0007},	// .srl
+	{88, 0x0000},	// .lnx
+	{93, 0x0004},	// .ngp
+	{98, 0x0004},	// .ngc
+	{103, 0x0004},	// .ngpc
+	{109, 0x0000},	// .firm
+	{115, 0x0005},	// .smdh
+	{121, 0x0007},	// .nds
+	{126, 0x0007},	// .dsi
+	{131, 0x0007},	// .ids
+	{136, 0x0004},	// .brstm
+	{143, 0x0004},	// .gbs
+	{148, 0x0004},	// .nsf
+	{153, 0x0004},	// .spc
+	{158, 0x0004},	// .vgm
+	{163, 0x0004},	// .vgz
+	{168, 0x0000},	// .elf
+	{173, 0x0000},	// .so
+	{177, 0x0000},	// .o
+	{180, 0x0000},	// .core
+	{186, 0x0000},	// .debug
+	{193, 0x0000},	// .rpx
+	{198, 0x0000},	// .rpl
+	{203, 0x010D},	// .iso
+	{208, 0x000D},	// .gdi
+	{213, 0x0001},	// .vms
+	{218, 0x0001},	// .vmi
+	{223, 0x0001},	// .dci
+	{228, 0x000D},	// .gcm
+	{233, 0x000D},	// .rvm
+	{238, 0x000D},	// .wbfs
+	{244, 0x000D},	// .ciso
+	{250, 0x000D},	// .cso
+	{255, 0x000D},	// .tgc
+	{260, 0x000D},	// .dec
+	{265, 0x000D},	// .wia
+	{270, 0x0005},	// .bnr
+	{275, 0x0005},	// .gci
+	{280, 0x0005},	// .gcs
+	{285, 0x0005},	// .sav
+	{290, 0x0005},	// .cmd
+	{295, 0x0005},	// .dat
+	{300, 0x0008},	// .gen
+	{305, 0x0008},	// .smd
+	{310, 0x0008},	// .32x
+	{315, 0x0008},	// .pco
+	{320, 0x0008},	// .sgd
+	{325, 0x0008},	// .68k
+	{330, 0x0008},	// .md
+	{334, 0x0004},	// .z64
+	{339, 0x0004},	// .n64
+	{344, 0x0004},	// .v64
+	{349, 0x0000},	// .nes
+	{354, 0x0000},	// .nez
+	{359, 0x0000},	// .fds
+	{364, 0x0000},	// .qd
+	{368, 0x0000},	// .tds
+	{373, 0x0000},	// .smc
+	{378, 0x0000},	// .swc
+	{383, 0x0000},	// .sfc
+	{388, 0x0000},	// .fig
+	{393, 0x0000},	// .ufo
+	{398, 0x0000},	// .mgd
+	{403, 0x0000},	// .bs
+	{407, 0x0000},	// .bsx
+	{412, 0x0009},	// .wud
+	{417, 0x0009},	// .wux
+	{422, 0x0005},	// .wad
+	{427, 0x0005},	// .bwf
+	{432, 0x0007},	// .3dsx
+	{438, 0x0007},	// .3ds
+	{443, 0x0007},	// .3dz
+	{448, 0x0007},	// .cci
+	{453, 0x0007},	// .cia
+	{458, 0x0007},	// .ncch
+	{464, 0x0007},	// .app
+	{469, 0x0007},	// .cxi
+	{474, 0x0007},	// .cfa
+	{479, 0x0007},	// .csu
+	{484, 0x0004},	// .adx
+	{489, 0x0004},	// .ahx
+	{494, 0x0004},	// .bcstm
+	{501, 0x0004},	// .bfstm
+	{508, 0x0004},	// .bcwav
+	{515, 0x0004},	// .psf
+	{520, 0x0004},	// .minipsf
+	{529, 0x0004},	// .psf1
+	{535, 0x0004},	// .minipsf1
+	{545, 0x0004},	// .psf2
+	{551, 0x0004},	// .minipsf2
+	{561, 0x0004},	// .ssf
+	{566, 0x0004},	// .minissf
+	{575, 0x0004},	// .dsf
+	{580, 0x0004},	// .minidsf
+	{589, 0x0004},	// .usf
+	{594, 0x0004},	// .miniusf
+	{603, 0x0004},	// .gsf
+	{608, 0x0004},	// .minigsf
+	{617, 0x0004},	// .snsf
+	{623, 0x0004},	// .minisnsf
+	{633, 0x0004},	// .qsf
+	{638, 0x0004},	// .miniqsf
+	{647, 0x0004},	// .sap
+	{652, 0x0004},	// .sndh
+	{658, 0x0004},	// .sid
+	{663, 0x0004},	// .psid
+	{669, 0x0001},	// .nfc
+	{674, 0x0001},	// .nfp
+	{679, 0x0000},	// .dylib
+	{686, 0x0000},	// .bundle
+	{694, 0x0001},	// .prb
+	{699, 0x0001},	// .cab
+	{704, 0x0000},	// .exe
+	{709, 0x0000},	// .dll
+	{714, 0x0000},	// .acm
+	{719, 0x0000},	// .ax
+	{723, 0x0000},	// .cpl
+	{728, 0x0000},	// .drv
+	{733, 0x0000},	// .efi
+	{738, 0x0000},	// .mui
+	{743, 0x0000},	// .ocx
+	{748, 0x0000},	// .scr
+	{753, 0x0000},	// .sys
+	{758, 0x0000},	// .tsp
+	{763, 0x0000},	// .fon
+	{768, 0x0000},	// .icl
+	{773, 0x0000},	// .vxd
+	{778, 0x0000},	// .386
+	{783, 0x0005},	// .psv
+	{788, 0x0005},	// .mcb
+	{793, 0x0005},	// .mcx
+	{798, 0x0005},	// .pda
+	{803, 0x0005},	// .psx
+	{808, 0x0005},	// .mcs
+	{813, 0x0005},	// .ps1
+	{818, 0x0004},	// .sms
+	{823, 0x0004},	// .gg
+	{827, 0x0004},	// .min
+	{832, 0x0109},	// .iso9660
+	{841, 0x0109},	// .xiso
+	{847, 0x0000},	// .vb
+	{851, 0x0005},	// .dds
+	{856, 0x0005},	// .pvr
+	{861, 0x0005},	// .gvr
+	{866, 0x0005},	// .svr
+	{871, 0x0005},	// .vtf
+	{876, 0x0005},	// .xbx
+	{881, 0x0005},	// .xpr
+	{886, 0x0005},	// .tex
+	{891, 0x0005},	// .texs
+};
+
+// Supported MIME types: string pool offset
+static const uint16_t RomDataFactory_mimeTypes[] = {
+	897,	// application/x-wii-wibn
+	920,	// application/x-xbox-executable
+	950,	// application/x-xbox360-xdbf
+	977,	// application/x-xbox360-executable
+	1010,	// application/x-xbox360-patch
+	1038,	// application/x-gameboy-rom
+	1064,	// application/x-gameboy-color-rom
+	1096,	// application/x-gba-rom
+	1118,	// application/x-atari-lynx-rom
+	1147,	// application/x-neo-geo-pocket-rom
+	1180,	// application/x-neo-geo-pocket-color-rom
+	1219,	// application/x-nintendo-3ds-firm
+	1251,	// application/x-nintendo-3ds-smdh
+	1283,	// application/x-nintendo-ds-rom
+	1313,	// application/x-nintendo-dsi-rom
+	1344,	// audio/x-brstm
+	1358,	// audio/x-gbs
+	1370,	// audio/x-nsf
+	1382,	// audio/x-spc
+	1394,	// audio/x-vgm
+	1406,	// application/x-object
+	1427,	// application/x-executable
+	1452,	// application/x-sharedlib
+	1476,	// application/x-core
+	1495,	// application/x-xbox360-stfs
+	1522,	// application/x-dreamcast-rom
+	1550,	// application/x-dreamcast-iso-image
+	1584,	// application/x-dreamcast-cuesheet
+	1617,	// application/x-dc-rom
+	1638,	// application/x-dreamcast-vms
+	1666,	// application/x-dreamcast-vms-info
+	1699,	// application/x-dreamcast-dci
+	1727,	// application/x-gamecube-rom
+	1754,	// application/x-gamecube-iso-image
+	1787,	// application/x-wii-rom
+	1809,	// application/x-wii-iso-image
+	1837,	// application/x-wbfs
+	1856,	// application/x-wia
+	1874,	// application/x-cso
+	1892,	// application/x-nasos-image
+	1918,	// application/x-gamecube-bnr
+	1945,	// application/x-gamecube-save
+	1973,	// application/x-ique-cmd
+	1996,	// application/x-ique-dat
+	2019,	// application/x-genesis-rom
+	2045,	// application/x-sega-cd-rom
+	2071,	// application/x-genesis-32x-rom
+	2101,	// application/x-sega-cd-32x-rom
+	2131,	// application/x-sega-pico-rom
+	2159,	// application/x-n64-rom
+	2181,	// application/x-nes-rom
+	2203,	// application/x-fds-disk
+	2226,	// application/vnd.nintendo.snes.rom
+	2260,	// application/x-snes-rom
+	2283,	// application/x-saturn-rom
+	2308,	// application/x-wii-save
+	2331,	// application/x-wii-u-rom
+	2355,	// application/x-wii-wad
+	2377,	// application/x-nintendo-3ds-3dsx
+	2409,	// application/x-nintendo-3ds-rom
+	2440,	// application/x-nintendo-3ds-emmc
+	2472,	// application/x-nintendo-3ds-cia
+	2503,	// application/x-nintendo-3ds-ncch
+	2535,	// audio/x-adx
+	2547,	// audio/x-bcstm
+	2561,	// audio/x-bfstm
+	2575,	// audio/x-bcwav
+	2589,	// audio/x-psf
+	2601,	// audio/x-minipsf
+	2617,	// audio/x-sap
+	2629,	// audio/x-sndh
+	2642,	// audio/prs.sid
+	2656,	// application/x-nintendo-amiibo
+	2686,	// application/x-mach-object
+	2712,	// application/x-mach-executable
+	2742,	// application/x-mach-sharedlib
+	2771,	// application/x-mach-core
+	2795,	// application/x-mach-bundle
+	2821,	// application/x-nintendo-badge
+	2850,	// application/x-nintendo-badge-set
+	2883,	// application/x-ms-dos-executable
+	2915,	// application/x-msdownload
+	2940,	// application/x-ps1-save
+	2963,	// application/x-game-com-rom
+	2990,	// application/x-sms-rom
+	3012,	// application/x-gamegear-rom
+	3039,	// application/x-pokemon-mini-rom
+	3070,	// application/x-cd-image
+	3093,	// application/x-iso9660-image
+	3121,	// application/x-virtual-boy-rom
+	3151,	// image/x-dds
+	3163,	// image/x-pvr
+	3175,	// image/x-sega-pvr
+	3192,	// image/x-sega-gvr
+	3209,	// image/x-sega-svr
+	3226,	// image/x-sega-pvrx
+	3244,	// image/vnd.valve.source.texture
+	3275,	// image/x-vtf
+	3287,	// image/x-vtf3
+	3300,	// image/x-xbox-xpr0
+	3318,	// image/x-didj-texture
+};
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_ROMDATAFACTORY_LISTS_H__ */
@@ -0,0 +1,332 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomDataLoader.cpp: Asynchronous RomData loader.                         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RomDataLoader.hpp"
+#include "RomDataFactory.hpp"
+
+// librpbase, librpfile
+using LibRpBase::RomData;
+using LibRpFile::IRpFile;
+
+// librpthreads
+#include "librpthreads/Atomics.h"
+#include "librpthreads/Mutex.hpp"
+#include "librpthreads/ThreadPool.hpp"
+#include "librpthreads/pthread_once.h"
+using LibRpBase::Mutex;
+using LibRpBase::MutexLocker;
+using LibRpBase::ScratchArena;
+using LibRpBase::TaskGroup;
+
+namespace LibRomData {
+
+class RomDataLoaderPrivate
+{
+	public:
+		RomDataLoaderPrivate(IRpFile *file, RomData *romData);
+		~RomDataLoaderPrivate();
+
+	private:
+		RP_DISABLE_COPY(RomDataLoaderPrivate)
+
+	public:
+		volatile int ref_cnt;	// Reference count.
+		unsigned int id;	// Loader ID.
+		static volatile unsigned int last_id;
+		IRpFile *file;		// ROM file. (released after RomDataFactory::create())
+		RomData *romData;	// RomData object.
+
+		// Notification function.
+		RomDataLoader::NotifyFn notifyFn;
+		void *userdata;
+
+		// Held while notifying, so cancel() can't return
+		// while a notification is in progress.
+		Mutex notifyMutex;
+		bool started;
+		volatile bool cancelled;
+
+		// Task group for all loaders.
+		// NOTE: Like the global thread pool, this is never deleted,
+		// since deleting it would wait for all pending loads.
+		static pthread_once_t group_once_control;
+		static TaskGroup *group;
+		static void initGroup(void);
+
+		/**
+		 * Notify the frontend that a stage has completed.
+		 * @param q RomDataLoader.
+		 * @param stage Stage.
+		 * @return True if loading should continue; false if it was cancelled.
+		 */
+		bool notify(RomDataLoader *q, RomDataLoader::Stage stage);
+
+		/**
+		 * Load the RomData object.
+		 * Called on a worker thread.
+		 * @param q RomDataLoader.
+		 */
+		void load(RomDataLoader *q);
+
+		/**
+		 * Loader task.
+		 * @param param RomDataLoader. (ref()'d by start())
+		 * @param arena Scratch arena. (unused)
+		 */
+		static void loadTask(void *param, ScratchArena *arena);
+};
+
+/** RomDataLoaderPrivate **/
+
+pthread_once_t RomDataLoaderPrivate::group_once_control = PTHREAD_ONCE_INIT;
+TaskGroup *RomDataLoaderPrivate::group = nullptr;
+volatile unsigned int RomDataLoaderPrivate::last_id = 0;
+
+RomDataLoaderPrivate::RomDataLoaderPrivate(IRpFile *file, RomData *romData)
+	: ref_cnt(1)
+	, id(ATOMIC_INC_FETCH(&last_id))
+	, file(file ? file->ref() : nullptr)
+	, romData(romData ? romData->ref() : nullptr)
+	, notifyFn(nullptr)
+	, userdata(nullptr)
+	, started(false)
+	, cancelled(false)
+{ }
+
+RomDataLoaderPrivate::~RomDataLoaderPrivate()
+{
+	if (file) {
+		file->unref();
+	}
+	if (romData) {
+		romData->unref();
+	}
+}
+
+/**
+ * Initialize the task group.
+ * Called by pthread_once().
+ */
+void RomDataLoaderPrivate::initGroup(void)
+{
+	group = new TaskGroup();
+}
+
+/**
+ * Notify the frontend that a stage has completed.
+ * @param q RomDataLoader.
+ * @param stage Stage.
+ * @return True if loading should continue; false if it was cancelled.
+ */
+bool RomDataLoaderPrivate::notify(RomDataLoader *q, RomDataLoader::Stage stage)
+{
+	MutexLocker locker(notifyMutex);
+	if (cancelled)
+		return false;
+	notifyFn(q, stage, userdata);
+	return true;
+}
+
+/**
+ * Load the RomData object.
+ * Called on a worker thread.
+ * @param q RomDataLoader.
+ */
+void RomDataLoaderPrivate::load(RomDataLoader *q)
+{
+	if (!romData) {
+		// Create the RomData object.
+		// NOTE: The file is ref()'d by RomData.
+		if (!cancelled) {
+			romData = RomDataFactory::create(file);
+		}
+		file->unref();
+		file = nullptr;
+		if (!romData) {
+			// Not supported.
+			notify(q, RomDataLoader::STAGE_ERROR);
+			return;
+		}
+	}
+	if (!notify(q, RomDataLoader::STAGE_HEADER))
+		return;
+
+	// Fields.
+	romData->fields();
+	if (!notify(q, RomDataLoader::STAGE_FIELDS))
+		return;
+
+	// Internal images.
+	const uint32_t imgbf = romData->supportedImageTypes();
+	if (imgbf & RomData::IMGBF_INT_BANNER) {
+		romData->image(RomData::IMG_INT_BANNER);
+	}
+	if (imgbf & RomData::IMGBF_INT_ICON) {
+		romData->image(RomData::IMG_INT_ICON);
+		romData->iconAnimData();
+	}
+
+	// Close the file.
+	// Keeping the file open may prevent the user from
+	// changing the file.
+	romData->close();
+	notify(q, RomDataLoader::STAGE_IMAGES);
+}
+
+/**
+ * Loader task.
+ * @param param RomDataLoader. (ref()'d by start())
+ * @param arena Scratch arena. (unused)
+ */
+void RomDataLoaderPrivate::loadTask(void *param, ScratchArena *arena)
+{
+	RP_UNUSED(arena);
+	RomDataLoader *const q = static_cast<RomDataLoader*>(param);
+	q->d_ptr->load(q);
+	q->unref();
+}
+
+/** RomDataLoader **/
+
+/**
+ * Create a loader for a ROM file.
+ * The file is ref()'d, and RomDataFactory::create()
+ * is called on a worker thread once start() is called.
+ * @param file ROM file.
+ */
+RomDataLoader::RomDataLoader(IRpFile *file)
+	: d_ptr(new RomDataLoaderPrivate(file, nullptr))
+{ }
+
+/**
+ * Create a loader for an existing RomData object.
+ * The RomData object is ref()'d.
+ * @param romData RomData object.
+ */
+RomDataLoader::RomDataLoader(RomData *romData)
+	: d_ptr(new RomDataLoaderPrivate(nullptr, romData))
+{ }
+
+RomDataLoader::~RomDataLoader()
+{
+	delete d_ptr;
+}
+
+/**
+ * Take a reference to this RomDataLoader object.
+ * @return this
+ */
+RomDataLoader *RomDataLoader::ref(void)
+{
+	RP_D(RomDataLoader);
+	ATOMIC_INC_FETCH(&d->ref_cnt);
+	return this;
+}
+
+/**
+ * Unreference this RomDataLoader object.
+ * If ref_cnt reaches 0, the RomDataLoader object is deleted.
+ */
+void RomDataLoader::unref(void)
+{
+	RP_D(RomDataLoader);
+	assert(d->ref_cnt > 0);
+	if (ATOMIC_DEC_FETCH(&d->ref_cnt) <= 0) {
+		// All references removed.
+		delete this;
+	}
+}
+
+/**
+ * Start loading on a worker thread.
+ *
+ * The worker thread holds a reference to this object,
+ * so the caller can unref() it at any time.
+ *
+ * NOTE: Until the final stage is notified, the worker thread
+ * may still be using the RomData object. Only use the
+ * functions listed for the stages that have completed.
+ *
+ * @param fn Stage notification function.
+ * @param userdata User data for fn.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomDataLoader::start(NotifyFn fn, void *userdata)
+{
+	RP_D(RomDataLoader);
+	if (!fn) {
+		return -EINVAL;
+	} else if (!d->file && !d->romData) {
+		// Nothing to load.
+		return -EBADF;
+	} else if (d->started) {
+		// Already started.
+		return -EBUSY;
+	}
+
+	d->notifyFn = fn;
+	d->userdata = userdata;
+	d->started = true;
+
+	// NOTE: If the thread pool doesn't have any worker threads,
+	// the task is run immediately on the calling thread.
+	pthread_once(&RomDataLoaderPrivate::group_once_control, RomDataLoaderPrivate::initGroup);
+	RomDataLoaderPrivate::group->run(RomDataLoaderPrivate::loadTask, ref());
+	return 0;
+}
+
+/**
+ * Cancel loading.
+ *
+ * Once this function returns, fn won't be called again.
+ * A stage that's currently being loaded can't be interrupted,
+ * but its results will be discarded.
+ */
+void RomDataLoader::cancel(void)
+{
+	RP_D(RomDataLoader);
+	MutexLocker locker(d->notifyMutex);
+	d->cancelled = true;
+}
+
+/**
+ * Has loading been cancelled?
+ * @return True if cancelled; false if not.
+ */
+bool RomDataLoader::isCancelled(void) const
+{
+	RP_D(const RomDataLoader);
+	return d->cancelled;
+}
+
+/**
+ * Get the RomData object.
+ * This is only valid after STAGE_HEADER has been notified.
+ * @return RomData object, or nullptr if it isn't available. (NOT ref()'d)
+ */
+RomData *RomDataLoader::romData(void) const
+{
+	RP_D(const RomDataLoader);
+	return d->romData;
+}
+
+/**
+ * Get the loader ID.
+ * Each RomDataLoader has a unique ID.
+ * This can be passed along with queued notifications
+ * in order to detect notifications from an old loader.
+ * @return Loader ID.
+ */
+unsigned int RomDataLoader::id(void) const
+{
+	RP_D(const RomDataLoader);
+	return d->id;
+}
+
+}
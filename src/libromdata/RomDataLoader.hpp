@@ -0,0 +1,168 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomDataLoader.hpp: Asynchronous RomData loader.                         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_ROMDATALOADER_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_ROMDATALOADER_HPP__
+
+#include "common.h"
+
+namespace LibRpBase {
+	class RomData;
+}
+namespace LibRpFile {
+	class IRpFile;
+}
+
+namespace LibRomData {
+
+class RomDataLoaderPrivate;
+class RomDataLoader
+{
+	public:
+		/**
+		 * Create a loader for a ROM file.
+		 * The file is ref()'d, and RomDataFactory::create()
+		 * is called on a worker thread once start() is called.
+		 * @param file ROM file.
+		 */
+		explicit RomDataLoader(LibRpFile::IRpFile *file);
+
+		/**
+		 * Create a loader for an existing RomData object.
+		 * The RomData object is ref()'d.
+		 * @param romData RomData object.
+		 */
+		explicit RomDataLoader(LibRpBase::RomData *romData);
+
+	protected:
+		/**
+		 * RomDataLoader destructor.
+		 * Use unref() instead.
+		 */
+		~RomDataLoader();
+
+	private:
+		friend class RomDataLoaderPrivate;
+		RomDataLoaderPrivate *const d_ptr;
+		RP_DISABLE_COPY(RomDataLoader)
+
+	public:
+		/**
+		 * Take a reference to this RomDataLoader object.
+		 * @return this
+		 */
+		RomDataLoader *ref(void);
+
+		/**
+		 * Unreference this RomDataLoader object.
+		 * If ref_cnt reaches 0, the RomDataLoader object is deleted.
+		 */
+		void unref(void);
+
+	public:
+		/**
+		 * Loading stages.
+		 *
+		 * Stages are notified in order. Header-level information
+		 * is cheap to load, so it's notified first; fields and
+		 * internal images may require reading large parts of
+		 * the file, e.g. Wii partition tables.
+		 */
+		enum Stage {
+			// RomData object was created.
+			// systemName(), fileType_string(), and
+			// supportedImageTypes() can be used.
+			STAGE_HEADER,
+
+			// fields() has been loaded.
+			STAGE_FIELDS,
+
+			// Internal images and iconAnimData() have been loaded,
+			// and the file has been closed. (final stage)
+			STAGE_IMAGES,
+
+			// The file isn't supported. (final stage)
+			STAGE_ERROR,
+		};
+
+		/**
+		 * Stage notification function.
+		 *
+		 * This is called on the worker thread, so UI frontends
+		 * must marshal the notification to the UI thread.
+		 * Do NOT call cancel() from this function.
+		 *
+		 * NOTE: This is called with an internal mutex held, and
+		 * cancel() waits for that mutex. This function must NOT
+		 * block on the UI thread, e.g. with a blocking queued
+		 * connection, or cancel() will deadlock. Post the
+		 * notification asynchronously instead. If the thread pool
+		 * doesn't have any worker threads, this may also be called
+		 * on the thread that called start().
+		 *
+		 * Notifications that were posted before cancel() returned
+		 * may still be delivered to the UI thread afterwards.
+		 * Use id() or isCancelled() to discard them.
+		 *
+		 * @param loader RomDataLoader.
+		 * @param stage Stage that was just completed.
+		 * @param userdata User data.
+		 */
+		typedef void (*NotifyFn)(RomDataLoader *loader, Stage stage, void *userdata);
+
+		/**
+		 * Start loading on a worker thread.
+		 *
+		 * The worker thread holds a reference to this object,
+		 * so the caller can unref() it at any time.
+		 *
+		 * NOTE: Until the final stage is notified, the worker thread
+		 * may still be using the RomData object. Only use the
+		 * functions listed for the stages that have completed.
+		 *
+		 * @param fn Stage notification function.
+		 * @param userdata User data for fn.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int start(NotifyFn fn, void *userdata);
+
+		/**
+		 * Cancel loading.
+		 *
+		 * Once this function returns, fn won't be called again.
+		 * A stage that's currently being loaded can't be interrupted,
+		 * but its results will be discarded.
+		 */
+		void cancel(void);
+
+		/**
+		 * Has loading been cancelled?
+		 * @return True if cancelled; false if not.
+		 */
+		bool isCancelled(void) const;
+
+		/**
+		 * Get the RomData object.
+		 * This is only valid after STAGE_HEADER has been notified.
+		 * @return RomData object, or nullptr if it isn't available. (NOT ref()'d)
+		 */
+		LibRpBase::RomData *romData(void) const;
+
+		/**
+		 * Get the loader ID.
+		 * Each RomDataLoader has a unique ID.
+		 * This can be passed along with queued notifications
+		 * in order to detect notifications from an old loader.
+		 * @return Loader ID.
+		 */
+		unsigned int id(void) const;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_ROMDATALOADER_HPP__ */
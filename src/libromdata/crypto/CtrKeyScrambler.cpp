@@ -178,13 +178,27 @@ int CtrKeyScrambler::CtrScramble(u128_t *keyNormal,
 		return -EINVAL;
 	}
 
-	// Load the key scrambler constant.
 	KeyManager *const keyManager = KeyManager::instance();
 	if (!keyManager) {
 		// Unable to initialize the KeyManager.
 		return -EIO;
 	}
 
+	// Check the derived key cache first.
+	// Scanning a 3DS library usually uses the same
+	// (KeyX, KeyY) pairs for many files.
+	u128_t keyXY[2];
+	keyXY[0] = *keyX;
+	keyXY[1] = *keyY;
+	if (keyManager->getDerivedKey(KeyManager::DERIVED_CTR_KEYNORMAL,
+	    reinterpret_cast<const uint8_t*>(keyXY), sizeof(keyXY), keyNormal->u8))
+	{
+		// Found the KeyNormal in the cache.
+		return 0;
+	}
+
+	// Load the key scrambler constant.
+
 	KeyManager::KeyData_t keyData;
 	KeyManager::VerifyResult res = keyManager->getAndVerify(
 		CtrKeyScramblerPrivate::EncryptionKeyNames[Key_Ctr_Scrambler], &keyData,
@@ -200,8 +214,14 @@ int CtrKeyScrambler::CtrScramble(u128_t *keyNormal,
 		return -EIO;	// TODO: Better error code?
 	}
 
-	return CtrScramble(keyNormal, keyX, keyY,
+	int ret = CtrScramble(keyNormal, keyX, keyY,
 		reinterpret_cast<const u128_t*>(keyData.key));
+	if (ret == 0) {
+		// Save the KeyNormal in the derived key cache.
+		keyManager->setDerivedKey(KeyManager::DERIVED_CTR_KEYNORMAL,
+			reinterpret_cast<const uint8_t*>(keyXY), sizeof(keyXY), keyNormal->u8);
+	}
+	return ret;
 }
 
 }
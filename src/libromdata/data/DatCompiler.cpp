@@ -0,0 +1,399 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * DatCompiler.cpp: Logiqx DAT to DAT index compiler.                      *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "DatCompiler.hpp"
+
+#ifndef ENABLE_XML
+#error Cannot compile DatCompiler.cpp without XML support.
+#endif
+
+// librpbase, librpfile
+#include "librpbase/datindex_structs.h"
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/RpFile.hpp"
+using namespace LibRpFile;
+
+// TinyXML2
+#include "tinyxml2.h"
+using namespace tinyxml2;
+
+// C++ STL classes.
+using std::string;
+using std::unique_ptr;
+using std::unordered_map;
+using std::vector;
+
+namespace LibRomData {
+
+class DatCompilerPrivate
+{
+	private:
+		// Static class.
+		DatCompilerPrivate();
+		~DatCompilerPrivate();
+		RP_DISABLE_COPY(DatCompilerPrivate)
+
+	public:
+		// Maximum DAT size. (uncompressed)
+		static const size_t DAT_SIZE_MAX = 512U*1024U*1024U;
+
+		/**
+		 * String table builder.
+		 * Identical strings are only stored once.
+		 */
+		class StringTable {
+			public:
+				StringTable()
+				{
+					// Offset 0 is always an empty string.
+					strtbl.push_back('\0');
+				}
+
+				/**
+				 * Add a string to the string table.
+				 * @param str String. (may be nullptr)
+				 * @return String offset.
+				 */
+				uint32_t add(const char *str)
+				{
+					if (!str || str[0] == '\0')
+						return 0;
+
+					auto iter = map.find(str);
+					if (iter != map.end())
+						return iter->second;
+
+					const uint32_t offset = static_cast<uint32_t>(strtbl.size());
+					strtbl.insert(strtbl.end(), str, str + strlen(str) + 1);
+					map.emplace(str, offset);
+					return offset;
+				}
+
+				/**
+				 * Get a string from the string table.
+				 * @param offset String offset.
+				 * @return String.
+				 */
+				inline const char *get(uint32_t offset) const
+				{
+					return &strtbl[offset];
+				}
+
+			public:
+				vector<char> strtbl;
+			private:
+				unordered_map<string, uint32_t> map;
+		};
+
+		/**
+		 * Parse a hexadecimal hash string.
+		 * @param str	[in] Hexadecimal string.
+		 * @param pBuf	[out] Output buffer.
+		 * @param size	[in] Size of pBuf.
+		 * @return True on success; false if the string is invalid.
+		 */
+		static bool parseHex(const char *str, uint8_t *pBuf, size_t size);
+
+		/**
+		 * Align a vector to an 8-byte boundary.
+		 * @param buf Vector.
+		 */
+		static inline void align8(vector<uint8_t> &buf)
+		{
+			buf.resize((buf.size() + 7) & ~static_cast<size_t>(7));
+		}
+
+		/**
+		 * Append a section to a vector.
+		 * The section is aligned to an 8-byte boundary.
+		 * @param buf	[in/out] Vector.
+		 * @param data	[in] Section data.
+		 * @param size	[in] Section size.
+		 * @return Section offset.
+		 */
+		static uint32_t appendSection(vector<uint8_t> &buf, const void *data, size_t size)
+		{
+			align8(buf);
+			const uint32_t offset = static_cast<uint32_t>(buf.size());
+			const uint8_t *const data8 = static_cast<const uint8_t*>(data);
+			buf.insert(buf.end(), data8, data8 + size);
+			return offset;
+		}
+};
+
+/**
+ * Parse a hexadecimal hash string.
+ * @param str	[in] Hexadecimal string.
+ * @param pBuf	[out] Output buffer.
+ * @param size	[in] Size of pBuf.
+ * @return True on success; false if the string is invalid.
+ */
+bool DatCompilerPrivate::parseHex(const char *str, uint8_t *pBuf, size_t size)
+{
+	if (!str || strlen(str) != size * 2)
+		return false;
+
+	for (size_t i = 0; i < size; i++, str += 2) {
+		uint8_t val = 0;
+		for (unsigned int j = 0; j < 2; j++) {
+			const char chr = str[j];
+			val <<= 4;
+			if (chr >= '0' && chr <= '9') {
+				val |= (chr - '0');
+			} else if (chr >= 'a' && chr <= 'f') {
+				val |= (chr - 'a' + 10);
+			} else if (chr >= 'A' && chr <= 'F') {
+				val |= (chr - 'A' + 10);
+			} else {
+				return false;
+			}
+		}
+		pBuf[i] = val;
+	}
+	return true;
+}
+
+/** DatCompiler **/
+
+/**
+ * Compile a Logiqx-format DAT file into a DAT index.
+ *
+ * No-Intro, Redump, and most other DAT groups use the
+ * Logiqx XML format. Both <game> and <machine> elements
+ * are supported. Serial numbers are taken from either
+ * a <serial> element or a "serial" attribute on <rom>.
+ *
+ * The DAT file may be gzipped.
+ *
+ * @param datFilename	[in] DAT filename.
+ * @param indexFilename	[in] Output DAT index filename.
+ * @return Number of entries compiled on success; negative POSIX error code on error.
+ */
+int DatCompiler::compile(const char *datFilename, const char *indexFilename)
+{
+	assert(datFilename != nullptr);
+	assert(indexFilename != nullptr);
+	if (!datFilename || datFilename[0] == '\0' ||
+	    !indexFilename || indexFilename[0] == '\0')
+	{
+		return -EINVAL;
+	}
+
+	// Read the entire DAT into memory.
+	unique_ptr<char[]> xml;
+	{
+		RpFile *const f_dat = new RpFile(datFilename, RpFile::FM_OPEN_READ_GZ);
+		if (!f_dat->isOpen()) {
+			const int err = f_dat->lastError();
+			f_dat->unref();
+			return (err != 0 ? -err : -EIO);
+		}
+
+		const off64_t xml_size = f_dat->size();
+		if (xml_size <= 0 || xml_size > static_cast<off64_t>(DatCompilerPrivate::DAT_SIZE_MAX)) {
+			// DAT is empty or too big.
+			f_dat->unref();
+			return -ENOMEM;
+		}
+		xml.reset(new char[static_cast<size_t>(xml_size)+1]);
+		const size_t size = f_dat->read(xml.get(), static_cast<size_t>(xml_size));
+		f_dat->unref();
+		if (size != static_cast<size_t>(xml_size)) {
+			// Read error.
+			return -EIO;
+		}
+		xml[static_cast<size_t>(xml_size)] = 0;
+	}
+
+	// Parse the XML.
+	XMLDocument doc;
+	int xerr = doc.Parse(xml.get());
+	xml.reset();
+	if (xerr != XML_SUCCESS) {
+		// Error parsing the DAT.
+		return -EIO;
+	}
+
+	// Root element must be datafile.
+	const XMLElement *const datafile = doc.FirstChildElement("datafile");
+	if (!datafile) {
+		// Not a Logiqx DAT.
+		return -EIO;
+	}
+
+	DatCompilerPrivate::StringTable strtbl;
+	DatIndex_Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, DATINDEX_MAGIC, sizeof(header.magic));
+	header.version = cpu_to_le32(DATINDEX_VERSION);
+
+	const XMLElement *const datHeader = datafile->FirstChildElement("header");
+	if (datHeader) {
+		const XMLElement *const name = datHeader->FirstChildElement("name");
+		if (name) {
+			header.dat_name = cpu_to_le32(strtbl.add(name->GetText()));
+		}
+		const XMLElement *const version = datHeader->FirstChildElement("version");
+		if (version) {
+			header.dat_version = cpu_to_le32(strtbl.add(version->GetText()));
+		}
+	}
+
+	// Process the games.
+	vector<DatIndex_Entry> entries;
+	for (const XMLElement *game = datafile->FirstChildElement(); game != nullptr;
+	     game = game->NextSiblingElement())
+	{
+		if (strcmp(game->Name(), "game") != 0 && strcmp(game->Name(), "machine") != 0)
+			continue;
+
+		const uint32_t game_name = strtbl.add(game->Attribute("name"));
+		uint32_t game_serial = 0;
+		const XMLElement *const serial = game->FirstChildElement("serial");
+		if (serial) {
+			game_serial = strtbl.add(serial->GetText());
+		}
+
+		for (const XMLElement *rom = game->FirstChildElement("rom"); rom != nullptr;
+		     rom = rom->NextSiblingElement("rom"))
+		{
+			DatIndex_Entry entry;
+			memset(&entry, 0, sizeof(entry));
+			entry.game_name = cpu_to_le32(game_name);
+			entry.rom_name = cpu_to_le32(strtbl.add(rom->Attribute("name")));
+			entry.size = cpu_to_le64(static_cast<uint64_t>(rom->Int64Attribute("size")));
+
+			const char *const rom_serial = rom->Attribute("serial");
+			entry.serial = cpu_to_le32(rom_serial ? strtbl.add(rom_serial) : game_serial);
+
+			uint32_t flags = 0;
+			uint8_t crc_be[4];
+			if (DatCompilerPrivate::parseHex(rom->Attribute("crc"), crc_be, sizeof(crc_be))) {
+				const uint32_t crc32 = (crc_be[0] << 24) | (crc_be[1] << 16) |
+				                       (crc_be[2] <<  8) |  crc_be[3];
+				entry.crc32 = cpu_to_le32(crc32);
+				flags |= DATINDEX_FLAG_HAS_CRC32;
+			}
+			if (DatCompilerPrivate::parseHex(rom->Attribute("sha1"), entry.sha1, sizeof(entry.sha1))) {
+				flags |= DATINDEX_FLAG_HAS_SHA1;
+			}
+			entry.flags = cpu_to_le32(flags);
+			entries.push_back(entry);
+		}
+	}
+
+	if (entries.size() > 0x7FFFFFFFU) {
+		// Too many entries.
+		return -ENOMEM;
+	}
+
+	// Build the keys.
+	const uint32_t entry_count = static_cast<uint32_t>(entries.size());
+	vector<DatIndex_CrcKey> crcKeys;
+	vector<DatIndex_Sha1Key> sha1Keys;
+	vector<DatIndex_SerialKey> serialKeys;
+	crcKeys.reserve(entry_count);
+	for (uint32_t i = 0; i < entry_count; i++) {
+		const DatIndex_Entry &entry = entries[i];
+
+		// NOTE: CRC32 keys are stored for all entries so the
+		// table has a fixed size. Entries without a CRC32
+		// are filtered out by DatIndex using the flags.
+		DatIndex_CrcKey crcKey;
+		crcKey.crc32 = entry.crc32;
+		crcKey.entry_idx = cpu_to_le32(i);
+		crcKeys.push_back(crcKey);
+
+		if (le32_to_cpu(entry.flags) & DATINDEX_FLAG_HAS_SHA1) {
+			DatIndex_Sha1Key sha1Key;
+			memcpy(sha1Key.sha1, entry.sha1, sizeof(sha1Key.sha1));
+			sha1Key.entry_idx = cpu_to_le32(i);
+			sha1Keys.push_back(sha1Key);
+		}
+
+		if (entry.serial != 0) {
+			DatIndex_SerialKey serialKey;
+			serialKey.serial = entry.serial;
+			serialKey.entry_idx = cpu_to_le32(i);
+			serialKeys.push_back(serialKey);
+		}
+	}
+
+	// Sort the keys.
+	// NOTE: std::stable_sort() keeps entries in DAT order
+	// when multiple entries have the same key.
+	std::stable_sort(crcKeys.begin(), crcKeys.end(),
+		[](const DatIndex_CrcKey &a, const DatIndex_CrcKey &b) {
+			return (le32_to_cpu(a.crc32) < le32_to_cpu(b.crc32));
+		});
+	std::stable_sort(sha1Keys.begin(), sha1Keys.end(),
+		[](const DatIndex_Sha1Key &a, const DatIndex_Sha1Key &b) {
+			return (memcmp(a.sha1, b.sha1, sizeof(a.sha1)) < 0);
+		});
+	std::stable_sort(serialKeys.begin(), serialKeys.end(),
+		[&strtbl](const DatIndex_SerialKey &a, const DatIndex_SerialKey &b) {
+			return (strcmp(strtbl.get(le32_to_cpu(a.serial)),
+			               strtbl.get(le32_to_cpu(b.serial))) < 0);
+		});
+
+	// Build the index.
+	vector<uint8_t> buf;
+	buf.resize(sizeof(header));
+	header.entry_count = cpu_to_le32(entry_count);
+	header.sha1_count = cpu_to_le32(static_cast<uint32_t>(sha1Keys.size()));
+	header.serial_count = cpu_to_le32(static_cast<uint32_t>(serialKeys.size()));
+	header.entry_offset = cpu_to_le32(DatCompilerPrivate::appendSection(buf,
+		entries.data(), entries.size() * sizeof(DatIndex_Entry)));
+	header.crc_offset = cpu_to_le32(DatCompilerPrivate::appendSection(buf,
+		crcKeys.data(), crcKeys.size() * sizeof(DatIndex_CrcKey)));
+	header.sha1_offset = cpu_to_le32(DatCompilerPrivate::appendSection(buf,
+		sha1Keys.data(), sha1Keys.size() * sizeof(DatIndex_Sha1Key)));
+	header.serial_offset = cpu_to_le32(DatCompilerPrivate::appendSection(buf,
+		serialKeys.data(), serialKeys.size() * sizeof(DatIndex_SerialKey)));
+	header.strtbl_offset = cpu_to_le32(DatCompilerPrivate::appendSection(buf,
+		strtbl.strtbl.data(), strtbl.strtbl.size()));
+	header.strtbl_size = cpu_to_le32(static_cast<uint32_t>(strtbl.strtbl.size()));
+	memcpy(buf.data(), &header, sizeof(header));
+	if (buf.size() > 0xFFFFFFFFU) {
+		// Index is too big. (offsets are 32-bit)
+		return -ENOMEM;
+	}
+
+	// Write the index.
+	// NOTE: The old index is deleted first instead of being
+	// overwritten, since other processes may have it mapped.
+	// NOTE: rpcli runs this with seccomp enabled, so the mkdir()
+	// and unlink() syscalls must be in rpcli's whitelist.
+	// DatCompilerTest writes the index into a subdirectory
+	// in order to check this with the test whitelist.
+	int ret = FileSystem::rmkdir(indexFilename);
+	if (ret != 0) {
+		return ret;
+	}
+	FileSystem::delete_file(indexFilename);
+	RpFile *const f_idx = new RpFile(indexFilename, RpFile::FM_CREATE_WRITE);
+	if (!f_idx->isOpen()) {
+		const int err = f_idx->lastError();
+		f_idx->unref();
+		return (err != 0 ? -err : -EIO);
+	}
+	const size_t size = f_idx->write(buf.data(), buf.size());
+	if (size != buf.size()) {
+		// Write error. Don't leave a truncated index around.
+		const int err = f_idx->lastError();
+		f_idx->unref();
+		FileSystem::delete_file(indexFilename);
+		return (err != 0 ? -err : -EIO);
+	}
+	f_idx->unref();
+
+	return static_cast<int>(entry_count);
+}
+
+}
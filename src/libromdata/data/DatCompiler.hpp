@@ -0,0 +1,44 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * DatCompiler.hpp: Logiqx DAT to DAT index compiler.                      *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DATCOMPILER_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_DATCOMPILER_HPP__
+
+#include "common.h"
+
+namespace LibRomData {
+
+class DatCompiler
+{
+	private:
+		// Static class.
+		DatCompiler();
+		~DatCompiler();
+		RP_DISABLE_COPY(DatCompiler)
+
+	public:
+		/**
+		 * Compile a Logiqx-format DAT file into a DAT index.
+		 *
+		 * No-Intro, Redump, and most other DAT groups use the
+		 * Logiqx XML format. Both <game> and <machine> elements
+		 * are supported. Serial numbers are taken from either
+		 * a <serial> element or a "serial" attribute on <rom>.
+		 *
+		 * The DAT file may be gzipped.
+		 *
+		 * @param datFilename	[in] DAT filename.
+		 * @param indexFilename	[in] Output DAT index filename.
+		 * @return Number of entries compiled on success; negative POSIX error code on error.
+		 */
+		static int compile(const char *datFilename, const char *indexFilename);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DATCOMPILER_HPP__ */
@@ -0,0 +1,376 @@
+/** Nintendo3DSSysTitles_data.h: Generated from Nintendo3DSSysTitles.tbl by gen_lookup_tables.py. **/
+/** DO NOT EDIT! Edit Nintendo3DSSysTitles.tbl and regenerate this file instead. **/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DATA_NINTENDO3DSSYSTITLES_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_DATA_NINTENDO3DSSYSTITLES_DATA_H__
+
+#include <stdint.h>
+
+// String pool. (572 bytes)
+// Offset 0 is the empty string, which indicates "no entry".
+static const char Nintendo3DSSysTitles_strtbl[] =
+	"\0"
+	"System Settings\0"
+	"JPN\0"
+	"USA\0"
+	"EUR\0"
+	"CHN\0"
+	"KOR\0"
+	"TWN\0"
+	"Download Play\0"
+	"Activity Log\0"
+	"Health and Safety Information\0"
+	"Nintendo 3DS Camera\0"
+	"Nintendo 3DS Sound\0"
+	"Mii Maker\0"
+	"StreetPass Mii Plaza\0"
+	"eShop\0"
+	"System Transfer\0"
+	"Nintendo Zone\0"
+	"Face Raiders\0"
+	"AR Games\0"
+	"System Updater (SAFE_MODE)\0"
+	"Promotional Video (v1.1.0)\0"
+	"Nintendo Network ID Settings\0"
+	"microSD Management\0"
+	"HOME Menu\0"
+	"Camera\0"
+	"Instruction Manual\0"
+	"Game Notes\0"
+	"Internet Browser\0"
+	"Friend List\0"
+	"Notifications\0"
+	"Software Keyboard\0"
+	"Software Keyboard (SAFE_MODE)\0"
+	"Mii picker\0"
+	"Picture picker\0"
+	"Voice memo picker\0"
+	"eShop applet\0"
+	"Miiverse\0"
+	"Miiverse posting applet\0"
+	"amiibo Settings\0";
+
+// sys_title_00040010: 96 entries, 128 slots.
+static const uint8_t Nintendo3DSSysTitles_sys_title_00040010_seeds[32] = {
+	    1,     9,     4,    13,     3,     8,     5,     2,
+	    6,     2,     1,     4,     1,     3,    11,     9,
+	    9,     2,    11,    11,     2,     0,     8,     2,
+	    3,     3,     2,     1,     4,     1,     2,     5,
+};
+static const struct Nintendo3DSSysTitles_sys_title_00040010_t {
+	uint32_t key;
+	uint16_t off[2];
+} Nintendo3DSSysTitles_sys_title_00040010[128] = {
+	{0x00022D00, {  204,    25}},
+	{0x00027700, {  137,    33}},
+	{0x00022400, {   98,    25}},
+	{0x20024100, {  309,    21}},
+	{0x20020300, {   68,    17}},
+	{0x00028100, {   41,    37}},
+	{0x00026100, {   41,    29}},
+	{0x00022900, {  168,    25}},
+	{0x00027900, {  168,    33}},
+	{0x00026400, {   98,    29}},
+	{0x00027300, {   68,    33}},
+	{0x00022700, {  137,    25}},
+	{0x20027D00, {  204,    33}},
+	{0x00020900, {  168,    17}},
+	{0x0002C100, {  280,    25}},
+	{0x00026700, {  137,    29}},
+	{0x00027500, {  118,    33}},
+	{0x00025000, {  253,    25}},
+	{0x00020400, {   98,    17}},
+	{0x0002C000, {  280,    21}},
+	{0, {0, 0}},
+	{0x00021700, {  137,    21}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x20021D00, {  204,    21}},
+	{0x00028200, {   55,    37}},
+	{0x00020300, {   68,    17}},
+	{0x20020D00, {  204,    17}},
+	{0, {0, 0}},
+	{0x00027100, {   41,    33}},
+	{0x00021F00, {  226,    21}},
+	{0x00027200, {   55,    33}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x00021B00, {  190,    21}},
+	{0x00022E00, {  217,    25}},
+	{0x20027300, {   68,    33}},
+	{0x00020800, {  147,    17}},
+	{0x00021100, {   41,    21}},
+	{0x00026500, {  118,    29}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x00027D00, {  204,    33}},
+	{0, {0, 0}},
+	{0x00026300, {   68,    29}},
+	{0x00026800, {  147,    29}},
+	{0x00028E00, {  217,    37}},
+	{0x0002BF00, {  280,    17}},
+	{0x00020100, {   41,    17}},
+	{0x00020A00, {  174,    17}},
+	{0x00022500, {  118,    25}},
+	{0, {0, 0}},
+	{0x00022000, {    1,    25}},
+	{0x20025100, {  309,    25}},
+	{0x00022800, {  147,    25}},
+	{0x00022100, {   41,    25}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x00028700, {  137,    37}},
+	{0x00021000, {    1,    21}},
+	{0x00021900, {  168,    21}},
+	{0, {0, 0}},
+	{0x00022200, {   55,    25}},
+	{0x00026F00, {  226,    29}},
+	{0x00021200, {   55,    21}},
+	{0x00028300, {   68,    37}},
+	{0x00024000, {  253,    21}},
+	{0x00021500, {  118,    21}},
+	{0x00020000, {    1,    17}},
+	{0x00028500, {  118,    37}},
+	{0, {0, 0}},
+	{0x00020700, {  137,    17}},
+	{0x00027800, {  147,    33}},
+	{0x00022A00, {  174,    25}},
+	{0, {0, 0}},
+	{0x00020E00, {  217,    17}},
+	{0x00026200, {   55,    29}},
+	{0x00027000, {    1,    33}},
+	{0x00020D00, {  204,    17}},
+	{0x00026D00, {  204,    29}},
+	{0x00021D00, {  204,    21}},
+	{0, {0, 0}},
+	{0x20021300, {   68,    21}},
+	{0x00021800, {  147,    21}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x00020200, {   55,    17}},
+	{0x00028A00, {  174,    37}},
+	{0x00028900, {  168,    37}},
+	{0x20022D00, {  204,    25}},
+	{0x00021300, {   68,    21}},
+	{0, {0, 0}},
+	{0x00027E00, {  217,    33}},
+	{0x00021A00, {  174,    21}},
+	{0x00028D00, {  204,    37}},
+	{0x00020B00, {  190,    17}},
+	{0x00020F00, {  226,    17}},
+	{0x00028800, {  147,    37}},
+	{0x00028400, {   98,    37}},
+	{0x00022300, {   68,    25}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x00027400, {   98,    33}},
+	{0, {0, 0}},
+	{0x00023000, {  253,    17}},
+	{0, {0, 0}},
+	{0x00022B00, {  190,    25}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x00028F00, {  226,    37}},
+	{0x00027A00, {  174,    33}},
+	{0x00022F00, {  226,    25}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x20023100, {  309,    17}},
+	{0x00021400, {   98,    21}},
+	{0x00020500, {  118,    17}},
+	{0x00026E00, {  217,    29}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x00028000, {    1,    37}},
+	{0x20022300, {   68,    25}},
+	{0x00027F00, {  226,    33}},
+	{0x00026000, {    1,    29}},
+	{0x00021E00, {  217,    21}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+};
+
+// sys_title_00040030: 96 entries, 128 slots.
+static const uint8_t Nintendo3DSSysTitles_sys_title_00040030_seeds[32] = {
+	    3,     4,     1,     7,     5,     9,     3,     4,
+	   23,     1,     7,     1,     6,     3,     1,     8,
+	    8,     2,     1,    14,     4,     9,     2,     2,
+	    1,     8,     2,    10,     4,     2,     4,    59,
+};
+static const struct Nintendo3DSSysTitles_sys_title_00040030_t {
+	uint32_t key;
+	uint16_t off[2];
+} Nintendo3DSSysTitles_sys_title_00040030[128] = {
+	{0x2000AE02, {  375,    33}},
+	{0x0000B002, {  404,    33}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x0000A202, {  338,    29}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x0000BC02, {  523,    17}},
+	{0x00009002, {  338,    21}},
+	{0x0000E902, {  510,    37}},
+	{0x0000A602, {  375,    29}},
+	{0, {0, 0}},
+	{0x0000D902, {  466,    29}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x0000BA02, {  532,    25}},
+	{0x0000B802, {  404,    37}},
+	{0, {0, 0}},
+	{0x0000C803, {  436,    21}},
+	{0x0000B502, {  364,    37}},
+	{0x00008602, {  345,    17}},
+	{0x0000AC02, {  345,    33}},
+	{0x0000C003, {  436,    17}},
+	{0x0000BE02, {  523,    25}},
+	{0x0000D802, {  418,    29}},
+	{0x0000C602, {  510,    17}},
+	{0x00009E02, {  556,    21}},
+	{0x0000B702, {  392,    37}},
+	{0, {0, 0}},
+	{0x2000C003, {  436,    17}},
+	{0x0000D402, {  492,    25}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x00008B02, {  532,    21}},
+	{0x00009202, {  345,    21}},
+	{0, {0, 0}},
+	{0x0000C802, {  418,    21}},
+	{0, {0, 0}},
+	{0x0000E102, {  477,    33}},
+	{0x0000D003, {  436,    25}},
+	{0x00008F02, {  328,    21}},
+	{0x00008202, {  328,    17}},
+	{0, {0, 0}},
+	{0x0000A402, {  345,    29}},
+	{0x0000A802, {  404,    29}},
+	{0x0000B102, {  328,    37}},
+	{0x0000DE03, {  436,    33}},
+	{0x0000D102, {  466,    25}},
+	{0x00009302, {  364,    21}},
+	{0x0000DC02, {  492,    29}},
+	{0x0000A102, {  328,    29}},
+	{0x0000B402, {  345,    37}},
+	{0x0000CC02, {  492,    21}},
+	{0x0000B202, {  338,    37}},
+	{0x00008D02, {  392,    17}},
+	{0x0000E302, {  510,    33}},
+	{0x0000DF02, {  466,    33}},
+	{0, {0, 0}},
+	{0x0000E402, {  418,    37}},
+	{0x2000DE03, {  436,    33}},
+	{0x0000CB02, {  477,    21}},
+	{0x0000C402, {  492,    17}},
+	{0, {0, 0}},
+	{0x0000BD02, {  523,    21}},
+	{0, {0, 0}},
+	{0x00009502, {  556,    17}},
+	{0x20009402, {  375,    21}},
+	{0, {0, 0}},
+	{0x0000E802, {  492,    37}},
+	{0x0000B602, {  375,    37}},
+	{0x2000D003, {  436,    25}},
+	{0x0000E502, {  466,    37}},
+	{0x0000D803, {  436,    29}},
+	{0, {0, 0}},
+	{0x00009D02, {  375,    25}},
+	{0x0000C902, {  466,    21}},
+	{0x0000D002, {  418,    25}},
+	{0x0000BF02, {  556,    37}},
+	{0x0000A002, {  404,    25}},
+	{0x00008802, {  375,    17}},
+	{0, {0, 0}},
+	{0x0000B902, {  556,    25}},
+	{0x00009C02, {  364,    25}},
+	{0x0000A502, {  364,    29}},
+	{0, {0, 0}},
+	{0x00009802, {  328,    25}},
+	{0x00008702, {  364,    17}},
+	{0x0000E202, {  492,    33}},
+	{0, {0, 0}},
+	{0x0000A702, {  392,    29}},
+	{0x0000C102, {  466,    17}},
+	{0, {0, 0}},
+	{0x0000CE02, {  510,    21}},
+	{0, {0, 0}},
+	{0x00008E02, {  404,    17}},
+	{0x0000AD02, {  364,    33}},
+	{0x0000AA02, {  338,    33}},
+	{0, {0, 0}},
+	{0x00009602, {  392,    21}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x00008C02, {  556,    33}},
+	{0x00009702, {  404,    21}},
+	{0x0000AE02, {  375,    33}},
+	{0x00008302, {  532,    17}},
+	{0x0000E403, {  436,    37}},
+	{0x20009D02, {  375,    25}},
+	{0, {0, 0}},
+	{0x2000C803, {  436,    21}},
+	{0x20008802, {  375,    17}},
+	{0x0000D302, {  477,    25}},
+	{0, {0, 0}},
+	{0x00009402, {  375,    21}},
+	{0x0000C002, {  418,    17}},
+	{0, {0, 0}},
+	{0x0000A902, {  328,    33}},
+	{0x0000DB02, {  477,    29}},
+	{0x0000D602, {  510,    25}},
+	{0x00009902, {  338,    25}},
+	{0, {0, 0}},
+	{0x00009F02, {  392,    25}},
+	{0x0000E702, {  477,    37}},
+	{0x0000DE02, {  418,    33}},
+	{0x00009B02, {  345,    25}},
+	{0x0000AF02, {  392,    33}},
+	{0x0000C302, {  477,    17}},
+	{0x00008402, {  338,    17}},
+};
+
+#if 0
+// Translatable strings for sys_title_00040010. (used by xgettext only)
+NOP_C_("Nintendo3DSSysTitles", "System Settings")
+NOP_C_("Nintendo3DSSysTitles", "Download Play")
+NOP_C_("Nintendo3DSSysTitles", "Activity Log")
+NOP_C_("Nintendo3DSSysTitles", "Health and Safety Information")
+NOP_C_("Nintendo3DSSysTitles", "Nintendo 3DS Camera")
+NOP_C_("Nintendo3DSSysTitles", "Nintendo 3DS Sound")
+NOP_C_("Nintendo3DSSysTitles", "Mii Maker")
+NOP_C_("Nintendo3DSSysTitles", "StreetPass Mii Plaza")
+NOP_C_("Nintendo3DSSysTitles", "eShop")
+NOP_C_("Nintendo3DSSysTitles", "System Transfer")
+NOP_C_("Nintendo3DSSysTitles", "Nintendo Zone")
+NOP_C_("Nintendo3DSSysTitles", "Face Raiders")
+NOP_C_("Nintendo3DSSysTitles", "AR Games")
+NOP_C_("Nintendo3DSSysTitles", "System Updater (SAFE_MODE)")
+NOP_C_("Nintendo3DSSysTitles", "Promotional Video (v1.1.0)")
+NOP_C_("Nintendo3DSSysTitles", "Nintendo Network ID Settings")
+NOP_C_("Nintendo3DSSysTitles", "microSD Management")
+#endif
+
+#if 0
+// Translatable strings for sys_title_00040030. (used by xgettext only)
+NOP_C_("Nintendo3DSSysTitles", "HOME Menu")
+NOP_C_("Nintendo3DSSysTitles", "Camera")
+NOP_C_("Nintendo3DSSysTitles", "Instruction Manual")
+NOP_C_("Nintendo3DSSysTitles", "Game Notes")
+NOP_C_("Nintendo3DSSysTitles", "Internet Browser")
+NOP_C_("Nintendo3DSSysTitles", "Friend List")
+NOP_C_("Nintendo3DSSysTitles", "Notifications")
+NOP_C_("Nintendo3DSSysTitles", "Software Keyboard")
+NOP_C_("Nintendo3DSSysTitles", "Software Keyboard (SAFE_MODE)")
+NOP_C_("Nintendo3DSSysTitles", "Mii picker")
+NOP_C_("Nintendo3DSSysTitles", "Picture picker")
+NOP_C_("Nintendo3DSSysTitles", "Voice memo picker")
+NOP_C_("Nintendo3DSSysTitles", "eShop applet")
+NOP_C_("Nintendo3DSSysTitles", "Miiverse")
+NOP_C_("Nintendo3DSSysTitles", "Miiverse posting applet")
+NOP_C_("Nintendo3DSSysTitles", "amiibo Settings")
+#endif
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DATA_NINTENDO3DSSYSTITLES_DATA_H__ */
@@ -0,0 +1,1060 @@
+/** NintendoPublishers_data.h: Generated from NintendoPublishers.tbl by gen_lookup_tables.py. **/
+/** DO NOT EDIT! Edit NintendoPublishers.tbl and regenerate this file instead. **/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DATA_NINTENDOPUBLISHERS_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_DATA_NINTENDOPUBLISHERS_DATA_H__
+
+#include <stdint.h>
+
+// String pool. (6160 bytes)
+// Offset 0 is the empty string, which indicates "no entry".
+static const char NintendoPublishers_strtbl[] =
+	"\0"
+	"<unlicensed>\0"
+	"Nintendo\0"
+	"Rocket Games / Ajinomoto\0"
+	"Imagineer-Zoom\0"
+	"Gray Matter\0"
+	"Zamuse\0"
+	"Falcom\0"
+	"Enix\0"
+	"Capcom\0"
+	"Hot B Co.\0"
+	"Jaleco\0"
+	"Coconuts Japan\0"
+	"Coconuts Japan / G.X.Media\0"
+	"Micronet\0"
+	"Technos\0"
+	"Mebio Software\0"
+	"Shouei System\0"
+	"Starfish\0"
+	"Mitsui Fudosan / Dentsu\0"
+	"Warashi Inc.\0"
+	"Nowpro\0"
+	"Game Village\0"
+	"IE Institute\0"
+	"Infocom\0"
+	"Electronic Arts Japan\0"
+	"Cobra Team\0"
+	"Human / Field\0"
+	"KOEI\0"
+	"Hudson Soft\0"
+	"S.C.P.\0"
+	"Yanoman\0"
+	"Tecmo Products\0"
+	"Japan Glary Business\0"
+	"Forum / OpenSystem\0"
+	"Virgin Games (Japan)\0"
+	"SMDE\0"
+	"Daikokudenki\0"
+	"Creatures Inc.\0"
+	"TDK Deep Impresion\0"
+	"Zoo\0"
+	"Sunsoft / Tokai Engineering\0"
+	"POW (Planning Office Wada) / VR1 Japan\0"
+	"Micro World\0"
+	"San-X\0"
+	"Loriciel / Electro Brain\0"
+	"Kemco Japan\0"
+	"Seta\0"
+	"Culture Brain\0"
+	"Palsoft\0"
+	"Visit Co.,Ltd.\0"
+	"Intec\0"
+	"System Sacom\0"
+	"Poppo\0"
+	"Ubisoft Japan\0"
+	"Media Works\0"
+	"NEC InterChannel\0"
+	"Tam\0"
+	"Jordan\0"
+	"Smilesoft / Rocket\0"
+	"Mediakite\0"
+	"Viacom\0"
+	"Carrozzeria\0"
+	"Dynamic\0"
+	"Magifact\0"
+	"Hect\0"
+	"Codemasters\0"
+	"Taito / GAGA Communications\0"
+	"Laguna\0"
+	"Telstar / Event / Taito\0"
+	"Soedesco\0"
+	"Arcade Zone Ltd\0"
+	"Entertainment International / Empire Software\0"
+	"Loriciel\0"
+	"Gremlin Graphics\0"
+	"K.Amusement Leasing Co.\0"
+	"Seika Corp.\0"
+	"Ubi Soft Entertainment\0"
+	"Sunsoft US\0"
+	"Life Fitness\0"
+	"System 3\0"
+	"Spectrum Holobyte\0"
+	"Irem\0"
+	"Gakken\0"
+	"Raya Systems\0"
+	"Renovation Products\0"
+	"Malibu Games\0"
+	"Eidos\0"
+	"Playmates Interactive\0"
+	"Fox Interactive\0"
+	"Time Warner Interactive\0"
+	"Disney Interactive\0"
+	"Black Pearl\0"
+	"Advanced Productions\0"
+	"GT Interactive\0"
+	"RARE\0"
+	"Crave Entertainment\0"
+	"Absolute Entertainment\0"
+	"Acclaim\0"
+	"Activision\0"
+	"American Sammy\0"
+	"Take 2 Interactive / GameTek\0"
+	"Hi Tech\0"
+	"LJN LTD.\0"
+	"Mattel\0"
+	"Mindscape / Red Orb Entertainment\0"
+	"Romstar\0"
+	"Taxan\0"
+	"Midway / Tradewest\0"
+	"American Softworks\0"
+	"Majesco Sales Inc\0"
+	"3DO\0"
+	"Hasbro\0"
+	"NewKidCo\0"
+	"Telegames\0"
+	"Metro3D\0"
+	"Vatical Entertainment\0"
+	"LEGO Media\0"
+	"Xicat Interactive\0"
+	"Cryo Interactive\0"
+	"Red Storm Entertainment\0"
+	"Microids\0"
+	"Data Design / Conspiracy / Swing\0"
+	"Titus\0"
+	"Virgin Interactive\0"
+	"Maxis\0"
+	"LucasArts Entertainment\0"
+	"Ocean\0"
+	"Bethesda Softworks\0"
+	"Electronic Arts\0"
+	"Laser Beam\0"
+	"Elite Systems\0"
+	"Electro Brain\0"
+	"The Learning Company\0"
+	"BBC\0"
+	"Software 2000\0"
+	"UFO Interactive Games\0"
+	"BAM! Entertainment\0"
+	"Studio 3\0"
+	"Classified Games\0"
+	"TDK Mediactive\0"
+	"DreamCatcher\0"
+	"JoWood Produtions\0"
+	"Sega\0"
+	"Wannado Edition\0"
+	"LSP (Light & Shadow Prod.)\0"
+	"ITE Media\0"
+	"Atari (Infogrames)\0"
+	"Interplay\0"
+	"JVC (US)\0"
+	"Parker Brothers\0"
+	"Sales Curve (Storm / SCI)\0"
+	"THQ\0"
+	"Accolade\0"
+	"Triffix Entertainment\0"
+	"Microprose Software\0"
+	"Sierra / Universal Interactive\0"
+	"Kemco\0"
+	"Rage Software\0"
+	"Encore\0"
+	"Kiddinx\0"
+	"Simon & Schuster Interactive\0"
+	"Asmik Ace Entertainment Inc.\0"
+	"Empire Interactive\0"
+	"Jester Interactive\0"
+	"Rockstar Games\0"
+	"Scholastic\0"
+	"Ignition Entertainment\0"
+	"Summitsoft\0"
+	"Stadlbauer\0"
+	"Misawa\0"
+	"Teichiku\0"
+	"Namco Ltd.\0"
+	"LOZC\0"
+	"Tokuma Shoten Intermedia\0"
+	"Tsukuda Original\0"
+	"DATAM-Polystar\0"
+	"BulletProof Software (BPS)\0"
+	"Vic Tokai Inc.\0"
+	"Character Soft\0"
+	"I'Max\0"
+	"Saurus\0"
+	"General Entertainment\0"
+	"Cyberfront Korea\0"
+	"Success\0"
+	"Sega Japan\0"
+	"Takara Amusement\0"
+	"Chun Soft\0"
+	"Video System /  Mc O' River\0"
+	"BEC\0"
+	"Varie\0"
+	"Yonezawa / S'pal\0"
+	"Kaneko\0"
+	"Marvelous Entertainment\0"
+	"Nichibutsu / Nihon Bussan\0"
+	"Tecmo\0"
+	"Imagineer\0"
+	"Nova\0"
+	"Take2 / Den'Z / Global Star\0"
+	"Bottom Up\0"
+	"TGL (Technical Group Laboratory)\0"
+	"Hasbro Japan\0"
+	"Keynet Inc.\0"
+	"Hands-On Entertainment\0"
+	"Telenet\0"
+	"Hori\0"
+	"Scorpion Soft\0"
+	"Konami\0"
+	"Kawada Co., Ltd.\0"
+	"Takara\0"
+	"Royal Industries\0"
+	"Technos Japan Corp.\0"
+	"JVC / Victor\0"
+	"Toei Animation\0"
+	"Toho\0"
+	"Namco\0"
+	"Media Rings Corporation\0"
+	"J-Wing\0"
+	"Pioneer LDC\0"
+	"KID\0"
+	"Mediafactory\0"
+	"Infogrames / Hudson\0"
+	"Kiratto. Ludic Inc\0"
+	"Yacht Club Games\0"
+	"Acclaim Japan\0"
+	"ASCII Corporation\0"
+	"Bandai\0"
+	"Soft Pro Inc.\0"
+	"HAL Laboratory\0"
+	"SNK\0"
+	"Pony Canyon\0"
+	"Sunsoft\0"
+	"Toshiba EMI\0"
+	"Sony Imagesoft\0"
+	"Sammy\0"
+	"Magical\0"
+	"Visco\0"
+	"Compile\0"
+	"MTO Inc.\0"
+	"Sunrise Interactive\0"
+	"Global A Entertainment\0"
+	"Fuuki\0"
+	"Taito\0"
+	"Sunsoft / Ask Co., Ltd.\0"
+	"Square\0"
+	"Tokuma Shoten\0"
+	"Data East\0"
+	"Tonkin House / Tokyo Shoseki\0"
+	"East Cube\0"
+	"Koei\0"
+	"Konami / Ultra / Palcom\0"
+	"NTVIC / VAP\0"
+	"Use Co., Ltd.\0"
+	"Meldac\0"
+	"Pony Canyon / FCI\0"
+	"Angel / Sotsu Agency / Sunrise\0"
+	"Yumedia / Aroma Co., Ltd\0"
+	"Boss\0"
+	"Axela / Crea-Tech\0"
+	"Sekaibunka-Sha / Sumire Kobo / Marigul Management Inc.\0"
+	"Konami Computer Entertainment Osaka\0"
+	"NEC Interchannel\0"
+	"Enterbrain\0"
+	"From Software\0"
+	"Taito / Disco\0"
+	"Sofel\0"
+	"Quest / Bothtec\0"
+	"Sigma\0"
+	"Ask Kodansha\0"
+	"Naxat\0"
+	"Copya System\0"
+	"Capcom Co., Ltd.\0"
+	"Banpresto\0"
+	"Tomy\0"
+	"LJN Japan\0"
+	"NCS\0"
+	"Human Entertainment\0"
+	"Altron\0"
+	"Gaps Inc.\0"
+	"Elf\0"
+	"Compile Heart\0"
+	"FarSight Studios\0"
+	"Yutaka\0"
+	"T&ESoft\0"
+	"Epoch\0"
+	"Athena\0"
+	"Asmik\0"
+	"Natsume\0"
+	"King Records\0"
+	"Atlus\0"
+	"Epic / Sony Records\0"
+	"IGS (Information Global Service)\0"
+	"Chatnoir\0"
+	"Right Stuff\0"
+	"Spike\0"
+	"Konami Computer Entertainment Tokyo\0"
+	"Alphadream Corporation\0"
+	"Sting\0"
+	"Star-Fish\0"
+	"A Wave\0"
+	"Motown Software\0"
+	"Left Field Entertainment\0"
+	"Extreme Ent. Grp.\0"
+	"TecMagik\0"
+	"Cybersoft\0"
+	"Psygnosis\0"
+	"Davidson / Western Tech.\0"
+	"The Game Factory\0"
+	"Hip Games\0"
+	"Aspyr\0"
+	"Mastiff\0"
+	"iQue\0"
+	"Digital Tainment Pool\0"
+	"XS Games / Jack Of All Games\0"
+	"Daewon Media\0"
+	"Alpha Unit\0"
+	"PCCW Japan\0"
+	"Yuke's Media Creations\0"
+	"KiKi Co Ltd\0"
+	"Open Sesame Inc\0"
+	"Sims\0"
+	"Broccoli\0"
+	"Avex\0"
+	"D3 Publisher\0"
+	"Konami Computer Entertainment Japan\0"
+	"Square-Enix\0"
+	"KSG\0"
+	"Micott & Basara Inc.\0"
+	"O3 Entertainment\0"
+	"Orbital Media\0"
+	"Detn8 Games\0"
+	"Gameloft / Ubi Soft\0"
+	"Gamecock Media Group\0"
+	"Oxygen Games\0"
+	"505 Games\0"
+	"Treasure\0"
+	"Aruze\0"
+	"Ertain\0"
+	"SNK Playmore\0"
+	"Level-5\0"
+	"Genius Products\0"
+	"Reef Entertainment\0"
+	"Nordcurrent\0"
+	"Yojigen\0"
+	"AQ Interactive\0"
+	"Arc System Works\0"
+	"Deep Silver\0"
+	"Atari\0"
+	"Nihon System\0"
+	"NIS America\0"
+	"Purple Hills\0"
+	"Trend Verlag / East Entertainment\0"
+	"Legacy Interactive\0"
+	"SilverStar Games\0"
+	"Mumbo Jumbo\0"
+	"Mindscape\0"
+	"Milestone / UFO Interactive\0"
+	"Blast !\0"
+	"Terabox\0"
+	"Nordic Games\0"
+	"Neko Entertainment / Diffusion / Naps team\0"
+	"Nobilis\0"
+	"Namco Bandai\0"
+	"Data Design / Destineer Studios\0"
+	"Phoenix Games\0"
+	"Playlogic\0"
+	"Rondomedia\0"
+	"Warner Bros. Interactive Entertainment Inc.\0"
+	"RTL Games\0"
+	"RealNetworks\0"
+	"Southpeak Interactive\0"
+	"Blade Interactive Studios\0"
+	"SevenGames\0"
+	"Storm City\0"
+	"Tasuke / Works\0"
+	"Tivola\0"
+	"Metro 3D / Data Design\0"
+	"Valcon Games\0"
+	"Virgin Play\0"
+	"Little Orbit\0"
+	"Xseed Games\0"
+	"Aksys Games\0"
+	"Fun Box Media\0"
+	"O2 Games\0"
+	"Bergsala Lightweight\0"
+	"Barunson Creative\0"
+	"Ntreev Soft\0"
+	"WBA Interactive\0"
+	"Internal Engine\0"
+	"Zinkia\0"
+	"Judo Baby\0"
+	"Topware Interactive\0"
+	"<非公認>\0"
+	"任天堂\0"
+	"カプコン\0"
+	"ジャレコ\0"
+	"ハドソン\0"
+	"アイレム\0"
+	"学習研究社\0"
+	"BPS\0"
+	"Pack-In-Video\0"
+	"パックインビデオ\0"
+	"テクモ\0"
+	"イマジニア\0"
+	"スコーピオンソフト\0"
+	"コナミ\0"
+	"河田\0"
+	"タカラ\0"
+	"ロイヤル工業\0"
+	"東映動画\0"
+	"ナムコ\0"
+	"アスキー\0"
+	"バンダイ\0"
+	"ソフトプロ\0"
+	"HAL研究所\0"
+	"サンソフト\0"
+	"東芝EMI\0"
+	"タイトー\0"
+	"サンソフト アスク講談社\0"
+	"ケムコ\0"
+	"スクウェア\0"
+	"徳間書店\0"
+	"データイースト\0"
+	"トンキンハウス\0"
+	"イーストキューブ\0"
+	"バップ\0"
+	"ユース\0"
+	"ポニーキャニオン\0"
+	"ソフエル\0"
+	"Bothtec, Inc.\0"
+	"ボーステック\0"
+	"Hiro Co., Ltd.\0"
+	"ヒロ\0"
+	"アテナ\0"
+	"アトラス\0";
+
+// thirdParty: 407 entries, 512 slots.
+static const uint8_t NintendoPublishers_thirdParty_seeds[128] = {
+	    2,     2,     3,    23,     6,    10,     3,    12,
+	    1,     3,     1,     1,    33,     1,     8,     4,
+	    9,     2,     1,     4,     9,     5,    16,     6,
+	    1,     2,    12,     4,     3,     8,     3,     2,
+	   16,     1,    14,     0,     1,    17,    24,     2,
+	    4,     7,     6,     2,     1,     1,     2,     4,
+	    1,     7,    64,     6,    13,     1,     1,    23,
+	    1,    13,    13,     3,     1,     1,    10,     1,
+	    1,     6,     7,    11,     3,     5,     3,    18,
+	   21,     8,     2,     7,    16,     4,     2,     0,
+	   14,     7,     1,     9,     1,     0,     9,     3,
+	    1,     1,    14,     5,     1,     3,     5,     1,
+	    2,    10,     2,     2,     1,    14,     1,    22,
+	    2,     0,    20,     2,    15,     3,    12,     4,
+	   18,    26,     1,     3,     1,    16,     8,    10,
+	    5,     3,     8,     2,     6,     1,    12,     9,
+};
+static const struct NintendoPublishers_thirdParty_t {
+	uint16_t key;
+	uint16_t off[1];
+} NintendoPublishers_thirdParty[512] = {
+	{0x3836, { 2444}},
+	{0x5547, { 5303}},
+	{0x5A34, { 5450}},
+	{0x4333, { 3393}},
+	{0x4548, { 4070}},
+	{0, {0}},
+	{0, {0}},
+	{0x3743, { 2159}},
+	{0, {0}},
+	{0x584A, { 5364}},
+	{0x464D, { 4310}},
+	{0x4150, { 3102}},
+	{0x3631, { 1705}},
+	{0x3050, {  259}},
+	{0x3336, {  817}},
+	{0x345A, { 1293}},
+	{0x474A, { 4602}},
+	{0x474D, { 4634}},
+	{0x544B, { 5281}},
+	{0x3334, {  803}},
+	{0x3735, { 2098}},
+	{0x4251, { 3357}},
+	{0x4745, { 4546}},
+	{0x5650, { 5339}},
+	{0, {0}},
+	{0x5257, { 5198}},
+	{0, {0}},
+	{0x3431, { 1021}},
+	{0x424C, { 3305}},
+	{0x3033, {   48}},
+	{0x4537, { 3968}},
+	{0x4739, { 4485}},
+	{0x4D53, { 4956}},
+	{0, {0}},
+	{0x3632, { 1724}},
+	{0x4532, { 3947}},
+	{0x3030, {    1}},
+	{0x3247, {  687}},
+	{0x3443, { 1120}},
+	{0x4948, { 4768}},
+	{0x3046, {  177}},
+	{0, {0}},
+	{0x3731, { 2063}},
+	{0x4759, { 4283}},
+	{0x3248, {  693}},
+	{0x3732, { 2073}},
+	{0x454E, { 4124}},
+	{0x3042, {  118}},
+	{0x3150, {  466}},
+	{0x4237, { 3226}},
+	{0x3442, { 1107}},
+	{0x4E51, { 5064}},
+	{0x3755, { 2367}},
+	{0x3843, { 2528}},
+	{0x434B, { 3604}},
+	{0, {0}},
+	{0x3430, { 1009}},
+	{0, {0}},
+	{0x4735, { 4450}},
+	{0x4E47, { 5000}},
+	{0x3137, {  340}},
+	{0x3459, { 1288}},
+	{0x4343, { 3504}},
+	{0x4654, { 4380}},
+	{0x364B, { 1873}},
+	{0x3048, {  206}},
+	{0x3951, { 2885}},
+	{0x3141, {  364}},
+	{0x4A4A, { 4808}},
+	{0x3335, {  812}},
+	{0, {0}},
+	{0x5335, { 5211}},
+	{0, {0}},
+	{0x354B, { 1531}},
+	{0x384E, { 2610}},
+	{0, {0}},
+	{0x3339, {  864}},
+	{0x4543, { 4008}},
+	{0x3143, {  372}},
+	{0, {0}},
+	{0x3031, {   14}},
+	{0x4650, { 4316}},
+	{0x4134, { 2935}},
+	{0x3838, { 2486}},
+	{0, {0}},
+	{0x3037, {   89}},
+	{0x324D, {  740}},
+	{0, {0}},
+	{0x3239, {  626}},
+	{0x4547, { 4061}},
+	{0x384A, { 2571}},
+	{0x3548, { 1527}},
+	{0x424E, { 3314}},
+	{0x3034, {   63}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x3532, { 1344}},
+	{0x4331, { 3369}},
+	{0, {0}},
+	{0x3656, { 1968}},
+	{0x4652, { 4329}},
+	{0x4132, { 2921}},
+	{0x3331, {  783}},
+	{0x4236, { 3211}},
+	{0x3243, {  645}},
+	{0x3344, {  959}},
+	{0x3345, {  968}},
+	{0x3558, { 1657}},
+	{0x3542, { 1457}},
+	{0x3553, { 1598}},
+	{0x3948, { 2817}},
+	{0, {0}},
+	{0x4B36, { 4826}},
+	{0x4833, { 4693}},
+	{0, {0}},
+	{0x4234, {   89}},
+	{0x3453, { 1240}},
+	{0x3748, { 2230}},
+	{0x3946, { 2784}},
+	{0x3757, { 2401}},
+	{0x535A, { 5270}},
+	{0, {0}},
+	{0x4430, { 3755}},
+	{0, {0}},
+	{0x3535, { 1399}},
+	{0x4754, { 4668}},
+	{0x3432, { 1044}},
+	{0x3139, {  357}},
+	{0x3241, {  631}},
+	{0x4D52, { 4946}},
+	{0, {0}},
+	{0x4131, { 2916}},
+	{0x324A, {  707}},
+	{0x4232, { 3190}},
+	{0x3830, { 2412}},
+	{0x374E, { 2303}},
+	{0x4446, { 3895}},
+	{0x4247, { 3283}},
+	{0x4434, { 3797}},
+	{0, {0}},
+	{0x434A, { 3599}},
+	{0x374B, { 2237}},
+	{0x4442, { 3861}},
+	{0x374C, { 2245}},
+	{0x3146, {  427}},
+	{0x4634, { 4229}},
+	{0, {0}},
+	{0, {0}},
+	{0x5954, { 5326}},
+	{0, {0}},
+	{0, {0}},
+	{0x5456, { 5296}},
+	{0x3933, { 2684}},
+	{0x5254, { 5188}},
+	{0, {0}},
+	{0x424A, { 3297}},
+	{0x3458, { 1273}},
+	{0x3659, { 2007}},
+	{0x4250, { 3334}},
+	{0x4831, { 4678}},
+	{0, {0}},
+	{0x4D54, { 4984}},
+	{0x3947, { 2789}},
+	{0x3639, { 1779}},
+	{0, {0}},
+	{0x354E, { 1557}},
+	{0x3132, {  285}},
+	{0, {0}},
+	{0x374A, {  500}},
+	{0, {0}},
+	{0, {0}},
+	{0x5350, { 5233}},
+	{0x304A, {  215}},
+	{0, {0}},
+	{0x324C, {  736}},
+	{0x3051, {  272}},
+	{0x4738, { 4480}},
+	{0x4439, { 3846}},
+	{0x564E, { 5326}},
+	{0x3135, {  315}},
+	{0x4732, { 4415}},
+	{0, {0}},
+	{0x3941, { 2742}},
+	{0x3444, { 1140}},
+	{0, {0}},
+	{0, {0}},
+	{0x4632, { 4186}},
+	{0x3744, { 2179}},
+	{0x3551, { 1587}},
+	{0x4530, {  111}},
+	{0x4437, { 3816}},
+	{0x434E, { 3713}},
+	{0x4747, { 4571}},
+	{0x4244, { 3262}},
+	{0x394C, { 2860}},
+	{0, {0}},
+	{0x4151, { 3122}},
+	{0, {0}},
+	{0x3837, { 2469}},
+	{0x365A, { 2034}},
+	{0x3647, { 1834}},
+	{0, {0}},
+	{0x444E, { 3912}},
+	{0x4633, { 4211}},
+	{0x4645, { 4258}},
+	{0x354C, { 1538}},
+	{0x4E53, { 4839}},
+	{0, {0}},
+	{0, {0}},
+	{0x3557, { 1633}},
+	{0, {0}},
+	{0x4146, { 3036}},
+	{0x434C, { 3622}},
+	{0x4746, { 4550}},
+	{0x4542, { 4002}},
+	{0, {0}},
+	{0x4330, { 3363}},
+	{0x3451, { 1221}},
+	{0x4246, { 3277}},
+	{0x474C, { 4614}},
+	{0x4335, { 3414}},
+	{0x3047, {  192}},
+	{0x3151, {  481}},
+	{0x4231, { 3172}},
+	{0x3655, { 1955}},
+	{0x3930, { 2629}},
+	{0x3746, { 2210}},
+	{0, {0}},
+	{0x4138, { 2966}},
+	{0x3236, {   89}},
+	{0x565A, { 5351}},
+	{0x5A58, { 5511}},
+	{0x3036, {   82}},
+	{0x394E, { 2718}},
+	{0x4438, { 3829}},
+	{0x3233, {  571}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x4734, { 4438}},
+	{0x4433, { 3791}},
+	{0, {0}},
+	{0x3634, { 1730}},
+	{0, {0}},
+	{0x3648, { 1855}},
+	{0x3943, { 2774}},
+	{0x4345, { 3525}},
+	{0x4137, { 2959}},
+	{0x3845, { 2543}},
+	{0x364D, { 1914}},
+	{0x3235, {  583}},
+	{0x4139, { 2983}},
+	{0x3645, { 1806}},
+	{0x414A, { 3073}},
+	{0, {0}},
+	{0x3238, {  614}},
+	{0, {0}},
+	{0x3630, { 1699}},
+	{0x4E50, { 5056}},
+	{0x4159, { 3141}},
+	{0x3039, {  101}},
+	{0x414B, { 3085}},
+	{0x3145, {  408}},
+	{0, {0}},
+	{0x3850, { 2618}},
+	{0x3045, {  169}},
+	{0x4338, { 3463}},
+	{0x3543, { 1465}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x3541, { 1423}},
+	{0x5853, { 5376}},
+	{0x4535, { 3962}},
+	{0x3550, { 1565}},
+	{0x3530, { 1313}},
+	{0x3231, {  504}},
+	{0x3147, {  448}},
+	{0, {0}},
+	{0x4351, { 3741}},
+	{0, {0}},
+	{0x3842, { 2501}},
+	{0x464B, { 4283}},
+	{0x3546, { 1490}},
+	{0, {0}},
+	{0x4748, { 4588}},
+	{0x3446, { 1153}},
+	{0x4332, { 2210}},
+	{0x4436, { 3810}},
+	{0x3753, { 2341}},
+	{0x4B42, { 4839}},
+	{0x3936, { 2694}},
+	{0x4342, { 3492}},
+	{0, {0}},
+	{0x3544, { 1471}},
+	{0, {0}},
+	{0x4846, { 4713}},
+	{0, {0}},
+	{0x3434, { 1055}},
+	{0x4147, { 3042}},
+	{0x344A, { 1181}},
+	{0x5A57, { 5501}},
+	{0x4550, { 4147}},
+	{0x3931, { 2646}},
+	{0x4737, { 4471}},
+	{0, {0}},
+	{0x3637, { 1754}},
+	{0, {0}},
+	{0, {0}},
+	{0x3232, {  532}},
+	{0x3346, {  985}},
+	{0, {0}},
+	{0x4639, { 4238}},
+	{0x4642, { 4248}},
+	{0, {0}},
+	{0x3437, { 1077}},
+	{0x304C, {  239}},
+	{0x324E, {  747}},
+	{0x4451, { 3916}},
+	{0x4B50, { 4851}},
+	{0x4832, { 4687}},
+	{0, {0}},
+	{0x364C, { 1895}},
+	{0x3330, {  776}},
+	{0x4334, { 3400}},
+	{0x3436, { 1068}},
+	{0x4630, { 4163}},
+	{0x3657, { 1986}},
+	{0x3447, { 1159}},
+	{0x3133, {  293}},
+	{0x3937, { 2711}},
+	{0x3246, {  674}},
+	{0x4C54, { 4898}},
+	{0x5A31, { 5432}},
+	{0x4B4D, { 4808}},
+	{0x3251, {  766}},
+	{0x3136, {  326}},
+	{0x3653, { 1940}},
+	{0, {0}},
+	{0x3846, { 2558}},
+	{0x3341, {  888}},
+	{0x4742, { 4498}},
+	{0x3032, {   23}},
+	{0, {0}},
+	{0x4730, { 4393}},
+	{0x4859, { 4737}},
+	{0x4631, { 4170}},
+	{0x594D, { 5411}},
+	{0x3754, { 2356}},
+	{0x4731, { 4404}},
+	{0x4241, {  631}},
+	{0x3739, { 2128}},
+	{0x4136, { 2942}},
+	{0x4141, { 3003}},
+	{0, {0}},
+	{0x4545, { 4028}},
+	{0x4431, { 3769}},
+	{0x3533, { 1355}},
+	{0, {0}},
+	{0x4D45, { 4917}},
+	{0x324B, {  719}},
+	{0x4456, { 3930}},
+	{0x3741, { 2137}},
+	{0x3538, { 1416}},
+	{0x454C, { 4082}},
+	{0x4243, { 3250}},
+	{0x5A53, { 5494}},
+	{0x3658, { 1991}},
+	{0x3439, { 1095}},
+	{0x3038, {   94}},
+	{0x4E4B, { 5013}},
+	{0, {0}},
+	{0, {0}},
+	{0x3332, {  795}},
+	{0x4448, { 3902}},
+	{0x3043, {  133}},
+	{0x524D, { 5133}},
+	{0x3035, {   75}},
+	{0x4A39, { 4776}},
+	{0x4347, { 3574}},
+	{0x4346, { 3543}},
+	{0x4E39, { 4992}},
+	{0, {0}},
+	{0x3756, { 2390}},
+	{0x3834, {  340}},
+	{0, {0}},
+	{0x484A, { 4721}},
+	{0x3237, {  589}},
+	{0x3942, { 2768}},
+	{0x5752, { 5144}},
+	{0x3738, { 2124}},
+	{0x4444, { 3871}},
+	{0x3638, { 1760}},
+	{0x3343, {  913}},
+	{0, {0}},
+	{0x4538, { 3975}},
+	{0x3531, { 1336}},
+	{0x5356, { 5259}},
+	{0, {0}},
+	{0x3041, {  111}},
+	{0x434D, { 3677}},
+	{0x314A, {  453}},
+	{0x3144, {  387}},
+	{0x3245, {  668}},
+	{0x3337, {  829}},
+	{0x3651, { 1923}},
+	{0x3547, { 1509}},
+	{0x4441, { 3856}},
+	{0x4A46, { 4791}},
+	{0x3642, { 1795}},
+	{0x364A, { 1859}},
+	{0x3935, { 2688}},
+	{0x344B, { 1197}},
+	{0x3441, { 1100}},
+	{0x4248, { 3291}},
+	{0x4336, { 3424}},
+	{0x4341, { 3468}},
+	{0x4736, { 4466}},
+	{0x3044, {  160}},
+	{0x3751, { 2322}},
+	{0x3939, { 2718}},
+	{0, {0}},
+	{0, {0}},
+	{0x4233, { 3197}},
+	{0, {0}},
+	{0x4337, { 3453}},
+	{0x354D, { 1547}},
+	{0x4553, { 4153}},
+	{0x5854, { 5388}},
+	{0, {0}},
+	{0x4539, { 3981}},
+	{0x3646, { 1820}},
+	{0x5047, { 5109}},
+	{0x3554, { 1616}},
+	{0, {0}},
+	{0x4C48, { 4864}},
+	{0x3832, { 2428}},
+	{0x3831, { 2419}},
+	{0x4D4A, { 4934}},
+	{0, {0}},
+	{0, {0}},
+	{0x5A48, { 5478}},
+	{0x4A57, { 4820}},
+	{0x3733, { 2082}},
+	{0x454D, { 4088}},
+	{0x3847, { 2564}},
+	{0x304E, {  252}},
+	{0x355A, { 1666}},
+	{0, {0}},
+	{0, {0}},
+	{0x4143, { 3016}},
+	{0x4653, { 4351}},
+	{0x3534, { 1370}},
+	{0, {0}},
+	{0x4432, { 3775}},
+	{0, {0}},
+	{0, {0}},
+	{0x3338, {  857}},
+	{0x3244, {  653}},
+	{0, {0}},
+	{0x4651, { 4324}},
+	{0, {0}},
+	{0x4230, { 3158}},
+	{0x384D, { 2593}},
+	{0x4148, { 3066}},
+	{0x4541, { 3989}},
+	{0x4445, { 3875}},
+	{0x4130, { 2908}},
+	{0x4744, { 4534}},
+	{0x3747, { 2216}},
+	{0x3455, { 1252}},
+	{0x4350, { 3730}},
+	{0x4E52, { 5077}},
+	{0x5A41, { 5462}},
+	{0x374D, { 2274}},
+	{0, {0}},
+	{0x3833, { 2439}},
+	{0x414C, { 3089}},
+	{0x3138, {  345}},
+	{0, {0}},
+	{0x4344, { 3518}},
+	{0x4242, { 3242}},
+	{0, {0}},
+	{0x3536, { 1407}},
+	{0, {0}},
+	{0x4144, { 3031}},
+	{0x504C, { 5123}},
+	{0x4533, { 2688}},
+	{0x4239, { 3230}},
+	{0x474E, { 4655}},
+	{0, {0}},
+	{0, {0}},
+	{0x4834, { 4700}},
+	{0, {0}},
+	{0x4447, {  111}},
+	{0x3230, {  500}},
+	{0x4534, { 3954}},
+	{0x394A, { 2827}},
+	{0x464C, { 4300}},
+	{0x3932, { 2656}},
+	{0, {0}},
+	{0, {0}},
+	{0x5946, { 5402}},
+	{0, {0}},
+	{0x3342, {  897}},
+	{0x3950, { 2873}},
+	{0, {0}},
+	{0x4135, {  985}},
+	{0x3730, { 2044}},
+	{0x485A, { 4756}},
+	{0x5253, { 5144}},
+};
+
+// fds: 41 entries, 64 slots.
+static const uint8_t NintendoPublishers_fds_seeds[16] = {
+	    4,     2,     2,    11,     2,     1,     2,     2,
+	    0,     4,     5,     2,     1,     2,     3,     2,
+};
+static const struct NintendoPublishers_fds_t {
+	uint8_t key;
+	uint16_t off[2];
+} NintendoPublishers_fds[64] = {
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0xC0, { 3363,  5868}},
+	{0, {0, 0}},
+	{0xC5, { 3414,  5955}},
+	{0xC1, { 3369,  5881}},
+	{0x99, { 5625,  5639}},
+	{0, {0, 0}},
+	{0xCA, { 3468,  5718}},
+	{0x0A, {  111,  5566}},
+	{0xEB, { 4002,  6147}},
+	{0xAC, { 3016,  5764}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x01, {   14,  5543}},
+	{0xB3, { 3197,  5813}},
+	{0xC7, { 3453,  5999}},
+	{0xBC, { 3250,  5858}},
+	{0xB2, { 3190,  5800}},
+	{0, {0, 0}},
+	{0x49, { 1095,  5592}},
+	{0xCC, { 3504,  6034}},
+	{0, {0, 0}},
+	{0xB1, { 3172,  5787}},
+	{0x8B, { 2501,  5621}},
+	{0, {0, 0}},
+	{0xA7, { 2959,  5735}},
+	{0, {0, 0}},
+	{0xC4, { 3400,  5942}},
+	{0x08, {   94,  5553}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0x18, {  345,  5579}},
+	{0, {0, 0}},
+	{0xAF, { 3036,  5777}},
+	{0xA8, { 2966,  5745}},
+	{0xE7, { 3968,  6137}},
+	{0xA6, { 2942,  5728}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0xDB, { 6115,  6130}},
+	{0, {0, 0}},
+	{0xC2, { 2210,  5916}},
+	{0xA2, { 2921,  5690}},
+	{0, {0, 0}},
+	{0, {0, 0}},
+	{0xCB, { 3492,  6024}},
+	{0xCE, { 3525,  6044}},
+	{0, {0, 0}},
+	{0xC3, { 3393,  5926}},
+	{0xC6, { 3424,  5977}},
+	{0x4A, { 1100,  5605}},
+	{0x9B, { 2768,  5664}},
+	{0x9C, { 2774,  5674}},
+	{0xD2, { 6082,  6096}},
+	{0xA4, { 2935,  5718}},
+	{0xBB, { 3242,  5842}},
+	{0xB6, { 3211,  5829}},
+	{0xD1, { 3769,  6069}},
+	{0x00, {    1,  5531}},
+};
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DATA_NINTENDOPUBLISHERS_DATA_H__ */
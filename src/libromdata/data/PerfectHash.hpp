@@ -0,0 +1,81 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * PerfectHash.hpp: Lookup functions for generated lookup tables.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DATA_PERFECTHASH_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_DATA_PERFECTHASH_HPP__
+
+// C includes.
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The *_data.h headers are generated from *.tbl files by
+ * gen_lookup_tables.py. Each header has a single string pool,
+ * and the tables store offsets into the pool instead of pointers.
+ * Offset 0 is the empty string and indicates "no entry".
+ *
+ * Hash tables use two levels: the key's first-level hash selects
+ * a seed, and the key is rehashed with that seed to get the slot.
+ * The generator picks seeds such that there are no collisions,
+ * so a lookup is always two hashes and one key comparison.
+ */
+
+namespace LibRomData { namespace PerfectHash {
+
+/**
+ * Hash a key.
+ * NOTE: This MUST match phash() in gen_lookup_tables.py.
+ * @param key Key.
+ * @param seed Seed. (0 for the first level)
+ * @return Hash.
+ */
+static inline uint32_t hash(uint32_t key, uint32_t seed)
+{
+	uint32_t h = key ^ (seed * 0x9E3779B9U);
+	h ^= h >> 16;
+	h *= 0x85EBCA6BU;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35U;
+	h ^= h >> 16;
+	return h;
+}
+
+/**
+ * Find an entry in a generated hash table.
+ * @param seeds Seed table.
+ * @param entries Entry table.
+ * @param key Key.
+ * @return Entry, or nullptr if not found.
+ */
+template<typename Seed, size_t SeedCount, typename Entry, size_t EntryCount>
+static inline const Entry *find(const Seed (&seeds)[SeedCount], const Entry (&entries)[EntryCount], uint32_t key)
+{
+	static_assert(SeedCount > 0 && (SeedCount & (SeedCount - 1)) == 0,
+		"SeedCount must be a power of two.");
+	static_assert(EntryCount > 0 && (EntryCount & (EntryCount - 1)) == 0,
+		"EntryCount must be a power of two.");
+
+	const uint32_t seed = seeds[hash(key, 0) & (SeedCount - 1)];
+	const Entry *const entry = &entries[hash(key, seed) & (EntryCount - 1)];
+	return (entry->off[0] != 0 && entry->key == key ? entry : nullptr);
+}
+
+/**
+ * Get a string from a string pool.
+ * @param strtbl String pool.
+ * @param offset Offset. (0 == no entry)
+ * @return String, or nullptr if offset is 0.
+ */
+static inline const char *str(const char *strtbl, uint32_t offset)
+{
+	return (offset != 0 ? &strtbl[offset] : nullptr);
+}
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DATA_PERFECTHASH_HPP__ */
@@ -0,0 +1,896 @@
+/** SegaPublishers_data.h: Generated from SegaPublishers.tbl by gen_lookup_tables.py. **/
+/** DO NOT EDIT! Edit SegaPublishers.tbl and regenerate this file instead. **/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DATA_SEGAPUBLISHERS_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_DATA_SEGAPUBLISHERS_DATA_H__
+
+#include <stdint.h>
+
+// String pool. (4927 bytes)
+// Offset 0 is the empty string, which indicates "no entry".
+static const char SegaPublishers_strtbl[] =
+	"\0"
+	"Sega\0"
+	"Taito\0"
+	"Capcom\0"
+	"Data East\0"
+	"Namco (Namcot)\0"
+	"Sun Electronics (Sunsoft)\0"
+	"Ma-Ba\0"
+	"Dempa\0"
+	"Tecno Soft\0"
+	"Asmik\0"
+	"ASCII\0"
+	"Micronet\0"
+	"VIC Tokai\0"
+	"Treco, Sammy\0"
+	"Nippon Computer Systems (Masaya)\0"
+	"Sigma Enterprises\0"
+	"Toho\0"
+	"HOT-B\0"
+	"Kyugo\0"
+	"Video System\0"
+	"SNK\0"
+	"Wolf Team\0"
+	"Kaneko\0"
+	"DreamWorks\0"
+	"Seismic Software\0"
+	"Tecmo\0"
+	"Mediagenic\0"
+	"Toaplan\0"
+	"UNIPACC\0"
+	"UPL\0"
+	"Human\0"
+	"Sanritsu (SIMS)\0"
+	"Game Arts\0"
+	"Kodansha Research Institute\0"
+	"Sage's Creation\0"
+	"Tengen (Time Warner Interactive)\0"
+	"Telenet Japan, Micro World\0"
+	"Electronic Arts\0"
+	"Microcabin\0"
+	"SystemSoft (SystemSoft Alpha)\0"
+	"Riverhillsoft\0"
+	"Face\0"
+	"Nuvision Entertainment\0"
+	"Razorsoft\0"
+	"Jaleco\0"
+	"Visco\0"
+	"Victor Musical Industries (Victor Entertainment, Victor Soft)\0"
+	"Toyo Recording Co. (Wonder Amusement Studio)\0"
+	"Sony Imagesoft\0"
+	"Toshiba EMI\0"
+	"Information Global Service\0"
+	"Tsukuda Ideal\0"
+	"Compile\0"
+	"Home Data (Magical)\0"
+	"CSK Research Institute (CRI)\0"
+	"Arena Entertainment\0"
+	"Virgin Interactive\0"
+	"Nihon Bussan (Nichibutsu)\0"
+	"Varie\0"
+	"Coconuts Japan, Soft Vision\0"
+	"PALSOFT\0"
+	"Pony Canyon\0"
+	"Koei\0"
+	"Takeru (Sur De Wave)\0"
+	"U.S. Gold\0"
+	"Acclaim Entertainment, Flying Edge\0"
+	"GameTek\0"
+	"Datawest\0"
+	"PCM Complete\0"
+	"Absolute Entertainment\0"
+	"Mindscape (The Software Toolworks)\0"
+	"Domark\0"
+	"Parker Brothers\0"
+	"Pack-In Video (Victor Interactive Software, Pack-In-Soft, Victor Soft)\0"
+	"Polydor (Sandstorm)\0"
+	"Sony\0"
+	"Konami\0"
+	"Tradewest, Williams Entertainment, Midway Games\0"
+	"Success\0"
+	"THQ, Black Pearl Software)\0"
+	"TecMagik Entertainment\0"
+	"Samsung\0"
+	"Takara\0"
+	"Shogakukan Production\0"
+	"Electronic Arts Victor\0"
+	"Electro Brain\0"
+	"Saddleback Graphics\0"
+	"Dynamix (Simon & Schuster Interactive)\0"
+	"American Laser Games\0"
+	"Hi-Tech Expressions\0"
+	"Psygnosis\0"
+	"T&E Soft\0"
+	"Core Design\0"
+	"The Learning Company\0"
+	"Accolade\0"
+	"Codemasters\0"
+	"ReadySoft\0"
+	"Gremlin Interactive\0"
+	"Spectrum Holobyte\0"
+	"Interplay\0"
+	"Maxis\0"
+	"Working Designs\0"
+	"Activision\0"
+	"Playmates Interactive Entertainment\0"
+	"Bandai\0"
+	"CapDisc\0"
+	"ASC Games\0"
+	"Viacom New Media\0"
+	"Toei Video\0"
+	"Hudson (Hudson Soft)\0"
+	"Atlus\0"
+	"Sony Music Entertainment\0"
+	"Sansan\0"
+	"Nisshouiwai Infocom\0"
+	"Imagineer (Imadio)\0"
+	"Infogrames\0"
+	"Davidson & Associates\0"
+	"Rocket Science Games\0"
+	"Technōs Japan\0"
+	"Angel\0"
+	"Mindscape\0"
+	"Crystal Dynamics\0"
+	"Sales Curve Interactive\0"
+	"Fox Interactive\0"
+	"Digital Pictures\0"
+	"Ocean Software\0"
+	"Seta\0"
+	"Altron\0"
+	"ASK Kodansha\0"
+	"Athena\0"
+	"Gakken\0"
+	"General Entertainment\0"
+	"EA Sports\0"
+	"Glams\0"
+	"ASCII Something Good\0"
+	"Ubisoft\0"
+	"Hitachi\0"
+	"BMG Interactive Entertainment (BMG Victor, BMG Japan)\0"
+	"Obunsha\0"
+	"Thinking Cap\0"
+	"Gaga Communications\0"
+	"SoftBank (Game Bank)\0"
+	"Naxat Soft (Pionesoft)\0"
+	"Mizuki (Spike, Maxbet)\0"
+	"KAZe\0"
+	"Sega Yonezawa\0"
+	"We Net\0"
+	"Datam Polystar\0"
+	"KID\0"
+	"Epoch\0"
+	"Ving\0"
+	"Yoshimoto Kogyo\0"
+	"NEC Interchannel (InterChannel)\0"
+	"Sonnet Computer Entertainment\0"
+	"Game Studio\0"
+	"Psikyo\0"
+	"Media Entertainment\0"
+	"Banpresto\0"
+	"Ecseco Development\0"
+	"Bullet-Proof Software (BPS)\0"
+	"Sieg\0"
+	"Yanoman\0"
+	"Oz Club\0"
+	"Nihon Create\0"
+	"Media Rings Corporation\0"
+	"Shoeisha\0"
+	"OPeNBooK\0"
+	"Hakuhodo (Hamlet)\0"
+	"Aroma (Yumedia)\0"
+	"Societa Daikanyama\0"
+	"Arc System Works\0"
+	"Climax Entertainment\0"
+	"Pioneer LDC\0"
+	"Tokuma Shoten\0"
+	"I'MAX\0"
+	"Shogakukan\0"
+	"Vantan International\0"
+	"Titus\0"
+	"LucasArts\0"
+	"Pai\0"
+	"Ecole (Reindeer)\0"
+	"Nayuta\0"
+	"Bandai Visual\0"
+	"Quintet\0"
+	"Disney Interactive\0"
+	"9003 (OpenBook9003)\0"
+	"Multisoft\0"
+	"Sky Think System\0"
+	"OCC\0"
+	"Increment P (iPC)\0"
+	"King Records\0"
+	"Fun House\0"
+	"Patra\0"
+	"Inner Brain\0"
+	"Make Software\0"
+	"GT Interactive Software\0"
+	"Kodansha\0"
+	"Clef\0"
+	"C-Seven\0"
+	"Fujitsu Parex\0"
+	"Xing Entertainment\0"
+	"Media Quest\0"
+	"Wooyoung System\0"
+	"Nihon System\0"
+	"Scholar\0"
+	"Datt Japan\0"
+	"MediaWorks\0"
+	"Kadokawa Shoten\0"
+	"Elf\0"
+	"Tomy\0"
+	"KSS\0"
+	"Mainichi Communications\0"
+	"Warashi\0"
+	"Metro\0"
+	"Sai-Mate\0"
+	"Kokopeli Digital Studios\0"
+	"Planning Office Wada (POW)\0"
+	"Telstar\0"
+	"Warp, Kumon Publishing\0"
+	"Masudaya\0"
+	"Soft Office\0"
+	"Empire Interactive\0"
+	"Genki (Sada Soft)\0"
+	"Neverland\0"
+	"Shar Rock\0"
+	"Natsume\0"
+	"Nexus Interact\0"
+	"Aplix Corporation\0"
+	"Omiya Soft\0"
+	"JVC\0"
+	"Zoom\0"
+	"TEN Institute\0"
+	"Fujitsu\0"
+	"TGL\0"
+	"Red Company (Red Entertainment)\0"
+	"Waka Manufacturing\0"
+	"Treasure\0"
+	"Tokuma Shoten Intermedia\0"
+	"Sonic! Software Planning (Camelot)\0"
+	"Sting\0"
+	"Chunsoft\0"
+	"Aki\0"
+	"From Software\0"
+	"Daiki\0"
+	"Aspect\0"
+	"Micro Vision\0"
+	"Gainax\0"
+	"FortyFive (45XLV)\0"
+	"Enix\0"
+	"Ray Corporation\0"
+	"Tonkin House\0"
+	"Outrigger\0"
+	"B-Factory\0"
+	"LayUp\0"
+	"Axela\0"
+	"WorkJam\0"
+	"Nihon Syscom (Syscom Entertainment)\0"
+	"FOG (Full On Games)\0"
+	"Eidos Interactive\0"
+	"UEP Systems\0"
+	"Shouei System\0"
+	"GMF\0"
+	"ADK\0"
+	"Softstar Entertainment\0"
+	"Nexton\0"
+	"Denshi Media Services\0"
+	"Takuyo\0"
+	"Starlight Marry\0"
+	"Crystal Vision\0"
+	"Kamata and Partners\0"
+	"AquaPlus\0"
+	"Media Gallop\0"
+	"Culture Brain\0"
+	"Locus\0"
+	"Entertainment Software Publishing (ESP)\0"
+	"NEC Home Electronics\0"
+	"Pulse Interactive\0"
+	"Random House\0"
+	"Vivarium\0"
+	"Mebius\0"
+	"Panther Software\0"
+	"TBS\0"
+	"NetVillage (Gamevillage)\0"
+	"Vision (Noisia)\0"
+	"Shangri-La\0"
+	"Crave Entertainment\0"
+	"Metro3D\0"
+	"Majesco\0"
+	"Take-Two Interactive\0"
+	"Hasbro Interactive\0"
+	"Rage Software (Rage Games)\0"
+	"Marvelous Entertainment\0"
+	"Bottom Up\0"
+	"Daikoku Denki\0"
+	"Sunrise Interactive\0"
+	"Bimboosoft\0"
+	"UFO\0"
+	"Mattel Interactive\0"
+	"CaramelPot\0"
+	"Vatical Entertainment\0"
+	"Ripcord Games\0"
+	"Sega Toys\0"
+	"Gathering of Developers\0"
+	"Rockstar Games\0"
+	"Winkysoft\0"
+	"Cyberfront\0"
+	"DaZZ\0"
+	"Kobi\0"
+	"Fujicom\0"
+	"Real Vision\0"
+	"Visit\0"
+	"Global A Entertainment\0"
+	"Studio Wonder Effect\0"
+	"Media Factory\0"
+	"Red\0"
+	"Agetec\0"
+	"Abel\0"
+	"Softmax\0"
+	"Isao\0"
+	"Kool Kizz\0"
+	"GeneX\0"
+	"Xicat Interactive\0"
+	"Swing! Entertainment\0"
+	"Yuke's\0"
+	"AAA Game\0"
+	"TV Asahi\0"
+	"Crazy Games\0"
+	"Atmark\0"
+	"Hackberry\0"
+	"AIA\0"
+	"Starfish-SD\0"
+	"Idea Factory\0"
+	"Broccoli\0"
+	"Oaks (Princess Soft)\0"
+	"Bigben Interactive\0"
+	"G.rev\0"
+	"Symbio Planning\0"
+	"Alchemist\0"
+	"SNK Playmore\0"
+	"D3Publisher\0"
+	"Rain Software (Charara)\0"
+	"Good Navigate (GN Software)\0"
+	"Alfa System\0"
+	"Milestone Inc.\0"
+	"Triangle Service\0";
+
+// tcode: 347 entries, 512 slots.
+static const uint8_t SegaPublishers_tcode_seeds[128] = {
+	    1,     4,     4,     3,     1,     2,     3,     2,
+	    4,     1,     1,     0,     4,     4,     5,     2,
+	    0,     1,     2,     1,     7,     3,     2,     4,
+	    1,     3,     1,     4,     4,     4,     2,     1,
+	    2,     1,     1,     3,     0,     8,     7,     1,
+	    1,     1,     5,     0,     5,     4,     7,     2,
+	    1,     0,     2,     1,     5,     3,     8,     4,
+	    9,     8,     4,     1,     1,     2,     9,     3,
+	    0,     2,     5,     8,     1,     1,     1,     6,
+	    4,     3,     4,     7,     4,    12,     2,    10,
+	   19,     2,     0,     6,     5,     0,     5,     3,
+	    3,    11,     4,     1,     2,     7,     5,     1,
+	   11,     2,     1,     5,     7,     2,     1,     4,
+	    2,     2,    17,     5,    13,     3,     3,     1,
+	    2,     5,     1,     2,     3,     1,    28,     2,
+	   10,     8,    15,     9,     1,     1,     1,     1,
+};
+static const struct SegaPublishers_tcode_t {
+	uint16_t key;
+	uint16_t off[1];
+} SegaPublishers_tcode[512] = {
+	{0, {0}},
+	{0x007E, { 1609}},
+	{0, {0}},
+	{0x00F9, { 2894}},
+	{0x019C, { 4313}},
+	{0x00EB, { 2798}},
+	{0, {0}},
+	{0x0133, { 3279}},
+	{0x00A5, { 2003}},
+	{0x019E, { 4328}},
+	{0x0056, { 1014}},
+	{0, {0}},
+	{0, {0}},
+	{0x01B6, { 4523}},
+	{0x014A, { 3483}},
+	{0, {0}},
+	{0x015C, { 3582}},
+	{0x009E, { 1904}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x0013, {   82}},
+	{0x0035, {  497}},
+	{0, {0}},
+	{0, {0}},
+	{0x0132, { 3267}},
+	{0, {0}},
+	{0x009A, { 1883}},
+	{0x0173, { 3801}},
+	{0, {0}},
+	{0x0172, { 3787}},
+	{0x01BD, { 4574}},
+	{0x0073, { 1497}},
+	{0, {0}},
+	{0, {0}},
+	{0x0103, { 2987}},
+	{0x0023, {  250}},
+	{0x01CA, { 4686}},
+	{0x00AC, { 2064}},
+	{0x0029, {  292}},
+	{0x00B5, { 2171}},
+	{0x0059, { 1079}},
+	{0x0178, { 3839}},
+	{0, {0}},
+	{0x0022, {  239}},
+	{0x018A, { 4053}},
+	{0x015E, { 3589}},
+	{0, {0}},
+	{0, {0}},
+	{0x0077, { 1530}},
+	{0x0163, { 3627}},
+	{0x0045, {  794}},
+	{0, {0}},
+	{0x017D, { 3884}},
+	{0x01DE, { 4895}},
+	{0, {0}},
+	{0, {0}},
+	{0x0028, {  284}},
+	{0x0040, {  696}},
+	{0x0141, { 3397}},
+	{0x0126, { 3175}},
+	{0, {0}},
+	{0x00C5, { 2320}},
+	{0, {0}},
+	{0, {0}},
+	{0x01C0, { 4597}},
+	{0, {0}},
+	{0, {0}},
+	{0x002E, {  336}},
+	{0x01C6, { 4649}},
+	{0x01A7, { 4453}},
+	{0x00BA, { 2212}},
+	{0x0020, {  222}},
+	{0x00FE, { 2949}},
+	{0x003A, {  556}},
+	{0, {0}},
+	{0x009F, { 1914}},
+	{0x0148, { 3455}},
+	{0x0043, {  745}},
+	{0x016F, { 3737}},
+	{0, {0}},
+	{0x004D, {  918}},
+	{0x00C3, { 2305}},
+	{0x0044, {  765}},
+	{0x0096, { 1810}},
+	{0, {0}},
+	{0x0104, { 2995}},
+	{0x01AD, { 4474}},
+	{0x017B, { 3861}},
+	{0x00B1, { 2101}},
+	{0x00E0, { 2702}},
+	{0x016B, { 3687}},
+	{0, {0}},
+	{0, {0}},
+	{0x01BE, { 4582}},
+	{0x016D, { 3701}},
+	{0, {0}},
+	{0, {0}},
+	{0x00F2, { 2855}},
+	{0x00DF, { 2688}},
+	{0, {0}},
+	{0x00A8, { 2028}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x00B9, { 2192}},
+	{0x0116, { 3088}},
+	{0x00E3, { 2719}},
+	{0x0012, {   82}},
+	{0, {0}},
+	{0x0134, { 3298}},
+	{0x0105, { 3009}},
+	{0x00A1, { 1955}},
+	{0, {0}},
+	{0x000C, {   12}},
+	{0x018C, { 4069}},
+	{0x0053, {  984}},
+	{0x0165, { 3648}},
+	{0x005B, { 1095}},
+	{0, {0}},
+	{0, {0}},
+	{0x017F, { 3919}},
+	{0x007C, { 1581}},
+	{0x0121, { 3124}},
+	{0x0065, { 1281}},
+	{0x00D4, { 2522}},
+	{0, {0}},
+	{0x007B, { 1561}},
+	{0x0197, { 4218}},
+	{0, {0}},
+	{0, {0}},
+	{0x0030, {  380}},
+	{0x01A6, { 4443}},
+	{0x00D1, { 2509}},
+	{0x01C7, { 4658}},
+	{0, {0}},
+	{0, {0}},
+	{0x0142, { 3411}},
+	{0x001F, {  218}},
+	{0, {0}},
+	{0x0066, { 1304}},
+	{0, {0}},
+	{0x019B, { 4293}},
+	{0, {0}},
+	{0, {0}},
+	{0x0099, { 1862}},
+	{0x002D, {  326}},
+	{0x00D9, { 2585}},
+	{0x0042, {  737}},
+	{0x00B4, { 2117}},
+	{0x00A9, { 2035}},
+	{0, {0}},
+	{0, {0}},
+	{0x00E8, { 2760}},
+	{0x0138, { 3344}},
+	{0x00F1, { 2845}},
+	{0x017E, { 3899}},
+	{0, {0}},
+	{0x0067, { 1312}},
+	{0x00C8, { 2335}},
+	{0x01D2, { 4755}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x01BF, { 4587}},
+	{0, {0}},
+	{0x00E7, { 2756}},
+	{0x0049, {  865}},
+	{0, {0}},
+	{0, {0}},
+	{0x017C, { 3868}},
+	{0x019D, { 4324}},
+	{0x0124, { 3160}},
+	{0, {0}},
+	{0x00CA, { 2383}},
+	{0x00B6, { 2179}},
+	{0, {0}},
+	{0x0182, { 3955}},
+	{0x01A3, { 4404}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x004A, {  893}},
+	{0x01B2, { 4494}},
+	{0, {0}},
+	{0x0031, {  413}},
+	{0x0139, { 3359}},
+	{0x0183, { 3961}},
+	{0x00A4, { 1988}},
+	{0x0018, {  124}},
+	{0x0010, {   70}},
+	{0, {0}},
+	{0x0058, { 1072}},
+	{0x0156, { 3562}},
+	{0x006E, { 1398}},
+	{0, {0}},
+	{0x007D, { 1599}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x0033, {  456}},
+	{0, {0}},
+	{0x0064, { 1254}},
+	{0x0051, {  949}},
+	{0x00D2, { 2514}},
+	{0x002B, {  304}},
+	{0x01BC, { 4569}},
+	{0x00CF, { 2462}},
+	{0, {0}},
+	{0x0180, { 3928}},
+	{0x00C7, { 2330}},
+	{0, {0}},
+	{0, {0}},
+	{0x01B7, { 4544}},
+	{0, {0}},
+	{0x0090, { 1752}},
+	{0x00AA, { 2042}},
+	{0, {0}},
+	{0, {0}},
+	{0x01DF, { 4910}},
+	{0, {0}},
+	{0, {0}},
+	{0x00E2, { 2708}},
+	{0x0128, { 3200}},
+	{0, {0}},
+	{0x0181, { 3941}},
+	{0, {0}},
+	{0x0019, {  137}},
+	{0x0194, { 4170}},
+	{0x01BB, { 4562}},
+	{0x0084, { 1642}},
+	{0, {0}},
+	{0x00D5, { 2530}},
+	{0x01D3, { 4774}},
+	{0x003F, {  684}},
+	{0x01DC, { 4855}},
+	{0x0087, { 1685}},
+	{0, {0}},
+	{0x01DD, { 4883}},
+	{0, {0}},
+	{0x0047, {  833}},
+	{0x0155, { 3558}},
+	{0x0198, { 4245}},
+	{0x0076, { 1509}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x009D, { 1898}},
+	{0x01A8, { 4464}},
+	{0x006D, { 1378}},
+	{0, {0}},
+	{0x0162, { 3609}},
+	{0x0057, { 1037}},
+	{0x001C, {  193}},
+	{0x00DC, { 2638}},
+	{0x0034, {  467}},
+	{0x00CB, { 2413}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x018E, { 4090}},
+	{0, {0}},
+	{0, {0}},
+	{0x00A0, { 1931}},
+	{0, {0}},
+	{0x0000, {    1}},
+	{0x0176, { 3809}},
+	{0x0048, {  859}},
+	{0x01B1, { 4482}},
+	{0x019A, { 4279}},
+	{0x0021, {  232}},
+	{0x0125, { 3166}},
+	{0x00F3, { 2872}},
+	{0x00F0, { 2825}},
+	{0x006A, { 1341}},
+	{0x0191, { 4131}},
+	{0x001B, {  188}},
+	{0, {0}},
+	{0x0136, { 3326}},
+	{0, {0}},
+	{0, {0}},
+	{0x00CD, { 2432}},
+	{0x008D, { 1720}},
+	{0, {0}},
+	{0x0041, {  723}},
+	{0x0171, { 3775}},
+	{0, {0}},
+	{0x012F, { 3258}},
+	{0, {0}},
+	{0x0190, { 4115}},
+	{0, {0}},
+	{0x0038, {  539}},
+	{0x00B0, { 2080}},
+	{0x004B, {  901}},
+	{0x0015, {   99}},
+	{0, {0}},
+	{0x0014, {   93}},
+	{0x00C6, { 2324}},
+	{0x006F, { 1437}},
+	{0, {0}},
+	{0, {0}},
+	{0x01B3, { 4500}},
+	{0x0169, { 3671}},
+	{0x0195, { 4178}},
+	{0x0091, { 1758}},
+	{0x01CE, { 4712}},
+	{0x011A, { 3119}},
+	{0x01D5, { 4780}},
+	{0x00EF, { 2806}},
+	{0x0196, { 4199}},
+	{0x00D0, { 2481}},
+	{0x000E, {   29}},
+	{0, {0}},
+	{0x01C8, { 4667}},
+	{0, {0}},
+	{0, {0}},
+	{0x00E6, { 2746}},
+	{0x01CF, { 4725}},
+	{0x018D, { 4086}},
+	{0x00D7, { 2567}},
+	{0x00AE, { 2074}},
+	{0x00C9, { 2351}},
+	{0x0186, { 4022}},
+	{0x0095, { 1790}},
+	{0x003D, {  624}},
+	{0x00D8, { 2576}},
+	{0x0098, { 1840}},
+	{0x002A, {  300}},
+	{0x00D6, { 2543}},
+	{0x00CE, { 2452}},
+	{0x0054, {  992}},
+	{0, {0}},
+	{0x00E5, { 2740}},
+	{0, {0}},
+	{0x014B, { 3508}},
+	{0x001E, {  205}},
+	{0x008F, { 1731}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x0153, { 3543}},
+	{0x0017, {  114}},
+	{0x01C9, { 4679}},
+	{0x013A, { 3377}},
+	{0x001A, {  170}},
+	{0, {0}},
+	{0x0149, { 3474}},
+	{0x0024, {  267}},
+	{0x013B, { 3388}},
+	{0x008B, { 1703}},
+	{0, {0}},
+	{0x01C2, { 4621}},
+	{0, {0}},
+	{0x01B9, { 4558}},
+	{0x00C2, { 2298}},
+	{0x00A2, { 1971}},
+	{0, {0}},
+	{0x0175, { 3805}},
+	{0x00E9, { 2777}},
+	{0x0117, { 3099}},
+	{0x019F, { 4347}},
+	{0x00FC, { 2923}},
+	{0, {0}},
+	{0, {0}},
+	{0x00A7, { 2015}},
+	{0, {0}},
+	{0x0111, { 3077}},
+	{0x00FA, { 2907}},
+	{0x013C, { 3392}},
+	{0x012C, { 3235}},
+	{0x003E, {  669}},
+	{0x00F6, { 2876}},
+	{0x002C, {  310}},
+	{0x010C, { 3040}},
+	{0x016A, { 3681}},
+	{0x00C1, { 2284}},
+	{0x0039, {  549}},
+	{0x0164, { 3632}},
+	{0x0193, { 4162}},
+	{0x00BC, { 2256}},
+	{0x0078, { 1539}},
+	{0, {0}},
+	{0x00BD, { 2279}},
+	{0x0032, {  440}},
+	{0x0093, { 1783}},
+	{0x0089, { 1693}},
+	{0, {0}},
+	{0x01D1, { 4734}},
+	{0x005C, { 1166}},
+	{0, {0}},
+	{0x0055, { 1001}},
+	{0x0168, { 3661}},
+	{0x0192, { 4142}},
+	{0x0123, { 3152}},
+	{0x0071, { 1478}},
+	{0, {0}},
+	{0x002F, {  364}},
+	{0, {0}},
+	{0x0135, { 3316}},
+	{0, {0}},
+	{0x0108, { 3028}},
+	{0x01CC, { 4696}},
+	{0x00CC, { 2425}},
+	{0, {0}},
+	{0x015A, { 3576}},
+	{0x0036, {  511}},
+	{0, {0}},
+	{0x0069, { 1319}},
+	{0, {0}},
+	{0x0046, {  814}},
+	{0x0072, { 1488}},
+	{0x0199, { 4269}},
+	{0x0079, { 1551}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x0061, { 1198}},
+	{0x0037, {  516}},
+	{0, {0}},
+	{0x00A6, { 2008}},
+	{0, {0}},
+	{0, {0}},
+	{0x01A0, { 4358}},
+	{0, {0}},
+	{0, {0}},
+	{0x001D, {  199}},
+	{0x0101, { 2982}},
+	{0x0085, { 1678}},
+	{0x00FF, { 2973}},
+	{0x00B2, { 2109}},
+	{0, {0}},
+	{0x018B, { 4062}},
+	{0x01A2, { 4394}},
+	{0, {0}},
+	{0x0016, {  105}},
+	{0x0146, { 3423}},
+	{0x00FB, { 2917}},
+	{0x0137, { 3336}},
+	{0, {0}},
+	{0x00BB, { 2233}},
+	{0x00DA, { 2603}},
+	{0, {0}},
+	{0x0097, { 1829}},
+	{0x0145, { 3419}},
+	{0x007F, { 1615}},
+	{0x0122, { 3128}},
+	{0x010E, { 3056}},
+	{0, {0}},
+	{0x00DD, { 2655}},
+	{0, {0}},
+	{0x00EA, { 2784}},
+	{0, {0}},
+	{0x01DA, { 4819}},
+	{0, {0}},
+	{0x01D7, { 4796}},
+	{0, {0}},
+	{0x01C1, { 4603}},
+	{0x00DE, { 2676}},
+	{0x005D, { 1186}},
+	{0x005F, { 1191}},
+	{0x016C, { 3693}},
+	{0x0063, { 1246}},
+	{0x0011, {   76}},
+	{0x0187, { 4040}},
+	{0x01AC, { 4469}},
+	{0x01A1, { 4380}},
+	{0x0070, { 1458}},
+	{0x006B, { 1364}},
+	{0x000B, {    6}},
+	{0x01C3, { 4642}},
+	{0x0177, { 3832}},
+	{0x010F, { 3069}},
+	{0x0082, { 1631}},
+	{0, {0}},
+	{0x01D9, { 4806}},
+	{0, {0}},
+	{0x015F, { 3602}},
+	{0x003C, {  562}},
+	{0x00DB, { 2619}},
+	{0, {0}},
+	{0x004C, {  913}},
+	{0x0170, { 3757}},
+	{0, {0}},
+	{0x0129, { 3227}},
+	{0x01CD, { 4700}},
+	{0, {0}},
+	{0, {0}},
+	{0x000F, {   44}},
+	{0x0026, {  273}},
+	{0, {0}},
+	{0x00FD, { 2935}},
+	{0x0118, { 3115}},
+	{0x0092, { 1312}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x01A5, { 4428}},
+	{0, {0}},
+	{0, {0}},
+	{0x000D, {   19}},
+	{0, {0}},
+	{0x01DB, { 4831}},
+	{0x004F, {  939}},
+	{0, {0}},
+	{0x0154, { 3549}},
+	{0x0184, { 4001}},
+	{0, {0}},
+};
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DATA_SEGAPUBLISHERS_DATA_H__ */
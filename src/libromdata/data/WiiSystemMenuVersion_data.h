@@ -0,0 +1,129 @@
+/** WiiSystemMenuVersion_data.h: Generated from WiiSystemMenuVersion.tbl by gen_lookup_tables.py. **/
+/** DO NOT EDIT! Edit WiiSystemMenuVersion.tbl and regenerate this file instead. **/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DATA_WIISYSTEMMENUVERSION_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_DATA_WIISYSTEMMENUVERSION_DATA_H__
+
+#include <stdint.h>
+
+// String pool. (200 bytes)
+// Offset 0 is the empty string, which indicates "no entry".
+static const char WiiSystemMenuVersion_strtbl[] =
+	"\0"
+	"1.0\0"
+	"2.0U\0"
+	"2.0J\0"
+	"2.0E\0"
+	"2.1E\0"
+	"2.2J\0"
+	"2.2U\0"
+	"2.2E\0"
+	"3.0J\0"
+	"3.0U\0"
+	"3.0E\0"
+	"3.1J\0"
+	"3.1U\0"
+	"3.1E\0"
+	"3.2J\0"
+	"3.2U\0"
+	"3.2E\0"
+	"3.3K\0"
+	"3.3J\0"
+	"3.3U\0"
+	"3.3E\0"
+	"3.4J\0"
+	"3.4U\0"
+	"3.4E\0"
+	"3.5K\0"
+	"4.0J\0"
+	"4.0U\0"
+	"4.0E\0"
+	"4.1J\0"
+	"4.1U\0"
+	"4.1E\0"
+	"4.1K\0"
+	"4.2J\0"
+	"4.2U\0"
+	"4.2E\0"
+	"4.2K\0"
+	"4.3J\0"
+	"4.3U\0"
+	"4.3E\0"
+	"4.3K\0";
+
+// sysVersion: 46 entries, 64 slots.
+static const uint8_t WiiSystemMenuVersion_sysVersion_seeds[16] = {
+	    2,     0,     2,     1,    13,    24,     2,    11,
+	    1,     2,     1,    13,    15,     2,     1,     2,
+};
+static const struct WiiSystemMenuVersion_sysVersion_t {
+	uint16_t key;
+	uint16_t off[1];
+} WiiSystemMenuVersion_sysVersion[64] = {
+	{0x0162, {  100}},
+	{0x01C0, {  140}},
+	{0x0122, {   80}},
+	{0x0200, {  180}},
+	{0x00E0, {   40}},
+	{0x01C1, {  145}},
+	{0x0260, {  180}},
+	{0x00C1, {   30}},
+	{0x0181, {  110}},
+	{0x0180, {  105}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0, {0}},
+	{0x0102, {   65}},
+	{0, {0}},
+	{0x0182, {  115}},
+	{0, {0}},
+	{0x0080, {   10}},
+	{0x0021, {    1}},
+	{0x0201, {  185}},
+	{0x0120, {   70}},
+	{0x01A1, {  130}},
+	{0, {0}},
+	{0x0121, {   75}},
+	{0, {0}},
+	{0, {0}},
+	{0x00C2, {   35}},
+	{0x00E1, {   45}},
+	{0x01E1, {  165}},
+	{0x01A0, {  125}},
+	{0, {0}},
+	{0x0160, {   90}},
+	{0, {0}},
+	{0x01C2, {  150}},
+	{0x0186, {  120}},
+	{0, {0}},
+	{0, {0}},
+	{0x0262, {  190}},
+	{0x0161, {   95}},
+	{0x00A2, {   20}},
+	{0x01E2, {  170}},
+	{0x0202, {  190}},
+	{0x01C6, {  155}},
+	{0x0206, {  195}},
+	{0x0261, {  185}},
+	{0x00E2, {   50}},
+	{0x0101, {   60}},
+	{0x0220, {  180}},
+	{0, {0}},
+	{0x0082, {   15}},
+	{0, {0}},
+	{0, {0}},
+	{0x01A2, {  135}},
+	{0x01E3, {  175}},
+	{0x00C0, {   25}},
+	{0x0146, {   85}},
+	{0x0221, {  185}},
+	{0x0100, {   55}},
+	{0x0061, {    5}},
+	{0, {0}},
+	{0, {0}},
+	{0x01E0, {  160}},
+	{0x0222, {  190}},
+};
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DATA_WIISYSTEMMENUVERSION_DATA_H__ */
@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# ROM Properties Page shell extension. (libromdata)
+# gen_lookup_tables.py: Generate lookup table headers from .tbl files.
+#
+# Copyright (c) 2016-2020 by David Korth.
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# Usage: gen_lookup_tables.py file1.tbl [file2.tbl...]
+#
+# Each X.tbl file is converted to X_data.h in the same directory.
+# The generated headers are checked into the repository, so Python
+# is *not* required to build rom-properties; this script only needs
+# to be run after editing a .tbl file.
+#
+# .tbl format:
+# - Lines starting with '#' are comments. Blank lines are ignored.
+# - "@table NAME TYPE key=KEYTYPE [cols=N] [size=N] [ctx=MSGCTXT]"
+#   starts a new table.
+#   - TYPE is either "hash" or "dense".
+#     - hash: Two-level perfect hash table. (See PerfectHash.hpp.)
+#     - dense: Offset array indexed directly by key. (cols must be 1)
+#   - KEYTYPE is uint8, uint16, or uint32.
+#   - cols: Number of string columns. (default is 1)
+#   - size: Array size for dense tables. (default is max key + 1)
+#   - ctx: If set, column 0 is translatable using the specified
+#     msgctxt. The strings are emitted in an "#if 0" block as
+#     NOP_C_() so xgettext can find them.
+# - Entry lines: KEY<tab>VALUE1[<tab>VALUE2...][<tab># comment]
+#   - Fields are separated by one or more tabs.
+#   - KEY is decimal, hexadecimal (0x), or a two-character
+#   multi-character constant ('AB' == 0x4142).
+#
+# All strings are stored in a single string pool. Tables contain
+# offsets into the pool instead of pointers, so the tables don't
+# need relocations when the library is loaded.
+# Offset 0 is an empty string and is used for "no entry".
+#
+# The hash function MUST match PerfectHash::hash() in PerfectHash.hpp.
+
+import os
+import re
+import sys
+
+KEY_TYPES = {
+	'uint8':  ('uint8_t',  0xFF,       '0x%02X'),
+	'uint16': ('uint16_t', 0xFFFF,     '0x%04X'),
+	'uint32': ('uint32_t', 0xFFFFFFFF, '0x%08X'),
+}
+
+# Maximum second-level seed value.
+MAX_SEED = 0xFFFF
+
+def phash(key, seed):
+	"""Hash a key. (Must match PerfectHash::hash().)"""
+	h = (key ^ ((seed * 0x9E3779B9) & 0xFFFFFFFF)) & 0xFFFFFFFF
+	h ^= h >> 16
+	h = (h * 0x85EBCA6B) & 0xFFFFFFFF
+	h ^= h >> 13
+	h = (h * 0xC2B2AE35) & 0xFFFFFFFF
+	h ^= h >> 16
+	return h
+
+def next_pow2(n):
+	"""Get the next power of two that's >= n. (minimum is 1)"""
+	p = 1
+	while p < n:
+		p <<= 1
+	return p
+
+class Table:
+	def __init__(self, filename, lineno, name, ttype, opts):
+		self.name = name
+		self.ttype = ttype
+		if ttype not in ('hash', 'dense'):
+			raise ValueError('%s:%d: invalid table type "%s"' % (filename, lineno, ttype))
+		keytype = opts.get('key', 'uint16')
+		if keytype not in KEY_TYPES:
+			raise ValueError('%s:%d: invalid key type "%s"' % (filename, lineno, keytype))
+		self.keytype = keytype
+		self.cols = int(opts.get('cols', '1'))
+		if self.cols < 1 or (ttype == 'dense' and self.cols != 1):
+			raise ValueError('%s:%d: invalid column count %d' % (filename, lineno, self.cols))
+		self.size = int(opts['size'], 0) if 'size' in opts else None
+		self.ctx = opts.get('ctx')
+		self.entries = []	# (key, [values])
+		self.keys = set()
+
+def parse_key(s):
+	"""Parse a key: decimal, hexadecimal, or 'AB'."""
+	m = re.match(r"^'(.+)'$", s)
+	if m:
+		key = 0
+		for c in m.group(1).encode('utf-8'):
+			key = (key << 8) | c
+		return key
+	return int(s, 0)
+
+def parse_tbl(filename):
+	"""Parse a .tbl file."""
+	tables = []
+	cur = None
+	with open(filename, 'r', encoding='utf-8') as f:
+		for lineno, line in enumerate(f, 1):
+			line = line.rstrip('\r\n')
+			# Remove trailing comments.
+			line = re.sub(r'\t+#.*$', '', line)
+			if not line.strip() or line.startswith('#'):
+				continue
+			if line.startswith('@table'):
+				parts = line.split()
+				if len(parts) < 3:
+					raise ValueError('%s:%d: invalid @table line' % (filename, lineno))
+				opts = dict(p.split('=', 1) for p in parts[3:])
+				cur = Table(filename, lineno, parts[1], parts[2], opts)
+				tables.append(cur)
+				continue
+			if cur is None:
+				raise ValueError('%s:%d: entry before @table' % (filename, lineno))
+
+			fields = re.split(r'\t+', line)
+			if len(fields) != cur.cols + 1:
+				raise ValueError('%s:%d: expected %d columns, got %d' %
+					(filename, lineno, cur.cols, len(fields) - 1))
+			key = parse_key(fields[0])
+			if key < 0 or key > KEY_TYPES[cur.keytype][1]:
+				raise ValueError('%s:%d: key is out of range' % (filename, lineno))
+			if key in cur.keys:
+				raise ValueError('%s:%d: duplicate key %s' % (filename, lineno, fields[0]))
+			if '' in fields[1:]:
+				raise ValueError('%s:%d: empty strings are not allowed' % (filename, lineno))
+			cur.keys.add(key)
+			cur.entries.append((key, fields[1:]))
+	return tables
+
+def build_hash(table):
+	"""
+	Build a two-level perfect hash table. (hash, displace, and compress)
+	:return: (seeds, slots); slots[i] is an entry index or None.
+	"""
+	n = len(table.entries)
+	m = next_pow2(n)
+	while True:
+		b = next_pow2((n + 3) // 4)
+		buckets = [[] for i in range(b)]
+		for idx, (key, values) in enumerate(table.entries):
+			buckets[phash(key, 0) & (b - 1)].append(idx)
+
+		seeds = [0] * b
+		slots = [None] * m
+		ok = True
+		# Place the largest buckets first.
+		for bidx in sorted(range(b), key=lambda i: (-len(buckets[i]), i)):
+			bucket = buckets[bidx]
+			if not bucket:
+				continue
+			for seed in range(1, MAX_SEED + 1):
+				pos = [phash(table.entries[i][0], seed) & (m - 1) for i in bucket]
+				if len(set(pos)) == len(pos) and all(slots[p] is None for p in pos):
+					break
+			else:
+				ok = False
+				break
+			seeds[bidx] = seed
+			for i, p in zip(bucket, pos):
+				slots[p] = i
+		if ok:
+			return seeds, slots
+		# Couldn't find seeds for all buckets. Try a larger table.
+		m <<= 1
+
+def c_escape(s):
+	"""Escape a string for use in a C string literal."""
+	s = s.replace('\\', '\\\\').replace('"', '\\"')
+	# Prevent trigraphs.
+	s = s.replace('??', '?\\?')
+	return s
+
+def write_header(tbl_filename, tables):
+	base = os.path.splitext(os.path.basename(tbl_filename))[0]
+	out_filename = os.path.join(os.path.dirname(tbl_filename), base + '_data.h')
+	guard = '__ROMPROPERTIES_LIBROMDATA_DATA_%s_DATA_H__' % base.upper()
+
+	# Build the string pool.
+	pool = ['']
+	pool_offsets = {'': 0}
+	pool_size = 1
+	for table in tables:
+		for key, values in table.entries:
+			for v in values:
+				if v not in pool_offsets:
+					pool_offsets[v] = pool_size
+					pool.append(v)
+					pool_size += len(v.encode('utf-8')) + 1
+	off_type = 'uint16_t' if pool_size <= 0x10000 else 'uint32_t'
+
+	o = []
+	o.append('/** %s_data.h: Generated from %s.tbl by gen_lookup_tables.py. **/' % (base, base))
+	o.append('/** DO NOT EDIT! Edit %s.tbl and regenerate this file instead. **/' % base)
+	o.append('')
+	o.append('#ifndef %s' % guard)
+	o.append('#define %s' % guard)
+	o.append('')
+	o.append('#include <stdint.h>')
+	o.append('')
+	o.append('// String pool. (%d bytes)' % pool_size)
+	o.append('// Offset 0 is the empty string, which indicates "no entry".')
+	o.append('static const char %s_strtbl[] =' % base)
+	o.append('\t"\\0"')
+	for s in pool[1:]:
+		o.append('\t"%s\\0"' % c_escape(s))
+	o[-1] += ';'
+
+	for table in tables:
+		ctype, kmax, kfmt = KEY_TYPES[table.keytype]
+		prefix = '%s_%s' % (base, table.name)
+		o.append('')
+		if table.ttype == 'dense':
+			size = table.size
+			maxkey = max(k for k, v in table.entries) if table.entries else -1
+			if size is None:
+				size = maxkey + 1
+			elif maxkey >= size:
+				raise ValueError('%s: table "%s" has keys >= size' % (tbl_filename, table.name))
+			offs = [0] * size
+			for key, values in table.entries:
+				offs[key] = pool_offsets[values[0]]
+			o.append('// %s: %d entries, indexed by key.' % (table.name, size))
+			o.append('static const %s %s[%d] = {' % (off_type, prefix, size))
+			for i in range(0, size, 8):
+				o.append('\t' + ' '.join('%5d,' % x for x in offs[i:i+8]))
+			o.append('};')
+			continue
+
+		seeds, slots = build_hash(table)
+		seed_type = 'uint8_t' if max(seeds) <= 0xFF else 'uint16_t'
+		o.append('// %s: %d entries, %d slots.' % (table.name, len(table.entries), len(slots)))
+		o.append('static const %s %s_seeds[%d] = {' % (seed_type, prefix, len(seeds)))
+		for i in range(0, len(seeds), 8):
+			o.append('\t' + ' '.join('%5d,' % x for x in seeds[i:i+8]))
+		o.append('};')
+		o.append('static const struct %s_t {' % prefix)
+		o.append('\t%s key;' % ctype)
+		o.append('\t%s off[%d];' % (off_type, table.cols))
+		o.append('} %s[%d] = {' % (prefix, len(slots)))
+		for idx in slots:
+			if idx is None:
+				o.append('\t{0, {%s}},' % ', '.join(['0'] * table.cols))
+				continue
+			key, values = table.entries[idx]
+			o.append('\t{%s, {%s}},' % (kfmt % key,
+				', '.join('%5d' % pool_offsets[v] for v in values)))
+		o.append('};')
+
+	# Translatable strings for xgettext.
+	for table in tables:
+		if not table.ctx:
+			continue
+		o.append('')
+		o.append('#if 0')
+		o.append('// Translatable strings for %s. (used by xgettext only)' % table.name)
+		seen = set()
+		for key, values in table.entries:
+			if values[0] in seen:
+				continue
+			seen.add(values[0])
+			o.append('NOP_C_("%s", "%s")' % (table.ctx, c_escape(values[0])))
+		o.append('#endif')
+
+	o.append('')
+	o.append('#endif /* %s */' % guard)
+
+	with open(out_filename, 'w', encoding='utf-8', newline='\n') as f:
+		f.write('\n'.join(o) + '\n')
+	print('%s: %d table(s), %d-byte string pool' % (out_filename, len(tables), pool_size))
+
+def main(argv):
+	if len(argv) < 2:
+		sys.stderr.write('Usage: %s file1.tbl [file2.tbl...]\n' % argv[0])
+		return 1
+	for filename in argv[1:]:
+		write_header(filename, parse_tbl(filename))
+	return 0
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv))
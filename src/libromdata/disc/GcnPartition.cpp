@@ -132,6 +132,57 @@ off64_t GcnPartition::size(void)
 	return d->data_size;
 }
 
+/**
+ * Hint that a range of the partition will be read soon.
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int GcnPartition::prefetch(off64_t pos, size_t size)
+{
+	RP_D(const GcnPartition);
+	assert(m_discReader != nullptr);
+	if (!m_discReader || !m_discReader->isOpen()) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	// GCN partitions are stored as-is.
+	int ret = m_discReader->prefetch(d->data_offset + pos, size);
+	if (ret != 0) {
+		m_lastError = m_discReader->lastError();
+	}
+	return ret;
+}
+
+/**
+ * Read data from the specified position.
+ * The partition position is not changed.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t GcnPartition::pread(off64_t pos, void *ptr, size_t size)
+{
+	RP_D(const GcnPartition);
+	assert(m_discReader != nullptr);
+	assert(m_discReader->isOpen());
+	if (!m_discReader || !m_discReader->isOpen()) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
+	}
+
+	// GCN partitions are stored as-is.
+	// TODO: data_size checks?
+	size_t ret = m_discReader->pread(d->data_offset + pos, ptr, size);
+	m_lastError = m_discReader->lastError();
+	return ret;
+}
+
 /** IPartition **/
 
 /**
@@ -160,13 +211,14 @@ off64_t GcnPartition::partition_size_used(void) const
 		// Error loading the boot block.
 		return -1;
 	}
-	if (!d->fst) {
-		// FST isn't loaded.
-		if (const_cast<GcnPartitionPrivate*>(d)->loadFst() != 0) {
-			// FST load failed.
-			// TODO: Errors?
-			return -1;
-		}
+
+	// Get the FST used size.
+	// NOTE: This doesn't load the full FST if it isn't loaded already.
+	const off64_t fstUsedSize = const_cast<GcnPartitionPrivate*>(d)->getFstUsedSize();
+	if (fstUsedSize < 0) {
+		// FST load failed.
+		// TODO: Errors?
+		return -1;
 	}
 
 	// FST/DOL offset and size.
@@ -182,8 +234,8 @@ off64_t GcnPartition::partition_size_used(void) const
 	}
 	size <<= d->offsetShift;
 
-	// Get the FST used size.
-	size += d->fst->totalUsedSize();
+	// Add the FST used size.
+	size += fstUsedSize;
 
 	// Add the difference between partition and data sizes.
 	size += (d->partition_size - d->data_size);
@@ -12,8 +12,9 @@
 #include "GcnFst.hpp"
 #include "GcnPartition.hpp"
 
-// librpbase
+// librpbase, librpfile
 using LibRpBase::IDiscReader;
+using LibRpFile::IoVec;
 
 namespace LibRomData {
 
@@ -27,6 +28,7 @@ GcnPartitionPrivate::GcnPartitionPrivate(GcnPartition *q,
 	, bootLoaded(false)
 	, offsetShift(offsetShift)
 	, fst(nullptr)
+	, fstUsedSize(-1)
 {
 	// NOTE: The discReader parameter is needed because
 	// WiiPartitionPrivate is created *before* the
@@ -59,22 +61,17 @@ int GcnPartitionPrivate::loadBootBlockAndInfo(void)
 	}
 
 	// Load the boot block and boot info.
-	// TODO: Consolidate into a single read?
+	// NOTE: The boot info immediately follows the boot block,
+	// so both are loaded with a single read.
 	RP_Q(GcnPartition);
 	q->m_lastError = 0;
-	size_t size = q->seekAndRead(GCN_Boot_Block_ADDRESS, &bootBlock, sizeof(bootBlock));
-	if (size != sizeof(bootBlock)) {
-		// Seek and/or read failed.
-		if (q->m_lastError == 0) {
-			q->m_lastError = EIO;
-		}
-		return -q->m_lastError;
-	}
-
-	q->m_lastError = 0;
-	size = q->read(&bootInfo, sizeof(bootInfo));
-	if (size != sizeof(bootInfo)) {
-		// bootInfo read failed.
+	const IoVec iov[2] = {
+		{&bootBlock, sizeof(bootBlock)},
+		{&bootInfo, sizeof(bootInfo)},
+	};
+	size_t size = q->preadv(GCN_Boot_Block_ADDRESS, iov, static_cast<int>(ARRAY_SIZE(iov)));
+	if (size != sizeof(bootBlock) + sizeof(bootInfo)) {
+		// Read failed.
 		if (q->m_lastError == 0) {
 			q->m_lastError = EIO;
 		}
@@ -104,6 +101,14 @@ int GcnPartitionPrivate::loadBootBlockAndInfo(void)
 
 	// bootBlock and bootInfo have been loaded.
 	bootLoaded = true;
+
+	// The FST is almost always loaded afterwards,
+	// so start reading it in the background now.
+	// NOTE: Same size limit as loadFst().
+	if (bootBlock.fst_size > 0 && bootBlock.fst_size <= (1048576U >> offsetShift)) {
+		q->prefetch(static_cast<off64_t>(bootBlock.fst_offset) << offsetShift,
+			static_cast<size_t>(bootBlock.fst_size) << offsetShift);
+	}
 	return 0;
 }
 
@@ -143,13 +148,6 @@ int GcnPartitionPrivate::loadFst(void)
 		return -EIO;
 	}
 
-	// Seek to the beginning of the FST.
-	ret = q->seek(static_cast<off64_t>(bootBlock.fst_offset) << offsetShift);
-	if (ret != 0) {
-		// Seek failed.
-		return -q->m_lastError;
-	}
-
 	// Read the FST.
 	// TODO: Eliminate the extra copy?
 	uint32_t fstData_len = bootBlock.fst_size << offsetShift;
@@ -159,7 +157,7 @@ int GcnPartitionPrivate::loadFst(void)
 		q->m_lastError = ENOMEM;
 		return -ENOMEM;
 	}
-	size_t size = q->read(fstData, fstData_len);
+	size_t size = q->pread(static_cast<off64_t>(bootBlock.fst_offset) << offsetShift, fstData, fstData_len);
 	if (size != fstData_len) {
 		// Short read.
 		free(fstData);
@@ -180,4 +178,89 @@ int GcnPartitionPrivate::loadFst(void)
 	return 0;
 }
 
+/**
+ * Get the total size of all files in the FST.
+ * If the FST isn't loaded, only the FST entries are read.
+ * The string table isn't needed, so it's skipped.
+ * @return Total size of all files, or -1 on error.
+ */
+off64_t GcnPartitionPrivate::getFstUsedSize(void)
+{
+	if (fstUsedSize >= 0) {
+		// Already calculated.
+		return fstUsedSize;
+	} else if (fst) {
+		// FST is already loaded.
+		fstUsedSize = fst->totalUsedSize();
+		return fstUsedSize;
+	}
+
+	RP_Q(GcnPartition);
+	if (data_offset < 0) {
+		// Partition is invalid.
+		q->m_lastError = EINVAL;
+		return -1;
+	}
+
+	// Load the boot block and boot info.
+	if (loadBootBlockAndInfo() != 0) {
+		// Error loading boot block and/or boot info.
+		return -1;
+	}
+
+	// NOTE: Same size limits as loadFst().
+	if (bootBlock.fst_size > (1048576U >> offsetShift) ||
+	    bootBlock.fst_max_size > (1048576U >> offsetShift) ||
+	    bootBlock.fst_size > bootBlock.fst_max_size)
+	{
+		// FST is invalid.
+		q->m_lastError = EIO;
+		return -1;
+	}
+	const uint32_t fstData_len = bootBlock.fst_size << offsetShift;
+	const off64_t fst_offset = static_cast<off64_t>(bootBlock.fst_offset) << offsetShift;
+
+	// The root directory entry has the total number of entries.
+	GCN_FST_Entry root;
+	if (fstData_len < sizeof(root) ||
+	    q->pread(fst_offset, &root, sizeof(root)) != sizeof(root))
+	{
+		// Read error.
+		q->m_lastError = EIO;
+		return -1;
+	}
+	const uint32_t file_count = be32_to_cpu(root.root_dir.file_count);
+	if (file_count <= 1) {
+		// No files.
+		fstUsedSize = 0;
+		return fstUsedSize;
+	} else if (file_count > fstData_len / sizeof(GCN_FST_Entry)) {
+		// Too many entries.
+		q->m_lastError = EIO;
+		return -1;
+	}
+
+	// Read the rest of the entries.
+	// NOTE: file_count includes the root directory entry.
+	ao::uvector<GCN_FST_Entry> entries;
+	entries.resize(file_count - 1);
+	const size_t entries_len = entries.size() * sizeof(GCN_FST_Entry);
+	if (q->pread(fst_offset + sizeof(root), entries.data(), entries_len) != entries_len) {
+		// Short read.
+		q->m_lastError = EIO;
+		return -1;
+	}
+
+	off64_t total_size = 0;
+	for (auto iter = entries.cbegin(); iter != entries.cend(); ++iter) {
+		if ((be32_to_cpu(iter->file_type_name_offset) >> 24) == 1) {
+			// Directory.
+			continue;
+		}
+		total_size += static_cast<off64_t>(be32_to_cpu(iter->file.size));
+	}
+	fstUsedSize = total_size;
+	return fstUsedSize;
+}
+
 }
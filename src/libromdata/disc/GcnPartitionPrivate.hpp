@@ -71,6 +71,17 @@ class GcnPartitionPrivate
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
 		int loadFst(void);
+
+		// Total size of all files in the FST. (-1 == not loaded)
+		off64_t fstUsedSize;
+
+		/**
+		 * Get the total size of all files in the FST.
+		 * If the FST isn't loaded, only the FST entries are read.
+		 * The string table isn't needed, so it's skipped.
+		 * @return Total size of all files, or -1 on error.
+		 */
+		off64_t getFstUsedSize(void);
 };
 
 }
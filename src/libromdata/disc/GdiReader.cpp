@@ -475,6 +475,77 @@ off64_t GdiReader::getPhysBlockAddr(uint32_t blockIdx) const
 	return -1;
 }
 
+/**
+ * Hint that a range of the disc image will be read soon.
+ *
+ * GDI tracks are stored in separate files, so the range
+ * is forwarded to each track file that it overlaps.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int GdiReader::prefetch(off64_t pos, size_t size)
+{
+	RP_D(GdiReader);
+	if (d->disc_size <= 0 || d->block_size == 0) {
+		// Disc image wasn't initialized properly.
+		m_lastError = EBADF;
+		return -EBADF;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return -EINVAL;
+	}
+
+	if (pos >= d->disc_size || size == 0) {
+		// Nothing to prefetch.
+		return 0;
+	} else if (pos + static_cast<off64_t>(size) > d->disc_size) {
+		size = static_cast<size_t>(d->disc_size - pos);
+	}
+
+	const unsigned int blockStart = static_cast<unsigned int>(pos / d->block_size);
+	const unsigned int blockEnd = static_cast<unsigned int>((pos + size - 1) / d->block_size);
+
+	int ret = 0;
+	for (auto iter = d->blockRanges.cbegin(); iter != d->blockRanges.cend(); ++iter) {
+		// NOTE: Using volatile because it can change in d->openTrack().
+		const volatile GdiReaderPrivate::BlockRange *const vbr = &(*iter);
+		if (blockEnd < vbr->blockStart) {
+			// Not in this track.
+			continue;
+		}
+
+		// Is the track loaded?
+		if (vbr->blockEnd == 0) {
+			// Track isn't loaded. Load it.
+			if (d->openTrack(vbr->trackNumber) != 0) {
+				// Unable to load the track.
+				continue;
+			}
+		}
+		if (vbr->blockEnd == 0 || blockStart > vbr->blockEnd || !vbr->file) {
+			// Not in this track.
+			continue;
+		}
+
+		// Prefetch the overlapping sectors from the track file.
+		// NOTE: 2352-byte sectors are prefetched in full.
+		const unsigned int first = std::max(blockStart, static_cast<unsigned int>(vbr->blockStart));
+		const unsigned int last = std::min(blockEnd, static_cast<unsigned int>(vbr->blockEnd));
+		const off64_t phys_pos = static_cast<off64_t>(first - vbr->blockStart) * vbr->sectorSize;
+		const size_t phys_size = static_cast<size_t>(last - first + 1) * vbr->sectorSize;
+		IRpFile *const file = vbr->file;
+		const int tret = file->prefetch(phys_pos, phys_size);
+		if (tret != 0 && ret == 0) {
+			m_lastError = file->lastError();
+			ret = tret;
+		}
+	}
+
+	return ret;
+}
+
 /**
  * Read the specified block.
  *
@@ -560,7 +631,7 @@ int GdiReader::readBlock(uint32_t blockIdx, void *ptr, int pos, size_t size)
 		// Mode 1 data starts at byte 16; Mode 2 data starts at byte 24.
 		phys_pos += 16;
 	}
-	size_t sz_read = blockRange->file->seekAndRead(phys_pos, ptr, size);
+	size_t sz_read = blockRange->file->pread(phys_pos, ptr, size);
 	m_lastError = blockRange->file->lastError();
 	return (sz_read > 0 ? (int)sz_read : -1);
 }
@@ -53,6 +53,19 @@ class GdiReader : public LibRpBase::SparseDiscReader
 		 */
 		int isDiscSupported(const uint8_t *pHeader, size_t szHeader) const final;
 
+	public:
+		/**
+		 * Hint that a range of the disc image will be read soon.
+		 *
+		 * GDI tracks are stored in separate files, so the range
+		 * is forwarded to each track file that it overlaps.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+		 */
+		int prefetch(off64_t pos, size_t size) final;
+
 	protected:
 		/** SparseDiscReader functions. **/
 
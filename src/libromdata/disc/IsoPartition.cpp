@@ -85,7 +85,7 @@ IsoPartitionPrivate::IsoPartitionPrivate(IsoPartition *q,
 	// Load the primary volume descriptor.
 	// TODO: Assuming this is the first one.
 	// Check for multiple?
-	size_t size = q->m_discReader->seekAndRead(partition_offset + 0x8000, &pvd, sizeof(pvd));
+	size_t size = q->m_discReader->pread(partition_offset + 0x8000, &pvd, sizeof(pvd));
 	if (size != sizeof(pvd)) {
 		// Seek and/or read error.
 		q->m_discReader = nullptr;
@@ -168,7 +168,7 @@ int IsoPartitionPrivate::loadRootDirectory(void)
 	rootDir_data.resize(rootdir->size.he);
 	const off64_t rootDir_addr = partition_offset +
 		static_cast<off64_t>(rootdir->block.he - iso_start_offset) * block_size;
-	size_t size = q->m_discReader->seekAndRead(rootDir_addr, rootDir_data.data(), rootDir_data.size());
+	size_t size = q->m_discReader->pread(rootDir_addr, rootDir_data.data(), rootDir_data.size());
 	if (size != rootDir_data.size()) {
 		// Seek and/or read error.
 		rootDir_data.clear();
@@ -379,9 +379,9 @@ size_t NCCHReaderPrivate::readFromROM(uint32_t offset, void *ptr, size_t size)
 	const off64_t phys_addr = ncch_offset + offset;
 	size_t sz_read;
 	if (q->m_hasDiscReader) {
-		sz_read = q->m_discReader->seekAndRead(phys_addr, ptr, size);
+		sz_read = q->m_discReader->pread(phys_addr, ptr, size);
 	} else {
-		sz_read = q->m_file->seekAndRead(phys_addr, ptr, size);
+		sz_read = q->m_file->pread(phys_addr, ptr, size);
 	}
 	if (sz_read != size) {
 		// Seek and/or read error.
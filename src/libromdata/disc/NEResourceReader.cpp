@@ -57,24 +57,33 @@ class NEResourceReaderPrivate
 		/**
 		 * Read the section header in an NE version resource.
 		 *
-		 * The file pointer will be advanced past the header.
+		 * The position will be advanced past the header.
 		 *
-		 * @param file		[in] PE version resource.
+		 * @param verData	[in] NE version resource.
+		 * @param verSize	[in] Size of verData.
+		 * @param pPos		[in/out] Position in verData.
 		 * @param key		[in] Expected header name.
 		 * @param pChildLen	[out,opt] Total length of the section.
 		 * @param pValueLen	[out,opt] Value length.
 		 * @return 0 if the header matches; non-zero on error.
 		 */
-		static int load_VS_VERSION_INFO_header(IRpFile *file, const char *key, uint16_t *pLen, uint16_t *pValueLen);
+		static int load_VS_VERSION_INFO_header(const uint8_t *verData, uint32_t verSize, uint32_t *pPos,
+			const char *key, uint16_t *pLen, uint16_t *pValueLen);
 
 		/**
 		 * Load a string table.
-		 * @param file		[in] PE version resource.
+		 *
+		 * The position will be advanced past the string table.
+		 *
+		 * @param verData	[in] NE version resource.
+		 * @param verSize	[in] Size of verData.
+		 * @param pPos		[in/out] Position in verData.
 		 * @param st		[out] String Table.
 		 * @param langID	[out] Language ID.
 		 * @return 0 on success; non-zero on error.
 		 */
-		static int load_StringTable(IRpFile *file, IResourceReader::StringTable &st, uint32_t *langID);
+		static int load_StringTable(const uint8_t *verData, uint32_t verSize, uint32_t *pPos,
+			IResourceReader::StringTable &st, uint32_t *langID);
 };
 
 /** NEResourceReaderPrivate **/
@@ -168,7 +177,7 @@ int NEResourceReaderPrivate::loadResTbl(void)
 
 	// Load the resource table.
 	unique_ptr<uint8_t[]> rsrcTblData(new uint8_t[rsrc_tbl_size]);
-	size_t size = q->m_file->seekAndRead(rsrc_tbl_addr, rsrcTblData.get(), rsrc_tbl_size);
+	size_t size = q->m_file->pread(rsrc_tbl_addr, rsrcTblData.get(), rsrc_tbl_size);
 	if (size != rsrc_tbl_size) {
 		// Seek and/or read error.
 		q->m_lastError = q->m_file->lastError();
@@ -275,23 +284,28 @@ int NEResourceReaderPrivate::loadResTbl(void)
 /**
  * Read the section header in an NE version resource.
  *
- * The file pointer will be advanced past the header.
+ * The position will be advanced past the header.
  *
- * @param file		[in] PE version resource.
+ * @param verData	[in] NE version resource.
+ * @param verSize	[in] Size of verData.
+ * @param pPos		[in/out] Position in verData.
  * @param key		[in] Expected header name.
  * @param pChildLen	[out,opt] Total length of the section.
  * @param pValueLen	[out,opt] Value length.
  * @return 0 if the header matches; non-zero on error.
  */
-int NEResourceReaderPrivate::load_VS_VERSION_INFO_header(IRpFile *file, const char *key, uint16_t *pLen, uint16_t *pValueLen)
+int NEResourceReaderPrivate::load_VS_VERSION_INFO_header(const uint8_t *verData, uint32_t verSize, uint32_t *pPos,
+	const char *key, uint16_t *pLen, uint16_t *pValueLen)
 {
 	// Read fields.
+	uint32_t pos = *pPos;
 	uint16_t fields[2];	// wLength, wValueLength
-	size_t size = file->read(fields, sizeof(fields));
-	if (size != sizeof(fields)) {
-		// Read error.
+	if (pos > verSize || verSize - pos < sizeof(fields)) {
+		// Out of range.
 		return -EIO;
 	}
+	memcpy(fields, &verData[pos], sizeof(fields));
+	pos += sizeof(fields);
 
 	// Check the key name.
 	// NOTE: NE uses SBCS/MBCS/DBCS, so the length is in bytes.
@@ -300,15 +314,14 @@ int NEResourceReaderPrivate::load_VS_VERSION_INFO_header(IRpFile *file, const ch
 	// NOTE: sizeof(fields) == 4, so it's already WORD-aligned.
 	unsigned int keyData_len = key_len + 1;
 	keyData_len = ALIGN_BYTES(4, keyData_len);
-	unique_ptr<char[]> keyData(new char[keyData_len]);
-	size = file->read(keyData.get(), keyData_len);
-	if (size != keyData_len) {
-		// Read error.
+	if (verSize - pos < keyData_len) {
+		// Out of range.
 		return -EIO;
 	}
 
 	// Verify that the strings are equal.
-	if (strncmp(keyData.get(), key, key_len) != 0) {
+	const char *const keyData = reinterpret_cast<const char*>(&verData[pos]);
+	if (strncmp(keyData, key, key_len) != 0) {
 		// Key mismatch.
 		return -EIO;
 	}
@@ -318,6 +331,7 @@ int NEResourceReaderPrivate::load_VS_VERSION_INFO_header(IRpFile *file, const ch
 	}
 
 	// Header read successfully.
+	*pPos = pos + keyData_len;
 	*pLen = le16_to_cpu(fields[0]);
 	*pValueLen = le16_to_cpu(fields[1]);
 	return 0;
@@ -325,12 +339,18 @@ int NEResourceReaderPrivate::load_VS_VERSION_INFO_header(IRpFile *file, const ch
 
 /**
  * Load a string table.
- * @param file		[in] PE version resource.
+ *
+ * The position will be advanced past the string table.
+ *
+ * @param verData	[in] NE version resource.
+ * @param verSize	[in] Size of verData.
+ * @param pPos		[in/out] Position in verData.
  * @param st		[out] String Table.
  * @param langID	[out] Language ID.
  * @return 0 on success; non-zero on error.
  */
-int NEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::StringTable &st, uint32_t *langID)
+int NEResourceReaderPrivate::load_StringTable(const uint8_t *verData, uint32_t verSize, uint32_t *pPos,
+	IResourceReader::StringTable &st, uint32_t *langID)
 {
 	// References:
 	// - String: https://msdn.microsoft.com/en-us/library/windows/desktop/ms646987(v=vs.85).aspx
@@ -341,13 +361,14 @@ int NEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::St
 	// Reference: https://blogs.msdn.microsoft.com/oldnewthing/20061220-15/?p=28653
 
 	// Read fields.
-	const off64_t pos_start = file->tell();
+	const uint32_t pos_start = *pPos;
 	uint16_t fields[2];	// wLength, wValueLength
-	size_t size = file->read(fields, sizeof(fields));
-	if (size != sizeof(fields)) {
-		// Read error.
+	char s_langID[9];
+	if (pos_start > verSize || verSize - pos_start < sizeof(fields) + sizeof(s_langID)) {
+		// Out of range.
 		return -EIO;
 	}
+	memcpy(fields, &verData[pos_start], sizeof(fields));
 
 	// wLength contains the total string table length.
 	// wValueLength should be 0.
@@ -360,10 +381,9 @@ int NEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::St
 	// Format: 040904E4
 	// - 0409: Language (US English)
 	// - 04E4: Code page (1252)
-	char s_langID[9];
-	size = file->read(s_langID, sizeof(s_langID));
-	if (size != sizeof(s_langID) || s_langID[8] != 0) {
-		// Read error, or not NULL terminated.
+	memcpy(s_langID, &verData[pos_start + sizeof(fields)], sizeof(s_langID));
+	if (s_langID[8] != 0) {
+		// Not NULL terminated.
 		return -EIO;
 	}
 
@@ -385,30 +405,27 @@ int NEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::St
 	}
 
 	// DWORD alignment.
-	IResourceReader::alignFileDWORD(file);
+	const uint32_t pos_strings = ALIGN_BYTES(4, pos_start + sizeof(fields) + sizeof(s_langID));
 
 	// Total string table size (in bytes) is wLength - (pos_strings - pos_start).
-	const off64_t pos_strings = file->tell();
-	int strTblData_len = static_cast<int>(fields[0]) - static_cast<int>(pos_strings - pos_start);
-	if (strTblData_len <= 0) {
+	const int strTblData_len = static_cast<int>(le16_to_cpu(fields[0])) - static_cast<int>(pos_strings - pos_start);
+	if (strTblData_len <= 0 || pos_strings > verSize ||
+	    static_cast<uint32_t>(strTblData_len) > verSize - pos_strings)
+	{
 		// Error...
 		return -EIO;
 	}
-
-	// Read the string table.
-	unique_ptr<uint8_t[]> strTblData(new uint8_t[strTblData_len]);
-	size = file->read(strTblData.get(), strTblData_len);
-	if (size != static_cast<size_t>(strTblData_len)) {
-		// Read error.
-		return -EIO;
-	}
+	const uint8_t *const strTblData = &verData[pos_strings];
 
 	// Parse the string table.
-	// TODO: Optimizations.
 	st.clear();
 	int tblPos = 0;
 	while (tblPos < strTblData_len) {
 		// wLength, wValueLength
+		if (strTblData_len - tblPos < static_cast<int>(sizeof(fields))) {
+			// Not enough space for the fields.
+			return -EIO;
+		}
 		memcpy(fields, &strTblData[tblPos], sizeof(fields));
 
 		// TODO: Use fields[] directly?
@@ -440,6 +457,10 @@ int NEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::St
 		// DWORD alignment is required here.
 		tblPos += (key_len + 1);
 		tblPos  = ALIGN_BYTES(4, tblPos);
+		if (wValueLength > strTblData_len - tblPos) {
+			// Value is out of range.
+			return -EIO;
+		}
 
 		// Value must be NULL-terminated.
 		const char *value = reinterpret_cast<const char*>(&strTblData[tblPos]);
@@ -482,6 +503,7 @@ int NEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::St
 	}
 
 	// String table loaded successfully.
+	*pPos = ALIGN_BYTES(4, pos_strings + strTblData_len);
 	return 0;
 }
 
@@ -706,10 +728,27 @@ int NEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 		return -ENOENT;
 	}
 
+	// Load the entire VS_VERSION_INFO resource.
+	// NOTE: wLength is 16-bit, so the resource can't be larger than 64 KB.
+	const off64_t verSize_o64 = f_ver->size();
+	if (verSize_o64 <= 0) {
+		// Empty resource.
+		return -EIO;
+	}
+	const uint32_t verSize = static_cast<uint32_t>(std::min(verSize_o64, static_cast<off64_t>(65536)));
+	unique_ptr<uint8_t[]> verData(new uint8_t[verSize]);
+	size_t size = f_ver->read(verData.get(), verSize);
+	if (size != verSize) {
+		// Read error.
+		return -EIO;
+	}
+
 	// Read the version header.
 	static const char vsvi[] = "VS_VERSION_INFO";
+	uint32_t pos = 0;
 	uint16_t len, valueLen;
-	int ret = NEResourceReaderPrivate::load_VS_VERSION_INFO_header(f_ver.get(), vsvi, &len, &valueLen);
+	int ret = NEResourceReaderPrivate::load_VS_VERSION_INFO_header(
+		verData.get(), verSize, &pos, vsvi, &len, &valueLen);
 	if (ret != 0) {
 		// Header is incorrect.
 		return ret;
@@ -717,17 +756,14 @@ int NEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 
 	// Verify the value size.
 	// (Value should be VS_FIXEDFILEINFO.)
-	if (valueLen != sizeof(*pVsFfi)) {
+	if (valueLen != sizeof(*pVsFfi) || verSize - pos < sizeof(*pVsFfi)) {
 		// Wrong size.
 		return -EIO;
 	}
 
 	// Read the version information.
-	size_t size = f_ver->read(pVsFfi, sizeof(*pVsFfi));
-	if (size != sizeof(*pVsFfi)) {
-		// Read error.
-		return -EIO;
-	}
+	memcpy(pVsFfi, &verData[pos], sizeof(*pVsFfi));
+	pos += sizeof(*pVsFfi);
 
 	// Verify the signature and structure version.
 	pVsFfi->dwSignature	= le32_to_cpu(pVsFfi->dwSignature);
@@ -756,11 +792,12 @@ int NEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 #endif /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
 
 	// DWORD alignment, if necessary.
-	alignFileDWORD(f_ver.get());
+	pos = ALIGN_BYTES(4, pos);
 
 	// Read the StringFileInfo section header.
 	static const char vssfi[] = "StringFileInfo";
-	ret = NEResourceReaderPrivate::load_VS_VERSION_INFO_header(f_ver.get(), vssfi, &len, &valueLen);
+	ret = NEResourceReaderPrivate::load_VS_VERSION_INFO_header(
+		verData.get(), verSize, &pos, vssfi, &len, &valueLen);
 	if (ret != 0) {
 		// No StringFileInfo section.
 		return 0;
@@ -772,7 +809,7 @@ int NEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 	// in order to read VarFileInfo.
 	StringTable st;
 	uint32_t langID;
-	ret = NEResourceReaderPrivate::load_StringTable(f_ver.get(), st, &langID);
+	ret = NEResourceReaderPrivate::load_StringTable(verData.get(), verSize, &pos, st, &langID);
 	if (ret == 0) {
 		// String table read successfully.
 		pVsSfi->insert(std::make_pair(langID, std::move(st)));
@@ -42,6 +42,13 @@ class PEResourceReaderPrivate
 		uint32_t rsrc_size;
 		uint32_t rsrc_va;
 
+		// In-memory copy of the .rsrc section.
+		// Only the first RSRC_DATA_MAX bytes are loaded.
+		// Resource directories and version resources are
+		// usually located at the start of the section.
+		static const uint32_t RSRC_DATA_MAX = 256U*1024U;
+		ao::uvector<uint8_t> rsrc_data;
+
 		// Read position.
 		off64_t pos;
 
@@ -54,6 +61,17 @@ class PEResourceReaderPrivate
 		};
 		typedef ao::uvector<ResDirEntry> rsrc_dir_t;
 
+		/**
+		 * Read data from the .rsrc section.
+		 * If the data is within the in-memory copy of .rsrc,
+		 * it will be copied from there instead of from the file.
+		 * @param addr	[in] Starting address. (relative to the start of .rsrc)
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t readRsrc(uint32_t addr, void *ptr, size_t size);
+
 		// Resource types. (Top-level directory.)
 		rsrc_dir_t res_types;
 
@@ -97,25 +115,34 @@ class PEResourceReaderPrivate
 		/**
 		 * Read the section header in a PE version resource.
 		 *
-		 * The file pointer will be advanced past the header.
+		 * The position will be advanced past the header.
 		 *
-		 * @param file		[in] PE version resource.
+		 * @param verData	[in] PE version resource.
+		 * @param verSize	[in] Size of verData.
+		 * @param pPos		[in/out] Position in verData.
 		 * @param key		[in] Expected header name.
 		 * @param type		[in] Expected data type. (0 == binary, 1 == text)
 		 * @param pChildLen	[out,opt] Total length of the section.
 		 * @param pValueLen	[out,opt] Value length.
 		 * @return 0 if the header matches; non-zero on error.
 		 */
-		static int load_VS_VERSION_INFO_header(IRpFile *file, const char16_t *key, uint16_t type, uint16_t *pLen, uint16_t *pValueLen);
+		static int load_VS_VERSION_INFO_header(const uint8_t *verData, uint32_t verSize, uint32_t *pPos,
+			const char16_t *key, uint16_t type, uint16_t *pLen, uint16_t *pValueLen);
 
 		/**
 		 * Load a string table.
-		 * @param file		[in] PE version resource.
+		 *
+		 * The position will be advanced past the string table.
+		 *
+		 * @param verData	[in] PE version resource.
+		 * @param verSize	[in] Size of verData.
+		 * @param pPos		[in/out] Position in verData.
 		 * @param st		[out] String Table.
 		 * @param langID	[out] Language ID.
 		 * @return 0 on success; non-zero on error.
 		 */
-		static int load_StringTable(IRpFile *file, IResourceReader::StringTable &st, uint32_t *langID);
+		static int load_StringTable(const uint8_t *verData, uint32_t verSize, uint32_t *pPos,
+			IResourceReader::StringTable &st, uint32_t *langID);
 };
 
 /** PEResourceReaderPrivate **/
@@ -164,6 +191,18 @@ PEResourceReaderPrivate::PEResourceReaderPrivate(
 		return;
 	}
 
+	// Load the start of the .rsrc section.
+	// Directories and data entries will be parsed from memory.
+	// NOTE: A short read isn't fatal. Anything that wasn't
+	// loaded will be read from the file by readRsrc().
+	uint32_t rsrc_data_size = std::min(rsrc_size, static_cast<uint32_t>(RSRC_DATA_MAX));
+	rsrc_data_size = std::min(rsrc_data_size, fileSize - rsrc_addr);
+	rsrc_data.resize(rsrc_data_size);
+	size_t size = q->m_file->pread(rsrc_addr, rsrc_data.data(), rsrc_data_size);
+	if (size != rsrc_data_size) {
+		rsrc_data.resize(size);
+	}
+
 	// Load the root resource directory.
 	int ret = loadResDir(0, res_types);
 	if (ret <= 0) {
@@ -173,6 +212,28 @@ PEResourceReaderPrivate::PEResourceReaderPrivate(
 	}
 }
 
+/**
+ * Read data from the .rsrc section.
+ * If the data is within the in-memory copy of .rsrc,
+ * it will be copied from there instead of from the file.
+ * @param addr	[in] Starting address. (relative to the start of .rsrc)
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t PEResourceReaderPrivate::readRsrc(uint32_t addr, void *ptr, size_t size)
+{
+	if (addr < rsrc_data.size() && size <= rsrc_data.size() - addr) {
+		// Data is in memory.
+		memcpy(ptr, &rsrc_data[addr], size);
+		return size;
+	}
+
+	// Data is not in memory. Read it from the file.
+	RP_Q(PEResourceReader);
+	return q->m_file->pread(static_cast<off64_t>(rsrc_addr) + addr, ptr, size);
+}
+
 /**
  * Load a resource directory.
  *
@@ -188,7 +249,7 @@ int PEResourceReaderPrivate::loadResDir(uint32_t addr, rsrc_dir_t &dir)
 	RP_Q(PEResourceReader);
 
 	IMAGE_RESOURCE_DIRECTORY root;
-	size_t size = q->m_file->seekAndRead(rsrc_addr + addr, &root, sizeof(root));
+	size_t size = readRsrc(addr, &root, sizeof(root));
 	if (size != sizeof(root)) {
 		// Seek and/or read error.
 		q->m_lastError = q->m_file->lastError();
@@ -204,7 +265,7 @@ int PEResourceReaderPrivate::loadResDir(uint32_t addr, rsrc_dir_t &dir)
 	}
 	uint32_t szToRead = static_cast<uint32_t>(entryCount * sizeof(IMAGE_RESOURCE_DIRECTORY_ENTRY));
 	unique_ptr<IMAGE_RESOURCE_DIRECTORY_ENTRY[]> irdEntries(new IMAGE_RESOURCE_DIRECTORY_ENTRY[entryCount]);
-	size = q->m_file->read(irdEntries.get(), szToRead);
+	size = readRsrc(addr + sizeof(root), irdEntries.get(), szToRead);
 	if (size != szToRead) {
 		// Read error.
 		q->m_lastError = q->m_file->lastError();
@@ -343,24 +404,29 @@ const PEResourceReaderPrivate::rsrc_dir_t *PEResourceReaderPrivate::getTypeIdDir
 /**
  * Read the section header in a PE version resource.
  *
- * The file pointer will be advanced past the header.
+ * The position will be advanced past the header.
  *
- * @param file		[in] PE version resource.
+ * @param verData	[in] PE version resource.
+ * @param verSize	[in] Size of verData.
+ * @param pPos		[in/out] Position in verData.
  * @param key		[in] Expected header name.
  * @param type		[in] Expected data type. (0 == binary, 1 == text)
  * @param pChildLen	[out] Total length of the section.
  * @param pValueLen	[out] Value length.
  * @return 0 if the header matches; non-zero on error.
  */
-int PEResourceReaderPrivate::load_VS_VERSION_INFO_header(IRpFile *file, const char16_t *key, uint16_t type, uint16_t *pLen, uint16_t *pValueLen)
+int PEResourceReaderPrivate::load_VS_VERSION_INFO_header(const uint8_t *verData, uint32_t verSize, uint32_t *pPos,
+	const char16_t *key, uint16_t type, uint16_t *pLen, uint16_t *pValueLen)
 {
 	// Read fields.
+	uint32_t pos = *pPos;
 	uint16_t fields[3];	// wLength, wValueLength, wType
-	size_t size = file->read(fields, sizeof(fields));
-	if (size != sizeof(fields)) {
-		// Read error.
+	if (pos > verSize || verSize - pos < sizeof(fields)) {
+		// Out of range.
 		return -EIO;
 	}
+	memcpy(fields, &verData[pos], sizeof(fields));
+	pos += sizeof(fields);
 
 	// Validate the data type.
 	assert(type == 0 || type == 1);
@@ -370,21 +436,19 @@ int PEResourceReaderPrivate::load_VS_VERSION_INFO_header(IRpFile *file, const ch
 	}
 
 	// Check the key name.
-	unsigned int key_len = static_cast<unsigned int>(u16_strlen(key));
+	const unsigned int key_len = static_cast<unsigned int>(u16_strlen(key));
 	// DWORD alignment: Make sure we end on a multiple of 4 bytes.
 	unsigned int keyData_len = (key_len+1) * sizeof(char16_t);
 	keyData_len = ALIGN_BYTES(4, keyData_len + sizeof(fields)) - sizeof(fields);
-	unique_ptr<char16_t[]> keyData(new char16_t[keyData_len/sizeof(char16_t)]);
-	size = file->read(keyData.get(), keyData_len);
-	if (size != keyData_len) {
-		// Read error.
+	if (verSize - pos < keyData_len) {
+		// Out of range.
 		return -EIO;
 	}
 
 	// Verify that the strings are equal.
 	// NOTE: Win32 is always UTF-16LE, so we have to
 	// adjust for endianness.
-	const char16_t *pKeyData = keyData.get();
+	const char16_t *pKeyData = reinterpret_cast<const char16_t*>(&verData[pos]);
 	for (unsigned int i = key_len; i > 0; i--, pKeyData++, key++) {
 		if (le16_to_cpu(*pKeyData) != *key) {
 			// Key mismatch.
@@ -397,6 +461,7 @@ int PEResourceReaderPrivate::load_VS_VERSION_INFO_header(IRpFile *file, const ch
 	}
 
 	// Header read successfully.
+	*pPos = pos + keyData_len;
 	*pLen = le16_to_cpu(fields[0]);
 	*pValueLen = le16_to_cpu(fields[1]);
 	return 0;
@@ -404,25 +469,32 @@ int PEResourceReaderPrivate::load_VS_VERSION_INFO_header(IRpFile *file, const ch
 
 /**
  * Load a string table.
- * @param file		[in] PE version resource.
+ *
+ * The position will be advanced past the string table.
+ *
+ * @param verData	[in] PE version resource.
+ * @param verSize	[in] Size of verData.
+ * @param pPos		[in/out] Position in verData.
  * @param st		[out] String Table.
  * @param langID	[out] Language ID.
  * @return 0 on success; non-zero on error.
  */
-int PEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::StringTable &st, uint32_t *langID)
+int PEResourceReaderPrivate::load_StringTable(const uint8_t *verData, uint32_t verSize, uint32_t *pPos,
+	IResourceReader::StringTable &st, uint32_t *langID)
 {
 	// References:
 	// - String: https://msdn.microsoft.com/en-us/library/windows/desktop/ms646987(v=vs.85).aspx
 	// - StringTable: https://msdn.microsoft.com/en-us/library/windows/desktop/ms646992(v=vs.85).aspx
 
 	// Read fields.
-	const off64_t pos_start = file->tell();
+	const uint32_t pos_start = *pPos;
 	uint16_t fields[3];	// wLength, wValueLength, wType
-	size_t size = file->read(fields, sizeof(fields));
-	if (size != sizeof(fields)) {
-		// Read error.
+	char16_t s_langID[9];
+	if (pos_start > verSize || verSize - pos_start < sizeof(fields) + sizeof(s_langID)) {
+		// Out of range.
 		return -EIO;
 	}
+	memcpy(fields, &verData[pos_start], sizeof(fields));
 
 	// wLength contains the total string table length.
 	// wValueLength should be 0.
@@ -433,12 +505,9 @@ int PEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::St
 	}
 
 	// Read the 8-character language ID.
-	char16_t s_langID[9];
-	size = file->read(s_langID, sizeof(s_langID));
-	if (size != sizeof(s_langID) ||
-	   (s_langID[8] != cpu_to_le16(0)))
-	{
-		// Read error, or not NULL terminated.
+	memcpy(s_langID, &verData[pos_start + sizeof(fields)], sizeof(s_langID));
+	if (s_langID[8] != cpu_to_le16(0)) {
+		// Not NULL terminated.
 		return -EIO;
 	}
 
@@ -453,32 +522,27 @@ int PEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::St
 		return -EIO;
 	}
 	// DWORD alignment.
-	IResourceReader::alignFileDWORD(file);
+	const uint32_t pos_strings = ALIGN_BYTES(4, pos_start + sizeof(fields) + sizeof(s_langID));
 
 	// Total string table size (in bytes) is wLength - (pos_strings - pos_start).
-	const off64_t pos_strings = file->tell();
-	int strTblData_len = static_cast<int>(fields[0]) - static_cast<int>(pos_strings - pos_start);
-	if (strTblData_len <= 0) {
+	const int strTblData_len = static_cast<int>(le16_to_cpu(fields[0])) - static_cast<int>(pos_strings - pos_start);
+	if (strTblData_len <= 0 || pos_strings > verSize ||
+	    static_cast<uint32_t>(strTblData_len) > verSize - pos_strings)
+	{
 		// Error...
 		return -EIO;
 	}
-
-	// Read the string table.
-	unique_ptr<uint8_t[]> strTblData(new uint8_t[strTblData_len]);
-	size = file->read(strTblData.get(), strTblData_len);
-	if (size != static_cast<size_t>(strTblData_len)) {
-		// Read error.
-		return -EIO;
-	}
-	// DWORD alignment.
-	IResourceReader::alignFileDWORD(file);
+	const uint8_t *const strTblData = &verData[pos_strings];
 
 	// Parse the string table.
-	// TODO: Optimizations.
 	st.clear();
 	int tblPos = 0;
 	while (tblPos < strTblData_len) {
 		// wLength, wValueLength, wType
+		if (strTblData_len - tblPos < static_cast<int>(sizeof(fields))) {
+			// Not enough space for the fields.
+			return -EIO;
+		}
 		memcpy(fields, &strTblData[tblPos], sizeof(fields));
 		if (fields[2] != cpu_to_le16(1)) {
 			// Not a string...
@@ -515,6 +579,10 @@ int PEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::St
 		// DWORD alignment is required here.
 		tblPos += ((key_len + 1) * 2);
 		tblPos  = ALIGN_BYTES(4, tblPos);
+		if (wValueLength > strTblData_len - tblPos) {
+			// Value is out of range.
+			return -EIO;
+		}
 
 		// Value must be NULL-terminated.
 		const char16_t *value = reinterpret_cast<const char16_t*>(&strTblData[tblPos]);
@@ -540,6 +608,7 @@ int PEResourceReaderPrivate::load_StringTable(IRpFile *file, IResourceReader::St
 	}
 
 	// String table loaded successfully.
+	*pPos = ALIGN_BYTES(4, pos_strings + strTblData_len);
 	return 0;
 }
 
@@ -597,7 +666,7 @@ size_t PEResourceReader::read(void *ptr, size_t size)
 	}
 
 	// Read the data.
-	size_t read = m_file->seekAndRead(static_cast<off64_t>(d->rsrc_addr) + static_cast<off64_t>(d->pos), ptr, size);
+	size_t read = d->readRsrc(static_cast<uint32_t>(d->pos), ptr, size);
 	if (read != size) {
 		// Seek and/or read error.
 		m_lastError = m_file->lastError();
@@ -748,7 +817,7 @@ IRpFile *PEResourceReader::open(uint16_t type, int id, int lang)
 
 	// Get the IMAGE_RESOURCE_DATA_ENTRY.
 	IMAGE_RESOURCE_DATA_ENTRY irdata;
-	size_t size = m_file->seekAndRead(d->rsrc_addr + dirEntry->addr, &irdata, sizeof(irdata));
+	size_t size = d->readRsrc(dirEntry->addr, &irdata, sizeof(irdata));
 	if (size != sizeof(irdata)) {
 		// Seek and/or read error.
 		m_lastError = m_file->lastError();
@@ -792,10 +861,27 @@ int PEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 		return -ENOENT;
 	}
 
+	// Load the entire VS_VERSION_INFO resource.
+	// NOTE: wLength is 16-bit, so the resource can't be larger than 64 KB.
+	const off64_t verSize_o64 = f_ver->size();
+	if (verSize_o64 <= 0) {
+		// Empty resource.
+		return -EIO;
+	}
+	const uint32_t verSize = static_cast<uint32_t>(std::min(verSize_o64, static_cast<off64_t>(65536)));
+	unique_ptr<uint8_t[]> verData(new uint8_t[verSize]);
+	size_t size = f_ver->read(verData.get(), verSize);
+	if (size != verSize) {
+		// Read error.
+		return -EIO;
+	}
+
 	// Read the version header.
 	static const char16_t vsvi[] = {'V','S','_','V','E','R','S','I','O','N','_','I','N','F','O',0};
+	uint32_t pos = 0;
 	uint16_t len, valueLen;
-	int ret = PEResourceReaderPrivate::load_VS_VERSION_INFO_header(f_ver.get(), vsvi, 0, &len, &valueLen);
+	int ret = PEResourceReaderPrivate::load_VS_VERSION_INFO_header(
+		verData.get(), verSize, &pos, vsvi, 0, &len, &valueLen);
 	if (ret != 0) {
 		// Header is incorrect.
 		return ret;
@@ -803,17 +889,14 @@ int PEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 
 	// Verify the value size.
 	// (Value should be VS_FIXEDFILEINFO.)
-	if (valueLen != sizeof(*pVsFfi)) {
+	if (valueLen != sizeof(*pVsFfi) || verSize - pos < sizeof(*pVsFfi)) {
 		// Wrong size.
 		return -EIO;
 	}
 
 	// Read the version information.
-	size_t size = f_ver->read(pVsFfi, sizeof(*pVsFfi));
-	if (size != sizeof(*pVsFfi)) {
-		// Read error.
-		return -EIO;
-	}
+	memcpy(pVsFfi, &verData[pos], sizeof(*pVsFfi));
+	pos += sizeof(*pVsFfi);
 
 	// Verify the signature and structure version.
 	pVsFfi->dwSignature	= le32_to_cpu(pVsFfi->dwSignature);
@@ -842,11 +925,12 @@ int PEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 #endif /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
 
 	// DWORD alignment, if necessary.
-	alignFileDWORD(f_ver.get());
+	pos = ALIGN_BYTES(4, pos);
 
 	// Read the StringFileInfo section header.
 	static const char16_t vssfi[] = {'S','t','r','i','n','g','F','i','l','e','I','n','f','o',0};
-	ret = PEResourceReaderPrivate::load_VS_VERSION_INFO_header(f_ver.get(), vssfi, 1, &len, &valueLen);
+	ret = PEResourceReaderPrivate::load_VS_VERSION_INFO_header(
+		verData.get(), verSize, &pos, vssfi, 1, &len, &valueLen);
 	if (ret != 0) {
 		// No StringFileInfo section.
 		return 0;
@@ -858,7 +942,7 @@ int PEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 	// in order to read VarFileInfo.
 	StringTable st;
 	uint32_t langID;
-	ret = PEResourceReaderPrivate::load_StringTable(f_ver.get(), st, &langID);
+	ret = PEResourceReaderPrivate::load_StringTable(verData.get(), verSize, &pos, st, &langID);
 	if (ret == 0) {
 		// String table read successfully.
 		pVsSfi->insert(std::make_pair(langID, std::move(st)));
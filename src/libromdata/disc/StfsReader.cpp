@@ -0,0 +1,550 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * StfsReader.cpp: Microsoft Xbox 360 STFS file reader.                    *
+ *                                                                         *
+ * Copyright (c) 2026 by David Korth.                                      *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "StfsReader.hpp"
+
+// librpfile
+using LibRpFile::IRpFile;
+
+// C++ STL classes.
+using std::unordered_map;
+
+namespace LibRomData {
+
+class StfsReaderPrivate
+{
+	public:
+		StfsReaderPrivate(StfsReader *q, const STFS_Package_Metadata *metadata, bool isCON,
+			uint32_t blockNumber, uint32_t blockCount, uint32_t fileSize, bool consecutive);
+
+	private:
+		RP_DISABLE_COPY(StfsReaderPrivate)
+	protected:
+		StfsReader *const q_ptr;
+
+	public:
+		// Package geometry.
+		// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
+		uint32_t firstHashTableAddr;	// Start of the block area.
+		uint8_t blockShift;		// 1 if hash tables have two copies; 0 if not.
+		uint8_t topLevel;		// Top hash table level. (0-2)
+		uint8_t topTableCopy;		// Top hash table copy. (0 or 1)
+		uint32_t blockStep[2];		// Blocks covered by level 0 and level 1 tables, including hashes.
+
+		// File.
+		uint32_t blockNumber;		// First data block number.
+		uint32_t blockCount;		// Number of data blocks.
+		uint32_t fileSize;		// File size.
+		bool consecutive;		// True if the blocks are consecutive.
+		off64_t pos;			// Current position.
+
+		// Data block numbers for the file's blocks, if not consecutive.
+		// Loaded from the hash chain as needed.
+		ao::uvector<uint32_t> dataBlocks;
+
+		// Hash table cache.
+		// Key: Physical address of the hash table.
+		// NOTE: Each level 0 table covers 680 KB of data,
+		// so the cache is cleared if it gets too large.
+		static const size_t HASH_CACHE_MAX = 32;
+		unordered_map<uint32_t, ao::uvector<uint8_t> > hashCache;
+
+	public:
+		/**
+		 * Convert a data block number to a physical address.
+		 * Data block numbers don't include hash blocks.
+		 * @param dataBlockNumber Data block number.
+		 * @return Physical address, or -1 on error.
+		 */
+		off64_t dataBlockToPhysAddr(uint32_t dataBlockNumber) const;
+
+		/**
+		 * Get the physical block number of a hash table.
+		 * @param dataBlockNumber Data block number covered by the table.
+		 * @param level Hash table level. (0-2)
+		 * @return Physical block number, relative to firstHashTableAddr.
+		 */
+		uint32_t hashTableBlockNumber(uint32_t dataBlockNumber, int level) const;
+
+		/**
+		 * Get a hash table.
+		 * The table is loaded from the file if it isn't cached.
+		 * @param addr Physical address.
+		 * @return Hash table, or nullptr on error.
+		 */
+		const STFS_Hash_Entry *getHashTable(uint32_t addr);
+
+		/**
+		 * Get the level 0 hash entry for a data block.
+		 * Higher-level tables are used to select the active
+		 * copy of each table if the package has two copies.
+		 * @param dataBlockNumber Data block number.
+		 * @return Hash entry, or nullptr on error.
+		 */
+		const STFS_Hash_Entry *getHashEntry(uint32_t dataBlockNumber);
+
+		/**
+		 * Get the data block number for a block in the file.
+		 * @param idx Block index within the file.
+		 * @return Data block number, or STFS_HASH_CHAIN_END on error.
+		 */
+		uint32_t fileBlockToDataBlock(uint32_t idx);
+};
+
+/** StfsReaderPrivate **/
+
+StfsReaderPrivate::StfsReaderPrivate(StfsReader *q,
+	const STFS_Package_Metadata *metadata, bool isCON,
+	uint32_t blockNumber, uint32_t blockCount, uint32_t fileSize, bool consecutive)
+	: q_ptr(q)
+	, firstHashTableAddr(0)
+	, blockShift(0)
+	, topLevel(0)
+	, topTableCopy(0)
+	, blockNumber(blockNumber)
+	, blockCount(blockCount)
+	, fileSize(fileSize)
+	, consecutive(consecutive)
+	, pos(0)
+{
+	blockStep[0] = 0;
+	blockStep[1] = 0;
+
+	assert(q->m_file != nullptr);
+	assert(metadata != nullptr);
+	if (!q->m_file || !metadata) {
+		// No file...
+		return;
+	}
+
+	const uint32_t header_size = be32_to_cpu(metadata->header_size);
+	firstHashTableAddr = (header_size + 0xFFF) & ~0xFFFU;
+
+	// Hash tables have two copies in console-signed packages,
+	// unless the block separation bit is set.
+	// NOTE: Only CON packages have the extra hash tables.
+	if (isCON) {
+		if (firstHashTableAddr == 0xB000) {
+			blockShift = 1;
+		} else {
+			blockShift = ((metadata->stfs_desc.block_separation & 1) ? 0 : 1);
+		}
+	}
+	blockStep[0] = STFS_HASH_ENTRIES_PER_TABLE + (1U << blockShift);
+	blockStep[1] = (STFS_HASH_ENTRIES_PER_TABLE * blockStep[0]) + (1U << blockShift);
+
+	// Top hash table level depends on the number of allocated blocks.
+	const uint32_t allocBlocks = be32_to_cpu(metadata->stfs_desc.total_alloc_block_count);
+	if (allocBlocks <= STFS_HASH_ENTRIES_PER_TABLE) {
+		topLevel = 0;
+	} else if (allocBlocks <= STFS_HASH_ENTRIES_PER_TABLE * STFS_HASH_ENTRIES_PER_TABLE) {
+		topLevel = 1;
+	} else {
+		topLevel = 2;
+	}
+	if (blockShift) {
+		topTableCopy = ((metadata->stfs_desc.block_separation & 2) ? 1 : 0);
+	}
+
+	// Sanity check: The file must fit in its blocks.
+	if ((static_cast<uint64_t>(blockCount) * STFS_BLOCK_SIZE) < fileSize ||
+	    blockNumber >= STFS_HASH_CHAIN_END)
+	{
+		// Invalid file entry.
+		this->fileSize = 0;
+		this->blockCount = 0;
+	}
+}
+
+/**
+ * Convert a data block number to a physical address.
+ * Data block numbers don't include hash blocks.
+ * @param dataBlockNumber Data block number.
+ * @return Physical address, or -1 on error.
+ */
+off64_t StfsReaderPrivate::dataBlockToPhysAddr(uint32_t dataBlockNumber) const
+{
+	// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
+	if (dataBlockNumber >= STFS_HASH_CHAIN_END) {
+		return -1;
+	}
+
+	// NOTE: Data block 0xAA is the first block after the level 1
+	// table, so the comparisons here must be >=, not >.
+	uint32_t phys = (((dataBlockNumber + 0xAA) / 0xAA) << blockShift) + dataBlockNumber;
+	if (dataBlockNumber >= 0xAA) {
+		phys += (((dataBlockNumber + 0x70E4) / 0x70E4) << blockShift);
+		if (dataBlockNumber >= 0x70E4) {
+			phys += (((dataBlockNumber + 0x4AF768) / 0x4AF768) << blockShift);
+		}
+	}
+
+	return static_cast<off64_t>(firstHashTableAddr) +
+		(static_cast<off64_t>(phys) * STFS_BLOCK_SIZE);
+}
+
+/**
+ * Get the physical block number of a hash table.
+ * @param dataBlockNumber Data block number covered by the table.
+ * @param level Hash table level. (0-2)
+ * @return Physical block number, relative to firstHashTableAddr.
+ */
+uint32_t StfsReaderPrivate::hashTableBlockNumber(uint32_t dataBlockNumber, int level) const
+{
+	static const uint32_t L0_BLOCKS = STFS_HASH_ENTRIES_PER_TABLE;
+	static const uint32_t L1_BLOCKS = STFS_HASH_ENTRIES_PER_TABLE * STFS_HASH_ENTRIES_PER_TABLE;
+
+	switch (level) {
+		case 0: {
+			if (dataBlockNumber < L0_BLOCKS)
+				return 0;
+			uint32_t num = (dataBlockNumber / L0_BLOCKS) * blockStep[0];
+			num += ((dataBlockNumber / L1_BLOCKS) + 1) << blockShift;
+			if (dataBlockNumber < L1_BLOCKS)
+				return num;
+			return num + (1U << blockShift);
+		}
+
+		case 1:
+			if (dataBlockNumber < L1_BLOCKS)
+				return blockStep[0];
+			return (1U << blockShift) + ((dataBlockNumber / L1_BLOCKS) * blockStep[1]);
+
+		case 2:
+			return blockStep[1];
+
+		default:
+			assert(!"Invalid hash table level.");
+			break;
+	}
+	return 0;
+}
+
+/**
+ * Get a hash table.
+ * The table is loaded from the file if it isn't cached.
+ * @param addr Physical address.
+ * @return Hash table, or nullptr on error.
+ */
+const STFS_Hash_Entry *StfsReaderPrivate::getHashTable(uint32_t addr)
+{
+	auto iter = hashCache.find(addr);
+	if (iter != hashCache.end()) {
+		return reinterpret_cast<const STFS_Hash_Entry*>(iter->second.data());
+	}
+
+	if (hashCache.size() >= HASH_CACHE_MAX) {
+		// Cache is full.
+		hashCache.clear();
+	}
+
+	RP_Q(StfsReader);
+	ao::uvector<uint8_t> table;
+	table.resize(STFS_HASH_ENTRIES_PER_TABLE * sizeof(STFS_Hash_Entry));
+	size_t size = q->m_file->pread(addr, table.data(), table.size());
+	if (size != table.size()) {
+		// Seek and/or read error.
+		q->m_lastError = q->m_file->lastError();
+		if (q->m_lastError == 0) {
+			q->m_lastError = EIO;
+		}
+		return nullptr;
+	}
+
+	auto ins = hashCache.emplace(addr, std::move(table));
+	return reinterpret_cast<const STFS_Hash_Entry*>(ins.first->second.data());
+}
+
+/**
+ * Get the level 0 hash entry for a data block.
+ * Higher-level tables are used to select the active
+ * copy of each table if the package has two copies.
+ * @param dataBlockNumber Data block number.
+ * @return Hash entry, or nullptr on error.
+ */
+const STFS_Hash_Entry *StfsReaderPrivate::getHashEntry(uint32_t dataBlockNumber)
+{
+	static const uint32_t L0_BLOCKS = STFS_HASH_ENTRIES_PER_TABLE;
+	static const uint32_t L1_BLOCKS = STFS_HASH_ENTRIES_PER_TABLE * STFS_HASH_ENTRIES_PER_TABLE;
+
+	// Start at the top table and work down.
+	// Only packages with two copies of each table need
+	// to read the higher levels.
+	uint8_t copy = topTableCopy;
+	const int startLevel = (blockShift ? topLevel : 0);
+	for (int level = startLevel; level >= 0; level--) {
+		const uint32_t tableBlock = hashTableBlockNumber(dataBlockNumber, level) + copy;
+		const uint32_t addr = firstHashTableAddr + (tableBlock * STFS_BLOCK_SIZE);
+		const STFS_Hash_Entry *const table = getHashTable(addr);
+		if (!table)
+			return nullptr;
+
+		unsigned int idx;
+		switch (level) {
+			default:
+			case 0:
+				idx = dataBlockNumber % L0_BLOCKS;
+				break;
+			case 1:
+				idx = (dataBlockNumber / L0_BLOCKS) % STFS_HASH_ENTRIES_PER_TABLE;
+				break;
+			case 2:
+				idx = (dataBlockNumber / L1_BLOCKS) % STFS_HASH_ENTRIES_PER_TABLE;
+				break;
+		}
+
+		if (level == 0) {
+			return &table[idx];
+		}
+		copy = ((table[idx].status & STFS_HASH_STATUS_ACTIVE_INDEX) ? 1 : 0);
+	}
+
+	// Should not get here...
+	return nullptr;
+}
+
+/**
+ * Get the data block number for a block in the file.
+ * @param idx Block index within the file.
+ * @return Data block number, or STFS_HASH_CHAIN_END on error.
+ */
+uint32_t StfsReaderPrivate::fileBlockToDataBlock(uint32_t idx)
+{
+	if (idx >= blockCount) {
+		return STFS_HASH_CHAIN_END;
+	} else if (consecutive) {
+		return blockNumber + idx;
+	}
+
+	// Follow the hash chain up to the requested block.
+	if (dataBlocks.empty()) {
+		dataBlocks.reserve(blockCount);
+		dataBlocks.push_back(blockNumber);
+	}
+	while (dataBlocks.size() <= idx) {
+		const STFS_Hash_Entry *const entry = getHashEntry(dataBlocks.back());
+		if (!entry) {
+			return STFS_HASH_CHAIN_END;
+		}
+		const uint32_t next = (entry->next_block[0] << 16) |
+		                      (entry->next_block[1] <<  8) |
+		                       entry->next_block[2];
+		if (next >= STFS_HASH_CHAIN_END) {
+			// Chain ended early.
+			RP_Q(StfsReader);
+			q->m_lastError = EIO;
+			return STFS_HASH_CHAIN_END;
+		}
+		dataBlocks.push_back(next);
+	}
+	return dataBlocks[idx];
+}
+
+/** StfsReader **/
+
+/**
+ * Construct an StfsReader for a file in an STFS package.
+ *
+ * Data block numbers are mapped to physical blocks,
+ * skipping the interleaved hash tables. If the file's
+ * blocks aren't consecutive, the block chain is read
+ * from the level 0 hash tables as needed.
+ *
+ * NOTE: The IRpFile *must* remain valid while this
+ * StfsReader is open.
+ *
+ * @param file		[in] IRpFile.
+ * @param metadata	[in] STFS package metadata.
+ * @param isCON		[in] True if this is a console-signed (CON) package.
+ * @param blockNumber	[in] First data block number.
+ * @param blockCount	[in] Number of data blocks.
+ * @param fileSize	[in] File size, in bytes.
+ * @param consecutive	[in] True if the file's blocks are consecutive.
+ */
+StfsReader::StfsReader(IRpFile *file, const STFS_Package_Metadata *metadata, bool isCON,
+		uint32_t blockNumber, uint32_t blockCount, uint32_t fileSize, bool consecutive)
+	: super(file)
+	, d_ptr(new StfsReaderPrivate(this, metadata, isCON, blockNumber, blockCount, fileSize, consecutive))
+{ }
+
+StfsReader::~StfsReader()
+{
+	delete d_ptr;
+}
+
+/** IDiscReader **/
+
+/**
+ * Read data from the file.
+ * Physically contiguous blocks are read in a single request.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t StfsReader::read(void *ptr, size_t size)
+{
+	RP_D(StfsReader);
+	assert(ptr != nullptr);
+	assert(m_file != nullptr);
+	assert(m_file->isOpen());
+	if (!ptr) {
+		m_lastError = EINVAL;
+		return 0;
+	} else if (!m_file || !m_file->isOpen()) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (size == 0 || d->pos >= static_cast<off64_t>(d->fileSize)) {
+		// Nothing to do...
+		return 0;
+	}
+
+	// Make sure pos + size <= fileSize.
+	if (d->pos + static_cast<off64_t>(size) > static_cast<off64_t>(d->fileSize)) {
+		size = static_cast<size_t>(d->fileSize - d->pos);
+	}
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t ret = 0;
+	while (size > 0) {
+		// Start of the run.
+		uint32_t blockIdx = static_cast<uint32_t>(d->pos / STFS_BLOCK_SIZE);
+		const uint32_t blockOffset = static_cast<uint32_t>(d->pos % STFS_BLOCK_SIZE);
+		const off64_t physAddr = d->dataBlockToPhysAddr(d->fileBlockToDataBlock(blockIdx));
+		if (physAddr < 0) {
+			// Invalid block.
+			if (m_lastError == 0) {
+				m_lastError = EIO;
+			}
+			break;
+		}
+
+		size_t runSize = STFS_BLOCK_SIZE - blockOffset;
+		if (runSize > size) {
+			runSize = size;
+		}
+
+		// Extend the run while the next block is physically adjacent.
+		while (runSize < size) {
+			blockIdx++;
+			const off64_t nextAddr = d->dataBlockToPhysAddr(d->fileBlockToDataBlock(blockIdx));
+			if (nextAddr != physAddr + static_cast<off64_t>(blockOffset + runSize))
+				break;
+
+			size_t blockSize = size - runSize;
+			if (blockSize > STFS_BLOCK_SIZE) {
+				blockSize = STFS_BLOCK_SIZE;
+			}
+			runSize += blockSize;
+		}
+
+		size_t sz_read = m_file->pread(physAddr + blockOffset, ptr8, runSize);
+		ret += sz_read;
+		d->pos += sz_read;
+		if (sz_read != runSize) {
+			// Short read.
+			m_lastError = m_file->lastError();
+			if (m_lastError == 0) {
+				m_lastError = EIO;
+			}
+			break;
+		}
+		ptr8 += runSize;
+		size -= runSize;
+	}
+
+	return ret;
+}
+
+/**
+ * Set the file position.
+ * @param pos File position.
+ * @return 0 on success; -1 on error.
+ */
+int StfsReader::seek(off64_t pos)
+{
+	RP_D(StfsReader);
+	assert(m_file != nullptr);
+	assert(m_file->isOpen());
+	if (!m_file ||  !m_file->isOpen()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	// Handle out-of-range cases.
+	if (pos < 0) {
+		// Negative is invalid.
+		m_lastError = EINVAL;
+		return -1;
+	} else if (pos >= static_cast<off64_t>(d->fileSize)) {
+		d->pos = d->fileSize;
+	} else {
+		d->pos = pos;
+	}
+	return 0;
+}
+
+/**
+ * Get the file position.
+ * @return File position on success; -1 on error.
+ */
+off64_t StfsReader::tell(void)
+{
+	RP_D(const StfsReader);
+	assert(m_file != nullptr);
+	assert(m_file->isOpen());
+	if (!m_file ||  !m_file->isOpen()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return d->pos;
+}
+
+/**
+ * Get the file size.
+ * @return File size, or -1 on error.
+ */
+off64_t StfsReader::size(void)
+{
+	RP_D(const StfsReader);
+	assert(m_file != nullptr);
+	assert(m_file->isOpen());
+	if (!m_file ||  !m_file->isOpen()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return d->fileSize;
+}
+
+/** IPartition **/
+
+/**
+ * Get the partition size.
+ * This is the number of allocated blocks times the block size.
+ * @return Partition size, or -1 on error.
+ */
+off64_t StfsReader::partition_size(void) const
+{
+	RP_D(const StfsReader);
+	return static_cast<off64_t>(d->blockCount) * STFS_BLOCK_SIZE;
+}
+
+/**
+ * Get the used partition size.
+ * For StfsReader, this is the same as partition_size().
+ * @return Used partition size, or -1 on error.
+ */
+off64_t StfsReader::partition_size_used(void) const
+{
+	RP_D(const StfsReader);
+	return static_cast<off64_t>(d->blockCount) * STFS_BLOCK_SIZE;
+}
+
+}
@@ -0,0 +1,105 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * StfsReader.hpp: Microsoft Xbox 360 STFS file reader.                    *
+ *                                                                         *
+ * Copyright (c) 2026 by David Korth.                                      *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DISC_STFSREADER_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_DISC_STFSREADER_HPP__
+
+#include "../Console/xbox360_stfs_structs.h"
+
+// librpbase
+#include "librpbase/disc/IPartition.hpp"
+
+namespace LibRomData {
+
+class StfsReaderPrivate;
+class StfsReader : public LibRpBase::IPartition
+{
+	public:
+		/**
+		 * Construct an StfsReader for a file in an STFS package.
+		 *
+		 * Data block numbers are mapped to physical blocks,
+		 * skipping the interleaved hash tables. If the file's
+		 * blocks aren't consecutive, the block chain is read
+		 * from the level 0 hash tables as needed.
+		 *
+		 * NOTE: The IRpFile *must* remain valid while this
+		 * StfsReader is open.
+		 *
+		 * @param file		[in] IRpFile.
+		 * @param metadata	[in] STFS package metadata.
+		 * @param isCON		[in] True if this is a console-signed (CON) package.
+		 * @param blockNumber	[in] First data block number.
+		 * @param blockCount	[in] Number of data blocks.
+		 * @param fileSize	[in] File size, in bytes.
+		 * @param consecutive	[in] True if the file's blocks are consecutive.
+		 */
+		StfsReader(LibRpFile::IRpFile *file, const STFS_Package_Metadata *metadata, bool isCON,
+			uint32_t blockNumber, uint32_t blockCount, uint32_t fileSize, bool consecutive);
+		virtual ~StfsReader();
+
+	private:
+		typedef IPartition super;
+		RP_DISABLE_COPY(StfsReader)
+
+	protected:
+		friend class StfsReaderPrivate;
+		StfsReaderPrivate *const d_ptr;
+
+	public:
+		/** IDiscReader **/
+
+		/**
+		 * Read data from the file.
+		 * Physically contiguous blocks are read in a single request.
+		 * @param ptr Output data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t read(void *ptr, size_t size) final;
+
+		/**
+		 * Set the file position.
+		 * @param pos File position.
+		 * @return 0 on success; -1 on error.
+		 */
+		int seek(off64_t pos) final;
+
+		/**
+		 * Get the file position.
+		 * @return File position on success; -1 on error.
+		 */
+		off64_t tell(void) final;
+
+		/**
+		 * Get the file size.
+		 * @return File size, or -1 on error.
+		 */
+		off64_t size(void) final;
+
+	public:
+		/** IPartition **/
+
+		/**
+		 * Get the partition size.
+		 * This is the number of allocated blocks times the block size.
+		 * @return Partition size, or -1 on error.
+		 */
+		off64_t partition_size(void) const final;
+
+		/**
+		 * Get the used partition size.
+		 * For StfsReader, this is the same as partition_size().
+		 * @return Used partition size, or -1 on error.
+		 */
+		off64_t partition_size_used(void) const final;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DISC_STFSREADER_HPP__ */
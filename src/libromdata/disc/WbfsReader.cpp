@@ -265,7 +265,7 @@ wbfs_disc_t *WbfsReaderPrivate::openWbfsDisc(wbfs_t *p, uint32_t index)
 					free(disc);
 					return nullptr;
 				}
-				size_t size = q->m_file->seekAndRead((p->hd_sec_sz + (i*p->disc_info_sz)),
+				size_t size = q->m_file->pread((p->hd_sec_sz + (i*p->disc_info_sz)),
 					disc->header, p->disc_info_sz);
 				if (size != p->disc_info_sz) {
 					// Error reading the disc information.
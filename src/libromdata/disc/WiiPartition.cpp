@@ -12,8 +12,11 @@
 #include "WiiPartition.hpp"
 #include "Console/wii_structs.h"
 
-// librpbase, librpfile
+// librpbase, librpfile, librpthreads
 #include "librpbase/crypto/KeyManager.hpp"
+#include "librpbase/crypto/MultiHash.hpp"
+#include "librpthreads/Mutex.hpp"
+#include "librpthreads/ThreadPool.hpp"
 #ifdef ENABLE_DECRYPTION
 # include "librpbase/crypto/IAesCipher.hpp"
 # include "librpbase/crypto/AesCipherFactory.hpp"
@@ -23,6 +26,7 @@ using LibRpFile::IRpFile;
 
 // C++ STL classes.
 using std::unique_ptr;
+using std::vector;
 
 #include "GcnPartitionPrivate.hpp"
 namespace LibRomData {
@@ -64,6 +68,9 @@ class WiiPartitionPrivate : public GcnPartitionPrivate
 		// Crypto method.
 		WiiPartition::CryptoMethod cryptoMethod;
 
+		// IDiscReader mutex. (optional)
+		Mutex *discReaderMutex;
+
 	public:
 		// Decrypted read position. (0x7C00 bytes out of 0x8000)
 		// NOTE: Actual read position if ((cryptoMethod & CM_MASK_SECTOR) == CM_32K).
@@ -84,6 +91,19 @@ class WiiPartitionPrivate : public GcnPartitionPrivate
 		 */
 		int readSector(uint32_t sector_num);
 
+		/**
+		 * Read raw data from the disc.
+		 * The IDiscReader mutex is locked if it's set.
+		 * On a short read, q->m_lastError is set while
+		 * the mutex is still locked.
+		 *
+		 * @param addr	[in] Disc address.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t readRaw(off64_t addr, void *ptr, size_t size);
+
 #ifdef ENABLE_DECRYPTION
 	public:
 		// AES cipher for this partition's title key.
@@ -163,6 +183,7 @@ WiiPartitionPrivate::WiiPartitionPrivate(WiiPartition *q,
 	, encKey(WiiPartition::ENCKEY_UNKNOWN)
 	, encKeyReal(WiiPartition::ENCKEY_UNKNOWN)
 	, cryptoMethod(cryptoMethod)
+	, discReaderMutex(nullptr)
 	, pos_7C00(-1)
 	, sector_num(~0)
 	, aes_title(nullptr)
@@ -171,6 +192,7 @@ WiiPartitionPrivate::WiiPartitionPrivate(WiiPartition *q,
 	, encKey(WiiPartition::ENCKEY_UNKNOWN)
 	, encKeyReal(WiiPartition::ENCKEY_UNKNOWN)
 	, cryptoMethod(cryptoMethod)
+	, discReaderMutex(nullptr)
 	, pos_7C00(-1)
 	, sector_num(~0)
 #endif /* ENABLE_DECRYPTION */
@@ -314,28 +336,53 @@ KeyManager::VerifyResult WiiPartitionPrivate::initDecryption(void)
 		return verifyResult;
 	}
 
-	// Load the common key. (CBC mode)
-	int ret = cipher->setKey(keyData.key, keyData.length);
-	ret |= cipher->setChainingMode(IAesCipher::CM_CBC);
-	if (ret != 0) {
-		// Error initializing the cipher.
-		verifyResult = KeyManager::VERFIY_IAESCIPHER_INIT_ERR;
-		return verifyResult;
-	}
+	// Check the derived key cache for the title key.
+	// - Input: Common key, title ID, encrypted title key.
+	// NOTE: getAndVerify() ensures the common key is at most 32 bytes.
+	uint8_t tkInput[32+8+16];
+	memcpy(&tkInput[0], keyData.key, keyData.length);
+	memcpy(&tkInput[keyData.length], partitionHeader.ticket.title_id.u8, 8);
+	memcpy(&tkInput[keyData.length+8], partitionHeader.ticket.enc_title_key, 16);
+	const unsigned int tkInputLen = keyData.length + 8 + 16;
+	if (!keyManager->getDerivedKey(KeyManager::DERIVED_WII_TITLE_KEY,
+	     tkInput, tkInputLen, title_key))
+	{
+		// Not cached. Decrypt the title key.
+
+		// Load the common key. (CBC mode)
+		int ret = cipher->setKey(keyData.key, keyData.length);
+		ret |= cipher->setChainingMode(IAesCipher::CM_CBC);
+		if (ret != 0) {
+			// Error initializing the cipher.
+			verifyResult = KeyManager::VERFIY_IAESCIPHER_INIT_ERR;
+			return verifyResult;
+		}
 
-	// Get the IV.
-	// First 8 bytes are the title ID.
-	// Second 8 bytes are all 0.
-	uint8_t iv[16];
-	memcpy(iv, partitionHeader.ticket.title_id.u8, 8);
-	memset(&iv[8], 0, 8);
+		// Get the IV.
+		// First 8 bytes are the title ID.
+		// Second 8 bytes are all 0.
+		uint8_t iv[16];
+		memcpy(iv, partitionHeader.ticket.title_id.u8, 8);
+		memset(&iv[8], 0, 8);
+
+		// Decrypt the title key.
+		memcpy(title_key, partitionHeader.ticket.enc_title_key, sizeof(title_key));
+		if (cipher->decrypt(title_key, sizeof(title_key), iv, sizeof(iv)) != sizeof(title_key)) {
+			// Error decrypting the title key.
+			verifyResult = KeyManager::VERIFY_IAESCIPHER_DECRYPT_ERR;
+			return verifyResult;
+		}
 
-	// Decrypt the title key.
-	memcpy(title_key, partitionHeader.ticket.enc_title_key, sizeof(title_key));
-	if (cipher->decrypt(title_key, sizeof(title_key), iv, sizeof(iv)) != sizeof(title_key)) {
-		// Error decrypting the title key.
-		verifyResult = KeyManager::VERIFY_IAESCIPHER_DECRYPT_ERR;
-		return verifyResult;
+		// Save the title key in the derived key cache.
+		keyManager->setDerivedKey(KeyManager::DERIVED_WII_TITLE_KEY,
+			tkInput, tkInputLen, title_key);
+	} else {
+		// Title key was cached. Set the chaining mode.
+		if (cipher->setChainingMode(IAesCipher::CM_CBC) != 0) {
+			// Error initializing the cipher.
+			verifyResult = KeyManager::VERFIY_IAESCIPHER_INIT_ERR;
+			return verifyResult;
+		}
 	}
 
 	// Set the title key in the AES cipher.
@@ -412,17 +459,11 @@ int WiiPartitionPrivate::readSector(uint32_t sector_num)
 	off64_t sector_addr = partition_offset + data_offset;
 	sector_addr += (static_cast<off64_t>(sector_num) * SECTOR_SIZE_ENCRYPTED);
 
-	int ret = q->m_discReader->seek(sector_addr);
-	if (ret != 0) {
-		q->m_lastError = q->m_discReader->lastError();
-		return ret;
-	}
-
-	size_t sz = q->m_discReader->read(sector_buf, sizeof(sector_buf));
+	const size_t sz = readRaw(sector_addr, sector_buf, sizeof(sector_buf));
 	if (sz != SECTOR_SIZE_ENCRYPTED) {
 		// sector_buf may be invalid.
+		// NOTE: readRaw() sets q->m_lastError.
 		this->sector_num = ~0;
-		q->m_lastError = EIO;
 		return -1;
 	}
 
@@ -445,6 +486,39 @@ int WiiPartitionPrivate::readSector(uint32_t sector_num)
 	return 0;
 }
 
+/**
+ * Read raw data from the disc.
+ * The IDiscReader mutex is locked if it's set.
+ * On a short read, q->m_lastError is set while
+ * the mutex is still locked.
+ *
+ * @param addr	[in] Disc address.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t WiiPartitionPrivate::readRaw(off64_t addr, void *ptr, size_t size)
+{
+	RP_Q(WiiPartition);
+
+	// NOTE: The read and lastError() must be done together
+	// if other partitions are reading from other threads.
+	if (discReaderMutex) {
+		discReaderMutex->lock();
+	}
+	const size_t sz_read = q->m_discReader->pread(addr, ptr, size);
+	if (sz_read != size) {
+		q->m_lastError = q->m_discReader->lastError();
+		if (q->m_lastError == 0) {
+			q->m_lastError = EIO;
+		}
+	}
+	if (discReaderMutex) {
+		discReaderMutex->unlock();
+	}
+	return sz_read;
+}
+
 /** WiiPartition **/
 
 /**
@@ -521,6 +595,123 @@ WiiPartition::~WiiPartition()
  * @return Number of bytes read.
  */
 size_t WiiPartition::read(void *ptr, size_t size)
+{
+	RP_D(WiiPartition);
+	const size_t ret = this->pread(d->pos_7C00, ptr, size);
+	d->pos_7C00 += ret;
+	return ret;
+}
+
+/**
+ * Set the partition position.
+ * @param pos Partition position.
+ * @return 0 on success; -1 on error.
+ */
+int WiiPartition::seek(off64_t pos)
+{
+	RP_D(WiiPartition);
+	assert(m_discReader != nullptr);
+	assert(m_discReader->isOpen());
+	if (!m_discReader ||  !m_discReader->isOpen()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	// Handle out-of-range cases.
+	if (pos < 0) {
+		// Negative is invalid.
+		m_lastError = EINVAL;
+		return -1;
+	} else if (pos >= d->data_size) {
+		d->pos_7C00 = d->data_size;
+	} else {
+		d->pos_7C00 = pos;
+	}
+	return 0;
+}
+
+/**
+ * Get the partition position.
+ * @return Partition position on success; -1 on error.
+ */
+off64_t WiiPartition::tell(void)
+{
+	RP_D(const WiiPartition);
+	assert(m_discReader != nullptr);
+	assert(m_discReader->isOpen());
+	if (!m_discReader ||  !m_discReader->isOpen()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return d->pos_7C00;
+}
+
+/**
+ * Hint that a range of the partition will be read soon.
+ *
+ * The range is converted to the encrypted sectors
+ * that contain it, including the hash areas.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int WiiPartition::prefetch(off64_t pos, size_t size)
+{
+	RP_D(const WiiPartition);
+	assert(m_discReader != nullptr);
+	if (!m_discReader || !m_discReader->isOpen()) {
+		m_lastError = EBADF;
+		return -EBADF;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return -EINVAL;
+	}
+
+	if (pos >= d->data_size || size == 0) {
+		// Nothing to prefetch.
+		return 0;
+	} else if (pos + static_cast<off64_t>(size) > d->data_size) {
+		size = static_cast<size_t>(d->data_size - pos);
+	}
+
+	// Determine the sector range.
+	// NOTE: CM_32K uses full 32K sectors with no hash area.
+	const unsigned int sector_size_data =
+		((d->cryptoMethod & CM_MASK_SECTOR) == CM_32K)
+			? SECTOR_SIZE_ENCRYPTED
+			: SECTOR_SIZE_DECRYPTED;
+	const off64_t sectorStart = pos / sector_size_data;
+	const off64_t sectorEnd = (pos + size - 1) / sector_size_data;
+
+	const off64_t sector_addr = d->partition_offset + d->data_offset +
+		(sectorStart * SECTOR_SIZE_ENCRYPTED);
+	const size_t sector_len = static_cast<size_t>(
+		(sectorEnd - sectorStart + 1) * SECTOR_SIZE_ENCRYPTED);
+	if (d->discReaderMutex) {
+		d->discReaderMutex->lock();
+	}
+	const int ret = m_discReader->prefetch(sector_addr, sector_len);
+	if (ret != 0) {
+		m_lastError = m_discReader->lastError();
+	}
+	if (d->discReaderMutex) {
+		d->discReaderMutex->unlock();
+	}
+	return ret;
+}
+
+/**
+ * Read data from the specified position.
+ * The partition position is not changed.
+ * NOTE: The sector cache is still updated.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t WiiPartition::pread(off64_t pos, void *ptr, size_t size)
 {
 	RP_D(WiiPartition);
 	assert(m_discReader != nullptr);
@@ -528,6 +719,9 @@ size_t WiiPartition::read(void *ptr, size_t size)
 	if (!m_discReader || !m_discReader->isOpen()) {
 		m_lastError = EBADF;
 		return 0;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
 	}
 
 	// TODO: Consolidate this code and optimize it.
@@ -535,20 +729,20 @@ size_t WiiPartition::read(void *ptr, size_t size)
 	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
 
 	// Are we already at the end of the file?
-	if (d->pos_7C00 >= d->data_size)
+	if (pos >= d->data_size)
 		return 0;
 
-	// Make sure d->pos_7C00 + size <= d->data_size.
+	// Make sure pos + size <= d->data_size.
 	// If it isn't, we'll do a short read.
-	if (d->pos_7C00 + static_cast<off64_t>(size) >= d->data_size) {
-		size = static_cast<size_t>(d->data_size - d->pos_7C00);
+	if (pos + static_cast<off64_t>(size) >= d->data_size) {
+		size = static_cast<size_t>(d->data_size - pos);
 	}
 
 	if ((d->cryptoMethod & CM_MASK_SECTOR) == CM_32K) {
 		// Full 32K sectors. (implies no encryption)
 
 		// Check if we're not starting on a block boundary.
-		const uint32_t blockStartOffset = d->pos_7C00 % SECTOR_SIZE_ENCRYPTED;
+		const uint32_t blockStartOffset = pos % SECTOR_SIZE_ENCRYPTED;
 		if (blockStartOffset != 0) {
 			// Not a block boundary.
 			// Read the end of the block.
@@ -558,7 +752,7 @@ size_t WiiPartition::read(void *ptr, size_t size)
 			}
 
 			// Read and decrypt the sector.
-			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_ENCRYPTED);
+			const uint32_t blockStart = static_cast<uint32_t>(pos / SECTOR_SIZE_ENCRYPTED);
 			d->readSector(blockStart);
 
 			// Copy data from the sector.
@@ -568,18 +762,18 @@ size_t WiiPartition::read(void *ptr, size_t size)
 			size -= read_sz;
 			ptr8 += read_sz;
 			ret += read_sz;
-			d->pos_7C00 += read_sz;
+			pos += read_sz;
 		}
 
 		// Read entire blocks.
 		for (; size >= SECTOR_SIZE_ENCRYPTED;
 		     size -= SECTOR_SIZE_ENCRYPTED, ptr8 += SECTOR_SIZE_ENCRYPTED,
-		     ret += SECTOR_SIZE_ENCRYPTED, d->pos_7C00 += SECTOR_SIZE_ENCRYPTED)
+		     ret += SECTOR_SIZE_ENCRYPTED, pos += SECTOR_SIZE_ENCRYPTED)
 		{
-			assert(d->pos_7C00 % SECTOR_SIZE_ENCRYPTED == 0);
+			assert(pos % SECTOR_SIZE_ENCRYPTED == 0);
 
 			// Read the sector.
-			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_ENCRYPTED);
+			const uint32_t blockStart = static_cast<uint32_t>(pos / SECTOR_SIZE_ENCRYPTED);
 			d->readSector(blockStart);
 
 			// Copy data from the sector.
@@ -591,15 +785,14 @@ size_t WiiPartition::read(void *ptr, size_t size)
 			// Not a full block.
 
 			// Read the sector.
-			assert(d->pos_7C00 % SECTOR_SIZE_ENCRYPTED == 0);
-			const uint32_t blockEnd = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_ENCRYPTED);
+			assert(pos % SECTOR_SIZE_ENCRYPTED == 0);
+			const uint32_t blockEnd = static_cast<uint32_t>(pos / SECTOR_SIZE_ENCRYPTED);
 			d->readSector(blockEnd);
 
 			// Copy data from the sector.
 			memcpy(ptr8, &d->sector_buf[blockStartOffset], size);
 
 			ret += size;
-			d->pos_7C00 += size;
 		}
 	} else {
 		if ((d->cryptoMethod & CM_MASK_ENCRYPTED) == CM_ENCRYPTED) {
@@ -634,7 +827,7 @@ size_t WiiPartition::read(void *ptr, size_t size)
 		}
 
 		// Check if we're not starting on a block boundary.
-		const uint32_t blockStartOffset = d->pos_7C00 % SECTOR_SIZE_DECRYPTED;
+		const uint32_t blockStartOffset = pos % SECTOR_SIZE_DECRYPTED;
 		if (blockStartOffset != 0) {
 			// Not a block boundary.
 			// Read the end of the block.
@@ -644,7 +837,7 @@ size_t WiiPartition::read(void *ptr, size_t size)
 			}
 
 			// Read and decrypt the sector.
-			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_DECRYPTED);
+			const uint32_t blockStart = static_cast<uint32_t>(pos / SECTOR_SIZE_DECRYPTED);
 			d->readSector(blockStart);
 
 			// Copy data from the sector.
@@ -654,18 +847,18 @@ size_t WiiPartition::read(void *ptr, size_t size)
 			size -= read_sz;
 			ptr8 += read_sz;
 			ret += read_sz;
-			d->pos_7C00 += read_sz;
+			pos += read_sz;
 		}
 
 		// Read entire blocks.
 		for (; size >= SECTOR_SIZE_DECRYPTED;
 		size -= SECTOR_SIZE_DECRYPTED, ptr8 += SECTOR_SIZE_DECRYPTED,
-		ret += SECTOR_SIZE_DECRYPTED, d->pos_7C00 += SECTOR_SIZE_DECRYPTED)
+		ret += SECTOR_SIZE_DECRYPTED, pos += SECTOR_SIZE_DECRYPTED)
 		{
-			assert(d->pos_7C00 % SECTOR_SIZE_DECRYPTED == 0);
+			assert(pos % SECTOR_SIZE_DECRYPTED == 0);
 
 			// Read and decrypt the sector.
-			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_DECRYPTED);
+			const uint32_t blockStart = static_cast<uint32_t>(pos / SECTOR_SIZE_DECRYPTED);
 			d->readSector(blockStart);
 
 			// Copy data from the sector.
@@ -677,15 +870,14 @@ size_t WiiPartition::read(void *ptr, size_t size)
 			// Not a full block.
 
 			// Read and decrypt the sector.
-			assert(d->pos_7C00 % SECTOR_SIZE_DECRYPTED == 0);
-			const uint32_t blockEnd = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_DECRYPTED);
+			assert(pos % SECTOR_SIZE_DECRYPTED == 0);
+			const uint32_t blockEnd = static_cast<uint32_t>(pos / SECTOR_SIZE_DECRYPTED);
 			d->readSector(blockEnd);
 
 			// Copy data from the sector.
 			memcpy(ptr8, &d->sector_buf[SECTOR_SIZE_DECRYPTED_OFFSET], size);
 
 			ret += size;
-			d->pos_7C00 += size;
 		}
 	}
 
@@ -693,51 +885,6 @@ size_t WiiPartition::read(void *ptr, size_t size)
 	return ret;
 }
 
-/**
- * Set the partition position.
- * @param pos Partition position.
- * @return 0 on success; -1 on error.
- */
-int WiiPartition::seek(off64_t pos)
-{
-	RP_D(WiiPartition);
-	assert(m_discReader != nullptr);
-	assert(m_discReader->isOpen());
-	if (!m_discReader ||  !m_discReader->isOpen()) {
-		m_lastError = EBADF;
-		return -1;
-	}
-
-	// Handle out-of-range cases.
-	if (pos < 0) {
-		// Negative is invalid.
-		m_lastError = EINVAL;
-		return -1;
-	} else if (pos >= d->data_size) {
-		d->pos_7C00 = d->data_size;
-	} else {
-		d->pos_7C00 = pos;
-	}
-	return 0;
-}
-
-/**
- * Get the partition position.
- * @return Partition position on success; -1 on error.
- */
-off64_t WiiPartition::tell(void)
-{
-	RP_D(const WiiPartition);
-	assert(m_discReader != nullptr);
-	assert(m_discReader->isOpen());
-	if (!m_discReader ||  !m_discReader->isOpen()) {
-		m_lastError = EBADF;
-		return -1;
-	}
-
-	return d->pos_7C00;
-}
-
 /**
  * Get the used partition size.
  * This size includes the partition header and hashes,
@@ -770,6 +917,302 @@ off64_t WiiPartition::partition_size_used(void) const
 
 /** WiiPartition **/
 
+/**
+ * Set a mutex to lock while reading from the IDiscReader.
+ *
+ * This is needed if multiple partitions on the same disc
+ * are read from different threads. Only the IDiscReader
+ * access is locked; sector decryption runs unlocked.
+ *
+ * NOTE: The mutex *must* remain valid while this
+ * WiiPartition is open.
+ *
+ * @param mutex Mutex, or nullptr to disable locking.
+ */
+void WiiPartition::setDiscReaderMutex(Mutex *mutex)
+{
+	RP_D(WiiPartition);
+	d->discReaderMutex = mutex;
+}
+
+/**
+ * Hash verification task.
+ * One task is queued per subgroup of 8 sectors.
+ */
+struct HashCheckTask {
+	uint8_t *buf;			// Sector data. (encrypted, if cipher is set)
+	uint32_t first_sector;		// First sector number.
+	unsigned int sector_count;	// Number of sectors. (up to 8)
+	const uint8_t *h3;		// H3 hash for this group.
+#ifdef ENABLE_DECRYPTION
+	IAesCipher *cipher;		// Title key cipher, or nullptr if unencrypted.
+#endif /* ENABLE_DECRYPTION */
+	int ret;			// 0 on success; negative POSIX error code on error.
+	vector<WiiPartition::BadSector> bad_sectors;
+};
+
+/**
+ * Hash verification task function.
+ * @param param HashCheckTask.
+ * @param arena Scratch arena. (unused)
+ */
+static void hashCheckTaskFn(void *param, ScratchArena *arena)
+{
+	RP_UNUSED(arena);
+	HashCheckTask *const task = static_cast<HashCheckTask*>(param);
+
+	uint8_t *sector = task->buf;
+	for (unsigned int i = 0; i < task->sector_count; i++, sector += SECTOR_SIZE_ENCRYPTED) {
+		const uint32_t sector_num = task->first_sector + i;
+
+#ifdef ENABLE_DECRYPTION
+		if (task->cipher) {
+			// The data IV is taken from the *encrypted* hash block,
+			// so it has to be saved before the hash block is decrypted.
+			static const uint8_t hash_iv[16] = {0};
+			uint8_t data_iv[16];
+			memcpy(data_iv, &sector[0x3D0], sizeof(data_iv));
+			if (task->cipher->decrypt(sector, SECTOR_SIZE_DECRYPTED_OFFSET,
+			      hash_iv, sizeof(hash_iv)) != SECTOR_SIZE_DECRYPTED_OFFSET ||
+			    task->cipher->decrypt(&sector[SECTOR_SIZE_DECRYPTED_OFFSET], SECTOR_SIZE_DECRYPTED,
+			      data_iv, sizeof(data_iv)) != SECTOR_SIZE_DECRYPTED)
+			{
+				// Decryption failed.
+				task->ret = -EIO;
+				return;
+			}
+		}
+#endif /* ENABLE_DECRYPTION */
+
+		const RVL_HashBlock *const hb = reinterpret_cast<const RVL_HashBlock*>(sector);
+		WiiPartition::BadSector bad = {sector_num, 0, 0};
+		uint8_t digest[20];
+
+		// H0: Each 0x400-byte block of sector data.
+		const uint8_t *data = &sector[SECTOR_SIZE_DECRYPTED_OFFSET];
+		for (unsigned int j = 0; j < ARRAY_SIZE(hb->h0); j++, data += 0x400) {
+			MultiHash::sha1(data, 0x400, digest);
+			if (memcmp(digest, hb->h0[j], sizeof(digest)) != 0) {
+				bad.h0_blocks |= (1U << j);
+				bad.h_levels |= (1U << 0);
+			}
+		}
+
+		// H1: This sector's H0 table.
+		MultiHash::sha1(hb->h0, sizeof(hb->h0), digest);
+		if (memcmp(digest, hb->h1[sector_num % 8], sizeof(digest)) != 0) {
+			bad.h_levels |= (1U << 1);
+		}
+
+		// H2: This subgroup's H1 table.
+		MultiHash::sha1(hb->h1, sizeof(hb->h1), digest);
+		if (memcmp(digest, hb->h2[(sector_num / 8) % 8], sizeof(digest)) != 0) {
+			bad.h_levels |= (1U << 2);
+		}
+
+		// H3: This group's H2 table.
+		MultiHash::sha1(hb->h2, sizeof(hb->h2), digest);
+		if (memcmp(digest, task->h3, sizeof(digest)) != 0) {
+			bad.h_levels |= (1U << 3);
+		}
+
+		if (bad.h_levels != 0) {
+			task->bad_sectors.push_back(bad);
+		}
+	}
+}
+
+/**
+ * Verify the partition's H0-H3 hash tree.
+ *
+ * Groups of 64 sectors are read sequentially. While one
+ * group is being read, the previous group is decrypted
+ * and hashed on the worker threads, one task per subgroup.
+ * Groups without an H3 hash are not used, so they're skipped.
+ *
+ * NOTE: This reads the entire partition, so it may take a while.
+ * The partition position and sector cache are not changed.
+ *
+ * @param result	[out] Hash verification results.
+ * @param group		[in,opt] Task group for cancellation.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int WiiPartition::verifyHashes(HashCheckResult &result, TaskGroup *group)
+{
+	RP_D(WiiPartition);
+	result.sectors_checked = 0;
+	result.h3_table_ok = false;
+	result.bad_sectors.clear();
+
+	if (!m_discReader || d->partition_size < 0) {
+		m_lastError = EBADF;
+		return -m_lastError;
+	}
+	if ((d->cryptoMethod & CM_MASK_SECTOR) != CM_1K_31K ||
+	    !(MultiHash::supportedAlgorithms() & MultiHash::ALGO_SHA1))
+	{
+		// No hashes in this partition, or SHA-1 isn't available.
+		return -ENOTSUP;
+	}
+
+	static const unsigned int SECTORS_PER_SUBGROUP = 8;
+	static const unsigned int SECTORS_PER_GROUP = 64;
+	static const unsigned int SUBGROUPS_PER_GROUP = SECTORS_PER_GROUP / SECTORS_PER_SUBGROUP;
+	static const size_t GROUP_SIZE = SECTORS_PER_GROUP * SECTOR_SIZE_ENCRYPTED;
+
+	HashCheckTask tasks[SUBGROUPS_PER_GROUP];
+#ifdef ENABLE_DECRYPTION
+	// Each task needs its own cipher, since the
+	// IV is part of the cipher's state.
+	unique_ptr<IAesCipher> ciphers[SUBGROUPS_PER_GROUP];
+#endif /* ENABLE_DECRYPTION */
+	if ((d->cryptoMethod & CM_MASK_ENCRYPTED) == CM_ENCRYPTED) {
+#ifdef ENABLE_DECRYPTION
+		if (d->initDecryption() != KeyManager::VERIFY_OK) {
+			// Unable to decrypt the partition.
+			m_lastError = EIO;
+			return -m_lastError;
+		}
+		for (unsigned int i = 0; i < SUBGROUPS_PER_GROUP; i++) {
+			ciphers[i].reset(AesCipherFactory::create());
+			if (!ciphers[i] || !ciphers[i]->isInit() ||
+			    ciphers[i]->setKey(d->title_key, sizeof(d->title_key)) != 0 ||
+			    ciphers[i]->setChainingMode(IAesCipher::CM_CBC) != 0)
+			{
+				// Error initializing the cipher.
+				m_lastError = EIO;
+				return -m_lastError;
+			}
+			tasks[i].cipher = ciphers[i].get();
+		}
+#else /* !ENABLE_DECRYPTION */
+		// Decryption is disabled.
+		return -ENOTSUP;
+#endif /* ENABLE_DECRYPTION */
+	}
+#ifdef ENABLE_DECRYPTION
+	else {
+		for (unsigned int i = 0; i < SUBGROUPS_PER_GROUP; i++) {
+			tasks[i].cipher = nullptr;
+		}
+	}
+#endif /* ENABLE_DECRYPTION */
+
+	// Load the H3 table and verify it against the TMD.
+	unique_ptr<uint8_t[]> h3_table(new uint8_t[RVL_H3_TABLE_SIZE]);
+	const off64_t h3_addr = d->partition_offset +
+		(static_cast<off64_t>(be32_to_cpu(d->partitionHeader.h3_table_offset)) << 2);
+	if (d->readRaw(h3_addr, h3_table.get(), RVL_H3_TABLE_SIZE) != RVL_H3_TABLE_SIZE) {
+		// NOTE: readRaw() sets m_lastError.
+		return -m_lastError;
+	}
+	const RVL_TMD_Header *const tmd = tmdHeader();
+	if (tmd && be16_to_cpu(tmd->nbr_cont) > 0) {
+		// Content 0's hash is the H3 table hash.
+		const RVL_Content_Entry *const content = reinterpret_cast<const RVL_Content_Entry*>(
+			&d->partitionHeader.tmd[sizeof(RVL_TMD_Header)]);
+		uint8_t digest[20];
+		MultiHash::sha1(h3_table.get(), RVL_H3_TABLE_SIZE, digest);
+		result.h3_table_ok = (memcmp(digest, content->sha1_hash, sizeof(digest)) == 0);
+	}
+
+	// Groups without an H3 hash aren't used.
+	const uint32_t sector_count = static_cast<uint32_t>(d->data_size / SECTOR_SIZE_ENCRYPTED);
+	const uint32_t group_count = std::min(
+		(sector_count + SECTORS_PER_GROUP - 1) / SECTORS_PER_GROUP,
+		static_cast<uint32_t>(RVL_H3_TABLE_SIZE / 20));
+	auto nextGroup = [&h3_table, group_count](uint32_t grp) -> uint32_t {
+		static const uint8_t zero_hash[20] = {0};
+		for (; grp < group_count; grp++) {
+			if (memcmp(&h3_table[grp * 20], zero_hash, sizeof(zero_hash)) != 0)
+				break;
+		}
+		return grp;
+	};
+	auto groupSectors = [sector_count](uint32_t grp) -> unsigned int {
+		return std::min(SECTORS_PER_GROUP, sector_count - (grp * SECTORS_PER_GROUP));
+	};
+	const off64_t data_addr = d->partition_offset + d->data_offset;
+
+	// Two group buffers: one is verified while the other is read.
+	unique_ptr<uint8_t[]> buf(new uint8_t[GROUP_SIZE * 2]);
+	uint8_t *const bufs[2] = {buf.get(), buf.get() + GROUP_SIZE};
+
+	// NOTE: Using our own TaskGroup, since waiting on the
+	// caller's group would wait for unrelated tasks.
+	TaskGroup tg;
+	int ret = 0;
+
+	// Read the first group.
+	int b = 0;
+	uint32_t grp = nextGroup(0);
+	if (grp < group_count) {
+		const size_t size = groupSectors(grp) * SECTOR_SIZE_ENCRYPTED;
+		if (d->readRaw(data_addr + (static_cast<off64_t>(grp) * GROUP_SIZE), bufs[0], size) != size) {
+			// NOTE: readRaw() sets m_lastError.
+			return -m_lastError;
+		}
+	}
+
+	while (grp < group_count) {
+		// Verify the current group on the worker threads.
+		const unsigned int cur_sectors = groupSectors(grp);
+		unsigned int taskCount = 0;
+		for (unsigned int s = 0; s < cur_sectors; s += SECTORS_PER_SUBGROUP, taskCount++) {
+			HashCheckTask &task = tasks[taskCount];
+			task.buf = bufs[b] + (s * SECTOR_SIZE_ENCRYPTED);
+			task.first_sector = (grp * SECTORS_PER_GROUP) + s;
+			task.sector_count = std::min(SECTORS_PER_SUBGROUP, cur_sectors - s);
+			task.h3 = &h3_table[grp * 20];
+			task.ret = 0;
+			tg.run(hashCheckTaskFn, &task);
+		}
+
+		// Read the next group while the current group is verified.
+		const uint32_t next_grp = nextGroup(grp + 1);
+		size_t next_size = 0, sz_read = 0;
+		if (next_grp < group_count) {
+			next_size = groupSectors(next_grp) * SECTOR_SIZE_ENCRYPTED;
+			sz_read = d->readRaw(data_addr + (static_cast<off64_t>(next_grp) * GROUP_SIZE),
+				bufs[b ^ 1], next_size);
+		}
+
+		tg.wait();
+		result.sectors_checked += cur_sectors;
+
+		// Collect the results. Tasks are in sector order.
+		for (unsigned int i = 0; i < taskCount; i++) {
+			HashCheckTask &task = tasks[i];
+			if (task.ret != 0 && ret == 0) {
+				ret = task.ret;
+			}
+			result.bad_sectors.insert(result.bad_sectors.end(),
+				task.bad_sectors.cbegin(), task.bad_sectors.cend());
+			task.bad_sectors.clear();
+		}
+		if (ret != 0) {
+			break;
+		}
+
+		if (sz_read != next_size) {
+			// Short read.
+			// NOTE: readRaw() sets m_lastError.
+			ret = -m_lastError;
+			break;
+		}
+		if (group && group->isCancelled()) {
+			ret = -ECANCELED;
+			break;
+		}
+
+		// Swap the buffers.
+		b ^= 1;
+		grp = next_grp;
+	}
+
+	return ret;
+}
+
 /**
  * Encryption key verification result.
  * @return Encryption key verification result.
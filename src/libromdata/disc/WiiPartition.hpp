@@ -16,6 +16,14 @@
 // librpbase
 #include "librpbase/crypto/KeyManager.hpp"
 
+// C++ includes.
+#include <vector>
+
+namespace LibRpBase {
+	class Mutex;
+	class TaskGroup;
+}
+
 namespace LibRomData {
 
 class WiiPartitionPrivate;
@@ -85,6 +93,29 @@ class WiiPartition : public GcnPartition
 		 */
 		off64_t tell(void) final;
 
+		/**
+		 * Hint that a range of the partition will be read soon.
+		 *
+		 * The range is converted to the encrypted sectors
+		 * that contain it, including the hash areas.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+		 */
+		int prefetch(off64_t pos, size_t size) final;
+
+		/**
+		 * Read data from the specified position.
+		 * The partition position is not changed.
+		 * NOTE: The sector cache is still updated.
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t pread(off64_t pos, void *ptr, size_t size) final;
+
 	public:
 		/**
 		 * Get the used partition size.
@@ -141,6 +172,56 @@ class WiiPartition : public GcnPartition
 		 */
 		const RVL_TMD_Header *tmdHeader(void) const;
 
+		/**
+		 * Set a mutex to lock while reading from the IDiscReader.
+		 *
+		 * This is needed if multiple partitions on the same disc
+		 * are read from different threads. Only the IDiscReader
+		 * access is locked; sector decryption runs unlocked.
+		 *
+		 * NOTE: The mutex *must* remain valid while this
+		 * WiiPartition is open.
+		 *
+		 * @param mutex Mutex, or nullptr to disable locking.
+		 */
+		void setDiscReaderMutex(LibRpBase::Mutex *mutex);
+
+	public:
+		/**
+		 * Sector that failed hash verification.
+		 */
+		struct BadSector {
+			uint32_t sector;	// Sector number, relative to the partition data.
+			uint32_t h0_blocks;	// Bitfield of 0x400-byte data blocks that failed the H0 check.
+			uint8_t h_levels;	// Bitfield of hash levels that failed. (bit 0 == H0, bit 3 == H3)
+		};
+
+		/**
+		 * Hash verification results.
+		 */
+		struct HashCheckResult {
+			uint32_t sectors_checked;		// Number of sectors checked.
+			bool h3_table_ok;			// True if the H3 table matches the TMD.
+			std::vector<BadSector> bad_sectors;	// Sectors that failed verification.
+		};
+
+		/**
+		 * Verify the partition's H0-H3 hash tree.
+		 *
+		 * Groups of 64 sectors are read sequentially. While one
+		 * group is being read, the previous group is decrypted
+		 * and hashed on the worker threads, one task per subgroup.
+		 * Groups without an H3 hash are not used, so they're skipped.
+		 *
+		 * NOTE: This reads the entire partition, so it may take a while.
+		 * The partition position and sector cache are not changed.
+		 *
+		 * @param result	[out] Hash verification results.
+		 * @param group		[in,opt] Task group for cancellation.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int verifyHashes(HashCheckResult &result, LibRpBase::TaskGroup *group = nullptr);
+
 	public:
 		// Encryption key indexes.
 		enum EncryptionKeys {
@@ -98,7 +98,7 @@ XDVDFSPartitionPrivate::XDVDFSPartitionPrivate(XDVDFSPartition *q,
 	}
 
 	// Load the XDVDFS header.
-	size_t size = q->m_discReader->seekAndRead(
+	size_t size = q->m_discReader->pread(
 		partition_offset + (XDVDFS_HEADER_LBA_OFFSET * XDVDFS_BLOCK_SIZE),
 		&xdvdfsHeader, sizeof(xdvdfsHeader));
 	if (size != sizeof(xdvdfsHeader)) {
@@ -304,7 +304,7 @@ const ao::uvector<uint8_t> *XDVDFSPartitionPrivate::getDirectory(const char *pat
 
 	// Read the directory.
 	ao::uvector<uint8_t> dirTable(dir_size);
-	size_t size = q->m_discReader->seekAndRead(dir_addr, dirTable.data(), dirTable.size());
+	size_t size = q->m_discReader->pread(dir_addr, dirTable.data(), dirTable.size());
 	if (size != dirTable.size()) {
 		// Seek and/or read error.
 		q->m_lastError = q->m_discReader->lastError();
@@ -18,6 +18,7 @@
 #include "librpbase/RomData.hpp"
 #include "librpbase/config/Config.hpp"
 #include "librpbase/img/RpImageLoader.hpp"
+#include "librpbase/img/RpPng.hpp"
 #include "librpfile/RpFile.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
@@ -35,24 +36,91 @@ using LibRpTexture::rp_image;
 
 // C++ includes.
 #include <memory>
+#include <vector>
 using std::unique_ptr;
+using std::vector;
 
 namespace LibRomData {
 
 template<typename ImgClass>
 TCreateThumbnail<ImgClass>::TCreateThumbnail()
+	: m_pngPassthrough(false)
+	, m_config(nullptr)
 { }
 
 template<typename ImgClass>
 TCreateThumbnail<ImgClass>::~TCreateThumbnail()
 { }
 
+/**
+ * Use a fixed Config object for all thumbnails.
+ *
+ * By default, Config::instance() is called for every thumbnail,
+ * which checks if the configuration has been modified. Batch
+ * thumbnailers can set this once so every thumbnail in the batch
+ * uses the same configuration. The image type priority for each
+ * RomData class is then only looked up once.
+ *
+ * NOTE: If a fixed Config object is set, getThumbnail()
+ * can be called from multiple threads at the same time.
+ *
+ * @param config Config object, or nullptr to use Config::instance().
+ */
+template<typename ImgClass>
+void TCreateThumbnail<ImgClass>::setConfig(const Config *config)
+{
+	MutexLocker locker(m_imgTypePrioMutex);
+	m_config = config;
+	m_imgTypePrioCache.clear();
+}
+
+/**
+ * Get the image type priority for a RomData object.
+ * If a fixed Config object is set, the result is cached.
+ * @param romData	[in] RomData object.
+ * @param imgTypePrio	[out] Image type priority data.
+ * @return ImgTypeResult
+ */
+template<typename ImgClass>
+Config::ImgTypeResult TCreateThumbnail<ImgClass>::getImgTypePrio(const RomData *romData, Config::ImgTypePrio_t *imgTypePrio)
+{
+	const char *const className = romData->className();
+	if (!m_config) {
+		// No fixed Config object. Don't cache anything,
+		// since the configuration may be reloaded.
+		return Config::instance()->getImgTypePrio(className, imgTypePrio);
+	}
+
+	// NOTE: ImgTypePrio_t contains a copy of the image types,
+	// so the cached entries don't depend on the Config snapshot.
+	MutexLocker locker(m_imgTypePrioMutex);
+	for (auto iter = m_imgTypePrioCache.cbegin(); iter != m_imgTypePrioCache.cend(); ++iter) {
+		if (iter->className == className) {
+			*imgTypePrio = iter->imgTypePrio;
+			return iter->res;
+		}
+	}
+
+	ImgTypePrioCache_t entry;
+	entry.className = className;
+	entry.res = m_config->getImgTypePrio(className, &entry.imgTypePrio);
+	m_imgTypePrioCache.push_back(entry);
+	*imgTypePrio = entry.imgTypePrio;
+	return entry.res;
+}
+
 /**
  * Get an internal image.
+ *
+ * If req_size is specified, and the RomData object has
+ * multiple image sizes available, the smallest image that's
+ * at least as large as req_size will be used.
+ *
  * @param romData	[in] RomData object.
  * @param imageType	[in] Image type.
  * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
  * @param sBIT		[out,opt] sBIT metadata.
+ * @param req_size	[in,opt] Requested image size. (0 for the default size)
  * @return Internal image, or null ImgClass on error.
  */
 template<typename ImgClass>
@@ -60,7 +128,8 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 	const RomData *romData,
 	RomData::ImageType imageType,
 	ImgSize *pOutSize,
-	rp_image::sBIT_t *sBIT)
+	rp_image::sBIT_t *sBIT,
+	int req_size)
 {
 	assert(imageType >= RomData::IMG_INT_MIN && imageType <= RomData::IMG_INT_MAX);
 	if (imageType < RomData::IMG_INT_MIN || imageType > RomData::IMG_INT_MAX) {
@@ -71,7 +140,9 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 		return getNullImgClass();
 	}
 
-	const rp_image *image = romData->image(imageType);
+	const rp_image *image = (req_size > 0
+		? romData->image(imageType, req_size)
+		: romData->image(imageType));
 	if (!image) {
 		// No image.
 		if (sBIT) {
@@ -111,13 +182,16 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
  * @param req_size	[in] Requested image size.
  * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
  * @param sBIT		[out,opt] sBIT metadata.
- * @return External image, or null ImgClass on error.
+ * @param pPngData	[out,opt] If specified, and the image is a valid PNG, the
+ *			original PNG image is stored here instead of decoding it.
+ * @return External image, or null ImgClass on error or if pPngData was filled.
  */
 template<typename ImgClass>
 ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 	const RomData *romData, RomData::ImageType imageType,
 	int req_size, ImgSize *pOutSize,
-	rp_image::sBIT_t *sBIT)
+	rp_image::sBIT_t *sBIT,
+	vector<uint8_t> *pPngData)
 {
 	assert(imageType >= RomData::IMG_EXT_MIN && imageType <= RomData::IMG_EXT_MAX);
 	if (imageType < RomData::IMG_EXT_MIN || imageType > RomData::IMG_EXT_MAX) {
@@ -140,8 +214,9 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 		return getNullImgClass();
 	}
 
-	// NOTE: This will force a configuration timestamp check.
-	const Config *const config = Config::instance();
+	// NOTE: This will force a configuration timestamp check
+	// unless a fixed Config object was set.
+	const Config *const config = this->config();
 	const bool extImgDownloadEnabled = config->extImgDownloadEnabled();
 	const bool downloadHighResScans = config->downloadHighResScans();
 
@@ -177,6 +252,29 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 
 		// Attempt to load the image.
 		unique_IRpFile<RpFile> file(new RpFile(cache_filename, RpFile::FM_OPEN_READ));
+		if (file->isOpen() && pPngData) {
+			// PNG pass-through: If the cached image is a PNG,
+			// use it as-is instead of decoding it.
+			// NOTE: Cached images are normally well under 1 MB.
+			const off64_t fileSize = file->size();
+			if (fileSize > 0 && fileSize <= 16*1024*1024) {
+				ImgSize sz;
+				pPngData->resize(static_cast<size_t>(fileSize));
+				if (file->seekAndRead(0, pPngData->data(), pPngData->size()) == pPngData->size() &&
+				    RpPng::verifyChunks(pPngData->data(), pPngData->size(), &sz.width, &sz.height) == 0)
+				{
+					// Found a valid PNG image.
+					if (pOutSize) {
+						*pOutSize = sz;
+					}
+					if (sBIT) {
+						memset(sBIT, 0, sizeof(*sBIT));
+					}
+					return getNullImgClass();
+				}
+				pPngData->clear();
+			}
+		}
 		if (file->isOpen()) {
 			unique_ptr<rp_image> dl_img(RpImageLoader::load(file.get()));
 			if (dl_img && dl_img->isValid()) {
@@ -265,14 +363,20 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 	pOutParams->fullSize.height = 0;
 	memset(&pOutParams->sBIT, 0, sizeof(pOutParams->sBIT));
 	pOutParams->retImg = getNullImgClass();
+	pOutParams->pngData.clear();
 
 	uint32_t imgbf = romData->supportedImageTypes();
 	uint32_t imgpf = 0;
 
+	// If an internal image was loaded at a smaller size,
+	// this is its image type, so the full size can be
+	// reported in pOutParams->fullSize.
+	int sizedImgType = -1;
+
 	// Get the image priority.
-	const Config *const config = Config::instance();
+	const Config *const config = this->config();
 	Config::ImgTypePrio_t imgTypePrio;
-	Config::ImgTypeResult res = config->getImgTypePrio(romData->className(), &imgTypePrio);
+	Config::ImgTypeResult res = getImgTypePrio(romData, &imgTypePrio);
 	switch (res) {
 		case Config::IMGTR_SUCCESS:
 		case Config::IMGTR_SUCCESS_DEFAULTS:
@@ -294,8 +398,10 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 		// Check for an icon first.
 		// TODO: Define "small sizes" somewhere. (DPI independence?)
 		if (imgbf & RomData::IMGBF_INT_ICON) {
-			pOutParams->retImg = getInternalImage(romData, RomData::IMG_INT_ICON, &pOutParams->fullSize, &pOutParams->sBIT);
+			pOutParams->retImg = getInternalImage(romData, RomData::IMG_INT_ICON,
+				&pOutParams->fullSize, &pOutParams->sBIT, reqSize);
 			imgpf = romData->imgpf(RomData::IMG_INT_ICON);
+			sizedImgType = RomData::IMG_INT_ICON;
 			imgbf &= ~RomData::IMGBF_INT_ICON;
 
 			if (isImgClassValid(pOutParams->retImg)) {
@@ -326,12 +432,26 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 		// This image may be present.
 		if (imgType <= RomData::IMG_INT_MAX) {
 			// Internal image.
-			pOutParams->retImg = getInternalImage(romData, imgType, &pOutParams->fullSize, &pOutParams->sBIT);
+			pOutParams->retImg = getInternalImage(romData, imgType,
+				&pOutParams->fullSize, &pOutParams->sBIT, reqSize);
 			imgpf = romData->imgpf(imgType);
+			sizedImgType = imgType;
 		} else {
 			// External image.
-			pOutParams->retImg = getExternalImage(romData, imgType, reqSize, &pOutParams->fullSize, &pOutParams->sBIT);
+			// PNG pass-through is only possible if the image
+			// won't be rescaled.
 			imgpf = romData->imgpf(imgType);
+			sizedImgType = -1;
+			vector<uint8_t> *const pPngData =
+				(m_pngPassthrough && !(imgpf & RomData::IMGPF_RESCALE_NEAREST))
+					? &pOutParams->pngData : nullptr;
+			pOutParams->retImg = getExternalImage(romData, imgType, reqSize,
+				&pOutParams->fullSize, &pOutParams->sBIT, pPngData);
+			if (!pOutParams->pngData.empty()) {
+				// Using the original PNG image.
+				pOutParams->thumbSize = pOutParams->fullSize;
+				return RPCT_SUCCESS;
+			}
 		}
 
 		if (isImgClassValid(pOutParams->retImg)) {
@@ -420,6 +540,19 @@ skip_image_check:
 		pOutParams->thumbSize = pOutParams->fullSize;
 	}
 
+	if (sizedImgType >= 0) {
+		// If a smaller internal image was used, report
+		// the size of the largest available image.
+		const vector<RomData::ImageSizeDef> sizeDefs =
+			romData->supportedImageSizes(static_cast<RomData::ImageType>(sizedImgType));
+		for (auto iter = sizeDefs.cbegin(); iter != sizeDefs.cend(); ++iter) {
+			if (iter->width * iter->height > pOutParams->fullSize.width * pOutParams->fullSize.height) {
+				pOutParams->fullSize.width = iter->width;
+				pOutParams->fullSize.height = iter->height;
+			}
+		}
+	}
+
 	// Image retrieved successfully.
 	return RPCT_SUCCESS;
 }
@@ -64,16 +64,38 @@ typedef enum {
  */
 typedef int (*PFN_RP_CREATE_THUMBNAIL)(const char *source_file, const char *output_file, int maximum_size);
 
+/**
+ * rp_create_thumbnail_batch() entry.
+ */
+typedef struct _RpCreateThumbnailBatchEntry {
+	const char *source_file;	// [in] Source file. (UTF-8)
+	const char *output_file;	// [in] Output file. (UTF-8)
+	int maximum_size;		// [in] Maximum size.
+	int result;			// [out] 0 on success; RpCreateThumbnailError on error.
+} RpCreateThumbnailBatchEntry;
+
+/**
+ * rp_create_thumbnail_batch() function pointer.
+ * Used for wrapper programs that don't link to libromdata directly.
+ * @param entries	[in/out] Batch entries.
+ * @param count		[in] Number of entries.
+ * @return 0 if the batch was processed (check each entry's result); non-zero on error.
+ */
+typedef int (*PFN_RP_CREATE_THUMBNAIL_BATCH)(RpCreateThumbnailBatchEntry *entries, unsigned int count);
+
 #ifdef __cplusplus
 }
 #endif
 
 #ifdef __cplusplus
 #include "librpbase/RomData.hpp"
+#include "librpbase/config/Config.hpp"
 #include "librptexture/img/rp_image.hpp"
+#include "librpthreads/Mutex.hpp"
 
 // C++ includes.
 #include <string>
+#include <vector>
 
 namespace LibRpBase {
 	class RomData;
@@ -93,6 +115,38 @@ class TCreateThumbnail
 	private:
 		RP_DISABLE_COPY(TCreateThumbnail)
 
+	public:
+		/**
+		 * Allow PNG pass-through for external images.
+		 *
+		 * If enabled, getThumbnail() may return the original
+		 * PNG image in GetThumbnailOutParams_t::pngData instead
+		 * of decoding it, if no rescaling is needed. The caller
+		 * can then write it out with RpPngWriter::copy_with_tEXt().
+		 *
+		 * @param enable True to enable; false to disable.
+		 */
+		inline void setPngPassthrough(bool enable)
+		{
+			m_pngPassthrough = enable;
+		}
+
+		/**
+		 * Use a fixed Config object for all thumbnails.
+		 *
+		 * By default, Config::instance() is called for every thumbnail,
+		 * which checks if the configuration has been modified. Batch
+		 * thumbnailers can set this once so every thumbnail in the batch
+		 * uses the same configuration. The image type priority for each
+		 * RomData class is then only looked up once.
+		 *
+		 * NOTE: If a fixed Config object is set, getThumbnail()
+		 * can be called from multiple threads at the same time.
+		 *
+		 * @param config Config object, or nullptr to use Config::instance().
+		 */
+		void setConfig(const LibRpBase::Config *config);
+
 	public:
 		/**
 		 * Image size struct.
@@ -104,16 +158,23 @@ class TCreateThumbnail
 
 		/**
 		 * Get an internal image.
+		 *
+		 * If req_size is specified, and the RomData object has
+		 * multiple image sizes available, the smallest image that's
+		 * at least as large as req_size will be used.
+		 *
 		 * @param romData	[in] RomData object.
 		 * @param imageType	[in] Image type.
 		 * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
 		 * @param sBIT		[out,opt] sBIT metadata.
+		 * @param req_size	[in,opt] Requested image size. (0 for the default size)
 		 * @return Internal image, or null ImgClass on error.
 		 */
 		ImgClass getInternalImage(const LibRpBase::RomData *romData,
 			LibRpBase::RomData::ImageType imageType,
 			ImgSize *pOutSize = nullptr,
-			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr);
+			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr,
+			int req_size = 0);
 
 		/**
 		 * Get an external image.
@@ -122,12 +183,15 @@ class TCreateThumbnail
 		 * @param req_size	[in] Requested image size.
 		 * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
 		 * @param sBIT		[out,opt] sBIT metadata.
-		 * @return External image, or null ImgClass on error.
+		 * @param pPngData	[out,opt] If specified, and the image is a valid PNG, the
+		 *			original PNG image is stored here instead of decoding it.
+		 * @return External image, or null ImgClass on error or if pPngData was filled.
 		 */
 		ImgClass getExternalImage(
 			const LibRpBase::RomData *romData, LibRpBase::RomData::ImageType imageType,
 			int req_size, ImgSize *pOutSize = nullptr,
-			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr);
+			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr,
+			std::vector<uint8_t> *pPngData = nullptr);
 
 		/**
 		 * getThumbnail() output parameters.
@@ -137,6 +201,8 @@ class TCreateThumbnail
 			ImgSize fullSize;			// [out] Full image size.
 			LibRpTexture::rp_image::sBIT_t sBIT;	// [out] sBIT metadata.
 			ImgClass retImg;			// [out] Returned image.
+			std::vector<uint8_t> pngData;		// [out] Original PNG image for pass-through.
+								//       If not empty, retImg is null.
 		};
 
 		/**
@@ -175,6 +241,25 @@ class TCreateThumbnail
 		 */
 		static inline void rescale_aspect(ImgSize &rs_size, const ImgSize &tgt_size);
 
+		/**
+		 * Get the Config object.
+		 * @return Config object.
+		 */
+		inline const LibRpBase::Config *config(void) const
+		{
+			return (m_config ? m_config : LibRpBase::Config::instance());
+		}
+
+		/**
+		 * Get the image type priority for a RomData object.
+		 * If a fixed Config object is set, the result is cached.
+		 * @param romData	[in] RomData object.
+		 * @param imgTypePrio	[out] Image type priority data.
+		 * @return ImgTypeResult
+		 */
+		LibRpBase::Config::ImgTypeResult getImgTypePrio(const LibRpBase::RomData *romData,
+			LibRpBase::Config::ImgTypePrio_t *imgTypePrio);
+
 	protected:
 		/** Pure virtual functions. **/
 
@@ -229,6 +314,23 @@ class TCreateThumbnail
 		 * @return Proxy, or empty string if no proxy is needed.
 		 */
 		virtual std::string proxyForUrl(const std::string &url) const = 0;
+
+	private:
+		// Allow PNG pass-through for external images.
+		bool m_pngPassthrough;
+
+		// Fixed Config object. (If nullptr, use Config::instance().)
+		const LibRpBase::Config *m_config;
+
+		// Image type priority cache. Only used with a fixed Config object.
+		// Key is RomData::className(), which is a static string.
+		struct ImgTypePrioCache_t {
+			const char *className;
+			LibRpBase::Config::ImgTypeResult res;
+			LibRpBase::Config::ImgTypePrio_t imgTypePrio;
+		};
+		std::vector<ImgTypePrioCache_t> m_imgTypePrioCache;
+		LibRpBase::Mutex m_imgTypePrioMutex;
 };
 
 }
@@ -0,0 +1,262 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * Unice68HeadTest.cpp: unice68_depacker_head() test.                      *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * SNDH uses unice68_depacker_head() to depack only the header
+ * of ICE-packed files. It uses a sliding window instead of
+ * depacking the entire file if the depacked size is larger
+ * than about 111 KB, so the test buffers are larger than that.
+ *
+ * Each buffer is packed with unice68_packer(), and the output
+ * of unice68_depacker_head() is compared to the first N bytes
+ * of the original buffer and of unice68_depacker().
+ */
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// unice68
+#include "unice68.h"
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+enum Unice68HeadTest_pattern {
+	PATTERN_MIXED,	// Literals, runs, and back-references.
+	PATTERN_RANDOM,	// Incompressible. (literals only)
+	PATTERN_ZEROES,	// Highly compressible. (long strings only)
+};
+
+struct Unice68HeadTest_mode
+{
+	int size;	// Depacked size.
+	Unice68HeadTest_pattern pattern;
+
+	Unice68HeadTest_mode(int size, Unice68HeadTest_pattern pattern)
+		: size(size)
+		, pattern(pattern)
+	{ }
+};
+
+class Unice68HeadTest : public ::testing::TestWithParam<Unice68HeadTest_mode>
+{
+	protected:
+		void SetUp(void) final;
+
+	public:
+		/**
+		 * Generate the test data.
+		 * A simple LCG is used so the data is reproducible.
+		 * @param buf		[out] Output buffer.
+		 * @param size		[in] Size.
+		 * @param pattern	[in] Data pattern.
+		 */
+		static void generate(vector<uint8_t> &buf, int size, Unice68HeadTest_pattern pattern);
+
+		/**
+		 * Test case suffix generator.
+		 * @param info Test parameter information.
+		 * @return Test case suffix.
+		 */
+		static string test_case_suffix_generator(const ::testing::TestParamInfo<Unice68HeadTest_mode> &info);
+
+	public:
+		vector<uint8_t> original;	// Original data.
+		vector<uint8_t> packed;		// ICE-packed data.
+		vector<uint8_t> depacked;	// Fully depacked data.
+};
+
+/**
+ * Generate the test data.
+ * A simple LCG is used so the data is reproducible.
+ * @param buf		[out] Output buffer.
+ * @param size		[in] Size.
+ * @param pattern	[in] Data pattern.
+ */
+void Unice68HeadTest::generate(vector<uint8_t> &buf, int size, Unice68HeadTest_pattern pattern)
+{
+	buf.resize(size);
+	uint32_t seed = 0x12345678U + static_cast<uint32_t>(size);
+	#define LCG_NEXT() (seed = (seed * 1103515245U) + 12345U)
+
+	switch (pattern) {
+		case PATTERN_ZEROES:
+			memset(buf.data(), 0, buf.size());
+			break;
+
+		case PATTERN_RANDOM:
+			for (int i = 0; i < size; i++) {
+				buf[i] = static_cast<uint8_t>(LCG_NEXT() >> 16);
+			}
+			break;
+
+		case PATTERN_MIXED:
+		default:
+			for (int i = 0; i < size; ) {
+				// Select a block type and length.
+				const uint32_t sel = LCG_NEXT();
+				const int type = (sel >> 16) & 3;
+				const int len = static_cast<int>((sel >> 20) & 0xFF) + 1;
+				for (int j = 0; j < len && i < size; j++, i++) {
+					if (type == 0) {
+						// Run of a single byte.
+						buf[i] = static_cast<uint8_t>(sel >> 8);
+					} else if (type == 1 && i >= 300) {
+						// Back-reference.
+						buf[i] = buf[i - 300];
+					} else {
+						// Literal.
+						buf[i] = static_cast<uint8_t>(LCG_NEXT() >> 16);
+					}
+				}
+			}
+			break;
+	}
+	#undef LCG_NEXT
+}
+
+/**
+ * SetUp() function.
+ * Run before each test.
+ */
+void Unice68HeadTest::SetUp(void)
+{
+	const Unice68HeadTest_mode &mode = GetParam();
+	generate(original, mode.size, mode.pattern);
+
+	// Pack the data.
+	// NOTE: unice68_packer() doesn't check for output buffer overflow,
+	// so leave plenty of room for incompressible data.
+	packed.resize(mode.size + (mode.size / 8) + 1024);
+	const int csize = unice68_packer(packed.data(), static_cast<int>(packed.size()),
+		original.data(), mode.size);
+	ASSERT_GT(csize, 0);
+	ASSERT_LE(csize, static_cast<int>(packed.size()));
+	packed.resize(csize);
+
+	// Depack the entire buffer.
+	int csize_hdr = 0;
+	ASSERT_EQ(mode.size, unice68_depacked_size(packed.data(), &csize_hdr));
+	ASSERT_EQ(csize, csize_hdr);
+	depacked.resize(mode.size);
+	ASSERT_EQ(0, unice68_depacker(depacked.data(), packed.data()));
+	ASSERT_TRUE(original == depacked) << "unice68_depacker() output doesn't match the original data.";
+}
+
+/**
+ * Depack the first N bytes, for various values of N.
+ * NOTE: All of the checks are in a single test, since
+ * unice68_packer() is slow with large buffers.
+ */
+TEST_P(Unice68HeadTest, depackHead)
+{
+	const int size = GetParam().size;
+	const int head_sizes[] = {
+		1, 4096, 0x2000, 65536, 100*1024,
+		size / 2, size - 1, size,
+	};
+
+	vector<uint8_t> head;
+	for (size_t i = 0; i < sizeof(head_sizes)/sizeof(head_sizes[0]); i++) {
+		const int head_size = head_sizes[i];
+		if (head_size <= 0 || head_size > size)
+			continue;
+
+		// Fill the buffer with garbage to catch bytes that weren't written.
+		head.assign(head_size, 0xA5);
+		ASSERT_EQ(0, unice68_depacker_head(head.data(), head_size,
+			packed.data(), static_cast<int>(packed.size())))
+			<< "head_size == " << head_size;
+		EXPECT_EQ(0, memcmp(depacked.data(), head.data(), head_size))
+			<< "head_size == " << head_size;
+	}
+
+	// Requesting more than the depacked size only writes the depacked size.
+	head.assign(size + 4096, 0xA5);
+	ASSERT_EQ(0, unice68_depacker_head(head.data(), static_cast<int>(head.size()),
+		packed.data(), static_cast<int>(packed.size())));
+	EXPECT_EQ(0, memcmp(depacked.data(), head.data(), size));
+	for (size_t i = size; i < head.size(); i++) {
+		ASSERT_EQ(0xA5, head[i]) << "Byte " << i << " past the depacked data was modified.";
+	}
+
+	// Truncated input must fail instead of reading out of bounds.
+	head.resize(4096);
+	EXPECT_EQ(-1, unice68_depacker_head(head.data(), static_cast<int>(head.size()),
+		packed.data(), static_cast<int>(packed.size()) - 1));
+}
+
+/**
+ * Test case suffix generator.
+ * @param info Test parameter information.
+ * @return Test case suffix.
+ */
+string Unice68HeadTest::test_case_suffix_generator(const ::testing::TestParamInfo<Unice68HeadTest_mode> &info)
+{
+	static const char *const pattern_names[] = {"mixed", "random", "zeroes"};
+	char buf[64];
+	snprintf(buf, sizeof(buf), "%s_%dK", pattern_names[info.param.pattern], info.param.size / 1024);
+	return buf;
+}
+
+// Depacked sizes around and above the sliding window threshold.
+INSTANTIATE_TEST_CASE_P(Mixed, Unice68HeadTest,
+	::testing::Values(
+		Unice68HeadTest_mode(100*1024, PATTERN_MIXED),
+		Unice68HeadTest_mode(112*1024, PATTERN_MIXED),
+		Unice68HeadTest_mode(128*1024, PATTERN_MIXED),
+		Unice68HeadTest_mode(256*1024, PATTERN_MIXED))
+	, Unice68HeadTest::test_case_suffix_generator);
+
+INSTANTIATE_TEST_CASE_P(Random, Unice68HeadTest,
+	::testing::Values(
+		Unice68HeadTest_mode(128*1024, PATTERN_RANDOM))
+	, Unice68HeadTest::test_case_suffix_generator);
+
+INSTANTIATE_TEST_CASE_P(Zeroes, Unice68HeadTest,
+	::testing::Values(
+		Unice68HeadTest_mode(128*1024, PATTERN_ZEROES),
+		Unice68HeadTest_mode(256*1024, PATTERN_ZEROES))
+	, Unice68HeadTest::test_case_suffix_generator);
+
+// Larger buffers.
+// NOTE: unice68_packer() is slow with large buffers,
+// so these are excluded from ctest.
+INSTANTIATE_TEST_CASE_P(Large_benchmark, Unice68HeadTest,
+	::testing::Values(
+		Unice68HeadTest_mode(1024*1024, PATTERN_MIXED),
+		Unice68HeadTest_mode(2048*1024, PATTERN_MIXED),
+		Unice68HeadTest_mode(256*1024, PATTERN_RANDOM),
+		Unice68HeadTest_mode(512*1024, PATTERN_RANDOM),
+		Unice68HeadTest_mode(1024*1024, PATTERN_ZEROES))
+	, Unice68HeadTest::test_case_suffix_generator);
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: unice68_depacker_head() tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * RomDataFactoryTest.cpp: RomDataFactory precomputed list test.           *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * RomDataFactory::supportedFileExtensions() and supportedMimeTypes()
+ * use precomputed tables from RomDataFactory_lists.h in order to
+ * avoid querying every RomData subclass at startup.
+ *
+ * This test verifies that the precomputed tables match the lists
+ * returned by the RomData subclasses. If they don't match, a new
+ * RomDataFactory_lists.h is written to the current directory.
+ * Copy it to src/libromdata/ and rebuild.
+ */
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// RomDataFactory
+#include "libromdata/RomDataFactory.hpp"
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <unordered_map>
+#include <vector>
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+class RomDataFactoryTest : public ::testing::Test
+{
+	public:
+		/**
+		 * Write a new RomDataFactory_lists.h to the current directory.
+		 * @param vec_exts File extensions.
+		 * @param vec_mimeTypes MIME types.
+		 * @return 0 on success; non-zero on error.
+		 */
+		static int writeListsHeader(const vector<RomDataFactory::ExtInfo> &vec_exts,
+					    const vector<const char*> &vec_mimeTypes);
+};
+
+/**
+ * Write a new RomDataFactory_lists.h to the current directory.
+ * @param vec_exts File extensions.
+ * @param vec_mimeTypes MIME types.
+ * @return 0 on success; non-zero on error.
+ */
+int RomDataFactoryTest::writeListsHeader(const vector<RomDataFactory::ExtInfo> &vec_exts,
+					 const vector<const char*> &vec_mimeTypes)
+{
+	// Build the string pool.
+	// Offset 0 is the empty string.
+	vector<const char*> pool;
+	unordered_map<string, unsigned int> map_offsets;
+	unsigned int pool_size = 1;
+	auto addString = [&](const char *str) -> unsigned int {
+		auto iter = map_offsets.find(str);
+		if (iter != map_offsets.end())
+			return iter->second;
+		const unsigned int offset = pool_size;
+		map_offsets.emplace(str, offset);
+		pool.push_back(str);
+		pool_size += static_cast<unsigned int>(strlen(str)) + 1;
+		return offset;
+	};
+
+	vector<unsigned int> ext_offsets;
+	ext_offsets.reserve(vec_exts.size());
+	for (const auto &ext : vec_exts) {
+		ext_offsets.push_back(addString(ext.ext));
+	}
+	vector<unsigned int> mime_offsets;
+	mime_offsets.reserve(vec_mimeTypes.size());
+	for (const char *mimeType : vec_mimeTypes) {
+		mime_offsets.push_back(addString(mimeType));
+	}
+	if (pool_size > 0x10000) {
+		fprintf(stderr, "*** ERROR: String pool is too large for uint16_t offsets.\n");
+		return -1;
+	}
+
+	FILE *f = fopen("RomDataFactory_lists.h", "w");
+	if (!f) {
+		fprintf(stderr, "*** ERROR: Unable to open RomDataFactory_lists.h for writing.\n");
+		return -1;
+	}
+
+	fputs("/** RomDataFactory_lists.h: Generated by RomDataFactoryTest. **/\n"
+	      "/** DO NOT EDIT! See RomDataFactoryTest.cpp for instructions. **/\n"
+	      "\n"
+	      "#ifndef __ROMPROPERTIES_LIBROMDATA_ROMDATAFACTORY_LISTS_H__\n"
+	      "#define __ROMPROPERTIES_LIBROMDATA_ROMDATAFACTORY_LISTS_H__\n"
+	      "\n"
+	      "#include <stdint.h>\n"
+	      "\n"
+	      "// String pool.\n"
+	      "static const char RomDataFactory_strtbl[] =\n"
+	      "\t\"\\0\"", f);
+	for (const char *str : pool) {
+		fprintf(f, "\n\t\"%s\\0\"", str);
+	}
+	fputs(";\n"
+	      "\n"
+	      "// Supported file extensions: {string pool offset, attributes}\n"
+	      "static const struct {\n"
+	      "\tuint16_t ext;\n"
+	      "\tuint16_t attrs;\n"
+	      "} RomDataFactory_exts[] = {\n", f);
+	for (size_t i = 0; i < vec_exts.size(); i++) {
+		fprintf(f, "\t{%u, 0x%04X},\t// %s\n", ext_offsets[i],
+			vec_exts[i].attrs, vec_exts[i].ext);
+	}
+	fputs("};\n"
+	      "\n"
+	      "// Supported MIME types: string pool offset\n"
+	      "static const uint16_t RomDataFactory_mimeTypes[] = {\n", f);
+	for (size_t i = 0; i < vec_mimeTypes.size(); i++) {
+		fprintf(f, "\t%u,\t// %s\n", mime_offsets[i], vec_mimeTypes[i]);
+	}
+	fputs("};\n"
+	      "\n"
+	      "#endif /* __ROMPROPERTIES_LIBROMDATA_ROMDATAFACTORY_LISTS_H__ */\n", f);
+	fclose(f);
+	return 0;
+}
+
+/**
+ * Verify the precomputed file extension and MIME type lists.
+ */
+TEST_F(RomDataFactoryTest, precomputedLists)
+{
+	const vector<RomDataFactory::ExtInfo> &vec_exts = RomDataFactory::supportedFileExtensions();
+	const vector<const char*> &vec_mimeTypes = RomDataFactory::supportedMimeTypes();
+	const vector<RomDataFactory::ExtInfo> vec_exts_enum = RomDataFactory::enumSupportedFileExtensions();
+	const vector<const char*> vec_mimeTypes_enum = RomDataFactory::enumSupportedMimeTypes();
+
+	bool match = (vec_exts.size() == vec_exts_enum.size() &&
+		      vec_mimeTypes.size() == vec_mimeTypes_enum.size());
+	for (size_t i = 0; match && i < vec_exts.size(); i++) {
+		match = (!strcmp(vec_exts[i].ext, vec_exts_enum[i].ext) &&
+			 vec_exts[i].attrs == vec_exts_enum[i].attrs);
+	}
+	for (size_t i = 0; match && i < vec_mimeTypes.size(); i++) {
+		match = !strcmp(vec_mimeTypes[i], vec_mimeTypes_enum[i]);
+	}
+
+	if (!match) {
+		// Write a new RomDataFactory_lists.h.
+		if (writeListsHeader(vec_exts_enum, vec_mimeTypes_enum) == 0) {
+			fprintf(stderr, "*** RomDataFactory_lists.h is out of date.\n"
+				"*** A new version has been written to the current directory.\n"
+				"*** Copy it to src/libromdata/ and rebuild.\n");
+		}
+	}
+	ASSERT_TRUE(match) << "RomDataFactory_lists.h is out of date.";
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: RomDataFactory tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
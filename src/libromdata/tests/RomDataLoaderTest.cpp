@@ -0,0 +1,228 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * RomDataLoaderTest.cpp: RomDataLoader test.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// RomDataLoader
+#include "libromdata/RomDataLoader.hpp"
+#include "libromdata/Handheld/gba_structs.h"
+
+// librpcpu, librpbase, librpfile, librpthreads
+#include "librpcpu/byteswap.h"
+#include "librpbase/RomData.hpp"
+#include "librpbase/RomFields.hpp"
+#include "librpfile/RpMemFile.hpp"
+#include "librpthreads/Mutex.hpp"
+#include "librpthreads/Semaphore.hpp"
+using namespace LibRpBase;
+using LibRpFile::RpMemFile;
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <vector>
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+class RomDataLoaderTest : public ::testing::Test
+{
+	protected:
+		RomDataLoaderTest()
+			: sem(0)
+		{ }
+
+	public:
+		// Notified stages.
+		Mutex mutex;
+		vector<RomDataLoader::Stage> stages;
+		// Released when the final stage is notified.
+		Semaphore sem;
+
+		/**
+		 * Stage notification function.
+		 * @param loader RomDataLoader.
+		 * @param stage Stage.
+		 * @param userdata RomDataLoaderTest.
+		 */
+		static void notifyFn(RomDataLoader *loader, RomDataLoader::Stage stage, void *userdata)
+		{
+			RP_UNUSED(loader);
+			RomDataLoaderTest *const test = static_cast<RomDataLoaderTest*>(userdata);
+			{
+				MutexLocker locker(test->mutex);
+				test->stages.push_back(stage);
+			}
+			if (stage == RomDataLoader::STAGE_IMAGES || stage == RomDataLoader::STAGE_ERROR) {
+				test->sem.release();
+			}
+		}
+
+		/**
+		 * Generate a Game Boy Advance ROM image.
+		 * @return ROM image.
+		 */
+		static vector<uint8_t> generateGBA(void)
+		{
+			static const uint8_t nintendo_gba_logo[16] = {
+				0x24, 0xFF, 0xAE, 0x51, 0x69, 0x9A, 0xA2, 0x21,
+				0x3D, 0x84, 0x82, 0x0A, 0x84, 0xE4, 0x09, 0xAD
+			};
+
+			vector<uint8_t> buf(0x8000);
+			GBA_RomHeader *const romHeader = reinterpret_cast<GBA_RomHeader*>(buf.data());
+			romHeader->entry_point = cpu_to_le32(0xEA00002E);	// b 0x080000C0
+			memcpy(romHeader->nintendo_logo, nintendo_gba_logo, sizeof(nintendo_gba_logo));
+			memcpy(romHeader->title, "RPTEST      ", sizeof(romHeader->title));
+			memcpy(romHeader->id6, "RPTE01", sizeof(romHeader->id6));
+			romHeader->fixed_96h = 0x96;
+			return buf;
+		}
+};
+
+/**
+ * Load a supported ROM image.
+ * All stages should be notified in order.
+ */
+TEST_F(RomDataLoaderTest, supportedTest)
+{
+	const vector<uint8_t> rom = generateGBA();
+	RpMemFile *const memFile = new RpMemFile(rom.data(), rom.size());
+	RomDataLoader *const loader = new RomDataLoader(memFile);
+	memFile->unref();
+
+	ASSERT_EQ(0, loader->start(notifyFn, this));
+	sem.obtain();
+
+	ASSERT_EQ(3U, stages.size());
+	EXPECT_EQ(RomDataLoader::STAGE_HEADER, stages[0]);
+	EXPECT_EQ(RomDataLoader::STAGE_FIELDS, stages[1]);
+	EXPECT_EQ(RomDataLoader::STAGE_IMAGES, stages[2]);
+
+	RomData *const romData = loader->romData();
+	ASSERT_TRUE(romData != nullptr);
+	EXPECT_TRUE(romData->isValid());
+	// The file should have been closed by the loader.
+	EXPECT_FALSE(romData->isOpen());
+	const RomFields *const fields = romData->fields();
+	ASSERT_TRUE(fields != nullptr);
+	EXPECT_GT(fields->count(), 0);
+
+	// Can't start the same loader twice.
+	EXPECT_EQ(-EBUSY, loader->start(notifyFn, this));
+	loader->unref();
+}
+
+/**
+ * Load an unsupported file.
+ * Only STAGE_ERROR should be notified.
+ */
+TEST_F(RomDataLoaderTest, unsupportedTest)
+{
+	const vector<uint8_t> data(0x8000, 0x5A);
+	RpMemFile *const memFile = new RpMemFile(data.data(), data.size());
+	RomDataLoader *const loader = new RomDataLoader(memFile);
+	memFile->unref();
+
+	ASSERT_EQ(0, loader->start(notifyFn, this));
+	sem.obtain();
+
+	ASSERT_EQ(1U, stages.size());
+	EXPECT_EQ(RomDataLoader::STAGE_ERROR, stages[0]);
+	EXPECT_TRUE(loader->romData() == nullptr);
+	loader->unref();
+}
+
+/**
+ * Cancel a loader before it's started.
+ * Nothing should be notified.
+ */
+TEST_F(RomDataLoaderTest, cancelTest)
+{
+	const vector<uint8_t> rom = generateGBA();
+	RpMemFile *const memFile = new RpMemFile(rom.data(), rom.size());
+	RomDataLoader *const loader = new RomDataLoader(memFile);
+	memFile->unref();
+
+	loader->cancel();
+	EXPECT_TRUE(loader->isCancelled());
+	ASSERT_EQ(0, loader->start(notifyFn, this));
+	loader->unref();
+
+	// Start a second loader, so there's something to wait on.
+	const vector<uint8_t> data(0x8000, 0x5A);
+	RpMemFile *const memFile2 = new RpMemFile(data.data(), data.size());
+	RomDataLoader *const loader2 = new RomDataLoader(memFile2);
+	memFile2->unref();
+	ASSERT_EQ(0, loader2->start(notifyFn, this));
+	sem.obtain();
+	loader2->unref();
+
+	// Only the second loader's notification should be present.
+	MutexLocker locker(mutex);
+	ASSERT_EQ(1U, stages.size());
+	EXPECT_EQ(RomDataLoader::STAGE_ERROR, stages[0]);
+}
+
+/**
+ * Test start() error handling.
+ */
+TEST_F(RomDataLoaderTest, startErrorTest)
+{
+	const vector<uint8_t> rom = generateGBA();
+	RpMemFile *const memFile = new RpMemFile(rom.data(), rom.size());
+	RomDataLoader *const loader = new RomDataLoader(memFile);
+	memFile->unref();
+
+	// No notification function.
+	EXPECT_EQ(-EINVAL, loader->start(nullptr, this));
+	loader->unref();
+
+	// No file.
+	RomDataLoader *const loader2 = new RomDataLoader(static_cast<LibRpFile::IRpFile*>(nullptr));
+	EXPECT_EQ(-EBADF, loader2->start(notifyFn, this));
+	loader2->unref();
+}
+
+/**
+ * Each loader must have a unique ID.
+ */
+TEST_F(RomDataLoaderTest, idTest)
+{
+	RomDataLoader *const loader = new RomDataLoader(static_cast<LibRpFile::IRpFile*>(nullptr));
+	RomDataLoader *const loader2 = new RomDataLoader(static_cast<LibRpFile::IRpFile*>(nullptr));
+	EXPECT_NE(loader->id(), loader2->id());
+
+	// The ID doesn't change when the loader is cancelled.
+	const unsigned int id = loader->id();
+	loader->cancel();
+	EXPECT_EQ(id, loader->id());
+
+	loader->unref();
+	loader2->unref();
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: RomDataLoader tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,614 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * BenchCorpus.cpp: Synthetic ROM corpus for RomDataBenchmark.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "BenchCorpus.hpp"
+#include "libromdata/config.libromdata.h"
+
+// librpcpu
+#include "librpcpu/byteswap.h"
+
+// librpfile
+#include "librpfile/FileSystem.hpp"
+
+// Structs.
+#include "libromdata/Handheld/nds_structs.h"
+#include "libromdata/Handheld/gba_structs.h"
+#include "libromdata/Console/gcn_structs.h"
+#include "libromdata/Console/gcn_banner.h"
+#include "libromdata/Other/elf_structs.h"
+#include "libromdata/Other/exe_structs.h"
+#include "libromdata/iso_structs.h"
+#include "librptexture/fileformat/dds_structs.h"
+#include "librptexture/fileformat/ktx_structs.h"
+#include "librptexture/fileformat/pvr3_structs.h"
+#include "librptexture/fileformat/gl_defs.h"
+
+// zlib
+#include <zlib.h>
+
+#ifdef ENABLE_UNICE68
+// unice68
+#include "unice68.h"
+#endif /* ENABLE_UNICE68 */
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+/**
+ * Deterministic pseudo-random number generator.
+ * This is a simple LCG; it only needs to generate
+ * "noisy" image data, not good random numbers.
+ */
+class BenchRandom
+{
+	public:
+		explicit BenchRandom(uint32_t seed)
+			: m_state(seed) { }
+
+		inline uint32_t next(void)
+		{
+			m_state = m_state * 1103515245U + 12345U;
+			return m_state;
+		}
+
+		/**
+		 * Fill a buffer with pseudo-random data.
+		 * @param ptr Buffer.
+		 * @param size Size of buffer, in bytes.
+		 */
+		void fill(void *ptr, size_t size)
+		{
+			uint8_t *p = static_cast<uint8_t*>(ptr);
+			for (; size > 0; size--, p++) {
+				*p = static_cast<uint8_t>(next() >> 16);
+			}
+		}
+
+	private:
+		uint32_t m_state;
+};
+
+// First 16 bytes of the Nintendo logo. (GBA and NDS)
+// NOTE: The rest of the logo isn't checked by the detection code.
+static const uint8_t nintendo_gba_logo[16] = {
+	0x24, 0xFF, 0xAE, 0x51, 0x69, 0x9A, 0xA2, 0x21,
+	0x3D, 0x84, 0x82, 0x0A, 0x84, 0xE4, 0x09, 0xAD
+};
+
+/**
+ * Copy a string into a fixed-size, non-NULL-terminated field.
+ * @param dest Destination field.
+ * @param size Size of destination field.
+ * @param src Source string.
+ */
+static void setField(char *dest, size_t size, const char *src)
+{
+	const size_t len = strlen(src);
+	memset(dest, ' ', size);
+	memcpy(dest, src, (len < size ? len : size));
+}
+
+/**
+ * Generate a Nintendo DS ROM image with an icon/title section.
+ * @return ROM image.
+ */
+static vector<uint8_t> generateNDS(void)
+{
+	// The icon/title section must be located after the secure area.
+	static const uint32_t icon_offset = 0x8200;
+	vector<uint8_t> buf(0x10000);
+
+	NDS_RomHeader *const romHeader = reinterpret_cast<NDS_RomHeader*>(buf.data());
+	setField(romHeader->title, sizeof(romHeader->title), "RPBENCH");
+	memcpy(romHeader->id6, "BNCE01", sizeof(romHeader->id6));
+	romHeader->icon_offset = cpu_to_le32(icon_offset);
+	romHeader->rom_header_size = cpu_to_le32(0x4000);
+	romHeader->total_used_rom_size = cpu_to_le32(static_cast<uint32_t>(buf.size()));
+	memcpy(romHeader->nintendo_logo, nintendo_gba_logo, sizeof(nintendo_gba_logo));
+	romHeader->nintendo_logo_checksum = cpu_to_le16(0xCF56);
+
+	NDS_IconTitleData *const iconTitle = reinterpret_cast<NDS_IconTitleData*>(&buf[icon_offset]);
+	iconTitle->version = cpu_to_le16(NDS_ICON_VERSION_ORIGINAL);
+	BenchRandom rng(0x4E445300);	// 'NDS\0'
+	rng.fill(iconTitle->icon_data, sizeof(iconTitle->icon_data));
+	for (unsigned int i = 0; i < ARRAY_SIZE(iconTitle->icon_pal); i++) {
+		iconTitle->icon_pal[i] = cpu_to_le16(static_cast<uint16_t>(rng.next() >> 16) & 0x7FFF);
+	}
+
+	// Title: "RPBENCH\nSynthetic\nrom-properties" in all languages.
+	static const char title[] = "RPBENCH\nSynthetic\nrom-properties";
+	for (unsigned int lang = 0; lang < NDS_LANG_CHINESE_SIMP; lang++) {
+		char16_t *const p = iconTitle->title[lang];
+		for (unsigned int i = 0; i < sizeof(title)-1; i++) {
+			p[i] = cpu_to_le16(static_cast<char16_t>(title[i]));
+		}
+	}
+	return buf;
+}
+
+/**
+ * Generate a Game Boy Advance ROM image.
+ * @return ROM image.
+ */
+static vector<uint8_t> generateGBA(void)
+{
+	vector<uint8_t> buf(0x10000);
+
+	GBA_RomHeader *const romHeader = reinterpret_cast<GBA_RomHeader*>(buf.data());
+	romHeader->entry_point = cpu_to_le32(0xEA00002E);	// b 0x080000C0
+	memcpy(romHeader->nintendo_logo, nintendo_gba_logo, sizeof(nintendo_gba_logo));
+	setField(romHeader->title, sizeof(romHeader->title), "RPBENCH");
+	memcpy(romHeader->id6, "BNCE01", sizeof(romHeader->id6));
+	romHeader->fixed_96h = 0x96;
+
+	// Header checksum.
+	uint8_t chk = 0;
+	for (unsigned int i = 0xA0; i <= 0xBC; i++) {
+		chk -= buf[i];
+	}
+	romHeader->checksum = chk - 0x19;
+	return buf;
+}
+
+/**
+ * Generate a GameCube disc image with an FST and opening.bnr.
+ * @return Disc image.
+ */
+static vector<uint8_t> generateGCN(void)
+{
+	static const uint32_t fst_offset = 0x10000;
+	static const uint32_t bnr_offset = 0x20000;
+	vector<uint8_t> buf(bnr_offset + sizeof(gcn_banner_bnr1_t));
+
+	// Disc header.
+	GCN_DiscHeader *const discHeader = reinterpret_cast<GCN_DiscHeader*>(buf.data());
+	memcpy(discHeader->id6, "GBNE01", sizeof(discHeader->id6));
+	discHeader->magic_gcn = cpu_to_be32(GCN_MAGIC);
+	strcpy(discHeader->game_title, "RPBENCH Synthetic GameCube Disc");
+
+	// FST: root directory and "opening.bnr".
+	static const char fst_strings[] = "opening.bnr";
+	const uint32_t fst_size = 2*sizeof(GCN_FST_Entry) + sizeof(fst_strings);
+	GCN_FST_Entry *const fst = reinterpret_cast<GCN_FST_Entry*>(&buf[fst_offset]);
+	fst[0].file_type_name_offset = cpu_to_be32(0x01000000);
+	fst[0].root_dir.file_count = cpu_to_be32(2);
+	fst[1].file_type_name_offset = cpu_to_be32(0x00000000);
+	fst[1].file.offset = cpu_to_be32(bnr_offset);
+	fst[1].file.size = cpu_to_be32(static_cast<uint32_t>(sizeof(gcn_banner_bnr1_t)));
+	memcpy(&fst[2], fst_strings, sizeof(fst_strings));
+
+	// Boot block and boot info.
+	GCN_Boot_Block *const bootBlock = reinterpret_cast<GCN_Boot_Block*>(&buf[GCN_Boot_Block_ADDRESS]);
+	bootBlock->fst_offset = cpu_to_be32(fst_offset);
+	bootBlock->fst_size = cpu_to_be32(fst_size);
+	bootBlock->fst_max_size = cpu_to_be32(fst_size);
+	GCN_Boot_Info *const bootInfo = reinterpret_cast<GCN_Boot_Info*>(&buf[GCN_Boot_Info_ADDRESS]);
+	bootInfo->region_code = cpu_to_be32(GCN_REGION_USA);
+
+	// opening.bnr (BNR1)
+	gcn_banner_bnr1_t *const bnr = reinterpret_cast<gcn_banner_bnr1_t*>(&buf[bnr_offset]);
+	bnr->magic = cpu_to_be32(GCN_BANNER_MAGIC_BNR1);
+	BenchRandom rng(0x47434E00);	// 'GCN\0'
+	rng.fill(bnr->banner, sizeof(bnr->banner));
+	strcpy(bnr->comment.gamename, "RPBENCH");
+	strcpy(bnr->comment.company, "rom-properties");
+	strcpy(bnr->comment.gamename_full, "RPBENCH Synthetic GameCube Disc");
+	strcpy(bnr->comment.company_full, "rom-properties");
+	strcpy(bnr->comment.gamedesc, "Synthetic disc image for benchmarking.");
+	return buf;
+}
+
+/**
+ * Generate an unencrypted Wii disc image header.
+ * No partitions are present, so only the disc header is parsed.
+ * @return Disc image.
+ */
+static vector<uint8_t> generateWii(void)
+{
+	vector<uint8_t> buf(0x50000);
+
+	GCN_DiscHeader *const discHeader = reinterpret_cast<GCN_DiscHeader*>(buf.data());
+	memcpy(discHeader->id6, "RBNE01", sizeof(discHeader->id6));
+	discHeader->magic_wii = cpu_to_be32(WII_MAGIC);
+	strcpy(discHeader->game_title, "RPBENCH Synthetic Wii Disc");
+	discHeader->hash_verify = 1;
+	discHeader->disc_noCrypto = 1;
+	return buf;
+}
+
+/**
+ * Generate a DDS texture. (DXT1, 256x256)
+ * @return DDS texture.
+ */
+static vector<uint8_t> generateDDS(void)
+{
+	static const unsigned int width = 256, height = 256;
+	static const unsigned int img_siz = (width * height) / 2;
+	vector<uint8_t> buf(4 + sizeof(DDS_HEADER) + img_siz);
+
+	const uint32_t magic = cpu_to_be32(DDS_MAGIC);
+	memcpy(buf.data(), &magic, sizeof(magic));
+
+	DDS_HEADER *const ddsHeader = reinterpret_cast<DDS_HEADER*>(&buf[4]);
+	ddsHeader->dwSize = cpu_to_le32(static_cast<uint32_t>(sizeof(*ddsHeader)));
+	ddsHeader->dwFlags = cpu_to_le32(DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE);
+	ddsHeader->dwHeight = cpu_to_le32(height);
+	ddsHeader->dwWidth = cpu_to_le32(width);
+	ddsHeader->dwPitchOrLinearSize = cpu_to_le32(img_siz);
+	ddsHeader->ddspf.dwSize = cpu_to_le32(static_cast<uint32_t>(sizeof(ddsHeader->ddspf)));
+	ddsHeader->ddspf.dwFlags = cpu_to_le32(DDPF_FOURCC);
+	ddsHeader->ddspf.dwFourCC = cpu_to_be32(DDPF_FOURCC_DXT1);
+	ddsHeader->dwCaps = cpu_to_le32(DDSCAPS_TEXTURE);
+
+	BenchRandom rng(0x44445300);	// 'DDS\0'
+	rng.fill(&buf[4 + sizeof(DDS_HEADER)], img_siz);
+	return buf;
+}
+
+/**
+ * Generate a KTX texture. (RGBA8888, 256x256)
+ * @return KTX texture.
+ */
+static vector<uint8_t> generateKTX(void)
+{
+	static const unsigned int width = 256, height = 256;
+	static const uint32_t img_siz = width * height * 4;
+	vector<uint8_t> buf(sizeof(KTX_Header) + sizeof(uint32_t) + img_siz);
+
+	KTX_Header *const ktxHeader = reinterpret_cast<KTX_Header*>(buf.data());
+	memcpy(ktxHeader->identifier, KTX_IDENTIFIER, sizeof(ktxHeader->identifier));
+	ktxHeader->endianness = KTX_ENDIAN_MAGIC;
+	ktxHeader->glType = GL_UNSIGNED_BYTE;
+	ktxHeader->glTypeSize = 1;
+	ktxHeader->glFormat = GL_RGBA;
+	ktxHeader->glInternalFormat = GL_RGBA8;
+	ktxHeader->glBaseInternalFormat = GL_RGBA;
+	ktxHeader->pixelWidth = width;
+	ktxHeader->pixelHeight = height;
+	ktxHeader->numberOfFaces = 1;
+	ktxHeader->numberOfMipmapLevels = 1;
+
+	// Image size field, followed by the image data.
+	// NOTE: Using a gradient instead of noise so the
+	// gzipped variant is actually compressed.
+	memcpy(&buf[sizeof(KTX_Header)], &img_siz, sizeof(img_siz));
+	uint8_t *p = &buf[sizeof(KTX_Header) + sizeof(uint32_t)];
+	for (unsigned int y = 0; y < height; y++) {
+		for (unsigned int x = 0; x < width; x++, p += 4) {
+			p[0] = static_cast<uint8_t>(x);
+			p[1] = static_cast<uint8_t>(y);
+			p[2] = static_cast<uint8_t>(x ^ y);
+			p[3] = 0xFF;
+		}
+	}
+	return buf;
+}
+
+/**
+ * Generate a PowerVR 3.0 texture. (ETC1, 256x256)
+ * @return PowerVR 3.0 texture.
+ */
+static vector<uint8_t> generatePVR3(void)
+{
+	static const unsigned int width = 256, height = 256;
+	static const unsigned int img_siz = (width * height) / 2;
+	vector<uint8_t> buf(sizeof(PowerVR3_Header) + img_siz);
+
+	PowerVR3_Header *const pvr3Header = reinterpret_cast<PowerVR3_Header*>(buf.data());
+	pvr3Header->version = PVR3_VERSION_HOST;
+	pvr3Header->pixel_format = PVR3_PXF_ETC1;
+	pvr3Header->channel_type = PVR3_CHTYPE_UBYTE_NORM;
+	pvr3Header->height = height;
+	pvr3Header->width = width;
+	pvr3Header->depth = 1;
+	pvr3Header->num_surfaces = 1;
+	pvr3Header->num_faces = 1;
+	pvr3Header->mipmap_count = 1;
+
+	BenchRandom rng(0x50565200);	// 'PVR\0'
+	rng.fill(&buf[sizeof(PowerVR3_Header)], img_siz);
+	return buf;
+}
+
+/**
+ * Generate an ISO-9660 disc image.
+ * Only the volume descriptors are present.
+ * @return Disc image.
+ */
+static vector<uint8_t> generateISO(void)
+{
+	// NOTE: RomDataFactory won't check for ISO-9660
+	// if the file is smaller than 256 KB.
+	static const unsigned int sector_count = 160;
+	vector<uint8_t> buf(sector_count * ISO_SECTOR_SIZE_MODE1_COOKED);
+
+	ISO_Primary_Volume_Descriptor *const pvd =
+		reinterpret_cast<ISO_Primary_Volume_Descriptor*>(&buf[ISO_PVD_ADDRESS_2048]);
+	pvd->header.type = ISO_VDT_PRIMARY;
+	memcpy(pvd->header.identifier, ISO_VD_MAGIC, sizeof(pvd->header.identifier));
+	pvd->header.version = ISO_VD_VERSION;
+	setField(pvd->sysID, sizeof(pvd->sysID), "RPBENCH");
+	setField(pvd->volID, sizeof(pvd->volID), "RPBENCH_ISO");
+	pvd->volume_space_size.le = cpu_to_le32(sector_count);
+	pvd->volume_space_size.be = cpu_to_be32(sector_count);
+
+	// Volume descriptor set terminator.
+	ISO_Volume_Descriptor_Header *const term =
+		reinterpret_cast<ISO_Volume_Descriptor_Header*>(&buf[ISO_PVD_ADDRESS_2048 + ISO_SECTOR_SIZE_MODE1_COOKED]);
+	term->type = ISO_VDT_TERMINATOR;
+	memcpy(term->identifier, ISO_VD_MAGIC, sizeof(term->identifier));
+	term->version = ISO_VD_VERSION;
+	return buf;
+}
+
+/**
+ * Generate a 64-bit ELF executable header.
+ * @return ELF executable.
+ */
+static vector<uint8_t> generateELF(void)
+{
+	vector<uint8_t> buf(4096);
+
+	Elf64_Ehdr *const ehdr = reinterpret_cast<Elf64_Ehdr*>(buf.data());
+	memcpy(ehdr->e_magic, "\177ELF", sizeof(ehdr->e_magic));
+	ehdr->e_class = ELFCLASS64;
+	ehdr->e_data = ELFDATA2LSB;
+	ehdr->e_elfversion = 1;
+	ehdr->e_osabi = ELFOSABI_SYSV;
+	ehdr->e_type = cpu_to_le16(ET_EXEC);
+	ehdr->e_machine = cpu_to_le16(EM_RISCV);
+	ehdr->e_version = cpu_to_le32(1);
+	ehdr->e_entry = cpu_to_le64(0x10000);
+	ehdr->e_phoff = cpu_to_le64(sizeof(Elf64_Ehdr));
+	ehdr->e_ehsize = cpu_to_le16(static_cast<uint16_t>(sizeof(Elf64_Ehdr)));
+	ehdr->e_phentsize = cpu_to_le16(static_cast<uint16_t>(sizeof(Elf64_Phdr)));
+	ehdr->e_phnum = cpu_to_le16(1);
+
+	Elf64_Phdr *const phdr = reinterpret_cast<Elf64_Phdr*>(&buf[sizeof(Elf64_Ehdr)]);
+	phdr->p_type = cpu_to_le32(PT_LOAD);
+	phdr->p_flags = cpu_to_le32(5);	// R+X
+	phdr->p_vaddr = cpu_to_le64(0x10000);
+	phdr->p_paddr = cpu_to_le64(0x10000);
+	phdr->p_filesz = cpu_to_le64(buf.size());
+	phdr->p_memsz = cpu_to_le64(buf.size());
+	phdr->p_align = cpu_to_le64(4096);
+	return buf;
+}
+
+/**
+ * Generate a PE32+ executable header.
+ * @return PE32+ executable.
+ */
+static vector<uint8_t> generatePE(void)
+{
+	static const uint32_t pe_offset = 0x80;
+	vector<uint8_t> buf(4096);
+
+	IMAGE_DOS_HEADER *const mz = reinterpret_cast<IMAGE_DOS_HEADER*>(buf.data());
+	mz->e_magic = cpu_to_be16('MZ');
+	mz->e_lfarlc = cpu_to_le16(0x40);
+	mz->e_lfanew = cpu_to_le32(pe_offset);
+
+	IMAGE_NT_HEADERS64 *const pe = reinterpret_cast<IMAGE_NT_HEADERS64*>(&buf[pe_offset]);
+	pe->Signature = cpu_to_be32(0x50450000);	// 'PE\0\0'
+	pe->FileHeader.Machine = cpu_to_le16(IMAGE_FILE_MACHINE_AMD64);
+	pe->FileHeader.SizeOfOptionalHeader = cpu_to_le16(static_cast<uint16_t>(sizeof(pe->OptionalHeader)));
+	pe->FileHeader.Characteristics = cpu_to_le16(IMAGE_FILE_EXECUTABLE_IMAGE | IMAGE_FILE_LARGE_ADDRESS_AWARE);
+	pe->OptionalHeader.Magic = cpu_to_le16(IMAGE_NT_OPTIONAL_HDR64_MAGIC);
+	pe->OptionalHeader.ImageBase = cpu_to_le64(0x140000000ULL);
+	pe->OptionalHeader.SectionAlignment = cpu_to_le32(4096);
+	pe->OptionalHeader.FileAlignment = cpu_to_le32(512);
+	pe->OptionalHeader.MajorOperatingSystemVersion = cpu_to_le16(6);
+	pe->OptionalHeader.MajorSubsystemVersion = cpu_to_le16(6);
+	pe->OptionalHeader.SizeOfImage = cpu_to_le32(4096);
+	pe->OptionalHeader.SizeOfHeaders = cpu_to_le32(512);
+	pe->OptionalHeader.Subsystem = cpu_to_le16(IMAGE_SUBSYSTEM_WINDOWS_GUI);
+	pe->OptionalHeader.NumberOfRvaAndSizes = cpu_to_le32(IMAGE_NUMBEROF_DIRECTORY_ENTRIES);
+	return buf;
+}
+
+/**
+ * Generate an Atari ST SNDH music file.
+ * The "music" is pseudo-random 68000 code with a lot
+ * of repetition, so it compresses like a real tune.
+ * @param size File size.
+ * @return SNDH file.
+ */
+static vector<uint8_t> generateSNDH(size_t size)
+{
+	static const char header[] =
+		"\x60\x0E\x00\x00"	// bra.s init
+		"\x60\x00\x00\x00"	// bra.s exit
+		"\x60\x00\x00\x00"	// bra.s play
+		"SNDH"
+		"TITLRPBENCH Synthetic Tune\0"
+		"COMMrom-properties\0"
+		"RIPPRPBENCH\0"
+		"CONVRPBENCH\0"
+		"YEAR2020\0"
+		"##01"
+		"TC50\0"
+		"\0HDNS";
+	vector<uint8_t> buf(size);
+	memcpy(buf.data(), header, sizeof(header)-1);
+
+	BenchRandom rng(0x534E4448);	// 'SNDH'
+	static const uint8_t opcodes[][4] = {
+		{0x4E, 0x75, 0x4E, 0x71},	// rts; nop
+		{0x13, 0xFC, 0x00, 0x08},	// move.b #8,(xxx).l
+		{0x30, 0x3C, 0x00, 0x10},	// move.w #$10,d0
+		{0x51, 0xC8, 0xFF, 0xFC},	// dbra d0,*-2
+		{0x00, 0xFF, 0x88, 0x00},	// YM2149 register select
+		{0x00, 0xFF, 0x88, 0x02},	// YM2149 register write
+	};
+	for (size_t i = sizeof(header)-1; i + 4 <= size; i += 4) {
+		const uint32_t r = rng.next() >> 16;
+		if ((r & 7) == 0) {
+			// Pattern data.
+			buf[i+0] = static_cast<uint8_t>(r >> 3);
+			buf[i+1] = static_cast<uint8_t>(r >> 8);
+			buf[i+2] = 0;
+			buf[i+3] = 0;
+		} else {
+			memcpy(&buf[i], opcodes[r % ARRAY_SIZE(opcodes)], 4);
+		}
+	}
+	return buf;
+}
+
+static vector<uint8_t> generateSNDH(void)
+{
+	return generateSNDH(48*1024);
+}
+
+#ifdef ENABLE_UNICE68
+/**
+ * Pack a file using ICE.
+ * @param data Unpacked data.
+ * @return Packed data, or empty vector on error.
+ */
+static vector<uint8_t> packICE(const vector<uint8_t> &data)
+{
+	// NOTE: unice68_packer() may read slightly past the end
+	// of the input buffer, and it doesn't check the output size.
+	vector<uint8_t> in(data);
+	in.resize(data.size() + 1024);
+	vector<uint8_t> out(data.size() * 2 + 1024);
+	const int size = unice68_packer(out.data(), static_cast<int>(out.size()),
+		in.data(), static_cast<int>(data.size()));
+	if (size <= 0) {
+		return vector<uint8_t>();
+	}
+	out.resize(size);
+	return out;
+}
+
+static vector<uint8_t> generateSNDH_ICE(void)
+{
+	return packICE(generateSNDH(48*1024));
+}
+
+static vector<uint8_t> generateSNDHLarge_ICE(void)
+{
+	// Large tunes with embedded samples.
+	return packICE(generateSNDH(768*1024));
+}
+#endif /* ENABLE_UNICE68 */
+
+/**
+ * Write a corpus file.
+ * @param filename	[in] Filename.
+ * @param data		[in] File data.
+ * @param gzip		[in] If true, gzip the file.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int writeCorpusFile(const string &filename, const vector<uint8_t> &data, bool gzip)
+{
+	if (gzip) {
+		// NOTE: Not using gzopen() on Windows due to filename encoding.
+		// The filenames are ASCII, so this doesn't matter here.
+		gzFile gzf = gzopen(filename.c_str(), "wb9");
+		if (!gzf) {
+			return -EIO;
+		}
+		const int ret = gzwrite(gzf, data.data(), static_cast<unsigned int>(data.size()));
+		gzclose(gzf);
+		return (ret == static_cast<int>(data.size()) ? 0 : -EIO);
+	}
+
+	FILE *f = fopen(filename.c_str(), "wb");
+	if (!f) {
+		const int err = errno;
+		return (err != 0 ? -err : -EIO);
+	}
+	const size_t size = fwrite(data.data(), 1, data.size(), f);
+	fclose(f);
+	return (size == data.size() ? 0 : -EIO);
+}
+
+/**
+ * Generate the synthetic benchmark corpus.
+ *
+ * The corpus is deterministic: the same files are generated
+ * on every run, so results can be compared across builds.
+ *
+ * @param dir	[in] Output directory. (Created if it doesn't exist.)
+ * @param files	[out] Generated files.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int generateBenchCorpus(const string &dir, vector<BenchCorpusFile> &files)
+{
+	static const struct {
+		const char *format;
+		const char *filename;
+		vector<uint8_t> (*generate)(void);
+		bool gzip;
+	} corpus[] = {
+		{"NDS",		"bench.nds",		generateNDS,	false},
+		{"NDS.gz",	"bench.nds.gz",		generateNDS,	true},
+		{"GBA",		"bench.gba",		generateGBA,	false},
+		{"GCN",		"bench_gcn.iso",	generateGCN,	false},
+		{"GCN.gz",	"bench_gcn.iso.gz",	generateGCN,	true},
+		{"Wii",		"bench_wii.iso",	generateWii,	false},
+		{"DDS",		"bench.dds",		generateDDS,	false},
+		{"DDS.gz",	"bench.dds.gz",		generateDDS,	true},
+		{"KTX",		"bench.ktx",		generateKTX,	false},
+		{"KTX.gz",	"bench.ktx.gz",		generateKTX,	true},
+		{"PVR3",	"bench.pvr",		generatePVR3,	false},
+		{"ISO",		"bench.iso",		generateISO,	false},
+		{"ELF",		"bench.elf",		generateELF,	false},
+		{"PE",		"bench.exe",		generatePE,	false},
+		{"SNDH",	"bench.sndh",		generateSNDH,	false},
+#ifdef ENABLE_UNICE68
+		{"SNDH.ice",	"bench_ice.sndh",	generateSNDH_ICE,	false},
+		{"SNDHL.ice",	"bench_large_ice.sndh",	generateSNDHLarge_ICE,	false},
+#endif /* ENABLE_UNICE68 */
+	};
+
+	string path = dir;
+	if (!path.empty() && path[path.size()-1] != DIR_SEP_CHR) {
+		path += DIR_SEP_CHR;
+	}
+	int ret = LibRpFile::FileSystem::rmkdir(path);
+	if (ret != 0) {
+		return ret;
+	}
+
+	files.clear();
+	files.reserve(ARRAY_SIZE(corpus));
+	for (unsigned int i = 0; i < ARRAY_SIZE(corpus); i++) {
+		BenchCorpusFile file;
+		file.format = corpus[i].format;
+		file.filename = path + corpus[i].filename;
+		file.gzip = corpus[i].gzip;
+
+		const vector<uint8_t> data = corpus[i].generate();
+		if (data.empty()) {
+			return -EIO;
+		}
+		file.size = data.size();
+		ret = writeCorpusFile(file.filename, data, file.gzip);
+		if (ret != 0) {
+			return ret;
+		}
+		files.push_back(file);
+	}
+	return 0;
+}
+
+} }
@@ -0,0 +1,42 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * BenchCorpus.hpp: Synthetic ROM corpus for RomDataBenchmark.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_TESTS_BENCH_BENCHCORPUS_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_TESTS_BENCH_BENCHCORPUS_HPP__
+
+// C++ includes.
+#include <string>
+#include <vector>
+
+namespace LibRomData { namespace Tests {
+
+/**
+ * Synthetic corpus file.
+ */
+struct BenchCorpusFile {
+	std::string format;	// Format name, e.g. "NDS" or "NDS.gz"
+	std::string filename;	// Full path to the generated file.
+	size_t size;		// Uncompressed file size.
+	bool gzip;		// True if the file is gzipped.
+};
+
+/**
+ * Generate the synthetic benchmark corpus.
+ *
+ * The corpus is deterministic: the same files are generated
+ * on every run, so results can be compared across builds.
+ *
+ * @param dir	[in] Output directory. (Created if it doesn't exist.)
+ * @param files	[out] Generated files.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int generateBenchCorpus(const std::string &dir, std::vector<BenchCorpusFile> &files);
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_TESTS_BENCH_BENCHCORPUS_HPP__ */
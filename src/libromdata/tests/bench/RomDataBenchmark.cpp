@@ -0,0 +1,351 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * RomDataBenchmark.cpp: End-to-end benchmark over a synthetic corpus.     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "BenchCorpus.hpp"
+using LibRomData::Tests::BenchCorpusFile;
+using LibRomData::Tests::generateBenchCorpus;
+
+// librpbase, librpfile, librptexture
+#include "librpbase/RomData.hpp"
+#include "librpbase/RomFields.hpp"
+#include "librpbase/img/RpPng.hpp"
+#include "librpfile/RpFile.hpp"
+#include "librpfile/RpVectorFile.hpp"
+#include "librptexture/img/rp_image.hpp"
+using namespace LibRpBase;
+using namespace LibRpFile;
+using LibRpTexture::rp_image;
+
+// libromdata
+#include "libromdata/RomDataFactory.hpp"
+using LibRomData::RomDataFactory;
+
+// C includes.
+#include <stdlib.h>
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// librpsecure
+#include "librpsecure/os-secure.h"
+
+// Benchmark stages.
+enum BenchStage {
+	BENCH_DETECT = 0,	// RomDataFactory::create()
+	BENCH_FIELDS,		// RomData::fields()
+	BENCH_THUMBNAIL,	// RomData::image() + rp_image::squared()
+	BENCH_PNG_FAST,		// RpPng::save(), RpPngWriter::PROFILE_FAST
+	BENCH_PNG_DEFAULT,	// RpPng::save(), RpPngWriter::PROFILE_DEFAULT
+	BENCH_PNG_SMALLEST,	// RpPng::save(), RpPngWriter::PROFILE_SMALLEST
+
+	BENCH_STAGE_MAX
+};
+
+static const char *const bench_stage_names[BENCH_STAGE_MAX] = {
+	"detect", "fields", "thumbnail",
+	"png_fast", "png_default", "png_smallest"
+};
+
+// PNG encoding profiles, in BenchStage order.
+static const RpPngWriter::Profile bench_png_profiles[RpPngWriter::PROFILE_MAX] = {
+	RpPngWriter::PROFILE_FAST,
+	RpPngWriter::PROFILE_DEFAULT,
+	RpPngWriter::PROFILE_SMALLEST,
+};
+
+/**
+ * Benchmark results for a single corpus file.
+ */
+struct BenchResult {
+	const BenchCorpusFile *file;
+	string className;	// RomData class name, or empty if not detected.
+	int fieldCount;		// Number of fields.
+	int thumbWidth;		// Thumbnail width. (0 if no thumbnail)
+	int thumbHeight;	// Thumbnail height. (0 if no thumbnail)
+	size_t pngSize[RpPngWriter::PROFILE_MAX];	// PNG size per profile, in bytes. (0 if no thumbnail)
+
+	// Per-iteration times, in nanoseconds.
+	vector<uint64_t> times[BENCH_STAGE_MAX];
+};
+
+/**
+ * Get the current time from a monotonic clock.
+ * @return Current time, in nanoseconds.
+ */
+static inline uint64_t now_ns(void)
+{
+	using namespace std::chrono;
+	return static_cast<uint64_t>(duration_cast<nanoseconds>(
+		steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Run a single benchmark iteration.
+ * @param result	[in/out] Benchmark result.
+ * @param first		[in] If true, record the file information.
+ * @return 0 on success; non-zero on error.
+ */
+static int runIteration(BenchResult &result, bool first)
+{
+	uint64_t t[BENCH_STAGE_MAX+1];
+
+	RpFile *const file = new RpFile(result.file->filename, RpFile::FM_OPEN_READ_GZ);
+	if (!file->isOpen()) {
+		file->unref();
+		return -1;
+	}
+
+	// Detection and construction.
+	t[0] = now_ns();
+	RomData *const romData = RomDataFactory::create(file);
+	t[1] = now_ns();
+	file->unref();
+	if (!romData) {
+		return -1;
+	}
+
+	// Field loading.
+	const RomFields *const fields = romData->fields();
+	t[2] = now_ns();
+
+	// Thumbnail: The first available internal image,
+	// squared, as done by the thumbnailers.
+	const rp_image *img = nullptr;
+	const uint32_t imgbf = romData->supportedImageTypes();
+	for (int i = RomData::IMG_INT_MIN; i <= RomData::IMG_INT_MAX && !img; i++) {
+		if (imgbf & (1U << i)) {
+			img = romData->image(static_cast<RomData::ImageType>(i));
+		}
+	}
+	rp_image *thumb = nullptr;
+	if (img) {
+		thumb = (img->isSquare() ? img->dup() : img->squared());
+	}
+	t[3] = now_ns();
+
+	// PNG output, using each encoding profile.
+	size_t pngSize[RpPngWriter::PROFILE_MAX] = {0, 0, 0};
+	for (int i = 0; i < RpPngWriter::PROFILE_MAX; i++) {
+		if (thumb) {
+			RpVectorFile *const pngFile = new RpVectorFile();
+			if (RpPng::save(pngFile, thumb, bench_png_profiles[i]) == 0) {
+				pngSize[i] = pngFile->vector().size();
+			}
+			pngFile->unref();
+		}
+		t[BENCH_PNG_FAST+i+1] = now_ns();
+	}
+
+	for (int i = 0; i < BENCH_STAGE_MAX; i++) {
+		result.times[i].push_back(t[i+1] - t[i]);
+	}
+
+	if (first) {
+		result.className = romData->className();
+		result.fieldCount = (fields ? fields->count() : 0);
+		if (thumb) {
+			result.thumbWidth = thumb->width();
+			result.thumbHeight = thumb->height();
+		}
+		memcpy(result.pngSize, pngSize, sizeof(result.pngSize));
+	}
+
+	delete thumb;
+	romData->unref();
+	return 0;
+}
+
+/**
+ * Get the median of a set of samples.
+ * @param samples Samples. (will be sorted)
+ * @return Median.
+ */
+static uint64_t median(vector<uint64_t> &samples)
+{
+	if (samples.empty())
+		return 0;
+	std::sort(samples.begin(), samples.end());
+	const size_t mid = samples.size() / 2;
+	if (samples.size() % 2 == 0) {
+		return (samples[mid-1] + samples[mid]) / 2;
+	}
+	return samples[mid];
+}
+
+/**
+ * Print the results as a text table.
+ * @param results Benchmark results.
+ */
+static void printText(vector<BenchResult> &results)
+{
+	printf("%-8s %-20s %6s %9s %10s %10s %10s %10s %10s %10s %22s\n",
+		"format", "class", "fields", "thumb",
+		"detect", "fields", "thumbnail", "png_fast", "png_def", "png_small",
+		"png size");
+	printf("%-8s %-20s %6s %9s %10s %10s %10s %10s %10s %10s %22s\n",
+		"", "", "", "",
+		"(us)", "(us)", "(us)", "(us)", "(us)", "(us)",
+		"(fast/def/small)");
+	for (auto iter = results.begin(); iter != results.end(); ++iter) {
+		BenchResult &result = *iter;
+		char thumb[32];
+		if (result.thumbWidth > 0) {
+			snprintf(thumb, sizeof(thumb), "%dx%d", result.thumbWidth, result.thumbHeight);
+		} else {
+			strcpy(thumb, "-");
+		}
+
+		printf("%-8s %-20s %6d %9s",
+			result.file->format.c_str(),
+			(!result.className.empty() ? result.className.c_str() : "(none)"),
+			result.fieldCount, thumb);
+		for (int i = 0; i < BENCH_STAGE_MAX; i++) {
+			printf(" %10.1f", static_cast<double>(median(result.times[i])) / 1000.0);
+		}
+		if (result.thumbWidth > 0) {
+			char pngSize[32];
+			snprintf(pngSize, sizeof(pngSize), "%u/%u/%u",
+				static_cast<unsigned int>(result.pngSize[RpPngWriter::PROFILE_FAST]),
+				static_cast<unsigned int>(result.pngSize[RpPngWriter::PROFILE_DEFAULT]),
+				static_cast<unsigned int>(result.pngSize[RpPngWriter::PROFILE_SMALLEST]));
+			printf(" %22s\n", pngSize);
+		} else {
+			printf(" %22s\n", "-");
+		}
+	}
+}
+
+/**
+ * Print the results as JSON.
+ * @param results Benchmark results.
+ * @param iterations Number of iterations.
+ */
+static void printJSON(vector<BenchResult> &results, int iterations)
+{
+	printf("{\"iterations\":%d,\"results\":[", iterations);
+	bool firstResult = true;
+	for (auto iter = results.begin(); iter != results.end(); ++iter) {
+		BenchResult &result = *iter;
+		if (!firstResult) {
+			putchar(',');
+		}
+		firstResult = false;
+
+		printf("{\"format\":\"%s\",\"class\":\"%s\",\"size\":%u,\"gzip\":%s,"
+			"\"fields\":%d,\"thumb_width\":%d,\"thumb_height\":%d,"
+			"\"png_size\":{\"fast\":%u,\"default\":%u,\"smallest\":%u},\"ns\":{",
+			result.file->format.c_str(),
+			result.className.c_str(),
+			static_cast<unsigned int>(result.file->size),
+			(result.file->gzip ? "true" : "false"),
+			result.fieldCount, result.thumbWidth, result.thumbHeight,
+			static_cast<unsigned int>(result.pngSize[RpPngWriter::PROFILE_FAST]),
+			static_cast<unsigned int>(result.pngSize[RpPngWriter::PROFILE_DEFAULT]),
+			static_cast<unsigned int>(result.pngSize[RpPngWriter::PROFILE_SMALLEST]));
+		for (int i = 0; i < BENCH_STAGE_MAX; i++) {
+			vector<uint64_t> &samples = result.times[i];
+			const unsigned long long med = median(samples);
+			const unsigned long long min = (!samples.empty() ? samples.front() : 0);
+			const unsigned long long max = (!samples.empty() ? samples.back() : 0);
+			printf("%s\"%s\":{\"min\":%llu,\"median\":%llu,\"max\":%llu}",
+				(i > 0 ? "," : ""), bench_stage_names[i], min, med, max);
+		}
+		printf("}}");
+	}
+	printf("]}\n");
+}
+
+int RP_C_API main(int argc, char *argv[])
+{
+	// Set OS-specific security options.
+	// TODO: Non-Windows syscall stuff.
+#ifdef _WIN32
+	rp_secure_param_t param;
+	param.bHighSec = FALSE;
+	rp_secure_enable(param);
+#endif /* _WIN32 */
+
+	int iterations = 20;
+	bool json = false;
+	const char *corpus_dir = "RomDataBenchmark_corpus";
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-j")) {
+			json = true;
+		} else if (!strcmp(argv[i], "-n") && i+1 < argc) {
+			iterations = atoi(argv[++i]);
+			if (iterations <= 0) {
+				fprintf(stderr, "Invalid iteration count '%s'.\n", argv[i]);
+				return EXIT_FAILURE;
+			}
+		} else if (argv[i][0] == '-') {
+			fprintf(stderr, "Syntax: %s [-j] [-n iterations] [corpus_dir]\n", argv[0]);
+			fputs("Generates a synthetic ROM corpus in corpus_dir and times\n"
+			      "detection, field loading, thumbnailing, and PNG output\n"
+			      "using each RpPngWriter encoding profile.\n"
+			      "  -j: Output the results as JSON.\n"
+			      "  -n: Number of iterations per file. (default is 20)\n", stderr);
+			return EXIT_FAILURE;
+		} else {
+			corpus_dir = argv[i];
+		}
+	}
+
+	vector<BenchCorpusFile> files;
+	int ret = generateBenchCorpus(corpus_dir, files);
+	if (ret != 0) {
+		fprintf(stderr, "*** ERROR: Unable to generate the corpus in '%s': %s\n",
+			corpus_dir, strerror(-ret));
+		return EXIT_FAILURE;
+	}
+
+	vector<BenchResult> results;
+	results.resize(files.size());
+	bool hasErrors = false;
+	for (size_t i = 0; i < files.size(); i++) {
+		BenchResult &result = results[i];
+		result.file = &files[i];
+		result.fieldCount = 0;
+		result.thumbWidth = 0;
+		result.thumbHeight = 0;
+		memset(result.pngSize, 0, sizeof(result.pngSize));
+		for (int j = 0; j < BENCH_STAGE_MAX; j++) {
+			result.times[j].reserve(iterations);
+		}
+
+		// NOTE: The first run is a warmup run and isn't timed.
+		ret = runIteration(result, true);
+		if (ret != 0) {
+			fprintf(stderr, "*** ERROR: %s was not detected.\n", files[i].format.c_str());
+			hasErrors = true;
+			continue;
+		}
+		for (int j = 0; j < BENCH_STAGE_MAX; j++) {
+			result.times[j].clear();
+		}
+		for (int j = 0; j < iterations; j++) {
+			runIteration(result, false);
+		}
+	}
+
+	if (json) {
+		printJSON(results, iterations);
+	} else {
+		printText(results);
+	}
+	return (hasErrors ? EXIT_FAILURE : EXIT_SUCCESS);
+}
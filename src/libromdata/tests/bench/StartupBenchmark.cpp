@@ -0,0 +1,354 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * StartupBenchmark.cpp: Cold-start latency benchmark.                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * Measures the cost of the first RomDataFactory::create() call
+ * in a fresh process, which includes all lazy initialization,
+ * and optionally the cost of loading a shell extension plugin
+ * with dlopen() and creating its first thumbnail.
+ *
+ * Each iteration runs in a child process created with fork(),
+ * so every sample is a cold start. (The parent process never
+ * calls into libromdata before forking.)
+ */
+
+#include "BenchCorpus.hpp"
+using LibRomData::Tests::BenchCorpusFile;
+using LibRomData::Tests::generateBenchCorpus;
+
+// librpbase, librpfile
+#include "librpbase/RomData.hpp"
+#include "librpfile/RpFile.hpp"
+using namespace LibRpBase;
+using namespace LibRpFile;
+
+// libromdata
+#include "libromdata/RomDataFactory.hpp"
+using LibRomData::RomDataFactory;
+
+// C includes.
+#include <dlfcn.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// rp_create_thumbnail() function pointer.
+typedef int (*PFN_RP_CREATE_THUMBNAIL)(const char *source_file, const char *output_file, int maximum_size);
+
+// Benchmark stages.
+enum StartupStage {
+	STARTUP_CREATE_FIRST = 0,	// First RomDataFactory::create()
+	STARTUP_CREATE_SECOND,		// Second RomDataFactory::create()
+	STARTUP_DLOPEN,			// dlopen() + dlsym() of the plugin
+	STARTUP_THUMB_FIRST,		// First rp_create_thumbnail()
+
+	STARTUP_STAGE_MAX
+};
+
+static const char *const startup_stage_names[STARTUP_STAGE_MAX] = {
+	"create_first", "create_second", "dlopen", "thumbnail_first"
+};
+
+/**
+ * Get the current time from a monotonic clock.
+ * @return Current time, in nanoseconds.
+ */
+static inline uint64_t now_ns(void)
+{
+	using namespace std::chrono;
+	return static_cast<uint64_t>(duration_cast<nanoseconds>(
+		steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Time RomDataFactory::create().
+ * @param filename ROM filename.
+ * @return Time, in nanoseconds, or 0 on error.
+ */
+static uint64_t timeCreate(const char *filename)
+{
+	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
+	if (!file->isOpen()) {
+		file->unref();
+		return 0;
+	}
+
+	const uint64_t t0 = now_ns();
+	RomData *const romData = RomDataFactory::create(file);
+	const uint64_t t1 = now_ns();
+	file->unref();
+	if (!romData) {
+		return 0;
+	}
+	romData->unref();
+	return t1 - t0;
+}
+
+/**
+ * Child process: Run a single cold-start iteration.
+ * This function does not return.
+ * @param fd		[in] Pipe to write the results to.
+ * @param filename	[in] ROM filename.
+ * @param plugin	[in] Plugin filename. (may be nullptr)
+ * @param thumb_file	[in] Thumbnail output filename. (if plugin != nullptr)
+ */
+static void runChild(int fd, const char *filename, const char *plugin, const char *thumb_file)
+{
+	uint64_t t[STARTUP_STAGE_MAX];
+	memset(t, 0, sizeof(t));
+
+	if (plugin) {
+		// Plugin first. This is the order the thumbnailers use.
+		uint64_t t0 = now_ns();
+		void *const pDll = dlopen(plugin, RTLD_NOW | RTLD_LOCAL);
+		PFN_RP_CREATE_THUMBNAIL pfn = nullptr;
+		if (pDll) {
+			pfn = reinterpret_cast<PFN_RP_CREATE_THUMBNAIL>(dlsym(pDll, "rp_create_thumbnail"));
+		}
+		uint64_t t1 = now_ns();
+		if (!pfn) {
+			_exit(2);
+		}
+		t[STARTUP_DLOPEN] = t1 - t0;
+
+		t0 = now_ns();
+		const int ret = pfn(filename, thumb_file, 256);
+		t1 = now_ns();
+		if (ret != 0) {
+			_exit(3);
+		}
+		t[STARTUP_THUMB_FIRST] = t1 - t0;
+	}
+
+	// RomDataFactory in this process.
+	t[STARTUP_CREATE_FIRST] = timeCreate(filename);
+	t[STARTUP_CREATE_SECOND] = timeCreate(filename);
+	if (t[STARTUP_CREATE_FIRST] == 0 || t[STARTUP_CREATE_SECOND] == 0) {
+		_exit(1);
+	}
+
+	const ssize_t size = write(fd, t, sizeof(t));
+	_exit(size == static_cast<ssize_t>(sizeof(t)) ? 0 : 4);
+}
+
+/**
+ * Run a single cold-start iteration in a child process.
+ * @param t		[out] Stage times, in nanoseconds.
+ * @param filename	[in] ROM filename.
+ * @param plugin	[in] Plugin filename. (may be nullptr)
+ * @param thumb_file	[in] Thumbnail output filename. (if plugin != nullptr)
+ * @return 0 on success; child exit status or negative POSIX error code on error.
+ */
+static int runIteration(uint64_t t[STARTUP_STAGE_MAX], const char *filename,
+			const char *plugin, const char *thumb_file)
+{
+	int fds[2];
+	if (pipe(fds) != 0) {
+		return -errno;
+	}
+
+	fflush(nullptr);
+	const pid_t pid = fork();
+	if (pid < 0) {
+		const int err = errno;
+		close(fds[0]);
+		close(fds[1]);
+		return -err;
+	} else if (pid == 0) {
+		close(fds[0]);
+		runChild(fds[1], filename, plugin, thumb_file);
+	}
+
+	close(fds[1]);
+	const size_t size = STARTUP_STAGE_MAX * sizeof(uint64_t);
+	const ssize_t rd = read(fds[0], t, size);
+	close(fds[0]);
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+	if (!WIFEXITED(status)) {
+		return -EINTR;
+	} else if (WEXITSTATUS(status) != 0) {
+		return WEXITSTATUS(status);
+	}
+	return (rd == static_cast<ssize_t>(size) ? 0 : -EIO);
+}
+
+/**
+ * Get the median of a set of samples.
+ * @param samples Samples. (will be sorted)
+ * @return Median.
+ */
+static uint64_t median(vector<uint64_t> &samples)
+{
+	if (samples.empty())
+		return 0;
+	std::sort(samples.begin(), samples.end());
+	const size_t mid = samples.size() / 2;
+	if (samples.size() % 2 == 0) {
+		return (samples[mid-1] + samples[mid]) / 2;
+	}
+	return samples[mid];
+}
+
+int RP_C_API main(int argc, char *argv[])
+{
+	int iterations = 20;
+	bool json = false;
+	const char *corpus_dir = "RomDataBenchmark_corpus";
+	const char *rom_file = nullptr;
+	const char *plugin = nullptr;
+	double budget_us = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-j")) {
+			json = true;
+		} else if (!strcmp(argv[i], "-n") && i+1 < argc) {
+			iterations = atoi(argv[++i]);
+			if (iterations <= 0) {
+				fprintf(stderr, "Invalid iteration count '%s'.\n", argv[i]);
+				return EXIT_FAILURE;
+			}
+		} else if (!strcmp(argv[i], "-b") && i+1 < argc) {
+			budget_us = atof(argv[++i]);
+			if (budget_us <= 0) {
+				fprintf(stderr, "Invalid budget '%s'.\n", argv[i]);
+				return EXIT_FAILURE;
+			}
+		} else if (!strcmp(argv[i], "-f") && i+1 < argc) {
+			rom_file = argv[++i];
+		} else if (!strcmp(argv[i], "-p") && i+1 < argc) {
+			plugin = argv[++i];
+		} else if (argv[i][0] == '-') {
+			fprintf(stderr, "Syntax: %s [-j] [-n iterations] [-b budget_us] [-f rom_file] [-p plugin.so] [corpus_dir]\n", argv[0]);
+			fputs("Measures cold-start latency in a fresh process for each iteration:\n"
+			      "the first RomDataFactory::create() call, and optionally dlopen()\n"
+			      "of a shell extension plugin plus its first rp_create_thumbnail().\n"
+			      "  -j: Output the results as JSON.\n"
+			      "  -n: Number of iterations. (default is 20)\n"
+			      "  -b: Startup budget, in microseconds. If the median of the\n"
+			      "      first create() plus dlopen() exceeds it, exit with an error.\n"
+			      "  -f: ROM file to use. (default is the NDS file from the corpus)\n"
+			      "  -p: Plugin to load, e.g. rom-properties-gtk3.so.\n", stderr);
+			return EXIT_FAILURE;
+		} else {
+			corpus_dir = argv[i];
+		}
+	}
+
+	vector<BenchCorpusFile> files;
+	string rom_filename;
+	if (rom_file) {
+		rom_filename = rom_file;
+	} else {
+		// NOTE: Generating the corpus doesn't use libromdata,
+		// so the child processes still start cold.
+		int ret = generateBenchCorpus(corpus_dir, files);
+		if (ret != 0 || files.empty()) {
+			fprintf(stderr, "*** ERROR: Unable to generate the corpus in '%s': %s\n",
+				corpus_dir, strerror(ret != 0 ? -ret : ENOENT));
+			return EXIT_FAILURE;
+		}
+		rom_filename = files[0].filename;
+		for (auto iter = files.cbegin(); iter != files.cend(); ++iter) {
+			if (iter->format == "NDS") {
+				rom_filename = iter->filename;
+				break;
+			}
+		}
+	}
+
+	string thumb_file;
+	if (plugin) {
+		thumb_file = rom_filename + ".startup.png";
+	}
+
+	vector<uint64_t> times[STARTUP_STAGE_MAX];
+	for (int i = 0; i < STARTUP_STAGE_MAX; i++) {
+		times[i].reserve(iterations);
+	}
+	for (int i = 0; i < iterations; i++) {
+		uint64_t t[STARTUP_STAGE_MAX];
+		int ret = runIteration(t, rom_filename.c_str(), plugin,
+			(plugin ? thumb_file.c_str() : nullptr));
+		if (ret != 0) {
+			if (ret < 0) {
+				fprintf(stderr, "*** ERROR: Unable to run the child process: %s\n", strerror(-ret));
+			} else if (ret == 1) {
+				fprintf(stderr, "*** ERROR: '%s' was not detected.\n", rom_filename.c_str());
+			} else if (ret == 2) {
+				fprintf(stderr, "*** ERROR: Unable to load rp_create_thumbnail() from '%s'.\n", plugin);
+			} else if (ret == 3) {
+				fprintf(stderr, "*** ERROR: rp_create_thumbnail() failed for '%s'.\n", rom_filename.c_str());
+			} else {
+				fprintf(stderr, "*** ERROR: Child process exited with status %d.\n", ret);
+			}
+			return EXIT_FAILURE;
+		}
+		for (int j = 0; j < STARTUP_STAGE_MAX; j++) {
+			times[j].push_back(t[j]);
+		}
+	}
+	if (plugin) {
+		unlink(thumb_file.c_str());
+	}
+
+	const int stage_max = (plugin ? STARTUP_STAGE_MAX : STARTUP_DLOPEN);
+	uint64_t med[STARTUP_STAGE_MAX];
+	for (int i = 0; i < STARTUP_STAGE_MAX; i++) {
+		med[i] = median(times[i]);
+	}
+	const double startup_us = static_cast<double>(med[STARTUP_CREATE_FIRST] + med[STARTUP_DLOPEN]) / 1000.0;
+	const bool overBudget = (budget_us > 0 && startup_us > budget_us);
+
+	if (json) {
+		printf("{\"iterations\":%d,\"file\":\"%s\",\"ns\":{", iterations, rom_filename.c_str());
+		for (int i = 0; i < stage_max; i++) {
+			const vector<uint64_t> &samples = times[i];
+			printf("%s\"%s\":{\"min\":%llu,\"median\":%llu,\"max\":%llu}",
+				(i > 0 ? "," : ""), startup_stage_names[i],
+				static_cast<unsigned long long>(samples.front()),
+				static_cast<unsigned long long>(med[i]),
+				static_cast<unsigned long long>(samples.back()));
+		}
+		printf("},\"startup_us\":%.1f", startup_us);
+		if (budget_us > 0) {
+			printf(",\"budget_us\":%.1f,\"over_budget\":%s", budget_us, (overBudget ? "true" : "false"));
+		}
+		printf("}\n");
+	} else {
+		printf("%-16s %10s %10s %10s\n", "stage", "min (us)", "med (us)", "max (us)");
+		for (int i = 0; i < stage_max; i++) {
+			const vector<uint64_t> &samples = times[i];
+			printf("%-16s %10.1f %10.1f %10.1f\n", startup_stage_names[i],
+				static_cast<double>(samples.front()) / 1000.0,
+				static_cast<double>(med[i]) / 1000.0,
+				static_cast<double>(samples.back()) / 1000.0);
+		}
+		printf("\nstartup (create_first + dlopen): %.1f us", startup_us);
+		if (budget_us > 0) {
+			printf(" (budget: %.1f us%s)", budget_us, (overBudget ? ", OVER BUDGET" : ""));
+		}
+		putchar('\n');
+	}
+	return (overBudget ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -0,0 +1,215 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * DatCompilerTest.cpp: DatCompiler and DatIndex test.                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// DatCompiler, DatIndex
+#include "libromdata/data/DatCompiler.hpp"
+#include "librpbase/DatIndex.hpp"
+using LibRpBase::DatIndex;
+
+// C includes.
+#ifdef _WIN32
+# include <direct.h>
+# define rmdir(dirname) _rmdir(dirname)
+#else /* !_WIN32 */
+# include <unistd.h>
+#endif /* _WIN32 */
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <vector>
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+class DatCompilerTest : public ::testing::Test
+{
+	protected:
+		static const char dat_filename[];
+		static const char idx_dirname[];
+		static const char idx_filename[];
+		static const char dat_xml[];
+
+		void SetUp(void) final
+		{
+			FILE *f = fopen(dat_filename, "wb");
+			ASSERT_TRUE(f != nullptr);
+			fwrite(dat_xml, 1, strlen(dat_xml), f);
+			fclose(f);
+
+			// Four <rom> elements.
+			ASSERT_EQ(4, DatCompiler::compile(dat_filename, idx_filename));
+		}
+
+		void TearDown(void) final
+		{
+			remove(dat_filename);
+			remove(idx_filename);
+			rmdir(idx_dirname);
+		}
+};
+
+// NOTE: The index is written into a subdirectory so
+// DatCompiler::compile() has to create it. This checks
+// that rmkdir() works with seccomp enabled.
+const char DatCompilerTest::dat_filename[] = "DatCompilerTest.dat";
+const char DatCompilerTest::idx_dirname[] = "DatCompilerTest.d";
+#ifdef _WIN32
+const char DatCompilerTest::idx_filename[] = "DatCompilerTest.d\\DatCompilerTest.datidx";
+#else /* !_WIN32 */
+const char DatCompilerTest::idx_filename[] = "DatCompilerTest.d/DatCompilerTest.datidx";
+#endif /* _WIN32 */
+
+// NOTE: "Game B" and "Game C" have the same CRC32,
+// but different sizes and SHA-1s.
+const char DatCompilerTest::dat_xml[] =
+	"<?xml version=\"1.0\"?>\n"
+	"<datafile>\n"
+	"\t<header>\n"
+	"\t\t<name>Test - System</name>\n"
+	"\t\t<version>20201016</version>\n"
+	"\t</header>\n"
+	"\t<game name=\"Game A (USA)\">\n"
+	"\t\t<serial>ABC-1234</serial>\n"
+	"\t\t<rom name=\"Game A (USA).bin\" size=\"1024\" crc=\"AABBCCDD\" sha1=\"0123456789abcdef0123456789abcdef01234567\"/>\n"
+	"\t</game>\n"
+	"\t<game name=\"Game B (Europe)\">\n"
+	"\t\t<rom name=\"Game B (Europe).bin\" size=\"2048\" crc=\"11223344\" sha1=\"1111111111111111111111111111111111111111\" serial=\"ABC-1234\"/>\n"
+	"\t</game>\n"
+	"\t<machine name=\"Game C (Japan)\">\n"
+	"\t\t<rom name=\"Game C (Japan).bin\" size=\"4096\" crc=\"11223344\" sha1=\"2222222222222222222222222222222222222222\"/>\n"
+	"\t\t<rom name=\"Game C (Japan) (Track 2).bin\" size=\"512\" crc=\"55667788\"/>\n"
+	"\t</machine>\n"
+	"</datafile>\n";
+
+/**
+ * Test the DAT header.
+ */
+TEST_F(DatCompilerTest, headerTest)
+{
+	const DatIndex datIndex(idx_filename);
+	ASSERT_TRUE(datIndex.isOpen());
+	EXPECT_STREQ("Test - System", datIndex.datName());
+	EXPECT_STREQ("20201016", datIndex.datVersion());
+	EXPECT_EQ(4U, datIndex.count());
+}
+
+/**
+ * Test lookups by SHA-1.
+ */
+TEST_F(DatCompilerTest, sha1Test)
+{
+	const DatIndex datIndex(idx_filename);
+	ASSERT_TRUE(datIndex.isOpen());
+
+	static const uint8_t sha1_a[20] = {
+		0x01,0x23,0x45,0x67,0x89,0xAB,0xCD,0xEF,0x01,0x23,
+		0x45,0x67,0x89,0xAB,0xCD,0xEF,0x01,0x23,0x45,0x67
+	};
+	DatIndex::Entry entry;
+	ASSERT_TRUE(datIndex.findBySha1(sha1_a, &entry));
+	EXPECT_STREQ("Game A (USA)", entry.game_name);
+	EXPECT_STREQ("Game A (USA).bin", entry.rom_name);
+	EXPECT_STREQ("ABC-1234", entry.serial);
+	EXPECT_EQ(1024U, entry.size);
+	EXPECT_EQ(0xAABBCCDDU, entry.crc32);
+	EXPECT_TRUE(entry.has_crc32);
+	EXPECT_TRUE(entry.has_sha1);
+
+	uint8_t sha1_c[20];
+	memset(sha1_c, 0x22, sizeof(sha1_c));
+	ASSERT_TRUE(datIndex.findBySha1(sha1_c, &entry));
+	EXPECT_STREQ("Game C (Japan)", entry.game_name);
+
+	uint8_t sha1_none[20];
+	memset(sha1_none, 0x33, sizeof(sha1_none));
+	EXPECT_FALSE(datIndex.findBySha1(sha1_none, &entry));
+}
+
+/**
+ * Test lookups by CRC32.
+ */
+TEST_F(DatCompilerTest, crc32Test)
+{
+	const DatIndex datIndex(idx_filename);
+	ASSERT_TRUE(datIndex.isOpen());
+
+	// CRC32 collision: Both entries should be returned in DAT order.
+	vector<DatIndex::Entry> vec = datIndex.findByCrc32(0x11223344);
+	ASSERT_EQ(2U, vec.size());
+	EXPECT_STREQ("Game B (Europe)", vec[0].game_name);
+	EXPECT_EQ(2048U, vec[0].size);
+	EXPECT_STREQ("Game C (Japan)", vec[1].game_name);
+	EXPECT_EQ(4096U, vec[1].size);
+
+	// Entry without SHA-1.
+	vec = datIndex.findByCrc32(0x55667788);
+	ASSERT_EQ(1U, vec.size());
+	EXPECT_STREQ("Game C (Japan) (Track 2).bin", vec[0].rom_name);
+	EXPECT_FALSE(vec[0].has_sha1);
+
+	vec = datIndex.findByCrc32(0xDEADBEEF);
+	EXPECT_TRUE(vec.empty());
+}
+
+/**
+ * Test lookups by serial number.
+ */
+TEST_F(DatCompilerTest, serialTest)
+{
+	const DatIndex datIndex(idx_filename);
+	ASSERT_TRUE(datIndex.isOpen());
+
+	// Serial from a <serial> element and a "serial" attribute.
+	vector<DatIndex::Entry> vec = datIndex.findBySerial("ABC-1234");
+	ASSERT_EQ(2U, vec.size());
+	EXPECT_STREQ("Game A (USA)", vec[0].game_name);
+	EXPECT_STREQ("Game B (Europe)", vec[1].game_name);
+
+	EXPECT_TRUE(datIndex.findBySerial("XYZ-0000").empty());
+	EXPECT_TRUE(datIndex.findBySerial("").empty());
+}
+
+/**
+ * Test opening invalid DAT indexes.
+ */
+TEST_F(DatCompilerTest, invalidIndexTest)
+{
+	// The DAT itself isn't a DAT index.
+	const DatIndex datIndex(dat_filename);
+	EXPECT_FALSE(datIndex.isOpen());
+	EXPECT_EQ(EIO, datIndex.lastError());
+	EXPECT_TRUE(datIndex.findByCrc32(0x11223344).empty());
+
+	// Nonexistent file.
+	const DatIndex datIndex2("DatCompilerTest.nonexistent");
+	EXPECT_FALSE(datIndex2.isOpen());
+	EXPECT_EQ(ENOENT, datIndex2.lastError());
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: DatCompiler tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
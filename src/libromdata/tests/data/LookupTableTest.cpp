@@ -0,0 +1,130 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * LookupTableTest.cpp: Generated lookup table tests.                      *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// Lookup tables.
+#include "libromdata/data/ELFData.hpp"
+#include "libromdata/data/Nintendo3DSSysTitles.hpp"
+#include "libromdata/data/NintendoPublishers.hpp"
+#include "libromdata/data/SegaPublishers.hpp"
+#include "libromdata/data/WiiSystemMenuVersion.hpp"
+
+// C includes. (C++ namespace)
+#include <cstdio>
+
+namespace LibRomData { namespace Tests {
+
+class LookupTableTest : public ::testing::Test
+{ };
+
+/**
+ * NintendoPublishers lookup.
+ */
+TEST_F(LookupTableTest, NintendoPublishers)
+{
+	EXPECT_STREQ("<unlicensed>", NintendoPublishers::lookup("00"));
+	EXPECT_STREQ("Nintendo", NintendoPublishers::lookup("01"));
+	EXPECT_STREQ("Topware Interactive", NintendoPublishers::lookup("ZX"));
+	EXPECT_STREQ("Capcom", NintendoPublishers::lookup_old(0x08));
+	EXPECT_TRUE(NintendoPublishers::lookup("!!") == nullptr);
+	EXPECT_TRUE(NintendoPublishers::lookup("") == nullptr);
+
+	EXPECT_STREQ("<unlicensed>", NintendoPublishers::lookup_fds(0x00));
+	EXPECT_STREQ("Atlus", NintendoPublishers::lookup_fds(0xEB));
+	EXPECT_TRUE(NintendoPublishers::lookup_fds(0xFF) == nullptr);
+}
+
+/**
+ * SegaPublishers lookup.
+ */
+TEST_F(LookupTableTest, SegaPublishers)
+{
+	EXPECT_STREQ("Sega", SegaPublishers::lookup(0));
+	EXPECT_STREQ("Taito", SegaPublishers::lookup(11));
+	EXPECT_STREQ("Triangle Service", SegaPublishers::lookup(479));
+	EXPECT_TRUE(SegaPublishers::lookup(1) == nullptr);
+	EXPECT_TRUE(SegaPublishers::lookup(0x10000) == nullptr);
+}
+
+/**
+ * WiiSystemMenuVersion lookup.
+ */
+TEST_F(LookupTableTest, WiiSystemMenuVersion)
+{
+	EXPECT_STREQ("1.0", WiiSystemMenuVersion::lookup(33));
+	EXPECT_STREQ("4.3E", WiiSystemMenuVersion::lookup(610));
+	EXPECT_TRUE(WiiSystemMenuVersion::lookup(0) == nullptr);
+	EXPECT_TRUE(WiiSystemMenuVersion::lookup(34) == nullptr);
+	// Versions must not be truncated to 16 bits.
+	EXPECT_TRUE(WiiSystemMenuVersion::lookup(0x10000 + 33) == nullptr);
+}
+
+/**
+ * ELFData lookup.
+ */
+TEST_F(LookupTableTest, ELFData)
+{
+	// Contiguous low IDs.
+	EXPECT_STREQ("No machine", ELFData::lookup_cpu(0));
+	EXPECT_STREQ("Intel i386", ELFData::lookup_cpu(3));
+	EXPECT_STREQ("AMD GPU", ELFData::lookup_cpu(224));
+	EXPECT_TRUE(ELFData::lookup_cpu(12) == nullptr);
+
+	// Other IDs.
+	EXPECT_STREQ("RISC-V", ELFData::lookup_cpu(243));
+	EXPECT_STREQ("Moxie (unofficial)", ELFData::lookup_cpu(0xFEED));
+	EXPECT_TRUE(ELFData::lookup_cpu(225) == nullptr);
+	EXPECT_TRUE(ELFData::lookup_cpu(0xFFFF) == nullptr);
+
+	// OS ABIs.
+	EXPECT_STREQ("UNIX System V", ELFData::lookup_osabi(0));
+	EXPECT_STREQ("Nuxi CloudABI", ELFData::lookup_osabi(17));
+	EXPECT_TRUE(ELFData::lookup_osabi(18) == nullptr);
+}
+
+/**
+ * Nintendo3DSSysTitles lookup.
+ */
+TEST_F(LookupTableTest, Nintendo3DSSysTitles)
+{
+	const char *region = nullptr;
+	EXPECT_STREQ("System Settings",
+		Nintendo3DSSysTitles::lookup_sys_title(0x00040010, 0x00020000, &region));
+	EXPECT_STREQ("JPN", region);
+	EXPECT_STREQ("microSD Management",
+		Nintendo3DSSysTitles::lookup_sys_title(0x00040010, 0x20025100, &region));
+	EXPECT_STREQ("EUR", region);
+	EXPECT_STREQ("amiibo Settings",
+		Nintendo3DSSysTitles::lookup_sys_title(0x00040030, 0x0000BF02, &region));
+	EXPECT_STREQ("TWN", region);
+
+	// Not found.
+	EXPECT_TRUE(Nintendo3DSSysTitles::lookup_sys_title(0x00040010, 0x00020001, &region) == nullptr);
+	EXPECT_TRUE(region == nullptr);
+	EXPECT_TRUE(Nintendo3DSSysTitles::lookup_sys_title(0x00040000, 0x00020000, &region) == nullptr);
+	EXPECT_TRUE(region == nullptr);
+	EXPECT_TRUE(Nintendo3DSSysTitles::lookup_sys_title(0x00040010, 0, nullptr) == nullptr);
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: Lookup table tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,371 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * StfsReaderTest.cpp: StfsReader block mapping test.                      *
+ *                                                                         *
+ * Copyright (c) 2026 by David Korth.                                      *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * StfsReader maps data block numbers to physical addresses,
+ * skipping the interleaved hash tables. The expected values
+ * here are from the package layout described at:
+ * https://github.com/Free60Project/wiki/blob/master/STFS.md
+ *
+ * Physical block numbers are relative to the first hash table,
+ * which is at 0xA000 for all packages tested here.
+ *
+ * LIVE/PIRS (one copy of each hash table):
+ * - Level 0 tables cover 0xAA data blocks, plus 1 hash block. (0xAB)
+ * - Level 1 tables cover 0xAA * 0xAB blocks, plus 1. (0x718F)
+ *
+ * CON (two copies of each hash table):
+ * - Level 0 tables cover 0xAA data blocks, plus 2 hash blocks. (0xAC)
+ * - Level 1 tables cover 0xAA * 0xAC blocks, plus 2. (0x723A)
+ */
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// StfsReader
+#include "libromdata/disc/StfsReader.hpp"
+#include "libromdata/Console/xbox360_stfs_structs.h"
+
+// librpcpu, librpfile
+#include "librpcpu/byteswap.h"
+#include "librpfile/IRpFile.hpp"
+using LibRpFile::IRpFile;
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <utility>
+#include <vector>
+using std::pair;
+using std::string;
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+/**
+ * Synthetic STFS package.
+ * Hash tables are filled with a single entry, repeated.
+ * Everything else is zero. All reads are recorded.
+ */
+class StfsTestFile final : public IRpFile
+{
+	public:
+		StfsTestFile()
+			: hashStatus(0)
+			, nextBlock(STFS_HASH_CHAIN_END)
+			, m_pos(0)
+		{ }
+
+	private:
+		typedef IRpFile super;
+		RP_DISABLE_COPY(StfsTestFile)
+
+	public:
+		bool isOpen(void) const final { return true; }
+		void close(void) final { }
+		size_t read(void *ptr, size_t size) final
+		{
+			size_t ret = pread(m_pos, ptr, size);
+			m_pos += ret;
+			return ret;
+		}
+		size_t write(const void *ptr, size_t size) final
+		{
+			RP_UNUSED(ptr);
+			RP_UNUSED(size);
+			m_lastError = EBADF;
+			return 0;
+		}
+		int seek(off64_t pos) final { m_pos = pos; return 0; }
+		off64_t tell(void) final { return m_pos; }
+		int truncate(off64_t size) final
+		{
+			RP_UNUSED(size);
+			m_lastError = ENOTSUP;
+			return -1;
+		}
+		off64_t size(void) final { return 0x100000000LL; }
+		string filename(void) const final { return string(); }
+
+		size_t pread(off64_t pos, void *ptr, size_t size) final
+		{
+			reads.push_back(pair<off64_t, size_t>(pos, size));
+			if (size != STFS_HASH_ENTRIES_PER_TABLE * sizeof(STFS_Hash_Entry)) {
+				memset(ptr, 0, size);
+				return size;
+			}
+
+			// Hash table.
+			STFS_Hash_Entry *entry = static_cast<STFS_Hash_Entry*>(ptr);
+			for (unsigned int i = 0; i < STFS_HASH_ENTRIES_PER_TABLE; i++, entry++) {
+				memset(entry->sha1, 0, sizeof(entry->sha1));
+				entry->status = hashStatus;
+				entry->next_block[0] = (nextBlock >> 16) & 0xFF;
+				entry->next_block[1] = (nextBlock >>  8) & 0xFF;
+				entry->next_block[2] =  nextBlock        & 0xFF;
+			}
+			return size;
+		}
+
+	public:
+		uint8_t hashStatus;	// Status byte for all hash entries.
+		uint32_t nextBlock;	// Next block for all hash entries.
+
+		// Reads: (address, size)
+		vector<pair<off64_t, size_t> > reads;
+
+	private:
+		off64_t m_pos;
+};
+
+class StfsReaderTest : public ::testing::Test
+{
+	protected:
+		void SetUp(void) final
+		{
+			memset(&metadata, 0, sizeof(metadata));
+			metadata.header_size = cpu_to_be32(0x971A);
+			file = new StfsTestFile();
+		}
+
+		void TearDown(void) final
+		{
+			file->unref();
+		}
+
+	public:
+		static const uint32_t FIRST_HASH_TABLE_ADDR = 0xA000;
+
+		/**
+		 * Get the address of a physical block.
+		 * @param phys Physical block number, relative to the first hash table.
+		 * @return Address.
+		 */
+		static inline off64_t physAddr(uint32_t phys)
+		{
+			return static_cast<off64_t>(FIRST_HASH_TABLE_ADDR) +
+				(static_cast<off64_t>(phys) * STFS_BLOCK_SIZE);
+		}
+
+		/**
+		 * Set up the package metadata.
+		 * @param allocBlocks Number of allocated blocks.
+		 * @param blockSeparation Block separation bits.
+		 */
+		void setMetadata(uint32_t allocBlocks, uint8_t blockSeparation = 0)
+		{
+			metadata.stfs_desc.block_separation = blockSeparation;
+			metadata.stfs_desc.total_alloc_block_count = cpu_to_be32(allocBlocks);
+		}
+
+		/**
+		 * Read a file from the synthetic package.
+		 * @param isCON		[in] True if this is a CON package.
+		 * @param blockNumber	[in] First data block number.
+		 * @param blockCount	[in] Number of data blocks.
+		 * @param consecutive	[in] True if the file's blocks are consecutive.
+		 */
+		void readFile(bool isCON, uint32_t blockNumber, uint32_t blockCount, bool consecutive)
+		{
+			const size_t size = blockCount * STFS_BLOCK_SIZE;
+			vector<uint8_t> buf(size);
+
+			file->reads.clear();
+			StfsReader reader(file, &metadata, isCON,
+				blockNumber, blockCount, static_cast<uint32_t>(size), consecutive);
+			EXPECT_EQ(size, reader.read(buf.data(), size));
+			EXPECT_EQ(0, reader.lastError());
+		}
+
+	public:
+		STFS_Package_Metadata metadata;
+		StfsTestFile *file;
+};
+
+struct BlockMapping {
+	uint32_t dataBlock;	// Data block number.
+	uint32_t phys;		// Physical block number.
+};
+
+/**
+ * Data block mapping for LIVE/PIRS packages.
+ */
+TEST_F(StfsReaderTest, liveDataBlocks)
+{
+	static const BlockMapping mappings[] = {
+		{0x0000, 0x0001},	// after L0 table 0
+		{0x00A9, 0x00AA},	// last block in L0 group 0
+		{0x00AA, 0x00AD},	// after L1 table 0 and L0 table 1
+		{0x0153, 0x0156},	// last block in L0 group 1
+		{0x0154, 0x0158},	// after L0 table 2
+		{0x70E3, 0x718E},	// last block in L1 group 0
+		{0x70E4, 0x7192},	// after L2, L1 table 1, and L0 table 0xAA
+	};
+
+	setMetadata(0x8000);
+	for (size_t i = 0; i < ARRAY_SIZE(mappings); i++) {
+		readFile(false, mappings[i].dataBlock, 1, true);
+		ASSERT_EQ(1U, file->reads.size()) << "data block 0x" << std::hex << mappings[i].dataBlock;
+		EXPECT_EQ(physAddr(mappings[i].phys), file->reads[0].first)
+			<< "data block 0x" << std::hex << mappings[i].dataBlock;
+		EXPECT_EQ(static_cast<size_t>(STFS_BLOCK_SIZE), file->reads[0].second);
+	}
+}
+
+/**
+ * Data block mapping for CON packages.
+ */
+TEST_F(StfsReaderTest, conDataBlocks)
+{
+	static const BlockMapping mappings[] = {
+		{0x0000, 0x0002},	// after L0 table 0
+		{0x00A9, 0x00AB},	// last block in L0 group 0
+		{0x00AA, 0x00B0},	// after L1 table 0 and L0 table 1
+		{0x0153, 0x0159},	// last block in L0 group 1
+		{0x0154, 0x015C},	// after L0 table 2
+		{0x70E3, 0x7239},	// last block in L1 group 0
+		{0x70E4, 0x7240},	// after L2, L1 table 1, and L0 table 0xAA
+	};
+
+	setMetadata(0x8000);
+	for (size_t i = 0; i < ARRAY_SIZE(mappings); i++) {
+		readFile(true, mappings[i].dataBlock, 1, true);
+		ASSERT_EQ(1U, file->reads.size()) << "data block 0x" << std::hex << mappings[i].dataBlock;
+		EXPECT_EQ(physAddr(mappings[i].phys), file->reads[0].first)
+			<< "data block 0x" << std::hex << mappings[i].dataBlock;
+		EXPECT_EQ(static_cast<size_t>(STFS_BLOCK_SIZE), file->reads[0].second);
+	}
+}
+
+/**
+ * CON packages with the block separation bit set
+ * only have one copy of each hash table.
+ */
+TEST_F(StfsReaderTest, conBlockSeparation)
+{
+	setMetadata(0x8000, 1);
+	readFile(true, 0x00AA, 1, true);
+	ASSERT_EQ(1U, file->reads.size());
+	EXPECT_EQ(physAddr(0x00AD), file->reads[0].first);
+
+	// ...unless the first hash table is at 0xB000.
+	metadata.header_size = cpu_to_be32(0xAD0E);
+	readFile(true, 0x00AA, 1, true);
+	ASSERT_EQ(1U, file->reads.size());
+	EXPECT_EQ(0xB000 + (0x00B0 * STFS_BLOCK_SIZE), file->reads[0].first);
+}
+
+/**
+ * Consecutive data blocks are read in a single request,
+ * unless there's a hash table between them.
+ */
+TEST_F(StfsReaderTest, consecutiveRuns)
+{
+	setMetadata(0x8000);
+	readFile(false, 0x00A8, 3, true);
+	ASSERT_EQ(2U, file->reads.size());
+	EXPECT_EQ(physAddr(0x00A9), file->reads[0].first);
+	EXPECT_EQ(static_cast<size_t>(STFS_BLOCK_SIZE * 2), file->reads[0].second);
+	EXPECT_EQ(physAddr(0x00AD), file->reads[1].first);
+	EXPECT_EQ(static_cast<size_t>(STFS_BLOCK_SIZE), file->reads[1].second);
+
+	readFile(true, 0x00A8, 3, true);
+	ASSERT_EQ(2U, file->reads.size());
+	EXPECT_EQ(physAddr(0x00AA), file->reads[0].first);
+	EXPECT_EQ(static_cast<size_t>(STFS_BLOCK_SIZE * 2), file->reads[0].second);
+	EXPECT_EQ(physAddr(0x00B0), file->reads[1].first);
+	EXPECT_EQ(static_cast<size_t>(STFS_BLOCK_SIZE), file->reads[1].second);
+}
+
+/**
+ * Hash chain for a LIVE/PIRS package.
+ * Only the level 0 table is read.
+ */
+TEST_F(StfsReaderTest, liveHashChain)
+{
+	setMetadata(0x8000);
+	file->nextBlock = 0x10;
+	readFile(false, 0x70E4, 2, false);
+	ASSERT_EQ(3U, file->reads.size());
+	EXPECT_EQ(physAddr(0x7191), file->reads[0].first) << "L0 table 0xAA";
+	EXPECT_EQ(STFS_HASH_ENTRIES_PER_TABLE * sizeof(STFS_Hash_Entry), file->reads[0].second);
+	EXPECT_EQ(physAddr(0x7192), file->reads[1].first) << "data block 0x70E4";
+	EXPECT_EQ(physAddr(0x0011), file->reads[2].first) << "data block 0x10";
+}
+
+/**
+ * Hash chain for a CON package.
+ * The top table's copy is selected by the block separation
+ * bits, and each lower table's copy by the parent entry.
+ */
+TEST_F(StfsReaderTest, conHashChain)
+{
+	// Top table copy 0; use the second copy of the lower tables.
+	setMetadata(0x8000);
+	file->hashStatus = STFS_HASH_STATUS_ACTIVE_INDEX;
+	file->nextBlock = 0x10;
+	readFile(true, 0x70E4, 2, false);
+	ASSERT_EQ(5U, file->reads.size());
+	EXPECT_EQ(physAddr(0x723A), file->reads[0].first) << "L2 table, copy 0";
+	EXPECT_EQ(physAddr(0x723D), file->reads[1].first) << "L1 table 1, copy 1";
+	EXPECT_EQ(physAddr(0x723F), file->reads[2].first) << "L0 table 0xAA, copy 1";
+	EXPECT_EQ(physAddr(0x7240), file->reads[3].first) << "data block 0x70E4";
+	EXPECT_EQ(physAddr(0x0012), file->reads[4].first) << "data block 0x10";
+
+	// Top table copy 1; use the first copy of the lower tables.
+	setMetadata(0x8000, 2);
+	file->hashStatus = 0;
+	readFile(true, 0x70E4, 2, false);
+	ASSERT_EQ(5U, file->reads.size());
+	EXPECT_EQ(physAddr(0x723B), file->reads[0].first) << "L2 table, copy 1";
+	EXPECT_EQ(physAddr(0x723C), file->reads[1].first) << "L1 table 1, copy 0";
+	EXPECT_EQ(physAddr(0x723E), file->reads[2].first) << "L0 table 0xAA, copy 0";
+
+	// Two-level package.
+	setMetadata(0x1000);
+	readFile(true, 0x00AA, 2, false);
+	ASSERT_EQ(4U, file->reads.size());
+	EXPECT_EQ(physAddr(0x00AC), file->reads[0].first) << "L1 table 0, copy 0";
+	EXPECT_EQ(physAddr(0x00AE), file->reads[1].first) << "L0 table 1, copy 0";
+	EXPECT_EQ(physAddr(0x00B0), file->reads[2].first) << "data block 0xAA";
+	EXPECT_EQ(physAddr(0x0012), file->reads[3].first) << "data block 0x10";
+}
+
+/**
+ * The hash chain ends early.
+ */
+TEST_F(StfsReaderTest, hashChainEnd)
+{
+	setMetadata(0x100);
+	file->nextBlock = STFS_HASH_CHAIN_END;
+
+	vector<uint8_t> buf(STFS_BLOCK_SIZE * 2);
+	StfsReader reader(file, &metadata, false, 0x10, 2, STFS_BLOCK_SIZE * 2, false);
+	EXPECT_EQ(static_cast<size_t>(STFS_BLOCK_SIZE), reader.read(buf.data(), buf.size()));
+	EXPECT_EQ(EIO, reader.lastError());
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: StfsReader tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
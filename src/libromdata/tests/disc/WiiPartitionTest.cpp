@@ -0,0 +1,271 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * WiiPartitionTest.cpp: WiiPartition hash tree verification test.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// WiiPartition
+#include "libromdata/disc/WiiPartition.hpp"
+#include "libromdata/Console/wii_structs.h"
+
+// librpcpu, librpbase, librpfile
+#include "librpcpu/byteswap.h"
+#include "librpbase/crypto/MultiHash.hpp"
+#include "librpbase/disc/DiscReader.hpp"
+#include "librpfile/RpMemFile.hpp"
+using namespace LibRpBase;
+using LibRpFile::RpMemFile;
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <vector>
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+class WiiPartitionTest : public ::testing::Test
+{
+	protected:
+		// Synthetic partition layout:
+		// - 0x00000: Partition header
+		// - 0x08000: H3 table
+		// - 0x20000: Data (one full group and one partial group)
+		static const unsigned int H3_OFFSET = 0x8000;
+		static const unsigned int DATA_OFFSET = 0x20000;
+		static const unsigned int SECTOR_COUNT = 64 + 10;
+
+		vector<uint8_t> image;
+
+		void SetUp(void) final
+		{
+			if (!(MultiHash::supportedAlgorithms() & MultiHash::ALGO_SHA1)) {
+				// No crypto backend.
+				return;
+			}
+
+			image.resize(DATA_OFFSET + (SECTOR_COUNT * 0x8000));
+			uint8_t *const data = &image[DATA_OFFSET];
+
+			// Fill the sector data with a pattern.
+			uint32_t seed = 0x12345678;
+			for (unsigned int sector = 0; sector < SECTOR_COUNT; sector++) {
+				uint8_t *const p = &data[(sector * 0x8000) + 0x400];
+				for (unsigned int i = 0; i < 0x7C00; i++) {
+					seed = (seed * 1103515245U) + 12345U;
+					p[i] = static_cast<uint8_t>(seed >> 16);
+				}
+			}
+
+			// Build the hash tree from the bottom up.
+			for (unsigned int sector = 0; sector < SECTOR_COUNT; sector++) {
+				buildH0(sector);
+			}
+			for (unsigned int sector = 0; sector < SECTOR_COUNT; sector++) {
+				// H1: Copy the H0 table hashes of this subgroup.
+				RVL_HashBlock *const hb = hashBlock(sector);
+				const unsigned int first = sector & ~7U;
+				for (unsigned int i = 0; i < 8 && first + i < SECTOR_COUNT; i++) {
+					MultiHash::sha1(hashBlock(first + i)->h0, sizeof(hb->h0), hb->h1[i]);
+				}
+			}
+			for (unsigned int sector = 0; sector < SECTOR_COUNT; sector++) {
+				// H2: Hash the H1 table of each subgroup in this group.
+				RVL_HashBlock *const hb = hashBlock(sector);
+				const unsigned int first = sector & ~63U;
+				for (unsigned int i = 0; i < 8 && first + (i * 8) < SECTOR_COUNT; i++) {
+					MultiHash::sha1(hashBlock(first + (i * 8))->h1, sizeof(hb->h1), hb->h2[i]);
+				}
+			}
+			uint8_t *const h3 = &image[H3_OFFSET];
+			for (unsigned int grp = 0; grp * 64 < SECTOR_COUNT; grp++) {
+				MultiHash::sha1(hashBlock(grp * 64)->h2, sizeof(RVL_HashBlock::h2), &h3[grp * 20]);
+			}
+
+			// Partition header.
+			RVL_PartitionHeader *const hdr = reinterpret_cast<RVL_PartitionHeader*>(&image[0]);
+			hdr->ticket.signature_type = cpu_to_be32(RVL_SIGNATURE_TYPE_RSA2048);
+			hdr->h3_table_offset = cpu_to_be32(H3_OFFSET >> 2);
+			hdr->data_offset = cpu_to_be32(DATA_OFFSET >> 2);
+			hdr->data_size = cpu_to_be32((SECTOR_COUNT * 0x8000) >> 2);
+			updateTmd();
+		}
+
+		RVL_HashBlock *hashBlock(unsigned int sector)
+		{
+			return reinterpret_cast<RVL_HashBlock*>(&image[DATA_OFFSET + (sector * 0x8000)]);
+		}
+
+		void buildH0(unsigned int sector)
+		{
+			RVL_HashBlock *const hb = hashBlock(sector);
+			const uint8_t *const p = &image[DATA_OFFSET + (sector * 0x8000) + 0x400];
+			for (unsigned int i = 0; i < 31; i++) {
+				MultiHash::sha1(&p[i * 0x400], 0x400, hb->h0[i]);
+			}
+		}
+
+		void updateTmd(void)
+		{
+			RVL_PartitionHeader *const hdr = reinterpret_cast<RVL_PartitionHeader*>(&image[0]);
+			RVL_TMD_Header *const tmd = reinterpret_cast<RVL_TMD_Header*>(hdr->tmd);
+			tmd->signature_type = cpu_to_be32(RVL_SIGNATURE_TYPE_RSA2048);
+			tmd->nbr_cont = cpu_to_be16(1);
+			RVL_Content_Entry *const content = reinterpret_cast<RVL_Content_Entry*>(&hdr->tmd[sizeof(*tmd)]);
+			MultiHash::sha1(&image[H3_OFFSET], RVL_H3_TABLE_SIZE, content->sha1_hash);
+		}
+
+		/**
+		 * Verify the synthetic partition.
+		 * @param result	[out] Hash verification results.
+		 * @param crypto	[in] Crypto method.
+		 * @return verifyHashes() return value.
+		 */
+		int verify(WiiPartition::HashCheckResult &result,
+			WiiPartition::CryptoMethod crypto = WiiPartition::CM_NASOS)
+		{
+			RpMemFile *const memFile = new RpMemFile(image.data(), image.size());
+			DiscReader *const discReader = new DiscReader(memFile);
+			memFile->unref();
+
+			int ret;
+			{
+				WiiPartition partition(discReader, 0, image.size(), crypto);
+				ret = partition.verifyHashes(result);
+			}
+			delete discReader;
+			return ret;
+		}
+};
+
+#define CHECK_CRYPTO_BACKEND() do { \
+	if (!(MultiHash::supportedAlgorithms() & MultiHash::ALGO_SHA1)) { \
+		fprintf(stderr, "*** SHA-1 isn't available; skipping this test.\n"); \
+		return; \
+	} \
+} while (0)
+
+/**
+ * Verify an intact partition.
+ */
+TEST_F(WiiPartitionTest, intactTest)
+{
+	CHECK_CRYPTO_BACKEND();
+
+	WiiPartition::HashCheckResult result;
+	ASSERT_EQ(0, verify(result));
+	EXPECT_EQ(64U + 10U, result.sectors_checked);
+	EXPECT_TRUE(result.h3_table_ok);
+	EXPECT_TRUE(result.bad_sectors.empty());
+}
+
+/**
+ * Corrupt a data block.
+ * Only the H0 check for that block should fail.
+ */
+TEST_F(WiiPartitionTest, corruptDataTest)
+{
+	CHECK_CRYPTO_BACKEND();
+
+	image[DATA_OFFSET + (5 * 0x8000) + 0x400 + (3 * 0x400) + 0x123] ^= 0x01;
+
+	WiiPartition::HashCheckResult result;
+	ASSERT_EQ(0, verify(result));
+	EXPECT_TRUE(result.h3_table_ok);
+	ASSERT_EQ(1U, result.bad_sectors.size());
+	EXPECT_EQ(5U, result.bad_sectors[0].sector);
+	EXPECT_EQ(1U << 3, result.bad_sectors[0].h0_blocks);
+	EXPECT_EQ(1U << 0, result.bad_sectors[0].h_levels);
+}
+
+/**
+ * Corrupt an H1 table in the partial group.
+ * The H1 and H2 checks for that sector should fail.
+ */
+TEST_F(WiiPartitionTest, corruptH1Test)
+{
+	CHECK_CRYPTO_BACKEND();
+
+	hashBlock(70)->h1[70 % 8][0] ^= 0x01;
+
+	WiiPartition::HashCheckResult result;
+	ASSERT_EQ(0, verify(result));
+	EXPECT_TRUE(result.h3_table_ok);
+	ASSERT_EQ(1U, result.bad_sectors.size());
+	EXPECT_EQ(70U, result.bad_sectors[0].sector);
+	EXPECT_EQ(0U, result.bad_sectors[0].h0_blocks);
+	EXPECT_EQ((1U << 1) | (1U << 2), result.bad_sectors[0].h_levels);
+}
+
+/**
+ * Corrupt an H3 hash.
+ * The H3 table shouldn't match the TMD, and the H3 check
+ * should fail for every sector in that group.
+ */
+TEST_F(WiiPartitionTest, corruptH3Test)
+{
+	CHECK_CRYPTO_BACKEND();
+
+	image[H3_OFFSET + 20] ^= 0x01;
+
+	WiiPartition::HashCheckResult result;
+	ASSERT_EQ(0, verify(result));
+	EXPECT_FALSE(result.h3_table_ok);
+	ASSERT_EQ(10U, result.bad_sectors.size());
+	for (unsigned int i = 0; i < 10; i++) {
+		EXPECT_EQ(64 + i, result.bad_sectors[i].sector);
+		EXPECT_EQ(1U << 3, result.bad_sectors[i].h_levels);
+	}
+}
+
+/**
+ * Groups without an H3 hash should be skipped.
+ */
+TEST_F(WiiPartitionTest, unusedGroupTest)
+{
+	CHECK_CRYPTO_BACKEND();
+
+	memset(&image[H3_OFFSET + 20], 0, 20);
+	updateTmd();
+
+	WiiPartition::HashCheckResult result;
+	ASSERT_EQ(0, verify(result));
+	EXPECT_EQ(64U, result.sectors_checked);
+	EXPECT_TRUE(result.h3_table_ok);
+	EXPECT_TRUE(result.bad_sectors.empty());
+}
+
+/**
+ * Partitions without hashes can't be verified.
+ */
+TEST_F(WiiPartitionTest, noHashesTest)
+{
+	CHECK_CRYPTO_BACKEND();
+
+	WiiPartition::HashCheckResult result;
+	EXPECT_EQ(-ENOTSUP, verify(result, WiiPartition::CM_RVTH));
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: WiiPartition tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
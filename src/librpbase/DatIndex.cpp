@@ -0,0 +1,433 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * DatIndex.cpp: Compiled DAT index reader.                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "DatIndex.hpp"
+#include "datindex_structs.h"
+
+// librpcpu
+#include "librpcpu/byteswap.h"
+
+// librpfile
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/RpFile.hpp"
+using LibRpFile::RpFile;
+
+// C++ STL classes.
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace LibRpBase {
+
+class DatIndexPrivate
+{
+	public:
+		explicit DatIndexPrivate(const char *filename);
+		~DatIndexPrivate();
+
+	private:
+		RP_DISABLE_COPY(DatIndexPrivate)
+
+	public:
+		// Index file.
+		RpFile *file;
+		int lastError;
+
+		// Index data.
+		// This is either a view of the memory-mapped file,
+		// or a copy in fallbackBuf if mapping isn't supported.
+		const uint8_t *data;
+		size_t data_size;
+		unique_ptr<uint8_t[]> fallbackBuf;
+
+		// Sections. (pointers into data)
+		const DatIndex_Header *header;
+		const DatIndex_Entry *entries;
+		const DatIndex_CrcKey *crcKeys;
+		const DatIndex_Sha1Key *sha1Keys;
+		const DatIndex_SerialKey *serialKeys;
+		const char *strtbl;
+		uint32_t strtbl_size;
+
+		// Maximum index size if the file can't be mapped.
+		static const size_t FALLBACK_SIZE_MAX = 256U*1024U*1024U;
+
+	public:
+		/**
+		 * Load and validate the index.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int load(void);
+
+		/**
+		 * Get a string from the string table.
+		 * @param offset String offset.
+		 * @return String, or empty string if the offset is invalid.
+		 */
+		inline const char *getString(uint32_t offset) const
+		{
+			offset = le32_to_cpu(offset);
+			return (offset < strtbl_size ? &strtbl[offset] : "");
+		}
+
+		/**
+		 * Convert an on-disk entry to a DatIndex::Entry.
+		 * @param entry_idx	[in] Entry index.
+		 * @param pEntry	[out] DatIndex::Entry.
+		 * @return True on success; false if entry_idx is out of range.
+		 */
+		bool getEntry(uint32_t entry_idx, DatIndex::Entry *pEntry) const;
+};
+
+/** DatIndexPrivate **/
+
+DatIndexPrivate::DatIndexPrivate(const char *filename)
+	: file(nullptr)
+	, lastError(0)
+	, data(nullptr)
+	, data_size(0)
+	, header(nullptr)
+	, entries(nullptr)
+	, crcKeys(nullptr)
+	, sha1Keys(nullptr)
+	, serialKeys(nullptr)
+	, strtbl(nullptr)
+	, strtbl_size(0)
+{
+	assert(filename != nullptr);
+	if (!filename || filename[0] == '\0') {
+		lastError = EINVAL;
+		return;
+	}
+
+	// NOTE: The index can be memory-mapped, since DatCompiler
+	// deletes the old index instead of truncating it.
+	file = new RpFile(filename, static_cast<RpFile::FileMode>(RpFile::FM_OPEN_READ | RpFile::FM_MMAP));
+	if (!file->isOpen()) {
+		lastError = file->lastError();
+		if (lastError == 0) {
+			lastError = EIO;
+		}
+		file->unref();
+		file = nullptr;
+		return;
+	}
+
+	int ret = load();
+	if (ret != 0) {
+		lastError = -ret;
+		data = nullptr;
+		header = nullptr;
+		fallbackBuf.reset();
+		file->unref();
+		file = nullptr;
+	}
+}
+
+DatIndexPrivate::~DatIndexPrivate()
+{
+	if (file) {
+		file->unref();
+	}
+}
+
+/**
+ * Load and validate the index.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int DatIndexPrivate::load(void)
+{
+	const off64_t fileSize = file->size();
+	if (fileSize < static_cast<off64_t>(sizeof(DatIndex_Header))) {
+		// File is too small.
+		return -EIO;
+	} else if (static_cast<uint64_t>(fileSize) > 0xFFFFFFFFU) {
+		// File is too big. (offsets are 32-bit)
+		return -EIO;
+	}
+	data_size = static_cast<size_t>(fileSize);
+
+	// Map the file if possible.
+	data = file->view(0, data_size);
+	if (!data) {
+		// Unable to map the file. Read it into memory instead.
+		if (data_size > FALLBACK_SIZE_MAX) {
+			return -ENOMEM;
+		}
+		fallbackBuf.reset(new uint8_t[data_size]);
+		size_t size = file->seekAndRead(0, fallbackBuf.get(), data_size);
+		if (size != data_size) {
+			const int err = file->lastError();
+			return (err != 0 ? -err : -EIO);
+		}
+		data = fallbackBuf.get();
+	}
+
+	// Check the header.
+	header = reinterpret_cast<const DatIndex_Header*>(data);
+	if (memcmp(header->magic, DATINDEX_MAGIC, sizeof(header->magic)) != 0 ||
+	    le32_to_cpu(header->version) != DATINDEX_VERSION)
+	{
+		// Not a DAT index, or an unsupported version.
+		return -EIO;
+	}
+
+	// Validate the section bounds.
+	struct section_t {
+		uint32_t offset;
+		uint32_t count;
+		uint32_t elem_size;
+	};
+	const section_t sections[] = {
+		{le32_to_cpu(header->entry_offset),	le32_to_cpu(header->entry_count),	sizeof(DatIndex_Entry)},
+		{le32_to_cpu(header->crc_offset),	le32_to_cpu(header->entry_count),	sizeof(DatIndex_CrcKey)},
+		{le32_to_cpu(header->sha1_offset),	le32_to_cpu(header->sha1_count),	sizeof(DatIndex_Sha1Key)},
+		{le32_to_cpu(header->serial_offset),	le32_to_cpu(header->serial_count),	sizeof(DatIndex_SerialKey)},
+		{le32_to_cpu(header->strtbl_offset),	le32_to_cpu(header->strtbl_size),	1},
+	};
+	for (const section_t &section : sections) {
+		const uint64_t end = static_cast<uint64_t>(section.offset) +
+			(static_cast<uint64_t>(section.count) * section.elem_size);
+		if (section.offset < sizeof(DatIndex_Header) || end > data_size) {
+			// Section is out of bounds.
+			return -EIO;
+		}
+	}
+
+	// The string table must start with an empty string
+	// and end with a NUL terminator.
+	strtbl_size = le32_to_cpu(header->strtbl_size);
+	strtbl = reinterpret_cast<const char*>(&data[le32_to_cpu(header->strtbl_offset)]);
+	if (strtbl_size == 0 || strtbl[0] != '\0' || strtbl[strtbl_size-1] != '\0') {
+		return -EIO;
+	}
+
+	entries = reinterpret_cast<const DatIndex_Entry*>(&data[le32_to_cpu(header->entry_offset)]);
+	crcKeys = reinterpret_cast<const DatIndex_CrcKey*>(&data[le32_to_cpu(header->crc_offset)]);
+	sha1Keys = reinterpret_cast<const DatIndex_Sha1Key*>(&data[le32_to_cpu(header->sha1_offset)]);
+	serialKeys = reinterpret_cast<const DatIndex_SerialKey*>(&data[le32_to_cpu(header->serial_offset)]);
+	return 0;
+}
+
+/**
+ * Convert an on-disk entry to a DatIndex::Entry.
+ * @param entry_idx	[in] Entry index.
+ * @param pEntry	[out] DatIndex::Entry.
+ * @return True on success; false if entry_idx is out of range.
+ */
+bool DatIndexPrivate::getEntry(uint32_t entry_idx, DatIndex::Entry *pEntry) const
+{
+	entry_idx = le32_to_cpu(entry_idx);
+	if (entry_idx >= le32_to_cpu(header->entry_count))
+		return false;
+
+	const DatIndex_Entry *const entry = &entries[entry_idx];
+	const uint32_t flags = le32_to_cpu(entry->flags);
+	pEntry->game_name = getString(entry->game_name);
+	pEntry->rom_name = getString(entry->rom_name);
+	pEntry->serial = getString(entry->serial);
+	pEntry->size = le64_to_cpu(entry->size);
+	pEntry->crc32 = le32_to_cpu(entry->crc32);
+	pEntry->has_crc32 = !!(flags & DATINDEX_FLAG_HAS_CRC32);
+	pEntry->has_sha1 = !!(flags & DATINDEX_FLAG_HAS_SHA1);
+	memcpy(pEntry->sha1, entry->sha1, sizeof(pEntry->sha1));
+	return true;
+}
+
+/** DatIndex **/
+
+/**
+ * Open a compiled DAT index.
+ *
+ * The index is memory-mapped if possible, so opening
+ * it doesn't require parsing, and lookups are done
+ * directly on the mapped data.
+ *
+ * @param filename Index filename.
+ */
+DatIndex::DatIndex(const char *filename)
+	: d_ptr(new DatIndexPrivate(filename))
+{ }
+
+DatIndex::~DatIndex()
+{
+	delete d_ptr;
+}
+
+/**
+ * Get the index filename for a RomData subclass.
+ * Indexes are stored in the "dat" subdirectory
+ * of the rom-properties cache directory.
+ * @param className RomData class name.
+ * @return Index filename, or empty string on error.
+ */
+string DatIndex::indexFilename(const char *className)
+{
+	if (!className || className[0] == '\0')
+		return string();
+
+	// Class names are used as filenames, so they
+	// must not contain any path separators.
+	for (const char *p = className; *p != '\0'; p++) {
+		if (!ISALNUM(*p) && *p != '_')
+			return string();
+	}
+
+	const string &cache_dir = LibRpFile::FileSystem::getCacheDirectory();
+	if (cache_dir.empty())
+		return string();
+
+	string filename = cache_dir;
+	if (filename.at(filename.size()-1) != DIR_SEP_CHR) {
+		filename += DIR_SEP_CHR;
+	}
+	filename += "dat";
+	filename += DIR_SEP_CHR;
+	filename += className;
+	filename += ".datidx";
+	return filename;
+}
+
+/**
+ * Is the index open?
+ * @return True if open; false if not.
+ */
+bool DatIndex::isOpen(void) const
+{
+	RP_D(const DatIndex);
+	return (d->header != nullptr);
+}
+
+/**
+ * Get the last error.
+ * @return Last POSIX error, or 0 if no error.
+ */
+int DatIndex::lastError(void) const
+{
+	RP_D(const DatIndex);
+	return d->lastError;
+}
+
+/**
+ * Get the DAT name, e.g. "Nintendo - GameCube".
+ * @return DAT name, or empty string if not set.
+ */
+const char *DatIndex::datName(void) const
+{
+	RP_D(const DatIndex);
+	return (d->header ? d->getString(d->header->dat_name) : "");
+}
+
+/**
+ * Get the DAT version.
+ * @return DAT version, or empty string if not set.
+ */
+const char *DatIndex::datVersion(void) const
+{
+	RP_D(const DatIndex);
+	return (d->header ? d->getString(d->header->dat_version) : "");
+}
+
+/**
+ * Get the number of entries in the index.
+ * @return Number of entries.
+ */
+unsigned int DatIndex::count(void) const
+{
+	RP_D(const DatIndex);
+	return (d->header ? le32_to_cpu(d->header->entry_count) : 0);
+}
+
+/**
+ * Find an entry by SHA-1.
+ * @param sha1	[in] SHA-1 digest.
+ * @param pEntry	[out] Entry.
+ * @return True if found; false if not.
+ */
+bool DatIndex::findBySha1(const uint8_t sha1[20], Entry *pEntry) const
+{
+	RP_D(const DatIndex);
+	assert(sha1 != nullptr);
+	assert(pEntry != nullptr);
+	if (!d->header || !sha1 || !pEntry)
+		return false;
+
+	const DatIndex_Sha1Key *const pBegin = d->sha1Keys;
+	const DatIndex_Sha1Key *const pEnd = pBegin + le32_to_cpu(d->header->sha1_count);
+	const DatIndex_Sha1Key *const pKey = std::lower_bound(pBegin, pEnd, sha1,
+		[](const DatIndex_Sha1Key &key, const uint8_t *sha1) {
+			return (memcmp(key.sha1, sha1, sizeof(key.sha1)) < 0);
+		});
+	if (pKey == pEnd || memcmp(pKey->sha1, sha1, sizeof(pKey->sha1)) != 0)
+		return false;
+
+	return d->getEntry(pKey->entry_idx, pEntry);
+}
+
+/**
+ * Find entries by CRC32.
+ * CRC32 collisions are possible, so multiple
+ * candidates may be returned. Check the size
+ * to narrow it down.
+ * @param crc32 CRC32.
+ * @return Matching entries.
+ */
+vector<DatIndex::Entry> DatIndex::findByCrc32(uint32_t crc32) const
+{
+	RP_D(const DatIndex);
+	vector<Entry> vec;
+	if (!d->header)
+		return vec;
+
+	const DatIndex_CrcKey *const pBegin = d->crcKeys;
+	const DatIndex_CrcKey *const pEnd = pBegin + le32_to_cpu(d->header->entry_count);
+	const DatIndex_CrcKey *pKey = std::lower_bound(pBegin, pEnd, crc32,
+		[](const DatIndex_CrcKey &key, uint32_t crc32) {
+			return (le32_to_cpu(key.crc32) < crc32);
+		});
+	for (; pKey != pEnd && le32_to_cpu(pKey->crc32) == crc32; ++pKey) {
+		Entry entry;
+		if (d->getEntry(pKey->entry_idx, &entry) && entry.has_crc32) {
+			vec.push_back(entry);
+		}
+	}
+	return vec;
+}
+
+/**
+ * Find entries by serial number.
+ * Multiple entries may have the same serial number,
+ * e.g. multi-disc games or revisions.
+ * @param serial Serial number.
+ * @return Matching entries.
+ */
+vector<DatIndex::Entry> DatIndex::findBySerial(const char *serial) const
+{
+	RP_D(const DatIndex);
+	vector<Entry> vec;
+	assert(serial != nullptr);
+	if (!d->header || !serial || serial[0] == '\0')
+		return vec;
+
+	const DatIndex_SerialKey *const pBegin = d->serialKeys;
+	const DatIndex_SerialKey *const pEnd = pBegin + le32_to_cpu(d->header->serial_count);
+	const DatIndex_SerialKey *pKey = std::lower_bound(pBegin, pEnd, serial,
+		[d](const DatIndex_SerialKey &key, const char *serial) {
+			return (strcmp(d->getString(key.serial), serial) < 0);
+		});
+	for (; pKey != pEnd && !strcmp(d->getString(pKey->serial), serial); ++pKey) {
+		Entry entry;
+		if (d->getEntry(pKey->entry_idx, &entry)) {
+			vec.push_back(entry);
+		}
+	}
+	return vec;
+}
+
+}
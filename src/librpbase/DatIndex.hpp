@@ -0,0 +1,132 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * DatIndex.hpp: Compiled DAT index reader.                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_DATINDEX_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_DATINDEX_HPP__
+
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+
+// C++ includes.
+#include <string>
+#include <vector>
+
+namespace LibRpBase {
+
+class DatIndexPrivate;
+class DatIndex
+{
+	public:
+		/**
+		 * Open a compiled DAT index.
+		 *
+		 * The index is memory-mapped if possible, so opening
+		 * it doesn't require parsing, and lookups are done
+		 * directly on the mapped data.
+		 *
+		 * @param filename Index filename.
+		 */
+		explicit DatIndex(const char *filename);
+		~DatIndex();
+
+	private:
+		RP_DISABLE_COPY(DatIndex)
+	private:
+		friend class DatIndexPrivate;
+		DatIndexPrivate *const d_ptr;
+
+	public:
+		/**
+		 * Get the index filename for a RomData subclass.
+		 * Indexes are stored in the "dat" subdirectory
+		 * of the rom-properties cache directory.
+		 * @param className RomData class name.
+		 * @return Index filename, or empty string on error.
+		 */
+		static std::string indexFilename(const char *className);
+
+		/**
+		 * Is the index open?
+		 * @return True if open; false if not.
+		 */
+		bool isOpen(void) const;
+
+		/**
+		 * Get the last error.
+		 * @return Last POSIX error, or 0 if no error.
+		 */
+		int lastError(void) const;
+
+		/**
+		 * Get the DAT name, e.g. "Nintendo - GameCube".
+		 * @return DAT name, or empty string if not set.
+		 */
+		const char *datName(void) const;
+
+		/**
+		 * Get the DAT version.
+		 * @return DAT version, or empty string if not set.
+		 */
+		const char *datVersion(void) const;
+
+		/**
+		 * Get the number of entries in the index.
+		 * @return Number of entries.
+		 */
+		unsigned int count(void) const;
+
+	public:
+		/**
+		 * DAT index entry.
+		 * Strings point into the index, so they remain
+		 * valid as long as the DatIndex is open.
+		 */
+		struct Entry {
+			const char *game_name;	// Game name
+			const char *rom_name;	// ROM filename
+			const char *serial;	// Serial number (empty if none)
+			uint64_t size;		// ROM size, in bytes
+			uint32_t crc32;		// CRC32
+			bool has_crc32;		// True if crc32 is valid.
+			bool has_sha1;		// True if sha1 is valid.
+			uint8_t sha1[20];	// SHA-1
+		};
+
+		/**
+		 * Find an entry by SHA-1.
+		 * @param sha1	[in] SHA-1 digest.
+		 * @param pEntry	[out] Entry.
+		 * @return True if found; false if not.
+		 */
+		bool findBySha1(const uint8_t sha1[20], Entry *pEntry) const;
+
+		/**
+		 * Find entries by CRC32.
+		 * CRC32 collisions are possible, so multiple
+		 * candidates may be returned. Check the size
+		 * to narrow it down.
+		 * @param crc32 CRC32.
+		 * @return Matching entries.
+		 */
+		std::vector<Entry> findByCrc32(uint32_t crc32) const;
+
+		/**
+		 * Find entries by serial number.
+		 * Multiple entries may have the same serial number,
+		 * e.g. multi-disc games or revisions.
+		 * @param serial Serial number.
+		 * @return Matching entries.
+		 */
+		std::vector<Entry> findBySerial(const char *serial) const;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_DATINDEX_HPP__ */
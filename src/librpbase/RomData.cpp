@@ -9,7 +9,11 @@
 #include "stdafx.h"
 #include "RomData.hpp"
 #include "RomData_p.hpp"
+#include "librpthreads/Profiler.hpp"
 
+#include "DatIndex.hpp"
+#include "config/Config.hpp"
+#include "crypto/MultiHash.hpp"
 #include "libi18n/i18n.h"
 
 // librpthreads
@@ -43,6 +47,8 @@ RomDataPrivate::RomDataPrivate(RomData *q, IRpFile *file)
 	, className(nullptr)
 	, mimeType(nullptr)
 	, fileType(RomData::FTYPE_ROM_IMAGE)
+	, hashesAdded(false)
+	, integrityAdded(false)
 {
 	// Initialize i18n.
 	rp_i18n_init();
@@ -416,6 +422,39 @@ time_t RomDataPrivate::pvd_time_to_unix_time(const char pvd_time[16], int8_t tz_
 	return unixtime;
 }
 
+/**
+ * Look up the hashed file in a DAT index.
+ * SHA-1 is checked first if available, then CRC32 and size.
+ * @param datIndex DAT index.
+ * @param hash Finalized MultiHash.
+ * @return Game name, or nullptr if not found.
+ */
+const char *RomDataPrivate::lookupDatIndex(const DatIndex &datIndex, const MultiHash &hash)
+{
+	uint8_t digest[20];
+	if (hash.digest(MultiHash::ALGO_SHA1, digest, sizeof(digest)) == static_cast<int>(sizeof(digest))) {
+		DatIndex::Entry entry;
+		if (datIndex.findBySha1(digest, &entry)) {
+			return entry.game_name;
+		}
+		// Not found. Some DATs don't have SHA-1 for all
+		// entries, so check the CRC32 as well.
+	}
+
+	if (hash.digest(MultiHash::ALGO_CRC32, digest, sizeof(digest)) != 4) {
+		// No usable hashes.
+		return nullptr;
+	}
+	const uint32_t crc32 = (digest[0] << 24) | (digest[1] << 16) |
+	                       (digest[2] <<  8) |  digest[3];
+	for (const DatIndex::Entry &entry : datIndex.findByCrc32(crc32)) {
+		if (entry.size == hash.bytesHashed()) {
+			return entry.game_name;
+		}
+	}
+	return nullptr;
+}
+
 /** RomData **/
 
 /**
@@ -702,6 +741,24 @@ int RomData::loadInternalImage(ImageType imageType, const rp_image **pImage)
 	return -ENOENT;
 }
 
+/**
+ * Load an internal image at a specific size.
+ * Called by RomData::image() if a size was requested.
+ *
+ * The default implementation ignores the index
+ * and calls loadInternalImage().
+ *
+ * @param imageType	[in] Image type to load.
+ * @param index		[in] Image index. (ImageSizeDef::index from supportedImageSizes())
+ * @param pImage	[out] Pointer to const rp_image* to store the image in.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomData::loadInternalImageSized(ImageType imageType, int index, const rp_image **pImage)
+{
+	RP_UNUSED(index);
+	return loadInternalImage(imageType, pImage);
+}
+
 /**
  * Load metadata properties.
  * Called by RomData::metaData() if the field data hasn't been loaded yet.
@@ -723,9 +780,17 @@ const RomFields *RomData::fields(void) const
 	if (d->fields->empty()) {
 		// Data has not been loaded.
 		// Load it now.
+		RP_PROFILE_SCOPE(STAGE_LOAD_FIELD_DATA);
 		int ret = const_cast<RomData*>(this)->loadFieldData();
 		if (ret < 0)
 			return nullptr;
+
+		if (Config::instance()->showFileHashes()) {
+			// Add the file hashes.
+			// NOTE: Errors are ignored here, since the
+			// rest of the fields are still usable.
+			const_cast<RomData*>(this)->addHashFields(MultiHash::supportedAlgorithms());
+		}
 	}
 	return d->fields;
 }
@@ -767,6 +832,7 @@ const rp_image *RomData::image(ImageType imageType) const
 
 	// Load the internal image.
 	// The subclass maintains ownership of the image.
+	RP_PROFILE_SCOPE(STAGE_LOAD_INTERNAL_IMAGE);
 #ifdef _DEBUG
 	// TODO: Verify casting on 32-bit.
 	#define INVALID_IMG_PTR ((const rp_image*)((intptr_t)-1LL))
@@ -787,6 +853,79 @@ const rp_image *RomData::image(ImageType imageType) const
 	return (ret == 0 ? img : nullptr);
 }
 
+/**
+ * Get an internal image from the ROM, using the smallest
+ * available size that's at least as large as the requested size.
+ * If no size is large enough, the largest size is used.
+ *
+ * This allows thumbnailers to use a smaller pre-rendered
+ * image, e.g. a texture mipmap, instead of decoding
+ * the full image.
+ *
+ * NOTE: The rp_image is owned by this object.
+ * Do NOT delete this object until you're done using this rp_image.
+ *
+ * @param imageType Image type to load.
+ * @param size Requested image size. (single dimension; assuming square image)
+ * @return Internal image, or nullptr if the ROM doesn't have one.
+ */
+const rp_image *RomData::image(ImageType imageType, int size) const
+{
+	assert(imageType >= IMG_INT_MIN && imageType <= IMG_INT_MAX);
+	if (imageType < IMG_INT_MIN || imageType > IMG_INT_MAX) {
+		// ImageType is out of range.
+		return nullptr;
+	}
+
+	const vector<ImageSizeDef> sizeDefs = supportedImageSizes(imageType);
+	if (sizeDefs.size() <= 1 || size <= 0) {
+		// Only one size is available.
+		return image(imageType);
+	}
+
+	// Find the smallest size that's at least as large as the
+	// requested size, or the largest size if none are.
+	// Sizes with unknown dimensions are ignored.
+	const ImageSizeDef *best = nullptr;
+	const ImageSizeDef *largest = nullptr;
+	for (auto iter = sizeDefs.cbegin(); iter != sizeDefs.cend(); ++iter) {
+		const int w = iter->width;
+		const int h = iter->height;
+		if (w == 0 || h == 0)
+			continue;
+		if (!largest || w * h > largest->width * largest->height) {
+			largest = &(*iter);
+		}
+		if (std::max(w, h) >= size &&
+		    (!best || w * h < best->width * best->height))
+		{
+			best = &(*iter);
+		}
+	}
+	if (!best) {
+		best = largest;
+		if (!best) {
+			// No usable sizes.
+			return image(imageType);
+		}
+	}
+
+	RP_PROFILE_SCOPE(STAGE_LOAD_INTERNAL_IMAGE);
+	const rp_image *img = nullptr;
+	int ret = const_cast<RomData*>(this)->loadInternalImageSized(imageType, best->index, &img);
+
+	// SANITY CHECK: If loadInternalImageSized() returns 0,
+	// img *must* be valid. Otherwise, it must be nullptr.
+	assert((ret == 0 && img != nullptr) ||
+	       (ret != 0 && img == nullptr));
+	if (ret != 0) {
+		// Unable to load the selected size.
+		// Fall back to the default image.
+		return image(imageType);
+	}
+	return img;
+}
+
 /**
  * Get a list of URLs for an external image type.
  *
@@ -905,4 +1044,199 @@ bool RomData::hasDangerousPermissions(void) const
 	return false;
 }
 
+/**
+ * Get the logical disc image, if this is a disc image
+ * stored in a sparse or compressed container.
+ * This is used to calculate hashes of the logical disc image.
+ *
+ * NOTE: The IDiscReader is owned by this object.
+ *
+ * @return IDiscReader, or nullptr if the file should be hashed as-is.
+ */
+IDiscReader *RomData::logicalImage(void) const
+{
+	// No logical disc image by default.
+	return nullptr;
+}
+
+/**
+ * Verify the ROM image using its internal hashes,
+ * e.g. the H0-H3 hash tree on Wii partitions.
+ *
+ * Reads are done sequentially, while decryption and
+ * hashing are done on the worker threads.
+ *
+ * NOTE: This reads the entire ROM image, so it may take a while.
+ *
+ * @param errors	[out] Integrity errors. (empty if the ROM image is intact)
+ * @param group		[in,opt] Task group for cancellation.
+ * @return 0 if verified; negative POSIX error code on error. (-ENOTSUP if no internal hashes)
+ */
+int RomData::verifyIntegrity(vector<IntegrityError> &errors, TaskGroup *group)
+{
+	// No internal hashes by default.
+	RP_UNUSED(errors);
+	RP_UNUSED(group);
+	return -ENOTSUP;
+}
+
+/**
+ * Add a "Hashes" tab to the ROM fields.
+ *
+ * The hashes are calculated over the logical disc image
+ * if one is available; otherwise, the file is hashed as-is.
+ *
+ * NOTE: This reads the entire file, so it may take a while.
+ * RomData::fields() calls this automatically if file hashes
+ * are enabled in the user configuration.
+ *
+ * @param algorithms Hash algorithms. (MultiHash::Algorithm bitfield)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomData::addHashFields(unsigned int algorithms)
+{
+	// Make sure the field data has been loaded first.
+	// Otherwise, the "Hashes" tab would prevent loadFieldData()
+	// from being called, since the fields wouldn't be empty.
+	if (!fields()) {
+		return -EIO;
+	}
+
+	RP_D(RomData);
+	if (d->hashesAdded) {
+		// Hashes were already added.
+		return 0;
+	}
+
+	MultiHash hash(algorithms);
+	if (hash.algorithms() == 0) {
+		// None of the requested algorithms are supported.
+		return -ENOTSUP;
+	}
+
+	int ret;
+	IDiscReader *const discReader = logicalImage();
+	if (discReader) {
+		ret = hash.hashReader(discReader);
+	} else if (d->file) {
+		ret = hash.hashFile(d->file);
+	} else {
+		// File isn't open.
+		return -EBADF;
+	}
+	if (ret != 0) {
+		return ret;
+	}
+
+	// If only a single unnamed tab is present, name it
+	// using the system name so the tabs are displayed.
+	RomFields *const fields = d->fields;
+	if (fields->tabCount() == 1 && !fields->tabName(0)) {
+		fields->setTabName(0, systemName(SYSNAME_TYPE_SHORT | SYSNAME_REGION_GENERIC));
+	}
+
+	fields->addTab(C_("RomData", "Hashes"));
+	fields->reserve(fields->count() + MultiHash::ALGO_COUNT);
+	for (unsigned int i = 0; i < MultiHash::ALGO_COUNT; i++) {
+		const MultiHash::Algorithm algo = static_cast<MultiHash::Algorithm>(1U << i);
+		if (!(hash.algorithms() & algo))
+			continue;
+		fields->addField_string(MultiHash::algorithmName(algo),
+			hash.hexDigest(algo), RomFields::STRF_MONOSPACE);
+	}
+
+	// Check the DAT index for this system, if one was compiled.
+	const string idxFilename = DatIndex::indexFilename(d->className);
+	if (!idxFilename.empty()) {
+		const DatIndex datIndex(idxFilename.c_str());
+		if (datIndex.isOpen()) {
+			const char *const game_name = d->lookupDatIndex(datIndex, hash);
+			if (game_name) {
+				fields->addField_string(C_("RomData", "Verified Dump"), game_name);
+			} else if (datIndex.datName()[0] != '\0') {
+				fields->addField_string(C_("RomData", "Verified Dump"),
+					rp_sprintf(C_("RomData", "Not found in %s"), datIndex.datName()));
+			} else {
+				fields->addField_string(C_("RomData", "Verified Dump"),
+					C_("RomData", "Not found"));
+			}
+		}
+	}
+
+	d->hashesAdded = true;
+	return 0;
+}
+
+/**
+ * Add an "Integrity" tab to the ROM fields.
+ * This uses verifyIntegrity() to check the internal hashes.
+ *
+ * NOTE: This reads the entire ROM image, so it may take a while.
+ *
+ * @param group [in,opt] Task group for cancellation.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomData::addIntegrityFields(TaskGroup *group)
+{
+	// Make sure the field data has been loaded first.
+	if (!fields()) {
+		return -EIO;
+	}
+
+	RP_D(RomData);
+	if (d->integrityAdded) {
+		// Integrity fields were already added.
+		return 0;
+	}
+
+	vector<IntegrityError> errors;
+	int ret = verifyIntegrity(errors, group);
+	if (ret != 0) {
+		return ret;
+	}
+
+	// If only a single unnamed tab is present, name it
+	// using the system name so the tabs are displayed.
+	RomFields *const fields = d->fields;
+	if (fields->tabCount() == 1 && !fields->tabName(0)) {
+		fields->setTabName(0, systemName(SYSNAME_TYPE_SHORT | SYSNAME_REGION_GENERIC));
+	}
+
+	fields->addTab(C_("RomData", "Integrity"));
+	const char *const integrity_title = C_("RomData", "Integrity");
+	if (errors.empty()) {
+		fields->addField_string(integrity_title, C_("RomData", "No errors found."));
+	} else {
+		const unsigned int count = static_cast<unsigned int>(errors.size());
+		fields->addField_string(integrity_title,
+			rp_sprintf(NC_("RomData", "%u error found.", "%u errors found.", count), count));
+
+		auto vv_errors = new RomFields::ListData_t();
+		vv_errors->resize(errors.size());
+		auto src_iter = errors.begin();
+		auto dest_iter = vv_errors->begin();
+		for (; dest_iter != vv_errors->end(); ++src_iter, ++dest_iter) {
+			vector<string> &data_row = *dest_iter;
+			data_row.reserve(2);
+			data_row.emplace_back(std::move(src_iter->location));
+			data_row.emplace_back(std::move(src_iter->description));
+		}
+
+		static const char *const errors_names[] = {
+			NOP_C_("RomData|Integrity", "Location"),
+			NOP_C_("RomData|Integrity", "Description"),
+		};
+		vector<string> *const v_errors_names = RomFields::strArrayToVector_i18n(
+			"RomData|Integrity", errors_names, ARRAY_SIZE(errors_names));
+
+		RomFields::AFLD_PARAMS params;
+		params.headers = v_errors_names;
+		params.data.single = vv_errors;
+		fields->addField_listData(C_("RomData", "Errors"), &params);
+	}
+
+	d->integrityAdded = true;
+	return 0;
+}
+
 }
@@ -29,6 +29,8 @@ namespace LibRpTexture {
 
 namespace LibRpBase {
 
+class IDiscReader;
+class TaskGroup;
 class RomFields;
 class RomMetaData;
 struct IconAnimData;
@@ -415,6 +417,20 @@ class RomData
 		 */
 		virtual int loadInternalImage(ImageType imageType, const LibRpTexture::rp_image **pImage);
 
+		/**
+		 * Load an internal image at a specific size.
+		 * Called by RomData::image() if a size was requested.
+		 *
+		 * The default implementation ignores the index
+		 * and calls loadInternalImage().
+		 *
+		 * @param imageType	[in] Image type to load.
+		 * @param index		[in] Image index. (ImageSizeDef::index from supportedImageSizes())
+		 * @param pImage	[out] Pointer to const rp_image* to store the image in.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int loadInternalImageSized(ImageType imageType, int index, const LibRpTexture::rp_image **pImage);
+
 	public:
 		/**
 		 * Get the ROM Fields object.
@@ -448,6 +464,24 @@ class RomData
 		 */
 		const LibRpTexture::rp_image *image(ImageType imageType) const;
 
+		/**
+		 * Get an internal image from the ROM, using the smallest
+		 * available size that's at least as large as the requested size.
+		 * If no size is large enough, the largest size is used.
+		 *
+		 * This allows thumbnailers to use a smaller pre-rendered
+		 * image, e.g. a texture mipmap, instead of decoding
+		 * the full image.
+		 *
+		 * NOTE: The rp_image is owned by this object.
+		 * Do NOT delete this object until you're done using this rp_image.
+		 *
+		 * @param imageType Image type to load.
+		 * @param size Requested image size. (single dimension; assuming square image)
+		 * @return Internal image, or nullptr if the ROM doesn't have one.
+		 */
+		const LibRpTexture::rp_image *image(ImageType imageType, int size) const;
+
 		/**
 		 * External URLs for a media type.
 		 * Includes URL and "cache key" for local caching,
@@ -534,6 +568,67 @@ class RomData
 		 * @return True if the ROM image has "dangerous" permissions; false if not.
 		 */
 		virtual bool hasDangerousPermissions(void) const;
+
+	public:
+		/**
+		 * Get the logical disc image, if this is a disc image
+		 * stored in a sparse or compressed container.
+		 * This is used to calculate hashes of the logical disc image.
+		 *
+		 * NOTE: The IDiscReader is owned by this object.
+		 *
+		 * @return IDiscReader, or nullptr if the file should be hashed as-is.
+		 */
+		virtual IDiscReader *logicalImage(void) const;
+
+		/**
+		 * Integrity error found by verifyIntegrity().
+		 */
+		struct IntegrityError {
+			std::string location;		// Location, e.g. partition and sector, or a filename.
+			std::string description;	// Description of the error.
+		};
+
+		/**
+		 * Verify the ROM image using its internal hashes,
+		 * e.g. the H0-H3 hash tree on Wii partitions.
+		 *
+		 * Reads are done sequentially, while decryption and
+		 * hashing are done on the worker threads.
+		 *
+		 * NOTE: This reads the entire ROM image, so it may take a while.
+		 *
+		 * @param errors	[out] Integrity errors. (empty if the ROM image is intact)
+		 * @param group		[in,opt] Task group for cancellation.
+		 * @return 0 if verified; negative POSIX error code on error. (-ENOTSUP if no internal hashes)
+		 */
+		virtual int verifyIntegrity(std::vector<IntegrityError> &errors, TaskGroup *group = nullptr);
+
+		/**
+		 * Add a "Hashes" tab to the ROM fields.
+		 *
+		 * The hashes are calculated over the logical disc image
+		 * if one is available; otherwise, the file is hashed as-is.
+		 *
+		 * NOTE: This reads the entire file, so it may take a while.
+		 * RomData::fields() calls this automatically if file hashes
+		 * are enabled in the user configuration.
+		 *
+		 * @param algorithms Hash algorithms. (MultiHash::Algorithm bitfield)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int addHashFields(unsigned int algorithms);
+
+		/**
+		 * Add an "Integrity" tab to the ROM fields.
+		 * This uses verifyIntegrity() to check the internal hashes.
+		 *
+		 * NOTE: This reads the entire ROM image, so it may take a while.
+		 *
+		 * @param group [in,opt] Task group for cancellation.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int addIntegrityFields(TaskGroup *group = nullptr);
 };
 
 }
@@ -204,6 +204,22 @@ class klass : public LibRpBase::RomData { \
 		 */ \
 		int loadInternalImage(ImageType imageType, const LibRpTexture::rp_image **pImage) final;
 
+/**
+ * RomData subclass function declaration for loading internal images
+ * at a specific size. Only needed if multiple sizes are available.
+ */
+#define ROMDATA_DECL_IMGINT_SIZED() \
+	public: \
+		/** \
+		 * Load an internal image at a specific size. \
+		 * Called by RomData::image() if a size was requested. \
+		 * @param imageType	[in] Image type to load. \
+		 * @param index		[in] Image index. (ImageSizeDef::index from supportedImageSizes()) \
+		 * @param pImage	[out] Pointer to const rp_image* to store the image in. \
+		 * @return 0 on success; negative POSIX error code on error. \
+		 */ \
+		int loadInternalImageSized(ImageType imageType, int index, const LibRpTexture::rp_image **pImage) final;
+
 /**
  * RomData subclass function declaration for obtaining URLs for external images.
  */
@@ -253,6 +269,39 @@ class klass : public LibRpBase::RomData { \
 		 */ \
 		bool hasDangerousPermissions(void) const final;
 
+/**
+ * RomData subclass function declaration for hashing the logical disc image.
+ */
+#define ROMDATA_DECL_LOGICALIMAGE() \
+	public: \
+		/** \
+		 * Get the logical disc image, if this is a disc image \
+		 * stored in a sparse or compressed container. \
+		 * This is used to calculate hashes of the logical disc image. \
+		 * \
+		 * NOTE: The IDiscReader is owned by this object. \
+		 * \
+		 * @return IDiscReader, or nullptr if the file should be hashed as-is. \
+		 */ \
+		LibRpBase::IDiscReader *logicalImage(void) const final;
+
+/**
+ * RomData subclass function declaration for verifying internal hashes.
+ */
+#define ROMDATA_DECL_VERIFYINTEGRITY() \
+	public: \
+		/** \
+		 * Verify the ROM image using its internal hashes. \
+		 * \
+		 * NOTE: This reads the entire ROM image, so it may take a while. \
+		 * \
+		 * @param errors	[out] Integrity errors. (empty if the ROM image is intact) \
+		 * @param group		[in,opt] Task group for cancellation. \
+		 * @return 0 if verified; negative POSIX error code on error. (-ENOTSUP if no internal hashes) \
+		 */ \
+		int verifyIntegrity(std::vector<LibRpBase::RomData::IntegrityError> &errors, \
+			LibRpBase::TaskGroup *group = nullptr) final;
+
 /**
  * RomData subclass function declaration for closing the internal file handle.
  * Only needed if extra handling is needed, e.g. if multiple files are opened.
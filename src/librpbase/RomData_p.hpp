@@ -30,6 +30,8 @@ namespace LibRpTexture {
 
 namespace LibRpBase {
 
+class DatIndex;
+class MultiHash;
 class RomFields;
 class RomMetaData;
 
@@ -64,6 +66,8 @@ class RomDataPrivate
 		const char *className;		// Class name for user configuration. (ASCII) (default is nullptr)
 		const char *mimeType;		// MIME type. (ASCII) (default is nullptr)
 		RomData::FileType fileType;	// File type. (default is FTYPE_ROM_IMAGE)
+		bool hashesAdded;		// Set once the "Hashes" tab has been added.
+		bool integrityAdded;		// Set once the "Integrity" tab has been added.
 
 	public:
 		/** Convenience functions. **/
@@ -163,6 +167,15 @@ class RomDataPrivate
 		 * @return UNIX time, or -1 if invalid or not set.
 		 */
 		static time_t pvd_time_to_unix_time(const char pvd_time[16], int8_t tz_offset);
+
+		/**
+		 * Look up the hashed file in a DAT index.
+		 * SHA-1 is checked first if available, then CRC32 and size.
+		 * @param datIndex DAT index.
+		 * @param hash Finalized MultiHash.
+		 * @return Game name, or nullptr if not found.
+		 */
+		static const char *lookupDatIndex(const DatIndex &datIndex, const MultiHash &hash);
 };
 
 }
@@ -20,6 +20,17 @@
 #include "librpfile/FileSystem.hpp"
 using namespace LibRpFile;
 
+// C++ STL classes.
+using std::string;
+
+#ifdef HAVE_INOTIFY_INIT1
+// inotify
+# include <sys/inotify.h>
+# include <fcntl.h>
+# include <limits.h>
+# include <unistd.h>
+#endif /* HAVE_INOTIFY_INIT1 */
+
 namespace LibRpBase {
 
 /** ConfReaderPrivate **/
@@ -29,10 +40,186 @@ ConfReaderPrivate::ConfReaderPrivate(const char *filename)
 	, conf_was_found(false)
 	, conf_mtime(0)
 	, conf_last_checked(0)
+#ifdef HAVE_INOTIFY_INIT1
+	, inotify_fd(-1)
+#endif /* HAVE_INOTIFY_INIT1 */
+	, pending(nullptr)
+	, cur_is_default(true)
+	, cur_snapshot(nullptr)
+	, readers(0)
 { }
 
 ConfReaderPrivate::~ConfReaderPrivate()
-{ }
+{
+#ifdef HAVE_INOTIFY_INIT1
+	if (inotify_fd >= 0) {
+		close(inotify_fd);
+	}
+#endif /* HAVE_INOTIFY_INIT1 */
+
+	delete pending;
+	delete cur_snapshot.load();
+	for (auto iter = retired.cbegin(); iter != retired.cend(); ++iter) {
+		delete *iter;
+	}
+}
+
+/**
+ * Start watching the configuration directory for changes.
+ * If a change notifier isn't available, load() will
+ * poll the configuration file's mtime instead.
+ *
+ * NOTE: mtxLoad must be locked, and conf_filename
+ * must be set before calling this function.
+ */
+void ConfReaderPrivate::initNotifier(void)
+{
+#ifdef HAVE_INOTIFY_INIT1
+	assert(inotify_fd < 0);
+	assert(!conf_filename.empty());
+	if (inotify_fd >= 0 || conf_filename.empty())
+		return;
+
+	// Watch the directory instead of the file itself.
+	// Most editors replace the file instead of rewriting it,
+	// and the file might not exist yet.
+	const size_t slash_pos = conf_filename.rfind(DIR_SEP_CHR);
+	if (slash_pos == string::npos || slash_pos == 0)
+		return;
+	const string conf_dir = conf_filename.substr(0, slash_pos);
+
+	inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotify_fd < 0) {
+		// inotify is not available.
+		// Fall back to polling.
+		return;
+	}
+
+	int wd = inotify_add_watch(inotify_fd, conf_dir.c_str(),
+		IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE |
+		IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+	if (wd < 0) {
+		// Unable to watch the directory.
+		// It probably doesn't exist yet, so fall back to polling.
+		close(inotify_fd);
+		inotify_fd = -1;
+	}
+#endif /* HAVE_INOTIFY_INIT1 */
+}
+
+/**
+ * Check if the configuration file has changed.
+ * NOTE: mtxLoad must be locked.
+ * @return 1 if changed; 0 if not; negative POSIX error code on error.
+ */
+int ConfReaderPrivate::checkForChanges(void)
+{
+#ifdef HAVE_INOTIFY_INIT1
+	if (inotify_fd >= 0) {
+		// Read all pending events without blocking.
+		// NOTE: inotify_event is variable-length, so the buffer
+		// is declared as uint64_t[] to ensure proper alignment.
+		uint64_t buf[(sizeof(struct inotify_event) + NAME_MAX + 1) / sizeof(uint64_t) * 4];
+		bool changed = false;
+		bool lost_watch = false;
+
+		ssize_t len;
+		while ((len = read(inotify_fd, buf, sizeof(buf))) > 0) {
+			const uint8_t *p = reinterpret_cast<const uint8_t*>(buf);
+			const uint8_t *const p_end = p + len;
+			while (p < p_end) {
+				const struct inotify_event *const ev =
+					reinterpret_cast<const struct inotify_event*>(p);
+				if (ev->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+					// Events were lost, or the directory itself
+					// was removed. Assume the file has changed.
+					changed = true;
+					if (!(ev->mask & IN_Q_OVERFLOW)) {
+						lost_watch = true;
+					}
+				} else if (ev->len > 0 && !strcmp(ev->name, conf_rel_filename)) {
+					// The configuration file has changed.
+					changed = true;
+				}
+				p += sizeof(*ev) + ev->len;
+			}
+		}
+
+		if (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+			// Read error. Fall back to polling.
+			lost_watch = true;
+			changed = true;
+		}
+		if (lost_watch) {
+			// The directory is no longer being watched.
+			// Fall back to polling.
+			close(inotify_fd);
+			inotify_fd = -1;
+		}
+		return (changed ? 1 : 0);
+	}
+#endif /* HAVE_INOTIFY_INIT1 */
+
+	// Check if the configuration file's timestamp has changed.
+	time_t mtime;
+	int ret = FileSystem::get_mtime(conf_filename, &mtime);
+	if (ret != 0) {
+		// Failed to retrieve the mtime.
+		// Leave everything as-is.
+		// TODO: Proper error code?
+		return -EIO;
+	}
+
+	return (mtime != conf_mtime ? 1 : 0);
+}
+
+/**
+ * Publish a snapshot, making it the current snapshot.
+ * The ConfReaderPrivate object takes ownership of the snapshot.
+ * The previous snapshot is retired, and it will be freed
+ * once no SnapshotRef objects are active.
+ *
+ * NOTE: mtxLoad must be locked, except when called
+ * from a subclass constructor.
+ *
+ * @param snapshot Snapshot.
+ */
+void ConfReaderPrivate::publish(Snapshot *snapshot)
+{
+	assert(snapshot != nullptr);
+	const Snapshot *const old_snapshot = cur_snapshot.exchange(snapshot);
+	if (old_snapshot) {
+		retired.push_back(old_snapshot);
+	}
+	reclaim();
+}
+
+/**
+ * Free retired snapshots if no SnapshotRef objects are active.
+ * NOTE: mtxLoad must be locked.
+ */
+void ConfReaderPrivate::reclaim(void)
+{
+	if (retired.empty())
+		return;
+
+	// SnapshotRef increments readers, then loads cur_snapshot.
+	// publish() stores cur_snapshot, then this function loads
+	// readers. All four operations are seq_cst, so if readers
+	// is 0 here, any SnapshotRef created after this point will
+	// see the new snapshot, and any SnapshotRef that might have
+	// seen a retired snapshot has already been destroyed.
+	if (readers.load() != 0) {
+		// Snapshots are in use. They'll be freed by
+		// a later call to reclaim().
+		return;
+	}
+
+	for (auto iter = retired.cbegin(); iter != retired.cend(); ++iter) {
+		delete *iter;
+	}
+	retired.clear();
+}
 
 /**
  * Process a configuration line.
@@ -95,39 +282,31 @@ int ConfReader::load(bool force)
 {
 	RP_D(ConfReader);
 
-	if (!force && d->conf_was_found) {
-		// Have we checked the timestamp recently?
+	if (!force) {
+		// Have we checked for changes recently?
 		// TODO: Define the threshold somewhere.
+		// NOTE: time() is handled by the vDSO on Linux,
+		// so this path doesn't make any system calls.
+		// NOTE: This is also checked if the file wasn't found,
+		// since retrying on every call is expensive on systems
+		// without a change notifier.
 		const time_t cur_time = time(nullptr);
-		if (llabs(cur_time - d->conf_last_checked) < 2) {
+		if (llabs(cur_time - d->conf_last_checked.load(std::memory_order_relaxed)) < 2) {
 			// We checked it recently. Assume it's up to date.
-			return 0;
-		}
-		d->conf_last_checked = cur_time;
-
-		// Check if the keys.conf timestamp has changed.
-		// Initial check. (fast path)
-		time_t mtime;
-		int ret = FileSystem::get_mtime(d->conf_filename, &mtime);
-		if (ret != 0) {
-			// Failed to retrieve the mtime.
-			// Leave everything as-is.
-			// TODO: Proper error code?
-			return -EIO;
-		}
-
-		if (mtime == d->conf_mtime) {
-			// Timestamp has not changed.
-			return 0;
+			return (d->conf_was_found.load(std::memory_order_acquire) ? 0 : -EIO);
 		}
+		d->conf_last_checked.store(cur_time, std::memory_order_relaxed);
 	}
 
-	// loadKeys() mutex.
-	// NOTE: This may result in the configuration being loaded
+	// load() mutex.
+	// NOTE: This may result in the configuration being checked
 	// twice in some cases, but that's better than the configuration
 	// being loaded twice at the same time and causing collisions.
 	MutexLocker mtxLocker(d->mtxLoad);
 
+	// Free any snapshots that were retired while they were in use.
+	d->reclaim();
+
 	if (d->conf_filename.empty()) {
 		// Get the configuration filename.
 		d->conf_filename = FileSystem::getConfigDirectory();
@@ -136,27 +315,34 @@ int ConfReader::load(bool force)
 				d->conf_filename += DIR_SEP_CHR;
 			}
 			d->conf_filename += d->conf_rel_filename;
-		}
-	} else if (!force && d->conf_was_found) {
-		// Check if the keys.conf timestamp has changed.
-		// NOTE: Second check once the mutex is locked.
-		time_t mtime;
-		int ret = FileSystem::get_mtime(d->conf_filename, &mtime);
-		if (ret != 0) {
-			// Failed to retrieve the mtime.
-			// Leave everything as-is.
-			// TODO: Proper error code?
-			return -EIO;
-		}
 
-		if (mtime == d->conf_mtime) {
-			// Timestamp has not changed.
-			return 0;
+			// Watch for changes to the configuration file.
+			d->initNotifier();
+		}
+	} else if (!force) {
+#ifdef HAVE_INOTIFY_INIT1
+		if (d->conf_was_found || d->inotify_fd >= 0)
+#else /* !HAVE_INOTIFY_INIT1 */
+		if (d->conf_was_found)
+#endif /* HAVE_INOTIFY_INIT1 */
+		{
+			// Check if the configuration file has changed.
+			// NOTE: If the file wasn't found, and we're watching
+			// the directory, this prevents opening the file
+			// again until it's actually created.
+			const int ret = d->checkForChanges();
+			if (ret < 0) {
+				return ret;
+			} else if (ret == 0) {
+				// No changes.
+				return (d->conf_was_found ? 0 : -EIO);
+			}
 		}
 	}
 
-	// Reset the configuration to the default values.
-	d->reset();
+	// Create a new snapshot with the default values.
+	delete d->pending;
+	d->pending = d->createSnapshot();
 
 	// Parse the configuration file.
 	// NOTE: We're using the filename directly, since it's always
@@ -183,14 +369,23 @@ int ConfReader::load(bool force)
 #endif /* _WIN32 */
 	if (ret != 0) {
 		// Error parsing the INI file.
-		d->reset();
+		// Revert to the default values if they aren't
+		// already in use.
+		delete d->pending;
+		d->pending = nullptr;
+		if (!d->cur_is_default) {
+			d->publish(d->createSnapshot());
+			d->cur_is_default = true;
+		}
+		d->conf_last_checked.store(time(nullptr), std::memory_order_relaxed);
+		d->conf_was_found.store(false, std::memory_order_release);
 		if (ret == -2)
 			return -ENOMEM;
 		return -EIO;
 	}
 
-	// Save the mtime from the keys.conf file.
-	// TODO: Combine with earlier check?
+	// Save the mtime from the configuration file.
+	// This is only needed if we're polling for changes.
 	time_t mtime;
 	ret = FileSystem::get_mtime(d->conf_filename, &mtime);
 	if (ret == 0) {
@@ -201,8 +396,13 @@ int ConfReader::load(bool force)
 		d->conf_mtime = 0;
 	}
 
-	// Keys loaded.
-	d->conf_was_found = true;
+	// Configuration loaded.
+	// Publish the new snapshot.
+	d->publish(d->pending);
+	d->pending = nullptr;
+	d->cur_is_default = false;
+	d->conf_last_checked.store(time(nullptr), std::memory_order_relaxed);
+	d->conf_was_found.store(true, std::memory_order_release);
 	return 0;
 }
 
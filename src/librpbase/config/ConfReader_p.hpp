@@ -19,7 +19,9 @@
 #include "ini.h"
 
 // C++ includes.
+#include <atomic>
 #include <string>
+#include <vector>
 
 namespace LibRpBase {
 
@@ -46,16 +48,135 @@ class ConfReaderPrivate
 		std::string conf_filename;		// alloc()'d in load()
 
 		// rom-properties.conf status.
-		bool conf_was_found;
+		// NOTE: conf_was_found and conf_last_checked are
+		// checked by load() without locking mtxLoad.
+		std::atomic<bool> conf_was_found;
 		time_t conf_mtime;
-		time_t conf_last_checked;
+		std::atomic<time_t> conf_last_checked;
+
+#ifdef HAVE_INOTIFY_INIT1
+		// inotify descriptor for the configuration directory.
+		// If -1, the mtime is polled instead.
+		int inotify_fd;
+#endif /* HAVE_INOTIFY_INIT1 */
+
+	public:
+		/**
+		 * Start watching the configuration directory for changes.
+		 * If a change notifier isn't available, load() will
+		 * poll the configuration file's mtime instead.
+		 *
+		 * NOTE: mtxLoad must be locked, and conf_filename
+		 * must be set before calling this function.
+		 */
+		void initNotifier(void);
+
+		/**
+		 * Check if the configuration file has changed.
+		 * NOTE: mtxLoad must be locked.
+		 * @return 1 if changed; 0 if not; negative POSIX error code on error.
+		 */
+		int checkForChanges(void);
 
 	public:
 		/**
-		 * Reset the configuration to the default values.
+		 * Configuration snapshot.
+		 *
+		 * Subclasses store all of their parsed configuration
+		 * data in a subclass of Snapshot. Once published,
+		 * a snapshot is never modified, so readers can use
+		 * it without locking.
+		 */
+		struct Snapshot {
+			virtual ~Snapshot() { }
+		};
+
+		/**
+		 * Create a new snapshot with the default values.
+		 * @return Snapshot.
 		 */
-		virtual void reset(void) = 0;
+		virtual Snapshot *createSnapshot(void) const = 0;
 
+		/**
+		 * Publish a snapshot, making it the current snapshot.
+		 * The ConfReaderPrivate object takes ownership of the snapshot.
+		 * The previous snapshot is retired, and it will be freed
+		 * once no SnapshotRef objects are active.
+		 *
+		 * NOTE: mtxLoad must be locked, except when called
+		 * from a subclass constructor.
+		 *
+		 * @param snapshot Snapshot.
+		 */
+		void publish(Snapshot *snapshot);
+
+		/**
+		 * Free retired snapshots if no SnapshotRef objects are active.
+		 * NOTE: mtxLoad must be locked.
+		 */
+		void reclaim(void);
+
+		/**
+		 * Reference to the current snapshot.
+		 *
+		 * Retired snapshots aren't freed while any SnapshotRef
+		 * is active, so the snapshot can be used without locking.
+		 * Creating a SnapshotRef is two atomic operations, and
+		 * it never blocks.
+		 *
+		 * NOTE: Pointers into the snapshot must not be used
+		 * after the SnapshotRef is destroyed.
+		 */
+		template<typename T>
+		class SnapshotRef
+		{
+			public:
+				explicit SnapshotRef(const ConfReaderPrivate *d)
+					: d(d)
+				{
+					// NOTE: Both of these operations must be seq_cst.
+					// See ConfReaderPrivate::reclaim().
+					d->readers.fetch_add(1);
+					p = static_cast<const T*>(d->cur_snapshot.load());
+				}
+
+				~SnapshotRef()
+				{
+					d->readers.fetch_sub(1);
+				}
+
+			private:
+				RP_DISABLE_COPY(SnapshotRef)
+
+			public:
+				inline const T *get(void) const { return p; }
+				inline const T *operator->(void) const { return p; }
+
+			private:
+				const ConfReaderPrivate *const d;
+				const T *p;
+		};
+
+		// Snapshot being filled in by processConfigLine().
+		// Only valid while load() is parsing the file.
+		Snapshot *pending;
+
+		// True if the current snapshot has the default values,
+		// i.e. it wasn't loaded from the configuration file.
+		bool cur_is_default;
+
+	private:
+		// Current snapshot.
+		std::atomic<const Snapshot*> cur_snapshot;
+
+		// Number of active SnapshotRef objects.
+		mutable std::atomic<int> readers;
+
+		// Retired snapshots that haven't been freed yet.
+		// NOTE: mtxLoad must be locked to access this.
+		std::vector<const Snapshot*> retired;
+
+	public:
 		/**
 		 * Process a configuration line.
 		 * Static function; used by inih as a C-style callback function.
@@ -72,6 +193,7 @@ class ConfReaderPrivate
 		/**
 		 * Process a configuration line.
 		 * Virtual function; must be reimplemented by subclasses.
+		 * Parsed values must be stored in the pending snapshot.
 		 *
 		 * @param section Section.
 		 * @param name Key.
@@ -12,6 +12,9 @@
 #include "Config.hpp"
 #include "ConfReader_p.hpp"
 
+// librpthreads
+#include "librpthreads/pthread_once.h"
+
 // C++ STL classes.
 using std::string;
 using std::unique_ptr;
@@ -32,16 +35,63 @@ class ConfigPrivate : public ConfReaderPrivate
 
 	public:
 		// Static Config instance.
-		// TODO: Q_GLOBAL_STATIC() equivalent, though we
-		// may need special initialization if the compiler
-		// doesn't support thread-safe statics.
-		static Config instance;
+		// This is created on first use instead of when the
+		// library is loaded, since the constructor allocates
+		// the default snapshot. (Not all compilers support
+		// thread-safe statics, so pthread_once() is used.)
+		static pthread_once_t once_instance;
+		static unique_ptr<Config> instance;
+
+		/**
+		 * Create the Config instance.
+		 * Called by pthread_once().
+		 */
+		static void initInstance(void);
 
 	public:
 		/**
-		 * Reset the configuration to the default values.
+		 * Configuration snapshot.
 		 */
-		void reset(void) final;
+		struct Snapshot : public super::Snapshot {
+			Snapshot();
+
+			// Image type priority data.
+			// Managed as a single block in order to reduce
+			// memory allocations.
+			ao::uvector<uint8_t> vImgTypePrio;
+
+			/**
+			 * Map of RomData subclass names to vImgTypePrio indexes.
+			 * - Key: RomData subclass name.
+			 * - Value: vImgTypePrio information.
+			 *   - High byte: Data length.
+			 *   - Low 3 bytes: Data offset.
+			 */
+			unordered_map<string, uint32_t> mapImgTypePrio;
+
+			// Download options.
+			bool extImgDownloadEnabled;
+			bool useIntIconForSmallSizes;
+			bool downloadHighResScans;
+			bool storeFileOriginInfo;
+
+			// DMG title screen mode. [index is ROM type]
+			Config::DMG_TitleScreen_Mode dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_MAX];
+
+			// Other options.
+			bool showDangerousPermissionsOverlayIcon;
+			bool enableThumbnailOnNetworkFS;
+			bool showFileHashes;
+		};
+
+		/**
+		 * Create a new snapshot with the default values.
+		 * @return Snapshot.
+		 */
+		super::Snapshot *createSnapshot(void) const final;
+
+		// Reference to the current snapshot.
+		typedef super::SnapshotRef<Snapshot> CurrentSnapshot;
 
 		/**
 		 * Process a configuration line.
@@ -62,41 +112,15 @@ class ConfigPrivate : public ConfReaderPrivate
 		 * for a given system.
 		 */
 		static const uint8_t defImgTypePrio[];
-
-		// Image type priority data.
-		// Managed as a single block in order to reduce
-		// memory allocations.
-		ao::uvector<uint8_t> vImgTypePrio;
-
-		/**
-		 * Map of RomData subclass names to vImgTypePrio indexes.
-		 * - Key: RomData subclass name.
-		 * - Value: vImgTypePrio information.
-		 *   - High byte: Data length.
-		 *   - Low 3 bytes: Data offset.
-		 */
-		unordered_map<string, uint32_t> mapImgTypePrio;
-
-		// Download options.
-		bool extImgDownloadEnabled;
-		bool useIntIconForSmallSizes;
-		bool downloadHighResScans;
-		bool storeFileOriginInfo;
-
-		// DMG title screen mode. [index is ROM type]
-		Config::DMG_TitleScreen_Mode dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_MAX];
-
-		// Other options.
-		bool showDangerousPermissionsOverlayIcon;
-		bool enableThumbnailOnNetworkFS;
 };
 
 /** ConfigPrivate **/
 
 // Singleton instance.
-// Using a static non-pointer variable in order to
-// handle proper destruction when the DLL is unloaded.
-Config ConfigPrivate::instance;
+// Using a static unique_ptr in order to handle
+// proper destruction when the DLL is unloaded.
+pthread_once_t ConfigPrivate::once_instance = PTHREAD_ONCE_INIT;
+unique_ptr<Config> ConfigPrivate::instance;
 
 /**
  * Default image type priority.
@@ -116,10 +140,26 @@ const uint8_t ConfigPrivate::defImgTypePrio[] = {
 	RomData::IMG_INT_BANNER,
 };
 
+/**
+ * Create the Config instance.
+ * Called by pthread_once().
+ */
+void ConfigPrivate::initInstance(void)
+{
+	instance.reset(new Config());
+}
+
 ConfigPrivate::ConfigPrivate()
 	: super("rom-properties.conf")
+{
+	// Publish the default configuration.
+	// This will be replaced once the configuration is loaded.
+	publish(createSnapshot());
+}
+
+ConfigPrivate::Snapshot::Snapshot()
 	/* Download options */
-	, extImgDownloadEnabled(true)
+	: extImgDownloadEnabled(true)
 	, useIntIconForSmallSizes(true)
 	, downloadHighResScans(true)
 	, storeFileOriginInfo(true)
@@ -127,42 +167,31 @@ ConfigPrivate::ConfigPrivate()
 	, showDangerousPermissionsOverlayIcon(true)
 	/* Enable thumbnailing and metadata on network FS */
 	, enableThumbnailOnNetworkFS(false)
+	/* Show file hashes (slow!) */
+	, showFileHashes(false)
 {
-	// NOTE: Configuration is also initialized in the reset() function.
-	memset(dmgTSMode, 0, sizeof(dmgTSMode));
+	// DMG title screen mode.
+	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_DMG] = Config::DMG_TitleScreen_Mode::DMG_TS_DMG;
+	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_SGB] = Config::DMG_TitleScreen_Mode::DMG_TS_SGB;
+	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_CGB] = Config::DMG_TitleScreen_Mode::DMG_TS_CGB;
 }
 
 /**
- * Reset the configuration to the default values.
+ * Create a new snapshot with the default values.
+ * @return Snapshot.
  */
-void ConfigPrivate::reset(void)
+ConfReaderPrivate::Snapshot *ConfigPrivate::createSnapshot(void) const
 {
-	// Clear the image type priorities vector and map.
-	vImgTypePrio.clear();
-	mapImgTypePrio.clear();
+	Snapshot *const snapshot = new Snapshot();
 
 	// Reserve 1 KB for the image type priorities store.
-	vImgTypePrio.reserve(1024);
+	snapshot->vImgTypePrio.reserve(1024);
 #ifdef HAVE_UNORDERED_MAP_RESERVE
 	// Reserve 16 entries for the map.
-	mapImgTypePrio.reserve(16);
+	snapshot->mapImgTypePrio.reserve(16);
 #endif
 
-	// Download options
-	extImgDownloadEnabled = true;
-	useIntIconForSmallSizes = true;
-	downloadHighResScans = true;
-	storeFileOriginInfo = true;
-
-	// DMG title screen mode.
-	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_DMG] = Config::DMG_TitleScreen_Mode::DMG_TS_DMG;
-	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_SGB] = Config::DMG_TitleScreen_Mode::DMG_TS_SGB;
-	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_CGB] = Config::DMG_TitleScreen_Mode::DMG_TS_CGB;
-
-	// Overlay icon
-	showDangerousPermissionsOverlayIcon = true;
-	// Enable thumbnail and metadata on network FS
-	enableThumbnailOnNetworkFS = false;
+	return snapshot;
 }
 
 /**
@@ -187,18 +216,20 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 		return 1;
 	}
 
+	Snapshot *const snapshot = static_cast<Snapshot*>(pending);
+
 	// Which section are we in?
 	if (!strcasecmp(section, "Downloads")) {
 		// Downloads. Check for one of the three boolean options.
 		bool *param;
 		if (!strcasecmp(name, "ExtImageDownload")) {
-			param = &extImgDownloadEnabled;
+			param = &snapshot->extImgDownloadEnabled;
 		} else if (!strcasecmp(name, "UseIntIconForSmallSizes")) {
-			param = &useIntIconForSmallSizes;
+			param = &snapshot->useIntIconForSmallSizes;
 		} else if (!strcasecmp(name, "DownloadHighResScans")) {
-			param = &downloadHighResScans;
+			param = &snapshot->downloadHighResScans;
 		} else if (!strcasecmp(name, "StoreFileOriginInfo")) {
-			param = &storeFileOriginInfo;
+			param = &snapshot->storeFileOriginInfo;
 		} else {
 			// Invalid option.
 			return 1;
@@ -241,14 +272,16 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 			return 1;
 		}
 
-		dmgTSMode[dmg_key] = dmg_value;
+		snapshot->dmgTSMode[dmg_key] = dmg_value;
 	} else if (!strcasecmp(section, "Options")) {
 		// Options.
 		bool *param;
 		if (!strcasecmp(name, "ShowDangerousPermissionsOverlayIcon")) {
-			param = &showDangerousPermissionsOverlayIcon;
+			param = &snapshot->showDangerousPermissionsOverlayIcon;
 		} else if (!strcasecmp(name, "EnableThumbnailOnNetworkFS")) {
-			param = &enableThumbnailOnNetworkFS;
+			param = &snapshot->enableThumbnailOnNetworkFS;
+		} else if (!strcasecmp(name, "ShowFileHashes")) {
+			param = &snapshot->showFileHashes;
 		} else {
 			// Invalid option.
 			return 1;
@@ -280,7 +313,7 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 		}
 
 		// Parse the comma-separated values.
-		const size_t vStartPos = vImgTypePrio.size();
+		const size_t vStartPos = snapshot->vImgTypePrio.size();
 		unsigned int count = 0;	// Number of image types.
 		uint32_t imgbf = 0;	// Image type bitfield to prevent duplicates.
 		while (*pos) {
@@ -300,7 +333,7 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 			// for this system are disabled.
 			if (count == 0 && len == 2 && !strncasecmp(pos, "no", 2)) {
 				// Thumbnails are disabled.
-				vImgTypePrio.push_back((uint8_t)RomData::IMG_DISABLED);
+				snapshot->vImgTypePrio.push_back((uint8_t)RomData::IMG_DISABLED);
 				count = 1;
 				break;
 			}
@@ -386,7 +419,7 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 				// Too many image types...
 				break;
 			}
-			vImgTypePrio.push_back(static_cast<uint8_t>(imgType));
+			snapshot->vImgTypePrio.push_back(static_cast<uint8_t>(imgType));
 			count++;
 
 			if (!comma)
@@ -404,7 +437,7 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 			// Add the class name information to the map.
 			uint32_t keyIdx = static_cast<uint32_t>(vStartPos);
 			keyIdx |= (count << 24);
-			mapImgTypePrio.insert(std::make_pair(className, keyIdx));
+			snapshot->mapImgTypePrio.insert(std::make_pair(className, keyIdx));
 		}
 	}
 
@@ -429,11 +462,12 @@ Config::Config()
 Config *Config::instance(void)
 {
 	// Initialize the singleton instance.
-	Config *const q = &ConfigPrivate::instance;
+	pthread_once(&ConfigPrivate::once_instance, ConfigPrivate::initInstance);
+	Config *const q = ConfigPrivate::instance.get();
 	// Load the configuration if necessary.
 	q->load(false);
 	// Return the singleton instance.
-	return &ConfigPrivate::instance;
+	return q;
 }
 
 /** Image types **/
@@ -455,14 +489,14 @@ Config::ImgTypeResult Config::getImgTypePrio(const char *className, ImgTypePrio_
 
 	// Find the class name in the map.
 	RP_D(const Config);
+	const ConfigPrivate::CurrentSnapshot snapshot(d);
 	string className_lower(className);
 	std::transform(className_lower.begin(), className_lower.end(), className_lower.begin(), ::tolower);
-	auto iter = d->mapImgTypePrio.find(className_lower);
-	if (iter == d->mapImgTypePrio.end()) {
+	auto iter = snapshot->mapImgTypePrio.find(className_lower);
+	if (iter == snapshot->mapImgTypePrio.end()) {
 		// Class name not found.
 		// Use the global defaults.
-		imgTypePrio->imgTypes = d->defImgTypePrio;
-		imgTypePrio->length = ARRAY_SIZE(d->defImgTypePrio);
+		getDefImgTypePrio(imgTypePrio);
 		return IMGTR_SUCCESS_DEFAULTS;
 	}
 
@@ -472,22 +506,25 @@ Config::ImgTypeResult Config::getImgTypePrio(const char *className, ImgTypePrio_
 	const uint32_t idx = (keyIdx & 0xFFFFFF);
 	const uint8_t len = ((keyIdx >> 24) & 0xFF);
 	assert(len > 0);
-	assert(idx < d->vImgTypePrio.size());
-	assert(idx + len <= d->vImgTypePrio.size());
-	if (len == 0 || idx >= d->vImgTypePrio.size() || idx + len > d->vImgTypePrio.size()) {
+	assert(len <= sizeof(imgTypePrio->imgTypes));
+	assert(idx < snapshot->vImgTypePrio.size());
+	assert(idx + len <= snapshot->vImgTypePrio.size());
+	if (len == 0 || len > sizeof(imgTypePrio->imgTypes) ||
+	    idx >= snapshot->vImgTypePrio.size() || idx + len > snapshot->vImgTypePrio.size())
+	{
 		// Entry is invalid...
 		// TODO: Force a configuration reload?
 		return IMGTR_ERR_MAP_CORRUPTED;
 	}
 
 	// Is the first entry RomData::IMG_DISABLED?
-	if (d->vImgTypePrio[idx] == static_cast<uint8_t>(RomData::IMG_DISABLED)) {
+	if (snapshot->vImgTypePrio[idx] == static_cast<uint8_t>(RomData::IMG_DISABLED)) {
 		// Thumbnails are disabled for this class.
 		return IMGTR_DISABLED;
 	}
 
-	// Return the starting address and length.
-	imgTypePrio->imgTypes = &d->vImgTypePrio[idx];
+	// Copy the image types.
+	memcpy(imgTypePrio->imgTypes, &snapshot->vImgTypePrio[idx], len);
 	imgTypePrio->length = len;
 	return IMGTR_SUCCESS;
 }
@@ -503,7 +540,9 @@ void Config::getDefImgTypePrio(ImgTypePrio_t *imgTypePrio) const
 	assert(imgTypePrio != nullptr);
 	if (imgTypePrio) {
 		RP_D(const Config);
-		imgTypePrio->imgTypes = d->defImgTypePrio;
+		static_assert(sizeof(ConfigPrivate::defImgTypePrio) <= sizeof(imgTypePrio->imgTypes),
+			"defImgTypePrio[] is too big for ImgTypePrio_t.");
+		memcpy(imgTypePrio->imgTypes, d->defImgTypePrio, sizeof(d->defImgTypePrio));
 		imgTypePrio->length = ARRAY_SIZE(d->defImgTypePrio);
 	}
 }
@@ -518,7 +557,8 @@ void Config::getDefImgTypePrio(ImgTypePrio_t *imgTypePrio) const
 bool Config::extImgDownloadEnabled(void) const
 {
 	RP_D(const Config);
-	return d->extImgDownloadEnabled;
+	const ConfigPrivate::CurrentSnapshot snapshot(d);
+	return snapshot->extImgDownloadEnabled;
 }
 
 /**
@@ -530,7 +570,8 @@ bool Config::extImgDownloadEnabled(void) const
 bool Config::useIntIconForSmallSizes(void) const
 {
 	RP_D(const Config);
-	return d->useIntIconForSmallSizes;
+	const ConfigPrivate::CurrentSnapshot snapshot(d);
+	return snapshot->useIntIconForSmallSizes;
 }
 
 /**
@@ -541,7 +582,8 @@ bool Config::useIntIconForSmallSizes(void) const
 bool Config::downloadHighResScans(void) const
 {
 	RP_D(const Config);
-	return d->downloadHighResScans;
+	const ConfigPrivate::CurrentSnapshot snapshot(d);
+	return snapshot->downloadHighResScans;
 }
 
 /**
@@ -552,7 +594,8 @@ bool Config::downloadHighResScans(void) const
 bool Config::storeFileOriginInfo(void) const
 {
 	RP_D(const Config);
-	return d->storeFileOriginInfo;
+	const ConfigPrivate::CurrentSnapshot snapshot(d);
+	return snapshot->storeFileOriginInfo;
 }
 
 /** DMG title screen mode **/
@@ -574,7 +617,8 @@ Config::DMG_TitleScreen_Mode Config::dmgTitleScreenMode(DMG_TitleScreen_Mode rom
 	}
 
 	RP_D(const Config);
-	return d->dmgTSMode[romType];
+	const ConfigPrivate::CurrentSnapshot snapshot(d);
+	return snapshot->dmgTSMode[romType];
 }
 
 /** Other options **/
@@ -587,7 +631,8 @@ Config::DMG_TitleScreen_Mode Config::dmgTitleScreenMode(DMG_TitleScreen_Mode rom
 bool Config::showDangerousPermissionsOverlayIcon(void) const
 {
 	RP_D(const Config);
-	return d->showDangerousPermissionsOverlayIcon;
+	const ConfigPrivate::CurrentSnapshot snapshot(d);
+	return snapshot->showDangerousPermissionsOverlayIcon;
 }
 
 /**
@@ -598,7 +643,21 @@ bool Config::showDangerousPermissionsOverlayIcon(void) const
 bool Config::enableThumbnailOnNetworkFS(void) const
 {
 	RP_D(const Config);
-	return d->enableThumbnailOnNetworkFS;
+	const ConfigPrivate::CurrentSnapshot snapshot(d);
+	return snapshot->enableThumbnailOnNetworkFS;
+}
+
+/**
+ * Show a tab with file hashes (CRC32, MD5, SHA-1, SHA-256)?
+ * NOTE: This reads the entire file, so it's disabled by default.
+ * NOTE: Call load() before using this function.
+ * @return True if we should show file hashes; false if not.
+ */
+bool Config::showFileHashes(void) const
+{
+	RP_D(const Config);
+	const ConfigPrivate::CurrentSnapshot snapshot(d);
+	return snapshot->showFileHashes;
 }
 
 }
@@ -49,9 +49,11 @@ class Config : public ConfReader
 		/** Image types **/
 
 		// Image type priority data.
+		// NOTE: The image types are copied, since the
+		// configuration may be reloaded at any time.
 		struct ImgTypePrio_t {
-			const uint8_t *imgTypes;	// Image types.
-			uint32_t length;		// Length of imgTypes array.
+			uint8_t imgTypes[32];		// Image types.
+			uint32_t length;		// Number of image types.
 		};
 
 		// TODO: Function to get image type priority for a specified class.
@@ -147,6 +149,14 @@ class Config : public ConfReader
 		 * @return True if we should enable; false if not.
 		 */
 		bool enableThumbnailOnNetworkFS(void) const;
+
+		/**
+		 * Show a tab with file hashes (CRC32, MD5, SHA-1, SHA-256)?
+		 * NOTE: This reads the entire file, so it's disabled by default.
+		 * NOTE: Call load() before using this function.
+		 * @return True if we should show file hashes; false if not.
+		 */
+		bool showFileHashes(void) const;
 };
 
 }
@@ -8,6 +8,7 @@
 
 #include "stdafx.h"
 #include "AesCAPI.hpp"
+#include "librpthreads/Profiler.hpp"
 
 // libwin32common
 #include "libwin32common/RpWin32_sdk.h"
@@ -313,6 +314,7 @@ int AesCAPI::setIV(const uint8_t *RESTRICT pIV, size_t size)
  */
 size_t AesCAPI::decrypt(uint8_t *RESTRICT pData, size_t size)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_DECRYPT, size);
 	RP_D(AesCAPI);
 	if (d->hKey == 0) {
 		// Key hasn't been set.
@@ -8,6 +8,7 @@
 
 #include "stdafx.h"
 #include "AesCAPI_NG.hpp"
+#include "librpthreads/Profiler.hpp"
 
 // libwin32common
 #include "libwin32common/RpWin32_sdk.h"
@@ -472,6 +473,7 @@ int AesCAPI_NG::setIV(const uint8_t *RESTRICT pIV, size_t size)
  */
 size_t AesCAPI_NG::decrypt(uint8_t *RESTRICT pData, size_t size)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_DECRYPT, size);
 	RP_D(AesCAPI_NG);
 	if (!d->hBcryptDll || !d->hAesAlg || !d->hKey) {
 		// Algorithm is not available,
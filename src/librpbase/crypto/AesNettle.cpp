@@ -10,6 +10,7 @@
 #include "config.librpbase.h"
 
 #include "AesNettle.hpp"
+#include "librpthreads/Profiler.hpp"
 
 // Nettle AES functions.
 #include <nettle/nettle-types.h>
@@ -228,6 +229,7 @@ size_t AesNettle::decrypt(uint8_t *RESTRICT pData, size_t size)
 	}
 
 	// Decrypt the data.
+	RP_PROFILE_SCOPE_BYTES(STAGE_DECRYPT, size);
 	RP_D(AesNettle);
 
 #ifdef HAVE_NETTLE_3
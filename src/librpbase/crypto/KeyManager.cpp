@@ -13,10 +13,19 @@
 #include "config/ConfReader_p.hpp"
 #include "libi18n/i18n.h"
 
+// librpthreads
+#include "librpthreads/pthread_once.h"
+
+// C++ includes.
+#include <list>
+#include <unordered_set>
+
 // C++ STL classes.
+using std::list;
 using std::string;
 using std::unique_ptr;
 using std::unordered_map;
+using std::unordered_set;
 
 #include "IAesCipher.hpp"
 #include "AesCipherFactory.hpp"
@@ -35,17 +44,127 @@ class KeyManagerPrivate : public ConfReaderPrivate
 #ifdef ENABLE_DECRYPTION
 	public:
 		// Static KeyManager instance.
-		// TODO: Q_GLOBAL_STATIC() equivalent, though we
-		// may need special initialization if the compiler
-		// doesn't support thread-safe statics.
-		static KeyManager instance;
+		// This is created on first use instead of when the
+		// library is loaded. (Not all compilers support
+		// thread-safe statics, so pthread_once() is used.)
+		static pthread_once_t once_instance;
+		static unique_ptr<KeyManager> instance;
+
+		/**
+		 * Create the KeyManager instance.
+		 * Called by pthread_once().
+		 */
+		static void initInstance(void);
 #endif /* ENABLE_DECRYPTION */
 
 	public:
 		/**
-		 * Reset the configuration to the default values.
+		 * Key store snapshot.
 		 */
-		void reset(void) final;
+		struct Snapshot : public super::Snapshot {
+#ifdef ENABLE_DECRYPTION
+			/**
+			 * Map of key names to key data.
+			 * - Key: Key name.
+			 * - Value: Key data. (in keyPool)
+			 */
+			unordered_map<string, const string*> mapKeyNames;
+
+			/**
+			 * Map of invalid key names to errors.
+			 * These are stored for better error reporting.
+			 * - Key: Key name.
+			 * - Value: Verification result.
+			 */
+			unordered_map<string, uint8_t> mapInvalidKeyNames;
+
+			/** Caches **/
+			// NOTE: The caches are the only part of the snapshot
+			// that's modified after it's published, so they're
+			// protected by mtxCache. Reloading keys.conf publishes
+			// a new snapshot, which invalidates the caches.
+			mutable Mutex mtxCache;
+
+			/**
+			 * Verified key cache entry.
+			 * Stores the result of verifying a key
+			 * against a specific verification block.
+			 */
+			struct VerifiedKey {
+				uint8_t verifyData[16];
+				uint8_t result;		// VerifyResult
+			};
+
+			/**
+			 * Verified key cache.
+			 * - Key: Key name.
+			 * - Value: Verification result.
+			 */
+			mutable unordered_map<string, VerifiedKey> mapVerifiedKeys;
+
+			/**
+			 * Derived key cache entry.
+			 * - id: Derived key type, followed by the input data.
+			 * - key: Derived key.
+			 */
+			struct DerivedKey {
+				string id;
+				uint8_t key[16];
+			};
+
+			// Maximum number of derived keys to cache.
+			static const size_t DERIVED_KEY_CACHE_MAX = 256;
+
+			// Derived key cache, in LRU order. (front == most recent)
+			// mapDerivedKeys has iterators into lstDerivedKeys.
+			mutable list<DerivedKey> lstDerivedKeys;
+			mutable unordered_map<string, list<DerivedKey>::iterator> mapDerivedKeys;
+
+			/**
+			 * Build a derived key cache ID.
+			 * @param type		[in] Derived key type.
+			 * @param pInput	[in] Input data used to derive the key.
+			 * @param inputLen	[in] Length of pInput.
+			 * @return Derived key cache ID.
+			 */
+			static string derivedKeyId(KeyManager::DerivedKeyType type,
+				const uint8_t *pInput, unsigned int inputLen)
+			{
+				string id;
+				id.reserve(1 + inputLen);
+				id += static_cast<char>(type);
+				id.append(reinterpret_cast<const char*>(pInput), inputLen);
+				return id;
+			}
+#endif /* ENABLE_DECRYPTION */
+		};
+
+		/**
+		 * Create a new snapshot with the default values.
+		 * @return Snapshot.
+		 */
+		super::Snapshot *createSnapshot(void) const final;
+
+		// Reference to the current snapshot.
+		typedef super::SnapshotRef<Snapshot> CurrentSnapshot;
+
+#ifdef ENABLE_DECRYPTION
+		/**
+		 * Key data pool.
+		 *
+		 * KeyManager::get() returns pointers to key data, which
+		 * must remain valid after the snapshot is freed, so the
+		 * key data is stored here instead. Identical keys are
+		 * only stored once, so this only grows if keys.conf
+		 * gets new key values.
+		 *
+		 * NOTE: mtxLoad must be locked to modify this.
+		 * Elements are never removed, and unordered_set
+		 * doesn't move its elements, so the key data
+		 * can be read without locking.
+		 */
+		unordered_set<string> keyPool;
+#endif /* ENABLE_DECRYPTION */
 
 		/**
 		 * Process a configuration line.
@@ -59,29 +178,28 @@ class KeyManagerPrivate : public ConfReaderPrivate
 		int processConfigLine(const char *section,
 			const char *name, const char *value) final;
 
-	public:
 #ifdef ENABLE_DECRYPTION
-		// Encryption key data.
-		// Managed as a single block in order to reduce
-		// memory allocations.
-		ao::uvector<uint8_t> vKeys;
-
+	public:
 		/**
-		 * Map of key names to vKeys indexes.
-		 * - Key: Key name.
-		 * - Value: vKeys information.
-		 *   - High byte: Key length.
-		 *   - Low 3 bytes: Key index.
+		 * Verify a key by decrypting a verification block.
+		 * The result must be "AES-128-ECB-TEST".
+		 * @param pKey		[in] Key data.
+		 * @param keyLen	[in] Key length. (16, 24, or 32)
+		 * @param pVerifyData	[in] Verification data block. (16 bytes)
+		 * @return VerifyResult.
 		 */
-		unordered_map<string, uint32_t> mapKeyNames;
+		static KeyManager::VerifyResult verifyKey(const uint8_t *pKey, unsigned int keyLen,
+			const uint8_t *pVerifyData);
 
 		/**
-		 * Map of invalid key names to errors.
-		 * These are stored for better error reporting.
-		 * - Key: Key name.
-		 * - Value: Verification result.
+		 * Get an encryption key from a snapshot.
+		 * @param snapshot	[in] Snapshot.
+		 * @param keyName	[in] Encryption key name.
+		 * @param pKeyData	[out,opt] Key data struct.
+		 * @return VerifyResult.
 		 */
-		unordered_map<string, uint8_t> mapInvalidKeyNames;
+		static KeyManager::VerifyResult getKey(const Snapshot *snapshot,
+			const char *keyName, KeyManager::KeyData_t *pKeyData);
 #endif /* ENABLE_DECRYPTION */
 };
 
@@ -89,9 +207,19 @@ class KeyManagerPrivate : public ConfReaderPrivate
 
 #ifdef ENABLE_DECRYPTION
 // Singleton instance.
-// Using a static non-pointer variable in order to
-// handle proper destruction when the DLL is unloaded.
-KeyManager KeyManagerPrivate::instance;
+// Using a static unique_ptr in order to handle
+// proper destruction when the DLL is unloaded.
+pthread_once_t KeyManagerPrivate::once_instance = PTHREAD_ONCE_INIT;
+unique_ptr<KeyManager> KeyManagerPrivate::instance;
+
+/**
+ * Create the KeyManager instance.
+ * Called by pthread_once().
+ */
+void KeyManagerPrivate::initInstance(void)
+{
+	instance.reset(new KeyManager());
+}
 
 // Verification test string.
 // NOTE: This string is NOT NULL-terminated!
@@ -103,29 +231,27 @@ const char KeyManager::verifyTestString[] = {
 
 KeyManagerPrivate::KeyManagerPrivate()
 	: super("keys.conf")
-{ }
+{
+	// Publish an empty key store.
+	// This will be replaced once keys.conf is loaded.
+	publish(createSnapshot());
+}
 
 /**
- * Reset the configuration to the default values.
+ * Create a new snapshot with the default values.
+ * @return Snapshot.
  */
-void KeyManagerPrivate::reset(void)
+ConfReaderPrivate::Snapshot *KeyManagerPrivate::createSnapshot(void) const
 {
+	Snapshot *const snapshot = new Snapshot();
 #ifdef ENABLE_DECRYPTION
-	// Clear the loaded keys.
-	vKeys.clear();
-	mapKeyNames.clear();
-	mapInvalidKeyNames.clear();
-
-	// Reserve 1 KB for the key store.
-	vKeys.reserve(1024);
 #ifdef HAVE_UNORDERED_MAP_RESERVE
 	// Reserve entries for the key names map.
 	// NOTE: Not reserving entries for invalid key names.
-	mapKeyNames.reserve(64);
+	snapshot->mapKeyNames.reserve(64);
 #endif
-#else /* !ENABLE_DECRYPTION */
-	assert(!"Should not be called in no-decryption builds.");
 #endif /* ENABLE_DECRYPTION */
+	return snapshot;
 }
 
 /**
@@ -161,6 +287,8 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 		return 1;
 	}
 
+	Snapshot *const snapshot = static_cast<Snapshot*>(pending);
+
 	// Check the value length.
 	// TODO: Check for <= 0?
 	const size_t value_len = strlen(value);
@@ -170,18 +298,14 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 	}
 
 	const bool is_odd_len = ((value_len % 2) != 0);
-	uint8_t len = static_cast<uint8_t>(value_len / 2);
+	unsigned int len = static_cast<unsigned int>(value_len / 2);
 
 	// Parse the value.
-	const uint32_t vKeys_start_pos = static_cast<uint32_t>(vKeys.size());
-	uint32_t vKeys_pos = vKeys_start_pos;
-	// Reserve space for half of the key string.
 	// Key string is ASCII hex, so two characters make up one byte.
-	vKeys.resize(vKeys.size() + len);
-	int ret = KeyManager::hexStringToBytes(value, &vKeys[vKeys_pos], len);
+	uint8_t keyBuf[128];
+	int ret = KeyManager::hexStringToBytes(value, keyBuf, len);
 	if (ret != 0) {
 		// Invalid character(s) encountered.
-		vKeys.resize(vKeys_start_pos);
 		return 1;
 	}
 	if (is_odd_len) {
@@ -190,11 +314,9 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 		char buf[2];
 		buf[0] = value[value_len-1];
 		buf[1] = '0';
-		vKeys.resize(vKeys.size() + 2);
-		ret = KeyManager::hexStringToBytes(buf, &vKeys[vKeys_pos+len], 1);
+		ret = KeyManager::hexStringToBytes(buf, &keyBuf[len], 1);
 		if (ret != 0) {
 			// Invalid character(s) encountered.
-			vKeys.resize(vKeys_start_pos);
 			return 1;
 		}
 		// Add the extra byte.
@@ -202,9 +324,9 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 	}
 
 	// Value parsed successfully.
-	uint32_t keyIdx = vKeys_start_pos;
-	keyIdx |= (len << 24);
-	mapKeyNames.insert(std::make_pair(string(name), keyIdx));
+	// Add it to the key data pool.
+	auto iter = keyPool.insert(string(reinterpret_cast<const char*>(keyBuf), len)).first;
+	snapshot->mapKeyNames.insert(std::make_pair(string(name), &(*iter)));
 	return 1;
 #else /* !ENABLE_DECRYPTION */
 	RP_UNUSED(section);
@@ -215,6 +337,90 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 #endif /* ENABLE_DECRYPTION */
 }
 
+#ifdef ENABLE_DECRYPTION
+/**
+ * Verify a key by decrypting a verification block.
+ * The result must be "AES-128-ECB-TEST".
+ * @param pKey		[in] Key data.
+ * @param keyLen	[in] Key length. (16, 24, or 32)
+ * @param pVerifyData	[in] Verification data block. (16 bytes)
+ * @return VerifyResult.
+ */
+KeyManager::VerifyResult KeyManagerPrivate::verifyKey(const uint8_t *pKey, unsigned int keyLen,
+	const uint8_t *pVerifyData)
+{
+	unique_ptr<IAesCipher> cipher(AesCipherFactory::create());
+	if (!cipher) {
+		// Unable to create the IAesCipher.
+		return KeyManager::VERFIY_IAESCIPHER_INIT_ERR;
+	}
+
+	// Set cipher parameters.
+	int ret = cipher->setChainingMode(IAesCipher::CM_ECB);
+	if (ret != 0) {
+		return KeyManager::VERFIY_IAESCIPHER_INIT_ERR;
+	}
+	ret = cipher->setKey(pKey, keyLen);
+	if (ret != 0) {
+		return KeyManager::VERFIY_IAESCIPHER_INIT_ERR;
+	}
+
+	// Decrypt the test data.
+	// NOTE: IAesCipher decrypts in place, so we need to
+	// make a temporary copy.
+	uint8_t tmpData[16];
+	memcpy(tmpData, pVerifyData, sizeof(tmpData));
+	size_t size = cipher->decrypt(tmpData, sizeof(tmpData));
+	if (size != sizeof(tmpData)) {
+		// Decryption failed.
+		return KeyManager::VERIFY_IAESCIPHER_DECRYPT_ERR;
+	}
+
+	// Verify the test data.
+	if (memcmp(tmpData, KeyManager::verifyTestString, sizeof(tmpData)) != 0) {
+		// Verification failed.
+		return KeyManager::VERIFY_WRONG_KEY;
+	}
+
+	// Test data verified.
+	return KeyManager::VERIFY_OK;
+}
+
+/**
+ * Get an encryption key from a snapshot.
+ * @param snapshot	[in] Snapshot.
+ * @param keyName	[in] Encryption key name.
+ * @param pKeyData	[out,opt] Key data struct.
+ * @return VerifyResult.
+ */
+KeyManager::VerifyResult KeyManagerPrivate::getKey(const Snapshot *snapshot,
+	const char *keyName, KeyManager::KeyData_t *pKeyData)
+{
+	auto iter = snapshot->mapKeyNames.find(keyName);
+	if (iter == snapshot->mapKeyNames.end()) {
+		// Key was not parsed. Figure out why.
+		auto iter2 = snapshot->mapInvalidKeyNames.find(keyName);
+		if (iter2 != snapshot->mapInvalidKeyNames.end()) {
+			// An error occurred when parsing the key.
+			return (KeyManager::VerifyResult)iter2->second;
+		}
+
+		// Key was not found.
+		return KeyManager::VERIFY_KEY_NOT_FOUND;
+	}
+
+	// Found the key.
+	// NOTE: The key data is in keyPool, so it remains
+	// valid after the snapshot is freed.
+	if (pKeyData) {
+		const string *const keyData = iter->second;
+		pKeyData->key = reinterpret_cast<const uint8_t*>(keyData->data());
+		pKeyData->length = static_cast<uint32_t>(keyData->size());
+	}
+	return KeyManager::VERIFY_OK;
+}
+#endif /* ENABLE_DECRYPTION */
+
 /** KeyManager **/
 
 KeyManager::KeyManager()
@@ -266,8 +472,10 @@ const char *KeyManager::verifyResultToString(VerifyResult res)
  */
 KeyManager *KeyManager::instance(void)
 {
+	// Initialize the singleton instance.
+	pthread_once(&KeyManagerPrivate::once_instance, KeyManagerPrivate::initInstance);
 	// Return the singleton instance.
-	return &KeyManagerPrivate::instance;
+	return KeyManagerPrivate::instance.get();
 }
 
 /**
@@ -295,38 +503,10 @@ KeyManager::VerifyResult KeyManager::get(const char *keyName, KeyData_t *pKeyDat
 		return VERIFY_KEY_DB_NOT_LOADED;
 	}
 
-	// Attempt to get the key from the map.
+	// Get the key from the current snapshot.
 	RP_D(const KeyManager);
-	auto iter = d->mapKeyNames.find(keyName);
-	if (iter == d->mapKeyNames.end()) {
-		// Key was not parsed. Figure out why.
-		auto iter2 = d->mapInvalidKeyNames.find(keyName);
-		if (iter2 != d->mapInvalidKeyNames.end()) {
-			// An error occurred when parsing the key.
-			return (VerifyResult)iter2->second;
-		}
-
-		// Key was not found.
-		return VERIFY_KEY_NOT_FOUND;
-	}
-
-	// Found the key.
-	const uint32_t keyIdx = iter->second;
-	const uint32_t idx = (keyIdx & 0xFFFFFF);
-	const uint8_t len = ((keyIdx >> 24) & 0xFF);
-
-	// Make sure the key index is valid.
-	assert(idx + len <= d->vKeys.size());
-	if (idx + len > d->vKeys.size()) {
-		// Should not happen...
-		return VERIFY_KEY_DB_ERROR;
-	}
-
-	if (pKeyData) {
-		pKeyData->key = d->vKeys.data() + idx;
-		pKeyData->length = len;
-	}
-	return VERIFY_OK;
+	const KeyManagerPrivate::CurrentSnapshot snapshot(d);
+	return KeyManagerPrivate::getKey(snapshot.get(), keyName, pKeyData);
 }
 
 /**
@@ -339,6 +519,9 @@ KeyManager::VerifyResult KeyManager::get(const char *keyName, KeyData_t *pKeyDat
  * If the key is valid, pKeyData will be populated
  * with the key information, similar to get().
  *
+ * Verification results are cached until keys.conf
+ * is reloaded, so repeated calls are cheap.
+ *
  * @param keyName	[in] Encryption key name.
  * @param pKeyData	[out] Key data struct.
  * @param pVerifyData	[in] Verification data block.
@@ -362,8 +545,19 @@ KeyManager::VerifyResult KeyManager::getAndVerify(const char *keyName, KeyData_t
 		pKeyData = &tmp_key_data;
 	}
 
+	// Check if keys.conf needs to be reloaded.
+	const_cast<KeyManager*>(this)->load();
+	if (!isLoaded()) {
+		// Keys are not loaded.
+		return VERIFY_KEY_DB_NOT_LOADED;
+	}
+
 	// Get the key first.
-	VerifyResult res = get(keyName, pKeyData);
+	// NOTE: The same snapshot is used for the verification
+	// cache, so a cached result always matches the key.
+	RP_D(const KeyManager);
+	const KeyManagerPrivate::CurrentSnapshot snapshot(d);
+	VerifyResult res = KeyManagerPrivate::getKey(snapshot.get(), keyName, pKeyData);
 	if (res != VERIFY_OK) {
 		// Error obtaining the key.
 		return res;
@@ -378,43 +572,141 @@ KeyManager::VerifyResult KeyManager::getAndVerify(const char *keyName, KeyData_t
 		return VERIFY_KEY_INVALID;
 	}
 
+	// Check if this key was already verified against this
+	// verification block. The cache is part of the snapshot,
+	// so it's invalidated if keys.conf is reloaded.
+	{
+		MutexLocker mtxLocker(snapshot->mtxCache);
+		auto iter = snapshot->mapVerifiedKeys.find(keyName);
+		if (iter != snapshot->mapVerifiedKeys.end() &&
+		    !memcmp(iter->second.verifyData, pVerifyData, verifyLen))
+		{
+			// Found a cached verification result.
+			return static_cast<VerifyResult>(iter->second.result);
+		}
+	}
+
 	// Decrypt the test data.
-	// TODO: Keep this IAesCipher instance around?
-	unique_ptr<IAesCipher> cipher(AesCipherFactory::create());
-	if (!cipher) {
-		// Unable to create the IAesCipher.
-		return VERFIY_IAESCIPHER_INIT_ERR;
+	res = KeyManagerPrivate::verifyKey(pKeyData->key, pKeyData->length, pVerifyData);
+	switch (res) {
+		case VERIFY_OK:
+		case VERIFY_WRONG_KEY: {
+			// Cache the verification result.
+			// Other errors might be transient, so they aren't cached.
+			KeyManagerPrivate::Snapshot::VerifiedKey vkey;
+			memcpy(vkey.verifyData, pVerifyData, sizeof(vkey.verifyData));
+			vkey.result = static_cast<uint8_t>(res);
+
+			MutexLocker mtxLocker(snapshot->mtxCache);
+			snapshot->mapVerifiedKeys[keyName] = vkey;
+			break;
+		}
+		default:
+			break;
 	}
 
-	// Set cipher parameters.
-	int ret = cipher->setChainingMode(IAesCipher::CM_ECB);
-	if (ret != 0) {
-		return VERFIY_IAESCIPHER_INIT_ERR;
+	return res;
+}
+
+/**
+ * Look up a derived key in the derived key cache.
+ *
+ * Derived keys are always 16 bytes. The cache is
+ * bounded, and it's cleared if keys.conf is reloaded.
+ *
+ * @param type		[in] Derived key type.
+ * @param pInput	[in] Input data used to derive the key.
+ * @param inputLen	[in] Length of pInput.
+ * @param pKeyOut	[out] Derived key. (16 bytes)
+ * @return True if the key was found; false if not.
+ */
+bool KeyManager::getDerivedKey(DerivedKeyType type, const uint8_t *pInput,
+	unsigned int inputLen, uint8_t *pKeyOut) const
+{
+	assert(type >= 0 && type < DERIVED_MAX);
+	assert(pInput != nullptr);
+	assert(pKeyOut != nullptr);
+	if (type < 0 || type >= DERIVED_MAX || !pInput || !pKeyOut) {
+		// Invalid parameters.
+		return false;
 	}
-	ret = cipher->setKey(pKeyData->key, pKeyData->length);
-	if (ret != 0) {
-		return VERFIY_IAESCIPHER_INIT_ERR;
+
+	// Check if keys.conf needs to be reloaded.
+	// If it was, the new snapshot has an empty cache.
+	const_cast<KeyManager*>(this)->load();
+
+	RP_D(const KeyManager);
+	const KeyManagerPrivate::CurrentSnapshot snapshot(d);
+	const string id = KeyManagerPrivate::Snapshot::derivedKeyId(type, pInput, inputLen);
+
+	MutexLocker mtxLocker(snapshot->mtxCache);
+	auto iter = snapshot->mapDerivedKeys.find(id);
+	if (iter == snapshot->mapDerivedKeys.end()) {
+		// Not found.
+		return false;
 	}
 
-	// Decrypt the test data.
-	// NOTE: IAesCipher decrypts in place, so we need to
-	// make a temporary copy.
-	unique_ptr<uint8_t[]> tmpData(new uint8_t[verifyLen]);
-	memcpy(tmpData.get(), pVerifyData, verifyLen);
-	size_t size = cipher->decrypt(tmpData.get(), verifyLen);
-	if (size != verifyLen) {
-		// Decryption failed.
-		return VERIFY_IAESCIPHER_DECRYPT_ERR;
+	// Found the key. Move it to the front of the LRU list.
+	auto &lst = snapshot->lstDerivedKeys;
+	if (iter->second != lst.begin()) {
+		lst.splice(lst.begin(), lst, iter->second);
 	}
+	memcpy(pKeyOut, iter->second->key, sizeof(iter->second->key));
+	return true;
+}
 
-	// Verify the test data.
-	if (memcmp(tmpData.get(), verifyTestString, verifyLen) != 0) {
-		// Verification failed.
-		return VERIFY_WRONG_KEY;
+/**
+ * Add a derived key to the derived key cache.
+ * If the cache is full, the least-recently used key is evicted.
+ * @param type		[in] Derived key type.
+ * @param pInput	[in] Input data used to derive the key.
+ * @param inputLen	[in] Length of pInput.
+ * @param pKey		[in] Derived key. (16 bytes)
+ */
+void KeyManager::setDerivedKey(DerivedKeyType type, const uint8_t *pInput,
+	unsigned int inputLen, const uint8_t *pKey) const
+{
+	assert(type >= 0 && type < DERIVED_MAX);
+	assert(pInput != nullptr);
+	assert(pKey != nullptr);
+	if (type < 0 || type >= DERIVED_MAX || !pInput || !pKey) {
+		// Invalid parameters.
+		return;
 	}
 
-	// Test data verified.
-	return VERIFY_OK;
+	// NOTE: Not calling load() here. If keys.conf was reloaded
+	// since the key was derived, it'll be added to the new
+	// snapshot's cache, which is harmless since the cache
+	// is keyed on the input data, not the key names.
+	RP_D(const KeyManager);
+	const KeyManagerPrivate::CurrentSnapshot snapshot(d);
+	string id = KeyManagerPrivate::Snapshot::derivedKeyId(type, pInput, inputLen);
+
+	MutexLocker mtxLocker(snapshot->mtxCache);
+	auto &lst = snapshot->lstDerivedKeys;
+	auto &map = snapshot->mapDerivedKeys;
+	auto iter = map.find(id);
+	if (iter != map.end()) {
+		// Key is already cached. Update it and move it to the front.
+		memcpy(iter->second->key, pKey, sizeof(iter->second->key));
+		if (iter->second != lst.begin()) {
+			lst.splice(lst.begin(), lst, iter->second);
+		}
+		return;
+	}
+
+	if (lst.size() >= KeyManagerPrivate::Snapshot::DERIVED_KEY_CACHE_MAX) {
+		// Cache is full. Evict the least-recently used key.
+		map.erase(lst.back().id);
+		lst.pop_back();
+	}
+
+	// Add the key to the front of the LRU list.
+	lst.emplace_front();
+	KeyManagerPrivate::Snapshot::DerivedKey &entry = lst.front();
+	memcpy(entry.key, pKey, sizeof(entry.key));
+	entry.id = std::move(id);
+	map.insert(std::make_pair(entry.id, lst.begin()));
 }
 
 /**
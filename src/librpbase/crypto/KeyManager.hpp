@@ -95,6 +95,9 @@ class KeyManager : public ConfReader
 		 * If the key is valid, pKeyData will be populated
 		 * with the key information, similar to get().
 		 *
+		 * Verification results are cached until keys.conf
+		 * is reloaded, so repeated calls are cheap.
+		 *
 		 * @param keyName	[in] Encryption key name.
 		 * @param pKeyData	[out,opt] Key data struct. (If nullptr, key will be checked but not loaded.)
 		 * @param pVerifyData	[in] Verification data block.
@@ -108,6 +111,44 @@ class KeyManager : public ConfReader
 		// NOTE: This string is NOT NULL-terminated!
 		static const char verifyTestString[16];
 
+	public:
+		/**
+		 * Derived key types.
+		 * Used as part of the derived key cache lookup.
+		 */
+		enum DerivedKeyType {
+			DERIVED_CTR_KEYNORMAL	= 0,	// Nintendo 3DS: (KeyX, KeyY) -> KeyNormal
+			DERIVED_WII_TITLE_KEY	= 1,	// Wii: (common key, ticket) -> title key
+
+			DERIVED_MAX
+		};
+
+		/**
+		 * Look up a derived key in the derived key cache.
+		 *
+		 * Derived keys are always 16 bytes. The cache is
+		 * bounded, and it's cleared if keys.conf is reloaded.
+		 *
+		 * @param type		[in] Derived key type.
+		 * @param pInput	[in] Input data used to derive the key.
+		 * @param inputLen	[in] Length of pInput.
+		 * @param pKeyOut	[out] Derived key. (16 bytes)
+		 * @return True if the key was found; false if not.
+		 */
+		bool getDerivedKey(DerivedKeyType type, const uint8_t *pInput,
+			unsigned int inputLen, uint8_t *pKeyOut) const;
+
+		/**
+		 * Add a derived key to the derived key cache.
+		 * If the cache is full, the least-recently used key is evicted.
+		 * @param type		[in] Derived key type.
+		 * @param pInput	[in] Input data used to derive the key.
+		 * @param inputLen	[in] Length of pInput.
+		 * @param pKey		[in] Derived key. (16 bytes)
+		 */
+		void setDerivedKey(DerivedKeyType type, const uint8_t *pInput,
+			unsigned int inputLen, const uint8_t *pKey) const;
+
 		/**
 		 * Convert string data from hexadecimal to bytes.
 		 * @param str	[in] String data. (Must be len*2 characters.)
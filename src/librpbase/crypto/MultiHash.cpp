@@ -0,0 +1,580 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * MultiHash.cpp: Single-pass multi-algorithm hash calculator.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "MultiHash_p.hpp"
+
+// librpbase
+#include "../disc/IDiscReader.hpp"
+
+// librpfile
+#include "librpfile/IRpFile.hpp"
+using LibRpFile::IRpFile;
+
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+
+#if defined(MULTIHASH_HAS_CLMUL) || defined(MULTIHASH_HAS_SHANI)
+# include "librpcpu/cpuflags_x86.h"
+#endif /* MULTIHASH_HAS_CLMUL || MULTIHASH_HAS_SHANI */
+
+// zlib for crc32()
+#include <zlib.h>
+
+// C++ STL classes.
+using std::string;
+using std::unique_ptr;
+
+namespace LibRpBase {
+
+/** MultiHashPrivate **/
+
+MultiHashPrivate::MultiHashPrivate(unsigned int algorithms)
+	: algorithms(algorithms & MultiHash::supportedAlgorithms())
+	, finalized(false)
+	, bytesHashed(0)
+	, crc32(0)
+{
+	memset(digests, 0, sizeof(digests));
+	init();
+}
+
+/**
+ * Initialize the hash states.
+ */
+void MultiHashPrivate::init(void)
+{
+	finalized = false;
+	bytesHashed = 0;
+	crc32 = 0;
+
+#ifdef HAVE_NETTLE
+	md5_init(&md5);
+	sha1_init(&sha1);
+	sha256_init(&sha256);
+#endif
+}
+
+/**
+ * Hash a block of data with a single algorithm.
+ * @param idx Algorithm index.
+ * @param data Data.
+ * @param size Size of data, in bytes.
+ */
+void MultiHashPrivate::updateOne(int idx, const uint8_t *data, size_t size)
+{
+	// NOTE: zlib and older versions of Nettle use
+	// 32-bit lengths, so large buffers are split up.
+	static const size_t MAX_PIECE = 1U << 30;
+
+	while (size > 0) {
+		const size_t piece = (size > MAX_PIECE ? MAX_PIECE : size);
+		switch (idx) {
+			case IDX_CRC32:
+				crc32 = crc32_update(crc32, data, piece);
+				break;
+#ifdef HAVE_NETTLE
+			case IDX_MD5:
+				md5_update(&md5, piece, data);
+				break;
+			case IDX_SHA1:
+				sha1_update(&sha1, piece, data);
+				break;
+			case IDX_SHA256:
+				sha256_update(&sha256, piece, data);
+				break;
+#endif
+			default:
+				assert(!"Unsupported hash algorithm.");
+				return;
+		}
+		data += piece;
+		size -= piece;
+	}
+}
+
+/**
+ * Finalize a single algorithm.
+ * @param idx Algorithm index.
+ */
+void MultiHashPrivate::finalizeOne(int idx)
+{
+	uint8_t *const digest = digests[idx];
+	switch (idx) {
+		case IDX_CRC32:
+			// Store the CRC32 as big-endian.
+			digest[0] = (crc32 >> 24) & 0xFF;
+			digest[1] = (crc32 >> 16) & 0xFF;
+			digest[2] = (crc32 >>  8) & 0xFF;
+			digest[3] =  crc32        & 0xFF;
+			break;
+#ifdef HAVE_NETTLE
+		case IDX_MD5:
+			md5_digest(&md5, MD5_DIGEST_SIZE, digest);
+			break;
+		case IDX_SHA1:
+			sha1_digest(&sha1, SHA1_DIGEST_SIZE, digest);
+			break;
+		case IDX_SHA256:
+			sha256_digest(&sha256, SHA256_DIGEST_SIZE, digest);
+			break;
+#endif
+		default:
+			assert(!"Unsupported hash algorithm.");
+			break;
+	}
+}
+
+/**
+ * Update a CRC32.
+ * Uses a PCLMULQDQ-folded implementation if available.
+ * @param crc Current CRC32. (finalized value, as used by zlib)
+ * @param data Data.
+ * @param size Size of data, in bytes.
+ * @return Updated CRC32.
+ */
+uint32_t MultiHashPrivate::crc32_update(uint32_t crc, const uint8_t *data, size_t size)
+{
+#ifdef MULTIHASH_HAS_CLMUL
+	if (size >= 64 && RP_CPU_HasPCLMULQDQ() && RP_CPU_HasSSE41()) {
+		// Fold as many 16-byte blocks as possible.
+		// The remainder is handled by zlib.
+		const size_t fold_size = size & ~static_cast<size_t>(15);
+		crc = ~crc32_clmul(data, fold_size, ~crc);
+		data += fold_size;
+		size -= fold_size;
+		if (size == 0)
+			return crc;
+	}
+#endif /* MULTIHASH_HAS_CLMUL */
+
+	return static_cast<uint32_t>(::crc32(crc, data, static_cast<uInt>(size)));
+}
+
+/**
+ * Hash task parameters.
+ * One task is queued per algorithm for each chunk.
+ */
+struct HashTask {
+	MultiHashPrivate *d;
+	const uint8_t *data;
+	size_t size;
+	int idx;
+};
+
+/**
+ * Hash task function.
+ * @param param HashTask.
+ * @param arena Scratch arena. (unused)
+ */
+static void hashTaskFn(void *param, ScratchArena *arena)
+{
+	RP_UNUSED(arena);
+	const HashTask *const task = static_cast<const HashTask*>(param);
+	task->d->updateOne(task->idx, task->data, task->size);
+}
+
+/**
+ * Hash an entire source, then finalize.
+ * Used by hashFile() and hashReader().
+ * @tparam T IRpFile or IDiscReader
+ * @param src Source.
+ * @param group Task group for cancellation. (optional)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+template<typename T>
+int MultiHashPrivate::hashSource(T *src, TaskGroup *group)
+{
+	const off64_t src_size = src->size();
+	if (src_size < 0) {
+		const int err = src->lastError();
+		return (err != 0 ? -err : -EIO);
+	}
+	init();
+
+	// Two chunk buffers: one is hashed while the other is read.
+	static const size_t CHUNK_SIZE = 1024U * 1024U;
+	unique_ptr<uint8_t[]> buf(new uint8_t[CHUNK_SIZE * 2]);
+	uint8_t *const bufs[2] = {buf.get(), buf.get() + CHUNK_SIZE};
+
+	// Set up the hash tasks.
+	HashTask tasks[MultiHash::ALGO_COUNT];
+	int taskCount = 0;
+	for (int i = 0; i < MultiHash::ALGO_COUNT; i++) {
+		if (algorithms & (1U << i)) {
+			tasks[taskCount].d = this;
+			tasks[taskCount].idx = i;
+			taskCount++;
+		}
+	}
+
+	// NOTE: Using our own TaskGroup, since waiting on the
+	// caller's group would wait for unrelated tasks.
+	TaskGroup tg;
+	int ret = 0;
+
+	// Read the first chunk.
+	off64_t pos = 0;
+	int b = 0;
+	size_t cur_size = static_cast<size_t>(
+		std::min(static_cast<off64_t>(CHUNK_SIZE), src_size));
+	if (cur_size > 0 && src->pread(0, bufs[0], cur_size) != cur_size) {
+		const int err = src->lastError();
+		return (err != 0 ? -err : -EIO);
+	}
+
+	while (cur_size > 0) {
+		// Hash the current chunk on the worker threads.
+		for (int i = 0; i < taskCount; i++) {
+			tasks[i].data = bufs[b];
+			tasks[i].size = cur_size;
+			tg.run(hashTaskFn, &tasks[i]);
+		}
+
+		// Read the next chunk while the current chunk is hashed.
+		pos += cur_size;
+		const size_t next_size = static_cast<size_t>(
+			std::min(static_cast<off64_t>(CHUNK_SIZE), src_size - pos));
+		size_t sz_read = 0;
+		if (next_size > 0) {
+			sz_read = src->pread(pos, bufs[b ^ 1], next_size);
+		}
+
+		tg.wait();
+		bytesHashed += cur_size;
+
+		if (sz_read != next_size) {
+			// Short read.
+			const int err = src->lastError();
+			ret = (err != 0 ? -err : -EIO);
+			break;
+		}
+		if (group && group->isCancelled()) {
+			ret = -ECANCELED;
+			break;
+		}
+
+		// Swap the buffers.
+		b ^= 1;
+		cur_size = next_size;
+	}
+
+	if (ret == 0) {
+		// Finalize the hashes.
+		for (int i = 0; i < taskCount; i++) {
+			finalizeOne(tasks[i].idx);
+		}
+		finalized = true;
+	}
+	return ret;
+}
+
+/** MultiHash **/
+
+/**
+ * Create a MultiHash object.
+ * Unsupported algorithms are silently dropped;
+ * check algorithms() to see what will be calculated.
+ * @param algorithms Algorithms to calculate. (Algorithm bitfield)
+ */
+MultiHash::MultiHash(unsigned int algorithms)
+	: d_ptr(new MultiHashPrivate(algorithms))
+{ }
+
+MultiHash::~MultiHash()
+{
+	delete d_ptr;
+}
+
+/**
+ * Get the algorithms supported by this build.
+ * CRC32 is always supported. MD5, SHA-1, and SHA-256
+ * require a crypto backend, which is only available
+ * if decryption is enabled.
+ * @return Supported algorithms. (Algorithm bitfield)
+ */
+unsigned int MultiHash::supportedAlgorithms(void)
+{
+#ifdef HAVE_NETTLE
+	return ALGO_ALL;
+#else
+	return ALGO_CRC32;
+#endif
+}
+
+/**
+ * Get the name of an algorithm.
+ * @param algo Algorithm. (single bit)
+ * @return Algorithm name, or nullptr if invalid.
+ */
+const char *MultiHash::algorithmName(Algorithm algo)
+{
+	switch (algo) {
+		case ALGO_CRC32:	return "CRC32";
+		case ALGO_MD5:		return "MD5";
+		case ALGO_SHA1:		return "SHA-1";
+		case ALGO_SHA256:	return "SHA-256";
+		default:		break;
+	}
+	return nullptr;
+}
+
+/**
+ * Get the digest length of an algorithm.
+ * @param algo Algorithm. (single bit)
+ * @return Digest length, in bytes, or 0 if invalid.
+ */
+unsigned int MultiHash::digestLength(Algorithm algo)
+{
+	switch (algo) {
+		case ALGO_CRC32:	return 4;
+		case ALGO_MD5:		return 16;
+		case ALGO_SHA1:		return 20;
+		case ALGO_SHA256:	return 32;
+		default:		break;
+	}
+	return 0;
+}
+
+/**
+ * Calculate the SHA-1 of a buffer on the calling thread.
+ *
+ * This is intended for verifying hash trees, where a large
+ * number of small blocks are hashed, so it doesn't allocate
+ * anything. The x86 SHA extensions are used if available.
+ *
+ * @param data		[in] Data.
+ * @param size		[in] Size of data, in bytes.
+ * @param pDigest	[out] Digest. (20 bytes)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MultiHash::sha1(const void *data, size_t size, uint8_t *pDigest)
+{
+	assert(data != nullptr || size == 0);
+	assert(pDigest != nullptr);
+	if (!pDigest) {
+		return -EINVAL;
+	}
+
+#ifdef MULTIHASH_HAS_SHANI
+	if (RP_CPU_HasSHA() && RP_CPU_HasSSE41()) {
+		uint32_t state[5] = {
+			0x67452301, 0xEFCDAB89, 0x98BADCFE,
+			0x10325476, 0xC3D2E1F0
+		};
+
+		// Full blocks.
+		const uint8_t *p = static_cast<const uint8_t*>(data);
+		const size_t nblocks = size / 64;
+		if (nblocks > 0) {
+			MultiHashPrivate::sha1_shani(state, p, nblocks);
+			p += (nblocks * 64);
+		}
+
+		// Final block(s), with padding and the bit length.
+		uint8_t tail[128];
+		const size_t rem = size % 64;
+		const size_t tail_len = (rem < 56 ? 64 : 128);
+		memcpy(tail, p, rem);
+		tail[rem] = 0x80;
+		memset(&tail[rem+1], 0, tail_len - rem - 1);
+		const uint64_t bits = static_cast<uint64_t>(size) << 3;
+		for (unsigned int i = 0; i < 8; i++) {
+			tail[tail_len - 1 - i] = static_cast<uint8_t>(bits >> (i * 8));
+		}
+		MultiHashPrivate::sha1_shani(state, tail, tail_len / 64);
+
+		// Store the digest. (big-endian)
+		for (unsigned int i = 0; i < 5; i++) {
+			pDigest[i*4+0] = static_cast<uint8_t>(state[i] >> 24);
+			pDigest[i*4+1] = static_cast<uint8_t>(state[i] >> 16);
+			pDigest[i*4+2] = static_cast<uint8_t>(state[i] >>  8);
+			pDigest[i*4+3] = static_cast<uint8_t>(state[i]);
+		}
+		return 0;
+	}
+#endif /* MULTIHASH_HAS_SHANI */
+
+#ifdef HAVE_NETTLE
+	struct sha1_ctx ctx;
+	sha1_init(&ctx);
+	sha1_update(&ctx, size, static_cast<const uint8_t*>(data));
+	sha1_digest(&ctx, SHA1_DIGEST_SIZE, pDigest);
+	return 0;
+#else /* !HAVE_NETTLE */
+	// SHA-1 isn't supported.
+	RP_UNUSED(data);
+	RP_UNUSED(size);
+	return -ENOTSUP;
+#endif /* HAVE_NETTLE */
+}
+
+/**
+ * Get the algorithms being calculated by this object.
+ * @return Algorithms. (Algorithm bitfield)
+ */
+unsigned int MultiHash::algorithms(void) const
+{
+	RP_D(const MultiHash);
+	return d->algorithms;
+}
+
+/**
+ * Reset all hash states.
+ */
+void MultiHash::reset(void)
+{
+	RP_D(MultiHash);
+	d->init();
+}
+
+/**
+ * Hash a block of data on the calling thread.
+ * @param data Data.
+ * @param size Size of data, in bytes.
+ */
+void MultiHash::update(const void *data, size_t size)
+{
+	RP_D(MultiHash);
+	assert(!d->finalized);
+	if (d->finalized)
+		return;
+
+	const uint8_t *const data8 = static_cast<const uint8_t*>(data);
+	for (int i = 0; i < ALGO_COUNT; i++) {
+		if (d->algorithms & (1U << i)) {
+			d->updateOne(i, data8, size);
+		}
+	}
+	d->bytesHashed += size;
+}
+
+/**
+ * Finalize the hashes.
+ * No more data can be added until reset() is called.
+ */
+void MultiHash::finalize(void)
+{
+	RP_D(MultiHash);
+	if (d->finalized)
+		return;
+
+	for (int i = 0; i < ALGO_COUNT; i++) {
+		if (d->algorithms & (1U << i)) {
+			d->finalizeOne(i);
+		}
+	}
+	d->finalized = true;
+}
+
+/**
+ * Hash an entire file in a single pass, then finalize.
+ *
+ * The file is read in chunks using pread(), so the file
+ * position isn't changed. While one chunk is being hashed,
+ * with each algorithm running on a separate worker thread,
+ * the next chunk is read into a second buffer.
+ *
+ * @param file File.
+ * @param group Task group for cancellation. (optional)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MultiHash::hashFile(IRpFile *file, TaskGroup *group)
+{
+	assert(file != nullptr);
+	if (!file)
+		return -EINVAL;
+
+	RP_D(MultiHash);
+	return d->hashSource(file, group);
+}
+
+/**
+ * Hash an entire disc image in a single pass, then finalize.
+ *
+ * Sparse and compressed disc images (e.g. WBFS, CISO, WUX)
+ * are hashed through their IDiscReader, so the hashes are
+ * for the logical disc image without an extraction step.
+ *
+ * @param reader IDiscReader.
+ * @param group Task group for cancellation. (optional)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MultiHash::hashReader(IDiscReader *reader, TaskGroup *group)
+{
+	assert(reader != nullptr);
+	if (!reader)
+		return -EINVAL;
+
+	RP_D(MultiHash);
+	return d->hashSource(reader, group);
+}
+
+/**
+ * Get the number of bytes hashed since the last reset().
+ * @return Number of bytes hashed.
+ */
+uint64_t MultiHash::bytesHashed(void) const
+{
+	RP_D(const MultiHash);
+	return d->bytesHashed;
+}
+
+/**
+ * Get a finalized digest.
+ * @param algo	[in] Algorithm. (single bit)
+ * @param pBuf	[out] Output buffer.
+ * @param size	[in] Size of pBuf. (must be at least digestLength(algo))
+ * @return Digest length on success; negative POSIX error code on error.
+ */
+int MultiHash::digest(Algorithm algo, uint8_t *pBuf, size_t size) const
+{
+	RP_D(const MultiHash);
+	const unsigned int len = digestLength(algo);
+	assert(len != 0);
+	assert(pBuf != nullptr);
+	if (len == 0 || !pBuf) {
+		return -EINVAL;
+	} else if (size < len) {
+		return -ENOSPC;
+	} else if (!(d->algorithms & algo)) {
+		// Algorithm wasn't calculated.
+		return -ENOENT;
+	} else if (!d->finalized) {
+		// Hashes haven't been finalized yet.
+		return -EAGAIN;
+	}
+
+	const int idx = uilog2(static_cast<unsigned int>(algo));
+	memcpy(pBuf, d->digests[idx], len);
+	return static_cast<int>(len);
+}
+
+/**
+ * Get a finalized digest as a lowercase hexadecimal string.
+ * @param algo Algorithm. (single bit)
+ * @return Hexadecimal string, or empty string on error.
+ */
+string MultiHash::hexDigest(Algorithm algo) const
+{
+	uint8_t buf[32];
+	const int len = digest(algo, buf, sizeof(buf));
+	if (len <= 0)
+		return string();
+
+	static const char hex_lookup[] = "0123456789abcdef";
+	string s;
+	s.resize(len * 2);
+	for (int i = 0; i < len; i++) {
+		s[i*2]   = hex_lookup[buf[i] >> 4];
+		s[i*2+1] = hex_lookup[buf[i] & 0x0F];
+	}
+	return s;
+}
+
+}
@@ -0,0 +1,180 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * MultiHash.hpp: Single-pass multi-algorithm hash calculator.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_CRYPTO_MULTIHASH_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_CRYPTO_MULTIHASH_HPP__
+
+#include "common.h"
+
+// C includes.
+#include <stddef.h>
+#include <stdint.h>
+
+// C++ includes.
+#include <string>
+
+namespace LibRpFile {
+	class IRpFile;
+}
+
+namespace LibRpBase {
+
+class IDiscReader;
+class TaskGroup;
+
+class MultiHashPrivate;
+class MultiHash
+{
+	public:
+		/**
+		 * Hash algorithms.
+		 * This is a bitfield; multiple algorithms can be
+		 * calculated in a single pass.
+		 */
+		enum Algorithm {
+			ALGO_CRC32	= (1U << 0),
+			ALGO_MD5	= (1U << 1),
+			ALGO_SHA1	= (1U << 2),
+			ALGO_SHA256	= (1U << 3),
+
+			ALGO_ALL	= 0x0F,
+			ALGO_COUNT	= 4
+		};
+
+		/**
+		 * Create a MultiHash object.
+		 * Unsupported algorithms are silently dropped;
+		 * check algorithms() to see what will be calculated.
+		 * @param algorithms Algorithms to calculate. (Algorithm bitfield)
+		 */
+		explicit MultiHash(unsigned int algorithms = ALGO_ALL);
+		~MultiHash();
+
+	private:
+		RP_DISABLE_COPY(MultiHash)
+	private:
+		friend class MultiHashPrivate;
+		MultiHashPrivate *const d_ptr;
+
+	public:
+		/**
+		 * Get the algorithms supported by this build.
+		 * CRC32 is always supported. MD5, SHA-1, and SHA-256
+		 * require Nettle, which is currently only used on
+		 * non-Windows systems with decryption enabled.
+		 * @return Supported algorithms. (Algorithm bitfield)
+		 */
+		static unsigned int supportedAlgorithms(void);
+
+		/**
+		 * Get the name of an algorithm.
+		 * @param algo Algorithm. (single bit)
+		 * @return Algorithm name, or nullptr if invalid.
+		 */
+		static const char *algorithmName(Algorithm algo);
+
+		/**
+		 * Get the digest length of an algorithm.
+		 * @param algo Algorithm. (single bit)
+		 * @return Digest length, in bytes, or 0 if invalid.
+		 */
+		static unsigned int digestLength(Algorithm algo);
+
+		/**
+		 * Calculate the SHA-1 of a buffer on the calling thread.
+		 *
+		 * This is intended for verifying hash trees, where a large
+		 * number of small blocks are hashed, so it doesn't allocate
+		 * anything. The x86 SHA extensions are used if available.
+		 *
+		 * @param data		[in] Data.
+		 * @param size		[in] Size of data, in bytes.
+		 * @param pDigest	[out] Digest. (20 bytes)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int sha1(const void *data, size_t size, uint8_t *pDigest);
+
+		/**
+		 * Get the algorithms being calculated by this object.
+		 * @return Algorithms. (Algorithm bitfield)
+		 */
+		unsigned int algorithms(void) const;
+
+	public:
+		/**
+		 * Reset all hash states.
+		 */
+		void reset(void);
+
+		/**
+		 * Hash a block of data on the calling thread.
+		 * @param data Data.
+		 * @param size Size of data, in bytes.
+		 */
+		void update(const void *data, size_t size);
+
+		/**
+		 * Finalize the hashes.
+		 * No more data can be added until reset() is called.
+		 */
+		void finalize(void);
+
+		/**
+		 * Hash an entire file in a single pass, then finalize.
+		 *
+		 * The file is read in chunks using pread(), so the file
+		 * position isn't changed. While one chunk is being hashed,
+		 * with each algorithm running on a separate worker thread,
+		 * the next chunk is read into a second buffer.
+		 *
+		 * @param file File.
+		 * @param group Task group for cancellation. (optional)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int hashFile(LibRpFile::IRpFile *file, TaskGroup *group = nullptr);
+
+		/**
+		 * Hash an entire disc image in a single pass, then finalize.
+		 *
+		 * Sparse and compressed disc images (e.g. WBFS, CISO, WUX)
+		 * are hashed through their IDiscReader, so the hashes are
+		 * for the logical disc image without an extraction step.
+		 *
+		 * @param reader IDiscReader.
+		 * @param group Task group for cancellation. (optional)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int hashReader(IDiscReader *reader, TaskGroup *group = nullptr);
+
+		/**
+		 * Get the number of bytes hashed since the last reset().
+		 * @return Number of bytes hashed.
+		 */
+		uint64_t bytesHashed(void) const;
+
+	public:
+		/**
+		 * Get a finalized digest.
+		 * @param algo	[in] Algorithm. (single bit)
+		 * @param pBuf	[out] Output buffer.
+		 * @param size	[in] Size of pBuf. (must be at least digestLength(algo))
+		 * @return Digest length on success; negative POSIX error code on error.
+		 */
+		int digest(Algorithm algo, uint8_t *pBuf, size_t size) const;
+
+		/**
+		 * Get a finalized digest as a lowercase hexadecimal string.
+		 * @param algo Algorithm. (single bit)
+		 * @return Hexadecimal string, or empty string on error.
+		 */
+		std::string hexDigest(Algorithm algo) const;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_CRYPTO_MULTIHASH_HPP__ */
@@ -0,0 +1,127 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * MultiHash_clmul.cpp: Single-pass multi-algorithm hash calculator.       *
+ * PCLMULQDQ-optimized CRC32.                                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "MultiHash_p.hpp"
+
+// SSE4.1 and PCLMULQDQ intrinsics.
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+
+namespace LibRpBase {
+
+/**
+ * Fold a buffer into a CRC32 using PCLMULQDQ.
+ * NOTE: Requires PCLMULQDQ and SSE4.1.
+ *
+ * Reference: "Fast CRC Computation for Generic Polynomials
+ * Using PCLMULQDQ Instruction", Intel, 2009.
+ * The constants are for the bit-reflected CRC-32 polynomial.
+ *
+ * @param data Data. (size must be at least 64 and a multiple of 16)
+ * @param size Size of data, in bytes.
+ * @param crc Raw CRC32 state. (bitwise NOT of the zlib value)
+ * @return Raw CRC32 state.
+ */
+uint32_t MultiHashPrivate::crc32_clmul(const uint8_t *data, size_t size, uint32_t crc)
+{
+	assert(size >= 64);
+	assert(size % 16 == 0);
+
+	// Folding constants: x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32), x^64
+	ALIGNED_VAR(16, static const uint64_t k1k2[2]) = {0x0154442BD4ULL, 0x01C6E41596ULL};
+	ALIGNED_VAR(16, static const uint64_t k3k4[2]) = {0x01751997D0ULL, 0x00CCAA009EULL};
+	ALIGNED_VAR(16, static const uint64_t k5k0[2]) = {0x0163CD6124ULL, 0x0000000000ULL};
+	// Barrett reduction: P(x)' and mu
+	ALIGNED_VAR(16, static const uint64_t poly[2]) = {0x01DB710641ULL, 0x01F7011641ULL};
+
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+	// Load the first 64 bytes and XOR in the CRC.
+	x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00));
+	x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10));
+	x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20));
+	x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+	data += 64;
+	size -= 64;
+
+	// Fold 64 bytes at a time.
+	for (; size >= 64; data += 64, size -= 64) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30)));
+	}
+
+	// Fold the four accumulators into one.
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	// Fold 16 bytes at a time.
+	for (; size >= 16; data += 16, size -= 16) {
+		x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	}
+
+	// Fold 128 bits to 64 bits.
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+	x1 = _mm_srli_si128(x1, 8);
+	x1 = _mm_xor_si128(x1, x2);
+
+	x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, x3);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	// Barrett reduction to 32 bits.
+	x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+
+	x2 = _mm_and_si128(x1, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+	x2 = _mm_and_si128(x2, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+}
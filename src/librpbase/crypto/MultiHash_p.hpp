@@ -0,0 +1,135 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * MultiHash_p.hpp: Single-pass multi-algorithm hash calculator.           *
+ * (PRIVATE CLASS)                                                         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_CRYPTO_MULTIHASH_P_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_CRYPTO_MULTIHASH_P_HPP__
+
+#include "librpbase/config.librpbase.h"
+#include "MultiHash.hpp"
+
+#if defined(__i386__) || defined(__x86_64__) || \
+    defined(_M_IX86) || defined(_M_X64)
+# define MULTIHASH_HAS_CLMUL 1
+# define MULTIHASH_HAS_SHANI 1
+#endif
+
+#ifdef HAVE_NETTLE
+# include <nettle/md5.h>
+# include <nettle/sha1.h>
+# include <nettle/sha2.h>
+#endif
+
+namespace LibRpBase {
+
+class MultiHashPrivate
+{
+	public:
+		explicit MultiHashPrivate(unsigned int algorithms);
+
+	private:
+		RP_DISABLE_COPY(MultiHashPrivate)
+
+	public:
+		// Algorithms being calculated.
+		unsigned int algorithms;
+		// Set once finalize() has been called.
+		bool finalized;
+		// Number of bytes hashed.
+		uint64_t bytesHashed;
+
+		// Algorithm indexes.
+		// These match the bit positions in MultiHash::Algorithm.
+		enum AlgoIdx {
+			IDX_CRC32	= 0,
+			IDX_MD5		= 1,
+			IDX_SHA1	= 2,
+			IDX_SHA256	= 3,
+		};
+
+		// Hash states.
+		uint32_t crc32;
+#ifdef HAVE_NETTLE
+		struct md5_ctx md5;
+		struct sha1_ctx sha1;
+		struct sha256_ctx sha256;
+#endif
+
+		// Finalized digests.
+		// NOTE: CRC32 is stored big-endian, like the
+		// hexadecimal representation in DAT files.
+		uint8_t digests[MultiHash::ALGO_COUNT][32];
+
+	public:
+		/**
+		 * Initialize the hash states.
+		 */
+		void init(void);
+
+		/**
+		 * Hash a block of data with a single algorithm.
+		 * @param idx Algorithm index.
+		 * @param data Data.
+		 * @param size Size of data, in bytes.
+		 */
+		void updateOne(int idx, const uint8_t *data, size_t size);
+
+		/**
+		 * Finalize a single algorithm.
+		 * @param idx Algorithm index.
+		 */
+		void finalizeOne(int idx);
+
+		/**
+		 * Update a CRC32.
+		 * Uses a PCLMULQDQ-folded implementation if available.
+		 * @param crc Current CRC32. (finalized value, as used by zlib)
+		 * @param data Data.
+		 * @param size Size of data, in bytes.
+		 * @return Updated CRC32.
+		 */
+		static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t size);
+
+#ifdef MULTIHASH_HAS_CLMUL
+		/**
+		 * Fold a buffer into a CRC32 using PCLMULQDQ.
+		 * NOTE: Requires PCLMULQDQ and SSE4.1.
+		 * @param data Data. (size must be at least 64 and a multiple of 16)
+		 * @param size Size of data, in bytes.
+		 * @param crc Raw CRC32 state. (bitwise NOT of the zlib value)
+		 * @return Raw CRC32 state.
+		 */
+		static uint32_t crc32_clmul(const uint8_t *data, size_t size, uint32_t crc);
+#endif /* MULTIHASH_HAS_CLMUL */
+
+#ifdef MULTIHASH_HAS_SHANI
+		/**
+		 * Compress 64-byte blocks into a SHA-1 state using the SHA extensions.
+		 * NOTE: Requires SHA and SSE4.1.
+		 * @param state SHA-1 state. (A, B, C, D, E)
+		 * @param data Data.
+		 * @param nblocks Number of 64-byte blocks.
+		 */
+		static void sha1_shani(uint32_t state[5], const uint8_t *data, size_t nblocks);
+#endif /* MULTIHASH_HAS_SHANI */
+
+		/**
+		 * Hash an entire source, then finalize.
+		 * Used by hashFile() and hashReader().
+		 * @tparam T IRpFile or IDiscReader
+		 * @param src Source.
+		 * @param group Task group for cancellation. (optional)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		template<typename T>
+		int hashSource(T *src, TaskGroup *group);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_CRYPTO_MULTIHASH_P_HPP__ */
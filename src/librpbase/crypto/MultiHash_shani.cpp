@@ -0,0 +1,144 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * MultiHash_shani.cpp: Single-pass multi-algorithm hash calculator.       *
+ * SHA-1 using the x86 SHA extensions.                                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "MultiHash_p.hpp"
+
+// SSE4.1 and SHA intrinsics.
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+#include <immintrin.h>
+
+/**
+ * Four rounds of SHA-1, with message schedule updates.
+ * Based on Intel's "New Instructions Supporting the Secure
+ * Hash Algorithm on Intel Architecture Processors" (2013).
+ *
+ * Rounds 16-63 all follow the same pattern. The message
+ * registers rotate, and the E registers alternate.
+ *
+ * @param En	E register for this group.
+ * @param Ep	E register to save ABCD into.
+ * @param M0	Current message register.
+ * @param M1	Message register finalized by sha1msg2.
+ * @param M2	Message register XORed with M0.
+ * @param M3	Message register started by sha1msg1.
+ * @param f	Round function. (0-3)
+ */
+#define SHA1_ROUNDS4(En, Ep, M0, M1, M2, M3, f) do { \
+	En = _mm_sha1nexte_epu32(En, M0); \
+	Ep = ABCD; \
+	M1 = _mm_sha1msg2_epu32(M1, M0); \
+	ABCD = _mm_sha1rnds4_epu32(ABCD, En, f); \
+	M3 = _mm_sha1msg1_epu32(M3, M0); \
+	M2 = _mm_xor_si128(M2, M0); \
+} while (0)
+
+namespace LibRpBase {
+
+/**
+ * Compress 64-byte blocks into a SHA-1 state using the SHA extensions.
+ * NOTE: Requires SHA and SSE4.1.
+ * @param state SHA-1 state. (A, B, C, D, E)
+ * @param data Data.
+ * @param nblocks Number of 64-byte blocks.
+ */
+void MultiHashPrivate::sha1_shani(uint32_t state[5], const uint8_t *data, size_t nblocks)
+{
+	__m128i ABCD, ABCD_SAVE, E0, E0_SAVE, E1;
+	__m128i MSG0, MSG1, MSG2, MSG3;
+	const __m128i MASK = _mm_set_epi64x(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL);
+
+	// Load the initial state.
+	ABCD = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+	E0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+	ABCD = _mm_shuffle_epi32(ABCD, 0x1B);
+
+	for (; nblocks > 0; nblocks--, data += 64) {
+		// Save the current state.
+		ABCD_SAVE = ABCD;
+		E0_SAVE = E0;
+
+		// Rounds 0-3
+		MSG0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0));
+		MSG0 = _mm_shuffle_epi8(MSG0, MASK);
+		E0 = _mm_add_epi32(E0, MSG0);
+		E1 = ABCD;
+		ABCD = _mm_sha1rnds4_epu32(ABCD, E0, 0);
+
+		// Rounds 4-7
+		MSG1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+		MSG1 = _mm_shuffle_epi8(MSG1, MASK);
+		E1 = _mm_sha1nexte_epu32(E1, MSG1);
+		E0 = ABCD;
+		ABCD = _mm_sha1rnds4_epu32(ABCD, E1, 0);
+		MSG0 = _mm_sha1msg1_epu32(MSG0, MSG1);
+
+		// Rounds 8-11
+		MSG2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
+		MSG2 = _mm_shuffle_epi8(MSG2, MASK);
+		E0 = _mm_sha1nexte_epu32(E0, MSG2);
+		E1 = ABCD;
+		ABCD = _mm_sha1rnds4_epu32(ABCD, E0, 0);
+		MSG1 = _mm_sha1msg1_epu32(MSG1, MSG2);
+		MSG0 = _mm_xor_si128(MSG0, MSG2);
+
+		// Rounds 12-15
+		MSG3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48));
+		MSG3 = _mm_shuffle_epi8(MSG3, MASK);
+		SHA1_ROUNDS4(E1, E0, MSG3, MSG0, MSG1, MSG2, 0);
+
+		// Rounds 16-63
+		SHA1_ROUNDS4(E0, E1, MSG0, MSG1, MSG2, MSG3, 0);
+		SHA1_ROUNDS4(E1, E0, MSG1, MSG2, MSG3, MSG0, 1);
+		SHA1_ROUNDS4(E0, E1, MSG2, MSG3, MSG0, MSG1, 1);
+		SHA1_ROUNDS4(E1, E0, MSG3, MSG0, MSG1, MSG2, 1);
+		SHA1_ROUNDS4(E0, E1, MSG0, MSG1, MSG2, MSG3, 1);
+		SHA1_ROUNDS4(E1, E0, MSG1, MSG2, MSG3, MSG0, 1);
+		SHA1_ROUNDS4(E0, E1, MSG2, MSG3, MSG0, MSG1, 2);
+		SHA1_ROUNDS4(E1, E0, MSG3, MSG0, MSG1, MSG2, 2);
+		SHA1_ROUNDS4(E0, E1, MSG0, MSG1, MSG2, MSG3, 2);
+		SHA1_ROUNDS4(E1, E0, MSG1, MSG2, MSG3, MSG0, 2);
+		SHA1_ROUNDS4(E0, E1, MSG2, MSG3, MSG0, MSG1, 2);
+		SHA1_ROUNDS4(E1, E0, MSG3, MSG0, MSG1, MSG2, 3);
+
+		// Rounds 64-67
+		SHA1_ROUNDS4(E0, E1, MSG0, MSG1, MSG2, MSG3, 3);
+
+		// Rounds 68-71
+		E1 = _mm_sha1nexte_epu32(E1, MSG1);
+		E0 = ABCD;
+		MSG2 = _mm_sha1msg2_epu32(MSG2, MSG1);
+		ABCD = _mm_sha1rnds4_epu32(ABCD, E1, 3);
+		MSG3 = _mm_xor_si128(MSG3, MSG1);
+
+		// Rounds 72-75
+		E0 = _mm_sha1nexte_epu32(E0, MSG2);
+		E1 = ABCD;
+		MSG3 = _mm_sha1msg2_epu32(MSG3, MSG2);
+		ABCD = _mm_sha1rnds4_epu32(ABCD, E0, 3);
+
+		// Rounds 76-79
+		E1 = _mm_sha1nexte_epu32(E1, MSG3);
+		E0 = ABCD;
+		ABCD = _mm_sha1rnds4_epu32(ABCD, E1, 3);
+
+		// Add the saved state.
+		E0 = _mm_sha1nexte_epu32(E0, E0_SAVE);
+		ABCD = _mm_add_epi32(ABCD, ABCD_SAVE);
+	}
+
+	// Store the state.
+	ABCD = _mm_shuffle_epi32(ABCD, 0x1B);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(state), ABCD);
+	state[4] = static_cast<uint32_t>(_mm_extract_epi32(E0, 3));
+}
+
+}
@@ -0,0 +1,125 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * datindex_structs.h: Compiled DAT index format structs.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_DATINDEX_STRUCTS_H__
+#define __ROMPROPERTIES_LIBRPBASE_DATINDEX_STRUCTS_H__
+
+#include <stdint.h>
+#include "common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#pragma pack(1)
+
+/**
+ * A DAT index is a compiled form of a Logiqx-format DAT file,
+ * e.g. from No-Intro or Redump. It's designed to be memory-mapped
+ * and searched in place; no parsing is needed when it's opened.
+ *
+ * Layout:
+ * - DatIndex_Header
+ * - DatIndex_Entry[entry_count]
+ * - DatIndex_CrcKey[entry_count], sorted by crc32, then entry_idx
+ * - DatIndex_Sha1Key[sha1_count], sorted by sha1
+ * - DatIndex_SerialKey[serial_count], sorted by serial (strcmp)
+ * - String table: NUL-terminated UTF-8 strings.
+ *   Offset 0 is always an empty string.
+ *
+ * All sections start on an 8-byte boundary.
+ * All fields are in little-endian.
+ */
+
+// Magic number: "RPDATIDX"
+#define DATINDEX_MAGIC "RPDATIDX"
+#define DATINDEX_VERSION 1
+
+/**
+ * DAT index header.
+ * All fields are in little-endian.
+ */
+typedef struct PACKED _DatIndex_Header {
+	char magic[8];			// [0x000] "RPDATIDX"
+	uint32_t version;		// [0x008] DATINDEX_VERSION
+	uint32_t dat_name;		// [0x00C] DAT name (string offset)
+	uint32_t dat_version;		// [0x010] DAT version (string offset)
+	uint32_t entry_count;		// [0x014] Number of entries (also CRC32 keys)
+	uint32_t sha1_count;		// [0x018] Number of SHA-1 keys
+	uint32_t serial_count;		// [0x01C] Number of serial keys
+	uint32_t entry_offset;		// [0x020] DatIndex_Entry[]
+	uint32_t crc_offset;		// [0x024] DatIndex_CrcKey[]
+	uint32_t sha1_offset;		// [0x028] DatIndex_Sha1Key[]
+	uint32_t serial_offset;		// [0x02C] DatIndex_SerialKey[]
+	uint32_t strtbl_offset;		// [0x030] String table
+	uint32_t strtbl_size;		// [0x034] String table size, in bytes
+	uint32_t reserved[2];		// [0x038]
+} DatIndex_Header;
+ASSERT_STRUCT(DatIndex_Header, 64);
+
+/**
+ * DAT index: Entry flags.
+ */
+typedef enum {
+	DATINDEX_FLAG_HAS_CRC32	= (1U << 0),
+	DATINDEX_FLAG_HAS_SHA1	= (1U << 1),
+} DatIndex_Flags_e;
+
+/**
+ * DAT index: ROM entry.
+ * One entry is stored for each <rom> element.
+ * All fields are in little-endian.
+ */
+typedef struct PACKED _DatIndex_Entry {
+	uint64_t size;		// [0x000] ROM size, in bytes
+	uint32_t game_name;	// [0x008] Game name (string offset)
+	uint32_t rom_name;	// [0x00C] ROM filename (string offset)
+	uint32_t serial;	// [0x010] Serial number (string offset; 0 if none)
+	uint32_t crc32;		// [0x014] CRC32
+	uint8_t sha1[20];	// [0x018] SHA-1
+	uint32_t flags;		// [0x02C] Flags (See DatIndex_Flags_e.)
+} DatIndex_Entry;
+ASSERT_STRUCT(DatIndex_Entry, 48);
+
+/**
+ * DAT index: CRC32 key.
+ * All fields are in little-endian.
+ */
+typedef struct PACKED _DatIndex_CrcKey {
+	uint32_t crc32;		// [0x000] CRC32
+	uint32_t entry_idx;	// [0x004] Entry index
+} DatIndex_CrcKey;
+ASSERT_STRUCT(DatIndex_CrcKey, 8);
+
+/**
+ * DAT index: SHA-1 key.
+ * All fields are in little-endian.
+ */
+typedef struct PACKED _DatIndex_Sha1Key {
+	uint8_t sha1[20];	// [0x000] SHA-1
+	uint32_t entry_idx;	// [0x014] Entry index
+} DatIndex_Sha1Key;
+ASSERT_STRUCT(DatIndex_Sha1Key, 24);
+
+/**
+ * DAT index: Serial number key.
+ * All fields are in little-endian.
+ */
+typedef struct PACKED _DatIndex_SerialKey {
+	uint32_t serial;	// [0x000] Serial number (string offset)
+	uint32_t entry_idx;	// [0x004] Entry index
+} DatIndex_SerialKey;
+ASSERT_STRUCT(DatIndex_SerialKey, 8);
+
+#pragma pack()
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_DATINDEX_STRUCTS_H__ */
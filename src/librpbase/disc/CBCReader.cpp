@@ -186,7 +186,7 @@ size_t CBCReader::read(void *ptr, size_t size)
 #endif /* ENABLE_DECRYPTION */
 	{
 		// No encryption. Read directly from the file.
-		size_t sz_read = m_file->seekAndRead(d->offset + d->pos, ptr, size);
+		size_t sz_read = m_file->pread(d->offset + d->pos, ptr, size);
 		if (sz_read != size) {
 			// Seek and/or read error.
 			m_lastError = m_file->lastError();
@@ -217,18 +217,19 @@ size_t CBCReader::read(void *ptr, size_t size)
 	// Total number of bytes read.
 	size_t total_sz_read = 0;
 
+	// Physical address of the next block to read.
+	off64_t phys_pos = d->offset + pos_block;
+
 	// Get the IV.
 	if (pos_block == 0) {
 		// Start of data.
 		// Use the specified IV.
 		memcpy(iv, d->iv, sizeof(iv));
-		m_file->seek(d->offset);
 	} else {
 		// Not start of data.
 		// Read the IV from the previous 16 bytes.
 		// TODO: Cache it!
-		m_file->seek(d->offset + pos_block - 16);
-		size_t sz_read = m_file->read(iv, sizeof(iv));
+		size_t sz_read = m_file->pread(d->offset + pos_block - 16, iv, sizeof(iv));
 		if (sz_read != sizeof(iv)) {
 			// Read error.
 			m_lastError = m_file->lastError();
@@ -253,7 +254,7 @@ size_t CBCReader::read(void *ptr, size_t size)
 		// Read and decrypt the full block, and copy out
 		// the necessary bytes.
 		const size_t sz = std::min(16U - (static_cast<size_t>(d->pos) & 15U), size);
-		size_t sz_read = m_file->read(block_tmp, sizeof(block_tmp));
+		size_t sz_read = m_file->pread(phys_pos, block_tmp, sizeof(block_tmp));
 		if (sz_read != sizeof(block_tmp)) {
 			// Read error.
 			m_lastError = m_file->lastError();
@@ -272,6 +273,7 @@ size_t CBCReader::read(void *ptr, size_t size)
 		}
 
 		memcpy(ptr8, &block_tmp[d->pos & 15], sz);
+		phys_pos += sizeof(block_tmp);
 		ptr8 += sz;
 		size -= sz;
 		total_sz_read += sz;
@@ -281,7 +283,7 @@ size_t CBCReader::read(void *ptr, size_t size)
 	// Read full blocks.
 	size_t full_block_sz = size & ~15LL;
 	if (full_block_sz > 0) {
-		size_t sz_read = m_file->read(ptr8, full_block_sz);
+		size_t sz_read = m_file->pread(phys_pos, ptr8, full_block_sz);
 		if (sz_read != full_block_sz) {
 			// Short read.
 			// Cannot decrypt with a short read.
@@ -300,6 +302,7 @@ size_t CBCReader::read(void *ptr, size_t size)
 			return 0;
 		}
 
+		phys_pos += sz_read;
 		ptr8 += sz_read;
 		size -= sz_read;
 		total_sz_read += sz_read;
@@ -310,7 +313,7 @@ size_t CBCReader::read(void *ptr, size_t size)
 		// We need to decrypt a partial block at the end.
 		// Read and decrypt the full block, and copy out
 		// the necessary bytes.
-		size_t sz_read = m_file->read(block_tmp, sizeof(block_tmp));
+		size_t sz_read = m_file->pread(phys_pos, block_tmp, sizeof(block_tmp));
 		if (sz_read != sizeof(block_tmp)) {
 			// Read error.
 			m_lastError = m_file->lastError();
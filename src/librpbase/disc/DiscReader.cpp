@@ -26,6 +26,7 @@ DiscReader::DiscReader(IRpFile *file)
 	: super(file)
 	, m_offset(0)
 	, m_length(0)
+	, m_readAhead(readAhead_pread, this)
 {
 	if (!m_file) {
 		m_lastError = EBADF;
@@ -51,6 +52,7 @@ DiscReader::DiscReader(IRpFile *file, off64_t offset, off64_t length)
 	: super(file)
 	, m_offset(0)
 	, m_length(0)
+	, m_readAhead(readAhead_pread, this)
 {
 	if (!m_file) {
 		m_lastError = EBADF;
@@ -178,4 +180,80 @@ off64_t DiscReader::size(void)
 	return m_length;
 }
 
+/**
+ * Hint that a range of the disc image will be read soon.
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int DiscReader::prefetch(off64_t pos, size_t size)
+{
+	assert(m_file != nullptr);
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -EBADF;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return -EINVAL;
+	}
+
+	// Constrain size based on offset and length.
+	if (pos >= m_length) {
+		return 0;
+	} else if (pos + static_cast<off64_t>(size) > m_length) {
+		size = static_cast<size_t>(m_length - pos);
+	}
+
+	int ret = m_file->prefetch(m_offset + pos, size);
+	if (ret != 0) {
+		m_lastError = m_file->lastError();
+	}
+	return ret;
+}
+
+/**
+ * Read data from the specified position.
+ * The disc image position is not changed.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t DiscReader::pread(off64_t pos, void *ptr, size_t size)
+{
+	assert(m_file != nullptr);
+	if (!m_file) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
+	}
+
+	// Constrain size based on offset and length.
+	if (pos >= m_length) {
+		return 0;
+	} else if (pos + static_cast<off64_t>(size) > m_length) {
+		size = static_cast<size_t>(m_length - pos);
+	}
+
+	size_t ret = m_readAhead.pread(pos, ptr, size, m_length);
+	m_lastError = m_file->lastError();
+	return ret;
+}
+
+/**
+ * ReadAhead backend read function.
+ * @param userdata	[in] DiscReader.
+ * @param pos		[in] Starting position, relative to m_offset.
+ * @param ptr		[out] Output data buffer.
+ * @param size		[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t DiscReader::readAhead_pread(void *userdata, off64_t pos, void *ptr, size_t size)
+{
+	DiscReader *const q = static_cast<DiscReader*>(userdata);
+	return q->m_file->pread(q->m_offset + pos, ptr, size);
+}
+
 }
@@ -12,6 +12,7 @@
 #define __ROMPROPERTIES_LIBRPBASE_DISCREADER_HPP__
 
 #include "IDiscReader.hpp"
+#include "ReadAhead.hpp"
 
 namespace LibRpBase {
 
@@ -87,10 +88,54 @@ class DiscReader : public IDiscReader
 		 */
 		off64_t size(void) override;
 
+		/**
+		 * Hint that a range of the disc image will be read soon.
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+		 */
+		int prefetch(off64_t pos, size_t size) override;
+
+		/**
+		 * Read data from the specified position.
+		 * The disc image position is not changed.
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t pread(off64_t pos, void *ptr, size_t size) override;
+
+	public:
+		/**
+		 * Get the readahead statistics for pread().
+		 * @return Readahead statistics.
+		 */
+		inline const ReadAhead::Stats &readAheadStats(void) const
+		{
+			return m_readAhead.stats();
+		}
+
+	private:
+		/**
+		 * ReadAhead backend read function.
+		 * @param userdata	[in] DiscReader.
+		 * @param pos		[in] Starting position, relative to m_offset.
+		 * @param ptr		[out] Output data buffer.
+		 * @param size		[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		static size_t readAhead_pread(void *userdata, off64_t pos, void *ptr, size_t size);
+
 	protected:
 		// Offset/length. Useful for e.g. GameCube TGC.
 		off64_t m_offset;
 		off64_t m_length;
+
+		// Readahead for pread().
+		// NOTE: read() uses the file position, which is
+		// already buffered by the underlying IRpFile.
+		ReadAhead m_readAhead;
 };
 
 }
@@ -11,6 +11,7 @@
 
 // librpfile
 using LibRpFile::IRpFile;
+using LibRpFile::IoVec;
 
 namespace LibRpBase {
 
@@ -56,6 +57,82 @@ bool IDiscReader::isOpen(void) const
 	}
 }
 
+/**
+ * Hint that a range of the disc image will be read soon.
+ *
+ * Default implementation: Hints are ignored, since the
+ * mapping to the underlying file is subclass-specific.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int IDiscReader::prefetch(off64_t pos, size_t size)
+{
+	RP_UNUSED(pos);
+	RP_UNUSED(size);
+	return 0;
+}
+
+/**
+ * Read data from the specified position.
+ *
+ * Default implementation: Save the disc image position,
+ * seek and read, then restore the disc image position.
+ *
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t IDiscReader::pread(off64_t pos, void *ptr, size_t size)
+{
+	const off64_t cur_pos = this->tell();
+	if (cur_pos < 0) {
+		// Unable to get the current position.
+		return 0;
+	}
+
+	size_t ret = 0;
+	if (this->seek(pos) == 0) {
+		ret = this->read(ptr, size);
+	}
+
+	// Restore the disc image position.
+	// NOTE: Don't let seek() overwrite the read error.
+	const int lastError = m_lastError;
+	this->seek(cur_pos);
+	m_lastError = lastError;
+	return ret;
+}
+
+/**
+ * Read data from the specified position into multiple buffers.
+ *
+ * Default implementation: Call pread() for each buffer.
+ *
+ * @param pos	[in] Starting position.
+ * @param iov	[in] Output buffers.
+ * @param iovcnt [in] Number of output buffers.
+ * @return Total number of bytes read.
+ */
+size_t IDiscReader::preadv(off64_t pos, const IoVec *iov, int iovcnt)
+{
+	size_t ret = 0;
+	for (; iovcnt > 0; iovcnt--, iov++) {
+		if (iov->size == 0)
+			continue;
+
+		const size_t sz_read = this->pread(pos + ret, iov->ptr, iov->size);
+		ret += sz_read;
+		if (sz_read != iov->size) {
+			// Short read.
+			break;
+		}
+	}
+	return ret;
+}
+
 /**
  * Seek to the specified address, then read data.
  * @param pos	[in] Requested seek address.
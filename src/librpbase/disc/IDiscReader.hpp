@@ -19,6 +19,7 @@
 
 namespace LibRpFile {
 	class IRpFile;
+	struct IoVec;
 }
 
 namespace LibRpBase {
@@ -106,6 +107,54 @@ class IDiscReader
 		 */
 		virtual off64_t size(void) = 0;
 
+		/**
+		 * Hint that a range of the disc image will be read soon.
+		 *
+		 * The range is translated to the underlying file's
+		 * physical layout and passed down to IRpFile::prefetch().
+		 * This is only a hint; the disc image position is not
+		 * changed, and subclasses may ignore it entirely.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+		 */
+		virtual int prefetch(off64_t pos, size_t size);
+
+		/**
+		 * Read data from the specified position.
+		 *
+		 * Unlike seekAndRead(), the disc image position is not
+		 * changed, so the underlying file can be shared with
+		 * other readers.
+		 *
+		 * The default implementation saves the disc image position,
+		 * does a seek and read, and then restores the position.
+		 * Subclasses should override this with a native version.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		virtual size_t pread(off64_t pos, void *ptr, size_t size);
+
+		/**
+		 * Read data from the specified position into multiple buffers.
+		 *
+		 * The buffers are filled in order, starting at pos.
+		 * Reading stops at the first short read.
+		 * The disc image position is not changed.
+		 *
+		 * The default implementation calls pread() for each buffer.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param iov	[in] Output buffers.
+		 * @param iovcnt [in] Number of output buffers.
+		 * @return Total number of bytes read.
+		 */
+		virtual size_t preadv(off64_t pos, const LibRpFile::IoVec *iov, int iovcnt);
+
 	public:
 		/** Convenience functions implemented for all IRpFile classes. **/
 
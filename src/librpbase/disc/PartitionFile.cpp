@@ -28,6 +28,7 @@ PartitionFile::PartitionFile(IDiscReader *partition, off64_t offset, off64_t siz
 	, m_offset(offset)
 	, m_size(size)
 	, m_pos(0)
+	, m_readAhead(readAhead_pread, this)
 {
 	if (!partition) {
 		m_lastError = EBADF;
@@ -52,6 +53,7 @@ bool PartitionFile::isOpen(void) const
 void PartitionFile::close(void)
 {
 	m_partition = nullptr;
+	m_readAhead.setMaxWindow(0);
 }
 
 /**
@@ -62,38 +64,8 @@ void PartitionFile::close(void)
  */
 size_t PartitionFile::read(void *ptr, size_t size)
 {
-	if (!m_partition) {
-		m_lastError = EBADF;
-		return 0;
-	}
-
-	// Check if size is in bounds.
-	if (m_pos > m_size - static_cast<off64_t>(size)) {
-		// Not enough data.
-		// Copy whatever's left in the file.
-		size = static_cast<size_t>(m_size - m_pos);
-		if (size == 0) {
-			// Nothing left.
-			// TODO: Set an error?
-			return 0;
-		}
-	}
-
-	m_partition->clearError();
-	int iRet = m_partition->seek(m_offset + m_pos);
-	if (iRet != 0) {
-		m_lastError = m_partition->lastError();
-		return 0;
-	}
-
-	size_t ret = 0;
-	if (size > 0) {
-		m_partition->clearError();
-		ret = m_partition->read(ptr, size);
-		m_pos += ret;
-		m_lastError = m_partition->lastError();
-	}
-
+	const size_t ret = this->pread(m_pos, ptr, size);
+	m_pos += ret;
 	return ret;
 }
 
@@ -189,4 +161,84 @@ string PartitionFile::filename(void) const
 	return string();
 }
 
+/**
+ * Hint that a range of the file will be read soon.
+ * This is forwarded to the underlying IPartition.
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int PartitionFile::prefetch(off64_t pos, size_t size)
+{
+	if (!m_partition) {
+		m_lastError = EBADF;
+		return -EBADF;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return -EINVAL;
+	}
+
+	// Constrain size to the file size.
+	if (pos >= m_size) {
+		return 0;
+	} else if (pos + static_cast<off64_t>(size) > m_size) {
+		size = static_cast<size_t>(m_size - pos);
+	}
+
+	int ret = m_partition->prefetch(m_offset + pos, size);
+	if (ret != 0) {
+		m_lastError = m_partition->lastError();
+	}
+	return ret;
+}
+
+/**
+ * Read data from the specified position.
+ * The file position is not changed.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t PartitionFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	if (!m_partition) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
+	}
+
+	// Constrain size to the file size.
+	if (pos >= m_size) {
+		// Nothing left.
+		// TODO: Set an error?
+		return 0;
+	} else if (pos + static_cast<off64_t>(size) > m_size) {
+		// Not enough data.
+		// Copy whatever's left in the file.
+		size = static_cast<size_t>(m_size - pos);
+	}
+
+	m_partition->clearError();
+	size_t ret = m_readAhead.pread(pos, ptr, size, m_size);
+	m_lastError = m_partition->lastError();
+	return ret;
+}
+
+/**
+ * ReadAhead backend read function.
+ * @param userdata	[in] PartitionFile.
+ * @param pos		[in] Starting position, relative to m_offset.
+ * @param ptr		[out] Output data buffer.
+ * @param size		[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t PartitionFile::readAhead_pread(void *userdata, off64_t pos, void *ptr, size_t size)
+{
+	PartitionFile *const q = static_cast<PartitionFile*>(userdata);
+	return q->m_partition->pread(q->m_offset + pos, ptr, size);
+}
+
 }
@@ -10,6 +10,7 @@
 #define __ROMPROPERTIES_LIBRPBASE_DISC_PARTITIONFILE_HPP__
 
 #include "librpfile/IRpFile.hpp"
+#include "ReadAhead.hpp"
 
 namespace LibRpBase {
 
@@ -98,11 +99,56 @@ class PartitionFile : public LibRpFile::IRpFile
 		 */
 		std::string filename(void) const final;
 
+	public:
+		/**
+		 * Hint that a range of the file will be read soon.
+		 * This is forwarded to the underlying IPartition.
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+		 */
+		int prefetch(off64_t pos, size_t size) final;
+
+		/**
+		 * Read data from the specified position.
+		 * This is forwarded to the underlying IPartition.
+		 * The file position is not changed.
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t pread(off64_t pos, void *ptr, size_t size) final;
+
+	public:
+		/**
+		 * Get the readahead statistics.
+		 * @return Readahead statistics.
+		 */
+		inline const ReadAhead::Stats &readAheadStats(void) const
+		{
+			return m_readAhead.stats();
+		}
+
+	private:
+		/**
+		 * ReadAhead backend read function.
+		 * @param userdata	[in] PartitionFile.
+		 * @param pos		[in] Starting position, relative to m_offset.
+		 * @param ptr		[out] Output data buffer.
+		 * @param size		[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		static size_t readAhead_pread(void *userdata, off64_t pos, void *ptr, size_t size);
+
 	protected:
 		IDiscReader *m_partition;
 		off64_t m_offset;	// File starting offset.
 		off64_t m_size;		// File size.
 		off64_t m_pos;		// Current position.
+
+		// Readahead for read() and pread().
+		ReadAhead m_readAhead;
 };
 
 }
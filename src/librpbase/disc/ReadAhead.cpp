@@ -0,0 +1,178 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * ReadAhead.cpp: Adaptive readahead policy for disc readers.              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ReadAhead.hpp"
+#include "librpthreads/Profiler.hpp"
+
+// C++ includes.
+#include <algorithm>
+
+namespace LibRpBase {
+
+// Static constants.
+const size_t ReadAhead::MIN_WINDOW;
+const size_t ReadAhead::DEFAULT_MAX_WINDOW;
+const unsigned int ReadAhead::SEQ_THRESHOLD;
+
+/**
+ * Create a ReadAhead object.
+ * @param pfnPread	[in] Backend read function.
+ * @param userdata	[in] User data for pfnPread.
+ * @param maxWindow	[in] Maximum readahead window, in bytes. (0 to disable readahead)
+ */
+ReadAhead::ReadAhead(PreadFn pfnPread, void *userdata, size_t maxWindow)
+	: m_pfnPread(pfnPread)
+	, m_userdata(userdata)
+	, m_maxWindow(maxWindow)
+	, m_window(0)
+	, m_seqCount(0)
+	, m_nextPos(-1)
+	, m_bufAlloc(0)
+	, m_bufPos(0)
+	, m_bufLen(0)
+{
+	assert(pfnPread != nullptr);
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+/**
+ * Read data from the backend.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t ReadAhead::backendRead(off64_t pos, void *ptr, size_t size)
+{
+	RP_PROFILE_SCOPE_BYTES(STAGE_DISC_IO, size);
+	const size_t ret = m_pfnPread(m_userdata, pos, ptr, size);
+	m_stats.ioCount++;
+	m_stats.ioBytes += ret;
+	if (ret > m_stats.ioMax) {
+		m_stats.ioMax = ret;
+	}
+	return ret;
+}
+
+/**
+ * Read data from the specified position.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @param limit	[in] End of the readable data. Readahead won't go past this point.
+ * @return Number of bytes read.
+ */
+size_t ReadAhead::pread(off64_t pos, void *ptr, size_t size, off64_t limit)
+{
+	assert(pos >= 0);
+	m_stats.requests++;
+	m_stats.requestBytes += size;
+	if (size == 0) {
+		return 0;
+	}
+
+	const bool inBuffer = (m_bufLen > 0 && pos >= m_bufPos &&
+		pos < m_bufPos + static_cast<off64_t>(m_bufLen));
+
+	// Update the access pattern.
+	if (pos == m_nextPos) {
+		if (m_seqCount < SEQ_THRESHOLD) {
+			m_seqCount++;
+		}
+	} else if (!inBuffer) {
+		// Random access. Back off.
+		m_seqCount = 0;
+		m_window = 0;
+	}
+
+	const off64_t startPos = pos;
+	uint8_t *p = static_cast<uint8_t*>(ptr);
+	size_t total = 0;
+
+	if (inBuffer) {
+		// Copy as much as possible from the buffer.
+		const size_t bufOffset = static_cast<size_t>(pos - m_bufPos);
+		const size_t n = std::min(size, m_bufLen - bufOffset);
+		memcpy(p, &m_buf[bufOffset], n);
+		m_stats.bufferBytes += n;
+		total = n;
+		p += n;
+		pos += n;
+		size -= n;
+	}
+
+	if (size > 0) {
+		if (m_seqCount >= SEQ_THRESHOLD && m_maxWindow > 0) {
+			// Sequential stream. Grow the window.
+			m_window = (m_window == 0 ? MIN_WINDOW : m_window * 2);
+			if (m_window > m_maxWindow) {
+				m_window = m_maxWindow;
+			}
+		}
+
+		size_t fill = m_window;
+		if (fill > 0 && pos + static_cast<off64_t>(fill) > limit) {
+			fill = (pos < limit ? static_cast<size_t>(limit - pos) : 0);
+		}
+
+		if (size >= fill) {
+			// Not sequential, or the request is at least as large
+			// as the window. Read directly into the caller's buffer.
+			total += backendRead(pos, p, size);
+		} else {
+			// Refill the readahead buffer.
+			if (m_bufAlloc < m_window) {
+				m_buf.reset(new uint8_t[m_window]);
+				m_bufAlloc = m_window;
+			}
+			m_bufPos = pos;
+			m_bufLen = backendRead(pos, m_buf.get(), fill);
+
+			const size_t n = std::min(size, m_bufLen);
+			memcpy(p, m_buf.get(), n);
+			m_stats.bufferBytes += n;
+			total += n;
+		}
+	}
+
+	m_nextPos = startPos + static_cast<off64_t>(total);
+	return total;
+}
+
+/**
+ * Discard the readahead buffer and reset the access pattern.
+ */
+void ReadAhead::invalidate(void)
+{
+	m_window = 0;
+	m_seqCount = 0;
+	m_nextPos = -1;
+	m_bufPos = 0;
+	m_bufLen = 0;
+}
+
+/**
+ * Set the maximum readahead window.
+ * @param maxWindow Maximum readahead window, in bytes. (0 to disable readahead)
+ */
+void ReadAhead::setMaxWindow(size_t maxWindow)
+{
+	m_maxWindow = maxWindow;
+	if (m_window > maxWindow) {
+		m_window = maxWindow;
+	}
+	if (maxWindow == 0) {
+		// Readahead is disabled. Free the buffer.
+		invalidate();
+		m_buf.reset();
+		m_bufAlloc = 0;
+	}
+}
+
+}
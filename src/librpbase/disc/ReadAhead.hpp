@@ -0,0 +1,159 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * ReadAhead.hpp: Adaptive readahead policy for disc readers.              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_DISC_READAHEAD_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_DISC_READAHEAD_HPP__
+
+#include "common.h"
+#include "librpfile/IRpFile.hpp"
+
+// C includes.
+#include <stdint.h>
+
+// C++ includes.
+#include <memory>
+
+namespace LibRpBase {
+
+/**
+ * Adaptive readahead for positional reads.
+ *
+ * Each reader owns a ReadAhead object and sends its pread()
+ * calls through it. Forward-sequential reads are detected,
+ * and once a stream is sequential, small reads are serviced
+ * from a buffer that's filled using a readahead window.
+ * The window doubles on every refill, up to a maximum size.
+ * A read that isn't sequential resets the window, so random
+ * access goes straight to the backend.
+ *
+ * Reads that are at least as large as the current window
+ * bypass the buffer entirely.
+ *
+ * NOTE: The backend must be read-only, since the buffer
+ * isn't invalidated by writes.
+ *
+ * NOTE: This class is not thread-safe, same as the readers
+ * that use it.
+ */
+class ReadAhead
+{
+	public:
+		/**
+		 * Backend read function.
+		 * @param userdata	[in] User data specified in the constructor.
+		 * @param pos		[in] Starting position.
+		 * @param ptr		[out] Output data buffer.
+		 * @param size		[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		typedef size_t (*PreadFn)(void *userdata, off64_t pos, void *ptr, size_t size);
+
+		/**
+		 * Create a ReadAhead object.
+		 * @param pfnPread	[in] Backend read function.
+		 * @param userdata	[in] User data for pfnPread.
+		 * @param maxWindow	[in] Maximum readahead window, in bytes. (0 to disable readahead)
+		 */
+		ReadAhead(PreadFn pfnPread, void *userdata, size_t maxWindow = DEFAULT_MAX_WINDOW);
+
+	private:
+		RP_DISABLE_COPY(ReadAhead)
+
+	public:
+		// Initial readahead window.
+		static const size_t MIN_WINDOW = 16U * 1024U;
+		// Default maximum readahead window.
+		static const size_t DEFAULT_MAX_WINDOW = 256U * 1024U;
+		// Number of sequential reads before readahead is started.
+		static const unsigned int SEQ_THRESHOLD = 2;
+
+		/**
+		 * Readahead statistics.
+		 * The effective I/O size is ioBytes / ioCount.
+		 */
+		struct Stats {
+			uint64_t requests;	// Number of pread() requests.
+			uint64_t requestBytes;	// Number of bytes requested.
+			uint64_t bufferBytes;	// Number of bytes copied from the readahead buffer.
+			uint64_t ioCount;	// Number of backend reads.
+			uint64_t ioBytes;	// Number of bytes read from the backend.
+			size_t ioMax;		// Largest backend read, in bytes.
+		};
+
+	public:
+		/**
+		 * Read data from the specified position.
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @param limit	[in] End of the readable data. Readahead won't go past this point.
+		 * @return Number of bytes read.
+		 */
+		size_t pread(off64_t pos, void *ptr, size_t size, off64_t limit);
+
+		/**
+		 * Discard the readahead buffer and reset the access pattern.
+		 */
+		void invalidate(void);
+
+		/**
+		 * Set the maximum readahead window.
+		 * @param maxWindow Maximum readahead window, in bytes. (0 to disable readahead)
+		 */
+		void setMaxWindow(size_t maxWindow);
+
+		/**
+		 * Get the current readahead window.
+		 * @return Current readahead window, in bytes. (0 if the stream isn't sequential)
+		 */
+		inline size_t window(void) const
+		{
+			return m_window;
+		}
+
+		/**
+		 * Get the readahead statistics.
+		 * @return Readahead statistics.
+		 */
+		inline const Stats &stats(void) const
+		{
+			return m_stats;
+		}
+
+	private:
+		/**
+		 * Read data from the backend.
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t backendRead(off64_t pos, void *ptr, size_t size);
+
+	private:
+		PreadFn m_pfnPread;
+		void *m_userdata;
+
+		size_t m_maxWindow;	// Maximum readahead window.
+		size_t m_window;	// Current readahead window. (0 == not sequential)
+		unsigned int m_seqCount;// Number of consecutive sequential reads.
+		off64_t m_nextPos;	// Expected position of the next sequential read.
+
+		// Readahead buffer.
+		// Allocated on first use, and only grows.
+		std::unique_ptr<uint8_t[]> m_buf;
+		size_t m_bufAlloc;	// Allocated size.
+		off64_t m_bufPos;	// Position of m_buf[0].
+		size_t m_bufLen;	// Number of valid bytes.
+
+		Stats m_stats;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_DISC_READAHEAD_HPP__ */
@@ -53,88 +53,15 @@ SparseDiscReader::~SparseDiscReader()
 size_t SparseDiscReader::read(void *ptr, size_t size)
 {
 	RP_D(SparseDiscReader);
-	assert(m_file != nullptr);
-	assert(d->disc_size > 0);
 	assert(d->pos >= 0);
-	assert(d->block_size != 0);
-	if (!m_file || d->disc_size <= 0 || d->pos < 0 || d->block_size == 0) {
+	if (d->pos < 0) {
 		// Disc image wasn't initialized properly.
 		m_lastError = EBADF;
-		return -1;
-	}
-
-	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
-	size_t ret = 0;
-
-	// Are we already at the end of the disc?
-	if (d->pos >= d->disc_size) {
-		// End of the disc.
 		return 0;
 	}
 
-	// Make sure d->pos + size <= d->disc_size.
-	// If it isn't, we'll do a short read.
-	if (d->pos + static_cast<off64_t>(size) >= d->disc_size) {
-		size = static_cast<size_t>(d->disc_size - d->pos);
-	}
-
-	// Check if we're not starting on a block boundary.
-	const uint32_t block_size = d->block_size;
-	const uint32_t blockStartOffset = d->pos % block_size;
-	if (blockStartOffset != 0) {
-		// Not a block boundary.
-		// Read the end of the block.
-		uint32_t read_sz = block_size - blockStartOffset;
-		if (size < static_cast<size_t>(read_sz)) {
-			read_sz = static_cast<uint32_t>(size);
-		}
-
-		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
-		int rd = this->readBlock(blockIdx, ptr8, blockStartOffset, read_sz);
-		if (rd < 0 || rd != static_cast<int>(read_sz)) {
-			// Error reading the data.
-			return (rd > 0 ? rd : 0);
-		}
-
-		// Starting block read.
-		size -= read_sz;
-		ptr8 += read_sz;
-		ret += read_sz;
-		d->pos += read_sz;
-	}
-
-	// Read entire blocks.
-	for (; size >= block_size;
-	    size -= block_size, ptr8 += block_size,
-	    ret += block_size, d->pos += block_size)
-	{
-		assert(d->pos % block_size == 0);
-		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
-		int rd = this->readBlock(blockIdx, ptr8, 0, block_size);
-		if (rd < 0 || rd != static_cast<int>(block_size)) {
-			// Error reading the data.
-			return ret + (rd > 0 ? rd : 0);
-		}
-	}
-
-	// Check if we still have data left. (not a full block)
-	if (size > 0) {
-		// Not a full block.
-		assert(d->pos % block_size == 0);
-
-		// Read the start of the block.
-		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
-		int rd = this->readBlock(blockIdx, ptr8, 0, size);
-		if (rd < 0 || rd != static_cast<int>(size)) {
-			// Error reading the data.
-			return ret + (rd > 0 ? rd : 0);
-		}
-
-		ret += size;
-		d->pos += size;
-	}
-
-	// Finished reading the data.
+	const size_t ret = this->pread(d->pos, ptr, size);
+	d->pos += ret;
 	return ret;
 }
 
@@ -209,6 +136,175 @@ off64_t SparseDiscReader::size(void)
 	return d->disc_size;
 }
 
+/**
+ * Hint that a range of the disc image will be read soon.
+ *
+ * The range is mapped to physical blocks using getPhysBlockAddr().
+ * Physically contiguous blocks are merged into a single hint.
+ * Subclasses that override readBlock() should override this too.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int SparseDiscReader::prefetch(off64_t pos, size_t size)
+{
+	RP_D(const SparseDiscReader);
+	assert(m_file != nullptr);
+	if (!m_file || d->disc_size <= 0 || d->block_size == 0) {
+		// Disc image wasn't initialized properly.
+		m_lastError = EBADF;
+		return -EBADF;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return -EINVAL;
+	}
+
+	if (pos >= d->disc_size || size == 0) {
+		// Nothing to prefetch.
+		return 0;
+	} else if (pos + static_cast<off64_t>(size) > d->disc_size) {
+		size = static_cast<size_t>(d->disc_size - pos);
+	}
+
+	const uint32_t block_size = d->block_size;
+	const uint32_t blockStart = static_cast<uint32_t>(pos / block_size);
+	const uint32_t blockEnd = static_cast<uint32_t>((pos + size - 1) / block_size);
+
+	// Current run of physically contiguous blocks.
+	// NOTE: Small gaps between blocks (e.g. 2352-byte sectors
+	// with 2048 bytes of user data) are included in the run.
+	off64_t runStart = -1, runEnd = -1;
+	for (uint32_t blockIdx = blockStart; blockIdx <= blockEnd; blockIdx++) {
+		const off64_t physBlockAddr = getPhysBlockAddr(blockIdx);
+		if (physBlockAddr <= 0) {
+			// Empty block or invalid block index.
+			continue;
+		}
+
+		if (runStart >= 0 && physBlockAddr >= runEnd &&
+		    physBlockAddr <= runEnd + static_cast<off64_t>(block_size))
+		{
+			// Extend the current run.
+			runEnd = physBlockAddr + block_size;
+			continue;
+		}
+
+		// Start a new run.
+		if (runStart >= 0) {
+			m_file->prefetch(runStart, static_cast<size_t>(runEnd - runStart));
+		}
+		runStart = physBlockAddr;
+		runEnd = physBlockAddr + block_size;
+	}
+
+	if (runStart >= 0) {
+		int ret = m_file->prefetch(runStart, static_cast<size_t>(runEnd - runStart));
+		if (ret != 0) {
+			m_lastError = m_file->lastError();
+			return ret;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Read data from the specified position.
+ * The disc image position is not changed.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t SparseDiscReader::pread(off64_t pos, void *ptr, size_t size)
+{
+	RP_D(const SparseDiscReader);
+	assert(m_file != nullptr);
+	assert(d->disc_size > 0);
+	assert(d->block_size != 0);
+	if (!m_file || d->disc_size <= 0 || d->block_size == 0) {
+		// Disc image wasn't initialized properly.
+		m_lastError = EBADF;
+		return 0;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
+	}
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t ret = 0;
+
+	// Are we already at the end of the disc?
+	if (pos >= d->disc_size) {
+		// End of the disc.
+		return 0;
+	}
+
+	// Make sure pos + size <= d->disc_size.
+	// If it isn't, we'll do a short read.
+	if (pos + static_cast<off64_t>(size) >= d->disc_size) {
+		size = static_cast<size_t>(d->disc_size - pos);
+	}
+
+	// Check if we're not starting on a block boundary.
+	const uint32_t block_size = d->block_size;
+	const uint32_t blockStartOffset = pos % block_size;
+	if (blockStartOffset != 0) {
+		// Not a block boundary.
+		// Read the end of the block.
+		uint32_t read_sz = block_size - blockStartOffset;
+		if (size < static_cast<size_t>(read_sz)) {
+			read_sz = static_cast<uint32_t>(size);
+		}
+
+		const unsigned int blockIdx = static_cast<unsigned int>(pos / block_size);
+		int rd = this->readBlock(blockIdx, ptr8, blockStartOffset, read_sz);
+		if (rd < 0 || rd != static_cast<int>(read_sz)) {
+			// Error reading the data.
+			return (rd > 0 ? rd : 0);
+		}
+
+		// Starting block read.
+		size -= read_sz;
+		ptr8 += read_sz;
+		ret += read_sz;
+		pos += read_sz;
+	}
+
+	// Read entire blocks.
+	for (; size >= block_size;
+	    size -= block_size, ptr8 += block_size,
+	    ret += block_size, pos += block_size)
+	{
+		assert(pos % block_size == 0);
+		const unsigned int blockIdx = static_cast<unsigned int>(pos / block_size);
+		int rd = this->readBlock(blockIdx, ptr8, 0, block_size);
+		if (rd < 0 || rd != static_cast<int>(block_size)) {
+			// Error reading the data.
+			return ret + (rd > 0 ? rd : 0);
+		}
+	}
+
+	// Check if we still have data left. (not a full block)
+	if (size > 0) {
+		// Not a full block.
+		assert(pos % block_size == 0);
+
+		// Read the start of the block.
+		const unsigned int blockIdx = static_cast<unsigned int>(pos / block_size);
+		int rd = this->readBlock(blockIdx, ptr8, 0, size);
+		if (rd < 0 || rd != static_cast<int>(size)) {
+			// Error reading the data.
+			return ret + (rd > 0 ? rd : 0);
+		}
+
+		ret += size;
+	}
+
+	// Finished reading the data.
+	return ret;
+}
+
 /** SparseDiscReader **/
 
 /**
@@ -258,7 +354,7 @@ int SparseDiscReader::readBlock(uint32_t blockIdx, void *ptr, int pos, size_t si
 	}
 
 	// Read from the block.
-	size_t sz_read = m_file->seekAndRead(physBlockAddr + pos, ptr, size);
+	size_t sz_read = m_file->pread(physBlockAddr + pos, ptr, size);
 	m_lastError = m_file->lastError();
 	return (sz_read > 0 ? (int)sz_read : -1);
 }
@@ -59,6 +59,29 @@ class SparseDiscReader : public IDiscReader
 		 */
 		off64_t size(void) final;
 
+		/**
+		 * Hint that a range of the disc image will be read soon.
+		 *
+		 * The range is mapped to physical blocks using getPhysBlockAddr().
+		 * Physically contiguous blocks are merged into a single hint.
+		 * Subclasses that override readBlock() should override this too.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+		 */
+		int prefetch(off64_t pos, size_t size) override;
+
+		/**
+		 * Read data from the specified position.
+		 * The disc image position is not changed.
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t pread(off64_t pos, void *ptr, size_t size) override;
+
 	protected:
 		/** Virtual functions for SparseDiscReader subclasses. **/
 
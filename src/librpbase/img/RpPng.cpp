@@ -53,12 +53,13 @@ using std::unique_ptr;
 # endif
 #endif /* !PNGCAPI */
 
+// zlib: crc32()
+#include <zlib.h>
+
 // pngcheck()
 #include "pngcheck/pngcheck.hpp"
 
 #if defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL))
-// Need zlib for delay-load checks.
-#include <zlib.h>
 // MSVC: Exception handling for /DELAYLOAD.
 #include "libwin32common/DelayLoadHelper.h"
 #endif /* defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL)) */
@@ -586,6 +587,109 @@ rp_image *RpPng::load(IRpFile *file)
 	return loadUnchecked(file);
 }
 
+/**
+ * Read an unaligned big-endian 32-bit value.
+ * @param p Pointer to the value.
+ * @return Value.
+ */
+static inline uint32_t read_be32(const uint8_t *p)
+{
+	return (static_cast<uint32_t>(p[0]) << 24) |
+	       (static_cast<uint32_t>(p[1]) << 16) |
+	       (static_cast<uint32_t>(p[2]) <<  8) |
+	        static_cast<uint32_t>(p[3]);
+}
+
+/**
+ * Verify the chunk layout of an in-memory PNG image.
+ *
+ * This checks the PNG signature, the IHDR chunk, chunk
+ * lengths and CRCs, and the IEND chunk. The image data
+ * is *not* decompressed, so this is much faster than
+ * load(), but it does not verify the IDAT contents.
+ *
+ * @param data		[in] PNG image data.
+ * @param size		[in] Size of data.
+ * @param pWidth	[out,opt] Image width.
+ * @param pHeight	[out,opt] Image height.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpPng::verifyChunks(const uint8_t *data, size_t size, int *pWidth, int *pHeight)
+{
+	static const uint8_t png_magic[8] = {0x89, 'P','N','G', '\r','\n', 0x1A, '\n'};
+	assert(data != nullptr);
+	if (!data || size < sizeof(png_magic) + (12+13) + 12) {
+		// Too small to be a PNG image.
+		// (signature, IHDR, IEND)
+		return -EINVAL;
+	}
+
+#if defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL))
+	// Delay load verification.
+	// TODO: Only if linked with /DELAYLOAD?
+	if (DelayLoad_test_zlib_and_png() != 0) {
+		// Delay load failed.
+		return -ENOTSUP;
+	}
+#endif /* defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL)) */
+
+	if (memcmp(data, png_magic, sizeof(png_magic)) != 0) {
+		// Not a PNG image.
+		return -EINVAL;
+	}
+
+	// Check the chunks.
+	const uint8_t *p = data + sizeof(png_magic);
+	const uint8_t *const p_end = data + size;
+	bool isFirst = true;
+	while (p_end - p >= 12) {
+		const uint32_t chunk_size = read_be32(p);
+		if (chunk_size > 0x7FFFFFFFU || chunk_size > static_cast<size_t>(p_end - p - 12)) {
+			// Chunk is out of bounds.
+			return -EIO;
+		}
+		const uint8_t *const chunk_name = p + 4;
+		const uint8_t *const chunk_data = p + 8;
+
+		// CRC32 covers the chunk name and data.
+		const uint32_t crc_expected = read_be32(chunk_data + chunk_size);
+		const uint32_t crc_actual = crc32(crc32(0, nullptr, 0), chunk_name, 4 + chunk_size);
+		if (crc_actual != crc_expected) {
+			// CRC mismatch.
+			return -EIO;
+		}
+
+		if (isFirst) {
+			// First chunk must be IHDR.
+			if (memcmp(chunk_name, "IHDR", 4) != 0 || chunk_size != 13) {
+				return -EIO;
+			}
+			const uint32_t width = read_be32(chunk_data);
+			const uint32_t height = read_be32(chunk_data + 4);
+			if (width == 0 || height == 0 || width > 0x7FFFFFFFU || height > 0x7FFFFFFFU) {
+				// Invalid image dimensions.
+				return -EIO;
+			}
+			if (pWidth) {
+				*pWidth = static_cast<int>(width);
+			}
+			if (pHeight) {
+				*pHeight = static_cast<int>(height);
+			}
+			isFirst = false;
+		} else if (!memcmp(chunk_name, "IEND", 4)) {
+			// End of image.
+			return (chunk_size == 0 ? 0 : -EIO);
+		}
+
+		// Next chunk.
+		p = chunk_data + chunk_size + 4;
+	}
+
+	// IEND was not found.
+	return -EIO;
+}
+
 /**
  * Save an image in PNG format to an IRpFile.
  * IRpFile must be open for writing.
@@ -595,9 +699,10 @@ rp_image *RpPng::load(IRpFile *file)
  *
  * @param file IRpFile to write to.
  * @param img rp_image to save.
+ * @param profile Encoding profile.
  * @return 0 on success; negative POSIX error code on error.
  */
-int RpPng::save(IRpFile *file, const rp_image *img)
+int RpPng::save(IRpFile *file, const rp_image *img, RpPngWriter::Profile profile)
 {
 	assert(file != nullptr);
 	assert(img != nullptr);
@@ -609,8 +714,13 @@ int RpPng::save(IRpFile *file, const rp_image *img)
 	if (!pngWriter->isOpen())
 		return -pngWriter->lastError();
 
+	// Set the encoding profile.
+	int ret = pngWriter->setProfile(profile);
+	if (ret != 0)
+		return ret;
+
 	// Write the PNG IHDR.
-	int ret = pngWriter->write_IHDR();
+	ret = pngWriter->write_IHDR();
 	if (ret != 0)
 		return ret;
 
@@ -623,9 +733,10 @@ int RpPng::save(IRpFile *file, const rp_image *img)
  *
  * @param filename Destination filename.
  * @param img rp_image to save.
+ * @param profile Encoding profile.
  * @return 0 on success; negative POSIX error code on error.
  */
-int RpPng::save(const char *filename, const rp_image *img)
+int RpPng::save(const char *filename, const rp_image *img, RpPngWriter::Profile profile)
 {
 	assert(filename != nullptr);
 	assert(filename[0] != 0);
@@ -638,8 +749,13 @@ int RpPng::save(const char *filename, const rp_image *img)
 	if (!pngWriter->isOpen())
 		return -pngWriter->lastError();
 
+	// Set the encoding profile.
+	int ret = pngWriter->setProfile(profile);
+	if (ret != 0)
+		return ret;
+
 	// Write the PNG IHDR.
-	int ret = pngWriter->write_IHDR();
+	ret = pngWriter->write_IHDR();
 	if (ret != 0)
 		return ret;
 
@@ -664,9 +780,10 @@ int RpPng::save(const char *filename, const rp_image *img)
  *
  * @param file IRpFile to write to.
  * @param iconAnimData Animated image data to save.
+ * @param profile Encoding profile.
  * @return 0 on success; negative POSIX error code on error.
  */
-int RpPng::save(IRpFile *file, const IconAnimData *iconAnimData)
+int RpPng::save(IRpFile *file, const IconAnimData *iconAnimData, RpPngWriter::Profile profile)
 {
 	assert(file != nullptr);
 	assert(iconAnimData != nullptr);
@@ -678,8 +795,13 @@ int RpPng::save(IRpFile *file, const IconAnimData *iconAnimData)
 	if (!pngWriter->isOpen())
 		return -pngWriter->lastError();
 
+	// Set the encoding profile.
+	int ret = pngWriter->setProfile(profile);
+	if (ret != 0)
+		return ret;
+
 	// Write the PNG IHDR.
-	int ret = pngWriter->write_IHDR();
+	ret = pngWriter->write_IHDR();
 	if (ret != 0)
 		return ret;
 
@@ -701,9 +823,10 @@ int RpPng::save(IRpFile *file, const IconAnimData *iconAnimData)
  *
  * @param filename Destination filename.
  * @param iconAnimData Animated image data to save.
+ * @param profile Encoding profile.
  * @return 0 on success; negative POSIX error code on error.
  */
-int RpPng::save(const char *filename, const IconAnimData *iconAnimData)
+int RpPng::save(const char *filename, const IconAnimData *iconAnimData, RpPngWriter::Profile profile)
 {
 	assert(filename != nullptr);
 	assert(filename[0] != 0);
@@ -716,8 +839,13 @@ int RpPng::save(const char *filename, const IconAnimData *iconAnimData)
 	if (!pngWriter->isOpen())
 		return -pngWriter->lastError();
 
+	// Set the encoding profile.
+	int ret = pngWriter->setProfile(profile);
+	if (ret != 0)
+		return ret;
+
 	// Write the PNG IHDR.
-	int ret = pngWriter->write_IHDR();
+	ret = pngWriter->write_IHDR();
 	if (ret != 0)
 		return ret;
 
@@ -10,6 +10,7 @@
 #define __ROMPROPERTIES_LIBRPBASE_IMG_RPPNG_HPP__
 
 #include "common.h"
+#include "RpPngWriter.hpp"
 
 namespace LibRpFile {
 	class IRpFile;
@@ -53,6 +54,22 @@ class RpPng
 		 */
 		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file);
 
+		/**
+		 * Verify the chunk layout of an in-memory PNG image.
+		 *
+		 * This checks the PNG signature, the IHDR chunk, chunk
+		 * lengths and CRCs, and the IEND chunk. The image data
+		 * is *not* decompressed, so this is much faster than
+		 * load(), but it does not verify the IDAT contents.
+		 *
+		 * @param data		[in] PNG image data.
+		 * @param size		[in] Size of data.
+		 * @param pWidth	[out,opt] Image width.
+		 * @param pHeight	[out,opt] Image height.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int verifyChunks(const uint8_t *data, size_t size, int *pWidth = nullptr, int *pHeight = nullptr);
+
 		/**
 		 * Save an image in PNG format to an IRpFile.
 		 * IRpFile must be open for writing.
@@ -62,18 +79,22 @@ class RpPng
 		 *
 		 * @param file IRpFile to write to.
 		 * @param img rp_image to save.
+		 * @param profile Encoding profile.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		static int save(LibRpFile::IRpFile *file, const LibRpTexture::rp_image *img);
+		static int save(LibRpFile::IRpFile *file, const LibRpTexture::rp_image *img,
+			RpPngWriter::Profile profile = RpPngWriter::PROFILE_DEFAULT);
 
 		/**
 		 * Save an image in PNG format to a file.
 		 *
 		 * @param filename Destination filename.
 		 * @param img rp_image to save.
+		 * @param profile Encoding profile.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		static int save(const char *filename, const LibRpTexture::rp_image *img);
+		static int save(const char *filename, const LibRpTexture::rp_image *img,
+			RpPngWriter::Profile profile = RpPngWriter::PROFILE_DEFAULT);
 
 		/**
 		 * Save an animated image in APNG format to an IRpFile.
@@ -92,9 +113,11 @@ class RpPng
 		 *
 		 * @param file IRpFile to write to.
 		 * @param iconAnimData Animated image data to save.
+		 * @param profile Encoding profile.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		static int save(LibRpFile::IRpFile *file, const IconAnimData *iconAnimData);
+		static int save(LibRpFile::IRpFile *file, const IconAnimData *iconAnimData,
+			RpPngWriter::Profile profile = RpPngWriter::PROFILE_DEFAULT);
 
 		/**
 		 * Save an animated image in APNG format to a file.
@@ -109,9 +132,11 @@ class RpPng
 		 *
 		 * @param filename Destination filename.
 		 * @param iconAnimData Animated image data to save.
+		 * @param profile Encoding profile.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		static int save(const char *filename, const IconAnimData *iconAnimData);
+		static int save(const char *filename, const IconAnimData *iconAnimData,
+			RpPngWriter::Profile profile = RpPngWriter::PROFILE_DEFAULT);
 };
 
 }
@@ -12,11 +12,14 @@
 
 #include "byteorder.h"
 #include "TextFuncs.hpp"
+#include "librpthreads/Profiler.hpp"
 
 // librpfile
 #include "librpfile/RpFile.hpp"
+#include "librpfile/RpMemFile.hpp"
 using LibRpFile::IRpFile;
 using LibRpFile::RpFile;
+using LibRpFile::RpMemFile;
 
 // librptexture
 #include "img/rp_image.hpp"
@@ -27,8 +30,14 @@ using LibRpTexture::argb32_t;
 #include "img/IconAnimData.hpp"
 #include "APNG_dlopen.h"
 
+// PNG pass-through
+#include "RpPng.hpp"
+#include "pngcheck/pngcheck.hpp"
+
 // libpng
 #include <png.h>
+// zlib: crc32()
+#include <zlib.h>
 
 #if PNG_LIBPNG_VER < 10209 || \
     (PNG_LIBPNG_VER == 10209 && \
@@ -83,8 +92,6 @@ using std::unique_ptr;
 using std::vector;
 
 #if defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL))
-// Need zlib for delay-load checks.
-#include <zlib.h>
 // MSVC: Exception handling for /DELAYLOAD.
 #include "libwin32common/DelayLoadHelper.h"
 #endif /* defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL)) */
@@ -118,18 +125,21 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(IRpFile *file, int width, int height, rp_image::Format format)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::PROFILE_DEFAULT)
 		{
 			init(file, width, height, format);
 		}
 		RpPngWriterPrivate(IRpFile *file, const rp_image *img)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::PROFILE_DEFAULT)
 		{
 			init(file, img);
 		}
 		RpPngWriterPrivate(IRpFile *file, const IconAnimData *iconAnimData)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::PROFILE_DEFAULT)
 		{
 			init(file, iconAnimData);
 		}
@@ -137,6 +147,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, int width, int height, rp_image::Format format)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::PROFILE_DEFAULT)
 		{
 			RpFile *const file = (filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(file, width, height, format);
@@ -147,6 +158,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, const rp_image *img)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::PROFILE_DEFAULT)
 		{
 			RpFile *const file = (filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(file, img);
@@ -157,6 +169,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, const IconAnimData *iconAnimData)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, profile(RpPngWriter::PROFILE_DEFAULT)
 		{
 			RpFile *const file = (filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(file, iconAnimData);
@@ -274,6 +287,13 @@ class RpPngWriterPrivate
 		};
 		cache_t cache;
 
+		// APNG: Combined palette for CI8 frames.
+		// If the frames use different palettes, they're merged into
+		// a single PLTE, and each frame's color indexes are offset
+		// by apng_pal_offset[frame] when writing.
+		array<uint32_t, 256> apng_palette;
+		array<uint8_t, IconAnimData::MAX_FRAMES> apng_pal_offset;
+
 		// PNG pointers.
 		png_structp png_ptr;
 		png_infop info_ptr;
@@ -281,6 +301,9 @@ class RpPngWriterPrivate
 		// Current state.
 		bool IHDR_written;
 
+		// Encoding profile.
+		RpPngWriter::Profile profile;
+
 	public:
 		/**
 		 * Initialize the PNG write structs.
@@ -309,6 +332,15 @@ class RpPngWriterPrivate
 		 */
 		static void PNGCAPI png_io_IRpFile_flush(png_structp png_ptr);
 
+		/**
+		 * libpng I/O write handler that only counts bytes.
+		 * Used by measure_IDAT().
+		 * @param png_ptr	[in] PNG pointer.
+		 * @param data		[in] Data to write.
+		 * @param length	[in] Size of data.
+		 */
+		static void PNGCAPI png_io_count_write(png_structp png_ptr, png_bytep data, png_size_t length);
+
 	public:
 		/** Internal functions. **/
 
@@ -318,6 +350,22 @@ class RpPngWriterPrivate
 		 */
 		int write_CI8_palette(void);
 
+		/**
+		 * Determine the APNG image format from all animation frames.
+		 * cache must have been initialized from the first frame.
+		 *
+		 * If all frames are CI8, their palettes are merged into
+		 * apng_palette if they fit. Otherwise, the APNG will be
+		 * written as ARGB32, and CI8 frames will be converted.
+		 */
+		void init_APNG_format(void);
+
+		/**
+		 * Write the APNG as ARGB32.
+		 * CI8 frames will be converted when writing.
+		 */
+		void set_APNG_ARGB32(void);
+
 		/**
 		 * Write raw image data to the PNG image.
 		 *
@@ -332,6 +380,18 @@ class RpPngWriterPrivate
 		 */
 		int write_IDAT(const png_byte *const *row_pointers, bool is_abgr = false);
 
+		/**
+		 * Measure the encoded size of an ARGB32 image using the specified filters.
+		 * The image is encoded using a temporary PNG write struct,
+		 * and the output is discarded.
+		 *
+		 * @param row_pointers PNG row pointers. Array must have cache.height elements.
+		 * @param is_abgr If true, image data is ABGR instead of ARGB.
+		 * @param filters PNG filters. (PNG_FILTER_*)
+		 * @return Encoded size, in bytes, or 0 on error.
+		 */
+		size_t measure_IDAT(const png_byte *const *row_pointers, bool is_abgr, int filters);
+
 		/**
 		 * Write the rp_image data to the PNG image.
 		 *
@@ -550,6 +610,7 @@ void RpPngWriterPrivate::init(IRpFile *file, const IconAnimData *iconAnimData)
 			imageTag = IMGT_INVALID;
 		}
 		cache.setFrom(img0);
+		init_APNG_format();
 	} else {
 		this->img = iconAnimData->frames[iconAnimData->seq_index[0]];
 		cache.setFrom(img);
@@ -652,6 +713,23 @@ void PNGCAPI RpPngWriterPrivate::png_io_IRpFile_write(png_structp png_ptr, png_b
 	file->write(data, length);
 }
 
+/**
+ * libpng I/O write handler that only counts bytes.
+ * Used by measure_IDAT().
+ * @param png_ptr	[in] PNG pointer.
+ * @param data		[in] Data to write.
+ * @param length	[in] Size of data.
+ */
+void PNGCAPI RpPngWriterPrivate::png_io_count_write(png_structp png_ptr, png_bytep data, png_size_t length)
+{
+	// Assuming io_ptr is a size_t*.
+	RP_UNUSED(data);
+	size_t *const pSize = static_cast<size_t*>(png_get_io_ptr(png_ptr));
+	if (pSize) {
+		*pSize += length;
+	}
+}
+
 /**
  * libpng I/O flush handler for IRpFile.
  * @param png_ptr	[in] PNG pointer.
@@ -718,6 +796,137 @@ int RpPngWriterPrivate::write_CI8_palette(void)
 	return 0;
 }
 
+/**
+ * Determine the APNG image format from all animation frames.
+ * cache must have been initialized from the first frame.
+ *
+ * If all frames are CI8, their palettes are merged into
+ * apng_palette if they fit. Otherwise, the APNG will be
+ * written as ARGB32, and CI8 frames will be converted.
+ */
+void RpPngWriterPrivate::init_APNG_format(void)
+{
+	apng_pal_offset.fill(0);
+	if (cache.format == rp_image::FORMAT_NONE)
+		return;
+
+	// Check the frame formats.
+	// If all CI8 frames share the first frame's palette,
+	// the frames can be written as-is.
+	bool same_palette = true;
+	for (int i = 0; i < iconAnimData->seq_count; i++) {
+		const rp_image *const frame = iconAnimData->frames[iconAnimData->seq_index[i]];
+		if (!frame)
+			continue;
+		if (frame->format() != cache.format) {
+			// Mixed formats. (e.g. GameCube RGB5A3 and CI8)
+			set_APNG_ARGB32();
+			return;
+		}
+		if (cache.format == rp_image::FORMAT_CI8 && same_palette) {
+			same_palette = (frame->palette_len() == cache.palette_len &&
+				!memcmp(frame->palette(), cache.palette, cache.palette_len * sizeof(uint32_t)));
+		}
+	}
+	if (same_palette)
+		return;
+
+	// CI8 frames with different palettes. (e.g. DSi animated icons)
+	// Merge the colors that are actually used into a single palette.
+	// Unique palettes found so far. pal_frames[] has the first frame
+	// that uses each palette; pal_used[] has the number of colors used.
+	array<const rp_image*, IconAnimData::MAX_FRAMES> pal_frames;
+	array<int, IconAnimData::MAX_FRAMES> pal_used;
+	array<uint8_t, IconAnimData::MAX_FRAMES> pal_offsets;
+	int pal_count = 0;
+	int pal_len = 0;
+
+	for (int i = 0; i < iconAnimData->seq_count; i++) {
+		const uint8_t idx = iconAnimData->seq_index[i];
+		const rp_image *const frame = iconAnimData->frames[idx];
+		if (!frame)
+			continue;
+
+		// Determine how many colors are used by this frame.
+		const int width = frame->width();
+		const int height = frame->height();
+		uint8_t max_idx = 0;
+		for (int y = 0; y < height; y++) {
+			const uint8_t *src = static_cast<const uint8_t*>(frame->scanLine(y));
+			for (int x = width; x > 0; x--, src++) {
+				if (*src > max_idx) {
+					max_idx = *src;
+				}
+			}
+		}
+		const int used = std::min(static_cast<int>(max_idx) + 1, frame->palette_len());
+		const uint32_t *const pal = frame->palette();
+
+		// Check if a previous frame has the same palette.
+		// The most recently added palette can be extended
+		// if this frame uses more colors.
+		int j;
+		for (j = 0; j < pal_count; j++) {
+			const int cmp_len = std::min(used, pal_used[j]);
+			if (!memcmp(pal_frames[j]->palette(), pal, cmp_len * sizeof(uint32_t)) &&
+			    (used <= pal_used[j] || j == pal_count-1))
+			{
+				break;
+			}
+		}
+		if (j < pal_count) {
+			if (used > pal_used[j]) {
+				// Extend the most recent palette.
+				if (pal_offsets[j] + used > static_cast<int>(apng_palette.size())) {
+					set_APNG_ARGB32();
+					return;
+				}
+				memcpy(&apng_palette[pal_offsets[j] + pal_used[j]], &pal[pal_used[j]],
+					(used - pal_used[j]) * sizeof(uint32_t));
+				pal_len += (used - pal_used[j]);
+				pal_frames[j] = frame;
+				pal_used[j] = used;
+			}
+			apng_pal_offset[idx] = pal_offsets[j];
+			continue;
+		}
+
+		// New palette. Append it to the combined palette.
+		if (pal_len + used > static_cast<int>(apng_palette.size())) {
+			// Too many colors for a single PLTE.
+			set_APNG_ARGB32();
+			return;
+		}
+		memcpy(&apng_palette[pal_len], pal, used * sizeof(uint32_t));
+		pal_frames[pal_count] = frame;
+		pal_used[pal_count] = used;
+		pal_offsets[pal_count] = static_cast<uint8_t>(pal_len);
+		apng_pal_offset[idx] = static_cast<uint8_t>(pal_len);
+		pal_count++;
+		pal_len += used;
+	}
+
+	// Use the combined palette.
+	cache.palette_len = pal_len;
+	cache.palette = apng_palette.data();
+}
+
+/**
+ * Write the APNG as ARGB32.
+ * CI8 frames will be converted when writing.
+ */
+void RpPngWriterPrivate::set_APNG_ARGB32(void)
+{
+	apng_pal_offset.fill(0);
+	cache.format = rp_image::FORMAT_ARGB32;
+	cache.palette_len = 0;
+	cache.palette = nullptr;
+#ifdef PNG_sBIT_SUPPORTED
+	// sBIT from the first frame isn't valid for the other frames.
+	cache.set_sBIT(nullptr);
+#endif /* PNG_sBIT_SUPPORTED */
+}
+
 /**
  * Write raw image data to the PNG image.
  *
@@ -747,6 +956,15 @@ int RpPngWriterPrivate::write_IDAT(const png_byte *const *row_pointers, bool is_
 		return -lastError;
 	}
 
+	if (profile == RpPngWriter::PROFILE_SMALLEST && cache.format == rp_image::FORMAT_ARGB32) {
+		// Use adaptive filtering only if it's actually smaller.
+		const size_t szNone = measure_IDAT(row_pointers, is_abgr, PNG_FILTER_NONE);
+		const size_t szAll = measure_IDAT(row_pointers, is_abgr, PNG_ALL_FILTERS);
+		if (szAll != 0 && szAll < szNone) {
+			png_set_filter(png_ptr, 0, PNG_ALL_FILTERS);
+		}
+	}
+
 #ifdef PNG_SETJMP_SUPPORTED
 	// WARNING: Do NOT initialize any C++ objects past this point!
 	if (setjmp(png_jmpbuf(png_ptr))) {
@@ -779,6 +997,78 @@ int RpPngWriterPrivate::write_IDAT(const png_byte *const *row_pointers, bool is_
 	return 0;
 }
 
+/**
+ * Measure the encoded size of an ARGB32 image using the specified filters.
+ * The image is encoded using a temporary PNG write struct,
+ * and the output is discarded.
+ *
+ * @param row_pointers PNG row pointers. Array must have cache.height elements.
+ * @param is_abgr If true, image data is ABGR instead of ARGB.
+ * @param filters PNG filters. (PNG_FILTER_*)
+ * @return Encoded size, in bytes, or 0 on error.
+ */
+size_t RpPngWriterPrivate::measure_IDAT(const png_byte *const *row_pointers, bool is_abgr, int filters)
+{
+	assert(cache.format == rp_image::FORMAT_ARGB32);
+
+	png_structp png_tmp = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+	if (!png_tmp) {
+		return 0;
+	}
+	png_infop info_tmp = png_create_info_struct(png_tmp);
+	if (!info_tmp) {
+		png_destroy_write_struct(&png_tmp, nullptr);
+		return 0;
+	}
+
+	size_t size = 0;
+
+#ifdef PNG_SETJMP_SUPPORTED
+	// WARNING: Do NOT initialize any C++ objects past this point!
+	if (setjmp(png_jmpbuf(png_tmp))) {
+		// PNG write failed.
+		png_destroy_write_struct(&png_tmp, &info_tmp);
+		return 0;
+	}
+#endif /* PNG_SETJMP_SUPPORTED */
+
+	png_set_write_fn(png_tmp, &size, png_io_count_write, nullptr);
+	png_set_filter(png_tmp, 0, filters);
+	png_set_compression_level(png_tmp, 9);
+	png_set_compression_mem_level(png_tmp, 9);
+
+	// Same color type and transformations as write_IHDR() and write_IDAT().
+#ifdef PNG_sBIT_SUPPORTED
+	const int color_type = (cache.skip_alpha ? PNG_COLOR_TYPE_RGB : PNG_COLOR_TYPE_RGB_ALPHA);
+#else /* !PNG_sBIT_SUPPORTED */
+	static const int color_type = PNG_COLOR_TYPE_RGB_ALPHA;
+#endif /* PNG_sBIT_SUPPORTED */
+	png_set_IHDR(png_tmp, info_tmp,
+			cache.width, cache.height, 8,
+			color_type,
+			PNG_INTERLACE_NONE,
+			PNG_COMPRESSION_TYPE_DEFAULT,
+			PNG_FILTER_TYPE_DEFAULT);
+	png_write_info(png_tmp, info_tmp);
+
+	if (!is_abgr) {
+		png_set_bgr(png_tmp);
+	}
+	if (cache.skip_alpha) {
+#if SYS_BYTEORDER == SYS_LIL_ENDIAN
+		static const int flags = PNG_FILLER_AFTER;
+#else /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
+		static const int flags = PNG_FILLER_BEFORE;
+#endif
+		png_set_filler(png_tmp, 0xFF, flags);
+	}
+
+	png_write_image(png_tmp, const_cast<png_bytepp>(row_pointers));
+	png_write_end(png_tmp, info_tmp);
+	png_destroy_write_struct(&png_tmp, &info_tmp);
+	return size;
+}
+
 /**
  * Write the rp_image data to the PNG image.
  *
@@ -860,7 +1150,38 @@ int RpPngWriterPrivate::write_IDAT_APNG(void)
 
 	// Using the cached width/height from the first image.
 	// TODO: Handle animated images where the different frames
-	// have different widths, heights, and/or formats.
+	// have different widths and/or heights.
+
+	// Convert frames that can't be written as-is to the APNG format.
+	// This must be done before setjmp(). Each frame is only converted
+	// once, even if it's used multiple times in the sequence.
+	array<unique_ptr<rp_image>, IconAnimData::MAX_FRAMES> conv_frames;
+	for (int i = 0; i < iconAnimData->seq_count; i++) {
+		const uint8_t idx = iconAnimData->seq_index[i];
+		const rp_image *const frame = iconAnimData->frames[idx];
+		if (!frame || conv_frames[idx])
+			continue;
+
+		if (cache.format == rp_image::FORMAT_ARGB32) {
+			if (frame->format() != rp_image::FORMAT_ARGB32) {
+				conv_frames[idx].reset(frame->dup_ARGB32());
+			}
+		} else if (apng_pal_offset[idx] != 0) {
+			// Offset the color indexes into the combined palette.
+			const uint8_t pal_offset = apng_pal_offset[idx];
+			const int width = frame->width();
+			const int height = frame->height();
+			rp_image *const conv = new rp_image(width, height, rp_image::FORMAT_CI8);
+			for (int y = 0; y < height; y++) {
+				const uint8_t *src = static_cast<const uint8_t*>(frame->scanLine(y));
+				uint8_t *dest = static_cast<uint8_t*>(conv->scanLine(y));
+				for (int x = width; x > 0; x--, src++, dest++) {
+					*dest = *src + pal_offset;
+				}
+			}
+			conv_frames[idx].reset(conv);
+		}
+	}
 
 #ifdef PNG_SETJMP_SUPPORTED
 	// WARNING: Do NOT initialize any C++ objects past this point!
@@ -876,6 +1197,17 @@ int RpPngWriterPrivate::write_IDAT_APNG(void)
 	// TODO: What format on big-endian?
 	png_set_bgr(png_ptr);
 
+	if (cache.skip_alpha && cache.format == rp_image::FORMAT_ARGB32) {
+		// Need to skip the alpha bytes.
+		// Assuming 'after' on LE, 'before' on BE.
+#if SYS_BYTEORDER == SYS_LIL_ENDIAN
+		static const int flags = PNG_FILLER_AFTER;
+#else /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
+		static const int flags = PNG_FILLER_BEFORE;
+#endif
+		png_set_filler(png_ptr, 0xFF, flags);
+	}
+
 	// Allocate the row pointers.
 	row_pointers = static_cast<const png_byte**>(
 		png_malloc(png_ptr, sizeof(const png_byte*) * cache.height));
@@ -886,7 +1218,10 @@ int RpPngWriterPrivate::write_IDAT_APNG(void)
 
 	// Write the images.
 	for (int i = 0; i < iconAnimData->seq_count; i++) {
-		const rp_image *const img = iconAnimData->frames[iconAnimData->seq_index[i]];
+		const uint8_t idx = iconAnimData->seq_index[i];
+		const rp_image *const img = (conv_frames[idx]
+			? conv_frames[idx].get()
+			: iconAnimData->frames[idx]);
 		if (!img)
 			break;
 
@@ -904,7 +1239,6 @@ int RpPngWriterPrivate::write_IDAT_APNG(void)
 				PNG_BLEND_OP_SOURCE);
 
 		// Write the image data.
-		// TODO: Individual palette for CI8?
 		png_write_image(png_ptr, (png_bytepp)row_pointers);
 
 		// Frame tail.
@@ -1091,6 +1425,31 @@ void RpPngWriter::close(void)
 	d->close();
 }
 
+/**
+ * Set the encoding profile.
+ * This must be called before write_IHDR().
+ * @param profile Encoding profile.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpPngWriter::setProfile(Profile profile)
+{
+	RP_D(RpPngWriter);
+	assert(profile >= PROFILE_FAST && profile < PROFILE_MAX);
+	assert(!d->IHDR_written);
+	if (profile < PROFILE_FAST || profile >= PROFILE_MAX) {
+		d->lastError = EINVAL;
+		return -d->lastError;
+	}
+	if (unlikely(d->IHDR_written)) {
+		// IHDR has already been written.
+		d->lastError = EEXIST;
+		return -d->lastError;
+	}
+
+	d->profile = profile;
+	return 0;
+}
+
 /**
  * Write the PNG IHDR.
  * This must be called before writing any other image data.
@@ -1126,9 +1485,34 @@ int RpPngWriter::write_IHDR(void)
 #endif /* PNG_SETJMP_SUPPORTED */
 
 	// Initialize compression parameters.
-	// TODO: Customizable?
-	png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
-	png_set_compression_level(d->png_ptr, PNG_Z_DEFAULT_COMPRESSION);
+	switch (d->profile) {
+		case PROFILE_FAST:
+			// Thumbnail caches are rewritten whenever the cache
+			// is rebuilt, so encoding speed is more important
+			// than the output size.
+			png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
+			png_set_compression_level(d->png_ptr, 1);
+			break;
+
+		case PROFILE_DEFAULT:
+		default:
+			png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
+			png_set_compression_level(d->png_ptr, PNG_Z_DEFAULT_COMPRESSION);
+			break;
+
+		case PROFILE_SMALLEST:
+			// Maximum compression.
+			// Adaptive filtering is often *larger* than no filtering
+			// for decoded textures, so write_IDAT() encodes ARGB32
+			// images with both and switches filters if adaptive
+			// filtering is smaller. Paletted images and APNG frames
+			// are always left unfiltered.
+			// Reference: https://www.w3.org/TR/PNG-Encoders.html#E.Filter-selection
+			png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
+			png_set_compression_level(d->png_ptr, 9);
+			png_set_compression_mem_level(d->png_ptr, 9);
+			break;
+	}
 
 	// Write the PNG header.
 	switch (d->cache.format) {
@@ -1395,6 +1779,172 @@ int RpPngWriter::write_tEXt(const kv_vector &kv)
 	return 0;
 }
 
+/**
+ * Append a PNG chunk to a buffer.
+ * @param buf	[in/out] Buffer.
+ * @param name	[in] Chunk name. (4 characters)
+ * @param data	[in] Chunk data.
+ * @param size	[in] Size of data.
+ */
+static void append_PNG_chunk(vector<uint8_t> &buf, const char *name, const uint8_t *data, size_t size)
+{
+	const size_t pos = buf.size();
+	buf.resize(pos + 12 + size);
+	uint8_t *const p = &buf[pos];
+
+	const uint32_t chunk_size = cpu_to_be32(static_cast<uint32_t>(size));
+	memcpy(p, &chunk_size, sizeof(chunk_size));
+	memcpy(p + 4, name, 4);
+	if (size > 0) {
+		memcpy(p + 8, data, size);
+	}
+
+	// CRC32 covers the chunk name and data.
+	const uint32_t crc = cpu_to_be32(static_cast<uint32_t>(
+		crc32(crc32(0, nullptr, 0), p + 4, static_cast<uInt>(4 + size))));
+	memcpy(p + 8 + size, &crc, sizeof(crc));
+}
+
+/**
+ * Copy a PNG image, adding text chunks.
+ * This is used to write thumbnails for images that are
+ * already in PNG format without re-encoding them.
+ *
+ * The chunk layout of the source image is verified with
+ * RpPng::verifyChunks(), and the new image is verified with
+ * pngcheck(), before anything is written.
+ *
+ * tEXt chunks are inserted immediately after IHDR.
+ * Existing text chunks with the same keywords are removed.
+ *
+ * NOTE: Key must be Latin-1. Value must be UTF-8.
+ * If value is ASCII or exclusively uses code points compatible
+ * with Latin-1, it will be saved as tEXt; otherwise, iTXt.
+ * Text chunks are not compressed.
+ *
+ * @param file		[in] IRpFile open for writing.
+ * @param png_data	[in] Source PNG image data.
+ * @param png_size	[in] Size of png_data.
+ * @param kv		[in] Vector of key/value pairs.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpPngWriter::copy_with_tEXt(IRpFile *file, const uint8_t *png_data, size_t png_size, const kv_vector &kv)
+{
+	assert(file != nullptr);
+	assert(png_data != nullptr);
+	if (!file || !file->isOpen() || !png_data) {
+		return -EINVAL;
+	}
+
+	int ret = RpPng::verifyChunks(png_data, png_size);
+	if (ret != 0) {
+		// PNG image is invalid.
+		return ret;
+	}
+
+	// PNG signature and IHDR. (verified above)
+	static const size_t IHDR_end = 8 + 12 + 13;
+	vector<uint8_t> buf;
+	buf.reserve(png_size + (kv.size() * 128));
+	buf.assign(png_data, png_data + IHDR_end);
+
+	// Text chunks.
+	vector<uint8_t> chunk;
+	for (auto iter = kv.cbegin(); iter != kv.cend(); ++iter) {
+		const size_t key_len = strlen(iter->first);
+		assert(key_len >= 1 && key_len <= 79);
+		if (key_len < 1 || key_len > 79) {
+			// Invalid keyword.
+			continue;
+		}
+
+		chunk.assign(iter->first, iter->first + key_len + 1);
+		const string &value = iter->second;
+		switch (u8strIsPngLatin1(value.c_str())) {
+			case 0:
+				// ASCII. Use it as-is.
+				chunk.insert(chunk.end(), value.cbegin(), value.cend());
+				append_PNG_chunk(buf, "tEXt", chunk.data(), chunk.size());
+				break;
+			case 1: {
+				// Latin-1. Convert it.
+				const string latin1_str = utf8_to_latin1(value);
+				chunk.insert(chunk.end(), latin1_str.cbegin(), latin1_str.cend());
+				append_PNG_chunk(buf, "tEXt", chunk.data(), chunk.size());
+				break;
+			}
+			default:
+				// UTF-8. Use iTXt.
+				// Compression flag, compression method,
+				// empty language tag, empty translated keyword.
+				chunk.insert(chunk.end(), 4, 0);
+				chunk.insert(chunk.end(), value.cbegin(), value.cend());
+				append_PNG_chunk(buf, "iTXt", chunk.data(), chunk.size());
+				break;
+		}
+	}
+
+	// Copy the remaining chunks.
+	const uint8_t *p = png_data + IHDR_end;
+	const uint8_t *const p_end = png_data + png_size;
+	while (p < p_end) {
+		uint32_t chunk_size;
+		memcpy(&chunk_size, p, sizeof(chunk_size));
+		chunk_size = be32_to_cpu(chunk_size);
+		const char *const chunk_name = reinterpret_cast<const char*>(p + 4);
+		const uint8_t *const chunk_next = p + 12 + chunk_size;
+
+		bool skip = false;
+		if (!memcmp(chunk_name, "tEXt", 4) || !memcmp(chunk_name, "zTXt", 4) || !memcmp(chunk_name, "iTXt", 4)) {
+			// Text chunk. Skip it if it has one of our keywords.
+			const char *const keyword = chunk_name + 4;
+			const size_t keyword_len = strnlen(keyword, chunk_size);
+			for (auto iter = kv.cbegin(); iter != kv.cend(); ++iter) {
+				if (strlen(iter->first) == keyword_len && !memcmp(iter->first, keyword, keyword_len)) {
+					skip = true;
+					break;
+				}
+			}
+		}
+		if (!skip) {
+			buf.insert(buf.end(), p, chunk_next);
+		}
+
+		if (!memcmp(chunk_name, "IEND", 4)) {
+			// End of image. Ignore any trailing data.
+			break;
+		}
+		p = chunk_next;
+	}
+
+	// Make sure the new PNG image is valid.
+	// verifyChunks() only checks the chunk layout, and the source
+	// image is untrusted, so the image data is checked here.
+	RpMemFile *const memFile = new RpMemFile(buf.data(), buf.size());
+	ret = pngcheck(memFile);
+	memFile->unref();
+	// NOTE: pngcheck returns kMinorError for some spec issues
+	// in the original image; RpPng::load() accepts those, too.
+	if (ret != kOK && ret != kMinorError) {
+		// PNG image has major errors.
+		return -EIO;
+	}
+
+	// Write the new PNG image.
+	ret = file->truncate(0);
+	if (ret != 0) {
+		ret = file->lastError();
+		return (ret != 0 ? -ret : -EIO);
+	}
+	file->rewind();
+	const size_t size = file->write(buf.data(), buf.size());
+	if (size != buf.size()) {
+		ret = file->lastError();
+		return (ret != 0 ? -ret : -EIO);
+	}
+	return 0;
+}
+
 /**
  * Write raw image data to the PNG image.
  *
@@ -1423,6 +1973,7 @@ int RpPngWriter::write_IDAT(const uint8_t *const *row_pointers, bool is_abgr)
 		return -EINVAL;
 	}
 
+	RP_PROFILE_SCOPE(STAGE_PNG_ENCODE);
 	return d->write_IDAT(row_pointers, is_abgr);
 }
 
@@ -1441,6 +1992,7 @@ int RpPngWriter::write_IDAT(const uint8_t *const *row_pointers, bool is_abgr)
  */
 int RpPngWriter::write_IDAT(void)
 {
+	RP_PROFILE_SCOPE(STAGE_PNG_ENCODE);
 	RP_D(RpPngWriter);
 	int ret = -1;
 	switch (d->imageTag) {
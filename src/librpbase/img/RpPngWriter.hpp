@@ -172,6 +172,26 @@ class RpPngWriter
 		 */
 		void close(void);
 
+		/**
+		 * Encoding profile.
+		 * This controls the PNG filter and zlib compression level.
+		 */
+		enum Profile {
+			PROFILE_FAST,		// zlib level 1, no filtering. (thumbnail caches)
+			PROFILE_DEFAULT,	// zlib default level, no filtering.
+			PROFILE_SMALLEST,	// zlib level 9, smaller of adaptive and no filtering. (image extraction)
+
+			PROFILE_MAX
+		};
+
+		/**
+		 * Set the encoding profile.
+		 * This must be called before write_IHDR().
+		 * @param profile Encoding profile.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int setProfile(Profile profile);
+
 		/**
 		 * Write the PNG IHDR.
 		 * This must be called before writing any other image data.
@@ -220,6 +240,31 @@ class RpPngWriter
 		 */
 		int write_tEXt(const kv_vector &kv);
 
+		/**
+		 * Copy a PNG image, adding text chunks.
+		 * This is used to write thumbnails for images that are
+		 * already in PNG format without re-encoding them.
+		 *
+		 * The chunk layout of the source image is verified with
+		 * RpPng::verifyChunks(), and the new image is verified with
+		 * pngcheck(), before anything is written.
+		 *
+		 * tEXt chunks are inserted immediately after IHDR.
+		 * Existing text chunks with the same keywords are removed.
+		 *
+		 * NOTE: Key must be Latin-1. Value must be UTF-8.
+		 * If value is ASCII or exclusively uses code points compatible
+		 * with Latin-1, it will be saved as tEXt; otherwise, iTXt.
+		 * Text chunks are not compressed.
+		 *
+		 * @param file		[in] IRpFile open for writing.
+		 * @param png_data	[in] Source PNG image data.
+		 * @param png_size	[in] Size of png_data.
+		 * @param kv		[in] Vector of key/value pairs.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int copy_with_tEXt(LibRpFile::IRpFile *file, const uint8_t *png_data, size_t png_size, const kv_vector &kv);
+
 		/**
 		 * Write raw image data to the PNG image.
 		 *
@@ -0,0 +1,248 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * MultiHashTest.cpp: MultiHash class test.                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// MultiHash
+#include "librpbase/crypto/MultiHash.hpp"
+
+// librpfile
+#include "librpfile/RpMemFile.hpp"
+using LibRpFile::RpMemFile;
+
+// C includes. (C++ namespace)
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+class MultiHashTest : public ::testing::Test
+{
+	protected:
+		/**
+		 * Fill a buffer with pseudo-random data.
+		 * A simple LCG is used so the data is reproducible.
+		 * @param buf Buffer.
+		 * @param size Size of buffer.
+		 */
+		static void fillBuffer(uint8_t *buf, size_t size)
+		{
+			uint32_t seed = 0x12345678;
+			for (size_t i = 0; i < size; i++) {
+				seed = (seed * 1103515245U) + 12345U;
+				buf[i] = static_cast<uint8_t>(seed >> 16);
+			}
+		}
+
+		/**
+		 * Calculate a reference CRC32.
+		 * The data is hashed in 1-byte pieces,
+		 * which bypasses any folded implementation.
+		 * @param buf Buffer.
+		 * @param size Size of buffer.
+		 * @return CRC32, as a hexadecimal string.
+		 */
+		static string refCrc32(const uint8_t *buf, size_t size)
+		{
+			MultiHash hash(MultiHash::ALGO_CRC32);
+			for (size_t i = 0; i < size; i++) {
+				hash.update(&buf[i], 1);
+			}
+			hash.finalize();
+			return hash.hexDigest(MultiHash::ALGO_CRC32);
+		}
+};
+
+/**
+ * Test hashing an empty buffer.
+ */
+TEST_F(MultiHashTest, emptyTest)
+{
+	MultiHash hash;
+	hash.finalize();
+	EXPECT_EQ(0U, hash.bytesHashed());
+
+	EXPECT_EQ("00000000", hash.hexDigest(MultiHash::ALGO_CRC32));
+	if (!(hash.algorithms() & MultiHash::ALGO_SHA256)) {
+		// No crypto backend.
+		return;
+	}
+	EXPECT_EQ("d41d8cd98f00b204e9800998ecf8427e", hash.hexDigest(MultiHash::ALGO_MD5));
+	EXPECT_EQ("da39a3ee5e6b4b0d3255bfef95601890afd80709", hash.hexDigest(MultiHash::ALGO_SHA1));
+	EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+		hash.hexDigest(MultiHash::ALGO_SHA256));
+}
+
+/**
+ * Test hashing "abc".
+ */
+TEST_F(MultiHashTest, abcTest)
+{
+	MultiHash hash;
+	hash.update("abc", 3);
+	hash.finalize();
+	EXPECT_EQ(3U, hash.bytesHashed());
+
+	EXPECT_EQ("352441c2", hash.hexDigest(MultiHash::ALGO_CRC32));
+	if (!(hash.algorithms() & MultiHash::ALGO_SHA256)) {
+		// No crypto backend.
+		return;
+	}
+	EXPECT_EQ("900150983cd24fb0d6963f7d28e17f72", hash.hexDigest(MultiHash::ALGO_MD5));
+	EXPECT_EQ("a9993e364706816aba3e25717850c26c9cd0d89d", hash.hexDigest(MultiHash::ALGO_SHA1));
+	EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+		hash.hexDigest(MultiHash::ALGO_SHA256));
+}
+
+/**
+ * Test digest() error handling.
+ */
+TEST_F(MultiHashTest, digestErrorTest)
+{
+	uint8_t buf[32];
+
+	// Not finalized yet.
+	MultiHash hash(MultiHash::ALGO_CRC32);
+	hash.update("abc", 3);
+	EXPECT_EQ(-EAGAIN, hash.digest(MultiHash::ALGO_CRC32, buf, sizeof(buf)));
+	hash.finalize();
+
+	// Buffer is too small.
+	EXPECT_EQ(-ENOSPC, hash.digest(MultiHash::ALGO_CRC32, buf, 3));
+	// Algorithm wasn't calculated.
+	EXPECT_EQ(-ENOENT, hash.digest(MultiHash::ALGO_MD5, buf, sizeof(buf)));
+	EXPECT_TRUE(hash.hexDigest(MultiHash::ALGO_MD5).empty());
+
+	// Valid digest. (big-endian)
+	ASSERT_EQ(4, hash.digest(MultiHash::ALGO_CRC32, buf, sizeof(buf)));
+	EXPECT_EQ(0x35, buf[0]);
+	EXPECT_EQ(0x24, buf[1]);
+	EXPECT_EQ(0x41, buf[2]);
+	EXPECT_EQ(0xC2, buf[3]);
+}
+
+/**
+ * Test CRC32 with various lengths and alignments.
+ * Larger buffers use the PCLMULQDQ implementation if available,
+ * so this compares the results to a byte-at-a-time calculation.
+ */
+TEST_F(MultiHashTest, crc32LengthTest)
+{
+	static const size_t BUF_SIZE = 4096 + 16;
+	vector<uint8_t> buf(BUF_SIZE);
+	fillBuffer(buf.data(), buf.size());
+
+	static const size_t sizes[] = {
+		1, 15, 16, 17, 63, 64, 65, 79, 80, 127, 128, 129,
+		255, 256, 257, 1000, 1024, 4095, 4096,
+	};
+	for (size_t offset = 0; offset < 16; offset += 5) {
+		for (size_t size : sizes) {
+			const uint8_t *const p = &buf[offset];
+			MultiHash hash(MultiHash::ALGO_CRC32);
+			hash.update(p, size);
+			hash.finalize();
+			EXPECT_EQ(refCrc32(p, size), hash.hexDigest(MultiHash::ALGO_CRC32)) <<
+				"offset == " << offset << ", size == " << size;
+		}
+	}
+}
+
+/**
+ * Test the one-shot SHA-1 function with various lengths.
+ * This uses the SHA extensions if available, so this
+ * compares the results to a MultiHash object.
+ */
+TEST_F(MultiHashTest, sha1LengthTest)
+{
+	if (!(MultiHash::supportedAlgorithms() & MultiHash::ALGO_SHA1)) {
+		// No crypto backend.
+		return;
+	}
+
+	static const size_t BUF_SIZE = 0x8000;
+	vector<uint8_t> buf(BUF_SIZE);
+	fillBuffer(buf.data(), buf.size());
+
+	static const size_t sizes[] = {
+		0, 1, 3, 55, 56, 63, 64, 65, 119, 120, 127, 128,
+		0xA0, 0x26C, 0x400, 0x7C00, 0x8000,
+	};
+	uint8_t digest[20];
+	for (size_t size : sizes) {
+		MultiHash expected(MultiHash::ALGO_SHA1);
+		expected.update(buf.data(), size);
+		expected.finalize();
+		uint8_t expected_digest[20];
+		ASSERT_EQ(20, expected.digest(MultiHash::ALGO_SHA1, expected_digest, sizeof(expected_digest)));
+
+		ASSERT_EQ(0, MultiHash::sha1(buf.data(), size, digest));
+		EXPECT_EQ(0, memcmp(expected_digest, digest, sizeof(digest))) <<
+			"size == " << size;
+	}
+
+	// Known value: "abc"
+	static const uint8_t abc_sha1[20] = {
+		0xA9,0x99,0x3E,0x36,0x47,0x06,0x81,0x6A,0xBA,0x3E,
+		0x25,0x71,0x78,0x50,0xC2,0x6C,0x9C,0xD0,0xD8,0x9D
+	};
+	ASSERT_EQ(0, MultiHash::sha1("abc", 3, digest));
+	EXPECT_EQ(0, memcmp(abc_sha1, digest, sizeof(digest)));
+}
+
+/**
+ * Test hashFile() on a file larger than the chunk size.
+ * The results should match a single update() call.
+ */
+TEST_F(MultiHashTest, hashFileTest)
+{
+	// 3.5 MB, so the last chunk is a partial chunk.
+	static const size_t FILE_SIZE = (3U * 1024U * 1024U) + (512U * 1024U) + 7U;
+	vector<uint8_t> buf(FILE_SIZE);
+	fillBuffer(buf.data(), buf.size());
+
+	MultiHash expected;
+	expected.update(buf.data(), buf.size());
+	expected.finalize();
+
+	RpMemFile *const memFile = new RpMemFile(buf.data(), buf.size());
+	MultiHash hash;
+	EXPECT_EQ(0, hash.hashFile(memFile));
+	memFile->unref();
+
+	EXPECT_EQ(static_cast<uint64_t>(FILE_SIZE), hash.bytesHashed());
+	for (unsigned int i = 0; i < MultiHash::ALGO_COUNT; i++) {
+		const MultiHash::Algorithm algo = static_cast<MultiHash::Algorithm>(1U << i);
+		if (!(hash.algorithms() & algo))
+			continue;
+		EXPECT_EQ(expected.hexDigest(algo), hash.hexDigest(algo)) <<
+			"algorithm == " << MultiHash::algorithmName(algo);
+	}
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpBase test suite: MultiHash tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,251 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * ReadAheadTest.cpp: ReadAhead class test.                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// ReadAhead
+#include "librpbase/disc/ReadAhead.hpp"
+#include "librpbase/disc/DiscReader.hpp"
+#include "librpbase/disc/PartitionFile.hpp"
+
+// librpfile
+#include "librpfile/RpMemFile.hpp"
+using LibRpFile::RpMemFile;
+
+// C includes. (C++ namespace)
+#include <cstring>
+
+// C++ includes.
+#include <vector>
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+class ReadAheadTest : public ::testing::Test
+{
+	protected:
+		ReadAheadTest()
+			: maxEnd(0)
+		{
+			// Fill the test data with pseudo-random data.
+			// A simple LCG is used so the data is reproducible.
+			data.resize(DATA_SIZE);
+			uint32_t seed = 0x12345678;
+			for (size_t i = 0; i < data.size(); i++) {
+				seed = (seed * 1103515245U) + 12345U;
+				data[i] = static_cast<uint8_t>(seed >> 16);
+			}
+		}
+
+	public:
+		static const size_t DATA_SIZE = 1024U * 1024U;
+
+		// Test data.
+		vector<uint8_t> data;
+		// Sizes of backend reads.
+		vector<size_t> ioSizes;
+		// Highest position read from the backend.
+		off64_t maxEnd;
+
+		/**
+		 * ReadAhead backend read function.
+		 * @param userdata	[in] ReadAheadTest.
+		 * @param pos		[in] Starting position.
+		 * @param ptr		[out] Output data buffer.
+		 * @param size		[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		static size_t backend_pread(void *userdata, off64_t pos, void *ptr, size_t size)
+		{
+			ReadAheadTest *const test = static_cast<ReadAheadTest*>(userdata);
+			test->ioSizes.push_back(size);
+			if (pos >= static_cast<off64_t>(test->data.size()))
+				return 0;
+			if (pos + static_cast<off64_t>(size) > static_cast<off64_t>(test->data.size())) {
+				size = test->data.size() - static_cast<size_t>(pos);
+			}
+			memcpy(ptr, &test->data[static_cast<size_t>(pos)], size);
+			if (pos + static_cast<off64_t>(size) > test->maxEnd) {
+				test->maxEnd = pos + static_cast<off64_t>(size);
+			}
+			return size;
+		}
+};
+
+const size_t ReadAheadTest::DATA_SIZE;
+
+/**
+ * Small sequential reads should be merged into large backend reads,
+ * with the window growing up to the maximum.
+ */
+TEST_F(ReadAheadTest, sequentialSmallReads)
+{
+	ReadAhead readAhead(backend_pread, this);
+	uint8_t buf[64];
+	for (size_t pos = 0; pos < DATA_SIZE; pos += sizeof(buf)) {
+		ASSERT_EQ(sizeof(buf), readAhead.pread(pos, buf, sizeof(buf), DATA_SIZE));
+		ASSERT_EQ(0, memcmp(&data[pos], buf, sizeof(buf))) << "pos == " << pos;
+	}
+
+	const ReadAhead::Stats &stats = readAhead.stats();
+	EXPECT_EQ(DATA_SIZE / sizeof(buf), stats.requests);
+	EXPECT_EQ(static_cast<uint64_t>(DATA_SIZE), stats.requestBytes);
+	EXPECT_EQ(static_cast<uint64_t>(DATA_SIZE), stats.ioBytes);
+	EXPECT_EQ(ReadAhead::DEFAULT_MAX_WINDOW, readAhead.window());
+	EXPECT_EQ(ReadAhead::DEFAULT_MAX_WINDOW, stats.ioMax);
+	// The first SEQ_THRESHOLD reads aren't buffered; the rest of
+	// the data is read using an exponentially-growing window.
+	EXPECT_LT(stats.ioCount, 16U);
+	EXPECT_EQ(stats.ioCount, ioSizes.size());
+}
+
+/**
+ * Random reads should go directly to the backend.
+ */
+TEST_F(ReadAheadTest, randomReads)
+{
+	ReadAhead readAhead(backend_pread, this);
+	uint8_t buf[512];
+	static const off64_t positions[] = {
+		0x80000, 0x1000, 0xF0000, 0x40000, 0x2000, 0x90000, 0x100, 0x7FE00,
+	};
+	for (size_t i = 0; i < ARRAY_SIZE(positions); i++) {
+		const off64_t pos = positions[i];
+		ASSERT_EQ(sizeof(buf), readAhead.pread(pos, buf, sizeof(buf), DATA_SIZE));
+		ASSERT_EQ(0, memcmp(&data[static_cast<size_t>(pos)], buf, sizeof(buf)));
+		EXPECT_EQ(0U, readAhead.window());
+	}
+
+	const ReadAhead::Stats &stats = readAhead.stats();
+	EXPECT_EQ(static_cast<uint64_t>(ARRAY_SIZE(positions)), stats.ioCount);
+	EXPECT_EQ(0U, stats.bufferBytes);
+	EXPECT_EQ(sizeof(buf), stats.ioMax);
+}
+
+/**
+ * A seek during a sequential stream should reset the window,
+ * and the window should grow again if the new stream is sequential.
+ */
+TEST_F(ReadAheadTest, backOffOnSeek)
+{
+	ReadAhead readAhead(backend_pread, this);
+	uint8_t buf[256];
+	off64_t pos = 0;
+	for (int i = 0; i < 256; i++, pos += sizeof(buf)) {
+		ASSERT_EQ(sizeof(buf), readAhead.pread(pos, buf, sizeof(buf), DATA_SIZE));
+	}
+	EXPECT_GT(readAhead.window(), ReadAhead::MIN_WINDOW);
+
+	// Random access outside of the buffer.
+	pos = 0xC0000;
+	ASSERT_EQ(sizeof(buf), readAhead.pread(pos, buf, sizeof(buf), DATA_SIZE));
+	ASSERT_EQ(0, memcmp(&data[static_cast<size_t>(pos)], buf, sizeof(buf)));
+	EXPECT_EQ(0U, readAhead.window());
+	EXPECT_EQ(sizeof(buf), ioSizes.back());
+
+	// Sequential again.
+	for (int i = 0; i < 8; i++) {
+		pos += sizeof(buf);
+		ASSERT_EQ(sizeof(buf), readAhead.pread(pos, buf, sizeof(buf), DATA_SIZE));
+		ASSERT_EQ(0, memcmp(&data[static_cast<size_t>(pos)], buf, sizeof(buf)));
+	}
+	EXPECT_EQ(ReadAhead::MIN_WINDOW, readAhead.window());
+}
+
+/**
+ * Readahead must not read past the specified limit.
+ */
+TEST_F(ReadAheadTest, limit)
+{
+	static const off64_t limit = 100000;
+	ReadAhead readAhead(backend_pread, this);
+	uint8_t buf[100];
+	for (off64_t pos = 0; pos < limit; pos += sizeof(buf)) {
+		ASSERT_EQ(sizeof(buf), readAhead.pread(pos, buf, sizeof(buf), limit));
+		ASSERT_EQ(0, memcmp(&data[static_cast<size_t>(pos)], buf, sizeof(buf)));
+	}
+	EXPECT_EQ(limit, maxEnd);
+}
+
+/**
+ * Sequential reads that are larger than the window
+ * should bypass the readahead buffer.
+ */
+TEST_F(ReadAheadTest, largeReads)
+{
+	ReadAhead readAhead(backend_pread, this);
+	vector<uint8_t> buf(ReadAhead::DEFAULT_MAX_WINDOW);
+	for (size_t pos = 0; pos < DATA_SIZE; pos += buf.size()) {
+		ASSERT_EQ(buf.size(), readAhead.pread(pos, buf.data(), buf.size(), DATA_SIZE));
+		ASSERT_EQ(0, memcmp(&data[pos], buf.data(), buf.size()));
+	}
+
+	const ReadAhead::Stats &stats = readAhead.stats();
+	EXPECT_EQ(DATA_SIZE / buf.size(), stats.ioCount);
+	EXPECT_EQ(0U, stats.bufferBytes);
+}
+
+/**
+ * Readahead with a maximum window of 0 is disabled.
+ */
+TEST_F(ReadAheadTest, disabled)
+{
+	ReadAhead readAhead(backend_pread, this, 0);
+	uint8_t buf[64];
+	for (size_t pos = 0; pos < 64 * sizeof(buf); pos += sizeof(buf)) {
+		ASSERT_EQ(sizeof(buf), readAhead.pread(pos, buf, sizeof(buf), DATA_SIZE));
+	}
+	EXPECT_EQ(64U, readAhead.stats().ioCount);
+	EXPECT_EQ(0U, readAhead.window());
+}
+
+/**
+ * PartitionFile on top of a DiscReader:
+ * Small sequential reads should be merged.
+ */
+TEST_F(ReadAheadTest, partitionFile)
+{
+	RpMemFile *const memFile = new RpMemFile(data.data(), data.size());
+	DiscReader *const discReader = new DiscReader(memFile, 0x1000, -1);
+	memFile->unref();
+	ASSERT_TRUE(discReader->isOpen());
+
+	static const off64_t fileOffset = 0x2000;
+	static const off64_t fileSize = 0x40000;
+	PartitionFile *const ptFile = new PartitionFile(discReader, fileOffset, fileSize);
+	uint8_t buf[32];
+	for (off64_t pos = 0; pos < fileSize; pos += sizeof(buf)) {
+		ASSERT_EQ(sizeof(buf), ptFile->read(buf, sizeof(buf)));
+		ASSERT_EQ(0, memcmp(&data[static_cast<size_t>(0x1000 + fileOffset + pos)], buf, sizeof(buf)));
+	}
+	EXPECT_EQ(0U, ptFile->read(buf, sizeof(buf)));
+
+	const ReadAhead::Stats &stats = ptFile->readAheadStats();
+	EXPECT_EQ(static_cast<uint64_t>(fileSize), stats.ioBytes);
+	EXPECT_LT(stats.ioCount, 8U);
+
+	ptFile->unref();
+	delete discReader;
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpBase test suite: ReadAhead tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
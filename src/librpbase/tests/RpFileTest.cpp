@@ -0,0 +1,159 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * RpFileTest.cpp: RpFile file mode tests.                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// zlib
+#include <zlib.h>
+
+// gzclose_r() and gzclose_w() were introduced in zlib-1.2.4.
+#if (ZLIB_VER_MAJOR > 1) || \
+    (ZLIB_VER_MAJOR == 1 && ZLIB_VER_MINOR > 2) || \
+    (ZLIB_VER_MAJOR == 1 && ZLIB_VER_MINOR == 2 && ZLIB_VER_REVISION >= 4)
+// zlib-1.2.4 or later
+#else
+#define gzclose_r(file) gzclose(file)
+#define gzclose_w(file) gzclose(file)
+#endif
+
+// librpfile
+#include "librpfile/RpFile.hpp"
+using namespace LibRpFile;
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+class RpFileTest : public ::testing::Test
+{
+	public:
+		// Test files.
+		// NOTE: These are copied from librpbase/tests/img/png_data/.
+		static const char gz_filename[];
+		static const char png_filename[];
+
+		/**
+		 * Read an entire file using RpFile.
+		 * @param buf	[out] Output buffer.
+		 * @param file	[in] RpFile.
+		 */
+		static void readAll(vector<uint8_t> &buf, RpFile *file);
+};
+
+const char RpFileTest::gz_filename[] = "png_data/gl_quad.gray.bmp.gz";
+const char RpFileTest::png_filename[] = "png_data/gl_quad.gray.png";
+
+/**
+ * Read an entire file using RpFile.
+ * @param buf	[out] Output buffer.
+ * @param file	[in] RpFile.
+ */
+void RpFileTest::readAll(vector<uint8_t> &buf, RpFile *file)
+{
+	const off64_t fileSize = file->size();
+	ASSERT_GT(fileSize, 0);
+	buf.resize(static_cast<size_t>(fileSize));
+	file->rewind();
+	ASSERT_EQ(buf.size(), file->read(buf.data(), buf.size()));
+}
+
+/**
+ * FM_MMAP must not disable transparent gzip decompression.
+ */
+TEST_F(RpFileTest, gzipWithMmap)
+{
+	// Decompress the file with zlib for reference.
+	gzFile gzf = gzopen(gz_filename, "rb");
+	ASSERT_TRUE(gzf != nullptr) << "gzopen() failed to open " << gz_filename;
+	vector<uint8_t> expected;
+	uint8_t buf[4096];
+	int sz_read;
+	while ((sz_read = gzread(gzf, buf, sizeof(buf))) > 0) {
+		expected.insert(expected.end(), buf, buf + sz_read);
+	}
+	gzclose_r(gzf);
+	ASSERT_EQ(0, sz_read) << "gzread() failed.";
+	ASSERT_GE(expected.size(), 2U);
+	ASSERT_EQ('B', expected[0]);
+	ASSERT_EQ('M', expected[1]);
+
+	// Open the file with and without FM_MMAP.
+	static const RpFile::FileMode modes[] = {
+		RpFile::FM_OPEN_READ_GZ,
+		static_cast<RpFile::FileMode>(RpFile::FM_OPEN_READ_GZ | RpFile::FM_MMAP),
+	};
+	for (size_t i = 0; i < sizeof(modes)/sizeof(modes[0]); i++) {
+		RpFile *const file = new RpFile(gz_filename, modes[i]);
+		ASSERT_TRUE(file->isOpen()) << "mode == " << static_cast<int>(modes[i]);
+
+		// The file should be decompressed.
+		EXPECT_EQ(static_cast<off64_t>(expected.size()), file->size())
+			<< "mode == " << static_cast<int>(modes[i]);
+		vector<uint8_t> data;
+		readAll(data, file);
+		EXPECT_TRUE(expected == data) << "mode == " << static_cast<int>(modes[i]);
+
+		// gzipped files can't be memory-mapped.
+		EXPECT_TRUE(file->view(0, 2) == nullptr) << "mode == " << static_cast<int>(modes[i]);
+		file->unref();
+	}
+}
+
+/**
+ * view() should only map files opened with FM_MMAP.
+ */
+TEST_F(RpFileTest, viewRequiresMmap)
+{
+	RpFile *file = new RpFile(png_filename, RpFile::FM_OPEN_READ);
+	ASSERT_TRUE(file->isOpen());
+	vector<uint8_t> expected;
+	readAll(expected, file);
+	EXPECT_TRUE(file->view(0, expected.size()) == nullptr);
+	file->unref();
+
+	file = new RpFile(png_filename,
+		static_cast<RpFile::FileMode>(RpFile::FM_OPEN_READ | RpFile::FM_MMAP));
+	ASSERT_TRUE(file->isOpen());
+	const uint8_t *const ptr = file->view(0, expected.size());
+	ASSERT_TRUE(ptr != nullptr);
+	EXPECT_EQ(0, memcmp(expected.data(), ptr, expected.size()));
+
+	// Out-of-bounds views are rejected.
+	EXPECT_TRUE(file->view(1, expected.size()) == nullptr);
+
+	// read() still works on a mapped file.
+	vector<uint8_t> data;
+	readAll(data, file);
+	EXPECT_TRUE(expected == data);
+	file->unref();
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpBase test suite: RpFile tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -43,6 +43,12 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		// TODO: Add more syscalls.
 		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
 		// defined in earlier versions, including Ubuntu 14.04.
+
+		// NOTE: Special case for clone(). If it's the first syscall
+		// in the list, it has a parameter restriction added that
+		// ensures it can only be used to create threads.
+		SCMP_SYS(clone),	// LibRpBase::ThreadPool
+
 		SCMP_SYS(fstat),     SCMP_SYS(fstat64),		// __GI___fxstat() [printf()]
 		SCMP_SYS(fstatat64), SCMP_SYS(newfstatat),	// Ubuntu 19.10 (32-bit)
 		SCMP_SYS(futex),	// iconv_open()
@@ -52,6 +58,11 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		SCMP_SYS(mprotect),	// iconv_open()
 		SCMP_SYS(munmap),	// free() [in some cases]
 		SCMP_SYS(lseek), SCMP_SYS(_llseek),
+		SCMP_SYS(mkdir), SCMP_SYS(mkdirat),	// LibRpFile::FileSystem::rmkdir() [DatCompilerTest]
+		SCMP_SYS(unlink), SCMP_SYS(unlinkat),	// LibRpFile::FileSystem::delete_file() [DatCompilerTest]
+		SCMP_SYS(rmdir),	// DatCompilerTest
+		SCMP_SYS(fadvise64), SCMP_SYS(fadvise64_64),	// RpFile::prefetch()
+		SCMP_SYS(inotify_init1), SCMP_SYS(inotify_add_watch),	// LibRpBase::ConfReader
 		SCMP_SYS(open),		// Ubuntu 16.04
 		SCMP_SYS(openat),	// glibc-2.31
 #if defined(__SNR_openat2) || defined(__NR_openat2)
@@ -83,9 +94,11 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 	// Promises:
 	// - stdio: General stdio functionality.
 	// - rpath: Read test cases.
-	param.promises = "stdio rpath";
+	// - wpath: Write test files. [DatCompilerTest]
+	// - cpath: Create and delete test files. [DatCompilerTest]
+	param.promises = "stdio rpath wpath cpath";
 #elif defined(HAVE_TAME)
-	param.tame_flags = TAME_STDIO | TAME_RPATH;
+	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH;
 #else
 	param.dummy = 0;
 #endif
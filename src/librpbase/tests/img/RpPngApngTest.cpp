@@ -0,0 +1,303 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * RpPngApngTest.cpp: APNG writer tests.                                   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// zlib
+#include <zlib.h>
+
+// librpbase
+#include "common.h"
+#include "img/IconAnimData.hpp"
+#include "img/RpPng.hpp"
+#include "img/RpPngWriter.hpp"
+
+// librpfile
+#include "librpfile/RpVectorFile.hpp"
+using namespace LibRpFile;
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+using LibRpTexture::rp_image;
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstring>
+
+// C++ includes.
+#include <memory>
+#include <vector>
+using std::unique_ptr;
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+class RpPngApngTest : public ::testing::Test
+{
+	protected:
+		void TearDown(void) final;
+
+	public:
+		static const int FRAME_W = 16;
+		static const int FRAME_H = 8;
+
+		/**
+		 * Create a CI8 frame with a 16-color palette.
+		 * @param pal_seed	[in] Palette seed.
+		 * @param px_mul	[in] Pixel pattern multiplier.
+		 * @return CI8 rp_image.
+		 */
+		static rp_image *createFrame(uint32_t pal_seed, int px_mul);
+
+		/**
+		 * Parse an APNG image written by RpPngWriter.
+		 * @param png		[in] APNG image data.
+		 * @param palette	[out] PLTE and tRNS as ARGB32.
+		 * @param frames	[out] Color indexes for each frame.
+		 */
+		static void parseAPNG(const vector<uint8_t> &png,
+			vector<uint32_t> &palette, vector<vector<uint8_t> > &frames);
+
+		/**
+		 * Save the animated image and verify the colors of each frame.
+		 * @param expected_pal_len Expected number of PLTE entries.
+		 */
+		void saveAndVerify(int expected_pal_len);
+
+	public:
+		IconAnimData iconAnimData;
+};
+
+/**
+ * TearDown() function.
+ * Run after each test.
+ */
+void RpPngApngTest::TearDown(void)
+{
+	for (int i = 0; i < iconAnimData.count; i++) {
+		delete iconAnimData.frames[i];
+	}
+}
+
+/**
+ * Create a CI8 frame with a 16-color palette.
+ * @param pal_seed	[in] Palette seed.
+ * @param px_mul	[in] Pixel pattern multiplier.
+ * @return CI8 rp_image.
+ */
+rp_image *RpPngApngTest::createFrame(uint32_t pal_seed, int px_mul)
+{
+	rp_image *const img = new rp_image(FRAME_W, FRAME_H, rp_image::FORMAT_CI8);
+	EXPECT_TRUE(img->isValid());
+	EXPECT_GE(img->palette_len(), 16);
+
+	uint32_t *const palette = img->palette();
+	for (unsigned int i = 0; i < 16; i++) {
+		palette[i] = 0xFF000000U | ((pal_seed * (i + 1)) & 0xFFFFFFU);
+	}
+
+	for (int y = 0; y < FRAME_H; y++) {
+		uint8_t *dest = static_cast<uint8_t*>(img->scanLine(y));
+		for (int x = 0; x < FRAME_W; x++, dest++) {
+			*dest = static_cast<uint8_t>(((x * px_mul) + y) & 15);
+		}
+	}
+	return img;
+}
+
+/**
+ * Parse an APNG image written by RpPngWriter.
+ * @param png		[in] APNG image data.
+ * @param palette	[out] PLTE and tRNS as ARGB32.
+ * @param frames	[out] Color indexes for each frame.
+ */
+void RpPngApngTest::parseAPNG(const vector<uint8_t> &png,
+	vector<uint32_t> &palette, vector<vector<uint8_t> > &frames)
+{
+	palette.clear();
+	frames.clear();
+
+	// Compressed data for each frame.
+	vector<vector<uint8_t> > zdata;
+
+	ASSERT_GT(png.size(), 8U);
+	size_t pos = 8;	// skip the PNG signature
+	while (pos + 12 <= png.size()) {
+		const uint32_t chunk_size = (png[pos] << 24) | (png[pos+1] << 16) | (png[pos+2] << 8) | png[pos+3];
+		ASSERT_LE(pos + 12 + chunk_size, png.size());
+		const char *const chunk_name = reinterpret_cast<const char*>(&png[pos+4]);
+		const uint8_t *const data = &png[pos+8];
+
+		if (!memcmp(chunk_name, "IHDR", 4)) {
+			// Must be 8-bit palette.
+			ASSERT_EQ(13U, chunk_size);
+			EXPECT_EQ(8, data[8]) << "Bit depth";
+			EXPECT_EQ(3, data[9]) << "Color type";
+			EXPECT_EQ(0, data[12]) << "Interlace method";
+		} else if (!memcmp(chunk_name, "PLTE", 4)) {
+			ASSERT_EQ(0U, chunk_size % 3);
+			for (uint32_t i = 0; i < chunk_size; i += 3) {
+				palette.push_back(0xFF000000U | (data[i] << 16) | (data[i+1] << 8) | data[i+2]);
+			}
+		} else if (!memcmp(chunk_name, "tRNS", 4)) {
+			ASSERT_LE(chunk_size, palette.size());
+			for (uint32_t i = 0; i < chunk_size; i++) {
+				palette[i] = (palette[i] & 0x00FFFFFFU) | (data[i] << 24);
+			}
+		} else if (!memcmp(chunk_name, "fcTL", 4)) {
+			// New frame.
+			zdata.resize(zdata.size() + 1);
+		} else if (!memcmp(chunk_name, "IDAT", 4)) {
+			// NOTE: The first frame is written as IDAT.
+			ASSERT_EQ(1U, zdata.size()) << "IDAT isn't the first frame.";
+			zdata.back().insert(zdata.back().end(), data, data + chunk_size);
+		} else if (!memcmp(chunk_name, "fdAT", 4)) {
+			// Skip the sequence number.
+			ASSERT_GE(chunk_size, 4U);
+			ASSERT_FALSE(zdata.empty());
+			zdata.back().insert(zdata.back().end(), data + 4, data + chunk_size);
+		}
+		pos += 12 + chunk_size;
+	}
+
+	// Decompress the frames.
+	// NOTE: PROFILE_DEFAULT doesn't use filtering.
+	const size_t row_bytes = FRAME_W + 1;
+	for (size_t i = 0; i < zdata.size(); i++) {
+		vector<uint8_t> raw(row_bytes * FRAME_H);
+		uLongf raw_len = static_cast<uLongf>(raw.size());
+		ASSERT_EQ(Z_OK, uncompress(raw.data(), &raw_len, zdata[i].data(), static_cast<uLong>(zdata[i].size())))
+			<< "Frame " << i;
+		ASSERT_EQ(raw.size(), raw_len) << "Frame " << i;
+
+		vector<uint8_t> frame;
+		frame.reserve(FRAME_W * FRAME_H);
+		for (int y = 0; y < FRAME_H; y++) {
+			const uint8_t *const row = &raw[y * row_bytes];
+			ASSERT_EQ(0, row[0]) << "Frame " << i << ", row " << y << " is filtered.";
+			frame.insert(frame.end(), row + 1, row + row_bytes);
+		}
+		frames.push_back(std::move(frame));
+	}
+}
+
+/**
+ * Save the animated image and verify the colors of each frame.
+ * @param expected_pal_len Expected number of PLTE entries.
+ */
+void RpPngApngTest::saveAndVerify(int expected_pal_len)
+{
+	unique_IRpFile<RpVectorFile> out(new RpVectorFile());
+	int ret = RpPng::save(out.get(), &iconAnimData, RpPngWriter::PROFILE_DEFAULT);
+	if (ret == -ENOTSUP) {
+		fprintf(stderr, "*** APNG write support isn't available; skipping this test.\n");
+		return;
+	}
+	ASSERT_EQ(0, ret);
+
+	vector<uint32_t> palette;
+	vector<vector<uint8_t> > frames;
+	ASSERT_NO_FATAL_FAILURE(parseAPNG(out->vector(), palette, frames));
+	EXPECT_EQ(expected_pal_len, static_cast<int>(palette.size()));
+	ASSERT_EQ(static_cast<size_t>(iconAnimData.seq_count), frames.size());
+
+	// Compare the colors of each frame to the original frame.
+	for (int i = 0; i < iconAnimData.seq_count; i++) {
+		const rp_image *const src = iconAnimData.frames[iconAnimData.seq_index[i]];
+		const uint32_t *const src_pal = src->palette();
+		const uint8_t *px = frames[i].data();
+		for (int y = 0; y < FRAME_H; y++) {
+			const uint8_t *src_px = static_cast<const uint8_t*>(src->scanLine(y));
+			for (int x = 0; x < FRAME_W; x++, px++, src_px++) {
+				ASSERT_LT(*px, palette.size());
+				ASSERT_EQ(src_pal[*src_px], palette[*px])
+					<< "Sequence index " << i << ", pixel (" << x << "," << y << ")";
+			}
+		}
+	}
+}
+
+/**
+ * Frames that share a palette are written with that palette.
+ */
+TEST_F(RpPngApngTest, samePalette)
+{
+	iconAnimData.frames[0] = createFrame(0x123456, 1);
+	iconAnimData.frames[1] = createFrame(0x123456, 3);
+	iconAnimData.count = 2;
+
+	static const uint8_t seq[] = {0, 1, 0};
+	iconAnimData.seq_count = sizeof(seq);
+	for (int i = 0; i < iconAnimData.seq_count; i++) {
+		iconAnimData.seq_index[i] = seq[i];
+		iconAnimData.delays[i].numer = 6;
+		iconAnimData.delays[i].denom = 60;
+		iconAnimData.delays[i].ms = 100;
+	}
+
+	saveAndVerify(iconAnimData.frames[0]->palette_len());
+}
+
+/**
+ * CI8 frames with different palettes are merged into a single PLTE.
+ * (e.g. DSi animated icons)
+ */
+TEST_F(RpPngApngTest, mergedPalette)
+{
+	// Same bitmap with two palettes, plus a different bitmap.
+	iconAnimData.frames[0] = createFrame(0x123456, 1);
+	iconAnimData.frames[1] = createFrame(0x654321, 1);
+	iconAnimData.frames[2] = createFrame(0x0F1E2D, 3);
+	iconAnimData.count = 3;
+
+	static const uint8_t seq[] = {0, 1, 2, 1, 0};
+	iconAnimData.seq_count = sizeof(seq);
+	for (int i = 0; i < iconAnimData.seq_count; i++) {
+		iconAnimData.seq_index[i] = seq[i];
+		iconAnimData.delays[i].numer = 6;
+		iconAnimData.delays[i].denom = 60;
+		iconAnimData.delays[i].ms = 100;
+	}
+
+	saveAndVerify(16*3);
+}
+
+/**
+ * Too many colors for a single PLTE.
+ * The APNG should be written as ARGB32 instead.
+ */
+TEST_F(RpPngApngTest, tooManyColors)
+{
+	for (int i = 0; i < 17; i++) {
+		iconAnimData.frames[i] = createFrame(0x010203 * (i + 1), 1);
+		iconAnimData.seq_index[i] = static_cast<uint8_t>(i);
+		iconAnimData.delays[i].numer = 6;
+		iconAnimData.delays[i].denom = 60;
+		iconAnimData.delays[i].ms = 100;
+	}
+	iconAnimData.count = 17;
+	iconAnimData.seq_count = 17;
+
+	unique_IRpFile<RpVectorFile> out(new RpVectorFile());
+	int ret = RpPng::save(out.get(), &iconAnimData, RpPngWriter::PROFILE_DEFAULT);
+	if (ret == -ENOTSUP) {
+		fprintf(stderr, "*** APNG write support isn't available; skipping this test.\n");
+		return;
+	}
+	ASSERT_EQ(0, ret);
+
+	// Check the IHDR color type.
+	const vector<uint8_t> &png = out->vector();
+	ASSERT_GT(png.size(), 8U + 8U + 13U);
+	ASSERT_EQ(0, memcmp(&png[8+4], "IHDR", 4));
+	EXPECT_EQ(6, png[8+8+9]) << "Color type should be RGB_ALPHA.";
+}
+
+} }
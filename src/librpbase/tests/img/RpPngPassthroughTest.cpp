@@ -0,0 +1,198 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * RpPngPassthroughTest.cpp: PNG pass-through tests.                       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// librpbase
+#include "common.h"
+#include "img/RpPng.hpp"
+#include "img/RpPngWriter.hpp"
+
+// librpfile
+#include "librpfile/RpFile.hpp"
+#include "librpfile/RpMemFile.hpp"
+#include "librpfile/RpVectorFile.hpp"
+using namespace LibRpFile;
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+using LibRpTexture::rp_image;
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstring>
+
+// C++ includes.
+#include <memory>
+#include <string>
+#include <vector>
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+class RpPngPassthroughTest : public ::testing::Test
+{
+	protected:
+		void SetUp(void) final;
+
+		/**
+		 * Count the text chunks with the specified keyword.
+		 * @param png PNG image data.
+		 * @param keyword Keyword.
+		 * @return Number of text chunks with the keyword.
+		 */
+		static int countTextChunks(const vector<uint8_t> &png, const char *keyword);
+
+		/**
+		 * Decode a PNG image.
+		 * @param png PNG image data.
+		 * @return rp_image, or nullptr on error.
+		 */
+		static rp_image *decode(const vector<uint8_t> &png);
+
+	public:
+		// PNG image.
+		vector<uint8_t> m_png_buf;
+};
+
+void RpPngPassthroughTest::SetUp(void)
+{
+	string path = "png_data";
+	path += DIR_SEP_CHR;
+	path += "gl_quad.ARGB32.png";
+	unique_IRpFile<RpFile> file(new RpFile(path, RpFile::FM_OPEN_READ));
+	ASSERT_TRUE(file->isOpen());
+
+	m_png_buf.resize(static_cast<size_t>(file->size()));
+	ASSERT_EQ(m_png_buf.size(), file->read(m_png_buf.data(), m_png_buf.size()));
+}
+
+/**
+ * Count the text chunks with the specified keyword.
+ * @param png PNG image data.
+ * @param keyword Keyword.
+ * @return Number of text chunks with the keyword.
+ */
+int RpPngPassthroughTest::countTextChunks(const vector<uint8_t> &png, const char *keyword)
+{
+	const size_t keyword_len = strlen(keyword);
+	int count = 0;
+	size_t pos = 8;	// skip the PNG signature
+	while (pos + 12 <= png.size()) {
+		const uint32_t chunk_size = (png[pos] << 24) | (png[pos+1] << 16) | (png[pos+2] << 8) | png[pos+3];
+		const char *const chunk_name = reinterpret_cast<const char*>(&png[pos+4]);
+		if ((!memcmp(chunk_name, "tEXt", 4) || !memcmp(chunk_name, "iTXt", 4)) &&
+		    chunk_size > keyword_len &&
+		    !memcmp(&png[pos+8], keyword, keyword_len+1))
+		{
+			count++;
+		}
+		pos += 12 + chunk_size;
+	}
+	return count;
+}
+
+/**
+ * Decode a PNG image.
+ * @param png PNG image data.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *RpPngPassthroughTest::decode(const vector<uint8_t> &png)
+{
+	unique_IRpFile<RpMemFile> file(new RpMemFile(png.data(), png.size()));
+	return RpPng::load(file.get());
+}
+
+/**
+ * Verify the chunks of a valid PNG image.
+ */
+TEST_F(RpPngPassthroughTest, verifyChunks)
+{
+	unique_ptr<rp_image> img(decode(m_png_buf));
+	ASSERT_TRUE(img != nullptr);
+
+	int width = 0, height = 0;
+	EXPECT_EQ(0, RpPng::verifyChunks(m_png_buf.data(), m_png_buf.size(), &width, &height));
+	EXPECT_EQ(img->width(), width);
+	EXPECT_EQ(img->height(), height);
+}
+
+/**
+ * Verify that corrupted PNG images are rejected.
+ */
+TEST_F(RpPngPassthroughTest, verifyChunks_corrupted)
+{
+	// Bad CRC in IHDR.
+	vector<uint8_t> png = m_png_buf;
+	png[8+8] ^= 0xFF;
+	EXPECT_EQ(-EIO, RpPng::verifyChunks(png.data(), png.size()));
+
+	// Truncated image. (IEND is missing)
+	EXPECT_EQ(-EIO, RpPng::verifyChunks(m_png_buf.data(), m_png_buf.size() - 12));
+
+	// Not a PNG image.
+	png = m_png_buf;
+	png[1] = 'X';
+	EXPECT_EQ(-EINVAL, RpPng::verifyChunks(png.data(), png.size()));
+
+	// copy_with_tEXt() must not write anything.
+	RpPngWriter::kv_vector kv;
+	kv.emplace_back("Software", "RpPngPassthroughTest");
+	unique_IRpFile<RpVectorFile> out(new RpVectorFile());
+	EXPECT_NE(0, RpPngWriter::copy_with_tEXt(out.get(), png.data(), png.size(), kv));
+	EXPECT_EQ(0U, out->vector().size());
+}
+
+/**
+ * Copy a PNG image with tEXt chunks added.
+ */
+TEST_F(RpPngPassthroughTest, copy_with_tEXt)
+{
+	RpPngWriter::kv_vector kv;
+	kv.emplace_back("Software", "RpPngPassthroughTest");
+	kv.emplace_back("Thumb::URI", "file:///tmp/a%20rather%20long%20filename.nds");	// >= 40 bytes
+	kv.emplace_back("Thumb::Latin1", "caf\xC3\xA9");	// Latin-1 code point
+	kv.emplace_back("Thumb::UTF8", "\xE3\x83\x86\xE3\x82\xB9\xE3\x83\x88");	// non-Latin-1
+
+	unique_IRpFile<RpVectorFile> out(new RpVectorFile());
+	ASSERT_EQ(0, RpPngWriter::copy_with_tEXt(out.get(), m_png_buf.data(), m_png_buf.size(), kv));
+	const vector<uint8_t> png1 = out->vector();
+	EXPECT_EQ(0, RpPng::verifyChunks(png1.data(), png1.size()));
+	for (auto iter = kv.cbegin(); iter != kv.cend(); ++iter) {
+		EXPECT_EQ(1, countTextChunks(png1, iter->first)) << "Keyword: " << iter->first;
+	}
+
+	// The image data must not be modified.
+	unique_ptr<rp_image> img_orig(decode(m_png_buf));
+	unique_ptr<rp_image> img_copy(decode(png1));
+	ASSERT_TRUE(img_orig != nullptr);
+	ASSERT_TRUE(img_copy != nullptr);
+	ASSERT_EQ(img_orig->width(), img_copy->width());
+	ASSERT_EQ(img_orig->height(), img_copy->height());
+	ASSERT_EQ(img_orig->format(), img_copy->format());
+	for (int y = 0; y < img_orig->height(); y++) {
+		EXPECT_EQ(0, memcmp(img_orig->scanLine(y), img_copy->scanLine(y), img_orig->row_bytes()))
+			<< "Scanline " << y << " differs.";
+	}
+
+	// Copying the new image again should replace the
+	// existing text chunks instead of duplicating them.
+	unique_IRpFile<RpVectorFile> out2(new RpVectorFile());
+	ASSERT_EQ(0, RpPngWriter::copy_with_tEXt(out2.get(), png1.data(), png1.size(), kv));
+	const vector<uint8_t> &png2 = out2->vector();
+	EXPECT_EQ(png1.size(), png2.size());
+	for (auto iter = kv.cbegin(); iter != kv.cend(); ++iter) {
+		EXPECT_EQ(1, countTextChunks(png2, iter->first)) << "Keyword: " << iter->first;
+	}
+}
+
+} }
@@ -94,58 +94,9 @@ void DualFile::close(void)
  */
 size_t DualFile::read(void *ptr, size_t size)
 {
-	if (!m_file[0] || !m_file[1]) {
-		m_lastError = EBADF;
-		return 0;
-	}
-
-	if (unlikely(size == 0)) {
-		// Not reading anything...
-		return 0;
-	}
-
-	// uint8_t pointer access.
-	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
-
-	// Check if the read is fully within file 0.
-	if (m_pos < m_size[0] && ((m_pos + static_cast<off64_t>(size)) < m_size[0])) {
-		// Read is fully within file 0.
-		const size_t sz_read = m_file[0]->seekAndRead(m_pos, ptr8, size);
-		m_lastError = m_file[0]->lastError();
-		m_pos += sz_read;
-		return sz_read;
-	}
-
-	// Check if the read is fully within file 1.
-	if (m_pos >= m_size[0]) {
-		// Fully within file 1.
-		// NOTE: If the size is past the bounds, the read will be truncated.
-		const size_t sz_read = m_file[1]->seekAndRead(m_pos - m_size[0], ptr8, size);
-		m_lastError = m_file[1]->lastError();
-		m_pos += sz_read;
-		return sz_read;
-	}
-
-	// Read crosses the boundary between file 0 and file 1.
-
-	// File 0 portion.
-	const size_t file0_sz = m_size[0] - m_pos;
-	size_t sz0_read = m_file[0]->seekAndRead(m_pos, ptr8, file0_sz);
-	m_lastError = m_file[0]->lastError();
-	m_pos += sz0_read;
-	if (sz0_read != file0_sz) {
-		// Short read.
-		return sz0_read;
-	}
-	size -= sz0_read;
-	ptr8 += sz0_read;
-
-	// File 1 portion.
-	size_t sz1_read = m_file[1]->seekAndRead(0, ptr8, size);
-	m_lastError = m_file[1]->lastError();
-	m_pos += sz1_read;
-
-	return (sz0_read + sz1_read);
+	const size_t ret = this->pread(m_pos, ptr, size);
+	m_pos += ret;
+	return ret;
 }
 
 /**
@@ -244,4 +195,69 @@ string DualFile::filename(void) const
 	return string();
 }
 
+/** Positional reads **/
+
+/**
+ * Read data from the specified position.
+ * The file position is not changed.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t DualFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	if (!m_file[0] || !m_file[1]) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
+	}
+
+	if (unlikely(size == 0)) {
+		// Not reading anything...
+		return 0;
+	}
+
+	// uint8_t pointer access.
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+
+	// Check if the read is fully within file 0.
+	if (pos < m_size[0] && ((pos + static_cast<off64_t>(size)) < m_size[0])) {
+		// Read is fully within file 0.
+		const size_t sz_read = m_file[0]->pread(pos, ptr8, size);
+		m_lastError = m_file[0]->lastError();
+		return sz_read;
+	}
+
+	// Check if the read is fully within file 1.
+	if (pos >= m_size[0]) {
+		// Fully within file 1.
+		// NOTE: If the size is past the bounds, the read will be truncated.
+		const size_t sz_read = m_file[1]->pread(pos - m_size[0], ptr8, size);
+		m_lastError = m_file[1]->lastError();
+		return sz_read;
+	}
+
+	// Read crosses the boundary between file 0 and file 1.
+
+	// File 0 portion.
+	const size_t file0_sz = static_cast<size_t>(m_size[0] - pos);
+	size_t sz0_read = m_file[0]->pread(pos, ptr8, file0_sz);
+	m_lastError = m_file[0]->lastError();
+	if (sz0_read != file0_sz) {
+		// Short read.
+		return sz0_read;
+	}
+	size -= sz0_read;
+	ptr8 += sz0_read;
+
+	// File 1 portion.
+	size_t sz1_read = m_file[1]->pread(0, ptr8, size);
+	m_lastError = m_file[1]->lastError();
+
+	return (sz0_read + sz1_read);
+}
+
 }
@@ -0,0 +1,64 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * FileView.cpp: Read-only view of a range of an IRpFile.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "FileView.hpp"
+
+namespace LibRpFile {
+
+/**
+ * Get a read-only view of a range of an IRpFile.
+ * @param file	[in] IRpFile
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @param align	[in,opt] Required alignment of data(), in bytes. (power of 2; 0 for none)
+ */
+FileView::FileView(IRpFile *file, off64_t pos, size_t size, size_t align)
+	: m_data(nullptr)
+	, m_size(0)
+	, m_buf(nullptr)
+{
+	assert(file != nullptr);
+	assert(align == 0 || (align & (align - 1)) == 0);
+	if (!file || size == 0) {
+		return;
+	}
+	if (align == 0) {
+		align = 1;
+	}
+
+	// Try a zero-copy view first.
+	const uint8_t *const pView = file->view(pos, size);
+	if (pView && (reinterpret_cast<uintptr_t>(pView) & (align - 1)) == 0) {
+		m_data = pView;
+		m_size = size;
+		return;
+	}
+
+	// Zero-copy views aren't supported, or the view isn't
+	// aligned correctly. Read the data into a buffer.
+	// NOTE: Allocating extra space for manual alignment.
+	m_buf = new uint8_t[size + align - 1];
+	uint8_t *const pAligned = reinterpret_cast<uint8_t*>(
+		(reinterpret_cast<uintptr_t>(m_buf) + (align - 1)) & ~static_cast<uintptr_t>(align - 1));
+	m_size = file->seekAndRead(pos, pAligned, size);
+	if (m_size == 0) {
+		// Seek and/or read error.
+		delete[] m_buf;
+		m_buf = nullptr;
+		return;
+	}
+	m_data = pAligned;
+}
+
+FileView::~FileView()
+{
+	delete[] m_buf;
+}
+
+}
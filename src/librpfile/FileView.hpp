@@ -0,0 +1,79 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * FileView.hpp: Read-only view of a range of an IRpFile.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_FILEVIEW_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_FILEVIEW_HPP__
+
+#include "IRpFile.hpp"
+
+namespace LibRpFile {
+
+/**
+ * Read-only view of a range of an IRpFile.
+ *
+ * If the file supports zero-copy views (e.g. a memory-mapped
+ * RpFile or an RpMemFile), the data is referenced directly.
+ * Otherwise, the range is read into an internal buffer.
+ *
+ * The IRpFile must remain open while the FileView is in use.
+ */
+class FileView
+{
+	public:
+		/**
+		 * Get a read-only view of a range of an IRpFile.
+		 * @param file	[in] IRpFile
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @param align	[in,opt] Required alignment of data(), in bytes. (power of 2; 0 for none)
+		 */
+		FileView(IRpFile *file, off64_t pos, size_t size, size_t align = 0);
+		~FileView();
+
+	private:
+		RP_DISABLE_COPY(FileView)
+
+	public:
+		/**
+		 * Get the data.
+		 * @return Data, or nullptr on error.
+		 */
+		inline const uint8_t *data(void) const
+		{
+			return m_data;
+		}
+
+		/**
+		 * Get the number of bytes available.
+		 * This may be less than the requested size
+		 * if a short read occurred.
+		 * @return Number of bytes available.
+		 */
+		inline size_t size(void) const
+		{
+			return m_size;
+		}
+
+		/**
+		 * Is the data referenced directly from the file?
+		 * @return True if zero-copy; false if the data was read into a buffer.
+		 */
+		inline bool isZeroCopy(void) const
+		{
+			return (m_data != nullptr && m_buf == nullptr);
+		}
+
+	private:
+		const uint8_t *m_data;	// Data pointer.
+		size_t m_size;		// Data size.
+		uint8_t *m_buf;		// Allocated buffer. (nullptr if zero-copy)
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_FILEVIEW_HPP__ */
@@ -53,6 +53,99 @@ void IRpFile::unref(void)
 	ATOMIC_DEC_FETCH(&ms_refCntTotal);
 }
 
+/**
+ * Get a read-only view of a range of the file.
+ *
+ * Default implementation: Views are not supported.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return Pointer to the data, or nullptr if views are not supported or the range is out of bounds.
+ */
+const uint8_t *IRpFile::view(off64_t pos, size_t size)
+{
+	RP_UNUSED(pos);
+	RP_UNUSED(size);
+	return nullptr;
+}
+
+/**
+ * Hint that a range of the file will be read soon.
+ *
+ * Default implementation: Hints are ignored.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int IRpFile::prefetch(off64_t pos, size_t size)
+{
+	RP_UNUSED(pos);
+	RP_UNUSED(size);
+	return 0;
+}
+
+/** Positional reads **/
+
+/**
+ * Read data from the specified position.
+ *
+ * Default implementation: Save the file position,
+ * seek and read, then restore the file position.
+ *
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t IRpFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	const off64_t cur_pos = this->tell();
+	if (cur_pos < 0) {
+		// Unable to get the current position.
+		return 0;
+	}
+
+	size_t ret = 0;
+	if (this->seek(pos) == 0) {
+		ret = this->read(ptr, size);
+	}
+
+	// Restore the file position.
+	// NOTE: Don't let seek() overwrite the read error.
+	const int lastError = m_lastError;
+	this->seek(cur_pos);
+	m_lastError = lastError;
+	return ret;
+}
+
+/**
+ * Read data from the specified position into multiple buffers.
+ *
+ * Default implementation: Call pread() for each buffer.
+ *
+ * @param pos	[in] Starting position.
+ * @param iov	[in] Output buffers.
+ * @param iovcnt [in] Number of output buffers.
+ * @return Total number of bytes read.
+ */
+size_t IRpFile::preadv(off64_t pos, const IoVec *iov, int iovcnt)
+{
+	size_t ret = 0;
+	for (; iovcnt > 0; iovcnt--, iov++) {
+		if (iov->size == 0)
+			continue;
+
+		const size_t sz_read = this->pread(pos + ret, iov->ptr, iov->size);
+		ret += sz_read;
+		if (sz_read != iov->size) {
+			// Short read.
+			break;
+		}
+	}
+	return ret;
+}
+
 /**
  * Get a single character (byte) from the file
  * @return Character from file, or EOF on end of file or error.
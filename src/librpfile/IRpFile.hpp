@@ -24,6 +24,15 @@
 
 namespace LibRpFile {
 
+/**
+ * Scatter buffer for IRpFile::preadv().
+ * Same layout as POSIX struct iovec.
+ */
+struct IoVec {
+	void *ptr;	// Output data buffer.
+	size_t size;	// Size of the buffer, in bytes.
+};
+
 class IRpFile
 {
 	protected:
@@ -148,6 +157,86 @@ class IRpFile
 			return false;
 		}
 
+	public:
+		/** Zero-copy access **/
+
+		/**
+		 * Get a read-only view of a range of the file.
+		 *
+		 * If supported, this returns a pointer directly into the
+		 * file's backing storage, e.g. a memory-mapped file or
+		 * a memory buffer. No data is copied, and the file
+		 * position is not changed.
+		 *
+		 * The pointer remains valid until the file is closed
+		 * or deleted. It must NOT be written to.
+		 *
+		 * NOTE: Use FileView instead of calling this function
+		 * directly, since FileView falls back to read() if views
+		 * aren't supported by the file.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return Pointer to the data, or nullptr if views are not supported or the range is out of bounds.
+		 */
+		virtual const uint8_t *view(off64_t pos, size_t size);
+
+		/**
+		 * Hint that a range of the file will be read soon.
+		 *
+		 * If supported, the underlying I/O is started in the
+		 * background, so a subsequent read() of this range
+		 * doesn't have to wait for the device. Callers that
+		 * know which ranges they'll need next (e.g. a disc
+		 * FST and banner) can issue hints for all of them
+		 * up front to overlap the I/O latency.
+		 *
+		 * This is only a hint. The file position is not changed,
+		 * and implementations may ignore it entirely.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+		 */
+		virtual int prefetch(off64_t pos, size_t size);
+
+	public:
+		/** Positional reads **/
+
+		/**
+		 * Read data from the specified position.
+		 *
+		 * Unlike seekAndRead(), the file position is not changed,
+		 * so this can be used on a file that's shared with
+		 * other readers.
+		 *
+		 * The default implementation saves the file position,
+		 * does a seek and read, and then restores the position.
+		 * Subclasses should override this with a native version.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		virtual size_t pread(off64_t pos, void *ptr, size_t size);
+
+		/**
+		 * Read data from the specified position into multiple buffers.
+		 *
+		 * The buffers are filled in order, starting at pos.
+		 * Reading stops at the first short read.
+		 * The file position is not changed.
+		 *
+		 * The default implementation calls pread() for each buffer.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param iov	[in] Output buffers.
+		 * @param iovcnt [in] Number of output buffers.
+		 * @return Total number of bytes read.
+		 */
+		virtual size_t preadv(off64_t pos, const IoVec *iov, int iovcnt);
+
 	public:
 		/** Convenience functions implemented for all IRpFile classes. **/
 
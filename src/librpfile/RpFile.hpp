@@ -44,6 +44,14 @@ class RpFile : public IRpFile
 			// Extras.
 			FM_GZIP_DECOMPRESS = 4,	// Transparent gzip decompression. (read-only!)
 			FM_OPEN_READ_GZ = FM_READ | FM_GZIP_DECOMPRESS,
+
+			// Allow view() to memory-map the file. (read-only!)
+			// WARNING: If another process truncates the file while
+			// it's mapped, accessing a view will raise SIGBUS.
+			// Only use this for files that are replaced instead of
+			// being truncated, or in processes where a crash is
+			// acceptable, e.g. rpcli.
+			FM_MMAP = 8,
 		};
 
 		/**
@@ -130,6 +138,73 @@ class RpFile : public IRpFile
 		 */
 		std::string filename(void) const final;
 
+	public:
+		/** Zero-copy access **/
+
+		/**
+		 * Get a read-only view of a range of the file.
+		 *
+		 * Regular files opened read-only with FM_MMAP are
+		 * memory-mapped on the first call to this function.
+		 * gzipped files, device files, writable files, and
+		 * files opened without FM_MMAP are not supported.
+		 *
+		 * If the file has been truncated since it was mapped,
+		 * nullptr is returned, and the caller should fall back
+		 * to read().
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return Pointer to the data, or nullptr if views are not supported or the range is out of bounds.
+		 */
+		const uint8_t *view(off64_t pos, size_t size) final;
+
+		/**
+		 * Hint that a range of the file will be read soon.
+		 *
+		 * On systems with posix_fadvise(), this starts kernel
+		 * readahead for the range. Ignored for gzipped files
+		 * and device files.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+		 */
+		int prefetch(off64_t pos, size_t size) final;
+
+	public:
+		/** Positional reads **/
+
+		/**
+		 * Read data from the specified position.
+		 * The file position is not changed.
+		 *
+		 * Regular files use pread() (or ReadFile() with an
+		 * OVERLAPPED offset on Windows), bypassing stdio.
+		 * gzipped files and device files fall back to
+		 * seek and read.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t pread(off64_t pos, void *ptr, size_t size) final;
+
+		/**
+		 * Read data from the specified position into multiple buffers.
+		 * The file position is not changed.
+		 *
+		 * On systems with preadv(), regular files are read
+		 * using a single system call.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param iov	[in] Output buffers.
+		 * @param iovcnt [in] Number of output buffers.
+		 * @return Total number of bytes read.
+		 */
+		size_t preadv(off64_t pos, const IoVec *iov, int iovcnt) final;
+
 	public:
 		/** Device file functions **/
 
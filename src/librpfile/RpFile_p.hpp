@@ -12,6 +12,9 @@
 #include "config.librpfile.h"
 #include "RpFile.hpp"
 
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+
 // C includes. (C++ namespace)
 #include <cassert>
 
@@ -75,10 +78,20 @@ class RpFilePrivate
 
 		RpFilePrivate(RpFile *q, const char *filename, RpFile::FileMode mode)
 			: q_ptr(q), file(FILE_INIT), filename(filename)
-			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr) { }
+			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr)
+			, map_ptr(nullptr), map_sz(0), map_tried(false)
+#ifdef _WIN32
+			, hMapping(nullptr)
+#endif /* _WIN32 */
+			{ }
 		RpFilePrivate(RpFile *q, const string &filename, RpFile::FileMode mode)
 			: q_ptr(q), file(FILE_INIT), filename(filename)
-			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr) { }
+			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr)
+			, map_ptr(nullptr), map_sz(0), map_tried(false)
+#ifdef _WIN32
+			, hMapping(nullptr)
+#endif /* _WIN32 */
+			{ }
 		~RpFilePrivate();
 
 	private:
@@ -169,6 +182,17 @@ class RpFilePrivate
 
 		DeviceInfo *devInfo;
 
+		// Read-only memory mapping of the entire file.
+		// Created on demand by RpFile::view() if FM_MMAP is set.
+		// NOTE: mapFile() must be called with mtxMap locked.
+		LibRpBase::Mutex mtxMap;
+		const uint8_t *map_ptr;	// Mapped data.
+		size_t map_sz;		// Mapped size.
+		bool map_tried;		// True if mapping was attempted.
+#ifdef _WIN32
+		HANDLE hMapping;	// File mapping object.
+#endif /* _WIN32 */
+
 	public:
 #ifdef _WIN32
 		/**
@@ -203,6 +227,25 @@ class RpFilePrivate
 		 */
 		int reOpenFile(void);
 
+		/**
+		 * Map the entire file into memory. (read-only)
+		 *
+		 * Only regular files opened in read-only mode with
+		 * FM_MMAP and without transparent decompression can
+		 * be mapped. If mapping fails, it won't be attempted
+		 * again until the file is reopened.
+		 *
+		 * NOTE: mtxMap must be locked by the caller.
+		 *
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int mapFile(void);
+
+		/**
+		 * Unmap the file if it's currently mapped.
+		 */
+		void unmapFile(void);
+
 	public:
 		/**
 		 * Read one sector into the sector cache.
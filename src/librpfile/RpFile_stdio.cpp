@@ -18,8 +18,12 @@
 
 // C includes.
 #include <fcntl.h>	// AT_EMPTY_PATH
+#include <sys/mman.h>	// mmap(), munmap()
 #include <sys/stat.h>	// stat(), statx()
-#include <unistd.h>	// ftruncate()
+#include <unistd.h>	// ftruncate(), pread()
+#ifdef HAVE_PREADV
+# include <sys/uio.h>	// preadv()
+#endif /* HAVE_PREADV */
 
 namespace LibRpFile {
 
@@ -27,6 +31,7 @@ namespace LibRpFile {
 
 RpFilePrivate::~RpFilePrivate()
 {
+	unmapFile();
 	if (gzfd) {
 		gzclose_r(gzfd);
 	}
@@ -72,6 +77,8 @@ int RpFilePrivate::reOpenFile(void)
 	const char *const mode_str = mode_to_str(mode);
 
 	// Linux: Use UTF-8 filenames directly.
+	unmapFile();
+	map_tried = false;
 	if (file) {
 		fclose(file);
 	}
@@ -196,6 +203,69 @@ int RpFilePrivate::reOpenFile(void)
 	return 0;
 }
 
+/**
+ * Map the entire file into memory. (read-only)
+ *
+ * Only regular files opened in read-only mode with
+ * FM_MMAP and without transparent decompression can
+ * be mapped. If mapping fails, it won't be attempted
+ * again until the file is reopened.
+ *
+ * NOTE: mtxMap must be locked by the caller.
+ *
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFilePrivate::mapFile(void)
+{
+	if (map_ptr) {
+		// Already mapped.
+		return 0;
+	} else if (map_tried) {
+		// Mapping was already attempted and failed.
+		return -ENOTSUP;
+	}
+	map_tried = true;
+
+	if (!file || devInfo || gzfd || (mode & RpFile::FM_WRITE) || !(mode & RpFile::FM_MMAP)) {
+		// Mapping is not supported for this file.
+		return -ENOTSUP;
+	}
+
+	struct stat sb;
+	if (fstat(fileno(file), &sb) != 0) {
+		return -errno;
+	} else if (!S_ISREG(sb.st_mode) || sb.st_size <= 0) {
+		// Not a regular file, or the file is empty.
+		return -ENOTSUP;
+	}
+	if (static_cast<uint64_t>(sb.st_size) > static_cast<uint64_t>(SIZE_MAX)) {
+		// File is too big to map on this system.
+		return -ENOMEM;
+	}
+
+	const size_t sz = static_cast<size_t>(sb.st_size);
+	void *const ptr = mmap(nullptr, sz, PROT_READ, MAP_SHARED, fileno(file), 0);
+	if (ptr == MAP_FAILED) {
+		return -errno;
+	}
+
+	map_ptr = static_cast<const uint8_t*>(ptr);
+	map_sz = sz;
+	return 0;
+}
+
+/**
+ * Unmap the file if it's currently mapped.
+ */
+void RpFilePrivate::unmapFile(void)
+{
+	if (map_ptr) {
+		munmap(const_cast<uint8_t*>(map_ptr), map_sz);
+		map_ptr = nullptr;
+		map_sz = 0;
+	}
+}
+
 /** RpFile **/
 
 /**
@@ -248,7 +318,8 @@ void RpFile::init(void)
 	// Check if this is a gzipped file.
 	// If it is, use transparent decompression.
 	// Reference: https://www.forensicswiki.org/wiki/Gzip
-	if (d->mode == FM_OPEN_READ_GZ) {
+	// NOTE: FM_MMAP doesn't affect decompression.
+	if ((d->mode & ~FM_MMAP) == FM_OPEN_READ_GZ) {
 		uint16_t gzmagic;
 		size_t size = fread(&gzmagic, 1, sizeof(gzmagic), d->file);
 		if (size == sizeof(gzmagic) && gzmagic == be16_to_cpu(0x1F8B)) {
@@ -328,6 +399,7 @@ void RpFile::close(void)
 		d->devInfo->close();
 	}
 
+	d->unmapFile();
 	if (d->gzfd) {
 		gzclose_r(d->gzfd);
 		d->gzfd = nullptr;
@@ -562,6 +634,230 @@ string RpFile::filename(void) const
 	return d->filename;
 }
 
+/** Zero-copy access **/
+
+/**
+ * Get a read-only view of a range of the file.
+ *
+ * Regular files opened read-only with FM_MMAP are
+ * memory-mapped on the first call to this function.
+ * gzipped files, device files, writable files, and
+ * files opened without FM_MMAP are not supported.
+ *
+ * If the file has been truncated since it was mapped,
+ * nullptr is returned, and the caller should fall back
+ * to read().
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return Pointer to the data, or nullptr if views are not supported or the range is out of bounds.
+ */
+const uint8_t *RpFile::view(off64_t pos, size_t size)
+{
+	RP_D(RpFile);
+	LibRpBase::MutexLocker mtxLocker(d->mtxMap);
+	if (!d->map_ptr) {
+		if (d->mapFile() != 0) {
+			// Unable to map the file.
+			// NOTE: Not setting m_lastError, since the
+			// caller is expected to fall back to read().
+			return nullptr;
+		}
+	}
+
+	// Make sure the file hasn't been truncated since it was mapped.
+	// Accessing pages past the end of the file raises SIGBUS.
+	// NOTE: This doesn't protect against truncation after the
+	// view is returned; that's why FM_MMAP is opt-in.
+	struct stat sb;
+	if (fstat(fileno(d->file), &sb) != 0 ||
+	    static_cast<uint64_t>(sb.st_size) < static_cast<uint64_t>(d->map_sz))
+	{
+		// File was truncated. Caller should fall back to read().
+		return nullptr;
+	}
+
+	// Check if the range is in bounds.
+	if (pos < 0 || static_cast<uint64_t>(pos) > d->map_sz ||
+	    size > d->map_sz - static_cast<size_t>(pos))
+	{
+		m_lastError = EINVAL;
+		return nullptr;
+	}
+
+	return d->map_ptr + static_cast<size_t>(pos);
+}
+
+/**
+ * Hint that a range of the file will be read soon.
+ *
+ * On systems with posix_fadvise(), this starts kernel
+ * readahead for the range. Ignored for gzipped files
+ * and device files.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int RpFile::prefetch(off64_t pos, size_t size)
+{
+	RP_D(RpFile);
+	if (!d->file) {
+		m_lastError = EBADF;
+		return -EBADF;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return -EINVAL;
+	}
+
+	if (d->devInfo || d->gzfd || size == 0) {
+		// Not supported for this file.
+		return 0;
+	}
+
+#ifdef HAVE_POSIX_FADVISE
+	// NOTE: posix_fadvise() returns the error code
+	// instead of setting errno.
+	const int ret = posix_fadvise(fileno(d->file), pos, size, POSIX_FADV_WILLNEED);
+	if (ret != 0) {
+		m_lastError = ret;
+		return -ret;
+	}
+#endif /* HAVE_POSIX_FADVISE */
+	return 0;
+}
+
+/** Positional reads **/
+
+/**
+ * Read data from the specified position.
+ * The file position is not changed.
+ *
+ * Regular files use pread(), bypassing stdio.
+ * gzipped files and device files fall back to
+ * seek and read.
+ *
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	RP_D(RpFile);
+	if (!d->file) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
+	}
+
+	if (d->devInfo || d->gzfd) {
+		// Block devices need sector-aligned reads,
+		// and gzipped files can only be read sequentially.
+		return super::pread(pos, ptr, size);
+	}
+
+	if (d->mode & FM_WRITE) {
+		// Make sure buffered writes are visible to pread().
+		::fflush(d->file);
+	}
+
+	const int fd = fileno(d->file);
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t ret = 0;
+	while (size > 0) {
+		const ssize_t sz_read = ::pread(fd, ptr8, size, pos);
+		if (sz_read < 0) {
+			if (errno == EINTR)
+				continue;
+			// An error occurred.
+			m_lastError = errno;
+			break;
+		} else if (sz_read == 0) {
+			// End of file.
+			break;
+		}
+
+		ptr8 += sz_read;
+		size -= sz_read;
+		pos += sz_read;
+		ret += sz_read;
+	}
+	return ret;
+}
+
+/**
+ * Read data from the specified position into multiple buffers.
+ * The file position is not changed.
+ *
+ * On systems with preadv(), regular files are read
+ * using a single system call.
+ *
+ * @param pos	[in] Starting position.
+ * @param iov	[in] Output buffers.
+ * @param iovcnt [in] Number of output buffers.
+ * @return Total number of bytes read.
+ */
+size_t RpFile::preadv(off64_t pos, const IoVec *iov, int iovcnt)
+{
+#ifdef HAVE_PREADV
+	RP_D(RpFile);
+	// NOTE: IOV_MAX is at least 16 on all POSIX systems.
+	static const int IOV_COUNT_MAX = 16;
+	if (!d->file || pos < 0 || d->devInfo || d->gzfd ||
+	    (d->mode & FM_WRITE) || iovcnt <= 1 || iovcnt > IOV_COUNT_MAX)
+	{
+		// Not handled here.
+		return super::preadv(pos, iov, iovcnt);
+	}
+
+	struct iovec sys_iov[IOV_COUNT_MAX];
+	size_t total = 0;
+	for (int i = 0; i < iovcnt; i++) {
+		sys_iov[i].iov_base = iov[i].ptr;
+		sys_iov[i].iov_len = iov[i].size;
+		total += iov[i].size;
+	}
+
+	ssize_t sz_read;
+	do {
+		sz_read = ::preadv(fileno(d->file), sys_iov, iovcnt, pos);
+	} while (sz_read < 0 && errno == EINTR);
+	if (sz_read < 0) {
+		// An error occurred.
+		m_lastError = errno;
+		return 0;
+	} else if (static_cast<size_t>(sz_read) == total || sz_read == 0) {
+		// Full read, or end of file.
+		return static_cast<size_t>(sz_read);
+	}
+
+	// Short read. Read the rest of the data one buffer at a time.
+	size_t ret = static_cast<size_t>(sz_read);
+	size_t skip = ret;
+	for (; iovcnt > 0; iovcnt--, iov++) {
+		if (skip >= iov->size) {
+			skip -= iov->size;
+			continue;
+		}
+
+		const size_t remain = iov->size - skip;
+		const size_t sz = this->pread(pos + ret, static_cast<uint8_t*>(iov->ptr) + skip, remain);
+		ret += sz;
+		skip = 0;
+		if (sz != remain) {
+			// Short read.
+			break;
+		}
+	}
+	return ret;
+#else /* !HAVE_PREADV */
+	return super::preadv(pos, iov, iovcnt);
+#endif /* HAVE_PREADV */
+}
+
 /** Device file functions **/
 
 /**
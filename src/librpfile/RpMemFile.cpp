@@ -198,4 +198,68 @@ string RpMemFile::filename(void) const
 	return string();
 }
 
+/** Zero-copy access **/
+
+/**
+ * Get a read-only view of a range of the file.
+ * For RpMemFile, this is a pointer into the memory buffer.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return Pointer to the data, or nullptr if the range is out of bounds.
+ */
+const uint8_t *RpMemFile::view(off64_t pos, size_t size)
+{
+	if (!m_buf) {
+		m_lastError = EBADF;
+		return nullptr;
+	}
+
+	// Check if the range is in bounds.
+	if (pos < 0 || static_cast<uint64_t>(pos) > m_size ||
+	    size > m_size - static_cast<size_t>(pos))
+	{
+		m_lastError = EINVAL;
+		return nullptr;
+	}
+
+	return static_cast<const uint8_t*>(m_buf) + static_cast<size_t>(pos);
+}
+
+/** Positional reads **/
+
+/**
+ * Read data from the specified position.
+ * The file position is not changed.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpMemFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	if (!m_buf) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
+	}
+
+	// Check if the range is in bounds.
+	if (static_cast<uint64_t>(pos) >= m_size) {
+		// Nothing to read.
+		return 0;
+	} else if (size > m_size - static_cast<size_t>(pos)) {
+		// Not enough data.
+		// Copy whatever's left in the buffer.
+		size = m_size - static_cast<size_t>(pos);
+	}
+
+	// Copy the data.
+	const uint8_t *const buf = static_cast<const uint8_t*>(m_buf);
+	memcpy(ptr, &buf[static_cast<size_t>(pos)], size);
+	return size;
+}
+
 }
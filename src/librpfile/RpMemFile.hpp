@@ -106,6 +106,32 @@ class RpMemFile : public IRpFile
 		 */
 		std::string filename(void) const final;
 
+	public:
+		/** Zero-copy access **/
+
+		/**
+		 * Get a read-only view of a range of the file.
+		 * For RpMemFile, this is a pointer into the memory buffer.
+		 *
+		 * @param pos	[in] Starting position.
+		 * @param size	[in] Number of bytes.
+		 * @return Pointer to the data, or nullptr if the range is out of bounds.
+		 */
+		const uint8_t *view(off64_t pos, size_t size) final;
+
+	public:
+		/** Positional reads **/
+
+		/**
+		 * Read data from the specified position.
+		 * The file position is not changed.
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t pread(off64_t pos, void *ptr, size_t size) final;
+
 	protected:
 		const void *m_buf;	// Memory buffer.
 		size_t m_size;		// Size of memory buffer.
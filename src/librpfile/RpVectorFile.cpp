@@ -164,4 +164,37 @@ string RpVectorFile::filename(void) const
 	return string();
 }
 
+/** Positional reads **/
+
+/**
+ * Read data from the specified position.
+ * The file position is not changed.
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpVectorFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
+	}
+
+	// Check if the range is in bounds.
+	const size_t vec_size = m_vector.size();
+	if (static_cast<uint64_t>(pos) >= vec_size) {
+		// Nothing to read.
+		return 0;
+	} else if (size > vec_size - static_cast<size_t>(pos)) {
+		// Not enough data.
+		// Copy whatever's left in the buffer.
+		size = vec_size - static_cast<size_t>(pos);
+	}
+
+	// Copy the data.
+	memcpy(ptr, &m_vector[static_cast<size_t>(pos)], size);
+	return size;
+}
+
 }
@@ -95,6 +95,19 @@ class RpVectorFile : public IRpFile
 		 */
 		std::string filename(void) const final;
 
+	public:
+		/** Positional reads **/
+
+		/**
+		 * Read data from the specified position.
+		 * The file position is not changed.
+		 * @param pos	[in] Starting position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t pread(off64_t pos, void *ptr, size_t size) final;
+
 	public:
 		/** RpVectorFile-specific functions **/
 
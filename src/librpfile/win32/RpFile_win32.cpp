@@ -40,6 +40,7 @@ DELAYLOAD_TEST_FUNCTION_IMPL0(zlibVersion);
 
 RpFilePrivate::~RpFilePrivate()
 {
+	unmapFile();
 	if (gzfd) {
 		gzclose_r(gzfd);
 	}
@@ -214,6 +215,8 @@ int RpFilePrivate::reOpenFile(void)
 	}
 
 	// Open the file.
+	unmapFile();
+	map_tried = false;
 	if (file && file != INVALID_HANDLE_VALUE) {
 		CloseHandle(file);
 	}
@@ -263,6 +266,81 @@ int RpFilePrivate::reOpenFile(void)
 	return (!file || file == INVALID_HANDLE_VALUE);
 }
 
+/**
+ * Map the entire file into memory. (read-only)
+ *
+ * Only regular files opened in read-only mode with
+ * FM_MMAP and without transparent decompression can
+ * be mapped. If mapping fails, it won't be attempted
+ * again until the file is reopened.
+ *
+ * NOTE: mtxMap must be locked by the caller.
+ *
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFilePrivate::mapFile(void)
+{
+	if (map_ptr) {
+		// Already mapped.
+		return 0;
+	} else if (map_tried) {
+		// Mapping was already attempted and failed.
+		return -ENOTSUP;
+	}
+	map_tried = true;
+
+	if (!file || file == INVALID_HANDLE_VALUE ||
+	    devInfo || gzfd || (mode & RpFile::FM_WRITE) || !(mode & RpFile::FM_MMAP))
+	{
+		// Mapping is not supported for this file.
+		return -ENOTSUP;
+	}
+
+	LARGE_INTEGER liFileSize;
+	if (!GetFileSizeEx(file, &liFileSize)) {
+		return -w32err_to_posix(GetLastError());
+	} else if (liFileSize.QuadPart <= 0) {
+		// Empty file.
+		return -ENOTSUP;
+	}
+	if (static_cast<uint64_t>(liFileSize.QuadPart) > static_cast<uint64_t>(SIZE_MAX)) {
+		// File is too big to map on this system.
+		return -ENOMEM;
+	}
+
+	hMapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!hMapping) {
+		return -w32err_to_posix(GetLastError());
+	}
+	const void *const ptr = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!ptr) {
+		const int err = w32err_to_posix(GetLastError());
+		CloseHandle(hMapping);
+		hMapping = nullptr;
+		return -err;
+	}
+
+	map_ptr = static_cast<const uint8_t*>(ptr);
+	map_sz = static_cast<size_t>(liFileSize.QuadPart);
+	return 0;
+}
+
+/**
+ * Unmap the file if it's currently mapped.
+ */
+void RpFilePrivate::unmapFile(void)
+{
+	if (map_ptr) {
+		UnmapViewOfFile(map_ptr);
+		map_ptr = nullptr;
+		map_sz = 0;
+	}
+	if (hMapping) {
+		CloseHandle(hMapping);
+		hMapping = nullptr;
+	}
+}
+
 /** RpFile **/
 
 /**
@@ -315,7 +393,8 @@ void RpFile::init(void)
 	// Check if this is a gzipped file.
 	// If it is, use transparent decompression.
 	// Reference: https://www.forensicswiki.org/wiki/Gzip
-	if (!d->devInfo && d->mode == FM_OPEN_READ_GZ) {
+	// NOTE: FM_MMAP doesn't affect decompression.
+	if (!d->devInfo && (d->mode & ~FM_MMAP) == FM_OPEN_READ_GZ) {
 #if defined(_MSC_VER) && defined(ZLIB_IS_DLL)
 		// Delay load verification.
 		// TODO: Only if linked with /DELAYLOAD?
@@ -432,6 +511,7 @@ void RpFile::close(void)
 		d->devInfo->close();
 	}
 
+	d->unmapFile();
 	if (d->gzfd) {
 		gzclose_r(d->gzfd);
 		d->gzfd = nullptr;
@@ -708,6 +788,151 @@ string RpFile::filename(void) const
 	return d->filename;
 }
 
+/** Zero-copy access **/
+
+/**
+ * Get a read-only view of a range of the file.
+ *
+ * Regular files opened read-only with FM_MMAP are
+ * memory-mapped on the first call to this function.
+ * gzipped files, device files, writable files, and
+ * files opened without FM_MMAP are not supported.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return Pointer to the data, or nullptr if views are not supported or the range is out of bounds.
+ */
+const uint8_t *RpFile::view(off64_t pos, size_t size)
+{
+	RP_D(RpFile);
+	// NOTE: Windows doesn't allow a file to be truncated while
+	// it's mapped, so the file size doesn't need to be rechecked.
+	LibRpBase::MutexLocker mtxLocker(d->mtxMap);
+	if (!d->map_ptr) {
+		if (d->mapFile() != 0) {
+			// Unable to map the file.
+			// NOTE: Not setting m_lastError, since the
+			// caller is expected to fall back to read().
+			return nullptr;
+		}
+	}
+
+	// Check if the range is in bounds.
+	if (pos < 0 || static_cast<uint64_t>(pos) > d->map_sz ||
+	    size > d->map_sz - static_cast<size_t>(pos))
+	{
+		m_lastError = EINVAL;
+		return nullptr;
+	}
+
+	return d->map_ptr + static_cast<size_t>(pos);
+}
+
+/**
+ * Hint that a range of the file will be read soon.
+ *
+ * Windows doesn't have a direct equivalent to posix_fadvise(),
+ * so this is currently a no-op.
+ *
+ * @param pos	[in] Starting position.
+ * @param size	[in] Number of bytes.
+ * @return 0 on success or if hints aren't supported; negative POSIX error code on error.
+ */
+int RpFile::prefetch(off64_t pos, size_t size)
+{
+	RP_D(RpFile);
+	if (!d->file || d->file == INVALID_HANDLE_VALUE) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+
+	// TODO: PrefetchVirtualMemory() on a mapped view? (Windows 8+)
+	RP_UNUSED(pos);
+	RP_UNUSED(size);
+	return 0;
+}
+
+/** Positional reads **/
+
+/**
+ * Read data from the specified position.
+ * The file position is not changed.
+ *
+ * Regular files use ReadFile() with an OVERLAPPED offset.
+ * gzipped files and device files fall back to seek and read.
+ *
+ * @param pos	[in] Starting position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	RP_D(RpFile);
+	if (!d->file || d->file == INVALID_HANDLE_VALUE) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (pos < 0) {
+		m_lastError = EINVAL;
+		return 0;
+	} else if (size == 0) {
+		// Nothing to read.
+		return 0;
+	}
+
+	if (d->devInfo || d->gzfd) {
+		// Block devices need sector-aligned reads,
+		// and gzipped files can only be read sequentially.
+		return super::pread(pos, ptr, size);
+	}
+
+	// NOTE: ReadFile() with an OVERLAPPED offset updates the
+	// file pointer for synchronous handles, so it has to be
+	// restored afterwards.
+	LARGE_INTEGER liZero, liCurPos;
+	liZero.QuadPart = 0;
+	if (!SetFilePointerEx(d->file, liZero, &liCurPos, FILE_CURRENT)) {
+		m_lastError = w32err_to_posix(GetLastError());
+		return 0;
+	}
+
+	OVERLAPPED ov;
+	memset(&ov, 0, sizeof(ov));
+	ov.Offset = static_cast<DWORD>(pos & 0xFFFFFFFFU);
+	ov.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(pos) >> 32);
+
+	DWORD bytesRead;
+	BOOL bRet = ReadFile(d->file, ptr, static_cast<DWORD>(size), &bytesRead, &ov);
+	if (!bRet) {
+		const DWORD dwError = GetLastError();
+		if (dwError != ERROR_HANDLE_EOF) {
+			// An error occurred.
+			m_lastError = w32err_to_posix(dwError);
+		}
+		bytesRead = 0;
+	}
+
+	SetFilePointerEx(d->file, liCurPos, nullptr, FILE_BEGIN);
+	return bytesRead;
+}
+
+/**
+ * Read data from the specified position into multiple buffers.
+ * The file position is not changed.
+ *
+ * NOTE: ReadFileScatter() requires unbuffered I/O with
+ * page-sized buffers, so each buffer is read separately.
+ *
+ * @param pos	[in] Starting position.
+ * @param iov	[in] Output buffers.
+ * @param iovcnt [in] Number of output buffers.
+ * @return Total number of bytes read.
+ */
+size_t RpFile::preadv(off64_t pos, const IoVec *iov, int iovcnt)
+{
+	return super::preadv(pos, iov, iovcnt);
+}
+
 /** Device file functions **/
 
 /**
@@ -86,6 +86,11 @@ int rp_secure_enable(rp_secure_param_t param)
 	seccomp_rule_add_array(ctx, SCMP_ACT_ALLOW, SCMP_SYS(tgkill), 0, NULL);
 #endif /* NDEBUG */
 
+	// ThreadPool::onlineCpuCount() [ThreadPool::instance()]
+	// NOTE: This is called even if clone() isn't allowed,
+	// in which case the ThreadPool runs everything inline.
+	seccomp_rule_add_array(ctx, SCMP_ACT_ALLOW, SCMP_SYS(sched_getaffinity), 0, NULL);
+
 	// NOTE: If clone() is wanted, it should be the first syscall in the list.
 	const int *p = param.syscall_wl;
 	if (*p == SCMP_SYS(clone)) {
@@ -96,6 +101,22 @@ int rp_secure_enable(rp_secure_param_t param)
 		seccomp_rule_add_array(ctx, SCMP_ACT_ALLOW, SCMP_SYS(clone),
 			(unsigned int)(sizeof(clone_params)/sizeof(clone_params[0])), clone_params);
 
+#if defined(__SNR_clone3) || defined(__NR_clone3)
+		// clone3() passes its flags in a struct, so they can't be
+		// filtered. glibc-2.34+ tries clone3() first when creating
+		// threads and falls back to clone() if it returns ENOSYS.
+		seccomp_rule_add_array(ctx, SCMP_ACT_ERRNO(ENOSYS), SCMP_SYS(clone3), 0, NULL);
+#endif /* __SNR_clone3 || __NR_clone3 */
+
+		// Other syscalls needed to create and run threads.
+		// NOTE: rt_sigprocmask() is only allowed by default in debug builds.
+		seccomp_rule_add_array(ctx, SCMP_ACT_ALLOW, SCMP_SYS(set_robust_list), 0, NULL);
+		seccomp_rule_add_array(ctx, SCMP_ACT_ALLOW, SCMP_SYS(rt_sigprocmask), 0, NULL);	// pthread_create()
+		seccomp_rule_add_array(ctx, SCMP_ACT_ALLOW, SCMP_SYS(madvise), 0, NULL);	// thread exit (stack)
+#if defined(__SNR_rseq) || defined(__NR_rseq)
+		seccomp_rule_add_array(ctx, SCMP_ACT_ALLOW, SCMP_SYS(rseq), 0, NULL);	// glibc-2.35+ thread startup
+#endif /* __SNR_rseq || __NR_rseq */
+
 		// Skip clone() in the loop.
 		p++;
 	}
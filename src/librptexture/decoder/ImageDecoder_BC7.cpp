@@ -248,6 +248,8 @@ static FORCEINLINE void rshift128(uint64_t &msb, uint64_t &lsb, unsigned int sha
 rp_image *fromBC7(int width, int height,
 	const uint8_t *img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -15,50 +15,13 @@
 #include "PixelConversion.hpp"
 using namespace LibRpTexture::PixelConversion;
 
+#include "TextureLayout.hpp"
+
 // C++ STL classes.
 using std::unique_ptr;
 
-// One-time initialization.
-#include "librpthreads/pthread_once.h"
-
 namespace LibRpTexture { namespace ImageDecoder {
 
-/**
- * Dreamcast twiddle map.
- * Must be initialized using initDreamcastTwiddleMap().
- *
- * Supports textures up to 4096x4096.
- */
-static unsigned int dc_tmap[4096];
-
-// pthread_once() control variable.
-static pthread_once_t once_control = PTHREAD_ONCE_INIT;
-
-/**
- * Initialize the Dreamcast twiddle map.
- * This initializes dc_tmap[].
- *
- * This function MUST be called using pthread_once().
- */
-static void initDreamcastTwiddleMap_int(void)
-{
-	for (unsigned int i = 0; i < ARRAY_SIZE(dc_tmap); i++) {
-		dc_tmap[i] = 0;
-		for (unsigned int j = 0, k = 1; k <= i; j++, k <<= 1) {
-			dc_tmap[i] |= ((i & k) << j);
-		}
-	}
-}
-
-/**
- * Initialize the Dreamcast twiddle map.
- * This initializes dc_tmap[].
- */
-static FORCEINLINE void initDreamcastTwiddleMap(void)
-{
-	pthread_once(&once_control, initDreamcastTwiddleMap_int);
-}
-
 /**
  * Convert a Dreamcast square twiddled 16-bit image to rp_image.
  * @param px_format 16-bit pixel format.
@@ -72,6 +35,8 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -86,8 +51,11 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 		return nullptr;
 	}
 
-	// Initialize the twiddle map.
-	initDreamcastTwiddleMap();
+	// Twiddled textures must be a power of two.
+	assert(isPow2(static_cast<unsigned int>(width)));
+	if (!isPow2(static_cast<unsigned int>(width))) {
+		return nullptr;
+	}
 
 	// Create an rp_image.
 	rp_image *img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
@@ -97,19 +65,17 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 		return nullptr;
 	}
 
-	// Convert one line at a time. (16-bit -> ARGB32)
-	uint32_t *px_dest = static_cast<uint32_t*>(img->bits());
-	const int dest_stride_adj = (img->stride() / sizeof(uint32_t)) - img->width();
+	// Untile and convert in one pass. (16-bit -> ARGB32)
+	const TextureLayout::Layout layout =
+		TextureLayout::dreamcastTwiddle(uilog2(static_cast<unsigned int>(width)));
+	uint32_t *const px_dest = static_cast<uint32_t*>(img->bits());
+	const unsigned int dest_stride = img->stride() / sizeof(uint32_t);
 	switch (px_format) {
 		case PXF_ARGB1555: {
-			for (unsigned int y = 0; y < static_cast<unsigned int>(height); y++) {
-				for (unsigned int x = 0; x < static_cast<unsigned int>(width); x++) {
-					const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
-					*px_dest = ARGB1555_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
-					px_dest++;
-				}
-				px_dest += dest_stride_adj;
-			}
+			TextureLayout::untile(layout, width, height, px_dest, dest_stride,
+				[img_buf](unsigned int srcIdx) {
+					return ARGB1555_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
+				});
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {5,5,5,0,1};
 			img->set_sBIT(&sBIT);
@@ -117,14 +83,10 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 		}
 
 		case PXF_RGB565: {
-			for (unsigned int y = 0; y < static_cast<unsigned int>(height); y++) {
-				for (unsigned int x = 0; x < static_cast<unsigned int>(width); x++) {
-					const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
-					*px_dest = RGB565_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
-					px_dest++;
-				}
-				px_dest += dest_stride_adj;
-			}
+			TextureLayout::untile(layout, width, height, px_dest, dest_stride,
+				[img_buf](unsigned int srcIdx) {
+					return RGB565_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
+				});
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {5,6,5,0,0};
 			img->set_sBIT(&sBIT);
@@ -132,14 +94,10 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 		}
 
 		case PXF_ARGB4444: {
-			for (unsigned int y = 0; y < static_cast<unsigned int>(height); y++) {
-				for (unsigned int x = 0; x < static_cast<unsigned int>(width); x++) {
-					const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
-					*px_dest = ARGB4444_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
-					px_dest++;
-				}
-				px_dest += dest_stride_adj;
-			}
+			TextureLayout::untile(layout, width, height, px_dest, dest_stride,
+				[img_buf](unsigned int srcIdx) {
+					return ARGB4444_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
+				});
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {4,4,4,0,4};
 			img->set_sBIT(&sBIT);
@@ -175,6 +133,8 @@ rp_image *fromDreamcastVQ16(PixelFormat px_format,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const uint16_t *RESTRICT pal_buf, int pal_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -211,8 +171,12 @@ rp_image *fromDreamcastVQ16(PixelFormat px_format,
 		return nullptr;
 	}
 
-	// Initialize the twiddle map.
-	initDreamcastTwiddleMap();
+	// Twiddled textures must be a power of two.
+	// VQ blocks are 2x2, so the minimum size is 2x2.
+	assert(width >= 2 && isPow2(static_cast<unsigned int>(width)));
+	if (width < 2 || !isPow2(static_cast<unsigned int>(width))) {
+		return nullptr;
+	}
 
 	// Create an rp_image.
 	rp_image *img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
@@ -266,12 +230,19 @@ rp_image *fromDreamcastVQ16(PixelFormat px_format,
 
 	// Convert one line at a time. (16-bit -> ARGB32)
 	// Reference: https://github.com/nickworonekin/puyotools/blob/548a52684fd48d936526fd91e8ead8e52aa33eb3/Libraries/VrSharp/PvrTexture/PvrDataCodec.cs#L149
+	// Each VQ index covers a 2x2 block, so the twiddled
+	// layout is half the image size in each direction.
+	const TextureLayout::Layout layout =
+		TextureLayout::dreamcastTwiddle(uilog2(static_cast<unsigned int>(width)) - 1);
 	uint32_t *px_dest = static_cast<uint32_t*>(img->bits());
 	const int dest_stride = (img->stride() / sizeof(uint32_t));
 	const int dest_stride_adj = dest_stride + dest_stride - img->width();
+	uint32_t ybits = 0;
 	for (unsigned int y = 0; y < static_cast<unsigned int>(height); y += 2, px_dest += dest_stride_adj) {
+	uint32_t xbits = 0;
 	for (unsigned int x = 0; x < static_cast<unsigned int>(width); x += 2, px_dest += 2) {
-		const unsigned int srcIdx = ((dc_tmap[x >> 1] << 1) | dc_tmap[y >> 1]);
+		const unsigned int srcIdx = (xbits | ybits);
+		xbits = TextureLayout::next_bits(xbits, layout.mask_x);
 		assert(srcIdx < (unsigned int)img_siz);
 		if (srcIdx >= static_cast<unsigned int>(img_siz)) {
 			// Out of bounds.
@@ -299,7 +270,9 @@ rp_image *fromDreamcastVQ16(PixelFormat px_format,
 		px_dest[1]		= palette[palIdx+2];
 		px_dest[dest_stride]	= palette[palIdx+1];
 		px_dest[dest_stride+1]	= palette[palIdx+3];
-	} }
+	}
+	ybits = TextureLayout::next_bits(ybits, layout.mask_y);
+	}
 
 	// Image has been converted.
 	return img;
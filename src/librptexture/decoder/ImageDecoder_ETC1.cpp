@@ -611,6 +611,8 @@ static void decodeBlock_ETC_RGB(uint32_t tileBuf[4*4], const etc1_block *etc1_sr
 rp_image *fromETC1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -673,6 +675,8 @@ rp_image *fromETC1(int width, int height,
 rp_image *fromETC2_RGB(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -775,6 +779,8 @@ static void decodeBlock_ETC2_alpha(uint32_t tileBuf[4*4], const etc2_alpha *alph
 rp_image *fromETC2_RGBA(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -841,6 +847,8 @@ rp_image *fromETC2_RGBA(int width, int height,
 rp_image *fromETC2_RGB_A1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
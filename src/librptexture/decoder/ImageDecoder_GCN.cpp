@@ -13,6 +13,8 @@
 #include "PixelConversion.hpp"
 using namespace LibRpTexture::PixelConversion;
 
+#include "TextureLayout.hpp"
+
 namespace LibRpTexture { namespace ImageDecoder {
 
 /**
@@ -28,6 +30,8 @@ rp_image *fromGcn16(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -53,28 +57,18 @@ rp_image *fromGcn16(PixelFormat px_format,
 		return nullptr;
 	}
 
-	// Calculate the total number of tiles.
-	const unsigned int tilesX = static_cast<unsigned int>(width / 4);
-	const unsigned int tilesY = static_cast<unsigned int>(height / 4);
-
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
+	// Untile and convert in one pass.
+	// Each tile row is 4 contiguous pixels.
+	const TextureLayout::Layout layout = TextureLayout::linearTiles(2, 2);
+	uint32_t *const px_dest = static_cast<uint32_t*>(img->bits());
+	const unsigned int dest_stride = img->stride() / sizeof(uint32_t);
 
 	switch (px_format) {
 		case PXF_RGB5A3: {
-			for (unsigned int y = 0; y < tilesY; y++) {
-				for (unsigned int x = 0; x < tilesX; x++) {
-					// Convert each tile to ARGB32 manually.
-					// TODO: Optimize using pointers instead of indexes?
-					for (unsigned int i = 0; i < 4*4; i += 2, img_buf += 2) {
-						tileBuf[i+0] = RGB5A3_to_ARGB32(be16_to_cpu(img_buf[0]));
-						tileBuf[i+1] = RGB5A3_to_ARGB32(be16_to_cpu(img_buf[1]));
-					}
-
-					// Blit the tile to the main image buffer.
-					ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-				}
-			}
+			TextureLayout::untile(layout, width, height, px_dest, dest_stride,
+				[img_buf](unsigned int srcIdx) {
+					return RGB5A3_to_ARGB32(be16_to_cpu(img_buf[srcIdx]));
+				});
 			// Set the sBIT metadata.
 			// NOTE: Pixels may be RGB555 or ARGB4444.
 			// We'll use 555 for RGB, and 4 for alpha.
@@ -85,19 +79,10 @@ rp_image *fromGcn16(PixelFormat px_format,
 		}
 
 		case PXF_RGB565: {
-			for (unsigned int y = 0; y < tilesY; y++) {
-				for (unsigned int x = 0; x < tilesX; x++) {
-					// Convert each tile to ARGB32 manually.
-					// TODO: Optimize using pointers instead of indexes?
-					for (unsigned int i = 0; i < 4*4; i += 2, img_buf += 2) {
-						tileBuf[i+0] = RGB565_to_ARGB32(be16_to_cpu(img_buf[0]));
-						tileBuf[i+1] = RGB565_to_ARGB32(be16_to_cpu(img_buf[1]));
-					}
-
-					// Blit the tile to the main image buffer.
-					ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-				}
-			}
+			TextureLayout::untile(layout, width, height, px_dest, dest_stride,
+				[img_buf](unsigned int srcIdx) {
+					return RGB565_to_ARGB32(be16_to_cpu(img_buf[srcIdx]));
+				});
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {5,6,5,0,0};
 			img->set_sBIT(&sBIT);
@@ -105,19 +90,10 @@ rp_image *fromGcn16(PixelFormat px_format,
 		}
 
 		case PXF_IA8: {
-			for (unsigned int y = 0; y < tilesY; y++) {
-				for (unsigned int x = 0; x < tilesX; x++) {
-					// Convert each tile to ARGB32 manually.
-					// TODO: Optimize using pointers instead of indexes?
-					for (unsigned int i = 0; i < 4*4; i += 2, img_buf += 2) {
-						tileBuf[i+0] = IA8_to_ARGB32(be16_to_cpu(img_buf[0]));
-						tileBuf[i+1] = IA8_to_ARGB32(be16_to_cpu(img_buf[1]));
-					}
-
-					// Blit the tile to the main image buffer.
-					ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-				}
-			}
+			TextureLayout::untile(layout, width, height, px_dest, dest_stride,
+				[img_buf](unsigned int srcIdx) {
+					return IA8_to_ARGB32(be16_to_cpu(img_buf[srcIdx]));
+				});
 			// Set the sBIT metadata.
 			// NOTE: Setting the grayscale value, though we're
 			// not saving grayscale PNGs at the moment.
@@ -150,6 +126,8 @@ rp_image *fromGcnCI8(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const uint16_t *RESTRICT pal_buf, int pal_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -242,6 +220,8 @@ rp_image *fromGcnCI8(int width, int height,
 rp_image *fromGcnI8(int width, int height,
 	const uint8_t *img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
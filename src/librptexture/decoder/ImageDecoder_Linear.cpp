@@ -33,6 +33,8 @@ rp_image *fromLinearCI4(PixelFormat px_format, bool msn_left,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const void *RESTRICT pal_buf, int pal_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -272,6 +274,8 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const void *RESTRICT pal_buf, int pal_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -475,6 +479,8 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 rp_image *fromLinearMono(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -549,6 +555,8 @@ rp_image *fromLinear8(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	static const int bytespp = 1;
 
 	// Verify parameters.
@@ -646,6 +654,8 @@ rp_image *fromLinear16_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	static const int bytespp = 2;
 
 	// Verify parameters.
@@ -761,6 +771,8 @@ rp_image *fromLinear24_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	static const int bytespp = 3;
 
 	// Verify parameters.
@@ -862,6 +874,8 @@ rp_image *fromLinear32_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint32_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	static const int bytespp = 4;
 
 	// Verify parameters.
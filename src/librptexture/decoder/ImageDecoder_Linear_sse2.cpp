@@ -283,6 +283,8 @@ rp_image *fromLinear16_sse2(PixelFormat px_format,
 		return fromLinear16_cpp(px_format, width, height, img_buf, img_siz, stride);
 	}
 
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Create an rp_image.
 	rp_image *img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
 	if (!img->isValid()) {
@@ -75,6 +75,8 @@ rp_image *fromLinear24_ssse3(PixelFormat px_format,
 		}
 	}
 
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Create an rp_image.
 	rp_image *img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
 	if (!img->isValid()) {
@@ -244,6 +246,8 @@ rp_image *fromLinear32_ssse3(PixelFormat px_format,
 		}
 	}
 
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Create an rp_image.
 	rp_image *img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
 	if (!img->isValid()) {
@@ -13,18 +13,13 @@
 #include "PixelConversion.hpp"
 using namespace LibRpTexture::PixelConversion;
 
-namespace LibRpTexture { namespace ImageDecoder {
-
 // N3DS uses 3-level Z-ordered tiling.
 // References:
 // - https://github.com/devkitPro/3dstools/blob/master/src/smdhtool.cpp
 // - https://en.wikipedia.org/wiki/Z-order_curve
-static const uint8_t N3DS_tile_order[] = {
-	 0,  1,  8,  9,  2,  3, 10, 11, 16, 17, 24, 25, 18, 19, 26, 27,
-	 4,  5, 12, 13,  6,  7, 14, 15, 20, 21, 28, 29, 22, 23, 30, 31,
-	32, 33, 40, 41, 34, 35, 42, 43, 48, 49, 56, 57, 50, 51, 58, 59,
-	36, 37, 44, 45, 38, 39, 46, 47, 52, 53, 60, 61, 54, 55, 62, 63
-};
+#include "TextureLayout.hpp"
+
+namespace LibRpTexture { namespace ImageDecoder {
 
 /**
  * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
@@ -37,6 +32,8 @@ static const uint8_t N3DS_tile_order[] = {
 rp_image *fromN3DSTiledRGB565(int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -62,26 +59,12 @@ rp_image *fromN3DSTiledRGB565(int width, int height,
 		return nullptr;
 	}
 
-	// Calculate the total number of tiles.
-	const unsigned int tilesX = static_cast<unsigned int>(width / 8);
-	const unsigned int tilesY = static_cast<unsigned int>(height / 8);
-
-	// Temporary tile buffer.
-	uint32_t tileBuf[8*8];
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-		for (unsigned int x = 0; x < tilesX; x++) {
-			// Convert each tile to ARGB32 manually.
-			// TODO: Optimize using pointers instead of indexes?
-			for (unsigned int i = 0; i < 8*8; i += 2, img_buf += 2) {
-				tileBuf[N3DS_tile_order[i+0]] = RGB565_to_ARGB32(le16_to_cpu(img_buf[0]));
-				tileBuf[N3DS_tile_order[i+1]] = RGB565_to_ARGB32(le16_to_cpu(img_buf[1]));
-			}
-
-			// Blit the tile to the main image buffer.
-			ImageDecoderPrivate::BlitTile<uint32_t, 8, 8>(img, tileBuf, x, y);
-		}
-	}
+	// Untile and convert in one pass.
+	TextureLayout::untile(TextureLayout::n3dsTiles(), width, height,
+		static_cast<uint32_t*>(img->bits()), img->stride() / sizeof(uint32_t),
+		[img_buf](unsigned int srcIdx) {
+			return RGB565_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
+		});
 
 	// Set the sBIT metadata.
 	static const rp_image::sBIT_t sBIT = {5,6,5,0,0};
@@ -105,6 +88,8 @@ rp_image *fromN3DSTiledRGB565_A4(int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz,
 	const uint8_t *RESTRICT alpha_buf, int alpha_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(alpha_buf != nullptr);
@@ -125,10 +110,6 @@ rp_image *fromN3DSTiledRGB565_A4(int width, int height,
 	if (width % 8 != 0 || height % 8 != 0)
 		return nullptr;
 
-	// Calculate the total number of tiles.
-	const unsigned int tilesX = static_cast<unsigned int>(width / 8);
-	const unsigned int tilesY = static_cast<unsigned int>(height / 8);
-
 	// Create an rp_image.
 	rp_image *img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
 	if (!img->isValid()) {
@@ -137,26 +118,15 @@ rp_image *fromN3DSTiledRGB565_A4(int width, int height,
 		return nullptr;
 	}
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[8*8];
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-		for (unsigned int x = 0; x < tilesX; x++) {
-			// Convert each tile to ARGB32 manually.
-			// TODO: Optimize using pointers instead of indexes?
-			// FIXME: Nybble ordering for A4?
-			// Assuming LeftLSN, same as NDS CI4.
-			for (unsigned int i = 0; i < 8*8; i += 2, img_buf += 2, alpha_buf++) {
-				tileBuf[N3DS_tile_order[i+0]] = RGB565_A4_to_ARGB32(
-					le16_to_cpu(img_buf[0]), *alpha_buf & 0x0F);
-				tileBuf[N3DS_tile_order[i+1]] = RGB565_A4_to_ARGB32(
-					le16_to_cpu(img_buf[1]), *alpha_buf >> 4);
-			}
-
-			// Blit the tile to the main image buffer.
-			ImageDecoderPrivate::BlitTile<uint32_t, 8, 8>(img, tileBuf, x, y);
-		}
-	}
+	// Untile and convert in one pass.
+	// FIXME: Nybble ordering for A4?
+	// Assuming LeftLSN, same as NDS CI4.
+	TextureLayout::untile(TextureLayout::n3dsTiles(), width, height,
+		static_cast<uint32_t*>(img->bits()), img->stride() / sizeof(uint32_t),
+		[img_buf, alpha_buf](unsigned int srcIdx) {
+			const uint8_t a4 = alpha_buf[srcIdx >> 1] >> ((srcIdx & 1) << 2);
+			return RGB565_A4_to_ARGB32(le16_to_cpu(img_buf[srcIdx]), a4);
+		});
 
 	// Set the sBIT metadata.
 	static const rp_image::sBIT_t sBIT = {5,6,5,0,4};
@@ -194,6 +194,8 @@ static inline uint8_t decode_DXT5_alpha_S3TC(unsigned int a3, const uint8_t *RES
 rp_image *fromDXT1_GCN(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -356,6 +358,7 @@ static rp_image *T_fromDXT1(int width, int height,
 rp_image *fromDXT1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
 	return T_fromDXT1<0>(width, height, img_buf, img_siz);
 }
 
@@ -372,6 +375,7 @@ rp_image *fromDXT1(int width, int height,
 rp_image *fromDXT1_A1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
 	return T_fromDXT1<DXTn_PALETTE_COLOR3_ALPHA>(width, height, img_buf, img_siz);
 }
 
@@ -415,6 +419,8 @@ rp_image *fromDXT2(int width, int height,
 rp_image *fromDXT3(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -532,6 +538,8 @@ rp_image *fromDXT4(int width, int height,
 rp_image *fromDXT5(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -619,6 +627,8 @@ rp_image *fromDXT5(int width, int height,
 rp_image *fromBC4(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -707,6 +717,8 @@ rp_image *fromBC4(int width, int height,
 rp_image *fromBC5(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_PROFILE_SCOPE_BYTES(STAGE_IMAGE_DECODE, img_siz);
+
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
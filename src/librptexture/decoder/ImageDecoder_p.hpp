@@ -13,6 +13,9 @@
 #include "byteswap.h"
 #include "../img/rp_image.hpp"
 
+// librpthreads
+#include "librpthreads/Profiler.hpp"
+
 // C includes. (C++ namespace)
 #include <cassert>
 #include <cstring>
@@ -0,0 +1,366 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * TextureLayout.hpp: Tiled and swizzled texture layouts.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_DECODER_TEXTURELAYOUT_HPP__
+#define __ROMPROPERTIES_LIBRPTEXTURE_DECODER_TEXTURELAYOUT_HPP__
+
+#include "common.h"
+
+// C includes. (C++ namespace)
+#include <cassert>
+#include <cstdint>
+
+#ifdef __BMI2__
+# include <immintrin.h>
+#endif /* __BMI2__ */
+
+namespace LibRpTexture { namespace TextureLayout {
+
+/**
+ * Texture layout.
+ *
+ * The image is made up of tiles, stored in row-major order.
+ * Within each tile, the source pixel index is built by
+ * depositing the x and y coordinates into mask_x and mask_y:
+ *
+ *   idx = pdep(x, mask_x) | pdep(y, mask_y)
+ *
+ * This covers row-major tiles (GameCube), Morton-ordered tiles
+ * (Nintendo 3DS), and whole-image twiddling (Dreamcast, Xbox),
+ * where the "tile" is the entire image.
+ *
+ * mask_x and mask_y must not overlap, and together they must
+ * cover the low (tileW_shift + tileH_shift) bits.
+ */
+struct Layout {
+	uint8_t tileW_shift;	// log2(tile width)
+	uint8_t tileH_shift;	// log2(tile height)
+	uint32_t mask_x;	// Pixel index bits for x within a tile.
+	uint32_t mask_y;	// Pixel index bits for y within a tile.
+};
+
+/**
+ * Deposit the low bits of a value into the set bits of a mask.
+ * If value is abcd and mask is 11010100100, this returns 0a0b0c00d00.
+ *
+ * NOTE: Only used for block and row bases, not per pixel, so
+ * the BMI2 version is only used if the compiler targets BMI2.
+ *
+ * @param value Value.
+ * @param mask Mask.
+ * @return Deposited value.
+ */
+static inline uint32_t deposit_bits(uint32_t value, uint32_t mask)
+{
+#ifdef __BMI2__
+	return _pdep_u32(value, mask);
+#else /* !__BMI2__ */
+	uint32_t result = 0;
+	for (; mask != 0 && value != 0; value >>= 1) {
+		const uint32_t bit = mask & (0U - mask);
+		if (value & 1) {
+			result |= bit;
+		}
+		mask &= ~bit;
+	}
+	return result;
+#endif /* __BMI2__ */
+}
+
+/**
+ * Advance a deposited value to the next value within a mask.
+ * This is pdep(pdep^-1(bits) + 1, mask) without the pdep.
+ * @param bits Deposited value.
+ * @param mask Mask.
+ * @return Next deposited value. (wraps around to 0)
+ */
+static FORCEINLINE uint32_t next_bits(uint32_t bits, uint32_t mask)
+{
+	return (bits - mask) & mask;
+}
+
+/** Layouts **/
+
+/**
+ * Row-major tiles, with row-major pixels within each tile. (GameCube)
+ * @param tileW_shift log2(tile width)
+ * @param tileH_shift log2(tile height)
+ * @return Layout.
+ */
+static inline Layout linearTiles(unsigned int tileW_shift, unsigned int tileH_shift)
+{
+	const Layout layout = {
+		static_cast<uint8_t>(tileW_shift),
+		static_cast<uint8_t>(tileH_shift),
+		(1U << tileW_shift) - 1,
+		((1U << tileH_shift) - 1) << tileW_shift,
+	};
+	return layout;
+}
+
+/**
+ * 8x8 tiles with Morton-ordered pixels. (Nintendo 3DS)
+ * The x coordinate is in the even bits.
+ * @return Layout.
+ */
+static inline Layout n3dsTiles(void)
+{
+	const Layout layout = {3, 3, 0x15, 0x2A};
+	return layout;
+}
+
+/**
+ * Twiddled square texture. (Dreamcast)
+ * The x coordinate is in the odd bits.
+ * @param size_shift log2(width), which must be equal to log2(height).
+ * @return Layout.
+ */
+static inline Layout dreamcastTwiddle(unsigned int size_shift)
+{
+	const uint32_t area_mask = (size_shift >= 16
+		? 0xFFFFFFFFU
+		: ((1U << (size_shift * 2)) - 1));
+	const Layout layout = {
+		static_cast<uint8_t>(size_shift),
+		static_cast<uint8_t>(size_shift),
+		0xAAAAAAAAU & area_mask,
+		0x55555555U & area_mask,
+	};
+	return layout;
+}
+
+/**
+ * Swizzled texture. (Xbox)
+ *
+ * Based on Cxbx-Reloaded's generate_swizzle_masks():
+ * https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
+ * Original license: LGPLv2 (GPLv2 for contributions after 2012/01/13)
+ *
+ * Bits are interleaved as ..yxyx, starting with x. Once the
+ * smaller dimension runs out of bits, the remaining bits all
+ * belong to the larger dimension.
+ *
+ * @param width_shift log2(width)
+ * @param height_shift log2(height)
+ * @return Layout.
+ */
+static inline Layout xboxSwizzle(unsigned int width_shift, unsigned int height_shift)
+{
+	Layout layout = {
+		static_cast<uint8_t>(width_shift),
+		static_cast<uint8_t>(height_shift),
+		0, 0,
+	};
+
+	uint32_t mask_bit = 1;
+	for (unsigned int i = 0; i < width_shift || i < height_shift; i++) {
+		if (i < width_shift) {
+			layout.mask_x |= mask_bit;
+			mask_bit <<= 1;
+		}
+		if (i < height_shift) {
+			layout.mask_y |= mask_bit;
+			mask_bit <<= 1;
+		}
+	}
+	return layout;
+}
+
+/** Untiling **/
+
+/**
+ * Maximum block size for untiling, in pixels.
+ * Large tiles (e.g. whole-image twiddling) are walked one row
+ * of blocks at a time, which keeps the source reads within a
+ * small range instead of striding across the whole image.
+ */
+static const unsigned int UNTILE_BLOCK_DIM = 32;
+
+/**
+ * Convert a run of contiguous source pixels. (internal class)
+ * This is unrolled at compile time, since run lengths are
+ * small and the per-pixel loop overhead would dominate.
+ * @tparam n Number of pixels.
+ */
+template<unsigned int n>
+struct UntileRun {
+	template<typename pixel, typename PixelFn>
+	static FORCEINLINE void copy(pixel *RESTRICT px_dest, unsigned int srcIdx, PixelFn &fn)
+	{
+		UntileRun<n-1>::copy(px_dest, srcIdx, fn);
+		px_dest[n-1] = fn(srcIdx + (n-1));
+	}
+};
+
+template<>
+struct UntileRun<0> {
+	template<typename pixel, typename PixelFn>
+	static FORCEINLINE void copy(pixel *RESTRICT, unsigned int, PixelFn &)
+	{ }
+};
+
+/**
+ * Untile an image. (internal function)
+ *
+ * The low bits of the source index form a small contiguous
+ * block of run x yrun pixels, which is converted as a unit.
+ *
+ * @tparam run		[in] Number of contiguous source pixels per row.
+ * @tparam yrun		[in] Number of rows in each contiguous block. (1 or 2)
+ * @tparam pixel	[in] Destination pixel type.
+ * @tparam PixelFn	[in] Pixel functor: pixel fn(unsigned int srcIdx)
+ */
+template<unsigned int run, unsigned int yrun, typename pixel, typename PixelFn>
+static inline void untile_int(const Layout &layout,
+	unsigned int width, unsigned int height,
+	pixel *RESTRICT dest, unsigned int dest_stride_px,
+	PixelFn &fn)
+{
+	const unsigned int tileW = 1U << layout.tileW_shift;
+	const unsigned int tileH = 1U << layout.tileH_shift;
+	const unsigned int tilesX = width >> layout.tileW_shift;
+	const unsigned int tilesY = height >> layout.tileH_shift;
+	const unsigned int area_shift = layout.tileW_shift + layout.tileH_shift;
+
+	const unsigned int blockW = (tileW < UNTILE_BLOCK_DIM ? tileW : UNTILE_BLOCK_DIM);
+	const unsigned int blockH = (tileH < UNTILE_BLOCK_DIM ? tileH : UNTILE_BLOCK_DIM);
+	const uint32_t bmask_x = deposit_bits(blockW - 1, layout.mask_x);
+	const uint32_t bmask_y = deposit_bits(blockH - 1, layout.mask_y);
+	// Bits above the contiguous block.
+	const uint32_t step_x = bmask_x & ~(run - 1);
+	const uint32_t step_y = bmask_y & ~((run * yrun) - 1);
+
+	// x offsets for each run within a block.
+	// The block pattern is the same for every block, so this is
+	// only calculated once, and it keeps the inner loop free of
+	// dependencies between pixels.
+	uint32_t xbits_tbl[UNTILE_BLOCK_DIM / run];
+	uint32_t xbits = 0;
+	for (unsigned int i = 0; i < blockW / run; i++) {
+		xbits_tbl[i] = xbits;
+		xbits = next_bits(xbits, step_x);
+	}
+
+	// x bits above the block, for stepping from one block to the next.
+	const uint32_t bstep_x = layout.mask_x & ~bmask_x;
+
+	// Rows are written in order. Each block row only covers
+	// blockH rows of each tile, which keeps the source reads
+	// for a block row within a small range.
+	pixel *px_dest = dest;
+	const unsigned int dest_stride_adj = (dest_stride_px * yrun) - width;
+	for (unsigned int ty = 0; ty < tilesY; ty++) {
+		const unsigned int tileRowBase = (ty * tilesX) << area_shift;
+		for (unsigned int by = 0; by < tileH; by += blockH) {
+			const unsigned int blockRowBase = tileRowBase | deposit_bits(by, layout.mask_y);
+
+			uint32_t ybits = 0;
+			for (unsigned int py = blockH / yrun; py > 0; py--, px_dest += dest_stride_adj) {
+				unsigned int tileBase = blockRowBase | ybits;
+				for (unsigned int tx = tilesX; tx > 0; tx--, tileBase += (1U << area_shift)) {
+					uint32_t bxbits = 0;
+					for (unsigned int bx = tileW / blockW; bx > 0; bx--, px_dest += blockW) {
+						const unsigned int lineBase = tileBase | bxbits;
+						for (unsigned int i = 0; i < blockW / run; i++) {
+							// Contiguous source pixels.
+							const unsigned int srcIdx = lineBase | xbits_tbl[i];
+							UntileRun<run>::copy(&px_dest[i * run], srcIdx, fn);
+							if (yrun == 2) {
+								UntileRun<run>::copy(&px_dest[dest_stride_px + (i * run)], srcIdx + run, fn);
+							}
+						}
+						bxbits = next_bits(bxbits, bstep_x);
+					}
+				}
+				ybits = next_bits(ybits, step_y);
+			}
+		}
+	}
+}
+
+/**
+ * Untile an image, converting each pixel with a functor.
+ *
+ * The width and height must be multiples of the tile size.
+ * Source pixel indexes are not bounds-checked; the caller
+ * must make sure the source buffer covers width*height pixels.
+ *
+ * @tparam pixel	[in] Destination pixel type.
+ * @tparam PixelFn	[in] Pixel functor: pixel fn(unsigned int srcIdx)
+ * @param layout	[in] Layout.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param dest		[out] Destination buffer.
+ * @param dest_stride_px [in] Destination stride, in pixels.
+ * @param fn		[in] Pixel functor.
+ */
+template<typename pixel, typename PixelFn>
+static inline void untile(const Layout &layout,
+	unsigned int width, unsigned int height,
+	pixel *RESTRICT dest, unsigned int dest_stride_px,
+	PixelFn fn)
+{
+	assert(width % (1U << layout.tileW_shift) == 0);
+	assert(height % (1U << layout.tileH_shift) == 0);
+	assert((layout.mask_x & layout.mask_y) == 0);
+
+	// Find the contiguous block in the low bits of the source index:
+	// up to 8 pixels from the low x bits, then 2 rows if the next
+	// bit belongs to y.
+	const unsigned int tileW = 1U << layout.tileW_shift;
+	const unsigned int tileH = 1U << layout.tileH_shift;
+	const unsigned int blockW = (tileW < UNTILE_BLOCK_DIM ? tileW : UNTILE_BLOCK_DIM);
+	const unsigned int blockH = (tileH < UNTILE_BLOCK_DIM ? tileH : UNTILE_BLOCK_DIM);
+	const uint32_t bmask_x = deposit_bits(blockW - 1, layout.mask_x);
+	const uint32_t bmask_y = deposit_bits(blockH - 1, layout.mask_y);
+	unsigned int run = 1;
+	while (run < 8 && (bmask_x & run)) {
+		run <<= 1;
+	}
+	const bool yrun2 = !!(bmask_y & run);
+
+#define UNTILE_CASE(n) \
+		case n: \
+			if (yrun2) { \
+				untile_int<n, 2>(layout, width, height, dest, dest_stride_px, fn); \
+			} else { \
+				untile_int<n, 1>(layout, width, height, dest, dest_stride_px, fn); \
+			} \
+			break;
+
+	switch (run) {
+		default:
+		UNTILE_CASE(1)
+		UNTILE_CASE(2)
+		UNTILE_CASE(4)
+		UNTILE_CASE(8)
+	}
+#undef UNTILE_CASE
+}
+
+/**
+ * Untile raw pixels into a linear buffer.
+ * @tparam pixel	[in] Pixel type.
+ * @param layout	[in] Layout.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param dest		[out] Destination buffer. (stride == width)
+ * @param src		[in] Source buffer. (width*height pixels)
+ */
+template<typename pixel>
+static inline void untileRaw(const Layout &layout,
+	unsigned int width, unsigned int height,
+	pixel *RESTRICT dest, const pixel *RESTRICT src)
+{
+	untile(layout, width, height, dest, width,
+		[src](unsigned int srcIdx) { return src[srcIdx]; });
+}
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_DECODER_TEXTURELAYOUT_HPP__ */
@@ -16,8 +16,10 @@
 #include "data/DX10Formats.hpp"
 
 // librpbase, librpfile
+#include "librpfile/FileView.hpp"
 using LibRpBase::rp_sprintf;
 using LibRpBase::RomFields;
+using LibRpFile::FileView;
 using LibRpFile::IRpFile;
 
 // librptexture
@@ -531,13 +533,6 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 	}
 	const uint32_t file_sz = static_cast<uint32_t>(file->size());
 
-	// Seek to the start of the texture data.
-	int ret = file->seek(texDataStartAddr);
-	if (ret != 0) {
-		// Seek error.
-		return nullptr;
-	}
-
 	// TODO: Handle DX10 alpha processing.
 	// Currently, we're assuming straight alpha for formats
 	// that have an alpha channel, except for DXT2 and DXT4,
@@ -610,11 +605,10 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 			return nullptr;
 		}
 
-		// Read the texture data.
-		auto buf = aligned_uptr<uint8_t>(16, expected_size);
-		size_t size = file->read(buf.get(), expected_size);
-		if (size != expected_size) {
-			// Read error.
+		// Get the texture data.
+		const FileView buf(file, texDataStartAddr, expected_size, 16);
+		if (buf.size() != expected_size) {
+			// Seek and/or read error.
 			return nullptr;
 		}
 
@@ -627,12 +621,12 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 					// 1-bit alpha.
 					img = ImageDecoder::fromDXT1_A1(
 						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 				} else {
 					// No alpha channel.
 					img = ImageDecoder::fromDXT1(
 						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 				}
 				break;
 
@@ -643,12 +637,12 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 					// Standard alpha: DXT3
 					img = ImageDecoder::fromDXT3(
 						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 				} else {
 					// Premultiplied alpha: DXT2
 					img = ImageDecoder::fromDXT2(
 						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 				}
 				break;
 
@@ -659,12 +653,12 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 					// Standard alpha: DXT5
 					img = ImageDecoder::fromDXT5(
 						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 				} else {
 					// Premultiplied alpha: DXT4
 					img = ImageDecoder::fromDXT4(
 						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 				}
 				break;
 
@@ -673,7 +667,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 			case DXGI_FORMAT_BC4_SNORM:
 				img = ImageDecoder::fromBC4(
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size);
+					buf.data(), expected_size);
 				break;
 
 			case DXGI_FORMAT_BC5_TYPELESS:
@@ -681,7 +675,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 			case DXGI_FORMAT_BC5_SNORM:
 				img = ImageDecoder::fromBC5(
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size);
+					buf.data(), expected_size);
 				break;
 
 			case DXGI_FORMAT_BC7_TYPELESS:
@@ -689,7 +683,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 			case DXGI_FORMAT_BC7_UNORM_SRGB:
 				img = ImageDecoder::fromBC7(
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size);
+					buf.data(), expected_size);
 				break;
 
 #ifdef ENABLE_PVRTC
@@ -697,7 +691,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 				// PVRTC, 2bpp, has alpha.
 				img = ImageDecoder::fromPVRTC(
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size,
+					buf.data(), expected_size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 
@@ -705,7 +699,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 				// PVRTC, 4bpp, has alpha.
 				img = ImageDecoder::fromPVRTC(
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size,
+					buf.data(), expected_size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 #endif /* ENABLE_PVRTC */
@@ -715,7 +709,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 				img = ImageDecoder::fromLinear32(
 					ImageDecoder::PXF_RGB9_E5,
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					reinterpret_cast<const uint32_t*>(buf.get()),
+					reinterpret_cast<const uint32_t*>(buf.data()),
 					expected_size);
 				break;
 
@@ -758,11 +752,10 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 			return nullptr;
 		}
 
-		// Read the texture data.
-		auto buf = aligned_uptr<uint8_t>(16, expected_size);
-		size_t size = file->read(buf.get(), expected_size);
-		if (size != expected_size) {
-			// Read error.
+		// Get the texture data.
+		const FileView buf(file, texDataStartAddr, expected_size, 16);
+		if (buf.size() != expected_size) {
+			// Seek and/or read error.
 			return nullptr;
 		}
 
@@ -772,7 +765,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 				img = ImageDecoder::fromLinear8(
 					(ImageDecoder::PixelFormat)pxf_uncomp,
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size, stride);
+					buf.data(), expected_size, stride);
 				break;
 
 			case sizeof(uint16_t):
@@ -780,7 +773,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 				img = ImageDecoder::fromLinear16(
 					(ImageDecoder::PixelFormat)pxf_uncomp,
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					reinterpret_cast<const uint16_t*>(buf.get()),
+					reinterpret_cast<const uint16_t*>(buf.data()),
 					expected_size, stride);
 				break;
 
@@ -789,7 +782,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 				img = ImageDecoder::fromLinear24(
 					(ImageDecoder::PixelFormat)pxf_uncomp,
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size, stride);
+					buf.data(), expected_size, stride);
 				break;
 
 			case sizeof(uint32_t):
@@ -797,7 +790,7 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 				img = ImageDecoder::fromLinear32(
 					(ImageDecoder::PixelFormat)pxf_uncomp,
 					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					reinterpret_cast<const uint32_t*>(buf.get()),
+					reinterpret_cast<const uint32_t*>(buf.data()),
 					expected_size, stride);
 				break;
 
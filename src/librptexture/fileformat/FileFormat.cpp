@@ -169,4 +169,58 @@ int FileFormat::getDimensions(int pBuf[3]) const
 	return 0;
 }
 
+/**
+ * Get the dimensions of the specified mipmap.
+ * This doesn't decode the mipmap, so it can be used
+ * to select a mipmap before calling mipmap().
+ *
+ * The default implementation only handles mipmap 0.
+ * Subclasses that can decode other mipmaps should
+ * override this function.
+ *
+ * @param mip	[in] Mipmap number.
+ * @param pBuf	[out] Three-element array for [x, y, z].
+ * @return 0 on success; -ENOENT if the mipmap can't be decoded; negative POSIX error code on error.
+ */
+int FileFormat::getMipmapDimensions(int mip, int pBuf[3]) const
+{
+	if (mip != 0) {
+		// Only the full image is available.
+		return -ENOENT;
+	}
+	return getDimensions(pBuf);
+}
+
+/**
+ * Calculate the dimensions of the specified mipmap.
+ * Each mipmap is half the size of the previous mipmap,
+ * with a minimum size of 1.
+ * @param mip	[in] Mipmap number.
+ * @param pBuf	[out] Three-element array for [x, y, z].
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int FileFormat::calcMipmapDimensions(int mip, int pBuf[3]) const
+{
+	assert(mip >= 0);
+	if (mip < 0) {
+		return -EINVAL;
+	}
+
+	int ret = getDimensions(pBuf);
+	if (ret != 0) {
+		return ret;
+	}
+
+	// NOTE: y and z may be 0 for 1D and 2D textures.
+	for (int i = 0; i < 3; i++) {
+		if (pBuf[i] > 0) {
+			pBuf[i] >>= mip;
+			if (pBuf[i] <= 0) {
+				pBuf[i] = 1;
+			}
+		}
+	}
+	return 0;
+}
+
 }
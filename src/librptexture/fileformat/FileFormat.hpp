@@ -172,6 +172,32 @@ class FileFormat
 		 */
 		virtual int mipmapCount(void) const = 0;
 
+		/**
+		 * Get the dimensions of the specified mipmap.
+		 * This doesn't decode the mipmap, so it can be used
+		 * to select a mipmap before calling mipmap().
+		 *
+		 * The default implementation only handles mipmap 0.
+		 * Subclasses that can decode other mipmaps should
+		 * override this function.
+		 *
+		 * @param mip	[in] Mipmap number.
+		 * @param pBuf	[out] Three-element array for [x, y, z].
+		 * @return 0 on success; -ENOENT if the mipmap can't be decoded; negative POSIX error code on error.
+		 */
+		virtual int getMipmapDimensions(int mip, int pBuf[3]) const;
+
+	protected:
+		/**
+		 * Calculate the dimensions of the specified mipmap.
+		 * Each mipmap is half the size of the previous mipmap,
+		 * with a minimum size of 1.
+		 * @param mip	[in] Mipmap number.
+		 * @param pBuf	[out] Three-element array for [x, y, z].
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int calcMipmapDimensions(int mip, int pBuf[3]) const;
+
 #ifdef ENABLE_LIBRPBASE_ROMFIELDS
 	public:
 		/**
@@ -162,6 +162,22 @@ class klass : public LibRpTexture::FileFormat { \
 		 */ \
 		void close(void) final;
 
+/**
+ * FileFormat subclass function declaration for getting mipmap dimensions.
+ * Only needed if the subclass can decode mipmaps other than mipmap 0.
+ */
+#define FILEFORMAT_DECL_MIPMAP_DIMENSIONS() \
+	public: \
+		/** \
+		 * Get the dimensions of the specified mipmap. \
+		 * This doesn't decode the mipmap, so it can be used \
+		 * to select a mipmap before calling mipmap(). \
+		 * @param mip	[in] Mipmap number. \
+		 * @param pBuf	[out] Three-element array for [x, y, z]. \
+		 * @return 0 on success; -ENOENT if the mipmap can't be decoded; negative POSIX error code on error. \
+		 */ \
+		int getMipmapDimensions(int mip, int pBuf[3]) const final;
+
 /**
  * End of FileFormat subclass declaration.
  */
@@ -22,7 +22,9 @@
 #include "data/GLenumStrings.hpp"
 
 // librpbase, librpfile
+#include "librpfile/FileView.hpp"
 using LibRpBase::RomFields;
+using LibRpFile::FileView;
 using LibRpFile::IRpFile;
 
 // librptexture
@@ -306,11 +308,11 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 		return nullptr;
 	}
 
-	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size = file->read(buf.get(), expected_size);
-	if (size != expected_size) {
-		// Read error.
+	// Get the texture data.
+	// NOTE: The texture data starts after the image size field.
+	const FileView buf(file, texDataStartAddr + sizeof(imageSize), expected_size, 16);
+	if (buf.size() != expected_size) {
+		// Seek and/or read error.
 		return nullptr;
 	}
 
@@ -322,21 +324,21 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 			// 24-bit RGB.
 			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_BGR888,
 				ktxHeader.pixelWidth, height,
-				buf.get(), expected_size, stride);
+				buf.data(), expected_size, stride);
 			break;
 
 		case GL_RGBA:
 			// 32-bit RGBA.
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_ABGR8888,
 				ktxHeader.pixelWidth, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf.data()), expected_size, stride);
 			break;
 
 		case GL_LUMINANCE:
 			// 8-bit Luminance.
 			img = ImageDecoder::fromLinear8(ImageDecoder::PXF_L8,
 				ktxHeader.pixelWidth, height,
-				buf.get(), expected_size, stride);
+				buf.data(), expected_size, stride);
 			break;
 
 		case GL_RGB9_E5:
@@ -344,7 +346,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 			// TODO: Does KTX handle GL_RGB9_E5 as compressed?
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
 				ktxHeader.pixelWidth, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf.data()), expected_size, stride);
 			break;
 
 		case 0:
@@ -358,21 +360,21 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// DXT1-compressed texture.
 					img = ImageDecoder::fromDXT1(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
 					// DXT1-compressed texture with 1-bit alpha.
 					img = ImageDecoder::fromDXT1_A1(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
 					// DXT3-compressed texture.
 					img = ImageDecoder::fromDXT3(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_RGBA_DXT5_S3TC:
@@ -381,14 +383,14 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// DXT5-compressed texture.
 					img = ImageDecoder::fromDXT5(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_ETC1_RGB8_OES:
 					// ETC1-compressed texture.
 					img = ImageDecoder::fromETC1(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_COMPRESSED_RGB8_ETC2:
@@ -397,7 +399,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// TODO: Handle sRGB.
 					img = ImageDecoder::fromETC2_RGB(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
@@ -407,7 +409,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// TODO: Handle sRGB.
 					img = ImageDecoder::fromETC2_RGB_A1(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_COMPRESSED_RGBA8_ETC2_EAC:
@@ -417,7 +419,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// TODO: Handle sRGB.
 					img = ImageDecoder::fromETC2_RGBA(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_COMPRESSED_RED_RGTC1:
@@ -426,7 +428,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC4(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_COMPRESSED_RG_RGTC2:
@@ -435,7 +437,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC5(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 				case GL_COMPRESSED_LUMINANCE_LATC1_EXT:
@@ -444,7 +446,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC4(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					// TODO: If this fails, return it anyway or return nullptr?
 					ImageDecoder::fromRed8ToL8(img);
 					break;
@@ -455,7 +457,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC5(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					// TODO: If this fails, return it anyway or return nullptr?
 					ImageDecoder::fromRG8ToLA8(img);
 					break;
@@ -465,35 +467,35 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// BPTC-compressed RGBA texture. (BC7)
 					img = ImageDecoder::fromBC7(
 						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						buf.data(), expected_size);
 					break;
 
 #ifdef ENABLE_PVRTC
 				case GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG:
 					// PVRTC, 2bpp, no alpha.
 					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+						buf.data(), expected_size,
 						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG:
 					// PVRTC, 2bpp, has alpha.
 					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+						buf.data(), expected_size,
 						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 
 				case GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG:
 					// PVRTC, 4bpp, no alpha.
 					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+						buf.data(), expected_size,
 						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG:
 					// PVRTC, 4bpp, has alpha.
 					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+						buf.data(), expected_size,
 						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 
@@ -501,7 +503,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// PVRTC-II, 2bpp.
 					// NOTE: Assuming this has alpha.
 					img = ImageDecoder::fromPVRTCII(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+						buf.data(), expected_size,
 						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 
@@ -509,7 +511,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// PVRTC-II, 4bpp.
 					// NOTE: Assuming this has alpha.
 					img = ImageDecoder::fromPVRTCII(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+						buf.data(), expected_size,
 						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 #endif /* ENABLE_PVRTC */
@@ -519,7 +521,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// TODO: Does KTX handle GL_RGB9_E5 as compressed?
 					img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
 						ktxHeader.pixelWidth, height,
-						reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
+						reinterpret_cast<const uint32_t*>(buf.data()), expected_size);
 					break;
 
 				default:
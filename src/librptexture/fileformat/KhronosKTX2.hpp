@@ -14,6 +14,7 @@
 namespace LibRpTexture {
 
 FILEFORMAT_DECL_BEGIN(KhronosKTX2)
+FILEFORMAT_DECL_MIPMAP_DIMENSIONS()
 
 	public:
 		static int isRomSupported_static(const DetectInfo *info);
@@ -20,7 +20,9 @@
 #include "pvr3_structs.h"
 
 // librpbase, librpfile
+#include "librpfile/FileView.hpp"
 using LibRpBase::RomFields;
+using LibRpFile::FileView;
 using LibRpFile::IRpFile;
 
 // librptexture
@@ -407,8 +409,10 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 
 	// If we're requesting a mipmap level higher than 0 (full image),
 	// adjust the start address, expected size, and dimensions.
+	// NOTE: Using a separate counter, since `mip` is needed
+	// to cache the decoded image below.
 	unsigned int start_addr = texDataStartAddr;
-	for (; mip > 0; mip--) {
+	for (int i = mip; i > 0; i--) {
 		width /= 2;
 		height /= 2;
 
@@ -430,10 +434,9 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 		return nullptr;
 	}
 
-	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->seekAndRead(start_addr, buf.get(), expected_size);
-	if (size != expected_size) {
+	// Get the texture data.
+	const FileView buf(file, start_addr, expected_size, 16);
+	if (buf.size() != expected_size) {
 		// Seek and/or read error.
 		return nullptr;
 	}
@@ -454,7 +457,7 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 				// 8-bit
 				img = ImageDecoder::fromLinear8(
 					static_cast<ImageDecoder::PixelFormat>(fmtLkup->pxfmt),
-					width, height, buf.get(), expected_size);
+					width, height, buf.data(), expected_size);
 				break;
 
 			case 15:
@@ -463,14 +466,14 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 				img = ImageDecoder::fromLinear16(
 					static_cast<ImageDecoder::PixelFormat>(fmtLkup->pxfmt),
 					width, height,
-					reinterpret_cast<const uint16_t*>(buf.get()), expected_size);
+					reinterpret_cast<const uint16_t*>(buf.data()), expected_size);
 				break;
 
 			case 24:
 				// 24-bit
 				img = ImageDecoder::fromLinear24(
 					static_cast<ImageDecoder::PixelFormat>(fmtLkup->pxfmt),
-					width, height, buf.get(), expected_size);
+					width, height, buf.data(), expected_size);
 				break;
 
 			case 32:
@@ -478,7 +481,7 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 				img = ImageDecoder::fromLinear32(
 					static_cast<ImageDecoder::PixelFormat>(fmtLkup->pxfmt),
 					width, height,
-					reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
+					reinterpret_cast<const uint32_t*>(buf.data()), expected_size);
 				break;
 
 			default:
@@ -492,110 +495,110 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 #ifdef ENABLE_PVRTC
 			case PVR3_PXF_PVRTC_2bpp_RGB:
 				// PVRTC, 2bpp, no alpha.
-				img = ImageDecoder::fromPVRTC(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTC(width, height, buf.data(), expected_size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 				break;
 
 			case PVR3_PXF_PVRTC_2bpp_RGBA:
 				// PVRTC, 2bpp, has alpha.
-				img = ImageDecoder::fromPVRTC(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTC(width, height, buf.data(), expected_size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 
 			case PVR3_PXF_PVRTC_4bpp_RGB:
 				// PVRTC, 4bpp, no alpha.
-				img = ImageDecoder::fromPVRTC(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTC(width, height, buf.data(), expected_size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 				break;
 
 			case PVR3_PXF_PVRTC_4bpp_RGBA:
 				// PVRTC, 4bpp, has alpha.
-				img = ImageDecoder::fromPVRTC(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTC(width, height, buf.data(), expected_size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 
 			case PVR3_PXF_PVRTCII_2bpp:
 				// PVRTC-II, 2bpp.
 				// NOTE: Assuming this has alpha.
-				img = ImageDecoder::fromPVRTCII(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTCII(width, height, buf.data(), expected_size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 
 			case PVR3_PXF_PVRTCII_4bpp:
 				// PVRTC-II, 4bpp.
 				// NOTE: Assuming this has alpha.
-				img = ImageDecoder::fromPVRTCII(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTCII(width, height, buf.data(), expected_size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 #endif /* ENABLE_PVRTC */
 
 			case PVR3_PXF_ETC1:
 				// ETC1-compressed texture.
-				img = ImageDecoder::fromETC1(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromETC1(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_ETC2_RGB:
 				// ETC2-compressed RGB texture.
-				img = ImageDecoder::fromETC2_RGB(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromETC2_RGB(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_ETC2_RGB_A1:
 				// ETC2-compressed RGB texture
 				// with punchthrough alpha.
-				img = ImageDecoder::fromETC2_RGB_A1(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromETC2_RGB_A1(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_ETC2_RGBA:
 				// ETC2-compressed RGB texture
 				// with EAC-compressed alpha channel.
-				img = ImageDecoder::fromETC2_RGBA(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromETC2_RGBA(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_DXT1:
 				// DXT1-compressed texture.
-				img = ImageDecoder::fromDXT1(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT1(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_DXT2:
 				// DXT2-compressed texture.
-				img = ImageDecoder::fromDXT2(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT2(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_DXT3:
 				// DXT3-compressed texture.
-				img = ImageDecoder::fromDXT3(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT3(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_DXT4:
 				// DXT4-compressed texture.
-				img = ImageDecoder::fromDXT4(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT4(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_DXT5:
 				// DXT2-compressed texture.
-				img = ImageDecoder::fromDXT5(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT5(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_BC4:
 				// RGTC, one component. (BC4)
-				img = ImageDecoder::fromBC4(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromBC4(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_BC5:
 				// RGTC, two components. (BC5)
-				img = ImageDecoder::fromBC5(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromBC5(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_BC7:
 				// BC7-compressed texture.
-				img = ImageDecoder::fromBC7(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromBC7(width, height, buf.data(), expected_size);
 				break;
 
 			case PVR3_PXF_R9G9B9E5:
 				// RGB9_E5 (technically uncompressed...)
 				img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
 					width, height,
-					reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
+					reinterpret_cast<const uint32_t*>(buf.data()), expected_size);
 				break;
 
 			default:
@@ -999,6 +1002,29 @@ int PowerVR3::mipmapCount(void) const
 	return d->pvr3Header.mipmap_count;
 }
 
+/**
+ * Get the dimensions of the specified mipmap.
+ * This doesn't decode the mipmap, so it can be used
+ * to select a mipmap before calling mipmap().
+ * @param mip	[in] Mipmap number.
+ * @param pBuf	[out] Three-element array for [x, y, z].
+ * @return 0 on success; -ENOENT if the mipmap can't be decoded; negative POSIX error code on error.
+ */
+int PowerVR3::getMipmapDimensions(int mip, int pBuf[3]) const
+{
+	RP_D(const PowerVR3);
+	if (!d->isValid)
+		return -EBADF;
+
+	// No mipmaps == one image.
+	const int mipmapCount = std::max(static_cast<int>(d->pvr3Header.mipmap_count), 1);
+	if (mip < 0 || mip >= mipmapCount) {
+		// Invalid mipmap number.
+		return -ENOENT;
+	}
+	return calcMipmapDimensions(mip, pBuf);
+}
+
 #ifdef ENABLE_LIBRPBASE_ROMFIELDS
 /**
  * Get property fields for rom-properties.
@@ -14,6 +14,7 @@
 namespace LibRpTexture {
 
 FILEFORMAT_DECL_BEGIN(PowerVR3)
+FILEFORMAT_DECL_MIPMAP_DIMENSIONS()
 FILEFORMAT_DECL_END()
 
 }
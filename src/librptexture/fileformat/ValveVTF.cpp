@@ -874,6 +874,29 @@ int ValveVTF::mipmapCount(void) const
 	return d->vtfHeader.mipmapCount;
 }
 
+/**
+ * Get the dimensions of the specified mipmap.
+ * This doesn't decode the mipmap, so it can be used
+ * to select a mipmap before calling mipmap().
+ * @param mip	[in] Mipmap number.
+ * @param pBuf	[out] Three-element array for [x, y, z].
+ * @return 0 on success; -ENOENT if the mipmap can't be decoded; negative POSIX error code on error.
+ */
+int ValveVTF::getMipmapDimensions(int mip, int pBuf[3]) const
+{
+	RP_D(const ValveVTF);
+	if (!d->isValid)
+		return -EBADF;
+
+	// No mipmaps == one image.
+	const int mipmapCount = std::max(static_cast<int>(d->vtfHeader.mipmapCount), 1);
+	if (mip < 0 || mip >= mipmapCount) {
+		// Invalid mipmap number.
+		return -ENOENT;
+	}
+	return calcMipmapDimensions(mip, pBuf);
+}
+
 #ifdef ENABLE_LIBRPBASE_ROMFIELDS
 /**
  * Get property fields for rom-properties.
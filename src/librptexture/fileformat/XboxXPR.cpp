@@ -19,6 +19,7 @@ using LibRpFile::IRpFile;
 // librptexture
 #include "img/rp_image.hpp"
 #include "decoder/ImageDecoder.hpp"
+#include "decoder/TextureLayout.hpp"
 
 namespace LibRpTexture {
 
@@ -56,87 +57,6 @@ class XboxXPRPrivate : public FileFormatPrivate
 		// Invalid pixel format message.
 		char invalid_pixel_format[24];
 
-		/**
-		 * Generate swizzle masks for unswizzling ARGB textures.
-		 * Based on Cxbx-Reloaded's unswizzling code:
-		 * https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
-		 * Original license: LGPLv2 (GPLv2 for contributions after 2012/01/13)
-		 *
-		 * This should be pretty straightforward.
-		 * It creates a bit pattern like ..zyxzyxzyx from ..xxx, ..yyy and ..zzz
-		 * If there are no bits left from any component it will pack the other masks
-		 * more tighly (Example: zzxzxzyx = Fewer x than z and even fewer y)
-		 *
-		 * rom-properties modification: Removed depth, since we're only
-		 * handling 2D textures.
-		 *
-		 * @param width
-		 * @param height
-		 * @param mask_x
-		 * @param mask_y
-		 */
-		static void generate_swizzle_masks(
-			unsigned int width, unsigned int height,
-			uint32_t *mask_x, uint32_t *mask_y);
-
-		/**
-		 * This fills a pattern with a value if your value has bits abcd and your
-		 * pattern is 11010100100 this will return: 0a0b0c00d00
-		 *
-		 * Based on Cxbx-Reloaded's unswizzling code:
-		 * https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
-		 * Original license: LGPLv2 (GPLv2 for contributions after 2012/01/13)
-		 *
-		 * @param pattern
-		 * @param value
-		 * @return
-		 */
-		static uint32_t fill_pattern(uint32_t pattern, uint32_t value);
-
-		/**
-		 * Get a swizzled texture offset.
-		 * Based on Cxbx-Reloaded's unswizzling code:
-		 * https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
-		 * Original license: LGPLv2 (GPLv2 for contributions after 2012/01/13)
-		 *
-		 * rom-properties modification: Removed depth, since we're only
-		 * handling 2D textures.
-		 *
-		 * @param x
-		 * @param y
-		 * @param mask_x
-		 * @param mask_y
-		 * @param bytes_per_pixel
-		 * @return
-		 */
-		static inline unsigned int get_swizzled_offset(
-			unsigned int x, unsigned int y,
-			uint32_t mask_x, uint32_t mask_y,
-			unsigned int bytes_per_pixel);
-
-		/**
-		 * Unswizzle an ARGB texture.
-		 * Based on Cxbx-Reloaded's unswizzling code:
-		 * https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
-		 * Original license: LGPLv2 (GPLv2 for contributions after 2012/01/13)
-		 *
-		 * rom-properties modification: Removed depth, since we're only
-		 * handling 2D textures. Also removed slice_pitch, since we don't
-		 * have any slices here.
-		 *
-		 * @param src_buf
-		 * @param width
-		 * @param height
-		 * @param dst_buf
-		 * @param row_pitch
-		 * @param slice_pitch
-		 * @param bytes_per_pixel
-		 */
-		static void unswizzle_box(const uint8_t *src_buf,
-			unsigned int width, unsigned int height,
-			uint8_t *dst_buf, unsigned int row_pitch,
-			unsigned int bytes_per_pixel);
-
 		/**
 		 * Load the XboxXPR image.
 		 * @return Image, or nullptr on error.
@@ -161,132 +81,6 @@ XboxXPRPrivate::~XboxXPRPrivate()
 	delete img;
 }
 
-/**
- * Generate swizzle masks for unswizzling ARGB textures.
- * Based on Cxbx-Reloaded's unswizzling code:
- * https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
- * Original license: LGPLv2 (GPLv2 for contributions after 2012/01/13)
- *
- * This should be pretty straightforward.
- * It creates a bit pattern like ..zyxzyxzyx from ..xxx, ..yyy and ..zzz
- * If there are no bits left from any component it will pack the other masks
- * more tighly (Example: zzxzxzyx = Fewer x than z and even fewer y)
- *
- * rom-properties modification: Removed depth, since we're only
- * handling 2D textures.
- *
- * @param width
- * @param height
- * @param mask_x
- * @param mask_y
- */
-void XboxXPRPrivate::generate_swizzle_masks(
-	unsigned int width, unsigned int height,
-	uint32_t *mask_x, uint32_t *mask_y)
-{
-	uint32_t x = 0, y = 0;
-	uint32_t bit = 1;
-	uint32_t mask_bit = 1;
-	bool done;
-	do {
-		done = true;
-		if (bit < width) { x |= mask_bit; mask_bit <<= 1; done = false; }
-		if (bit < height) { y |= mask_bit; mask_bit <<= 1; done = false; }
-		bit <<= 1;
-	} while(!done);
-	assert((x ^ y) == (mask_bit - 1));
-	*mask_x = x;
-	*mask_y = y;
-}
-
-/**
- * This fills a pattern with a value if your value has bits abcd and your
- * pattern is 11010100100 this will return: 0a0b0c00d00
- *
- * Based on Cxbx-Reloaded's unswizzling code:
- * https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
- * Original license: LGPLv2 (GPLv2 for contributions after 2012/01/13)
- *
- * @param pattern
- * @param value
- * @return
- */
-uint32_t XboxXPRPrivate::fill_pattern(uint32_t pattern, uint32_t value)
-{
-	uint32_t result = 0;
-	uint32_t bit = 1;
-	while(value) {
-		if (pattern & bit) {
-			/* Copy bit to result */
-			result |= value & 1 ? bit : 0;
-			value >>= 1;
-		}
-		bit <<= 1;
-	}
-	return result;
-}
-
-/**
- * Get a swizzled texture offset.
- * Based on Cxbx-Reloaded's unswizzling code:
- * https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
- * Original license: LGPLv2 (GPLv2 for contributions after 2012/01/13)
- *
- * rom-properties modification: Removed depth, since we're only
- * handling 2D textures.
- *
- * @param x
- * @param y
- * @param mask_x
- * @param mask_y
- * @param bytes_per_pixel
- * @return
- */
-inline unsigned int XboxXPRPrivate::get_swizzled_offset(
-	unsigned int x, unsigned int y,
-	uint32_t mask_x, uint32_t mask_y,
-	unsigned int bytes_per_pixel)
-{
-	return bytes_per_pixel * (fill_pattern(mask_x, x)
-	                       |  fill_pattern(mask_y, y));
-}
-
-/**
- * Unswizzle an ARGB texture.
- * Based on Cxbx-Reloaded's unswizzling code:
- * https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
- * Original license: LGPLv2 (GPLv2 for contributions after 2012/01/13)
- *
- * rom-properties modification: Removed depth, since we're only
- * handling 2D textures. Also removed slice_pitch, since we don't
- * have any slices here.
- *
- * @param src_buf
- * @param width
- * @param height
- * @param dst_buf
- * @param row_pitch
- * @param slice_pitch
- * @param bytes_per_pixel
- */
-void XboxXPRPrivate::unswizzle_box(const uint8_t *src_buf,
-	unsigned int width, unsigned int height,
-	uint8_t *dst_buf, unsigned int row_pitch,
-	unsigned int bytes_per_pixel)
-{
-	uint32_t mask_x, mask_y;
-	generate_swizzle_masks(width, height, &mask_x, &mask_y);
-
-	for (unsigned int y = 0; y < height; y++) {
-		for (unsigned int x = 0; x < width; x++) {
-			const uint8_t *src = src_buf +
-				get_swizzled_offset(x, y, mask_x, mask_y, bytes_per_pixel);
-			uint8_t *dst = dst_buf + y * row_pitch + x * bytes_per_pixel;
-			memcpy(dst, src, bytes_per_pixel);
-		}
-	}
-}
-
 /**
  * Load the XPR0 image.
  * @return Image, or nullptr on error.
@@ -439,6 +233,39 @@ const rp_image *XboxXPRPrivate::loadXboxXPR0Image(void)
 
 	const int width  = 1 << (xpr0Header.width_pow2 >> 4);
 	const int height = 1 << (xpr0Header.height_pow2 & 0x0F);
+
+	if (mode.swizzled) {
+		// Image is swizzled.
+		// Unswizzle the raw pixels first, then let the linear
+		// decoders handle the pixel format conversion.
+		// Swizzling is based on Cxbx-Reloaded:
+		// https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
+		const TextureLayout::Layout layout = TextureLayout::xboxSwizzle(
+			xpr0Header.width_pow2 >> 4, xpr0Header.height_pow2 & 0x0F);
+		auto unswz = aligned_uptr<uint8_t>(16, expected_size);
+		switch (mode.bpp) {
+			case 8:
+				TextureLayout::untileRaw(layout, width, height,
+					unswz.get(), buf.get());
+				break;
+			case 16:
+				TextureLayout::untileRaw(layout, width, height,
+					reinterpret_cast<uint16_t*>(unswz.get()),
+					reinterpret_cast<const uint16_t*>(buf.get()));
+				break;
+			case 32:
+				TextureLayout::untileRaw(layout, width, height,
+					reinterpret_cast<uint32_t*>(unswz.get()),
+					reinterpret_cast<const uint32_t*>(buf.get()));
+				break;
+			case 0:
+			default:
+				assert(!"Unsupported bpp value.");
+				return nullptr;
+		}
+		buf = std::move(unswz);
+	}
+
 	if (mode.dxtn != 0) {
 		// DXTn
 		switch (mode.dxtn) {
@@ -491,43 +318,6 @@ const rp_image *XboxXPRPrivate::loadXboxXPR0Image(void)
 		return nullptr;
 	}
 
-	if (mode.swizzled) {
-		// Image is swizzled.
-		// Unswizzling code is based on Cxbx-Reloaded:
-		// https://github.com/Cxbx-Reloaded/Cxbx-Reloaded/blob/5d79c0b66e58bf38d39ea28cb4de954209d1e8ad/src/devices/video/swizzle.cpp
-
-		// Image dimensions must be a multiple of 4.
-		assert(width % 4 == 0);
-		assert(height % 4 == 0);
-		if (width % 4 != 0 || height % 4 != 0) {
-			// Not a multiple of 4.
-			// Return the image as-is.
-			return img;
-		}
-
-		// Assuming we don't have any extra bytes of stride,
-		// since the image must be a multiple of 4px wide.
-		// 4px ARGB32 is 16 bytes.
-		assert(img->stride() == img->row_bytes());
-		if (img->stride() != img->row_bytes()) {
-			// We have extra bytes.
-			// Can't unswizzle this image right now.
-			// Return the image as-is.
-			return img;
-		}
-
-		// Assuming img is ARGB32, since we're converting it
-		// from either a 16-bit or 32-bit ARGB format.
-		rp_image *const imgunswz = new rp_image(width, height, rp_image::FORMAT_ARGB32);
-		unswizzle_box(static_cast<const uint8_t*>(img->bits()),
-			width, height,
-			static_cast<uint8_t*>(imgunswz->bits()),
-			img->stride(), sizeof(uint32_t));
-		delete img;
-		img = imgunswz;
-		return imgunswz;
-	}
-
 	return img;
 }
 
@@ -11,6 +11,9 @@
 #include "rp_image_p.hpp"
 #include "rp_image_backend.hpp"
 
+// librpthreads
+#include "librpthreads/Profiler.hpp"
+
 // Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
 #define rp_imagePrivate rp_image_private
 
@@ -107,6 +110,7 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 		clear_properties();
 		return;
 	}
+	RP_PROFILE_ALLOC(m_data_len);
 
 	// Do we need to allocate memory for the palette?
 	if (format == rp_image::FORMAT_CI8) {
@@ -0,0 +1,414 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture/tests)               *
+ * TextureLayoutTest.cpp: Test tiled and swizzled texture layouts.         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+#include "common.h"
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+#include "librptexture/decoder/ImageDecoder.hpp"
+#include "librptexture/decoder/PixelConversion.hpp"
+#include "librptexture/decoder/TextureLayout.hpp"
+using namespace LibRpTexture::PixelConversion;
+
+// librpcpu
+#include "librpcpu/bitstuff.h"
+#include "librpcpu/byteswap.h"
+
+// C includes.
+#include <stdint.h>
+#include <stdlib.h>
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <memory>
+#include <vector>
+using std::unique_ptr;
+using std::vector;
+
+namespace LibRpTexture { namespace Tests {
+
+class TextureLayoutTest : public ::testing::Test
+{
+	protected:
+		TextureLayoutTest()
+			: m_buf(BENCHMARK_DIM * BENCHMARK_DIM)
+		{
+			// Fill the buffer with a pseudo-random pattern.
+			uint32_t seed = 0x12345678;
+			for (auto iter = m_buf.begin(); iter != m_buf.end(); ++iter) {
+				seed = seed * 1103515245 + 12345;
+				*iter = static_cast<uint16_t>(seed >> 16);
+			}
+		}
+
+	public:
+		// Number of iterations for benchmarks.
+		static const unsigned int BENCHMARK_ITERATIONS = 100;
+
+		// Image size for benchmarks.
+		static const unsigned int BENCHMARK_DIM = 1024;
+
+		// Source buffer.
+		vector<uint16_t> m_buf;
+
+	public:
+		/** Reference implementations, using the old per-pixel methods. **/
+
+		/**
+		 * Dreamcast twiddled 16-bit, using a twiddle map lookup per pixel.
+		 * @param dim Image width and height.
+		 * @param img_buf Source buffer.
+		 * @return rp_image.
+		 */
+		static rp_image *ref_fromDreamcastSquareTwiddled16(unsigned int dim, const uint16_t *img_buf);
+
+		/**
+		 * Nintendo 3DS tiled RGB565, using a tile order table.
+		 * @param width Image width.
+		 * @param height Image height.
+		 * @param img_buf Source buffer.
+		 * @return rp_image.
+		 */
+		static rp_image *ref_fromN3DSTiledRGB565(unsigned int width, unsigned int height, const uint16_t *img_buf);
+
+		/**
+		 * Xbox swizzle offset, using Cxbx-Reloaded's fill_pattern().
+		 * @param x
+		 * @param y
+		 * @param width
+		 * @param height
+		 * @return Pixel index.
+		 */
+		static unsigned int ref_xboxSwizzledIndex(unsigned int x, unsigned int y,
+			unsigned int width, unsigned int height);
+
+		/**
+		 * Compare two ARGB32 images.
+		 * @param expected Expected image.
+		 * @param actual Actual image.
+		 */
+		static void compareImages(const rp_image *expected, const rp_image *actual);
+};
+
+/**
+ * Dreamcast twiddled 16-bit, using a twiddle map lookup per pixel.
+ * @param dim Image width and height.
+ * @param img_buf Source buffer.
+ * @return rp_image.
+ */
+rp_image *TextureLayoutTest::ref_fromDreamcastSquareTwiddled16(unsigned int dim, const uint16_t *img_buf)
+{
+	static unsigned int dc_tmap[4096];
+	if (dc_tmap[ARRAY_SIZE(dc_tmap)-1] == 0) {
+		for (unsigned int i = 0; i < ARRAY_SIZE(dc_tmap); i++) {
+			dc_tmap[i] = 0;
+			for (unsigned int j = 0, k = 1; k <= i; j++, k <<= 1) {
+				dc_tmap[i] |= ((i & k) << j);
+			}
+		}
+	}
+
+	rp_image *const img = new rp_image(dim, dim, rp_image::FORMAT_ARGB32);
+	for (unsigned int y = 0; y < dim; y++) {
+		uint32_t *px_dest = static_cast<uint32_t*>(img->scanLine(y));
+		for (unsigned int x = 0; x < dim; x++) {
+			const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
+			px_dest[x] = RGB565_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
+		}
+	}
+	return img;
+}
+
+/**
+ * Nintendo 3DS tiled RGB565, using a tile order table.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf Source buffer.
+ * @return rp_image.
+ */
+rp_image *TextureLayoutTest::ref_fromN3DSTiledRGB565(unsigned int width, unsigned int height, const uint16_t *img_buf)
+{
+	static const uint8_t N3DS_tile_order[] = {
+		 0,  1,  8,  9,  2,  3, 10, 11, 16, 17, 24, 25, 18, 19, 26, 27,
+		 4,  5, 12, 13,  6,  7, 14, 15, 20, 21, 28, 29, 22, 23, 30, 31,
+		32, 33, 40, 41, 34, 35, 42, 43, 48, 49, 56, 57, 50, 51, 58, 59,
+		36, 37, 44, 45, 38, 39, 46, 47, 52, 53, 60, 61, 54, 55, 62, 63
+	};
+
+	rp_image *const img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
+	for (unsigned int ty = 0; ty < height / 8; ty++) {
+		for (unsigned int tx = 0; tx < width / 8; tx++) {
+			for (unsigned int i = 0; i < 8*8; i++, img_buf++) {
+				const unsigned int pos = N3DS_tile_order[i];
+				uint32_t *px_dest = static_cast<uint32_t*>(img->scanLine(ty*8 + (pos / 8)));
+				px_dest[tx*8 + (pos % 8)] = RGB565_to_ARGB32(le16_to_cpu(*img_buf));
+			}
+		}
+	}
+	return img;
+}
+
+/**
+ * Xbox swizzle offset, using Cxbx-Reloaded's fill_pattern().
+ * @param x
+ * @param y
+ * @param width
+ * @param height
+ * @return Pixel index.
+ */
+unsigned int TextureLayoutTest::ref_xboxSwizzledIndex(unsigned int x, unsigned int y,
+	unsigned int width, unsigned int height)
+{
+	uint32_t mask_x = 0, mask_y = 0;
+	uint32_t bit = 1, mask_bit = 1;
+	bool done;
+	do {
+		done = true;
+		if (bit < width) { mask_x |= mask_bit; mask_bit <<= 1; done = false; }
+		if (bit < height) { mask_y |= mask_bit; mask_bit <<= 1; done = false; }
+		bit <<= 1;
+	} while (!done);
+
+	struct fill {
+		static uint32_t pattern(uint32_t pattern, uint32_t value) {
+			uint32_t result = 0;
+			for (uint32_t bit = 1; value != 0; bit <<= 1) {
+				if (pattern & bit) {
+					result |= (value & 1) ? bit : 0;
+					value >>= 1;
+				}
+			}
+			return result;
+		}
+	};
+	return fill::pattern(mask_x, x) | fill::pattern(mask_y, y);
+}
+
+/**
+ * Compare two ARGB32 images.
+ * @param expected Expected image.
+ * @param actual Actual image.
+ */
+void TextureLayoutTest::compareImages(const rp_image *expected, const rp_image *actual)
+{
+	ASSERT_TRUE(expected != nullptr);
+	ASSERT_TRUE(actual != nullptr);
+	ASSERT_EQ(expected->width(), actual->width());
+	ASSERT_EQ(expected->height(), actual->height());
+	ASSERT_EQ(expected->format(), actual->format());
+
+	const size_t row_bytes = expected->width() * sizeof(uint32_t);
+	for (int y = 0; y < expected->height(); y++) {
+		ASSERT_EQ(0, memcmp(expected->scanLine(y), actual->scanLine(y), row_bytes))
+			<< "Row " << y << " does not match.";
+	}
+}
+
+/**
+ * Test the Xbox swizzle layout against Cxbx-Reloaded's masks.
+ */
+TEST_F(TextureLayoutTest, xboxSwizzle)
+{
+	static const uint8_t sizes[][2] = {
+		{0,0}, {1,0}, {0,3}, {2,2}, {3,5}, {6,2}, {5,5}, {8,3}, {4,9}
+	};
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		const unsigned int width = 1U << sizes[i][0];
+		const unsigned int height = 1U << sizes[i][1];
+		const TextureLayout::Layout layout = TextureLayout::xboxSwizzle(sizes[i][0], sizes[i][1]);
+
+		// Use the pixel index as the pixel value.
+		vector<uint32_t> src(width * height);
+		for (unsigned int j = 0; j < src.size(); j++) {
+			src[j] = j;
+		}
+		vector<uint32_t> dest(width * height);
+		TextureLayout::untileRaw(layout, width, height, dest.data(), src.data());
+
+		for (unsigned int y = 0; y < height; y++) {
+			for (unsigned int x = 0; x < width; x++) {
+				ASSERT_EQ(ref_xboxSwizzledIndex(x, y, width, height), dest[y * width + x])
+					<< "Size " << width << 'x' << height << ", pixel (" << x << ',' << y << ')';
+			}
+		}
+	}
+}
+
+/**
+ * Test deposit_bits() and next_bits().
+ */
+TEST_F(TextureLayoutTest, depositBits)
+{
+	// Example from Cxbx-Reloaded's fill_pattern().
+	EXPECT_EQ(0x224U, TextureLayout::deposit_bits(0xB, 0x6A4));	// 11010100100
+	EXPECT_EQ(0U, TextureLayout::deposit_bits(0, 0xFFFF));
+	EXPECT_EQ(0xAAAAAAAAU, TextureLayout::deposit_bits(0xFFFF, 0xAAAAAAAA));
+
+	// next_bits() should count through the mask.
+	const uint32_t mask = 0x2A;
+	uint32_t bits = 0;
+	for (uint32_t i = 0; i < 8; i++) {
+		EXPECT_EQ(TextureLayout::deposit_bits(i, mask), bits);
+		bits = TextureLayout::next_bits(bits, mask);
+	}
+	EXPECT_EQ(0U, bits);
+}
+
+/**
+ * Test Dreamcast twiddled textures against the twiddle map.
+ */
+TEST_F(TextureLayoutTest, fromDreamcastSquareTwiddled16)
+{
+	static const unsigned int dims[] = {1, 2, 8, 64, 256};
+	for (unsigned int i = 0; i < ARRAY_SIZE(dims); i++) {
+		const unsigned int dim = dims[i];
+		unique_ptr<rp_image> expected(ref_fromDreamcastSquareTwiddled16(dim, m_buf.data()));
+		unique_ptr<rp_image> actual(ImageDecoder::fromDreamcastSquareTwiddled16(
+			ImageDecoder::PXF_RGB565, dim, dim, m_buf.data(), dim * dim * 2));
+		ASSERT_NO_FATAL_FAILURE(compareImages(expected.get(), actual.get()));
+	}
+}
+
+/**
+ * Test Nintendo 3DS tiled textures against the tile order table.
+ */
+TEST_F(TextureLayoutTest, fromN3DSTiledRGB565)
+{
+	static const unsigned int dims[][2] = {{8,8}, {48,48}, {24,16}, {256,128}};
+	for (unsigned int i = 0; i < ARRAY_SIZE(dims); i++) {
+		const unsigned int width = dims[i][0];
+		const unsigned int height = dims[i][1];
+		unique_ptr<rp_image> expected(ref_fromN3DSTiledRGB565(width, height, m_buf.data()));
+		unique_ptr<rp_image> actual(ImageDecoder::fromN3DSTiledRGB565(
+			width, height, m_buf.data(), width * height * 2));
+		ASSERT_NO_FATAL_FAILURE(compareImages(expected.get(), actual.get()));
+	}
+}
+
+/**
+ * Test GameCube 4x4 tiles against a direct tile walk.
+ */
+TEST_F(TextureLayoutTest, fromGcn16)
+{
+	static const unsigned int width = 20, height = 12;
+	unique_ptr<rp_image> expected(new rp_image(width, height, rp_image::FORMAT_ARGB32));
+	const uint16_t *src = m_buf.data();
+	for (unsigned int ty = 0; ty < height / 4; ty++) {
+		for (unsigned int tx = 0; tx < width / 4; tx++) {
+			for (unsigned int py = 0; py < 4; py++) {
+				uint32_t *px_dest = static_cast<uint32_t*>(expected->scanLine(ty*4 + py));
+				for (unsigned int px = 0; px < 4; px++, src++) {
+					px_dest[tx*4 + px] = RGB565_to_ARGB32(be16_to_cpu(*src));
+				}
+			}
+		}
+	}
+
+	unique_ptr<rp_image> actual(ImageDecoder::fromGcn16(
+		ImageDecoder::PXF_RGB565, width, height, m_buf.data(), width * height * 2));
+	ASSERT_NO_FATAL_FAILURE(compareImages(expected.get(), actual.get()));
+}
+
+/** Benchmarks **/
+
+/**
+ * Benchmark Dreamcast twiddled textures. (twiddle map)
+ */
+TEST_F(TextureLayoutTest, fromDreamcastSquareTwiddled16_tmap_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		delete ref_fromDreamcastSquareTwiddled16(BENCHMARK_DIM, m_buf.data());
+	}
+}
+
+/**
+ * Benchmark Dreamcast twiddled textures. (TextureLayout)
+ */
+TEST_F(TextureLayoutTest, fromDreamcastSquareTwiddled16_layout_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		delete ImageDecoder::fromDreamcastSquareTwiddled16(ImageDecoder::PXF_RGB565,
+			BENCHMARK_DIM, BENCHMARK_DIM, m_buf.data(), BENCHMARK_DIM * BENCHMARK_DIM * 2);
+	}
+}
+
+/**
+ * Benchmark Nintendo 3DS tiled textures. (tile order table)
+ */
+TEST_F(TextureLayoutTest, fromN3DSTiledRGB565_table_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		delete ref_fromN3DSTiledRGB565(BENCHMARK_DIM, BENCHMARK_DIM, m_buf.data());
+	}
+}
+
+/**
+ * Benchmark Nintendo 3DS tiled textures. (TextureLayout)
+ */
+TEST_F(TextureLayoutTest, fromN3DSTiledRGB565_layout_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		delete ImageDecoder::fromN3DSTiledRGB565(BENCHMARK_DIM, BENCHMARK_DIM,
+			m_buf.data(), BENCHMARK_DIM * BENCHMARK_DIM * 2);
+	}
+}
+
+/**
+ * Benchmark Xbox swizzled textures. (fill_pattern)
+ */
+TEST_F(TextureLayoutTest, xboxSwizzle_fill_pattern_benchmark)
+{
+	vector<uint16_t> dest(BENCHMARK_DIM * BENCHMARK_DIM);
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		for (unsigned int y = 0; y < BENCHMARK_DIM; y++) {
+			for (unsigned int x = 0; x < BENCHMARK_DIM; x++) {
+				dest[y * BENCHMARK_DIM + x] = m_buf[
+					ref_xboxSwizzledIndex(x, y, BENCHMARK_DIM, BENCHMARK_DIM)];
+			}
+		}
+	}
+}
+
+/**
+ * Benchmark Xbox swizzled textures. (TextureLayout)
+ */
+TEST_F(TextureLayoutTest, xboxSwizzle_layout_benchmark)
+{
+	const unsigned int dim_shift = uilog2(BENCHMARK_DIM);
+	const TextureLayout::Layout layout = TextureLayout::xboxSwizzle(dim_shift, dim_shift);
+	vector<uint16_t> dest(BENCHMARK_DIM * BENCHMARK_DIM);
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		TextureLayout::untileRaw(layout, BENCHMARK_DIM, BENCHMARK_DIM,
+			dest.data(), m_buf.data());
+	}
+}
+
+} }
+
+/**
+ * Test suite main function.
+ * Called by gtest_init.cpp.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpTexture test suite: TextureLayout tests.\n\n");
+	fprintf(stderr, "Benchmark iterations: %u\n",
+		LibRpTexture::Tests::TextureLayoutTest::BENCHMARK_ITERATIONS);
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,320 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * Profiler.cpp: Per-stage timing and byte counters.                       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "config.librpthreads.h"
+#include "Profiler.hpp"
+
+// C includes. (C++ namespace)
+#include <cassert>
+
+#ifdef ENABLE_PROFILING
+# include "Mutex.hpp"
+# include "pthread_once.h"
+# ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#   define WIN32_LEAN_AND_MEAN 1
+#  endif
+#  include <windows.h>
+# else /* !_WIN32 */
+#  include <pthread.h>
+# endif /* _WIN32 */
+
+// C++ includes.
+# include <atomic>
+# include <chrono>
+# include <vector>
+using std::atomic;
+using std::vector;
+#endif /* ENABLE_PROFILING */
+
+namespace LibRpThreads { namespace Profiler {
+
+#ifdef ENABLE_PROFILING
+using LibRpBase::Mutex;
+using LibRpBase::MutexLocker;
+
+/**
+ * Counters for a single thread.
+ *
+ * Each thread only updates its own counters, so adding a sample
+ * doesn't need a lock, and the worker threads don't contend on
+ * a shared cache line. The counters are summed when reporting.
+ */
+struct ThreadCounters {
+	atomic<uint64_t> calls[STAGE_MAX];
+	atomic<uint64_t> time_ns[STAGE_MAX];
+	atomic<uint64_t> bytes[STAGE_MAX];
+	atomic<uint64_t> alloc_count;
+	atomic<uint64_t> alloc_bytes;
+
+	ThreadCounters() { clear(); }
+
+	void clear(void)
+	{
+		for (int i = 0; i < STAGE_MAX; i++) {
+			calls[i].store(0, std::memory_order_relaxed);
+			time_ns[i].store(0, std::memory_order_relaxed);
+			bytes[i].store(0, std::memory_order_relaxed);
+		}
+		alloc_count.store(0, std::memory_order_relaxed);
+		alloc_bytes.store(0, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Add a value to a counter.
+	 * Only the owning thread may call this.
+	 * @param counter Counter.
+	 * @param val Value to add.
+	 */
+	static inline void add(atomic<uint64_t> &counter, uint64_t val)
+	{
+		// Only one thread writes to the counter, so a relaxed
+		// load and store is enough. Readers will see either
+		// the old value or the new value.
+		counter.store(counter.load(std::memory_order_relaxed) + val,
+			std::memory_order_relaxed);
+	}
+};
+
+/**
+ * All thread counters.
+ *
+ * NOTE: Counters are never freed. When a thread exits, its counters
+ * are reused by the next thread that needs them, so the totals are
+ * preserved and the number of ThreadCounters is limited to the
+ * maximum number of concurrent threads. (On Windows, TLS doesn't
+ * have a destructor, so they aren't reused there.)
+ *
+ * This is allocated once and never deleted, since worker threads
+ * may exit after static destructors have run.
+ */
+struct CounterRegistry {
+	Mutex mutex;
+	vector<ThreadCounters*> all;	// All counters.
+	vector<ThreadCounters*> unused;	// Counters from threads that have exited.
+};
+static CounterRegistry *registry = nullptr;
+
+// Thread-local storage for the current thread's counters.
+static pthread_once_t tls_once_control = PTHREAD_ONCE_INIT;
+#ifdef _WIN32
+static DWORD tls_index = TLS_OUT_OF_INDEXES;
+#else /* !_WIN32 */
+static pthread_key_t tls_key;
+
+/**
+ * A thread has exited. Mark its counters as reusable.
+ * @param param ThreadCounters.
+ */
+static void releaseThreadCounters(void *param)
+{
+	MutexLocker mtxLocker(registry->mutex);
+	registry->unused.push_back(static_cast<ThreadCounters*>(param));
+}
+#endif /* _WIN32 */
+
+/**
+ * Initialize the counter registry and the thread-local storage key.
+ * Called by pthread_once().
+ */
+static void initTls(void)
+{
+	registry = new CounterRegistry();
+#ifdef _WIN32
+	tls_index = TlsAlloc();
+#else /* !_WIN32 */
+	pthread_key_create(&tls_key, releaseThreadCounters);
+#endif /* _WIN32 */
+}
+
+/**
+ * Get the current thread's counters.
+ * @return ThreadCounters.
+ */
+static ThreadCounters *threadCounters(void)
+{
+	pthread_once(&tls_once_control, initTls);
+#ifdef _WIN32
+	ThreadCounters *tc = static_cast<ThreadCounters*>(TlsGetValue(tls_index));
+#else /* !_WIN32 */
+	ThreadCounters *tc = static_cast<ThreadCounters*>(pthread_getspecific(tls_key));
+#endif /* _WIN32 */
+	if (tc)
+		return tc;
+
+	// First sample on this thread.
+	MutexLocker mtxLocker(registry->mutex);
+	if (!registry->unused.empty()) {
+		tc = registry->unused.back();
+		registry->unused.pop_back();
+	} else {
+		tc = new ThreadCounters();
+		registry->all.push_back(tc);
+	}
+#ifdef _WIN32
+	TlsSetValue(tls_index, tc);
+#else /* !_WIN32 */
+	pthread_setspecific(tls_key, tc);
+#endif /* _WIN32 */
+	return tc;
+}
+
+// Is profiling enabled at runtime?
+static volatile bool enabled = false;
+
+/**
+ * Is profiling enabled at runtime?
+ *
+ * Profiling support has to be compiled in using ENABLE_PROFILING,
+ * but the counters are only updated if profiling is enabled at
+ * runtime, e.g. using `rpcli --profile`.
+ *
+ * @return True if enabled; false if not.
+ */
+bool isEnabled(void)
+{
+	return enabled;
+}
+
+/**
+ * Enable or disable profiling at runtime.
+ * @param enable True to enable; false to disable.
+ */
+void setEnabled(bool enable)
+{
+	enabled = enable;
+}
+
+/**
+ * Reset all counters.
+ * NOTE: Samples that are added while resetting may be lost.
+ */
+void reset(void)
+{
+	pthread_once(&tls_once_control, initTls);
+	MutexLocker mtxLocker(registry->mutex);
+	for (auto iter = registry->all.begin(); iter != registry->all.end(); ++iter) {
+		(*iter)->clear();
+	}
+}
+
+/**
+ * Get the current time from a monotonic clock.
+ * @return Current time, in nanoseconds.
+ */
+uint64_t now_ns(void)
+{
+	using namespace std::chrono;
+	return static_cast<uint64_t>(duration_cast<nanoseconds>(
+		steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Add a timing sample to a stage.
+ * @param stage		[in] Stage.
+ * @param time_ns	[in] Elapsed time, in nanoseconds.
+ * @param bytes		[in] Number of bytes processed.
+ */
+void addSample(Stage stage, uint64_t time_ns, uint64_t bytes)
+{
+	assert(stage >= 0 && stage < STAGE_MAX);
+	if (stage < 0 || stage >= STAGE_MAX)
+		return;
+
+	ThreadCounters *const tc = threadCounters();
+	ThreadCounters::add(tc->calls[stage], 1);
+	ThreadCounters::add(tc->time_ns[stage], time_ns);
+	ThreadCounters::add(tc->bytes[stage], bytes);
+}
+
+/**
+ * Count an image allocation.
+ * @param bytes		[in] Number of bytes allocated.
+ */
+void addAlloc(size_t bytes)
+{
+	ThreadCounters *const tc = threadCounters();
+	ThreadCounters::add(tc->alloc_count, 1);
+	ThreadCounters::add(tc->alloc_bytes, bytes);
+}
+
+/**
+ * Get the statistics for a stage.
+ * @param stage		[in] Stage.
+ * @param pStats	[out] Statistics.
+ */
+void getStats(Stage stage, StageStats *pStats)
+{
+	assert(stage >= 0 && stage < STAGE_MAX);
+	assert(pStats != nullptr);
+	if (stage < 0 || stage >= STAGE_MAX || !pStats)
+		return;
+
+	// Sum the counters from all threads.
+	pthread_once(&tls_once_control, initTls);
+	StageStats stats = {0, 0, 0};
+	MutexLocker mtxLocker(registry->mutex);
+	for (auto iter = registry->all.cbegin(); iter != registry->all.cend(); ++iter) {
+		const ThreadCounters *const tc = *iter;
+		stats.calls += tc->calls[stage].load(std::memory_order_relaxed);
+		stats.time_ns += tc->time_ns[stage].load(std::memory_order_relaxed);
+		stats.bytes += tc->bytes[stage].load(std::memory_order_relaxed);
+	}
+	*pStats = stats;
+}
+
+/**
+ * Get the image allocation statistics.
+ * @param pStats	[out] Statistics.
+ */
+void getAllocStats(AllocStats *pStats)
+{
+	assert(pStats != nullptr);
+	if (!pStats)
+		return;
+
+	// Sum the counters from all threads.
+	pthread_once(&tls_once_control, initTls);
+	AllocStats stats = {0, 0};
+	MutexLocker mtxLocker(registry->mutex);
+	for (auto iter = registry->all.cbegin(); iter != registry->all.cend(); ++iter) {
+		const ThreadCounters *const tc = *iter;
+		stats.count += tc->alloc_count.load(std::memory_order_relaxed);
+		stats.bytes += tc->alloc_bytes.load(std::memory_order_relaxed);
+	}
+	*pStats = stats;
+}
+#endif /* ENABLE_PROFILING */
+
+/**
+ * Get the name of a stage.
+ * @param stage Stage.
+ * @return Stage name, or nullptr if invalid.
+ */
+const char *stageName(Stage stage)
+{
+	static const char *const stage_names[] = {
+		"detect",
+		"construct",
+		"loadFieldData",
+		"loadInternalImage",
+		"imageDecode",
+		"decrypt",
+		"pngEncode",
+		"discIO",
+	};
+	static_assert(ARRAY_SIZE(stage_names) == STAGE_MAX,
+		"stage_names[] is out of sync with Profiler::Stage.");
+
+	assert(stage >= 0 && stage < STAGE_MAX);
+	if (stage < 0 || stage >= STAGE_MAX)
+		return nullptr;
+	return stage_names[stage];
+}
+
+} }
@@ -0,0 +1,205 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * Profiler.hpp: Per-stage timing and byte counters.                       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTHREADS_PROFILER_HPP__
+#define __ROMPROPERTIES_LIBRPTHREADS_PROFILER_HPP__
+
+#include "config.librpthreads.h"
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+
+// C includes. (C++ namespace)
+#include <cstddef>
+
+#ifdef ENABLE_USDT
+// SystemTap USDT probes. (usable with perf, bpftrace, etc.)
+# include <sys/sdt.h>
+#endif /* ENABLE_USDT */
+
+namespace LibRpThreads { namespace Profiler {
+
+/**
+ * Profiling stages.
+ * Each stage is timed separately.
+ */
+enum Stage {
+	STAGE_DETECT = 0,		// RomDataFactory: Header detection
+	STAGE_CONSTRUCT,		// RomDataFactory: RomData subclass constructor
+	STAGE_LOAD_FIELD_DATA,		// RomData::loadFieldData()
+	STAGE_LOAD_INTERNAL_IMAGE,	// RomData::loadInternalImage()
+	STAGE_IMAGE_DECODE,		// ImageDecoder functions
+	STAGE_DECRYPT,			// IAesCipher::decrypt()
+	STAGE_PNG_ENCODE,		// RpPngWriter::write_IDAT()
+	STAGE_DISC_IO,			// ReadAhead: Backend reads (bytes / calls == effective I/O size)
+
+	STAGE_MAX
+};
+
+/**
+ * Statistics for a single stage.
+ */
+struct StageStats {
+	uint64_t calls;		// Number of calls.
+	uint64_t time_ns;	// Total time, in nanoseconds.
+	uint64_t bytes;		// Number of bytes processed.
+};
+
+/**
+ * Image allocation statistics.
+ */
+struct AllocStats {
+	uint64_t count;		// Number of allocations.
+	uint64_t bytes;		// Total number of bytes allocated.
+};
+
+#ifdef ENABLE_PROFILING
+/**
+ * Is profiling enabled at runtime?
+ *
+ * Profiling support has to be compiled in using ENABLE_PROFILING,
+ * but the counters are only updated if profiling is enabled at
+ * runtime, e.g. using `rpcli --profile`.
+ *
+ * @return True if enabled; false if not.
+ */
+bool isEnabled(void);
+
+/**
+ * Enable or disable profiling at runtime.
+ * @param enable True to enable; false to disable.
+ */
+void setEnabled(bool enable);
+
+/**
+ * Reset all counters.
+ */
+void reset(void);
+
+/**
+ * Get the current time from a monotonic clock.
+ * @return Current time, in nanoseconds.
+ */
+uint64_t now_ns(void);
+
+/**
+ * Add a timing sample to a stage.
+ * @param stage		[in] Stage.
+ * @param time_ns	[in] Elapsed time, in nanoseconds.
+ * @param bytes		[in] Number of bytes processed.
+ */
+void addSample(Stage stage, uint64_t time_ns, uint64_t bytes);
+
+/**
+ * Count an image allocation.
+ * @param bytes		[in] Number of bytes allocated.
+ */
+void addAlloc(size_t bytes);
+
+/**
+ * Get the statistics for a stage.
+ * @param stage		[in] Stage.
+ * @param pStats	[out] Statistics.
+ */
+void getStats(Stage stage, StageStats *pStats);
+
+/**
+ * Get the image allocation statistics.
+ * @param pStats	[out] Statistics.
+ */
+void getAllocStats(AllocStats *pStats);
+#endif /* ENABLE_PROFILING */
+
+/**
+ * Get the name of a stage.
+ * @param stage Stage.
+ * @return Stage name, or nullptr if invalid.
+ */
+const char *stageName(Stage stage);
+
+#if defined(ENABLE_PROFILING) || defined(ENABLE_USDT)
+/**
+ * Scoped stage timer.
+ * Use the RP_PROFILE_SCOPE() macros instead of using this directly.
+ */
+class ScopedTimer
+{
+	public:
+		inline explicit ScopedTimer(Stage stage, uint64_t bytes = 0)
+			: m_stage(stage)
+			, m_bytes(bytes)
+#ifdef ENABLE_PROFILING
+			, m_active(isEnabled())
+			, m_start(m_active ? now_ns() : 0)
+#endif /* ENABLE_PROFILING */
+		{
+#ifdef ENABLE_USDT
+			DTRACE_PROBE2(rom_properties, stage__begin, (int)m_stage, m_bytes);
+#endif /* ENABLE_USDT */
+		}
+
+		inline ~ScopedTimer()
+		{
+#ifdef ENABLE_PROFILING
+			if (m_active) {
+				addSample(m_stage, now_ns() - m_start, m_bytes);
+			}
+#endif /* ENABLE_PROFILING */
+#ifdef ENABLE_USDT
+			DTRACE_PROBE2(rom_properties, stage__end, (int)m_stage, m_bytes);
+#endif /* ENABLE_USDT */
+		}
+
+	private:
+		RP_DISABLE_COPY(ScopedTimer)
+
+	private:
+		const Stage m_stage;
+		const uint64_t m_bytes;
+#ifdef ENABLE_PROFILING
+		const bool m_active;
+		const uint64_t m_start;
+#endif /* ENABLE_PROFILING */
+};
+#endif /* ENABLE_PROFILING || ENABLE_USDT */
+
+} }
+
+/**
+ * Profiling macros.
+ * These compile to nothing if neither ENABLE_PROFILING
+ * nor ENABLE_USDT is set.
+ *
+ * RP_PROFILE_SCOPE(stage): Time the rest of the current scope.
+ * RP_PROFILE_SCOPE_BYTES(stage, bytes): Same, but also count bytes processed.
+ * RP_PROFILE_ALLOC(bytes): Count an image allocation.
+ *
+ * NOTE: Only one RP_PROFILE_SCOPE() can be used per scope.
+ */
+#if defined(ENABLE_PROFILING) || defined(ENABLE_USDT)
+# define RP_PROFILE_SCOPE(stage) \
+	const LibRpThreads::Profiler::ScopedTimer rp_profile_timer_(LibRpThreads::Profiler::stage)
+# define RP_PROFILE_SCOPE_BYTES(stage, bytes) \
+	const LibRpThreads::Profiler::ScopedTimer rp_profile_timer_(LibRpThreads::Profiler::stage, (bytes))
+#else /* !(ENABLE_PROFILING || ENABLE_USDT) */
+# define RP_PROFILE_SCOPE(stage) do { } while (0)
+# define RP_PROFILE_SCOPE_BYTES(stage, bytes) do { } while (0)
+#endif /* ENABLE_PROFILING || ENABLE_USDT */
+
+#ifdef ENABLE_PROFILING
+# define RP_PROFILE_ALLOC(bytes) do { \
+	if (LibRpThreads::Profiler::isEnabled()) { \
+		LibRpThreads::Profiler::addAlloc(bytes); \
+	} \
+} while (0)
+#else /* !ENABLE_PROFILING */
+# define RP_PROFILE_ALLOC(bytes) do { } while (0)
+#endif /* ENABLE_PROFILING */
+
+#endif /* __ROMPROPERTIES_LIBRPTHREADS_PROFILER_HPP__ */
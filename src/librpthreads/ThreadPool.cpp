@@ -0,0 +1,1201 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * ThreadPool.cpp: Work-stealing thread pool.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "config.librpthreads.h"
+#include "ThreadPool.hpp"
+
+#include "Atomics.h"
+#include "Mutex.hpp"
+#include "pthread_once.h"
+
+#ifdef _WIN32
+# ifndef WIN32_LEAN_AND_MEAN
+#  define WIN32_LEAN_AND_MEAN 1
+# endif
+# include <windows.h>
+# include <process.h>
+#else /* !_WIN32 */
+# include <pthread.h>
+# include <sched.h>
+# include <unistd.h>
+#endif /* _WIN32 */
+
+// C includes. (C++ namespace)
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+
+// C++ includes.
+#include <deque>
+#include <vector>
+using std::deque;
+using std::vector;
+
+namespace LibRpBase {
+
+/** PoolCondLock **/
+
+/**
+ * Mutex with an associated condition variable.
+ * Used for sleeping workers and TaskGroup waiters.
+ */
+class PoolCondLock
+{
+	public:
+		PoolCondLock();
+		~PoolCondLock();
+
+	private:
+#if __cplusplus >= 201103L
+		PoolCondLock(const PoolCondLock &) = delete;
+		PoolCondLock &operator=(const PoolCondLock &) = delete;
+#else /* __cplusplus < 201103L */
+		PoolCondLock(const PoolCondLock &);
+		PoolCondLock &operator=(const PoolCondLock &);
+#endif /* __cplusplus */
+
+	public:
+		inline void lock(void);
+		inline void unlock(void);
+
+		/**
+		 * Wait for a notification.
+		 * The lock must be held by the calling thread.
+		 */
+		inline void wait(void);
+
+		inline void notifyOne(void);
+		inline void notifyAll(void);
+
+	private:
+#ifdef _WIN32
+		SRWLOCK m_lock;
+		CONDITION_VARIABLE m_cond;
+#else /* !_WIN32 */
+		pthread_mutex_t m_mutex;
+		pthread_cond_t m_cond;
+#endif /* _WIN32 */
+};
+
+#ifdef _WIN32
+PoolCondLock::PoolCondLock()
+{
+	InitializeSRWLock(&m_lock);
+	InitializeConditionVariable(&m_cond);
+}
+
+PoolCondLock::~PoolCondLock()
+{
+	// Nothing to do here...
+}
+
+inline void PoolCondLock::lock(void)
+{
+	AcquireSRWLockExclusive(&m_lock);
+}
+
+inline void PoolCondLock::unlock(void)
+{
+	ReleaseSRWLockExclusive(&m_lock);
+}
+
+inline void PoolCondLock::wait(void)
+{
+	SleepConditionVariableSRW(&m_cond, &m_lock, INFINITE, 0);
+}
+
+inline void PoolCondLock::notifyOne(void)
+{
+	WakeConditionVariable(&m_cond);
+}
+
+inline void PoolCondLock::notifyAll(void)
+{
+	WakeAllConditionVariable(&m_cond);
+}
+#else /* !_WIN32 */
+PoolCondLock::PoolCondLock()
+{
+	int ret = pthread_mutex_init(&m_mutex, nullptr);
+	assert(ret == 0);
+	ret = pthread_cond_init(&m_cond, nullptr);
+	assert(ret == 0);
+	((void)ret);
+}
+
+PoolCondLock::~PoolCondLock()
+{
+	pthread_cond_destroy(&m_cond);
+	pthread_mutex_destroy(&m_mutex);
+}
+
+inline void PoolCondLock::lock(void)
+{
+	pthread_mutex_lock(&m_mutex);
+}
+
+inline void PoolCondLock::unlock(void)
+{
+	pthread_mutex_unlock(&m_mutex);
+}
+
+inline void PoolCondLock::wait(void)
+{
+	pthread_cond_wait(&m_cond, &m_mutex);
+}
+
+inline void PoolCondLock::notifyOne(void)
+{
+	pthread_cond_signal(&m_cond);
+}
+
+inline void PoolCondLock::notifyAll(void)
+{
+	pthread_cond_broadcast(&m_cond);
+}
+#endif /* _WIN32 */
+
+/** ScratchArena **/
+
+struct ScratchArena::Block {
+	Block *prev;	// Previous block.
+	size_t size;	// Size of the data area.
+	// Data area follows the header.
+
+	inline uint8_t *data(void)
+	{
+		return reinterpret_cast<uint8_t*>(this + 1);
+	}
+};
+
+// Minimum block size.
+static const size_t SCRATCH_BLOCK_SIZE_MIN = 64*1024;
+
+ScratchArena::ScratchArena()
+	: m_head(nullptr)
+	, m_used(0)
+	, m_capacity(0)
+{ }
+
+ScratchArena::~ScratchArena()
+{
+	Block *blk = m_head;
+	while (blk) {
+		Block *const prev = blk->prev;
+		free(blk);
+		blk = prev;
+	}
+}
+
+/**
+ * Allocate memory from the arena.
+ * @param size Size, in bytes.
+ * @param align Alignment. (must be a power of two; maximum 64)
+ * @return Pointer to the memory, or nullptr on error.
+ */
+void *ScratchArena::alloc(size_t size, size_t align)
+{
+	assert(align != 0 && (align & (align - 1)) == 0);
+	assert(align <= 64);
+	if (align == 0 || (align & (align - 1)) != 0 || align > 64)
+		return nullptr;
+
+	if (m_head) {
+		// Check if the allocation fits in the current block.
+		const uintptr_t base = reinterpret_cast<uintptr_t>(m_head->data());
+		const uintptr_t addr = (base + m_used + (align - 1)) & ~static_cast<uintptr_t>(align - 1);
+		const size_t offset = static_cast<size_t>(addr - base);
+		if (offset <= m_head->size && size <= m_head->size - offset) {
+			m_used = offset + size;
+			return reinterpret_cast<void*>(addr);
+		}
+	}
+
+	// Allocate a new block.
+	// Blocks grow geometrically so reset() converges on a single block.
+	if (size > SIZE_MAX - sizeof(Block) - align)
+		return nullptr;
+	size_t blkSize = (m_capacity > SCRATCH_BLOCK_SIZE_MIN ? m_capacity : SCRATCH_BLOCK_SIZE_MIN);
+	if (blkSize < size + align) {
+		blkSize = size + align;
+	}
+	Block *const blk = static_cast<Block*>(malloc(sizeof(Block) + blkSize));
+	if (!blk)
+		return nullptr;
+	blk->prev = m_head;
+	blk->size = blkSize;
+	m_head = blk;
+	m_used = 0;
+	m_capacity += blkSize;
+
+	const uintptr_t base = reinterpret_cast<uintptr_t>(blk->data());
+	const uintptr_t addr = (base + (align - 1)) & ~static_cast<uintptr_t>(align - 1);
+	m_used = static_cast<size_t>(addr - base) + size;
+	return reinterpret_cast<void*>(addr);
+}
+
+/**
+ * Release all allocations.
+ * If more than one block was allocated, the blocks are
+ * coalesced into a single block for the next round.
+ */
+void ScratchArena::reset(void)
+{
+	m_used = 0;
+	if (!m_head || !m_head->prev)
+		return;
+
+	// Multiple blocks. Replace them with a single block.
+	const size_t total = m_capacity;
+	Block *blk = m_head;
+	while (blk) {
+		Block *const prev = blk->prev;
+		free(blk);
+		blk = prev;
+	}
+	m_head = static_cast<Block*>(malloc(sizeof(Block) + total));
+	if (m_head) {
+		m_head->prev = nullptr;
+		m_head->size = total;
+		m_capacity = total;
+	} else {
+		m_capacity = 0;
+	}
+}
+
+/**
+ * Get the total capacity of the arena.
+ * @return Capacity, in bytes.
+ */
+size_t ScratchArena::capacity(void) const
+{
+	return m_capacity;
+}
+
+/**
+ * Get the current allocation state.
+ * @return Allocation state.
+ */
+ScratchArena::Mark ScratchArena::mark(void) const
+{
+	Mark mark;
+	mark.block = m_head;
+	mark.used = m_used;
+	return mark;
+}
+
+/**
+ * Rewind to a previous allocation state.
+ * Blocks allocated after the mark are freed.
+ * @param mark Allocation state from mark().
+ */
+void ScratchArena::rewind(const Mark &mark)
+{
+	if (!mark.block || (mark.used == 0 && !mark.block->prev)) {
+		// The arena was empty when the mark was taken.
+		// Coalesce the blocks for the next task.
+		reset();
+		return;
+	}
+
+	while (m_head && m_head != mark.block) {
+		Block *const prev = m_head->prev;
+		m_capacity -= m_head->size;
+		free(m_head);
+		m_head = prev;
+	}
+	m_used = mark.used;
+}
+
+/** ThreadPoolPrivate **/
+
+class TaskGroupPrivate;
+
+// Queued task.
+struct PoolTask {
+	TaskGroup::TaskFn fn;
+	void *param;
+	TaskGroupPrivate *group;
+};
+
+class ThreadPoolPrivate;
+
+// Worker thread.
+struct PoolWorker {
+	ThreadPoolPrivate *pool;
+	int index;
+
+	Mutex mtxQueue;		// Protects queue.
+	deque<PoolTask> queue;	// Owner uses the back; thieves use the front.
+	ScratchArena arena;
+
+#ifdef _WIN32
+	HANDLE hThread;
+#else /* !_WIN32 */
+	pthread_t thread;
+#endif /* _WIN32 */
+};
+
+class ThreadPoolPrivate
+{
+	public:
+		explicit ThreadPoolPrivate(int threads);
+		~ThreadPoolPrivate();
+
+	private:
+#if __cplusplus >= 201103L
+		ThreadPoolPrivate(const ThreadPoolPrivate &) = delete;
+		ThreadPoolPrivate &operator=(const ThreadPoolPrivate &) = delete;
+#else /* __cplusplus < 201103L */
+		ThreadPoolPrivate(const ThreadPoolPrivate &);
+		ThreadPoolPrivate &operator=(const ThreadPoolPrivate &);
+#endif /* __cplusplus */
+
+	public:
+		vector<PoolWorker*> workers;
+		int maxThreads;		// Requested number of worker threads.
+
+		// Worker threads are started on first use.
+		Mutex startMutex;
+		volatile int started;
+
+		// Sleeping workers wait on this until a task is queued.
+		// Workers waiting on a TaskGroup also sleep here.
+		PoolCondLock wakeLock;
+		volatile int queued;	// Number of queued tasks. (approximate)
+		volatile int shutdown;	// Set when the pool is being destroyed.
+		volatile int rr;	// Round-robin counter for external submissions.
+		volatile int waitingWorkers;	// Number of workers waiting on a TaskGroup.
+
+	public:
+		/**
+		 * Start the worker threads if they haven't been started yet.
+		 * If thread creation fails, the pool uses whatever threads
+		 * were started, and tasks are run inline if none were.
+		 */
+		void startWorkers(void);
+
+		/**
+		 * Wait for a task to be queued or for a TaskGroup to finish.
+		 * Called by worker threads waiting on a TaskGroup.
+		 * @param group TaskGroup.
+		 */
+		void waitForWork(TaskGroupPrivate *group);
+
+		/**
+		 * Get the worker for the current thread.
+		 * @return Worker, or nullptr if the current thread isn't a worker in this pool.
+		 */
+		PoolWorker *currentWorker(void) const;
+
+		/**
+		 * Queue a task.
+		 * @param task Task.
+		 */
+		void push(const PoolTask &task);
+
+		/**
+		 * Run one queued task, if one is available.
+		 * @param self Worker for the current thread, or nullptr if not a worker.
+		 * @param arena Scratch arena for the current thread.
+		 * @return True if a task was run; false if not.
+		 */
+		bool runOne(PoolWorker *self, ScratchArena *arena);
+
+		/**
+		 * Run a task and mark it as finished in its group.
+		 * @param task Task.
+		 * @param arena Scratch arena for the current thread.
+		 */
+		static void execute(const PoolTask &task, ScratchArena *arena);
+
+	public:
+		// parallelFor() state.
+		struct ForState {
+			size_t begin;
+			size_t end;
+			size_t grain;
+			int chunks;
+			volatile int next;	// Next chunk index.
+			ThreadPool::RangeFn fn;
+			void *param;
+			TaskGroup *group;
+		};
+
+		/**
+		 * Run parallelFor() chunks until none are left.
+		 * @param state parallelFor() state.
+		 * @param arena Scratch arena for the current thread.
+		 */
+		static void runChunks(ForState *state, ScratchArena *arena);
+
+		/**
+		 * TaskGroup wrapper for runChunks().
+		 * @param param ForState.
+		 * @param arena Scratch arena for the current thread.
+		 */
+		static void forTask(void *param, ScratchArena *arena);
+
+	private:
+		/**
+		 * Worker thread main loop.
+		 * @param self Worker.
+		 */
+		void workerLoop(PoolWorker *self);
+
+#ifdef _WIN32
+		static unsigned int __stdcall threadProc(void *param);
+#else /* !_WIN32 */
+		static void *threadProc(void *param);
+#endif /* _WIN32 */
+
+	public:
+		// Thread-local storage for the current worker.
+		static pthread_once_t tls_once_control;
+#ifdef _WIN32
+		static DWORD tls_index;
+#else /* !_WIN32 */
+		static pthread_key_t tls_key;
+#endif /* _WIN32 */
+		static void initTls(void);
+
+		// Global pool.
+		static pthread_once_t instance_once_control;
+		static ThreadPool *instance;
+		static void initInstance(void);
+};
+
+pthread_once_t ThreadPoolPrivate::tls_once_control = PTHREAD_ONCE_INIT;
+#ifdef _WIN32
+DWORD ThreadPoolPrivate::tls_index = TLS_OUT_OF_INDEXES;
+#else /* !_WIN32 */
+pthread_key_t ThreadPoolPrivate::tls_key;
+#endif /* _WIN32 */
+
+pthread_once_t ThreadPoolPrivate::instance_once_control = PTHREAD_ONCE_INIT;
+ThreadPool *ThreadPoolPrivate::instance = nullptr;
+
+/**
+ * Initialize the thread-local storage key.
+ * Called by pthread_once().
+ */
+void ThreadPoolPrivate::initTls(void)
+{
+#ifdef _WIN32
+	tls_index = TlsAlloc();
+#else /* !_WIN32 */
+	pthread_key_create(&tls_key, nullptr);
+#endif /* _WIN32 */
+}
+
+/**
+ * Initialize the global pool.
+ * Called by pthread_once().
+ */
+void ThreadPoolPrivate::initInstance(void)
+{
+	// NOTE: The worker threads aren't started until the
+	// first task is queued. See ThreadPoolCleanup for
+	// how they're stopped.
+	instance = new ThreadPool(-1);
+
+#ifdef _WIN32
+	// Worker threads can't be joined from DllMain() because of
+	// the loader lock, so pin this module instead. Otherwise,
+	// the threads could outlive the DLL if it's unloaded.
+	HMODULE hModule;
+	GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN,
+		reinterpret_cast<LPCTSTR>(&instance), &hModule);
+#endif /* _WIN32 */
+}
+
+#ifndef _WIN32
+/**
+ * Delete the global pool when the process exits,
+ * or when this module is unloaded with dlclose().
+ * This joins the worker threads, so they can't
+ * keep running after this module is unmapped.
+ */
+static class ThreadPoolCleanup
+{
+	public:
+		~ThreadPoolCleanup()
+		{
+			delete ThreadPoolPrivate::instance;
+			ThreadPoolPrivate::instance = nullptr;
+		}
+} threadPoolCleanup;
+#endif /* !_WIN32 */
+
+ThreadPoolPrivate::ThreadPoolPrivate(int threads)
+	: maxThreads(0)
+	, started(0)
+	, queued(0)
+	, shutdown(0)
+	, rr(0)
+	, waitingWorkers(0)
+{
+	pthread_once(&tls_once_control, initTls);
+
+	if (threads < 0) {
+		// Leave one CPU for the calling thread,
+		// since it runs tasks while it waits.
+		threads = ThreadPool::onlineCpuCount() - 1;
+	}
+	if (threads > ThreadPool::MAX_THREADS) {
+		threads = ThreadPool::MAX_THREADS;
+	}
+	if (threads > 0) {
+		maxThreads = threads;
+	}
+}
+
+/**
+ * Start the worker threads if they haven't been started yet.
+ * If thread creation fails, the pool uses whatever threads
+ * were started, and tasks are run inline if none were.
+ */
+void ThreadPoolPrivate::startWorkers(void)
+{
+	if (ATOMIC_OR_FETCH(&started, 0))
+		return;
+
+	MutexLocker mtxLocker(startMutex);
+	if (started)
+		return;
+
+	// Create the worker objects first so the worker threads
+	// see a complete vector when they start stealing.
+	const int threads = maxThreads;
+	workers.reserve(threads);
+	for (int i = 0; i < threads; i++) {
+		PoolWorker *const worker = new PoolWorker;
+		worker->pool = this;
+		worker->index = i;
+		workers.push_back(worker);
+	}
+
+	// Start the threads.
+	// If thread creation fails (e.g. resource limits or a sandbox
+	// that doesn't allow clone()), use whatever threads we have.
+	// NOTE: Workers don't look at the vector until a task is queued,
+	// so it's safe to shrink it before `started` is set.
+	int nStarted = 0;
+	for (; nStarted < threads; nStarted++) {
+		PoolWorker *const worker = workers[nStarted];
+#ifdef _WIN32
+		worker->hThread = reinterpret_cast<HANDLE>(
+			_beginthreadex(nullptr, 0, threadProc, worker, 0, nullptr));
+		if (!worker->hThread)
+			break;
+#else /* !_WIN32 */
+		if (pthread_create(&worker->thread, nullptr, threadProc, worker) != 0)
+			break;
+#endif /* _WIN32 */
+	}
+	for (int i = nStarted; i < threads; i++) {
+		delete workers[i];
+	}
+	workers.resize(nStarted);
+
+	// NOTE: Other threads may check `started` without locking
+	// startMutex, so it must be set after `workers` is final.
+	ATOMIC_EXCHANGE(&started, 1);
+}
+
+ThreadPoolPrivate::~ThreadPoolPrivate()
+{
+	// Tell the workers to exit.
+	wakeLock.lock();
+	shutdown = 1;
+	wakeLock.notifyAll();
+	wakeLock.unlock();
+
+	// NOTE: Join all of the threads before deleting anything,
+	// since a worker that hasn't exited yet might be stealing
+	// from another worker's queue.
+	for (auto iter = workers.begin(); iter != workers.end(); ++iter) {
+		PoolWorker *const worker = *iter;
+#ifdef _WIN32
+		WaitForSingleObject(worker->hThread, INFINITE);
+		CloseHandle(worker->hThread);
+#else /* !_WIN32 */
+		pthread_join(worker->thread, nullptr);
+#endif /* _WIN32 */
+	}
+
+	for (auto iter = workers.begin(); iter != workers.end(); ++iter) {
+		// All task groups must be waited on before deleting the pool.
+		assert((*iter)->queue.empty());
+		delete *iter;
+	}
+}
+
+#ifdef _WIN32
+unsigned int __stdcall ThreadPoolPrivate::threadProc(void *param)
+{
+	PoolWorker *const worker = static_cast<PoolWorker*>(param);
+	TlsSetValue(tls_index, worker);
+	worker->pool->workerLoop(worker);
+	return 0;
+}
+#else /* !_WIN32 */
+void *ThreadPoolPrivate::threadProc(void *param)
+{
+	PoolWorker *const worker = static_cast<PoolWorker*>(param);
+	pthread_setspecific(tls_key, worker);
+	worker->pool->workerLoop(worker);
+	return nullptr;
+}
+#endif /* _WIN32 */
+
+/**
+ * Worker thread main loop.
+ * @param self Worker.
+ */
+void ThreadPoolPrivate::workerLoop(PoolWorker *self)
+{
+	for (;;) {
+		wakeLock.lock();
+		while (!shutdown && ATOMIC_OR_FETCH(&queued, 0) <= 0) {
+			wakeLock.wait();
+		}
+		const bool quit = !!shutdown;
+		wakeLock.unlock();
+		if (quit)
+			break;
+
+		// Run tasks until the queues are empty.
+		while (runOne(self, &self->arena)) { }
+	}
+}
+
+/**
+ * Get the worker for the current thread.
+ * @return Worker, or nullptr if the current thread isn't a worker in this pool.
+ */
+PoolWorker *ThreadPoolPrivate::currentWorker(void) const
+{
+#ifdef _WIN32
+	PoolWorker *const worker = static_cast<PoolWorker*>(TlsGetValue(tls_index));
+#else /* !_WIN32 */
+	PoolWorker *const worker = static_cast<PoolWorker*>(pthread_getspecific(tls_key));
+#endif /* _WIN32 */
+	return (worker && worker->pool == this) ? worker : nullptr;
+}
+
+/**
+ * Queue a task.
+ * @param task Task.
+ */
+void ThreadPoolPrivate::push(const PoolTask &task)
+{
+	assert(!workers.empty());
+
+	// Tasks queued by a worker go to its own queue.
+	// Other threads distribute tasks round-robin.
+	PoolWorker *worker = currentWorker();
+	if (!worker) {
+		const unsigned int idx = static_cast<unsigned int>(ATOMIC_INC_FETCH(&rr));
+		worker = workers[idx % workers.size()];
+	}
+
+	worker->mtxQueue.lock();
+	worker->queue.push_back(task);
+	worker->mtxQueue.unlock();
+
+	ATOMIC_INC_FETCH(&queued);
+	wakeLock.lock();
+	wakeLock.notifyOne();
+	wakeLock.unlock();
+}
+
+/**
+ * Run one queued task, if one is available.
+ * @param self Worker for the current thread, or nullptr if not a worker.
+ * @param arena Scratch arena for the current thread.
+ * @return True if a task was run; false if not.
+ */
+bool ThreadPoolPrivate::runOne(PoolWorker *self, ScratchArena *arena)
+{
+	if (ATOMIC_OR_FETCH(&queued, 0) <= 0)
+		return false;
+
+	PoolTask task;
+	bool found = false;
+
+	if (self) {
+		// Check our own queue first. (LIFO)
+		MutexLocker mtxLocker(self->mtxQueue);
+		if (!self->queue.empty()) {
+			task = self->queue.back();
+			self->queue.pop_back();
+			found = true;
+		}
+	}
+
+	if (!found) {
+		// Steal from the other workers. (FIFO)
+		const unsigned int count = static_cast<unsigned int>(workers.size());
+		const unsigned int start = (self
+			? static_cast<unsigned int>(self->index + 1)
+			: static_cast<unsigned int>(ATOMIC_OR_FETCH(&rr, 0)));
+		for (unsigned int i = 0; i < count; i++) {
+			PoolWorker *const victim = workers[(start + i) % count];
+			if (victim == self)
+				continue;
+
+			MutexLocker mtxLocker(victim->mtxQueue);
+			if (!victim->queue.empty()) {
+				task = victim->queue.front();
+				victim->queue.pop_front();
+				found = true;
+				break;
+			}
+		}
+	}
+
+	if (!found)
+		return false;
+
+	ATOMIC_DEC_FETCH(&queued);
+	execute(task, arena);
+	return true;
+}
+
+/** TaskGroupPrivate **/
+
+class TaskGroupPrivate
+{
+	public:
+		explicit TaskGroupPrivate(ThreadPool *pool);
+
+	private:
+#if __cplusplus >= 201103L
+		TaskGroupPrivate(const TaskGroupPrivate &) = delete;
+		TaskGroupPrivate &operator=(const TaskGroupPrivate &) = delete;
+#else /* __cplusplus < 201103L */
+		TaskGroupPrivate(const TaskGroupPrivate &);
+		TaskGroupPrivate &operator=(const TaskGroupPrivate &);
+#endif /* __cplusplus */
+
+	public:
+		ThreadPoolPrivate *pool;
+
+		PoolCondLock lock;		// Protects pending.
+		int pending;		// Number of queued or running tasks.
+		volatile int cancelled;
+
+		/**
+		 * Is the group still running tasks?
+		 * @return True if tasks are queued or running; false if not.
+		 */
+		bool isPending(void);
+
+		/**
+		 * Mark a task as finished.
+		 */
+		void finishOne(void);
+};
+
+TaskGroupPrivate::TaskGroupPrivate(ThreadPool *pool)
+	: pool(pool ? pool->d_ptr : ThreadPool::instance()->d_ptr)
+	, pending(0)
+	, cancelled(0)
+{ }
+
+/**
+ * Is the group still running tasks?
+ * @return True if tasks are queued or running; false if not.
+ */
+bool TaskGroupPrivate::isPending(void)
+{
+	lock.lock();
+	const bool ret = (pending > 0);
+	lock.unlock();
+	return ret;
+}
+
+/**
+ * Mark a task as finished.
+ */
+void TaskGroupPrivate::finishOne(void)
+{
+	// NOTE: The lock must be held while notifying, since the
+	// waiter may delete the TaskGroup as soon as it sees 0.
+	ThreadPoolPrivate *const pool = this->pool;
+	lock.lock();
+	assert(pending > 0);
+	const bool done = (--pending == 0);
+	if (done) {
+		lock.notifyAll();
+	}
+	lock.unlock();
+
+	// Worker threads waiting on a group sleep on the pool's
+	// wakeLock, since they also need to wake up for new tasks.
+	// NOTE: `this` may have been deleted at this point.
+	if (done && ATOMIC_OR_FETCH(&pool->waitingWorkers, 0) > 0) {
+		pool->wakeLock.lock();
+		pool->wakeLock.notifyAll();
+		pool->wakeLock.unlock();
+	}
+}
+
+/**
+ * Wait for a task to be queued or for a TaskGroup to finish.
+ * Called by worker threads waiting on a TaskGroup.
+ * @param group TaskGroup.
+ */
+void ThreadPoolPrivate::waitForWork(TaskGroupPrivate *group)
+{
+	// NOTE: waitingWorkers must be incremented before checking
+	// the group, so finishOne() won't skip the notification.
+	ATOMIC_INC_FETCH(&waitingWorkers);
+	wakeLock.lock();
+	while (ATOMIC_OR_FETCH(&queued, 0) <= 0 && group->isPending()) {
+		wakeLock.wait();
+	}
+	wakeLock.unlock();
+	ATOMIC_DEC_FETCH(&waitingWorkers);
+}
+
+/**
+ * Run a task and mark it as finished in its group.
+ * @param task Task.
+ * @param arena Scratch arena for the current thread.
+ */
+void ThreadPoolPrivate::execute(const PoolTask &task, ScratchArena *arena)
+{
+	TaskGroupPrivate *const group = task.group;
+	if (!ATOMIC_OR_FETCH(&group->cancelled, 0)) {
+		// Save the arena state in case this task is
+		// running inside of another task's wait().
+		const ScratchArena::Mark mark = arena->mark();
+		task.fn(task.param, arena);
+		arena->rewind(mark);
+	}
+	group->finishOne();
+}
+
+/**
+ * Run parallelFor() chunks until none are left.
+ * @param state parallelFor() state.
+ * @param arena Scratch arena for the current thread.
+ */
+void ThreadPoolPrivate::runChunks(ForState *state, ScratchArena *arena)
+{
+	for (;;) {
+		if (state->group && state->group->isCancelled())
+			break;
+
+		const int chunk = ATOMIC_INC_FETCH(&state->next) - 1;
+		if (chunk >= state->chunks)
+			break;
+
+		const size_t chunk_begin = state->begin + static_cast<size_t>(chunk) * state->grain;
+		size_t chunk_end = chunk_begin + state->grain;
+		if (chunk_end > state->end || chunk_end < chunk_begin) {
+			chunk_end = state->end;
+		}
+
+		const ScratchArena::Mark mark = arena->mark();
+		state->fn(chunk_begin, chunk_end, state->param, arena);
+		arena->rewind(mark);
+	}
+}
+
+/**
+ * TaskGroup wrapper for runChunks().
+ * @param param ForState.
+ * @param arena Scratch arena for the current thread.
+ */
+void ThreadPoolPrivate::forTask(void *param, ScratchArena *arena)
+{
+	runChunks(static_cast<ForState*>(param), arena);
+}
+
+/** TaskGroup **/
+
+/**
+ * Create a task group.
+ * @param pool Thread pool. (If nullptr, the global pool is used.)
+ */
+TaskGroup::TaskGroup(ThreadPool *pool)
+	: d_ptr(new TaskGroupPrivate(pool))
+{ }
+
+/**
+ * Delete the task group.
+ * This will wait for all pending tasks to finish.
+ */
+TaskGroup::~TaskGroup()
+{
+	wait();
+	delete d_ptr;
+}
+
+/**
+ * Queue a task.
+ * If the pool has no worker threads, the task is run immediately.
+ * If the group has been cancelled, the task is discarded.
+ * @param fn PoolTask function.
+ * @param param PoolTask parameter.
+ */
+void TaskGroup::run(TaskFn fn, void *param)
+{
+	TaskGroupPrivate *const d = d_ptr;
+	assert(fn != nullptr);
+	if (!fn || isCancelled())
+		return;
+
+	d->lock.lock();
+	d->pending++;
+	d->lock.unlock();
+
+	PoolTask task;
+	task.fn = fn;
+	task.param = param;
+	task.group = d;
+
+	ThreadPoolPrivate *const pool = d->pool;
+	pool->startWorkers();
+	if (pool->workers.empty()) {
+		// No worker threads. Run the task inline.
+		ScratchArena arena;
+		ThreadPoolPrivate::execute(task, &arena);
+		return;
+	}
+	pool->push(task);
+}
+
+/**
+ * Wait for all queued tasks to finish.
+ * The calling thread runs queued tasks while it waits.
+ * @return 0 on success; -ECANCELED if the group was cancelled.
+ */
+int TaskGroup::wait(void)
+{
+	TaskGroupPrivate *const d = d_ptr;
+	ThreadPoolPrivate *const pool = d->pool;
+	PoolWorker *const self = pool->currentWorker();
+	ScratchArena localArena;
+	ScratchArena *const arena = (self ? &self->arena : &localArena);
+
+	for (;;) {
+		d->lock.lock();
+		const int pending = d->pending;
+		d->lock.unlock();
+		if (pending == 0)
+			break;
+
+		// Help out while waiting.
+		if (pool->runOne(self, arena))
+			continue;
+
+		if (self) {
+			// Worker threads must wake up if another task is
+			// queued, since the remaining tasks may be waiting
+			// on it, so they sleep on the pool's wakeLock.
+			pool->waitForWork(d);
+			continue;
+		}
+
+		// Nothing left to steal. Sleep until the group finishes.
+		d->lock.lock();
+		if (d->pending > 0) {
+			d->lock.wait();
+		}
+		d->lock.unlock();
+	}
+
+	return (isCancelled() ? -ECANCELED : 0);
+}
+
+/**
+ * Cancel the group.
+ * Tasks that haven't started yet will be skipped.
+ * Running tasks should poll isCancelled() and return early.
+ */
+void TaskGroup::cancel(void)
+{
+	ATOMIC_EXCHANGE(&d_ptr->cancelled, 1);
+}
+
+/**
+ * Has the group been cancelled?
+ * @return True if cancelled; false if not.
+ */
+bool TaskGroup::isCancelled(void) const
+{
+	return !!ATOMIC_OR_FETCH(&d_ptr->cancelled, 0);
+}
+
+/** ThreadPool **/
+
+/**
+ * Create a thread pool.
+ * @param threads Number of worker threads. (-1 for onlineCpuCount() - 1)
+ */
+ThreadPool::ThreadPool(int threads)
+	: d_ptr(new ThreadPoolPrivate(threads))
+{ }
+
+ThreadPool::~ThreadPool()
+{
+	delete d_ptr;
+}
+
+/**
+ * Get the global thread pool.
+ * The pool is created on first use.
+ *
+ * On Windows, the global pool is never deleted, and this
+ * module is pinned in memory. On other systems, the pool is
+ * deleted on exit, or when this module is unloaded.
+ *
+ * @return Global thread pool.
+ */
+ThreadPool *ThreadPool::instance(void)
+{
+	pthread_once(&ThreadPoolPrivate::instance_once_control, ThreadPoolPrivate::initInstance);
+	return ThreadPoolPrivate::instance;
+}
+
+/**
+ * Get the number of online CPUs.
+ * @return Number of online CPUs. (always at least 1)
+ */
+int ThreadPool::onlineCpuCount(void)
+{
+	long count = -1;
+#if defined(_WIN32)
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	count = static_cast<long>(si.dwNumberOfProcessors);
+#else /* !_WIN32 */
+# if defined(__linux__) && defined(CPU_COUNT)
+	// Respect the CPU affinity mask. (taskset, cpusets)
+	cpu_set_t cpuset;
+	if (sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0) {
+		count = CPU_COUNT(&cpuset);
+	}
+# endif /* __linux__ && CPU_COUNT */
+# ifdef _SC_NPROCESSORS_ONLN
+	const long online = sysconf(_SC_NPROCESSORS_ONLN);
+	if (online > 0 && (count <= 0 || online < count)) {
+		count = online;
+	}
+# endif /* _SC_NPROCESSORS_ONLN */
+#endif /* _WIN32 */
+
+	if (count <= 0) {
+		count = 1;
+	} else if (count > INT_MAX) {
+		count = INT_MAX;
+	}
+	return static_cast<int>(count);
+}
+
+/**
+ * Get the number of worker threads.
+ * This starts the worker threads if they haven't been
+ * started yet. It may be lower than the requested number
+ * if thread creation failed.
+ * @return Number of worker threads.
+ */
+int ThreadPool::threadCount(void) const
+{
+	d_ptr->startWorkers();
+	return static_cast<int>(d_ptr->workers.size());
+}
+
+/**
+ * Run a function over an index range in parallel.
+ *
+ * The range is split into chunks of `grain` indexes, which are
+ * handed out dynamically to the workers and the calling thread.
+ * The scratch arena is reset after each chunk.
+ *
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param grain Chunk size. (0 to pick one automatically)
+ * @param fn Range function.
+ * @param param Parameter for fn.
+ * @param group PoolTask group for cancellation. (optional)
+ * @return 0 on success; -ECANCELED if the group was cancelled.
+ */
+int ThreadPool::parallelFor(size_t begin, size_t end, size_t grain,
+	RangeFn fn, void *param, TaskGroup *group)
+{
+	ThreadPoolPrivate *const d = d_ptr;
+	assert(fn != nullptr);
+	if (!fn)
+		return -EINVAL;
+	if (end <= begin)
+		return (group && group->isCancelled() ? -ECANCELED : 0);
+
+	d->startWorkers();
+	const size_t count = end - begin;
+	const size_t threads = d->workers.size() + 1;
+	if (grain == 0) {
+		// Aim for a few chunks per thread so
+		// uneven chunks can be balanced out.
+		grain = count / (threads * 4);
+		if (grain == 0) {
+			grain = 1;
+		}
+	}
+
+	// Chunk indexes are handed out with int atomics.
+	// Leave some headroom for the final increments.
+	static const size_t CHUNKS_MAX = INT_MAX / 2;
+	size_t chunks = (count / grain) + ((count % grain) != 0);
+	if (chunks > CHUNKS_MAX) {
+		grain = (count / CHUNKS_MAX) + 1;
+		chunks = (count / grain) + ((count % grain) != 0);
+	}
+
+	ThreadPoolPrivate::ForState state;
+	state.begin = begin;
+	state.end = end;
+	state.grain = grain;
+	state.chunks = static_cast<int>(chunks);
+	state.next = 0;
+	state.fn = fn;
+	state.param = param;
+	state.group = group;
+
+	PoolWorker *const self = d->currentWorker();
+	ScratchArena localArena;
+	ScratchArena *const arena = (self ? &self->arena : &localArena);
+
+	if (chunks > 1 && !d->workers.empty()) {
+		// Start helpers on the worker threads.
+		// The calling thread processes chunks too.
+		size_t helpers = chunks - 1;
+		if (helpers > d->workers.size()) {
+			helpers = d->workers.size();
+		}
+
+		TaskGroup helperGroup(this);
+		for (size_t i = 0; i < helpers; i++) {
+			helperGroup.run(ThreadPoolPrivate::forTask, &state);
+		}
+		ThreadPoolPrivate::runChunks(&state, arena);
+		helperGroup.wait();
+	} else {
+		// Single chunk, or no worker threads.
+		ThreadPoolPrivate::runChunks(&state, arena);
+	}
+
+	return (group && group->isCancelled() ? -ECANCELED : 0);
+}
+
+}
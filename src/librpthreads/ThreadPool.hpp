@@ -0,0 +1,293 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * ThreadPool.hpp: Work-stealing thread pool.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTHREADS_THREADPOOL_HPP__
+#define __ROMPROPERTIES_LIBRPTHREADS_THREADPOOL_HPP__
+
+// C includes. (C++ namespace)
+#include <cstddef>
+#include <cstdint>
+
+namespace LibRpBase {
+
+/**
+ * Per-thread scratch arena.
+ *
+ * Each worker thread owns one arena. Memory allocated from the
+ * arena is valid until the current task or parallel-for chunk
+ * returns, at which point the arena is reset. The arena keeps
+ * its largest block around, so steady-state tasks don't hit
+ * the system allocator at all.
+ */
+class ScratchArena
+{
+	public:
+		ScratchArena();
+		~ScratchArena();
+
+	private:
+#if __cplusplus >= 201103L
+		ScratchArena(const ScratchArena &) = delete;
+		ScratchArena &operator=(const ScratchArena &) = delete;
+#else /* __cplusplus < 201103L */
+		ScratchArena(const ScratchArena &);
+		ScratchArena &operator=(const ScratchArena &);
+#endif /* __cplusplus */
+
+	public:
+		/**
+		 * Allocate memory from the arena.
+		 * @param size Size, in bytes.
+		 * @param align Alignment. (must be a power of two; maximum 64)
+		 * @return Pointer to the memory, or nullptr on error.
+		 */
+		void *alloc(size_t size, size_t align = 16);
+
+		/**
+		 * Release all allocations.
+		 * If more than one block was allocated, the blocks are
+		 * coalesced into a single block for the next round.
+		 */
+		void reset(void);
+
+		/**
+		 * Get the total capacity of the arena.
+		 * @return Capacity, in bytes.
+		 */
+		size_t capacity(void) const;
+
+	private:
+		friend class ThreadPoolPrivate;
+		struct Block;
+
+		// Allocation state, saved before running a task so
+		// nested tasks on the same thread can't clobber it.
+		struct Mark {
+			Block *block;
+			size_t used;
+		};
+
+		/**
+		 * Get the current allocation state.
+		 * @return Allocation state.
+		 */
+		Mark mark(void) const;
+
+		/**
+		 * Rewind to a previous allocation state.
+		 * Blocks allocated after the mark are freed.
+		 * @param mark Allocation state from mark().
+		 */
+		void rewind(const Mark &mark);
+
+	private:
+		Block *m_head;		// Current block. (linked to older blocks)
+		size_t m_used;		// Bytes used in the current block.
+		size_t m_capacity;	// Total capacity of all blocks.
+};
+
+class ThreadPool;
+class TaskGroupPrivate;
+
+/**
+ * Group of tasks that can be waited on and cancelled as a unit.
+ */
+class TaskGroup
+{
+	public:
+		/**
+		 * Task function.
+		 * @param param Task parameter.
+		 * @param arena Scratch arena for the thread running the task.
+		 */
+		typedef void (*TaskFn)(void *param, ScratchArena *arena);
+
+		/**
+		 * Create a task group.
+		 * @param pool Thread pool. (If nullptr, the global pool is used.)
+		 */
+		explicit TaskGroup(ThreadPool *pool = nullptr);
+
+		/**
+		 * Delete the task group.
+		 * This will wait for all pending tasks to finish.
+		 */
+		~TaskGroup();
+
+	private:
+		friend class TaskGroupPrivate;
+		friend class ThreadPool;
+		TaskGroupPrivate *const d_ptr;
+#if __cplusplus >= 201103L
+		TaskGroup(const TaskGroup &) = delete;
+		TaskGroup &operator=(const TaskGroup &) = delete;
+#else /* __cplusplus < 201103L */
+		TaskGroup(const TaskGroup &);
+		TaskGroup &operator=(const TaskGroup &);
+#endif /* __cplusplus */
+
+	public:
+		/**
+		 * Queue a task.
+		 * If the pool has no worker threads, the task is run immediately.
+		 * If the group has been cancelled, the task is discarded.
+		 * @param fn Task function.
+		 * @param param Task parameter.
+		 */
+		void run(TaskFn fn, void *param);
+
+		/**
+		 * Wait for all queued tasks to finish.
+		 * The calling thread runs queued tasks while it waits.
+		 * @return 0 on success; -ECANCELED if the group was cancelled.
+		 */
+		int wait(void);
+
+		/**
+		 * Cancel the group.
+		 * Tasks that haven't started yet will be skipped.
+		 * Running tasks should poll isCancelled() and return early.
+		 */
+		void cancel(void);
+
+		/**
+		 * Has the group been cancelled?
+		 * @return True if cancelled; false if not.
+		 */
+		bool isCancelled(void) const;
+};
+
+class ThreadPoolPrivate;
+
+/**
+ * Work-stealing thread pool.
+ *
+ * Each worker has its own task queue. Tasks queued from a worker
+ * go to the back of that worker's queue and are picked up LIFO;
+ * idle workers steal from the front of other workers' queues.
+ * Threads waiting on a TaskGroup run queued tasks while they wait,
+ * so nested parallelism can't deadlock the pool.
+ *
+ * Worker threads aren't started until the first task is queued,
+ * so an unused pool doesn't cost any threads. If no worker threads
+ * could be created (e.g. single-CPU system, or thread creation
+ * blocked by a sandbox), all work is run on the calling thread.
+ */
+class ThreadPool
+{
+	public:
+		/**
+		 * Create a thread pool.
+		 * @param threads Number of worker threads. (-1 for onlineCpuCount() - 1)
+		 */
+		explicit ThreadPool(int threads = -1);
+		~ThreadPool();
+
+	private:
+		friend class ThreadPoolPrivate;
+		friend class TaskGroup;
+		friend class TaskGroupPrivate;
+		ThreadPoolPrivate *const d_ptr;
+#if __cplusplus >= 201103L
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool &operator=(const ThreadPool &) = delete;
+#else /* __cplusplus < 201103L */
+		ThreadPool(const ThreadPool &);
+		ThreadPool &operator=(const ThreadPool &);
+#endif /* __cplusplus */
+
+	public:
+		/**
+		 * Maximum number of worker threads.
+		 */
+		static const int MAX_THREADS = 64;
+
+		/**
+		 * Get the global thread pool.
+		 * The pool is created on first use.
+		 *
+		 * On Windows, the global pool is never deleted, and this
+		 * module is pinned in memory. On other systems, the pool is
+		 * deleted on exit, or when this module is unloaded.
+		 *
+		 * @return Global thread pool.
+		 */
+		static ThreadPool *instance(void);
+
+		/**
+		 * Get the number of online CPUs.
+		 * @return Number of online CPUs. (always at least 1)
+		 */
+		static int onlineCpuCount(void);
+
+		/**
+		 * Get the number of worker threads.
+		 * This starts the worker threads if they haven't been
+		 * started yet. It may be lower than the requested number
+		 * if thread creation failed.
+		 * @return Number of worker threads.
+		 */
+		int threadCount(void) const;
+
+	public:
+		/**
+		 * Range function for parallelFor().
+		 * @param begin First index.
+		 * @param end One past the last index.
+		 * @param param Parameter.
+		 * @param arena Scratch arena for the thread running the range.
+		 */
+		typedef void (*RangeFn)(size_t begin, size_t end, void *param, ScratchArena *arena);
+
+		/**
+		 * Run a function over an index range in parallel.
+		 *
+		 * The range is split into chunks of `grain` indexes, which are
+		 * handed out dynamically to the workers and the calling thread.
+		 * The scratch arena is reset after each chunk.
+		 *
+		 * @param begin First index.
+		 * @param end One past the last index.
+		 * @param grain Chunk size. (0 to pick one automatically)
+		 * @param fn Range function.
+		 * @param param Parameter for fn.
+		 * @param group Task group for cancellation. (optional)
+		 * @return 0 on success; -ECANCELED if the group was cancelled.
+		 */
+		int parallelFor(size_t begin, size_t end, size_t grain,
+			RangeFn fn, void *param, TaskGroup *group = nullptr);
+
+		/**
+		 * Run a functor over an index range in parallel.
+		 * The functor is called as fn(begin, end, arena).
+		 *
+		 * @param begin First index.
+		 * @param end One past the last index.
+		 * @param grain Chunk size. (0 to pick one automatically)
+		 * @param fn Functor.
+		 * @param group Task group for cancellation. (optional)
+		 * @return 0 on success; -ECANCELED if the group was cancelled.
+		 */
+		template<typename Fn>
+		inline int parallelFor(size_t begin, size_t end, size_t grain,
+			Fn &fn, TaskGroup *group = nullptr)
+		{
+			return parallelFor(begin, end, grain, &callFunctor<Fn>, &fn, group);
+		}
+
+	private:
+		template<typename Fn>
+		static void callFunctor(size_t begin, size_t end, void *param, ScratchArena *arena)
+		{
+			(*static_cast<Fn*>(param))(begin, end, arena);
+		}
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPTHREADS_THREADPOOL_HPP__ */
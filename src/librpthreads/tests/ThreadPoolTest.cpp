@@ -0,0 +1,467 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads/tests)               *
+ * ThreadPoolTest.cpp: ThreadPool tests.                                   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+#include "librpthreads/Atomics.h"
+
+#ifdef __linux__
+// C includes.
+# include <dirent.h>
+#endif /* __linux__ */
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <memory>
+#include <vector>
+using std::unique_ptr;
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+class ThreadPoolTest : public ::testing::TestWithParam<int>
+{
+	protected:
+		void SetUp(void) final;
+
+	public:
+		// Test array size.
+		static const size_t TEST_ARRAY_SIZE = 100000;
+
+		// Number of iterations for benchmarks.
+		static const unsigned int BENCHMARK_ITERATIONS = 200;
+
+		// Benchmark array size.
+		static const size_t BENCHMARK_ARRAY_SIZE = 1024*1024;
+
+	public:
+		// Thread pool. Number of threads is the test parameter.
+		unique_ptr<ThreadPool> pool;
+};
+
+/**
+ * SetUp() function.
+ * Run before each test.
+ */
+void ThreadPoolTest::SetUp(void)
+{
+	pool.reset(new ThreadPool(GetParam()));
+	ASSERT_TRUE(pool.get() != nullptr);
+	// Thread creation may fail in restricted environments,
+	// but the pool must never have more threads than requested.
+	EXPECT_GE(pool->threadCount(), 0);
+	if (GetParam() >= 0) {
+		EXPECT_LE(pool->threadCount(), GetParam());
+	}
+	EXPECT_LE(pool->threadCount(), static_cast<int>(ThreadPool::MAX_THREADS));
+}
+
+/**
+ * Count how many times each index is visited.
+ */
+struct VisitCounter {
+	vector<int> counts;
+
+	explicit VisitCounter(size_t size)
+		: counts(size)
+	{ }
+
+	void operator()(size_t begin, size_t end, ScratchArena *arena)
+	{
+		ASSERT_TRUE(arena != nullptr);
+		for (size_t i = begin; i < end; i++) {
+			ATOMIC_INC_FETCH(&counts[i]);
+		}
+	}
+};
+
+/**
+ * Make sure onlineCpuCount() returns a sane value.
+ */
+TEST_P(ThreadPoolTest, onlineCpuCount)
+{
+	EXPECT_GE(ThreadPool::onlineCpuCount(), 1);
+}
+
+/**
+ * parallelFor() must visit every index exactly once.
+ */
+TEST_P(ThreadPoolTest, parallelFor)
+{
+	static const size_t grains[] = {0, 1, 7, 1000, TEST_ARRAY_SIZE, TEST_ARRAY_SIZE * 2};
+	for (size_t g = 0; g < sizeof(grains)/sizeof(grains[0]); g++) {
+		VisitCounter counter(TEST_ARRAY_SIZE);
+		EXPECT_EQ(0, pool->parallelFor(0, TEST_ARRAY_SIZE, grains[g], counter));
+		for (size_t i = 0; i < TEST_ARRAY_SIZE; i++) {
+			ASSERT_EQ(1, counter.counts[i]) << "Index " << i << ", grain " << grains[g];
+		}
+	}
+}
+
+/**
+ * parallelFor() with an offset and empty ranges.
+ */
+TEST_P(ThreadPoolTest, parallelFor_range)
+{
+	VisitCounter counter(1000);
+	EXPECT_EQ(0, pool->parallelFor(100, 900, 3, counter));
+	for (size_t i = 0; i < 1000; i++) {
+		ASSERT_EQ((i >= 100 && i < 900) ? 1 : 0, counter.counts[i]) << "Index " << i;
+	}
+
+	// Empty ranges must not call the functor.
+	EXPECT_EQ(0, pool->parallelFor(500, 500, 0, counter));
+	EXPECT_EQ(0, pool->parallelFor(600, 500, 0, counter));
+	EXPECT_EQ(1, counter.counts[500]);
+}
+
+/**
+ * Nested parallelFor() calls must not deadlock.
+ */
+struct NestedFor {
+	ThreadPool *pool;
+	size_t size;
+	vector<int> counts;
+
+	NestedFor(ThreadPool *pool, size_t size)
+		: pool(pool), size(size), counts(size * size)
+	{ }
+
+	struct Inner {
+		NestedFor *outer;
+		size_t row;
+
+		void operator()(size_t begin, size_t end, ScratchArena *)
+		{
+			for (size_t i = begin; i < end; i++) {
+				ATOMIC_INC_FETCH(&outer->counts[row * outer->size + i]);
+			}
+		}
+	};
+
+	void operator()(size_t begin, size_t end, ScratchArena *)
+	{
+		for (size_t row = begin; row < end; row++) {
+			Inner inner = {this, row};
+			EXPECT_EQ(0, pool->parallelFor(0, size, 4, inner));
+		}
+	}
+};
+
+TEST_P(ThreadPoolTest, parallelFor_nested)
+{
+	NestedFor nested(pool.get(), 64);
+	EXPECT_EQ(0, pool->parallelFor(0, 64, 1, nested));
+	for (size_t i = 0; i < nested.counts.size(); i++) {
+		ASSERT_EQ(1, nested.counts[i]) << "Index " << i;
+	}
+}
+
+/**
+ * Cancelling a group stops parallelFor() early.
+ */
+struct CancelFor {
+	TaskGroup *group;
+	volatile int visited;
+
+	void operator()(size_t begin, size_t end, ScratchArena *)
+	{
+		for (size_t i = begin; i < end; i++) {
+			if (ATOMIC_INC_FETCH(&visited) == 100) {
+				group->cancel();
+			}
+		}
+	}
+};
+
+TEST_P(ThreadPoolTest, parallelFor_cancel)
+{
+	TaskGroup group(pool.get());
+	CancelFor cancelFor = {&group, 0};
+	EXPECT_EQ(-ECANCELED, pool->parallelFor(0, TEST_ARRAY_SIZE, 10, cancelFor, &group));
+	EXPECT_TRUE(group.isCancelled());
+	// Chunks that already started will finish, but
+	// nowhere near the whole range should be visited.
+	EXPECT_LT(cancelFor.visited, static_cast<int>(TEST_ARRAY_SIZE / 2));
+
+	// Already-cancelled group: nothing is visited.
+	cancelFor.visited = 0;
+	EXPECT_EQ(-ECANCELED, pool->parallelFor(0, TEST_ARRAY_SIZE, 10, cancelFor, &group));
+	EXPECT_EQ(0, cancelFor.visited);
+}
+
+/**
+ * Run tasks in a TaskGroup.
+ */
+static void addTask(void *param, ScratchArena *arena)
+{
+	EXPECT_TRUE(arena != nullptr);
+	ATOMIC_INC_FETCH(static_cast<volatile int*>(param));
+}
+
+TEST_P(ThreadPoolTest, taskGroup)
+{
+	volatile int count = 0;
+	TaskGroup group(pool.get());
+	for (int i = 0; i < 1000; i++) {
+		group.run(addTask, (void*)&count);
+	}
+	EXPECT_EQ(0, group.wait());
+	EXPECT_EQ(1000, count);
+
+	// The group can be reused after wait().
+	for (int i = 0; i < 1000; i++) {
+		group.run(addTask, (void*)&count);
+	}
+	EXPECT_EQ(0, group.wait());
+	EXPECT_EQ(2000, count);
+	EXPECT_FALSE(group.isCancelled());
+}
+
+/**
+ * Tasks queued after cancel() must not run.
+ */
+TEST_P(ThreadPoolTest, taskGroup_cancel)
+{
+	volatile int count = 0;
+	TaskGroup group(pool.get());
+	group.cancel();
+	for (int i = 0; i < 1000; i++) {
+		group.run(addTask, (void*)&count);
+	}
+	EXPECT_EQ(-ECANCELED, group.wait());
+	EXPECT_EQ(0, count);
+}
+
+/**
+ * Scratch arena allocations in tasks.
+ */
+struct ArenaFor {
+	volatile int failed;
+
+	void operator()(size_t begin, size_t end, ScratchArena *arena)
+	{
+		for (size_t i = begin; i < end; i++) {
+			// Sizes vary so some chunks need more than one block.
+			const size_t size = 1024 + (i % 64) * 4096;
+			uint8_t *const buf = static_cast<uint8_t*>(arena->alloc(size, 64));
+			if (!buf || (reinterpret_cast<uintptr_t>(buf) & 63) != 0) {
+				ATOMIC_INC_FETCH(&failed);
+				continue;
+			}
+			memset(buf, static_cast<int>(i & 0xFF), size);
+			if (buf[0] != (i & 0xFF) || buf[size-1] != (i & 0xFF)) {
+				ATOMIC_INC_FETCH(&failed);
+			}
+		}
+	}
+};
+
+TEST_P(ThreadPoolTest, scratchArena_parallelFor)
+{
+	ArenaFor arenaFor = {0};
+	EXPECT_EQ(0, pool->parallelFor(0, 10000, 16, arenaFor));
+	EXPECT_EQ(0, arenaFor.failed);
+}
+
+/**
+ * Sum an array using parallelFor().
+ */
+struct SumFor {
+	const uint32_t *data;
+	uint64_t *sums;	// One per chunk.
+	size_t grain;
+
+	void operator()(size_t begin, size_t end, ScratchArena *)
+	{
+		uint64_t sum = 0;
+		for (size_t i = begin; i < end; i++) {
+			sum += data[i];
+		}
+		sums[begin / grain] = sum;
+	}
+};
+
+/**
+ * Benchmark parallelFor() against a serial loop.
+ */
+TEST_P(ThreadPoolTest, parallelFor_benchmark)
+{
+	vector<uint32_t> data(BENCHMARK_ARRAY_SIZE);
+	uint64_t expected = 0;
+	for (size_t i = 0; i < data.size(); i++) {
+		data[i] = static_cast<uint32_t>(i * 2654435761U);
+		expected += data[i];
+	}
+
+	static const size_t grain = 16384;
+	vector<uint64_t> sums(data.size() / grain + 1);
+	SumFor sumFor;
+	sumFor.data = data.data();
+	sumFor.sums = sums.data();
+	sumFor.grain = grain;
+
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		EXPECT_EQ(0, pool->parallelFor(0, data.size(), grain, sumFor));
+	}
+
+	uint64_t total = 0;
+	for (size_t i = 0; i < sums.size(); i++) {
+		total += sums[i];
+	}
+	EXPECT_EQ(expected, total);
+}
+
+/**
+ * Benchmark TaskGroup::run() overhead.
+ */
+TEST_P(ThreadPoolTest, taskGroup_benchmark)
+{
+	volatile int count = 0;
+	TaskGroup group(pool.get());
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		for (int j = 0; j < 1000; j++) {
+			group.run(addTask, (void*)&count);
+		}
+		EXPECT_EQ(0, group.wait());
+	}
+	EXPECT_EQ(static_cast<int>(BENCHMARK_ITERATIONS * 1000), count);
+}
+
+// Thread counts to test.
+// - 0: No worker threads; everything runs inline.
+// - 1: Single worker, plus the calling thread.
+// - 4: Multiple workers, even on single-CPU systems.
+// - -1: Sized from the online CPU count.
+INSTANTIATE_TEST_CASE_P(ThreadPoolTest, ThreadPoolTest,
+	::testing::Values(0, 1, 4, -1));
+
+#ifdef __linux__
+/**
+ * Count the threads in this process.
+ * @return Number of threads, or -1 on error.
+ */
+static int processThreadCount(void)
+{
+	DIR *const dir = opendir("/proc/self/task");
+	if (!dir)
+		return -1;
+
+	int count = 0;
+	const struct dirent *dirent;
+	while ((dirent = readdir(dir)) != nullptr) {
+		if (dirent->d_name[0] != '.') {
+			count++;
+		}
+	}
+	closedir(dir);
+	return count;
+}
+#endif /* __linux__ */
+
+/**
+ * Worker threads must not be started until the pool is used.
+ */
+TEST(ThreadPoolLazyTest, lazyStart)
+{
+#ifdef __linux__
+	const int before = processThreadCount();
+	if (before < 0) {
+		fprintf(stderr, "*** /proc/self/task isn't available; skipping this test.\n");
+		return;
+	}
+
+	unique_ptr<ThreadPool> pool(new ThreadPool(4));
+	EXPECT_EQ(before, processThreadCount());
+
+	// Waiting on an empty group doesn't start the workers.
+	{
+		TaskGroup group(pool.get());
+		EXPECT_EQ(0, group.wait());
+	}
+	EXPECT_EQ(before, processThreadCount());
+
+	// Queueing a task does.
+	volatile int count = 0;
+	{
+		TaskGroup group(pool.get());
+		group.run(addTask, (void*)&count);
+		EXPECT_EQ(0, group.wait());
+	}
+	EXPECT_EQ(1, count);
+	// NOTE: Sanitizers may start their own threads here,
+	// so only the worker threads are counted exactly.
+	const int threads = pool->threadCount();
+	const int running = processThreadCount();
+	EXPECT_GE(running, before + threads);
+
+	// Deleting the pool joins the workers.
+	pool.reset();
+	EXPECT_EQ(running - threads, processThreadCount());
+#else /* !__linux__ */
+	fprintf(stderr, "*** Thread counting is only implemented on Linux; skipping this test.\n");
+#endif /* __linux__ */
+}
+
+/**
+ * ScratchArena tests that don't need a thread pool.
+ */
+TEST(ScratchArenaTest, alloc)
+{
+	ScratchArena arena;
+	EXPECT_EQ(0U, arena.capacity());
+
+	// Alignment
+	static const size_t aligns[] = {1, 2, 4, 8, 16, 32, 64};
+	for (size_t i = 0; i < sizeof(aligns)/sizeof(aligns[0]); i++) {
+		void *const p = arena.alloc(3, aligns[i]);
+		ASSERT_TRUE(p != nullptr);
+		EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(p) & (aligns[i] - 1)) << "Alignment " << aligns[i];
+	}
+	const size_t cap1 = arena.capacity();
+	EXPECT_GT(cap1, 0U);
+
+	// Allocating more than the block size adds a block.
+	ASSERT_TRUE(arena.alloc(cap1 * 2) != nullptr);
+	const size_t cap2 = arena.capacity();
+	EXPECT_GT(cap2, cap1);
+
+	// reset() coalesces the blocks. Capacity is retained.
+	arena.reset();
+	EXPECT_EQ(cap2, arena.capacity());
+
+	// The coalesced block fits both allocations.
+	ASSERT_TRUE(arena.alloc(cap1 * 2) != nullptr);
+	ASSERT_TRUE(arena.alloc(cap1 / 2) != nullptr);
+	EXPECT_EQ(cap2, arena.capacity());
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpThreads test suite: ThreadPool tests.\n\n");
+	fprintf(stderr, "Online CPUs: %d\n", LibRpBase::ThreadPool::onlineCpuCount());
+	fprintf(stderr, "Benchmark iterations: %u\n", LibRpBase::Tests::ThreadPoolTest::BENCHMARK_ITERATIONS);
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -92,6 +92,8 @@ int rp_stub_do_security_options(bool config)
 		SCMP_SYS(futex),	// pthread_once()
 		SCMP_SYS(getuid), SCMP_SYS(geteuid),	// TODO: Only use geteuid()?
 		SCMP_SYS(lseek), SCMP_SYS(_llseek),
+		SCMP_SYS(fadvise64), SCMP_SYS(fadvise64_64),	// RpFile::prefetch()
+		SCMP_SYS(inotify_init1), SCMP_SYS(inotify_add_watch),	// LibRpBase::ConfReader
 		SCMP_SYS(lstat), SCMP_SYS(lstat64),	// realpath() [LibRpBase::FileSystem::resolve_symlink()]
 		SCMP_SYS(readlink),	// realpath() [LibRpBase::FileSystem::resolve_symlink()]
 
@@ -21,9 +21,15 @@
 #include "librpbase/TextFuncs.hpp"
 #include "librpbase/img/RpPng.hpp"
 #include "librpbase/img/IconAnimData.hpp"
+#include "librpbase/crypto/MultiHash.hpp"
+#include "librpbase/DatIndex.hpp"
 #include "libi18n/i18n.h"
 using namespace LibRpBase;
 
+// librpthreads
+#include "librpthreads/Profiler.hpp"
+namespace Profiler = LibRpThreads::Profiler;
+
 // librpfile
 #include "librpfile/config.librpfile.h"
 #include "librpfile/FileSystem.hpp"
@@ -33,6 +39,10 @@ using namespace LibRpFile;
 // libromdata
 #include "libromdata/RomDataFactory.hpp"
 using LibRomData::RomDataFactory;
+#ifdef ENABLE_XML
+# include "libromdata/data/DatCompiler.hpp"
+using LibRomData::DatCompiler;
+#endif /* ENABLE_XML */
 
 // librptexture
 #include "librptexture/img/rp_image.hpp"
@@ -118,7 +128,7 @@ static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract)
 					rp_sprintf_p(C_("rpcli", "Extracting %1$s into '%2$s'"),
 						RomData::getImageTypeName((RomData::ImageType)it->image_type),
 						it->filename) << endl;
-				int errcode = RpPng::save(it->filename, image);
+				int errcode = RpPng::save(it->filename, image, RpPngWriter::PROFILE_SMALLEST);
 				if (errcode != 0) {
 					// tr: %1$s == filename, %2%s == error message
 					cerr << rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
@@ -135,11 +145,12 @@ static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract)
 			if (iconAnimData && iconAnimData->count != 0 && iconAnimData->seq_count != 0) {
 				found = true;
 				cerr << "-- " << rp_sprintf(C_("rpcli", "Extracting animated icon into '%s'"), it->filename) << endl;
-				int errcode = RpPng::save(it->filename, iconAnimData);
+				int errcode = RpPng::save(it->filename, iconAnimData, RpPngWriter::PROFILE_SMALLEST);
 				if (errcode == -ENOTSUP) {
 					cerr << "   " << C_("rpcli", "APNG not supported, extracting only the first frame") << endl;
 					// falling back to outputting the first frame
-					errcode = RpPng::save(it->filename, iconAnimData->frames[iconAnimData->seq_index[0]]);
+					errcode = RpPng::save(it->filename, iconAnimData->frames[iconAnimData->seq_index[0]],
+						RpPngWriter::PROFILE_SMALLEST);
 				}
 				if (errcode != 0) {
 					cerr << "   " <<
@@ -170,13 +181,34 @@ static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract)
  * @param extract Vector of image extraction parameters
  * @param languageCode Language code. (0 for default)
  */
-static void DoFile(const char *filename, bool json, vector<ExtractParam>& extract, uint32_t languageCode = 0)
+static void DoFile(const char *filename, bool json, vector<ExtractParam>& extract, uint32_t languageCode = 0, bool hash = false, bool verify = false)
 {
 	cerr << "== " << rp_sprintf(C_("rpcli", "Reading file '%s'..."), filename) << endl;
-	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
+	// NOTE: rpcli is a standalone process, so it can use memory-mapped
+	// views. If the file is truncated while it's being read, only rpcli
+	// will crash, not a file manager.
+	RpFile *const file = new RpFile(filename,
+		static_cast<RpFile::FileMode>(RpFile::FM_OPEN_READ_GZ | RpFile::FM_MMAP));
 	if (file->isOpen()) {
 		RomData *romData = RomDataFactory::create(file);
 		if (romData && romData->isValid()) {
+			if (hash) {
+				// Calculate the file hashes.
+				cerr << "-- " << C_("rpcli", "Calculating hashes") << endl;
+				int ret = romData->addHashFields(MultiHash::supportedAlgorithms());
+				if (ret != 0) {
+					cerr << "-- " << rp_sprintf(C_("rpcli", "Couldn't calculate hashes: %s"), strerror(-ret)) << endl;
+				}
+			}
+			if (verify) {
+				// Verify the internal hashes.
+				cerr << "-- " << C_("rpcli", "Verifying integrity") << endl;
+				int ret = romData->addIntegrityFields();
+				if (ret != 0) {
+					cerr << "-- " << rp_sprintf(C_("rpcli", "Couldn't verify integrity: %s"), strerror(-ret)) << endl;
+				}
+			}
+
 			if (json) {
 				cerr << "-- " << C_("rpcli", "Outputting JSON data") << endl;
 				cout << JSONROMOutput(romData, languageCode) << endl;
@@ -200,6 +232,52 @@ static void DoFile(const char *filename, bool json, vector<ExtractParam>& extrac
 	file->unref();
 }
 
+#ifdef ENABLE_PROFILING
+/**
+ * Print the per-stage profiling report for the last file.
+ * The report is printed to stderr so the normal output isn't affected.
+ * @param json Is program running in json mode?
+ */
+static void PrintProfile(bool json)
+{
+	using namespace LibRpThreads::Profiler;
+	StageStats stats;
+	AllocStats allocStats;
+	getAllocStats(&allocStats);
+
+	if (json) {
+		cerr << "{\"profile\":{";
+		for (int i = 0; i < STAGE_MAX; i++) {
+			getStats(static_cast<Stage>(i), &stats);
+			cerr << '"' << stageName(static_cast<Stage>(i)) << "\":{" <<
+				"\"calls\":" << stats.calls <<
+				",\"time_ns\":" << stats.time_ns <<
+				",\"bytes\":" << stats.bytes << "},";
+		}
+		cerr << "\"imageAlloc\":{" <<
+			"\"count\":" << allocStats.count <<
+			",\"bytes\":" << allocStats.bytes << "}}}" << endl;
+		return;
+	}
+
+	cerr << "-- " << C_("rpcli", "Profile:") << endl;
+	for (int i = 0; i < STAGE_MAX; i++) {
+		getStats(static_cast<Stage>(i), &stats);
+		if (stats.calls == 0)
+			continue;
+		cerr << rp_sprintf("   %-18s %6u calls %10.3f ms %12llu bytes",
+			stageName(static_cast<Stage>(i)),
+			static_cast<unsigned int>(stats.calls),
+			static_cast<double>(stats.time_ns) / 1000000.0,
+			static_cast<unsigned long long>(stats.bytes)) << endl;
+	}
+	cerr << rp_sprintf("   %-18s %6u allocs %22llu bytes",
+		"imageAlloc",
+		static_cast<unsigned int>(allocStats.count),
+		static_cast<unsigned long long>(allocStats.bytes)) << endl;
+}
+#endif /* ENABLE_PROFILING */
+
 /**
  * Print the system region information.
  */
@@ -253,6 +331,33 @@ static void PrintPathnames(void)
 	cout << endl;
 }
 
+#ifdef ENABLE_XML
+/**
+ * Compile a DAT file into the DAT index for a system.
+ * @param className RomData class name, e.g. "GameCube"
+ * @param datFilename DAT filename
+ * @return 0 on success; non-zero on error.
+ */
+static int DoCompileDat(const char *className, const char *datFilename)
+{
+	const string idxFilename = DatIndex::indexFilename(className);
+	if (idxFilename.empty()) {
+		cerr << "-- " << rp_sprintf(C_("rpcli", "Invalid class name '%s'"), className) << endl;
+		return 1;
+	}
+
+	cerr << "== " << rp_sprintf(C_("rpcli", "Compiling DAT file '%s'..."), datFilename) << endl;
+	const int ret = DatCompiler::compile(datFilename, idxFilename.c_str());
+	if (ret < 0) {
+		cerr << "-- " << rp_sprintf(C_("rpcli", "Couldn't compile DAT file: %s"), strerror(-ret)) << endl;
+		return 1;
+	}
+
+	cerr << "-- " << rp_sprintf(C_("rpcli", "Compiled %d entries into '%s'"), ret, idxFilename.c_str()) << endl;
+	return 0;
+}
+#endif /* ENABLE_XML */
+
 #ifdef RP_OS_SCSI_SUPPORTED
 /**
  * Run a SCSI INQUIRY command on a device.
@@ -355,6 +460,14 @@ int RP_C_API main(int argc, char *argv[])
 		cerr << "  -l:   " << C_("rpcli", "Retrieve the specified language from the ROM image.") << endl;
 		cerr << "  -xN:  " << C_("rpcli", "Extract image N to outfile in PNG format.") << endl;
 		cerr << "  -a:   " << C_("rpcli", "Extract the animated icon to outfile in APNG format.") << endl;
+		cerr << "  --hash: " << C_("rpcli", "Calculate CRC32, MD5, SHA-1, and SHA-256 hashes of each file.") << endl;
+		cerr << "  --verify: " << C_("rpcli", "Verify each file using its internal hashes, e.g. Wii hash trees.") << endl;
+#ifdef ENABLE_XML
+		cerr << "  --compile-dat class datfile: " << C_("rpcli", "Compile a Logiqx DAT file for verifying dumps of the specified system.") << endl;
+#endif /* ENABLE_XML */
+#ifdef ENABLE_PROFILING
+		cerr << "  --profile: " << C_("rpcli", "Print a per-stage timing breakdown for each file.") << endl;
+#endif /* ENABLE_PROFILING */
 		cerr << endl;
 #ifdef RP_OS_SCSI_SUPPORTED
 		cerr << "Special options for devices:" << endl;
@@ -386,6 +499,11 @@ int RP_C_API main(int argc, char *argv[])
 	bool inq_ata = false;
 #endif /* RP_OS_SCSI_SUPPORTED */
 	uint32_t languageCode = 0;
+#ifdef ENABLE_PROFILING
+	bool profile = false;
+#endif /* ENABLE_PROFILING */
+	bool hash = false;
+	bool verify = false;
 	bool first = true;
 	int ret = 0;
 	for (int i = 1; i < argc; i++){
@@ -457,6 +575,43 @@ int RP_C_API main(int argc, char *argv[])
 				break;
 			case 'j': // do nothing
 				break;
+			case '-':
+				// Long options.
+				if (!strcmp(argv[i], "--hash")) {
+					// Calculate hashes for all subsequent files.
+					hash = true;
+					break;
+				}
+				if (!strcmp(argv[i], "--verify")) {
+					// Verify integrity for all subsequent files.
+					verify = true;
+					break;
+				}
+#ifdef ENABLE_XML
+				if (!strcmp(argv[i], "--compile-dat")) {
+					// Compile a DAT file.
+					if (i+2 >= argc) {
+						cerr << rp_sprintf(C_("rpcli", "Warning: '%s' requires a class name and a DAT filename"), argv[i]) << endl;
+						i = argc;
+						break;
+					}
+					if (DoCompileDat(argv[i+1], argv[i+2]) != 0) {
+						ret = 1;
+					}
+					i += 2;
+					break;
+				}
+#endif /* ENABLE_XML */
+#ifdef ENABLE_PROFILING
+				if (!strcmp(argv[i], "--profile")) {
+					// Enable profiling for all subsequent files.
+					profile = true;
+					Profiler::setEnabled(true);
+					break;
+				}
+#endif /* ENABLE_PROFILING */
+				cerr << rp_sprintf(C_("rpcli", "Warning: skipping unknown switch '%s'"), argv[i]) << endl;
+				break;
 #ifdef RP_OS_SCSI_SUPPORTED
 			case 'i':
 				// TODO: Check if a SCSI implementation is available for this OS?
@@ -490,7 +645,17 @@ int RP_C_API main(int argc, char *argv[])
 #endif /* RP_OS_SCSI_SUPPORTED */
 			{
 				// Regular file.
-				DoFile(argv[i], json, extract, languageCode);
+#ifdef ENABLE_PROFILING
+				if (profile) {
+					Profiler::reset();
+				}
+#endif /* ENABLE_PROFILING */
+				DoFile(argv[i], json, extract, languageCode, hash, verify);
+#ifdef ENABLE_PROFILING
+				if (profile) {
+					PrintProfile(json);
+				}
+#endif /* ENABLE_PROFILING */
 			}
 
 #ifdef RP_OS_SCSI_SUPPORTED
@@ -26,6 +26,16 @@ int rpcli_do_security_options(void)
 		// TODO: Add more syscalls.
 		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
 		// defined in earlier versions, including Ubuntu 14.04.
+
+		// NOTE: Special case for clone(). If it's the first syscall
+		// in the list, it has a parameter restriction added that
+		// ensures it can only be used to create threads.
+		SCMP_SYS(clone),	// LibRpBase::ThreadPool
+
+		SCMP_SYS(clock_gettime),	// LibRpThreads::Profiler::now_ns() (if vDSO is unavailable)
+#if defined(__SNR_clock_gettime64) || defined(__NR_clock_gettime64)
+		SCMP_SYS(clock_gettime64),
+#endif /* __SNR_clock_gettime64 || __NR_clock_gettime64 */
 		SCMP_SYS(close),
 		SCMP_SYS(dup),		// gzdopen()
 		SCMP_SYS(fstat),     SCMP_SYS(fstat64),		// __GI___fxstat() [printf()]
@@ -36,7 +46,10 @@ int rpcli_do_security_options(void)
 		SCMP_SYS(gettimeofday),	// 32-bit only?
 		SCMP_SYS(ioctl),	// for devices; also afl-fuzz
 		SCMP_SYS(lseek), SCMP_SYS(_llseek),
+		SCMP_SYS(fadvise64), SCMP_SYS(fadvise64_64),	// RpFile::prefetch()
+		SCMP_SYS(inotify_init1), SCMP_SYS(inotify_add_watch),	// LibRpBase::ConfReader
 		SCMP_SYS(lstat), SCMP_SYS(lstat64),	// LibRpBase::FileSystem::is_symlink(), resolve_symlink()
+		SCMP_SYS(mkdir), SCMP_SYS(mkdirat),	// LibRpFile::FileSystem::rmkdir() [--compile-dat]
 		SCMP_SYS(mmap), SCMP_SYS(mmap2),
 		SCMP_SYS(mprotect),	// dlopen()
 		SCMP_SYS(munmap),
@@ -46,6 +59,7 @@ int rpcli_do_security_options(void)
 		SCMP_SYS(openat2),	// Linux 5.6
 #endif /* __SNR_openat2 || __NR_openat2 */
 		SCMP_SYS(readlink),	// realpath() [LibRpBase::FileSystem::resolve_symlink()]
+		SCMP_SYS(unlink), SCMP_SYS(unlinkat),	// LibRpFile::FileSystem::delete_file() [--compile-dat]
 
 		// KeyManager (keys.conf)
 		SCMP_SYS(access),	// LibUnixCommon::isWritableDirectory()